@@ -28,7 +28,7 @@
 #include "../include/block_size.h"
 #include "../include/kernel_d_lib4.h"
 
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 #include <mmintrin.h>
 #include <xmmintrin.h>  // SSE
 #include <emmintrin.h>  // SSE2
@@ -242,7 +242,7 @@ void dgeset_lib(int row, int col, double alpha, int offset, double *pA, int sda)
 		}
 	for( ; ii<row-3; ii+=4)
 		{
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 		kernel_dgeset_4_lib4(col, alpha, pA);
 #else
 		for(jj=0; jj<col; jj++)
@@ -295,7 +295,7 @@ void dtrset_lib(int row, double alpha, int offset, double *pA, int sda)
 		}
 	for( ; ii<row-3; ii+=4)
 		{
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 		kernel_dtrset_4_lib4(ii, alpha, pA);
 #else
 		for(jj=0; jj<ii; jj++)
@@ -555,7 +555,7 @@ void d_copy_pmat_general(int m, int n, int offset_A, double *A, int sda, int off
 				}
 			}
 		// main loop
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		for(; ii<m-7; ii+=8)
 			{
 			kernel_align_panel_8_0_lib4(n, A, sda, B, sdb);
@@ -624,7 +624,7 @@ void d_copy_pmat_general(int m, int n, int offset_A, double *A, int sda, int off
 				}
 			}
 		// main loop
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		for( ; ii<m-7; ii+=8)
 			{
 			kernel_align_panel_8_1_lib4(n, A, sda, B, sdb);
@@ -693,7 +693,7 @@ void d_copy_pmat_general(int m, int n, int offset_A, double *A, int sda, int off
 				}
 			}
 		// main loop
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		for(; ii<m-7; ii+=8)
 			{
 			kernel_align_panel_8_2_lib4(n, A, sda, B, sdb);
@@ -762,7 +762,7 @@ void d_copy_pmat_general(int m, int n, int offset_A, double *A, int sda, int off
 				}
 			}
 		// main loop
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		for(; ii<m-7; ii+=8)
 			{
 			kernel_align_panel_8_3_lib4(n, A, sda, B, sdb);
@@ -1318,7 +1318,7 @@ void d_cvt_mat2pmat(int row, int col, double *A, int lda, int offset, double *pA
 	double
 		*B, *pB;
 	
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 	__m256d
 		tmp;
 #endif
@@ -1349,7 +1349,7 @@ void d_cvt_mat2pmat(int row, int col, double *A, int lda, int offset, double *pA
 			B  += row0;
 			pB += row0 + bs*(sda-1);
 			}
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 		for( ; ii<row-3; ii+=4)
 			{
 			tmp = _mm256_loadu_pd( &B[0+lda*0] );
@@ -1423,6 +1423,16 @@ void d_cvt_mat2pmat(int row, int col, double *A, int lda, int offset, double *pA
 			B  += row0;
 			pB += row0 + bs*(sda-1);
 			}
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
+		for( ; ii<row-3; ii+=4)
+			{
+			tmp = _mm256_loadu_pd( &B[0+lda*0] );
+			_mm256_store_pd( &pB[0+bs*0], tmp );
+			// update
+			B  += 4;
+			pB += bs*sda;
+			}
+#else
 		for( ; ii<row-3; ii+=4)
 			{
 			// col 0
@@ -1434,6 +1444,7 @@ void d_cvt_mat2pmat(int row, int col, double *A, int lda, int offset, double *pA
 			B  += 4;
 			pB += bs*sda;
 			}
+#endif
 		for( ; ii<row; ii++)
 			{
 			// col 0
@@ -1538,7 +1549,7 @@ void d_cvt_tran_mat2pmat(int row, int col, double *A, int lda, int offset, doubl
 	double
 		*B, *pB;
 	
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 	__m256d
 		v0, v1, v2, v3,
 		v4, v5, v6, v7;
@@ -1570,7 +1581,7 @@ void d_cvt_tran_mat2pmat(int row, int col, double *A, int lda, int offset, doubl
 		j=0;
 		B  = A + ii*lda;
 		pB = pA + ii*sda;
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 		for(; j<row-3; j+=4)
 			{
 			v0 = _mm256_loadu_pd( &B[0+0*lda] ); // 00 10 20 30
@@ -1691,9 +1702,15 @@ void d_cvt_pmat2mat(int row, int col, int offset, double *pA, int sda, double *A
 	int i, ii, jj;
 	
 	int row0 = (bs-offset%bs)%bs;
+	if(row0>row)
+		row0 = row;
 	
 	double *ptr_pA;
 	
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
+	__m256d
+		tmp;
+#endif
 
 	jj=0;
 	for(; jj<col; jj++)
@@ -1709,6 +1726,14 @@ void d_cvt_pmat2mat(int row, int col, int offset, double *pA, int sda, double *A
 				}
 			ptr_pA += (sda-1)*bs;
 			}
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
+		for(; ii<row-bs+1; ii+=bs)
+			{
+			tmp = _mm256_load_pd( &ptr_pA[0] );
+			_mm256_storeu_pd( &A[ii+lda*jj], tmp );
+			ptr_pA += sda*bs;
+			}
+#else
 		for(; ii<row-bs+1; ii+=bs)
 			{
 			i=0;
@@ -1719,6 +1744,7 @@ void d_cvt_pmat2mat(int row, int col, int offset, double *pA, int sda, double *A
 				}
 			ptr_pA += (sda-1)*bs;
 			}
+#endif
 		for(; ii<row; ii++)
 			{
 			A[ii+lda*jj] = ptr_pA[0];
@@ -1741,11 +1767,67 @@ void d_cvt_tran_pmat2mat(int row, int col, int offset, double *pA, int sda, doub
 	int i, ii, jj;
 	
 	int row0 = (bs-offset%bs)%bs;
+	if(row0>row)
+		row0 = row;
 	
 	double *ptr_pA;
 	
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
+	__m256d
+		v0, v1, v2, v3,
+		v4, v5, v6, v7;
+#endif
 
 	jj=0;
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
+	for(; jj<col-3; jj+=4)
+		{
+		ptr_pA = pA + jj*bs;
+		ii = 0;
+		if(row0>0)
+			{
+			for(; ii<row0; ii++)
+				{
+				A[jj+0+lda*ii] = ptr_pA[0+bs*0];
+				A[jj+1+lda*ii] = ptr_pA[0+bs*1];
+				A[jj+2+lda*ii] = ptr_pA[0+bs*2];
+				A[jj+3+lda*ii] = ptr_pA[0+bs*3];
+				ptr_pA++;
+				}
+			ptr_pA += (sda-1)*bs;
+			}
+		for(; ii<row-bs+1; ii+=bs)
+			{
+			v0 = _mm256_load_pd( &ptr_pA[0+bs*0] ); // 00 10 20 30
+			v1 = _mm256_load_pd( &ptr_pA[0+bs*1] ); // 01 11 21 31
+			v4 = _mm256_unpacklo_pd( v0, v1 ); // 00 01 20 21
+			v5 = _mm256_unpackhi_pd( v0, v1 ); // 10 11 30 31
+			v2 = _mm256_load_pd( &ptr_pA[0+bs*2] ); // 02 12 22 32
+			v3 = _mm256_load_pd( &ptr_pA[0+bs*3] ); // 03 13 23 33
+			v6 = _mm256_unpacklo_pd( v2, v3 ); // 02 03 22 23
+			v7 = _mm256_unpackhi_pd( v2, v3 ); // 12 13 32 33
+
+			v0 = _mm256_permute2f128_pd( v4, v6, 0x20 ); // 00 01 02 03
+			_mm256_storeu_pd( &A[jj+lda*(ii+0)], v0 );
+			v2 = _mm256_permute2f128_pd( v4, v6, 0x31 ); // 20 21 22 23
+			_mm256_storeu_pd( &A[jj+lda*(ii+2)], v2 );
+			v1 = _mm256_permute2f128_pd( v5, v7, 0x20 ); // 10 11 12 13
+			_mm256_storeu_pd( &A[jj+lda*(ii+1)], v1 );
+			v3 = _mm256_permute2f128_pd( v5, v7, 0x31 ); // 30 31 32 33
+			_mm256_storeu_pd( &A[jj+lda*(ii+3)], v3 );
+
+			ptr_pA += sda*bs;
+			}
+		for(; ii<row; ii++)
+			{
+			A[jj+0+lda*ii] = ptr_pA[0+bs*0];
+			A[jj+1+lda*ii] = ptr_pA[0+bs*1];
+			A[jj+2+lda*ii] = ptr_pA[0+bs*2];
+			A[jj+3+lda*ii] = ptr_pA[0+bs*3];
+			ptr_pA++;
+			}
+		}
+#endif
 	for(; jj<col; jj++)
 		{
 		ptr_pA = pA + jj*bs;
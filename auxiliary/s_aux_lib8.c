@@ -30,6 +30,8 @@ int posix_memalign(void **memptr, size_t alignment, size_t size);
 
 
 
+#if ! defined(BLASFEO)
+
 /* creates a zero matrix aligned */
 void s_zeros(float **pA, int row, int col)
 	{
@@ -58,6 +60,8 @@ void s_zeros_align(float **pA, int row, int col)
 	for(i=0; i<row*col; i++) A[i] = 0.0;
 	}
 
+#endif
+
 
 
 /* creates a zero matrix aligned */
@@ -997,6 +1001,8 @@ void s_cvt_pmat2mat(int row, int col, int offset, int bs_dummy, float *pA, int s
 
 
 
+#if ! defined(BLASFEO)
+
 /* prints a matrix */
 void s_print_mat(int row, int col, float *A, int lda)
 	{
@@ -1030,6 +1036,8 @@ void s_print_mat_e(int row, int col, float *A, int lda)
 	printf("\n");
 	}	
 
+#endif
+
 
 
 /* prints a packed matrix */
@@ -23,12 +23,13 @@
 *                                                                                                 *
 **************************************************************************************************/
 
+#include <stdlib.h>
 #include <math.h>
 
 #include "../include/kernel_d_lib4.h"
 #include "../include/block_size.h"
 
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 #include <mmintrin.h>
 #include <xmmintrin.h>  // SSE
 #include <emmintrin.h>  // SSE2
@@ -49,7 +50,7 @@ void dgemm_kernel_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, i
 	int i, j, jj;
 	
 	i = 0;
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	for(; i<m-8; i+=12)
 		{
 		j = 0;
@@ -136,7 +137,7 @@ void dgemm_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 		if(td==0) // tc==0, td==0
 			{
 
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	// low rank updates
 	if (k<=4)
 		{
@@ -252,8 +253,23 @@ void dgemm_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 #endif
 
 			i = 0;
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_CORTEX_A57)
-#if defined(TARGET_X64_AVX2) //|| defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX512)
+			// full 8-row blocks, the row clean-up is left to the AVX2 code below
+			for(; i<m-7; i+=8)
+				{
+				j = 0;
+				for(; j<n-7; j+=8)
+					{
+					kernel_dgemm_nt_8x8_lib4(k, &pA[i*sda], sda, &pB[j*sdb], sdb, &pC[j*bs+i*sdc], sdc, &pD[j*bs+i*sdd], sdd, alg);
+					}
+				if(j<n)
+					{
+					kernel_dgemm_nt_8x8_vs_lib4(8, n-j, k, &pA[i*sda], sda, &pB[j*sdb], sdb, &pC[j*bs+i*sdc], sdc, &pD[j*bs+i*sdd], sdd, alg);
+					}
+				}
+#endif
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_CORTEX_A57)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) //|| defined(TARGET_X64_AVX)
 			for(; i<m-11; i+=12)
 				{
 				j = 0;
@@ -439,7 +455,7 @@ void dgemm_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 			return;
 
 			// clean up loops definitions
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 			left_00_12:
 			j = 0;
 			for(; j<n-2; j+=4)
@@ -469,7 +485,7 @@ void dgemm_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 			return;
 #endif
 
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			left_00_8:
 			j = 0;
 			for(; j<n-2; j+=4)
@@ -530,8 +546,8 @@ void dgemm_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 
 
 			i = 0;
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_CORTEX_A57)
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_CORTEX_A57)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			for(; i<m-11; i+=12)
 				{
 				j = 0;
@@ -706,7 +722,7 @@ void dgemm_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 			return;
 
 			// clean up loops definitions
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			left_01_12:
 			j = 0;
 			for(; j<n-2; j+=4)
@@ -736,7 +752,7 @@ void dgemm_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 			return;
 #endif
 
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			left_01_8:
 			j = 0;
 			for(; j<n-2; j+=4)
@@ -800,8 +816,8 @@ void dgemm_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 
 
 			i = 0;
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_CORTEX_A57)
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_CORTEX_A57)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			for(; i<m-11; i+=12)
 				{
 				j = 0;
@@ -980,7 +996,7 @@ void dgemm_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 			return;
 
 			// clean up loops definitions
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			left_10_12:
 			j = 0;
 			for(; j<n-2; j+=4)
@@ -1010,7 +1026,7 @@ void dgemm_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 			return;
 #endif
 
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			left_10_8:
 			j = 0;
 			for(; j<n-2; j+=4)
@@ -1071,8 +1087,8 @@ void dgemm_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 
 
 			i = 0;
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_CORTEX_A57)
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_CORTEX_A57)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			for(; i<m-11; i+=12)
 				{
 				j = 0;
@@ -1251,7 +1267,7 @@ void dgemm_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 			return;
 
 			// clean up loops definitions
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			left_11_12:
 			j = 0;
 			for(; j<n-2; j+=4)
@@ -1281,7 +1297,7 @@ void dgemm_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 			return;
 #endif
 
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 			left_11_8:
 			j = 0;
 			for(; j<n-2; j+=4)
@@ -1363,8 +1379,8 @@ void dgemm_nn_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 		if(td==0) // not transpose D
 			{
 			i = 0;
-#if defined(TARGET_X64_AVX2) ||  defined(TARGET_X64_AVX)
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) ||  defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			for(; i<m-11; i+=12)
 				{
 				j = 0;
@@ -1436,7 +1452,7 @@ void dgemm_nn_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 
 			// clean up loops definitions
 
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			left_00_12:
 			j = 0;
 			for(; j<n-2; j+=4)
@@ -1528,8 +1544,8 @@ void dgemm_nn_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 		else // tc==0, td==1
 			{
 			i = 0;
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			for(; i<m-11; i+=12)
 				{
 				j = 0;
@@ -1601,7 +1617,7 @@ void dgemm_nn_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 			return;
 
 			// clean up loops definitions
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			left_01_12:
 			j = 0;
 			for(; j<n-2; j+=4)
@@ -1695,8 +1711,8 @@ void dgemm_nn_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 		if(td==0) // not transpose D
 			{
 			i = 0;
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			for(; i<m-11; i+=12)
 				{
 				j = 0;
@@ -1769,7 +1785,7 @@ void dgemm_nn_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 
 			// clean up loops definitions
 
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			left_10_12:
 			j = 0;
 			for(; j<n-2; j+=4)
@@ -1860,8 +1876,8 @@ void dgemm_nn_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 		else // td==1
 			{
 			i = 0;
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			for(; i<m-11; i+=12)
 				{
 				j = 0;
@@ -1934,7 +1950,7 @@ void dgemm_nn_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 
 			// clean up loops definitions
 
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			left_11_12:
 			j = 0;
 			for(; j<n-2; j+=4)
@@ -2167,7 +2183,34 @@ void dtrmm_nt_u_lib(int m, int n, double *pA, int sda, double *pB, int sdb, doub
 	return;
 
 #else
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX512)
+	for(; i<m-7; i+=8)
+		{
+		j = 0;
+		for(; j<n-7; j+=8)
+			{
+			kernel_dtrmm_nt_u_8x8_lib4(n-j, &pA[j*bs+i*sda], sda, &pB[j*bs+j*sdb], sdb, &pC[j*bs+i*sdc], sdc);
+			}
+		if(j<n-3)
+			{
+			kernel_dtrmm_nt_u_8x4_lib4(n-j, &pA[j*bs+i*sda], sda, &pB[j*bs+j*sdb], &pC[j*bs+i*sdc], sdc);
+			j += 4;
+			}
+		if(n-j==1)
+			{
+			corner_dtrmm_nt_u_8x1_lib4(&pA[j*bs+i*sda], sda, &pB[j*bs+j*sdb], &pC[j*bs+i*sdc], sdc);
+			}
+		else if(n-j==2)
+			{
+			corner_dtrmm_nt_u_8x2_lib4(&pA[j*bs+i*sda], sda, &pB[j*bs+j*sdb], &pC[j*bs+i*sdc], sdc);
+			}
+		else if(n-j==3)
+			{
+			corner_dtrmm_nt_u_8x3_lib4(&pA[j*bs+i*sda], sda, &pB[j*bs+j*sdb], &pC[j*bs+i*sdc], sdc);
+			}
+		}
+#endif
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	for(; i<m-8; i+=12)
 		{
 		j = 0;
@@ -2189,7 +2232,7 @@ void dtrmm_nt_u_lib(int m, int n, double *pA, int sda, double *pB, int sdb, doub
 			}
 		}
 #endif
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	for(; i<m-4; i+=8)
 		{
 		j = 0;
@@ -2254,7 +2297,7 @@ void dtrmm_nt_l_lib(int m, int n, double *pA, int sda, double *pB, int sdb, doub
 	int i, j;
 	
 	i=0;
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	for( ; i<m-4; i+=8)
 		{
 		j=0;
@@ -2322,7 +2365,7 @@ void dsyrk_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 
 	int i, j, l;
 
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	// low rank updates
 	if (k<=4)
 		{
@@ -2522,7 +2565,19 @@ void dsyrk_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 #endif
 
 	i = 0;
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX512)
+	// 8-row blocks with a full diagonal block, the clean-up is left to the AVX2 code below
+	for(; i<m-7 && i<n-7; i+=8)
+		{
+		j = 0;
+		for(; j<i; j+=8)
+			{
+			kernel_dgemm_nt_8x8_lib4(k, &pA[i*sda], sda, &pB[j*sdb], sdb, &pC[j*bs+i*sdc], sdc, &pD[j*bs+i*sdd], sdd, alg);
+			}
+		kernel_dsyrk_nt_8x8_lib4(k, &pA[i*sda], sda, &pB[j*sdb], sdb, &pC[j*bs+i*sdc], sdc, &pD[j*bs+i*sdd], sdd, alg);
+		}
+#endif
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	for(; i<m-11; i+=12)
 		{
 		j = 0;
@@ -2627,7 +2682,7 @@ void dsyrk_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 		i += 12;
 		}
 #endif
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	for(; i<m-7; i+=8)
 		{
 		j = 0;
@@ -2636,7 +2691,7 @@ void dsyrk_nt_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 #if defined(TARGET_X64_AVX)
 			kernel_dgemm_nt_8x4_lib4(k, &pA[i*sda], sda, &pB[j*sdb], &pC[j*bs+i*sdc], sdc, &pD[j*bs+i*sdd], sdd, alg, 0, 0);
 #endif
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			kernel_dgemm_nt_8x4_vs_lib4(8, 4, k, &pA[i*sda], sda, &pB[j*sdb], &pC[j*bs+i*sdc], sdc, &pD[j*bs+i*sdd], sdd, alg, 0, 0);
 #endif
 			}
@@ -2967,7 +3022,7 @@ void dsyrk_nn_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 	for(; j<n-2; j+=4)
 		{
 		i = j;
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		if(i<m-8)
 			{
 			kernel_dsyrk_nt_12x4_lib4(k, &pA[i*sda], sda, &pB[j*sdb], &pC[j*bs+i*sdc], sdc, &pD[j*bs+i*sdd], sdd, alg);
@@ -3033,7 +3088,7 @@ void dsyrk_nn_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb,
 			{
 			kernel_dsyrk_nt_4x2_lib4(k, &pA[i*sda], &pB[j*sdb], &pC[j*bs+i*sdc], &pD[j*bs+i*sdd], alg);
 			i += 4;
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			for(; i<m-4; i+=8)
 				{
 				kernel_dgemm_nt_8x2_lib4(k, &pA[i*sda], sda, &pB[j*sdb], &pC[j*bs+i*sdc], sdc, &pD[j*bs+i*sdd], sdd, alg, 0, 0);
@@ -3079,7 +3134,18 @@ void dpotrf_lib(int m, int n, double *pC, int sdc, double *pD, int sdd, double *
 #if 1 // inner loop over columns
 
 	i = 0;
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX512)
+	for(; i<m-7 && i<n-7; i+=8)
+		{
+		j = 0;
+		for(; j<i; j+=8)
+			{
+			kernel_dgemm_dtrsm_nt_8x8_lib4_new(0, dummy, 0, dummy, 0, j, &pD[i*sdd], sdd, &pD[j*sdd], sdd, 1, &pC[j*bs+i*sdc], sdc, &pD[j*bs+i*sdd], sdd, &pD[j*bs+j*sdd], sdd, 1, &inv_diag_D[j]);
+			}
+		kernel_dsyrk_dpotrf_nt_8x8_lib4(0, dummy, 0, dummy, 0, j, &pD[i*sdd], sdd, &pD[j*sdd], sdd, 1, &pC[j*bs+i*sdc], sdc, &pD[j*bs+i*sdd], sdd, &inv_diag_D[j]);
+		}
+#endif
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	for(; i<m-11; i+=12)
 		{
 		j = 0;
@@ -3370,7 +3436,7 @@ void dpotrf_lib(int m, int n, double *pC, int sdc, double *pD, int sdd, double *
 	for(; i<m-3; i+=4)
 		{
 		j = 0;
-		for(; j<i && j<n-2; j+=4)
+		for(; j<i && j<n-3; j+=4)
 			{
 			kernel_dtrsm_nt_4x4_lib4_new(j, &pD[i*sdd], &pD[j*sdd], 1, &pC[j*bs+i*sdc], &pD[j*bs+i*sdd], &pD[j*bs+j*sdd], 1, &inv_diag_D[j]);
 			}
@@ -3454,7 +3520,10 @@ void dpotrf_lib(int m, int n, double *pC, int sdc, double *pD, int sdd, double *
 			}
 		else // dpotrf
 			{
-			kernel_dsyrk_dpotrf_nt_2x2_vs_lib4_new(m-i, n-j, 0, 0, dummy, dummy, j, &pD[i*sdd], &pD[j*sdd], 1, &pC[j*bs+i*sdc], &pD[j*bs+i*sdd], &inv_diag_D[j]);
+			if(j<n)
+				{
+				kernel_dsyrk_dpotrf_nt_2x2_vs_lib4_new(m-i, n-j, 0, 0, dummy, dummy, j, &pD[i*sdd], &pD[j*sdd], 1, &pC[j*bs+i*sdc], &pD[j*bs+i*sdd], &inv_diag_D[j]);
+				}
 			}
 		i += 2;
 		}
@@ -3635,7 +3704,18 @@ void dsyrk_dpotrf_lib(int m, int n, int k, double *pA, int sda, double *pB, int
 #if 1 // inner loop over columns
 
 	i = 0;
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX512)
+	for(; i<m-7 && i<n-7; i+=8)
+		{
+		j = 0;
+		for(; j<i; j+=8)
+			{
+			kernel_dgemm_dtrsm_nt_8x8_lib4_new(k, &pA[i*sda], sda, &pB[j*sdb], sdb, j, &pD[i*sdd], sdd, &pD[j*sdd], sdd, 1, &pC[j*bs+i*sdc], sdc, &pD[j*bs+i*sdd], sdd, &pD[j*bs+j*sdd], sdd, 1, &inv_diag_D[j]);
+			}
+		kernel_dsyrk_dpotrf_nt_8x8_lib4(k, &pA[i*sda], sda, &pB[j*sdb], sdb, j, &pD[i*sdd], sdd, &pD[j*sdd], sdd, 1, &pC[j*bs+i*sdc], sdc, &pD[j*bs+i*sdd], sdd, &inv_diag_D[j]);
+		}
+#endif
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	for(; i<m-11; i+=12)
 		{
 		j = 0;
@@ -3928,7 +4008,7 @@ void dsyrk_dpotrf_lib(int m, int n, int k, double *pA, int sda, double *pB, int
 	for(; i<m-3; i+=4)
 		{
 		j = 0;
-		for(; j<i && j<n-2; j+=4)
+		for(; j<i && j<n-3; j+=4)
 			{
 			kernel_dgemm_dtrsm_nt_4x4_lib4_new(k, &pA[i*sda], &pB[j*sdb], j, &pD[i*sdd], &pD[j*sdd], alg, &pC[j*bs+i*sdc], &pD[j*bs+i*sdd], &pD[j*bs+j*sdd], 1, &inv_diag_D[j]);
 			}
@@ -4012,7 +4092,10 @@ void dsyrk_dpotrf_lib(int m, int n, int k, double *pA, int sda, double *pB, int
 			}
 		else // dpotrf
 			{
-			kernel_dsyrk_dpotrf_nt_2x2_vs_lib4_new(m-i, n-j, k, 0, &pA[i*sda], &pB[j*sdb], j, &pD[i*sdd], &pD[j*sdd], alg, &pC[j*bs+i*sdc], &pD[j*bs+i*sdd], &inv_diag_D[j]);
+			if(j<n)
+				{
+				kernel_dsyrk_dpotrf_nt_2x2_vs_lib4_new(m-i, n-j, k, 0, &pA[i*sda], &pB[j*sdb], j, &pD[i*sdd], &pD[j*sdd], alg, &pC[j*bs+i*sdc], &pD[j*bs+i*sdd], &inv_diag_D[j]);
+				}
 			}
 		i += 2;
 		}
@@ -4021,7 +4104,7 @@ void dsyrk_dpotrf_lib(int m, int n, int k, double *pA, int sda, double *pB, int
 
 #else // inner loop over rows
 
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	j = 0;
 	for(; j<n-3; j+=4) // then i<n-3 !!!
 		{
@@ -4285,7 +4368,7 @@ void dlauum_dpotrf_lib(int m, int n, int k, double *pA, int sda, double *pB, int
 	double *dummy;
 
 	i = 0;
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	// dlauum_dpotrf
 	for(; i<k-11; i+=12)
 		{
@@ -4764,7 +4847,7 @@ void dlauum_dpotrf_lib(int m, int n, int k, double *pA, int sda, double *pB, int
 	for(; i<m-3; i+=4)
 		{
 		j = 0;
-		for(; j<i && j<n-2; j+=4)
+		for(; j<i && j<n-3; j+=4)
 			{
 			kernel_dtrsm_nt_4x4_lib4_new(j, &pD[i*sdd], &pD[j*sdd], 1, &pC[j*bs+i*sdc], &pD[j*bs+i*sdd], &pD[j*bs+j*sdd], 1, &inv_diag_D[j]);
 			}
@@ -4848,7 +4931,10 @@ void dlauum_dpotrf_lib(int m, int n, int k, double *pA, int sda, double *pB, int
 			}
 		else // dpotrf
 			{
-			kernel_dsyrk_dpotrf_nt_2x2_vs_lib4_new(m-i, n-j, 0, 0, dummy, dummy, j, &pD[i*sdd], &pD[j*sdd], 1, &pC[j*bs+i*sdc], &pD[j*bs+i*sdd], &inv_diag_D[j]);
+			if(j<n)
+				{
+				kernel_dsyrk_dpotrf_nt_2x2_vs_lib4_new(m-i, n-j, 0, 0, dummy, dummy, j, &pD[i*sdd], &pD[j*sdd], 1, &pC[j*bs+i*sdc], &pD[j*bs+i*sdd], &inv_diag_D[j]);
+				}
 			}
 		i += 2;
 		}
@@ -4859,6 +4945,84 @@ void dlauum_dpotrf_lib(int m, int n, int k, double *pA, int sda, double *pB, int
 
 
 
+#if ! defined(BLASFEO)
+// fused dtrmm + dsyrk + dpotrf of the Riccati recursion: W = A * B' (B upper triangular, k x k),
+// plus the row pR (stride bs, if not NULL) added to the last row of W, and D = chol( C + W * W' );
+// the first block of each 4-row panel of D is computed by a fused kernel, that builds that panel of W
+// and consumes it from registers; W is still stored, since the following blocks of the panel need it
+void dtrmm_dsyrk_dpotrf_lib(int m, int n, int k, double *pA, int sda, double *pB, int sdb, double *pR, double *pW, int sdw, double *pC, int sdc, double *pD, int sdd, double *inv_diag_D)
+	{
+
+	if(m<=0 || n<=0)
+		return;
+
+	if(m<n)
+		n = m;
+
+	const int bs = 4;
+
+	int i, j;
+
+#if defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4) || defined(TARGET_CORTEX_A57)
+
+	int ir;
+
+	for(i=0; i<m; i+=4)
+		{
+		// the row pR is added by the kernel of the last panel
+		ir = -1;
+		if(pR!=NULL && m-i<=4)
+			ir = m-1-i;
+		if(i==0)
+			{
+			kernel_dtrmm_dsyrk_dpotrf_nt_4x4_vs_lib4_new(m-i, n, k, &pA[i*sda], pB, sdb, pR, ir, 1, &pC[i*sdc], &pW[i*sdw], &pD[i*sdd], &inv_diag_D[0]);
+			continue;
+			}
+		kernel_dtrmm_dgemm_dtrsm_nt_4x4_vs_lib4_new(m-i, n, k, &pA[i*sda], pB, sdb, pR, ir, &pW[0], 1, &pC[i*sdc], &pW[i*sdw], &pD[i*sdd], &pD[0], &inv_diag_D[0]);
+		j = 4;
+		for(; j<i && j<n-2; j+=4)
+			{
+			kernel_dgemm_dtrsm_nt_4x4_vs_lib4_new(m-i, n-j, k, 0, &pW[i*sdw], &pW[j*sdw], j, &pD[i*sdd], &pD[j*sdd], 1, &pC[j*bs+i*sdc], &pD[j*bs+i*sdd], &pD[j*bs+j*sdd], 1, &inv_diag_D[j]);
+			}
+		if(j<i) // dtrsm
+			{
+			if(j<n)
+				{
+				kernel_dgemm_dtrsm_nt_4x2_vs_lib4_new(m-i, n-j, k, 0, &pW[i*sdw], &pW[j*sdw], j, &pD[i*sdd], &pD[j*sdd], 1, &pC[j*bs+i*sdc], &pD[j*bs+i*sdd], &pD[j*bs+j*sdd], 1, &inv_diag_D[j]);
+				}
+			}
+		else // dpotrf
+			{
+			if(j<n-2)
+				{
+				kernel_dsyrk_dpotrf_nt_4x4_vs_lib4_new(m-i, n-j, k, 0, &pW[i*sdw], &pW[j*sdw], j, &pD[i*sdd], &pD[j*sdd], 1, &pC[j*bs+i*sdc], &pD[j*bs+i*sdd], &inv_diag_D[j]);
+				}
+			else if(j<n)
+				{
+				kernel_dsyrk_dpotrf_nt_4x2_vs_lib4_new(m-i, n-j, k, 0, &pW[i*sdw], &pW[j*sdw], j, &pD[i*sdd], &pD[j*sdd], 1, &pC[j*bs+i*sdc], &pD[j*bs+i*sdd], &inv_diag_D[j]);
+				}
+			}
+		}
+
+#else
+
+	// no fused kernel for this target
+	dtrmm_nt_u_lib(m, k, pA, sda, pB, sdb, pW, sdw);
+	if(pR!=NULL)
+		{
+		i = m-1;
+		for(j=0; j<k; j++)
+			pW[i/bs*bs*sdw+i%bs+j*bs] += pR[j*bs];
+		}
+	dsyrk_dpotrf_lib(m, n, k, pW, sdw, pW, sdw, 1, pC, sdc, pD, sdd, inv_diag_D);
+
+#endif
+
+	}
+#endif
+
+
+
 #if ! defined(BLASFEO)
 // TODO modify kernels instead
 void dgemv_n_lib(int m, int n, double *pA, int sda, double *x, int alg, double *y, double *z) // pA has to be aligned !!!
@@ -4873,7 +5037,16 @@ void dgemv_n_lib(int m, int n, double *pA, int sda, double *x, int alg, double *
 	int i, j;
 
 	j=0;
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX512)
+	for(; j<m-15; j+=16)
+		{
+		kernel_dgemv_n_16_lib4(n, pA, sda, x, y, z, alg);
+		pA += 4*sda*bs;
+		y  += 4*bs;
+		z  += 4*bs;
+		}
+#endif
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 	for(; j<m-11; j+=12)
 		{
 		kernel_dgemv_n_12_lib4(n, pA, sda, x, y, z, alg);
@@ -4936,7 +5109,13 @@ void dgemv_t_lib(int m, int n, double *pA, int sda, double *x, int alg, double *
 	int j;
 	
 	j=0;
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX512)
+	for(; j<n-15; j+=16)
+		{
+		kernel_dgemv_t_16_lib4(m, pA+j*bs, sda, x, y+j, z+j, alg);
+		}
+#endif
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 	for(; j<n-11; j+=12)
 		{
 		kernel_dgemv_t_12_lib4(m, pA+j*bs, sda, x, y+j, z+j, alg);
@@ -4977,7 +5156,7 @@ void dtrmv_u_n_lib(int m, double *pA, int sda, double *x, int alg, double *y)
 	int j;
 	
 	j=0;
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	for(; j<m-11; j+=12)
 		{
 		kernel_dtrmv_u_n_12_lib4(m-j, pA, sda, x, y, alg);
@@ -5036,7 +5215,7 @@ void dtrmv_u_t_lib(int m, double *pA, int sda, double *x, int alg, double *y)
 	double *ptrA;
 	
 	j=0;
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	for(; j<m-11; j+=12)
 		{
 		kernel_dtrmv_u_t_12_lib4(j, pA, sda, x, y, alg);
@@ -5103,7 +5282,7 @@ void dsymv_lib(int m, int n, double *pA, int sda, double *x, int alg, double *y,
 		}
 	
 	j=0;
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 	for(; j<n-11; j+=12)
 		{
 		kernel_dsymv_6_lib4(m-j, pA+j*sda+j*bs, sda, x+j, z+j, z+j, x+j, z+j, z+j, 1, alg, alg);
@@ -5176,7 +5355,7 @@ void dgemv_nt_lib(int m, int n, double *pA, int sda, double *x_n, double *x_t, i
 		}
 	
 	j=0;
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 	for(; j<n-5; j+=6)
 		{
 		kernel_dsymv_6_lib4(m, pA+j*bs, sda, x_n+j, z_n, z_n, x_t, z_t+j, z_t+j, 0, alg_n, alg_t);
@@ -5220,7 +5399,7 @@ void dtrsv_n_lib(int m, int n, double *pA, int sda, int use_inv_diag_A, double *
 			y[i] = x[i];
 
 	j = 0;
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	for(; j<n-11; j+=12)
 		{
 		kernel_dtrsv_n_12_lib4_new(j, &pA[j*sda], sda, use_inv_diag_A, &inv_diag_A[j], x, &y[j]);
@@ -5240,7 +5419,7 @@ void dtrsv_n_lib(int m, int n, double *pA, int sda, int use_inv_diag_A, double *
 		kernel_dtrsv_n_4_vs_lib4_new(m-j, n-j, j, &pA[j*sda], use_inv_diag_A, &inv_diag_A[j], x, &y[j]);
 		j += 4;
 		}
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 	for(; j<m-11; j+=12)
 		{
 		kernel_dgemv_n_12_lib4(n, &pA[j*sda], sda, x, &y[j], &y[j], -1);
@@ -5306,6 +5485,12 @@ void dtrsv_t_lib(int m, int n, double *pA, int sda, int use_inv_diag_A, double *
 		kernel_dtrsv_t_3_lib4_new(m-n+j+3, pA+(n/bs)*bs*sda+(n-j-3)*bs, sda, use_inv_diag_A, inv_diag_A+n-j-3, y+n-j-3);
 		j+=3;
 		}
+#if defined(TARGET_X64_AVX512)
+	for(; j<n-7; j+=8)
+		{
+		kernel_dtrsv_t_8_lib4_new(m-n+j+8, pA+((n-j-8)/bs)*bs*sda+(n-j-8)*bs, sda, use_inv_diag_A, inv_diag_A+n-j-8, y+n-j-8);
+		}
+#endif
 	for(; j<n-3; j+=4)
 		{
 		kernel_dtrsv_t_4_lib4_new(m-n+j+4, pA+((n-j-4)/bs)*bs*sda+(n-j-4)*bs, sda, use_inv_diag_A, inv_diag_A+n-j-4, y+n-j-4);
@@ -5323,7 +5508,7 @@ void daxpy_lib(int kmax, double alpha, double *x, double *y)
 
 	int ii;
 
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 	__m256d
 		v_alpha, v_tmp,
 		v_x0, v_y0,
@@ -5331,7 +5516,7 @@ void daxpy_lib(int kmax, double alpha, double *x, double *y)
 #endif
 
 	ii = 0;
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	v_alpha = _mm256_broadcast_sd( &alpha );
 	for( ; ii<kmax-7; ii+=8)
 		{
@@ -5339,7 +5524,7 @@ void daxpy_lib(int kmax, double alpha, double *x, double *y)
 		v_x1  = _mm256_load_pd( &x[ii+4] );
 		v_y0  = _mm256_load_pd( &y[ii+0] );
 		v_y1  = _mm256_load_pd( &y[ii+4] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		v_y0  = _mm256_fmadd_pd( v_alpha, v_x0, v_y0 );
 		v_y1  = _mm256_fmadd_pd( v_alpha, v_x1, v_y1 );
 #else // AVX
@@ -5355,7 +5540,7 @@ void daxpy_lib(int kmax, double alpha, double *x, double *y)
 		{
 		v_x0  = _mm256_load_pd( &x[ii] );
 		v_y0  = _mm256_load_pd( &y[ii] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		v_y0  = _mm256_fmadd_pd( v_alpha, v_x0, v_y0 );
 #else
 		v_tmp = _mm256_mul_pd( v_alpha, v_x0 );
@@ -5391,7 +5576,7 @@ void daxpy_bkp_lib(int kmax, double alpha, double *x, double *y, double *z)
 
 	int ii;
 
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 	__m256d
 		v_alpha, v_tmp,
 		v_x0, v_y0,
@@ -5399,7 +5584,7 @@ void daxpy_bkp_lib(int kmax, double alpha, double *x, double *y, double *z)
 #endif
 
 	ii = 0;
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 	v_alpha = _mm256_broadcast_sd( &alpha );
 	for( ; ii<kmax-7; ii+=8)
 		{
@@ -5409,7 +5594,7 @@ void daxpy_bkp_lib(int kmax, double alpha, double *x, double *y, double *z)
 		v_x1  = _mm256_loadu_pd( &x[ii+4] );
 		_mm256_storeu_pd( &z[ii+0], v_y0 );
 		_mm256_storeu_pd( &z[ii+4], v_y1 );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		v_y0  = _mm256_fmadd_pd( v_alpha, v_x0, v_y0 );
 		v_y1  = _mm256_fmadd_pd( v_alpha, v_x1, v_y1 );
 #else // AVX
@@ -5426,7 +5611,7 @@ void daxpy_bkp_lib(int kmax, double alpha, double *x, double *y, double *z)
 		v_y0  = _mm256_loadu_pd( &y[ii] );
 		v_x0  = _mm256_loadu_pd( &x[ii] );
 		_mm256_storeu_pd( &z[ii], v_y0 );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		v_y0  = _mm256_fmadd_pd( v_alpha, v_x0, v_y0 );
 #else
 		v_tmp = _mm256_mul_pd( v_alpha, v_x0 );
@@ -6110,7 +6295,7 @@ void dgecp_lib(int m, int n, int offsetA, double *A, int sda, int offsetB, doubl
 				}
 			}
 		// main loop
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		for(; ii<m-7; ii+=8)
 			{
 			kernel_dgecp_8_0_lib4(0, n, A, sda, B, sdb);
@@ -6179,7 +6364,7 @@ void dgecp_lib(int m, int n, int offsetA, double *A, int sda, int offsetB, doubl
 				}
 			}
 		// main loop
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		for( ; ii<m-7; ii+=8)
 			{
 			kernel_dgecp_8_1_lib4(0, n, A, sda, B, sdb);
@@ -6248,7 +6433,7 @@ void dgecp_lib(int m, int n, int offsetA, double *A, int sda, int offsetB, doubl
 				}
 			}
 		// main loop
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		for(; ii<m-7; ii+=8)
 			{
 			kernel_dgecp_8_2_lib4(0, n, A, sda, B, sdb);
@@ -6317,7 +6502,7 @@ void dgecp_lib(int m, int n, int offsetA, double *A, int sda, int offsetB, doubl
 				}
 			}
 		// main loop
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		for(; ii<m-7; ii+=8)
 			{
 			kernel_dgecp_8_3_lib4(0, n, A, sda, B, sdb);
@@ -6415,7 +6600,7 @@ void dtrcp_l_lib(int m, int offsetA, double *A, int sda, int offsetB, double *B,
 				}
 			}
 		// main loop
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		for(; ii<m-7; ii+=8)
 			{
 			kernel_dgecp_8_0_lib4(1, ii, A, sda, B, sdb);
@@ -6484,7 +6669,7 @@ void dtrcp_l_lib(int m, int offsetA, double *A, int sda, int offsetB, double *B,
 				}
 			}
 		// main loop
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		for( ; ii<m-7; ii+=8)
 			{
 			kernel_dgecp_8_1_lib4(1, ii, A, sda, B, sdb);
@@ -6553,7 +6738,7 @@ void dtrcp_l_lib(int m, int offsetA, double *A, int sda, int offsetB, double *B,
 				}
 			}
 		// main loop
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		for(; ii<m-7; ii+=8)
 			{
 			kernel_dgecp_8_2_lib4(1, ii, A, sda, B, sdb);
@@ -6622,7 +6807,7 @@ void dtrcp_l_lib(int m, int offsetA, double *A, int sda, int offsetB, double *B,
 				}
 			}
 		// main loop
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		for(; ii<m-7; ii+=8)
 			{
 			kernel_dgecp_8_3_lib4(1, ii, A, sda, B, sdb);
@@ -6718,7 +6903,7 @@ void dgead_lib(int m, int n, double alpha, int offsetA, double *A, int sda, int
 				}
 			}
 		// main loop
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		for(; ii<m-7; ii+=8)
 			{
 			kernel_dgead_8_0_lib4(n, alpha, A, sda, B, sdb);
@@ -6787,7 +6972,7 @@ void dgead_lib(int m, int n, double alpha, int offsetA, double *A, int sda, int
 				}
 			}
 		// main loop
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		for( ; ii<m-7; ii+=8)
 			{
 			kernel_dgead_8_1_lib4(n, alpha, A, sda, B, sdb);
@@ -6856,7 +7041,7 @@ void dgead_lib(int m, int n, double alpha, int offsetA, double *A, int sda, int
 				}
 			}
 		// main loop
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		for(; ii<m-7; ii+=8)
 			{
 			kernel_dgead_8_2_lib4(n, alpha, A, sda, B, sdb);
@@ -6925,7 +7110,7 @@ void dgead_lib(int m, int n, double alpha, int offsetA, double *A, int sda, int
 				}
 			}
 		// main loop
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		for(; ii<m-7; ii+=8)
 			{
 			kernel_dgead_8_3_lib4(n, alpha, A, sda, B, sdb);
@@ -7010,7 +7195,7 @@ C =
 		pA += mna + bs*(sda-1);
 		pC += mna*bs;
 		}
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	for( ; ii<m-7; ii+=8)
 		{
 		kernel_dgetr_8_lib4(0, n, nna, pA, sda, pC, sdc);
@@ -7513,7 +7698,7 @@ void dlauum_lib(int m, double *pA, int sda, double *pB, int sdb, int alg, double
 	
 	ii = 0;
 // TODO unify kernels for dtrmm_l_u and dlauum using a flag !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	for( ; ii<m-11; ii+=12)
 		{
 		// off-diagonal blocks
@@ -7623,7 +7808,7 @@ void dtrtri_lib(int m, double *pA, int sda, int use_inv_diag_A, double *inv_diag
 	int n = m; // just to distinguish between rows and colscan be removed
 
 	ii = 0;
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	for( ; ii<m-11; ii+=12)
 		{
 		jj = ii;
@@ -7973,7 +8158,7 @@ void dgetrf_lib(int m, int n, double *pC, int sdc, double *pD, int sdd, double *
 	int ii, jj, ie;
 
 	// main loop
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 	ii = 0;
 	for( ; ii<m-7; ii+=8)
 		{
@@ -8131,7 +8316,7 @@ void dgetrf_lib(int m, int n, double *pC, int sdc, double *pD, int sdd, double *
 	// common return if i==m
 	return;
 
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 	left_8:
 	jj = 0;
 	// solve lower
@@ -8276,7 +8461,7 @@ void dgetrf_pivot_lib(int m, int n, double *pC, int sdc, double *pD, int sdd, do
 	p = n<m ? n : m; // XXX
 
 	// main loop
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 	// 8 columns at a time
 	jj = 0;
 	for(; jj<p-7; jj+=8)
@@ -8515,7 +8700,7 @@ void dgetrf_pivot_lib(int m, int n, double *pC, int sdc, double *pD, int sdd, do
 
 
 	// clean up
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 	left_n_8:
 	// 5-8 columns at a time
 	// pivot & factorize & solve lower
@@ -8627,7 +8812,7 @@ void dgetrf_pivot_lib(int m, int n, double *pC, int sdc, double *pD, int sdd, do
 #endif
 
 
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 	left_m_8:
 	// 5-8 rows at a time
 	// pivot & factorize & solve lower
@@ -8728,7 +8913,7 @@ void dgetrf_pivot_lib(int m, int n, double *pC, int sdc, double *pD, int sdd, do
 	// pivot & factorize & solve lower
 	ii = jj;
 	i0 = ii;
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 	for( ; ii<m-4; ii+=8)
 		{
 		kernel_dgemm_nn_8x4_vs_lib4(m-ii, n-jj, jj, &pD[ii*sdd], sdd, &pD[jj*bs], sdd, -1, &pD[jj*bs+ii*sdd], sdd, &pD[jj*bs+ii*sdd], sdd, 0, 0);
@@ -8862,7 +9047,7 @@ void dgetrf_pivot_lib(int m, int n, double *pC, int sdc, double *pD, int sdd, do
 	// pivot & factorize & solve lower
 	ii = jj;
 	i0 = ii;
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX)
 	for( ; ii<m-4; ii+=8)
 		{
 		kernel_dgemm_nn_8x2_vs_lib4(m-ii, n-jj, jj, &pD[ii*sdd], sdd, &pD[jj*bs], sdd, -1, &pD[jj*bs+ii*sdd], sdd, &pD[jj*bs+ii*sdd], sdd, 0, 0);
@@ -8905,7 +9090,7 @@ void dgetrf_pivot_lib(int m, int n, double *pC, int sdc, double *pD, int sdd, do
 	return;
 
 
-#if ! ( defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) )
+#if ! ( defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) )
 	left_m_2:
 	// 1-2 rows at a time
 	// pivot & factorize & solve lower
@@ -38,7 +38,7 @@ void sgemm_nt_lib(int m, int n, int k, float *pA, int sda, float *pB, int sdb, i
 
 	const int bs = 4;
 
-	int i, j, jj;
+	int i, j;
 	
 	i = 0;
 #if defined(TARGET_CORTEX_A15) || defined(TARGET_CORTEX_A57)
@@ -53,7 +53,7 @@ void sgemm_nt_lib(int m, int n, int k, float *pA, int sda, float *pB, int sdb, i
 			kernel_sgemm_nt_12x4_lib4(k, &pA[0+i*sda], &pA[0+(i+4)*sda], &pA[0+(i+8)*sda], &pB[0+j*sdb], &pC[0+(j+0)*bs+i*sdc], &pC[0+(j+0)*bs+(i+4)*sdc], &pC[0+(j+0)*bs+(i+8)*sdc], &pC[0+(j+0)*bs+i*sdc], &pC[0+(j+0)*bs+(i+4)*sdc], &pC[0+(j+0)*bs+(i+8)*sdc], alg);//return;
 #endif
 			}
-		jj = 0;
+/*		jj = 0;*/
 /*		for(; jj<n-j-1; jj+=2)*/
 /*		for(; jj<n-j; jj+=2)*/
 /*			{*/
@@ -75,7 +75,7 @@ void sgemm_nt_lib(int m, int n, int k, float *pA, int sda, float *pB, int sdb, i
 			kernel_sgemm_nt_8x4_lib4(k, &pA[0+i*sda], &pA[0+(i+4)*sda], &pB[0+j*sdb], &pC[0+(j+0)*bs+i*sdc], &pC[0+(j+0)*bs+(i+4)*sdc], &pC[0+(j+0)*bs+i*sdc], &pC[0+(j+0)*bs+(i+4)*sdc], alg);
 #endif
 			}
-		jj = 0;
+/*		jj = 0;*/
 /*		for(; jj<n-j-1; jj+=2)*/
 /*		for(; jj<n-j; jj+=2)*/
 /*			{*/
@@ -95,7 +95,7 @@ void sgemm_nt_lib(int m, int n, int k, float *pA, int sda, float *pB, int sdb, i
 			kernel_sgemm_nt_8x4_lib4(k, &pA[0+i*sda], &pA[0+(i+4)*sda], &pB[0+j*sdb], &pC[0+(j+0)*bs+i*sdc], &pC[0+(j+0)*bs+(i+4)*sdc], &pC[0+(j+0)*bs+i*sdc], &pC[0+(j+0)*bs+(i+4)*sdc], alg);
 #endif
 			}
-		jj = 0;
+/*		jj = 0;*/
 /*		for(; jj<n-j-1; jj+=2)*/
 /*		for(; jj<n-j; jj+=2)*/
 /*			{*/
@@ -118,7 +118,7 @@ void sgemm_nt_lib(int m, int n, int k, float *pA, int sda, float *pB, int sdb, i
 			kernel_sgemm_nt_12x4_lib4(k, &pA[0+i*sda], &pA[0+(i+4)*sda], &pA[0+(i+8)*sda], &pB[0+j*sdb], &pC[0+(j+0)*bs+i*sdc], &pC[0+(j+0)*bs+(i+4)*sdc], &pC[0+(j+0)*bs+(i+8)*sdc], &pC[0+(j+0)*bs+i*sdc], &pC[0+(j+0)*bs+(i+4)*sdc], &pC[0+(j+0)*bs+(i+8)*sdc], alg);//return;
 #endif
 			}
-		jj = 0;
+/*		jj = 0;*/
 /*		for(; jj<n-j-1; jj+=2)*/
 /*		for(; jj<n-j; jj+=2)*/
 /*			{*/
@@ -143,7 +143,7 @@ void sgemm_nt_lib(int m, int n, int k, float *pA, int sda, float *pB, int sdb, i
 			kernel_sgemm_nt_8x4_lib4(k, &pA[0+i*sda], &pA[0+(i+4)*sda], &pB[0+j*sdb], &pC[0+(j+0)*bs+i*sdc], &pC[0+(j+0)*bs+(i+4)*sdc], &pC[0+(j+0)*bs+i*sdc], &pC[0+(j+0)*bs+(i+4)*sdc], alg);
 #endif
 			}
-		jj = 0;
+/*		jj = 0;*/
 /*		for(; jj<n-j-1; jj+=2)*/
 /*		for(; jj<n-j; jj+=2)*/
 /*			{*/
@@ -166,7 +166,7 @@ void sgemm_nt_lib(int m, int n, int k, float *pA, int sda, float *pB, int sdb, i
 			kernel_sgemm_nt_4x4_lib4(k, &pA[0+i*sda], &pB[0+j*sdb], &pC[0+(j+0)*bs+i*sdc], &pC[0+(j+0)*bs+i*sdc], alg);
 #endif
 			}
-		jj = 0;
+/*		jj = 0;*/
 /*		for(; jj<n-j-1; jj+=2)*/
 /*		for(; jj<n-j; jj+=2)*/
 /*			{*/
@@ -531,7 +531,7 @@ void ssyrk_spotrf_lib(int m, int n, int k, float *pA, int sda, float *pC, int sd
 			diag[j+0] = fact[0];
 			diag[j+1] = fact[2];
 			i += 4;
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			for(; i<m-4; i+=8)
 				{
 				kernel_sgemm_strsm_nt_8x2_lib4(k, j, &pA[i*sda], &pA[(i+4)*sda], &pA[j*sda], &pC[j*bs+i*sdc], &pC[j*bs+(i+4)*sdc], &pA[(k0+k+j)*bs+i*sda], &pA[(k0+k+j)*bs+(i+4)*sda], fact);
@@ -728,7 +728,6 @@ void strmv_u_t_lib(int m, float *pA, int sda, float *x, float *y, int alg)
 	
 	int j;
 	
-	float *ptrA;
 	
 	j=0;
 	for(; j<m-7; j+=8)
@@ -41,7 +41,7 @@ void sgemm_nt_lib(int m, int n, int k, float *pA, int sda, float *pB, int sdb, i
 	int i, j, jj;
 	
 	i = 0;
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 	for(; i<m-16; i+=24)
 		{
 		j = 0;
@@ -276,7 +276,7 @@ void ssyrk_spotrf_lib(int m, int n, int k, float *pA, int sda, float *pC, int sd
 			diag[j+6] = fact1[5];
 			diag[j+7] = fact1[9];
 			i += 16;
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			for(; i<m-16; i+=24)
 				{
 				kernel_sgemm_strsm_nt_24x4_lib8(k, j, &pA[i*sda], &pA[(i+8)*sda], &pA[(i+16)*sda], &pA[j*sda], &pC[j*bs+i*sdc], &pC[j*bs+(i+8)*sdc], &pC[j*bs+(i+16)*sdc], &pA[(k0+k+j)*bs+i*sda], &pA[(k0+k+j)*bs+(i+8)*sda], &pA[(k0+k+j)*bs+(i+16)*sda], fact0);
@@ -340,7 +340,7 @@ void ssyrk_spotrf_lib(int m, int n, int k, float *pA, int sda, float *pC, int sd
 /*			diag[j+6] = fact1[5];*/
 /*			diag[j+7] = fact1[9];*/
 			i += 16;
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			for(; i<m-16; i+=24)
 				{
 				kernel_sgemm_strsm_nt_24x4_lib8(k, j, &pA[i*sda], &pA[(i+8)*sda], &pA[(i+16)*sda], &pA[j*sda], &pC[j*bs+i*sdc], &pC[j*bs+(i+8)*sdc], &pC[j*bs+(i+16)*sdc], &pA[(k0+k+j)*bs+i*sda], &pA[(k0+k+j)*bs+(i+8)*sda], &pA[(k0+k+j)*bs+(i+16)*sda], fact0);
@@ -600,7 +600,6 @@ void strmv_u_t_lib(int m, float *pA, int sda, float *x, float *y, int alg)
 	
 	int j;
 	
-	float *ptrA;
 	
 	j=0;
 	for(; j<m-7; j+=8)
@@ -0,0 +1,393 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+// Generator of a Riccati recursion specialized for fixed stage sizes: it emits one C translation
+// unit defining d_back_ric_rec_sv_codegen_libstr, a drop-in replacement of d_back_ric_rec_sv_libstr
+// where the factorization and the solution of each stage are fully unrolled.
+//
+// usage: d_back_ric_rec_codegen.out nx0 nu0 nb0 ng0 nx nu nb ng nbN ngN file.c
+// nx0, nu0, nb0, ng0 are the sizes of the first stage (where typically nx0=0, or nb0 boxes x0),
+// nx, nu, nb, ng the ones of the stages 1,...,N-1, nbN and ngN the ones of the last stage (where
+// nu is 0 and nx is the one of the middle stages). If the sizes passed at run time differ, the
+// generic recursion is called.
+
+#include <stdlib.h>
+#include <stdio.h>
+
+
+
+static FILE *f;
+
+
+
+// M = RSQrq + box and general constraints Hessian, as (nux+1) x nux lower matrix
+static void emit_init_M(int nux, int nb, int ng)
+	{
+
+	int ii, jj, kk;
+
+	int ld = nux+1;
+
+	fprintf(f, "\t// stage Hessian and gradient\n");
+	for(jj=0; jj<nux; jj++)
+		for(ii=jj; ii<nux; ii++)
+			fprintf(f, "\tM[%d] = BLASFEO_DMATEL(sRSQrq, %d, %d);\n", ii+ld*jj, ii, jj);
+	fprintf(f, "\tif(update_q)\n\t\t{\n");
+	for(jj=0; jj<nux; jj++)
+		fprintf(f, "\t\tM[%d] = BLASFEO_DVECEL(srq, %d);\n", nux+ld*jj, jj);
+	fprintf(f, "\t\t}\n\telse\n\t\t{\n");
+	for(jj=0; jj<nux; jj++)
+		fprintf(f, "\t\tM[%d] = BLASFEO_DMATEL(sRSQrq, %d, %d);\n", nux+ld*jj, nux, jj);
+	fprintf(f, "\t\t}\n");
+
+	if(nb>0)
+		{
+		fprintf(f, "\t// box constraints\n");
+		for(ii=0; ii<nb; ii++)
+			{
+			fprintf(f, "\tM[%d*idxb[%d]] += BLASFEO_DVECEL(sQx, %d);\n", ld+1, ii, ii);
+			fprintf(f, "\tM[%d+%d*idxb[%d]] += BLASFEO_DVECEL(sqx, %d);\n", nux, ld, ii, ii);
+			}
+		}
+
+	if(ng>0)
+		{
+		fprintf(f, "\t// general constraints\n");
+		for(kk=0; kk<ng; kk++)
+			{
+			for(ii=0; ii<nux; ii++)
+				fprintf(f, "\tD[%d] = BLASFEO_DMATEL(sDCt, %d, %d);\n", ii+nux*kk, ii, kk);
+			for(ii=0; ii<nux; ii++)
+				fprintf(f, "\tDQ[%d] = D[%d]*BLASFEO_DVECEL(sQx, %d);\n", ii+ld*kk, ii+nux*kk, nb+kk);
+			fprintf(f, "\tDQ[%d] = BLASFEO_DVECEL(sqx, %d);\n", nux+ld*kk, nb+kk);
+			}
+		for(jj=0; jj<nux; jj++)
+			for(ii=jj; ii<=nux; ii++)
+				{
+				fprintf(f, "\tM[%d] +=", ii+ld*jj);
+				for(kk=0; kk<ng; kk++)
+					fprintf(f, "%s DQ[%d]*D[%d]", kk==0 ? "" : " +", ii+ld*kk, jj+nux*kk);
+				fprintf(f, ";\n");
+				}
+		}
+
+	}
+
+
+
+// M += W * W', with W (nux+1) x nx
+static void emit_syrk_W(int nux, int nx)
+	{
+
+	int ii, jj, kk;
+
+	int ld = nux+1;
+
+	fprintf(f, "\t// syrk\n");
+	for(jj=0; jj<nux; jj++)
+		for(ii=jj; ii<=nux; ii++)
+			{
+			fprintf(f, "\tM[%d] +=", ii+ld*jj);
+			for(kk=0; kk<nx; kk++)
+				fprintf(f, "%s W[%d]*W[%d]", kk==0 ? "" : " +", ii+ld*kk, jj+ld*kk);
+			fprintf(f, ";\n");
+			}
+
+	}
+
+
+
+// cholesky factorization of the (nux+1) x nux lower matrix M, stored into sL
+static void emit_potrf_store(int nux)
+	{
+
+	int ii, jj, kk;
+
+	int ld = nux+1;
+
+	fprintf(f, "\t// potrf\n");
+	for(jj=0; jj<nux; jj++)
+		{
+		fprintf(f, "\td_00 = M[%d]", jj+ld*jj);
+		for(kk=0; kk<jj; kk++)
+			fprintf(f, " - M[%d]*M[%d]", jj+ld*kk, jj+ld*kk);
+		fprintf(f, ";\n");
+		fprintf(f, "\tif(d_00>0.0)\n\t\t{\n\t\td_00 = sqrt(d_00);\n\t\tinv_d_00 = 1.0/d_00;\n\t\t}\n");
+		fprintf(f, "\telse\n\t\t{\n\t\td_00 = 0.0;\n\t\tinv_d_00 = 0.0;\n\t\t}\n");
+		fprintf(f, "\tM[%d] = d_00;\n", jj+ld*jj);
+		for(ii=jj+1; ii<=nux; ii++)
+			{
+			fprintf(f, "\tM[%d] = (M[%d]", ii+ld*jj, ii+ld*jj);
+			for(kk=0; kk<jj; kk++)
+				fprintf(f, " - M[%d]*M[%d]", ii+ld*kk, jj+ld*kk);
+			fprintf(f, ") * inv_d_00;\n");
+			}
+		}
+
+	fprintf(f, "\t// store\n");
+	for(jj=0; jj<nux; jj++)
+		for(ii=jj; ii<=nux; ii++)
+			fprintf(f, "\tBLASFEO_DMATEL(sL, %d, %d) = M[%d];\n", ii, jj, ii+ld*jj);
+	fprintf(f, "\tsL->use_dA = 0;\n");
+
+	}
+
+
+
+// factorization of the last stage
+static void emit_trf_last(int nx, int nb, int ng)
+	{
+
+	int nux = nx;
+	int ld = nux+1;
+
+	fprintf(f, "static void d_ric_trf_last(int update_q, struct blasfeo_dmat *sRSQrq, struct blasfeo_dvec *srq, struct blasfeo_dmat *sDCt, struct blasfeo_dvec *sQx, struct blasfeo_dvec *sqx, int *idxb, struct blasfeo_dmat *sL)\n");
+	fprintf(f, "\t{\n\n");
+	fprintf(f, "\tdouble M[%d];\n", ld*nux);
+	if(ng>0)
+		fprintf(f, "\tdouble D[%d], DQ[%d];\n", nux*ng, ld*ng);
+	fprintf(f, "\tdouble d_00, inv_d_00;\n\n");
+
+	emit_init_M(nux, nb, ng);
+	emit_potrf_store(nux);
+
+	fprintf(f, "\n\treturn;\n\n\t}\n\n\n\n");
+
+	}
+
+
+
+// factorization of one stage, whose next stage has nx1 states
+static void emit_trf_stage(char *name, int nx, int nu, int nb, int ng, int nx1)
+	{
+
+	int ii, jj, kk;
+
+	int nux = nu+nx;
+	int ld = nux+1;
+
+	fprintf(f, "static void %s(int update_b, int update_q, int compute_Pb, int nu1, struct blasfeo_dmat *sL1, struct blasfeo_dvec *sPb1, struct blasfeo_dmat *sBAbt, struct blasfeo_dvec *sb, struct blasfeo_dmat *sRSQrq, struct blasfeo_dvec *srq, struct blasfeo_dmat *sDCt, struct blasfeo_dvec *sQx, struct blasfeo_dvec *sqx, int *idxb, struct blasfeo_dmat *sL)\n", name);
+	fprintf(f, "\t{\n\n");
+	fprintf(f, "\tdouble M[%d], BA[%d], W[%d], Lx[%d];\n", ld*nux, ld*nx1, ld*nx1, nx1*nx1);
+	if(ng>0)
+		fprintf(f, "\tdouble D[%d], DQ[%d];\n", nux*ng, ld*ng);
+	fprintf(f, "\tdouble d_00, inv_d_00;\n\n");
+
+	fprintf(f, "\tif(update_b)\n\t\t{\n");
+	for(jj=0; jj<nx1; jj++)
+		fprintf(f, "\t\tBLASFEO_DMATEL(sBAbt, %d, %d) = BLASFEO_DVECEL(sb, %d);\n", nux, jj, jj);
+	fprintf(f, "\t\t}\n\n");
+
+	fprintf(f, "\t// load\n");
+	for(jj=0; jj<nx1; jj++)
+		for(ii=0; ii<=nux; ii++)
+			fprintf(f, "\tBA[%d] = BLASFEO_DMATEL(sBAbt, %d, %d);\n", ii+ld*jj, ii, jj);
+	for(jj=0; jj<nx1; jj++)
+		for(ii=jj; ii<nx1; ii++)
+			fprintf(f, "\tLx[%d] = BLASFEO_DMATEL(sL1, nu1+%d, nu1+%d);\n", ii+nx1*jj, ii, jj);
+
+	fprintf(f, "\t// trmm\n");
+	for(jj=0; jj<nx1; jj++)
+		for(ii=0; ii<=nux; ii++)
+			{
+			fprintf(f, "\tW[%d] =", ii+ld*jj);
+			for(kk=jj; kk<nx1; kk++)
+				fprintf(f, "%s BA[%d]*Lx[%d]", kk==jj ? "" : " +", ii+ld*kk, kk+nx1*jj);
+			fprintf(f, ";\n");
+			}
+
+	fprintf(f, "\tif(compute_Pb)\n\t\t{\n");
+	for(ii=0; ii<nx1; ii++)
+		{
+		fprintf(f, "\t\tBLASFEO_DVECEL(sPb1, %d) =", ii);
+		for(kk=0; kk<=ii; kk++)
+			fprintf(f, "%s Lx[%d]*W[%d]", kk==0 ? "" : " +", ii+nx1*kk, nux+ld*kk);
+		fprintf(f, ";\n");
+		}
+	fprintf(f, "\t\t}\n");
+
+	for(jj=0; jj<nx1; jj++)
+		fprintf(f, "\tW[%d] += BLASFEO_DMATEL(sL1, nu1+%d, nu1+%d);\n", nux+ld*jj, nx1, jj);
+
+	emit_init_M(nux, nb, ng);
+	emit_syrk_W(nux, nx1);
+	emit_potrf_store(nux);
+
+	fprintf(f, "\n\treturn;\n\n\t}\n\n\n\n");
+
+	}
+
+
+
+// forward substitution of one stage: solves for the first nsol components of ux (all of them in the first stage),
+// computes the nx1 states of the next stage and optionally the equality multipliers
+static void emit_trs_stage(char *name, int nx, int nu, int nsol, int nx1)
+	{
+
+	int ii, jj;
+
+	int nux = nu+nx;
+
+	fprintf(f, "static void %s(int compute_pi, int nu1, struct blasfeo_dmat *sL, struct blasfeo_dmat *sL1, struct blasfeo_dmat *sBAbt, struct blasfeo_dvec *sux, struct blasfeo_dvec *sux1, struct blasfeo_dvec *spi1)\n", name);
+	fprintf(f, "\t{\n\n");
+	fprintf(f, "\tdouble ux[%d], x1[%d], Lx[%d], p[%d];\n\n", nux, nx1, nx1*nx1, nx1);
+
+	for(ii=0; ii<nsol; ii++)
+		fprintf(f, "\tux[%d] = - BLASFEO_DMATEL(sL, %d, %d);\n", ii, nux, ii);
+	for(ii=nsol; ii<nux; ii++)
+		fprintf(f, "\tux[%d] = BLASFEO_DVECEL(sux, %d);\n", ii, ii);
+
+	fprintf(f, "\t// trsv\n");
+	for(jj=nsol-1; jj>=0; jj--)
+		{
+		fprintf(f, "\tux[%d] = (ux[%d]", jj, jj);
+		for(ii=jj+1; ii<nux; ii++)
+			fprintf(f, " - BLASFEO_DMATEL(sL, %d, %d)*ux[%d]", ii, jj, ii);
+		fprintf(f, ") / BLASFEO_DMATEL(sL, %d, %d);\n", jj, jj);
+		}
+	for(ii=0; ii<nsol; ii++)
+		fprintf(f, "\tBLASFEO_DVECEL(sux, %d) = ux[%d];\n", ii, ii);
+
+	fprintf(f, "\t// dynamics\n");
+	for(jj=0; jj<nx1; jj++)
+		{
+		fprintf(f, "\tx1[%d] = BLASFEO_DMATEL(sBAbt, %d, %d)", jj, nux, jj);
+		for(ii=0; ii<nux; ii++)
+			fprintf(f, " + BLASFEO_DMATEL(sBAbt, %d, %d)*ux[%d]", ii, jj, ii);
+		fprintf(f, ";\n");
+		}
+	for(jj=0; jj<nx1; jj++)
+		fprintf(f, "\tBLASFEO_DVECEL(sux1, nu1+%d) = x1[%d];\n", jj, jj);
+
+	fprintf(f, "\tif(compute_pi)\n\t\t{\n");
+	for(jj=0; jj<nx1; jj++)
+		for(ii=jj; ii<nx1; ii++)
+			fprintf(f, "\t\tLx[%d] = BLASFEO_DMATEL(sL1, nu1+%d, nu1+%d);\n", ii+nx1*jj, ii, jj);
+	for(jj=0; jj<nx1; jj++)
+		{
+		fprintf(f, "\t\tp[%d] = BLASFEO_DMATEL(sL1, nu1+%d, nu1+%d)", jj, nx1, jj);
+		for(ii=jj; ii<nx1; ii++)
+			fprintf(f, " + Lx[%d]*x1[%d]", ii+nx1*jj, ii);
+		fprintf(f, ";\n");
+		}
+	for(ii=0; ii<nx1; ii++)
+		{
+		fprintf(f, "\t\tBLASFEO_DVECEL(spi1, %d) =", ii);
+		for(jj=0; jj<=ii; jj++)
+			fprintf(f, "%s Lx[%d]*p[%d]", jj==0 ? "" : " +", ii+nx1*jj, jj);
+		fprintf(f, ";\n");
+		}
+	fprintf(f, "\t\t}\n");
+
+	fprintf(f, "\n\treturn;\n\n\t}\n\n\n\n");
+
+	}
+
+
+
+static void emit_driver(int nx0, int nu0, int nb0, int ng0, int nx, int nu, int nb, int ng, int nbN, int ngN)
+	{
+
+	fprintf(f, "void d_back_ric_rec_sv_codegen_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int update_b, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, int update_q, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dvec *hsqx, struct blasfeo_dvec *hsux, int compute_pi, struct blasfeo_dvec *hspi, int compute_Pb, struct blasfeo_dvec *hsPb, struct blasfeo_dmat *hsL, void *work)\n");
+	fprintf(f, "\t{\n\n");
+	fprintf(f, "\tint nn;\n\n");
+
+	fprintf(f, "\t// fall back to the generic recursion if the sizes are not the generated ones\n");
+	fprintf(f, "\tint generated = N>0 & nx[N]==%d & nu[N]==0 & nb[N]==%d & ng[N]==%d;\n", nx, nbN, ngN);
+	fprintf(f, "\tgenerated &= nx[0]==%d & nu[0]==%d & nb[0]==%d & ng[0]==%d;\n", nx0, nu0, nb0, ng0);
+	fprintf(f, "\tfor(nn=1; nn<N; nn++)\n");
+	fprintf(f, "\t\tgenerated &= nx[nn]==%d & nu[nn]==%d & nb[nn]==%d & ng[nn]==%d;\n", nx, nu, nb, ng);
+	fprintf(f, "\tif(!generated)\n\t\t{\n");
+	fprintf(f, "\t\td_back_ric_rec_sv_libstr(N, nx, nu, nb, hidxb, ng, update_b, hsBAbt, hsb, update_q, hsRSQrq, hsrq, hsDCt, hsQx, hsqx, hsux, compute_pi, hspi, compute_Pb, hsPb, hsL, work);\n");
+	fprintf(f, "\t\treturn;\n\t\t}\n\n");
+
+	fprintf(f, "\t// factorization and backward substitution\n");
+	fprintf(f, "\td_ric_trf_last(update_q, &hsRSQrq[N], &hsrq[N], &hsDCt[N], &hsQx[N], &hsqx[N], hidxb[N], &hsL[N]);\n");
+	fprintf(f, "\tfor(nn=N-1; nn>0; nn--)\n");
+	fprintf(f, "\t\td_ric_trf_stage(update_b, update_q, compute_Pb, nu[nn+1], &hsL[nn+1], &hsPb[nn+1], &hsBAbt[nn], &hsb[nn], &hsRSQrq[nn], &hsrq[nn], &hsDCt[nn], &hsQx[nn], &hsqx[nn], hidxb[nn], &hsL[nn]);\n");
+	fprintf(f, "\td_ric_trf_first(update_b, update_q, compute_Pb, nu[1], &hsL[1], &hsPb[1], &hsBAbt[0], &hsb[0], &hsRSQrq[0], &hsrq[0], &hsDCt[0], &hsQx[0], &hsqx[0], hidxb[0], &hsL[0]);\n\n");
+
+	fprintf(f, "\t// forward substitution\n");
+	fprintf(f, "\td_ric_trs_first(compute_pi, nu[1], &hsL[0], &hsL[1], &hsBAbt[0], &hsux[0], &hsux[1], &hspi[1]);\n");
+	fprintf(f, "\tfor(nn=1; nn<N; nn++)\n");
+	fprintf(f, "\t\td_ric_trs_stage(compute_pi, nu[nn+1], &hsL[nn], &hsL[nn+1], &hsBAbt[nn], &hsux[nn], &hsux[nn+1], &hspi[nn+1]);\n\n");
+
+	fprintf(f, "\treturn;\n\n\t}\n\n");
+
+	}
+
+
+
+int main(int argc, char **argv)
+	{
+
+	if(argc!=12)
+		{
+		printf("\nusage: %s nx0 nu0 nb0 ng0 nx nu nb ng nbN ngN file.c\n\n", argv[0]);
+		return 1;
+		}
+
+	int nx0 = atoi(argv[1]);
+	int nu0 = atoi(argv[2]);
+	int nb0 = atoi(argv[3]);
+	int ng0 = atoi(argv[4]);
+	int nx  = atoi(argv[5]);
+	int nu  = atoi(argv[6]);
+	int nb  = atoi(argv[7]);
+	int ng  = atoi(argv[8]);
+	int nbN = atoi(argv[9]);
+	int ngN = atoi(argv[10]);
+
+	if(nx0<0 | nu0<0 | nu0+nx0<1 | nb0<0 | nb0>nu0+nx0 | ng0<0 | nx<1 | nu<0 | nb<0 | nb>nu+nx | ng<0 | nbN<0 | nbN>nx | ngN<0)
+		{
+		printf("\nerror: d_back_ric_rec_codegen: invalid sizes nx0=%d nu0=%d nb0=%d ng0=%d nx=%d nu=%d nb=%d ng=%d nbN=%d ngN=%d\n\n", nx0, nu0, nb0, ng0, nx, nu, nb, ng, nbN, ngN);
+		return 1;
+		}
+
+	f = fopen(argv[11], "w");
+	if(f==NULL)
+		{
+		printf("\nerror: d_back_ric_rec_codegen: cannot open %s\n\n", argv[11]);
+		return 1;
+		}
+
+	fprintf(f, "// generated by d_back_ric_rec_codegen.out for nx0=%d nu0=%d nb0=%d ng0=%d nx=%d nu=%d nb=%d ng=%d nbN=%d ngN=%d, do not edit\n\n", nx0, nu0, nb0, ng0, nx, nu, nb, ng, nbN, ngN);
+	fprintf(f, "#include <math.h>\n\n");
+	fprintf(f, "#include <blasfeo_target.h>\n");
+	fprintf(f, "#include <blasfeo_common.h>\n\n");
+	fprintf(f, "#include \"../include/lqcp_solvers.h\"\n\n\n\n");
+
+	emit_trf_last(nx, nbN, ngN);
+	emit_trf_stage("d_ric_trf_first", nx0, nu0, nb0, ng0, nx);
+	emit_trf_stage("d_ric_trf_stage", nx, nu, nb, ng, nx);
+	emit_trs_stage("d_ric_trs_first", nx0, nu0, nu0+nx0, nx);
+	emit_trs_stage("d_ric_trs_stage", nx, nu, nu, nx);
+	emit_driver(nx0, nu0, nb0, ng0, nx, nu, nb, ng, nbN, ngN);
+
+	fclose(f);
+
+	return 0;
+
+	}
@@ -29,8 +29,10 @@ extern "C" {
 
 
 
+#if ! defined(BLASFEO)
 void s_zeros(float **pA, int row, int col);
 void s_zeros_align(float **pA, int row, int col);
+#endif
 void s_eye(float **pA, int row);
 void s_copy_mat(int row, int col, float *A, int lda, float *B, int ldb);
 void s_copy_pmat(int row, int col, int bs, float *A, int sda, float *B, int sdb);
@@ -43,7 +45,10 @@ void cvt_d2s_mat2pmat(int row, int col, int offset, int bs_dummy, double *A, int
 void s_cvt_tran_mat2pmat(int row, int col, int offset, int bs, float *A, int lda, float *B, int sdb);
 void cvt_tran_d2s_mat2pmat(int row, int col, int offset, int bs_dummy, double *A, int lda, float *pA, int sda);
 void s_cvt_pmat2mat(int row, int col, int offset, int bs, float *pA, int sda, float *A, int lda);
+#if ! defined(BLASFEO)
 void s_print_mat(int row, int col, float *A, int lda);
+void s_print_mat_e(int row, int col, float *A, int lda);
+#endif
 void s_print_pmat(int row, int col, int bs, float *A, int sda);
 
 
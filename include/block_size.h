@@ -23,9 +23,24 @@
 *                                                                                                 *
 **************************************************************************************************/
 
-#if defined( TARGET_X64_AVX2 )
+#if defined( TARGET_X64_AVX512 )
 
+// panel size as X64_AVX2: the 8x8 kernels keep a column of two 4-row panels in a zmm register
 #define D_MR 4
+#define D_BATCH 8 // problems interleaved across simd lanes in the batched solvers
+#define S_MR 8
+#if defined BLASFEO // XXX
+#define D_NCL 4
+#define S_NCL 4
+#else
+#define D_NCL 2
+#define S_NCL 2
+#endif
+
+#elif defined( TARGET_X64_AVX2 )
+
+#define D_MR 4
+#define D_BATCH 4
 #define S_MR 8
 #if defined BLASFEO // XXX
 #define D_NCL 4
@@ -38,6 +53,7 @@
 #elif defined( TARGET_X64_AVX )
 
 #define D_MR 4
+#define D_BATCH 4
 #define S_MR 8
 #if defined BLASFEO // XXX
 #define D_NCL 4
@@ -50,6 +66,7 @@
 #elif defined( TARGET_X64_SSE3 )
 
 #define D_MR 4
+#define D_BATCH 4
 #define S_MR 4
 #if defined BLASFEO // XXX
 #define D_NCL 4
@@ -62,6 +79,7 @@
 #elif defined( TARGET_C99_4X4 )
 
 #define D_MR 4
+#define D_BATCH 4
 #define S_MR 4
 #if defined BLASFEO // XXX
 #define D_NCL 4
@@ -74,6 +92,7 @@
 #elif defined( TARGET_C99_4X4_PREFETCH )
 
 #define D_MR 4
+#define D_BATCH 4
 #define S_MR 4
 #if defined BLASFEO // XXX
 #define D_NCL 4
@@ -86,6 +105,7 @@
 #elif defined( TARGET_CORTEX_A57 )
 
 #define D_MR 4
+#define D_BATCH 4
 #define S_MR 4
 #if defined BLASFEO // XXX
 #define D_NCL 4
@@ -98,6 +118,7 @@
 #elif defined( TARGET_CORTEX_A15 )
 
 #define D_MR 4
+#define D_BATCH 4
 #define S_MR 4
 #if defined BLASFEO // XXX
 #define D_NCL 4
@@ -110,6 +131,7 @@
 #elif defined( TARGET_CORTEX_A9 )
 
 #define D_MR 4
+#define D_BATCH 4
 #define S_MR 4
 #if defined BLASFEO // XXX
 #define D_NCL 4
@@ -122,6 +144,7 @@
 #elif defined( TARGET_CORTEX_A7 )
 
 #define D_MR 4
+#define D_BATCH 4
 #define S_MR 4
 #if defined BLASFEO // XXX
 #define D_NCL 4
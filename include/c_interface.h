@@ -67,17 +67,35 @@ int fortran_order_d_ip_ocp_hard_tv_single_newton_step(int *kk, int k_max, double
 void fortran_order_d_solve_kkt_new_rhs_ocp_hard_tv(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, double **A, double **B, double **b, double **Q, double **S, double **R, double **q, double **r, double **lb, double **ub, double **C, double **D, double **lg, double **ug, double **x, double **u, double **pi, double **lam, /*double **t,*/ double *inf_norm_res, double *work0);
 
 // soft constrains
+// lam holds [lb ub lg ug ls us sl su] at each stage, inf_norm_res holds [res_rq res_b res_d mu]
 int hpmpc_d_ip_ocp_soft_tv_work_space_size_bytes(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int *ns);
 int fortran_order_d_ip_ocp_soft_tv(int *kk, int k_max, double mu0, double mu_tol, int N, int *nx, int *nu_N, int *nb, int **hidxb, int *ng, int *ns, int warm_start, double **A, double **B, double **b, double **Q, double **S, double **R, double **q, double **r, double **Z, double **z, double **lb, double **ub, double **C, double **D, double **lg, double **ug, double **x, double **u, double **pi, double **lam, /* double **t,*/ double *inf_norm_res, void *work0, double *stat);
 
 
 
 // listr interfaces
+// real-time mode: return status 3 with the last iterate if one more IPM iteration is predicted to exceed time_budget seconds
+int c_order_d_ip_ocp_hard_tv_deadline(int *kk, int k_max, double time_budget, double mu0, double mu_tol, int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int N2, int warm_start, double **A, double **B, double **b, double **Q, double **S, double **R, double **q, double **r, double **lb, double **ub, double **C, double **D, double **lg, double **ug, double **x, double **u, double **pi, double **lam, /*double **t,*/ double *inf_norm_res, void *work0, double *stat);
+int fortran_order_d_ip_ocp_hard_tv_deadline(int *kk, int k_max, double time_budget, double mu0, double mu_tol, int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int N2, int warm_start, double **A, double **B, double **b, double **Q, double **S, double **R, double **q, double **r, double **lb, double **ub, double **C, double **D, double **lg, double **ug, double **x, double **u, double **pi, double **lam, /*double **t,*/ double *inf_norm_res, void *work0, double *stat);
 void fortran_order_d_ip_last_kkt_new_rhs_ocp_hard_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int N2, double **b, double **q, double **r, double **lb, double **ub, double **lg, double **ug, double **x, double **u, double **pi, double **lam, /*double **t, */ double *inf_norm_res, void *work0);
+// batch of n_prob independent problems (all arguments indexed by problem) solved on n_thread OpenMP threads;
+// work0 holds one slice per thread: allocate it without touching it, so that each slice is placed on the NUMA node of its thread
+// status and kk hold the per-problem return value and iteration count, the return value is the number of problems with nonzero status
+int hpmpc_d_ip_ocp_hard_tv_batch_work_space_size_bytes(int n_thread, int n_prob, int *N, int **nx, int **nu, int **nb, int ***hidxb, int **ng, int *N2);
+int fortran_order_d_ip_ocp_hard_tv_batch(int n_thread, int n_prob, int *kk, int k_max, double mu0, double mu_tol, int *N, int **nx, int **nu, int **nb, int ***hidxb, int **ng, int *N2, int warm_start, double ***A, double ***B, double ***b, double ***Q, double ***S, double ***R, double ***q, double ***r, double ***lb, double ***ub, double ***C, double ***D, double ***lg, double ***ug, double ***x, double ***u, double ***pi, double ***lam, double **inf_norm_res, void *work0, double **stat, int *status);
+// partial condensing horizon N2 minimizing a cost model of the solution time, optionally calibrated (calibrate=1) by timing the best candidates on this machine;
+// the choice is cached per problem size, block_horizon (if not NULL) returns the horizon of the N2 blocks;
+// the cache is shared by all callers and guarded by an OpenMP critical section: without OpenMP the routine is not thread-safe
+int hpmpc_d_ip_ocp_hard_tv_tune_N2(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int calibrate, int *block_horizon);
 
 
 
 
+// name of the target selected at run time, only available in the library built with 'make dispatch_library'
+const char *hpmpc_dispatch_target();
+
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -264,6 +264,7 @@ void kernel_dsyrk_dpotrf_nt_8x4_vs_lib4_new(int km, int kn, int kadd, int tri_A,
 void kernel_dsyrk_dpotrf_nt_4x4_vs_lib4_new(int km, int kn, int kadd, int tri_A, double *Ap0, double *Bp, int ksub, double *Am0, double *Bm, int alg, double *C0, double *D0, double *inv_diag_D);
 void kernel_dsyrk_dpotrf_nt_4x2_vs_lib4_new(int km, int kn, int kadd, int tri_A, double *Ap, double *Bp, int ksub, double *Am, double *Bm, int alg, double *C, double *D, double *inv_diag_D);
 void kernel_dsyrk_dpotrf_nt_2x2_vs_lib4_new(int km, int kn, int kadd, int tri_A, double *Ap, double *Bp, int ksub, double *Am, double *Bm, int alg, double *C, double *D, double *inv_diag_D);
+void kernel_dtrmm_dsyrk_dpotrf_nt_4x4_vs_lib4_new(int km, int kn, int kadd, double *A, double *B, int sdb, double *R, int ir, int alg, double *C, double *W, double *D, double *inv_diag_D);
 void kernel_dtrsm_nt_12x4_lib4_new(int ksub, double *Am0, int sdam, double *Bm, int alg, double *C0, int sdc, double *D0, int sdd, double *E, int use_inv_diag_E, double *inv_diag_E);
 void kernel_dtrsm_nt_8x4_lib4_new(int ksub, double *Am0, int sdam, double *Bm, int alg, double *C0, int sdc, double *D0, int sdd, double *E, int use_inv_diag_E, double *inv_diag_E);
 void kernel_dtrsm_nt_4x4_lib4_new(int ksub, double *Am0, double *Bm, int alg, double *C0, double *D0, double *E, int use_inv_diag_E, double *inv_diag_E);
@@ -279,6 +280,7 @@ void kernel_dgemm_dtrsm_nt_4x4_vs_lib4_new(int km, int kn, int kadd, int tri_A,
 void kernel_dgemm_dtrsm_nt_4x2_vs_lib4_new(int km, int kn, int kadd, int tri_A, double *Ap, double *Bp, int ksub, double *Am, double *Bm, int alg, double *C, double *D, double *E, int use_inv_diag_E, double *inv_diag_E);
 void kernel_dgemm_dtrsm_nt_2x4_vs_lib4_new(int km, int kn, int kadd, int tri_A, double *Ap0, double *Bp, int ksub, double *Am0, double *Bm, int alg, double *C0, double *D0, double *E, int use_inv_diag_E, double *inv_diag_E);
 void kernel_dgemm_dtrsm_nt_2x2_vs_lib4_new(int km, int kn, int kadd, int tri_A, double *Ap, double *Bp, int ksub, double *Am, double *Bm, int alg, double *C, double *D, double *E, int use_inv_diag_E, double *inv_diag_E);
+void kernel_dtrmm_dgemm_dtrsm_nt_4x4_vs_lib4_new(int km, int kn, int kadd, double *A, double *B, int sdb, double *R, int ir, double *Wp, int alg, double *C, double *W, double *D, double *E, double *inv_diag_E);
 void kernel_dtrsv_n_12_lib4_new(int kmax, double *A0, int sda, int use_inv_diag_A, double *inv_diag_A, double *x, double *y);
 void kernel_dtrsv_n_8_lib4_new(int kmax, double *A0, int sda, int use_inv_diag_A, double *inv_diag_A, double *x, double *y);
 void kernel_dtrsv_n_4_lib4_new(int kmax, double *A, int use_inv_diag_A, double *inv_diag_A, double *x, double *y);
@@ -358,6 +360,19 @@ void kernel_dtrsm_nn_ru_2x4_vs_lib4(int km, int kn, int kmax, double *A, double
 void kernel_dtrsm_nn_ru_2x2_vs_lib4(int km, int kn, int kmax, double *A, double *B, int sdb, int alg, double *C, double *D, double *E, int use_inv_diag_E, double *inv_diag_E);
 
 
+// AVX-512 kernels (8x8 blocks over two panels)
+void kernel_dgemm_nt_8x8_lib4(int kmax, double *A0, int sda, double *B0, int sdb, double *C0, int sdc, double *D0, int sdd, int alg);
+void kernel_dgemm_nt_8x8_vs_lib4(int km, int kn, int kmax, double *A0, int sda, double *B0, int sdb, double *C0, int sdc, double *D0, int sdd, int alg);
+void kernel_dsyrk_nt_8x8_lib4(int kmax, double *A0, int sda, double *B0, int sdb, double *C0, int sdc, double *D0, int sdd, int alg);
+void kernel_dtrmm_nt_u_8x8_lib4(int kadd, double *A0, int sda, double *B0, int sdb, double *D0, int sdd);
+void kernel_dsyrk_dpotrf_nt_8x8_lib4(int kadd, double *Ap0, int sdap, double *Bp0, int sdbp, int ksub, double *Am0, int sdam, double *Bm0, int sdbm, int alg, double *C0, int sdc, double *D0, int sdd, double *inv_diag_D);
+void kernel_dgemm_dtrsm_nt_8x8_lib4_new(int kadd, double *Ap0, int sdap, double *Bp0, int sdbp, int ksub, double *Am0, int sdam, double *Bm0, int sdbm, int alg, double *C0, int sdc, double *D0, int sdd, double *E0, int sde, int use_inv_diag_E, double *inv_diag_E);
+void kernel_dgemm_dtrsm_nt_8x8_vs_lib4_new(int km, int kn, int kadd, double *Ap0, int sdap, double *Bp0, int sdbp, int ksub, double *Am0, int sdam, double *Bm0, int sdbm, int alg, double *C0, int sdc, double *D0, int sdd, double *E0, int sde, int use_inv_diag_E, double *inv_diag_E);
+void kernel_dgemv_n_16_lib4(int kmax, double *A0, int sda, double *x, double *y, double *z, int alg);
+void kernel_dgemv_t_16_lib4(int kmax, double *A, int sda, double *x, double *y, double *z, int alg);
+void kernel_dtrsv_t_8_lib4_new(int kmax, double *A, int sda, int use_inv_diag_A, double *inv_diag_A, double *x);
+
+
 // kernels for aux routines
 void kernel_dgeset_4_lib4(int kmax, double alpha, double *A);
 void kernel_dtrset_4_lib4(int kmax, double alpha, double *A);
@@ -43,11 +43,19 @@ void d_back_ric_rec_sv_tv_res(int N, int *nx, int *nu, int *nb, int **idxb, int
 void d_back_ric_rec_trf_tv_res(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, double **hpBAbt, double **hpQ, double **hpDCt, double **Qx, double **bd, double *memory, double *work);
 // backward Riccati recursion: solution
 void d_back_ric_rec_trs_tv_res(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, double **hpBAbt, double **hb, double **hq, double **hpDCt, double **qx, double **hux, int compute_pi, double **hpi, int compute_Pb, double **hPb, double *memory, double *work);
+// backward Riccati recursion in single precision, time-invariant problem size (pi[ii+1] is the multiplier of the ii-th dynamics): factorization and solution
+void s_ric_sv_mpc(int nx, int nu, int N, float **hpBAbt, float **hpQ, float **hux, float **hpL, float *work, float *diag, int compute_pi, float **hpi);
+// backward Riccati recursion in single precision: solution (hq is overwritten)
+void s_ric_trs_mpc(int nx, int nu, int N, float **hpBAbt, float **hpL, float **hq, float **hux, float *work, int compute_Pb, float **hPb, int compute_pi, float **hpi);
+// residuals in single precision
+void s_res_mpc(int nx, int nu, int N, float **hpBAbt, float **hpQ, float **hq, float **hux, float **hpi, float **hrq, float **hrb);
 #ifdef BLASFEO
 // work space
 int d_back_ric_rec_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int *ng);
 // backward Riccati recursion: factorization and solution
 void d_back_ric_rec_sv_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int update_b, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, int update_q, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dvec *hsqx, struct blasfeo_dvec *hsux, int compute_pi, struct blasfeo_dvec *hspi, int compute_Pb, struct blasfeo_dvec *hsPb, struct blasfeo_dmat *hsL, void *work_space);
+// backward Riccati recursion: factorization and solution, unrolled for the sizes in RIC_CODEGEN_SIZES (built with RIC_CODEGEN = 1)
+void d_back_ric_rec_sv_codegen_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int update_b, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, int update_q, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dvec *hsqx, struct blasfeo_dvec *hsux, int compute_pi, struct blasfeo_dvec *hspi, int compute_Pb, struct blasfeo_dvec *hsPb, struct blasfeo_dmat *hsL, void *work_space);
 // backward Riccati recursion: factorization 
 void d_back_ric_rec_trf_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dmat *hsL, void *work);
 // backward Riccati recursion: solution 
@@ -56,6 +64,20 @@ void d_back_ric_rec_trs_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int
 void d_back_ric_rec_sv_back_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int update_b, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, int update_q, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dvec *hsqx, struct blasfeo_dvec *hsux, int compute_pi, struct blasfeo_dvec *hspi, int compute_Pb, struct blasfeo_dvec *hsPb, struct blasfeo_dmat *hsL, void *work);
 // backward Riccati recursion: forward substitution
 void d_back_ric_rec_sv_forw_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int update_b, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, int update_q, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dvec *hsqx, struct blasfeo_dvec *hsux, int compute_pi, struct blasfeo_dvec *hspi, int compute_Pb, struct blasfeo_dvec *hsPb, struct blasfeo_dmat *hsL, void *work);
+// parallel-in-time Riccati recursion over n_chunk chunks of the horizon: work space
+int d_par_back_ric_rec_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int *ng, int n_chunk);
+// parallel-in-time Riccati recursion: factorization and solution
+void d_par_back_ric_rec_sv_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dvec *hsqx, struct blasfeo_dvec *hsux, int compute_pi, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hsPb, struct blasfeo_dmat *hsL, int n_chunk, void *work);
+// parallel-in-time Riccati recursion: factorization (the coarse factorization is kept in work)
+void d_par_back_ric_rec_trf_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dmat *hsL, int n_chunk, void *work);
+// parallel-in-time Riccati recursion: solution (same n_chunk and work as in the factorization)
+void d_par_back_ric_rec_trs_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsqx, struct blasfeo_dvec *hsux, int compute_pi, struct blasfeo_dvec *hspi, int compute_Pb, struct blasfeo_dvec *hsPb, struct blasfeo_dmat *hsL, int n_chunk, void *work);
+// work space (single precision)
+int s_back_ric_rec_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int *ng);
+// backward Riccati recursion in single precision: factorization
+void s_back_ric_rec_trf_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_smat *hsBAbt, struct blasfeo_smat *hsRSQrq, struct blasfeo_smat *hsDCt, struct blasfeo_svec *hsQx, struct blasfeo_smat *hsL, void *work);
+// backward Riccati recursion in single precision: solution
+void s_back_ric_rec_trs_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, struct blasfeo_smat *hsBAbt, struct blasfeo_svec *hsb, struct blasfeo_svec *hsrq, struct blasfeo_smat *hsDCt, struct blasfeo_svec *hsqx, struct blasfeo_svec *hsux, int compute_pi, struct blasfeo_svec *hspi, int compute_Pb, struct blasfeo_svec *hsPb, struct blasfeo_smat *hsL, void *work);
 #endif
 
 // tree Riccati
@@ -80,8 +102,8 @@ void d_tree_back_ric_rec_trs_libstr(int Nn, struct node *tree, int *nx, int *nu,
 void d_cond_BAbt(int N, int *nx, int *nu, double **hpBAbt, double *work, double **hpGamma, double *pBAbt2);
 // condense Hessian and gradient (N^2 n_x^3 algorithm)
 void d_cond_RSQrq(int N, int *nx, int *nu, double **hpBAbt, double **hpRSQrq, double **hpGamma, double *work, double *pRSQrq2);
-// condense constraints (TODO general constraints)
-void d_cond_DCtd(int N, int *nx, int *nu, int *nb, int **hidxb, double **hd, double **hpGamma, double *pDCt2, double *d2, int *idxb2);
+// condense constraints (box on states and general constraints become general constraints)
+void d_cond_DCtd(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, double **hpDCt, double **hd, double **hpGamma, double *work, double *pDCt2, double *d2, int *idxb2);
 // computes problem size (not hidxb2)
 void d_part_cond_compute_problem_size(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int N2, int *nx2, int *nu2, int *nb2, int *ng2);
 // work space for partially condensing routine
@@ -104,6 +126,8 @@ int d_part_cond_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, i
 int d_part_cond_memory_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int N2, int *nx2, int *nu2, int *nb2, int *ng2);
 // partial condensing routine
 void d_part_cond_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, int N2, int *nx2, int *nu2, int *nb2, int **hidxb2, int *ng2, struct blasfeo_dmat *hsBAbt2, struct blasfeo_dmat *hsRSQrq2, struct blasfeo_dmat *hsDCt2, struct blasfeo_dvec *hsd2, void *memory_space, void *work_space, int *work_space_sizes);
+// incremental partial condensing routine: only the blocks containing a stage with dirty[ii]!=0 are condensed again, restarting Gamma from the first and the Hessian recursion from the last dirty stage of the block
+void d_part_cond_update_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int *dirty, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, int N2, int *nx2, int *nu2, int *nb2, int **hidxb2, int *ng2, struct blasfeo_dmat *hsBAbt2, struct blasfeo_dmat *hsRSQrq2, struct blasfeo_dmat *hsDCt2, struct blasfeo_dvec *hsd2, void *memory_space, void *work_space, int *work_space_sizes);
 void d_part_cond_rhs_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, int N2, int *nx2, int *nu2, int *nb2, int **hidxb2, int *ng2, struct blasfeo_dmat *hsBAbt2, struct blasfeo_dvec *hsb2, struct blasfeo_dmat *hsRSQrq2, struct blasfeo_dvec *hsrq2, struct blasfeo_dmat *hsDCt2, struct blasfeo_dvec *hsd2, void *memory_space, void *work_space, int *work_space_sizes);
 // work space for partial expand
 int d_part_expand_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int *ng, int *work_space_sizes);
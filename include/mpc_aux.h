@@ -53,11 +53,14 @@ void d_update_gradient_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng
 void d_compute_alpha_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, double *ptr_alpha, double **t, double **dt, double **lam, double **dlam, double **lamt, double **dux, double **pDCt, double **db);
 #ifdef BLASFEO
 void d_compute_alpha_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, double *ptr_alpha, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hslamt, struct blasfeo_dvec *hsdux, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsdb);
+void d_compute_alpha_mu_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, double *ptr_alpha, double *ptr_mu_poly, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hslamt, struct blasfeo_dvec *hsdux, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsdb);
+void d_compute_gondzio_correction_mpc_hard_libstr(int N, int *nb, int *ng, double alpha, double mu_min, double mu_max, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hslamt, struct blasfeo_dvec *hstinv, struct blasfeo_dvec *hsqx);
 #endif
 void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double *ptr_mu, double mu_scal, double alpha, double **ux, double **dux, double **t, double **dt, double **lam, double **dlam, double **pi, double **dpi);
 #ifdef BLASFEO
 void d_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, double *ptr_mu, double mu_scal, double alpha, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hsdux, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hsdpi, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam);
 void d_backup_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, double *ptr_mu, double mu_scal, double alpha, struct blasfeo_dvec *hsux_bkp, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hsdux, struct blasfeo_dvec *hst_bkp, struct blasfeo_dvec *hspi_bkp, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hsdpi, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam_bkp, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam);
+void d_backup_update_var_hessian_gradient_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, double *ptr_mu, double mu_scal, double alpha, struct blasfeo_dvec *hsux_bkp, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hsdux, struct blasfeo_dvec *hspi_bkp, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hsdpi, struct blasfeo_dvec *hst_bkp, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam_bkp, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hsdb, double sigma_mu, struct blasfeo_dvec *hstinv, struct blasfeo_dvec *hslamt, struct blasfeo_dvec *hsQx, struct blasfeo_dvec *hsqx);
 #endif
 void d_compute_mu_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double *ptr_mu, double mu_scal, double alpha, double **lam, double **dlam, double **t, double **dt);
 #ifdef BLASFEO
@@ -86,6 +89,7 @@ void d_compute_mu_res_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, dou
 void d_compute_centering_correction_res_mpc_hard_tv(int N, int *nb, int *ng, double sigma_mu, double **dt, double **dlam, double **res_m);
 #ifdef BLASFEO
 void d_compute_centering_correction_res_mpc_hard_libstr(int N, int *nb, int *ng, double sigma_mu, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hsres_m);
+void d_compute_gondzio_correction_res_mpc_hard_libstr(int N, int *nb, int *ng, double alpha, double mu_min, double mu_max, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hsres_m);
 #endif
 void d_update_gradient_res_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double **res_d, double **res_m, double **lam, double **t_inv, double **qx);
 #ifdef BLASFEO
@@ -101,7 +105,27 @@ void d_update_gradient_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, in
 void d_compute_alpha_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, int *ns, double *ptr_alpha, double **t, double **dt, double **lam, double **dlam, double **lamt, double **dux, double **pDCt, double **db, double **Zl, double **zl);
 void d_update_var_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns, double *ptr_mu, double mu_scal, double alpha, double **ux, double **dux, double **t, double **dt, double **lam, double **dlam, double **pi, double **dpi);
 void d_compute_mu_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns, double *ptr_mu, double mu_scal, double alpha, double **lam, double **dlam, double **t, double **dt);
+#ifdef BLASFEO
+// soft-constrained routines with residuals computation
+void d_init_var_mpc_soft_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int *ns, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hspi, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsdb, struct blasfeo_dvec *hst, struct blasfeo_dvec *hslam, double mu0, int warm_start);
+void d_update_hessian_gradient_res_mpc_soft_libstr(int N, int *nx, int *nu, int *nb, int *ng, int *ns, struct blasfeo_dvec *hsres_d, struct blasfeo_dvec *hsres_m, struct blasfeo_dvec *hsres_z, struct blasfeo_dvec *hst, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hstinv, struct blasfeo_dvec *hsZ, struct blasfeo_dvec *hsZl, struct blasfeo_dvec *hszl, struct blasfeo_dvec *hsQx, struct blasfeo_dvec *hsqx);
+void d_update_gradient_res_mpc_soft_libstr(int N, int *nx, int *nu, int *nb, int *ng, int *ns, struct blasfeo_dvec *hsres_d, struct blasfeo_dvec *hsres_m, struct blasfeo_dvec *hsres_z, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hstinv, struct blasfeo_dvec *hsZl, struct blasfeo_dvec *hszl, struct blasfeo_dvec *hsqx);
+void d_compute_alpha_res_mpc_soft_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, int *ns, struct blasfeo_dvec *hsdux, struct blasfeo_dvec *hst, struct blasfeo_dvec *hstinv, struct blasfeo_dvec *hslam, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsres_d, struct blasfeo_dvec *hsres_m, struct blasfeo_dvec *hsZl, struct blasfeo_dvec *hszl, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hsdlam, double *ptr_alpha);
+void d_compute_mu_mpc_soft_libstr(int N, int *nx, int *nu, int *nb, int *ng, int *ns, double *ptr_mu, double mu_scal, double alpha, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt);
+void d_compute_centering_correction_res_mpc_soft_libstr(int N, int *nb, int *ng, int *ns, double sigma_mu, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hsres_m);
+void d_update_var_res_mpc_soft_libstr(int N, int *nx, int *nu, int *nb, int *ng, int *ns, double alpha, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hsdux, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hsdpi, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam);
+#endif
+
+
+
 
+// single precision, box constraints only (old version)
+void s_init_ux_pi_t_box_mpc(int N, int nx, int nu, int nbu, int nb, float **ux, float **pi, float **db, float **t, int warm_start);
+void s_init_lam_mpc(int N, int nu, int nbu, int nb, float **t, float **lam);
+void s_update_hessian_box_mpc(int N, int k0, int k1, int kmax, int cnz, float sigma_mu, float **t, float **t_inv, float **lam, float **lamt, float **dlam, float **bd, float **bl, float **pd, float **pl, float **pl2, float **db);
+void s_compute_alpha_box_mpc(int N, int k0, int k1, int kmax, float *ptr_alpha, float **t, float **dt, float **lam, float **dlam, float **lamt, float **dux, float **db);
+void s_update_var_mpc(int nx, int nu, int N, int nb, int nbu, float *ptr_mu, float mu_scal, float alpha, float **ux, float **dux, float **t, float **dt, float **lam, float **dlam, float **pi, float **dpi);
+void s_compute_mu_mpc(int N, int nbu, int nu, int nb, float *ptr_mu, float mu_scal, float alpha, float **lam, float **dlam, float **t, float **dt);
 
 
 #ifdef __cplusplus
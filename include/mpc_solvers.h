@@ -48,12 +48,88 @@ void d_res_res_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int **idxb, int *ng
 
 
 
+// batched IPM with residuals computation, box constraints only: D_BATCH problems of identical size interleaved across the simd lanes
+int d_ip2_res_mpc_hard_batch_work_space_size_bytes(int N, int *nx, int *nu, int *nb);
+int d_ip2_res_mpc_hard_batch(int *kk, int k_max, double mu0, double mu_tol, double alpha_min, int warm_start, double *stat, int N, int *nx, int *nu, int *nb, int **idxb, double **bBAbt, double **bRSQrq, double **bd, double **bux, int compute_mult, double **bpi, double **blam, double **bt, double *double_work_memory);
+void d_cvt_mat2bmat(int m, int n, double *A, int lda, int lane, double *bA);
+void d_cvt_bmat2mat(int m, int n, double *bA, int lane, double *A, int lda);
+void d_cvt_vec2bvec(int m, double *x, int lane, double *bx);
+void d_cvt_bvec2vec(int m, double *bx, int lane, double *x);
+
+
+
 #ifdef BLASFEO
+// the work space always includes the copy of the best iterate kept in real-time mode, as it is shared by d_ip2_res_mpc_hard_libstr and d_ip2_res_mpc_hard_deadline_libstr
 int d_ip2_res_mpc_hard_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int *ng);
+void d_ip2_res_mpc_hard_work_space_plan_libstr(int N, int *nx, int *nu, int *nb, int *ng, int *size_no_alias, int *size);
 int d_ip2_res_mpc_hard_libstr(int *kk, int k_max, double mu0, double mu_tol, double alpha_min, int warm_start, double *stat, int N, int *nx, int *nu, int *nb, int **idxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, void *work_memory);
+// real-time mode: return status 3 with the best iterate so far if one more iteration is predicted to exceed time_budget seconds
+int d_ip2_res_mpc_hard_deadline_libstr(int *kk, int k_max, double time_budget, double mu0, double mu_tol, double alpha_min, int warm_start, double *stat, int N, int *nx, int *nu, int *nb, int **idxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, void *work_memory);
 void d_kkt_solve_new_rhs_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, void *work);
 int d_res_res_mpc_hard_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int *ng);
 void d_res_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dmat *hsQ, struct blasfeo_dvec *hsq, struct blasfeo_dvec *hsux, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsrq, struct blasfeo_dvec *hsrb, struct blasfeo_dvec *hsrd, struct blasfeo_dvec *hsrm, double *mu, void *work);
+// solver object of d_ip2_res_mpc_hard_libstr: the work space is laid out once per problem size at creation, and reused across solves
+struct d_ip2_res_mpc_hard_solver
+	{
+	int N;
+	int *nx;
+	int *nu;
+	int *nb;
+	int *ng;
+	struct blasfeo_dmat *hsL;
+	struct blasfeo_dvec *hsb;
+	struct blasfeo_dvec *hsrq;
+	struct blasfeo_dvec *hsQx;
+	struct blasfeo_dvec *hsqx;
+	struct blasfeo_dvec *hsdux;
+	struct blasfeo_dvec *hsdpi;
+	struct blasfeo_dvec *hsdt;
+	struct blasfeo_dvec *hsdlam;
+	struct blasfeo_dvec *hstinv;
+	struct blasfeo_dvec *hslamt;
+	struct blasfeo_dvec *hsPb;
+	struct blasfeo_dvec *hsres_rq;
+	struct blasfeo_dvec *hsres_b;
+	struct blasfeo_dvec *hsres_d;
+	struct blasfeo_dvec *hsres_m;
+	struct blasfeo_dvec *hsux_bkp;
+	struct blasfeo_dvec *hspi_bkp;
+	struct blasfeo_dvec *hst_bkp;
+	struct blasfeo_dvec *hslam_bkp;
+	struct blasfeo_dvec *hsux_best; // iterate with the smallest residuals in real-time mode
+	struct blasfeo_dvec *hspi_best;
+	struct blasfeo_dvec *hst_best;
+	struct blasfeo_dvec *hslam_best;
+	struct blasfeo_dvec *hsdux_cor; // only with IPM_GONDZIO
+	struct blasfeo_dvec *hsdpi_cor;
+	struct blasfeo_dvec *hsdt_cor;
+	struct blasfeo_dvec *hsdlam_cor;
+	struct blasfeo_smat *hssL; // only with IPM_MIXED_PREC
+	struct blasfeo_smat *hssBAbt;
+	struct blasfeo_svec *hssb;
+	struct blasfeo_svec *hssrq;
+	struct blasfeo_svec *hssdux;
+	struct blasfeo_svec *hssdpi;
+	struct blasfeo_svec *hssPb;
+	struct blasfeo_dvec *hsrq2;
+	struct blasfeo_dvec *hsres_rq2;
+	struct blasfeo_dvec *hsres_b2;
+	int *i_zeros; // nb=ng=0 of the equality constrained sub-problem, only with IPM_MIXED_PREC
+	void *d_back_ric_rec_work_space;
+	void *d_res_res_mpc_hard_work_space;
+	void *d_back_ric_rec_mixed_work_space; // NULL unless IPM_MIXED_PREC
+	void *s_back_ric_rec_work_space; // NULL unless IPM_MIXED_PREC
+	void *d_par_back_ric_rec_work_space; // NULL unless RIC_PAR_CHUNKS
+	void *work; // IPM work space
+	int memsize;
+	};
+int d_ip2_res_mpc_hard_solver_memsize_libstr(int N, int *nx, int *nu, int *nb, int *ng);
+void d_ip2_res_mpc_hard_solver_create_libstr(int N, int *nx, int *nu, int *nb, int *ng, struct d_ip2_res_mpc_hard_solver *solver, void *memory);
+int d_ip2_res_mpc_hard_solver_solve_libstr(int *kk, int k_max, double mu0, double mu_tol, double alpha_min, int warm_start, double *stat, int **idxb, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, struct d_ip2_res_mpc_hard_solver *solver);
+int d_ip2_res_mpc_hard_solver_solve_deadline_libstr(int *kk, int k_max, double time_budget, double mu0, double mu_tol, double alpha_min, int warm_start, double *stat, int **idxb, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, struct d_ip2_res_mpc_hard_solver *solver);
+void d_ip2_res_mpc_hard_solver_kkt_solve_new_rhs_libstr(int **idxb, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, struct d_ip2_res_mpc_hard_solver *solver);
+// shift the solution by one stage for the next control cycle, to be used with warm_start=2 (ux, pi, t & lam as given)
+void d_shift_warm_start_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, double mu_min);
 #endif
 #if defined(TREE_MPC)
 #ifdef BLASFEO
@@ -69,7 +145,29 @@ void d_tree_res_res_mpc_hard_libstr(int Nn, struct node *tree, int *nx, int *nu,
 int d_ip2_mpc_soft_tv_work_space_size_bytes(int N, int *nx, int *nu, int *nb, int *ng, int *ns);
 int d_ip2_mpc_soft_tv(int *kk, int k_max, double mu0, double mu_tol, double alpha_min, int warm_start, double *stat, int N, int *nx, int *nu, int *nb, int **idxb, int *ng, int *ns, double **pBAbt, double **pQ, double **Z, double **z, double **pDCt, double **d, double **ux, int compute_mult, double **pi, double **lam, double **t, double *double_work_memory);
 void d_res_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, int *ns, double **hpBAbt, double **hpQ, double **hq, double **hZ, double **hz, double **hux, double **hpDCt, double **hd, double **hpi, double **hlam, double **ht, double **hrq, double **hrb, double **hrd, double **hrz, double *mu);
+#ifdef BLASFEO
+int d_ip2_res_mpc_soft_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int *ng, int *ns);
+int d_ip2_res_mpc_soft_libstr(int *kk, int k_max, double mu0, double mu_tol, double alpha_min, int warm_start, double *stat, int N, int *nx, int *nu, int *nb, int **idxb, int *ng, int *ns, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsZ, struct blasfeo_dvec *hsz, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, void *work_memory);
+int d_res_res_mpc_soft_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int *ng, int *ns);
+void d_res_res_mpc_soft_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, int *ns, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dmat *hsQ, struct blasfeo_dvec *hsq, struct blasfeo_dvec *hsZ, struct blasfeo_dvec *hsz, struct blasfeo_dvec *hsux, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsrq, struct blasfeo_dvec *hsrb, struct blasfeo_dvec *hsrd, struct blasfeo_dvec *hsrm, struct blasfeo_dvec *hsrz, double *mu, void *work);
+// ADMM with the Riccati factorization cached in the work space: compute_fact=0 reuses the one of the previous call with the same rho;
+// rho is in/out, and is updated (with refactorization) only if the primal and dual residuals are unbalanced
+int d_admm_mpc_hard_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb);
+int d_admm_mpc_hard_libstr(int *kk, int k_max, double tol_p, double tol_d, int warm_start, int compute_fact, double *rho, double alpha, double *stat, int N, int *nx, int *nu, int *nb, int **idxb, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hsv, struct blasfeo_dvec *hsw, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, void *work_memory);
+int d_admm_mpc_soft_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int *ns);
+int d_admm_mpc_soft_libstr(int *kk, int k_max, double tol_p, double tol_d, int warm_start, int compute_fact, double *rho, double alpha, double *stat, int N, int *nx, int *nu, int *nb, int **idxb, int *ns, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsZ, struct blasfeo_dvec *hsz, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hsv, struct blasfeo_dvec *hsw, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, void *work_memory);
+// dense QP (e.g. from d_cond_libstr, H and g in the (nv+1)x(nv) matrix sH): Schur complement on the constraints if nb+ng<nv and H>0, normal equations otherwise
+int d_ip2_res_dense_qp_work_space_size_bytes_libstr(int nv, int nb, int ng);
+int d_ip2_res_dense_qp_libstr(int *kk, int k_max, double mu0, double mu_tol, double alpha_min, int warm_start, double *stat, int nv, int nb, int *idxb, int ng, struct blasfeo_dmat *sH, struct blasfeo_dmat *sDCt, struct blasfeo_dvec *sd, struct blasfeo_dvec *sv, struct blasfeo_dvec *slam, struct blasfeo_dvec *st, void *work_memory);
+#endif
+
+
+
 
+// single precision, box constraints only, time-invariant problem size (work space of (N+1)*(pnz*cnl+4*anz+4*anb+2*anx)+3*anz floats)
+int s_ip_box_mpc(int *kk, int k_max, float mu_tol, float alpha_min, int warm_start, float *sigma_par, float *stat, int nx, int nu, int N, int nb, float **pBAbt, float **pQ, float **db, float **ux, int compute_mult, float **pi, float **lam, float **t, float *work_memory);
+int s_ip2_box_mpc(int *kk, int k_max, float mu_tol, float alpha_min, int warm_start, float *sigma_par, float *stat, int nx, int nu, int N, int nb, float **pBAbt, float **pQ, float **db, float **ux, int compute_mult, float **pi, float **lam, float **t, float *work_memory);
+void s_res_ip_box_mpc(int nx, int nu, int N, int nb, float **hpBAbt, float **hpQ, float **hq, float **hux, float **hdb, float **hpi, float **hlam, float **ht, float **hrq, float **hrb, float **hrd, float *mu);
 
 
 #ifdef __cplusplus
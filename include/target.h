@@ -0,0 +1,10 @@
+
+/* This file is meant to be configured by the build system. */
+
+#ifndef TARGET_C99_4X4
+#define TARGET_C99_4X4
+#endif /* TARGET_C99_4X4 */
+
+#ifndef WITHOUT_BLASFEO
+#define WITHOUT_BLASFEO
+#endif /* WITHOUT_BLASFEO */
@@ -88,16 +88,6 @@ int fortran_order_d_ip_ocp_hard_tv(
 
 
 
-	// if ng>0, disable partial condensing (TODO implement this case)
-	int ngM = ng[0];
-	for(ii=1; ii<N; ii++)
-		ngM = ng[ii]> ngM ? ng[ii] : ngM;
-
-	if(ngM>0)
-		N2 = N;
-
-
-
 	// check for consistency of problem size
 	// nb <= nu+nx
 	for(ii=0; ii<=N; ii++)
@@ -727,16 +717,6 @@ int fortran_order_d_ip_ocp_hard_tv(
 
 
 
-		// if ng>0, disable partial condensing (TODO implement this case)
-		int ngM = ng[0];
-		for(ii=1; ii<N; ii++)
-			ngM = ng[ii]> ngM ? ng[ii] : ngM;
-
-		if(ngM>0)
-			N2 = N;
-
-
-
 		// check for consistency of problem size
 		// nb <= nu+nx
 		for(ii=0; ii<=N; ii++)
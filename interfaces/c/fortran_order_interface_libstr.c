@@ -26,6 +26,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <time.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
 #ifdef BLASFEO
 #include <blasfeo_target.h>
@@ -164,8 +168,9 @@ int hpmpc_d_ip_ocp_hard_tv_work_space_size_bytes_noidxb(int N, int *nx, int *nu,
 
 
 
-int fortran_order_d_ip_ocp_hard_tv( 
-							int *kk, int k_max, double mu0, double mu_tol,
+// real-time mode: time_budget in seconds, no limit if <=0
+int fortran_order_d_ip_ocp_hard_tv_deadline( 
+							int *kk, int k_max, double time_budget, double mu0, double mu_tol,
 							int N, int *nx, int *nu, int *nb, int **hidxb, int *ng,
 							int N2,
 							int warm_start,
@@ -185,7 +190,7 @@ int fortran_order_d_ip_ocp_hard_tv(
 	int hpmpc_status = -1;
 
 
-	int ii, jj, ll, idx;
+	int ii, jj, ll;
 
 
 
@@ -193,6 +198,10 @@ int fortran_order_d_ip_ocp_hard_tv(
 	if(N2>N)
 		N2 = N;
 
+	// full warm start (warm_start=2) needs t and lam as input, not available here
+	if(warm_start>1)
+		warm_start = 1;
+
 
 
 	// check for consistency of problem size
@@ -209,8 +218,6 @@ int fortran_order_d_ip_ocp_hard_tv(
 
 	double alpha_min = 1e-8; // minimum accepted step length
 	double temp;
-	
-	int info = 0;
 
 
 
@@ -594,7 +601,7 @@ int fortran_order_d_ip_ocp_hard_tv(
 
 
 		// IPM solver on partially condensed system
-		hpmpc_status = d_ip2_res_mpc_hard_libstr(kk, k_max, mu0, mu_tol, alpha_min, warm_start, stat, N2, nx2, nu2, nb2, hidxb2, ng2, hsBAbt2, hsRSQrq2, hsDCt2, hsd2, hsux2, 1, hspi2, hslam2, hst2, work_ipm);
+		hpmpc_status = d_ip2_res_mpc_hard_deadline_libstr(kk, k_max, time_budget, mu0, mu_tol, alpha_min, warm_start, stat, N2, nx2, nu2, nb2, hidxb2, ng2, hsBAbt2, hsRSQrq2, hsDCt2, hsd2, hsux2, 1, hspi2, hslam2, hst2, work_ipm);
 
 #if 0
 		printf("\nux\n");
@@ -649,7 +656,7 @@ int fortran_order_d_ip_ocp_hard_tv(
 			}
 
 		// IPM solver on full space system
-		hpmpc_status = d_ip2_res_mpc_hard_libstr(kk, k_max, mu0, mu_tol, alpha_min, warm_start, stat, N, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsd, hsux, 1, hspi, hslam, hst, work_ipm);
+		hpmpc_status = d_ip2_res_mpc_hard_deadline_libstr(kk, k_max, time_budget, mu0, mu_tol, alpha_min, warm_start, stat, N, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsd, hsux, 1, hspi, hslam, hst, work_ipm);
 
 		}
 
@@ -763,9 +770,20 @@ int fortran_order_d_ip_ocp_hard_tv(
 
 
 
+int fortran_order_d_ip_ocp_hard_tv(int *kk, int k_max, double mu0, double mu_tol, int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int N2, int warm_start, double **A, double **B, double **b, double **Q, double **S, double **R, double **q, double **r, double **lb, double **ub, double **C, double **D, double **lg, double **ug, double **x, double **u, double **pi, double **lam, double *inf_norm_res, void *work0, double *stat)
+	{
 
-int c_order_d_ip_ocp_hard_tv( 
-							int *kk, int k_max, double mu0, double mu_tol,
+	return fortran_order_d_ip_ocp_hard_tv_deadline(kk, k_max, 0.0, mu0, mu_tol, N, nx, nu, nb, hidxb, ng, N2, warm_start, A, B, b, Q, S, R, q, r, lb, ub, C, D, lg, ug, x, u, pi, lam, inf_norm_res, work0, stat);
+
+	}
+
+
+
+
+
+// real-time mode: time_budget in seconds, no limit if <=0
+int c_order_d_ip_ocp_hard_tv_deadline( 
+							int *kk, int k_max, double time_budget, double mu0, double mu_tol,
 							int N, int *nx, int *nu, int *nb, int **hidxb, int *ng,
 							int N2,
 							int warm_start,
@@ -785,7 +803,7 @@ int c_order_d_ip_ocp_hard_tv(
 	int hpmpc_status = -1;
 
 
-	int ii, jj, ll, idx;
+	int ii, jj, ll;
 
 
 
@@ -793,6 +811,10 @@ int c_order_d_ip_ocp_hard_tv(
 	if(N2>N)
 		N2 = N;
 
+	// full warm start (warm_start=2) needs t and lam as input, not available here
+	if(warm_start>1)
+		warm_start = 1;
+
 
 
 	// check for consistency of problem size
@@ -809,8 +831,6 @@ int c_order_d_ip_ocp_hard_tv(
 
 	double alpha_min = 1e-8; // minimum accepted step length
 	double temp;
-	
-	int info = 0;
 
 
 
@@ -1200,7 +1220,7 @@ int c_order_d_ip_ocp_hard_tv(
 
 
 		// IPM solver on partially condensed system
-		hpmpc_status = d_ip2_res_mpc_hard_libstr(kk, k_max, mu0, mu_tol, alpha_min, warm_start, stat, N2, nx2, nu2, nb2, hidxb2, ng2, hsBAbt2, hsRSQrq2, hsDCt2, hsd2, hsux2, 1, hspi2, hslam2, hst2, work_ipm);
+		hpmpc_status = d_ip2_res_mpc_hard_deadline_libstr(kk, k_max, time_budget, mu0, mu_tol, alpha_min, warm_start, stat, N2, nx2, nu2, nb2, hidxb2, ng2, hsBAbt2, hsRSQrq2, hsDCt2, hsd2, hsux2, 1, hspi2, hslam2, hst2, work_ipm);
 
 #if 0
 		printf("\nux\n");
@@ -1255,7 +1275,7 @@ int c_order_d_ip_ocp_hard_tv(
 			}
 
 		// IPM solver on full space system
-		hpmpc_status = d_ip2_res_mpc_hard_libstr(kk, k_max, mu0, mu_tol, alpha_min, warm_start, stat, N, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsd, hsux, 1, hspi, hslam, hst, work_ipm);
+		hpmpc_status = d_ip2_res_mpc_hard_deadline_libstr(kk, k_max, time_budget, mu0, mu_tol, alpha_min, warm_start, stat, N, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsd, hsux, 1, hspi, hslam, hst, work_ipm);
 
 		}
 
@@ -1373,6 +1393,16 @@ int c_order_d_ip_ocp_hard_tv(
 
 
 
+int c_order_d_ip_ocp_hard_tv(int *kk, int k_max, double mu0, double mu_tol, int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int N2, int warm_start, double **A, double **B, double **b, double **Q, double **S, double **R, double **q, double **r, double **lb, double **ub, double **C, double **D, double **lg, double **ug, double **x, double **u, double **pi, double **lam, double *inf_norm_res, void *work0, double *stat)
+	{
+
+	return c_order_d_ip_ocp_hard_tv_deadline(kk, k_max, 0.0, mu0, mu_tol, N, nx, nu, nb, hidxb, ng, N2, warm_start, A, B, b, Q, S, R, q, r, lb, ub, C, D, lg, ug, x, u, pi, lam, inf_norm_res, work0, stat);
+
+	}
+
+
+
+
 
 void fortran_order_d_ip_last_kkt_new_rhs_ocp_hard_libstr( 
 							int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, // TODO use memory to save them !!!
@@ -1389,7 +1419,7 @@ void fortran_order_d_ip_last_kkt_new_rhs_ocp_hard_libstr(
 
 //printf("\nstart of wrapper\n");
 
-	int ii, jj, ll, idx;
+	int ii, jj;
 
 
 
@@ -1412,8 +1442,6 @@ void fortran_order_d_ip_last_kkt_new_rhs_ocp_hard_libstr(
 
 
 	double temp;
-	
-	int info = 0;
 
 
 
@@ -1876,3 +1904,760 @@ void fortran_order_d_ip_last_kkt_new_rhs_ocp_hard_libstr(
 
 
 
+
+
+
+// soft constraints: the last ns[ii] entries of hidxb[ii], lb[ii] and ub[ii] are the soft boxes, after the nb[ii] hard ones
+int hpmpc_d_ip_ocp_soft_tv_work_space_size_bytes(int N, int *nx, int *nu_N, int *nb, int **hidxb, int *ng, int *ns)
+	{
+	int ii, nt0;
+	int size = 0;
+	// nu with nu[N]=0
+	int nu[N+1];
+	for(ii=0; ii<N; ii++)
+		nu[ii] = nu_N[ii];
+	nu[N] = 0;
+	for(ii=0; ii<=N; ii++)
+		{
+		nt0 = nb[ii]+ns[ii]+ng[ii];
+		if(ii<N)
+			{
+			size += blasfeo_memsize_dmat(nu[ii]+nx[ii]+1, nx[ii+1]); // BAbt
+			size += 2*blasfeo_memsize_dvec(nx[ii+1]); // b, rb
+			}
+		size += blasfeo_memsize_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii]); // RSQrq
+		size += blasfeo_memsize_dmat(nu[ii]+nx[ii], ng[ii]); // DCt
+		size += blasfeo_memsize_dvec(nx[ii]); // pi
+		size += 3*blasfeo_memsize_dvec(nu[ii]+nx[ii]); // rq, rrq, ux
+		size += 2*blasfeo_memsize_dvec(2*nt0); // d, rd
+		size += 3*blasfeo_memsize_dvec(2*nt0+2*ns[ii]); // lam, t, rm
+		size += 3*blasfeo_memsize_dvec(2*ns[ii]); // Z, z, rz
+		}
+	size += d_ip2_res_mpc_soft_work_space_size_bytes_libstr(N, nx, nu, nb, ng, ns);
+	size += d_res_res_mpc_soft_work_space_size_bytes_libstr(N, nx, nu, nb, ng, ns);
+	size += 2*64; // typical cache line size, used for alignement
+	return size;
+	}
+
+
+
+// the multipliers are returned in the layout of the non-libstr version, [lb ub lg ug ls us sl su] at each stage
+int fortran_order_d_ip_ocp_soft_tv( 
+							int *kk, int k_max, double mu0, double mu_tol,
+							int N, int *nx, int *nu_N, int *nb, int **hidxb, int *ng, int *ns,
+							int warm_start,
+							double **A, double **B, double **b, 
+							double **Q, double **S, double **R, double **q, double **r, 
+							double **Z, double **z,
+							double **lb, double **ub,
+							double **C, double **D, double **lg, double **ug,
+							double **x, double **u, double **pi, double **lam, //double **t,
+							double *inf_norm_res,
+							void *work0, 
+							double *stat)
+
+	{
+
+	int hpmpc_status = -1;
+
+
+	int ii, jj, ll, nt0;
+
+
+	// full warm start (warm_start=2) needs t and lam as input, not available here
+	if(warm_start>1)
+		warm_start = 1;
+
+
+
+	// nu with nu[N]=0
+	int nu[N+1];
+	for(ii=0; ii<N; ii++)
+		nu[ii] = nu_N[ii];
+	nu[N] = 0;
+
+
+
+	// check for consistency of problem size
+	// nb+ns <= nu+nx
+	for(ii=0; ii<=N; ii++)
+		{
+		if(nb[ii]+ns[ii]>nu[ii]+nx[ii])
+			{
+			printf("\nERROR: At stage %d, the number of hard and soft bounds nb+ns=%d can not be larger than the number of variables nu+nx=%d.\n\n", ii, nb[ii]+ns[ii], nu[ii]+nx[ii]);
+			exit(1);
+			}
+		}
+
+
+	double alpha_min = 1e-8; // minimum accepted step length
+	double temp;
+
+
+
+	// align to (typical) cache line size
+	size_t addr = (( (size_t) work0 ) + 63 ) / 64 * 64;
+	char *c_ptr = (char *) addr;
+
+
+	// data structure
+	struct blasfeo_dmat hsBAbt[N];
+	struct blasfeo_dmat hsRSQrq[N+1];
+	struct blasfeo_dmat hsDCt[N+1];
+	struct blasfeo_dvec hsb[N];
+	struct blasfeo_dvec hsrq[N+1];
+	struct blasfeo_dvec hsZ[N+1];
+	struct blasfeo_dvec hsz[N+1];
+	struct blasfeo_dvec hsd[N+1];
+	struct blasfeo_dvec hsux[N+1];
+	struct blasfeo_dvec hspi[N+1];
+	struct blasfeo_dvec hslam[N+1];
+	struct blasfeo_dvec hst[N+1];
+	struct blasfeo_dvec hsrrq[N+1];
+	struct blasfeo_dvec hsrb[N];
+	struct blasfeo_dvec hsrd[N+1];
+	struct blasfeo_dvec hsrm[N+1];
+	struct blasfeo_dvec hsrz[N+1];
+	void *work_ipm;
+	void *work_res;
+
+	for(ii=0; ii<N; ii++)
+		{
+		blasfeo_create_dmat(nu[ii]+nx[ii]+1, nx[ii+1], &hsBAbt[ii], (void *) c_ptr);
+		c_ptr += hsBAbt[ii].memsize;
+		blasfeo_create_dvec(nx[ii+1], &hsb[ii], (void *) c_ptr);
+		c_ptr += hsb[ii].memsize;
+		blasfeo_create_dvec(nx[ii+1], &hsrb[ii], (void *) c_ptr);
+		c_ptr += hsrb[ii].memsize;
+		}
+
+	for(ii=0; ii<=N; ii++)
+		{
+		nt0 = nb[ii]+ns[ii]+ng[ii];
+		blasfeo_create_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], &hsRSQrq[ii], (void *) c_ptr);
+		c_ptr += hsRSQrq[ii].memsize;
+		blasfeo_create_dmat(nu[ii]+nx[ii], ng[ii], &hsDCt[ii], (void *) c_ptr);
+		c_ptr += hsDCt[ii].memsize;
+		blasfeo_create_dvec(nx[ii], &hspi[ii], (void *) c_ptr);
+		c_ptr += hspi[ii].memsize;
+		blasfeo_create_dvec(nu[ii]+nx[ii], &hsrq[ii], (void *) c_ptr);
+		c_ptr += hsrq[ii].memsize;
+		blasfeo_create_dvec(nu[ii]+nx[ii], &hsrrq[ii], (void *) c_ptr);
+		c_ptr += hsrrq[ii].memsize;
+		blasfeo_create_dvec(nu[ii]+nx[ii], &hsux[ii], (void *) c_ptr);
+		c_ptr += hsux[ii].memsize;
+		blasfeo_create_dvec(2*nt0, &hsd[ii], (void *) c_ptr);
+		c_ptr += hsd[ii].memsize;
+		blasfeo_create_dvec(2*nt0, &hsrd[ii], (void *) c_ptr);
+		c_ptr += hsrd[ii].memsize;
+		blasfeo_create_dvec(2*nt0+2*ns[ii], &hslam[ii], (void *) c_ptr);
+		c_ptr += hslam[ii].memsize;
+		blasfeo_create_dvec(2*nt0+2*ns[ii], &hst[ii], (void *) c_ptr);
+		c_ptr += hst[ii].memsize;
+		blasfeo_create_dvec(2*nt0+2*ns[ii], &hsrm[ii], (void *) c_ptr);
+		c_ptr += hsrm[ii].memsize;
+		blasfeo_create_dvec(2*ns[ii], &hsZ[ii], (void *) c_ptr);
+		c_ptr += hsZ[ii].memsize;
+		blasfeo_create_dvec(2*ns[ii], &hsz[ii], (void *) c_ptr);
+		c_ptr += hsz[ii].memsize;
+		blasfeo_create_dvec(2*ns[ii], &hsrz[ii], (void *) c_ptr);
+		c_ptr += hsrz[ii].memsize;
+		}
+
+	work_res = (void *) c_ptr;
+	c_ptr += d_res_res_mpc_soft_work_space_size_bytes_libstr(N, nx, nu, nb, ng, ns);
+
+
+
+	// convert matrices
+
+	// dynamic system
+	for(ii=0; ii<N; ii++)
+		{
+		blasfeo_pack_tran_dmat(nx[ii+1], nu[ii], B[ii], nx[ii+1], &hsBAbt[ii], 0, 0);
+		blasfeo_pack_tran_dmat(nx[ii+1], nx[ii], A[ii], nx[ii+1], &hsBAbt[ii], nu[ii], 0);
+		blasfeo_pack_tran_dmat(nx[ii+1], 1, b[ii], nx[ii+1], &hsBAbt[ii], nu[ii]+nx[ii], 0);
+		blasfeo_pack_dvec(nx[ii+1], b[ii], 1, &hsb[ii], 0);
+		}
+
+	// general constraints
+	for(ii=0; ii<N; ii++)
+		{
+		blasfeo_pack_tran_dmat(ng[ii], nu[ii], D[ii], ng[ii], &hsDCt[ii], 0, 0);
+		blasfeo_pack_tran_dmat(ng[ii], nx[ii], C[ii], ng[ii], &hsDCt[ii], nu[ii], 0);
+		}
+	ii = N;
+	blasfeo_pack_tran_dmat(ng[ii], nx[ii], C[ii], ng[ii], &hsDCt[ii], 0, 0);
+
+	// cost function
+	for(ii=0; ii<N; ii++)
+		{
+		blasfeo_pack_dmat(nu[ii], nu[ii], R[ii], nu[ii], &hsRSQrq[ii], 0, 0);
+		blasfeo_pack_tran_dmat(nu[ii], nx[ii], S[ii], nu[ii], &hsRSQrq[ii], nu[ii], 0);
+		blasfeo_pack_dmat(nx[ii], nx[ii], Q[ii], nx[ii], &hsRSQrq[ii], nu[ii], nu[ii]);
+		blasfeo_pack_tran_dmat(nu[ii], 1, r[ii], nu[ii], &hsRSQrq[ii], nu[ii]+nx[ii], 0);
+		blasfeo_pack_tran_dmat(nx[ii], 1, q[ii], nx[ii], &hsRSQrq[ii], nu[ii]+nx[ii], nu[ii]);
+		blasfeo_pack_dvec(nu[ii], r[ii], 1, &hsrq[ii], 0);
+		blasfeo_pack_dvec(nx[ii], q[ii], 1, &hsrq[ii], nu[ii]);
+		}
+	ii = N;
+	blasfeo_pack_dmat(nx[ii], nx[ii], Q[ii], nx[ii], &hsRSQrq[ii], 0, 0);
+	blasfeo_pack_tran_dmat(nx[ii], 1, q[ii], nx[ii], &hsRSQrq[ii], nx[ii], 0);
+	blasfeo_pack_dvec(nx[ii], q[ii], 1, &hsrq[ii], 0);
+
+	// soft constraints cost
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_pack_dvec(2*ns[ii], Z[ii], 1, &hsZ[ii], 0);
+		blasfeo_pack_dvec(2*ns[ii], z[ii], 1, &hsz[ii], 0);
+		}
+
+	// estimate mu0 if not user-provided
+	if(mu0<=0)
+		{
+		for(ii=0; ii<N; ii++)
+			{
+			for(jj=0; jj<nu[ii]; jj++) for(ll=0; ll<nu[ii]; ll++) mu0 = fmax(mu0, R[ii][jj*nu[ii]+ll]);
+			for(jj=0; jj<nx[ii]*nu[ii]; jj++) mu0 = fmax(mu0, S[ii][jj]);
+			for(jj=0; jj<nx[ii]; jj++) for(ll=0; ll<nx[ii]; ll++) mu0 = fmax(mu0, Q[ii][jj*nx[ii]+ll]);
+			for(jj=0; jj<nu[ii]; jj++) mu0 = fmax(mu0, r[ii][jj]);
+			for(jj=0; jj<nx[ii]; jj++) mu0 = fmax(mu0, q[ii][jj]);
+			for(jj=0; jj<2*ns[ii]; jj++) mu0 = fmax(mu0, Z[ii][jj]);
+			for(jj=0; jj<2*ns[ii]; jj++) mu0 = fmax(mu0, z[ii][jj]);
+			}
+		ii=N;
+		for(jj=0; jj<nx[ii]; jj++) for(ll=0; ll<nx[ii]; ll++) mu0 = fmax(mu0, Q[ii][jj*nx[ii]+ll]);
+		for(jj=0; jj<nx[ii]; jj++) mu0 = fmax(mu0, q[ii][jj]);
+		for(jj=0; jj<2*ns[ii]; jj++) mu0 = fmax(mu0, Z[ii][jj]);
+		for(jj=0; jj<2*ns[ii]; jj++) mu0 = fmax(mu0, z[ii][jj]);
+		}
+
+	// box constraints: hard bounds first, soft bounds after
+	for(ii=0; ii<=N; ii++)
+		{
+		nt0 = nb[ii]+ns[ii]+ng[ii];
+		blasfeo_pack_dvec(nb[ii]+ns[ii], lb[ii], 1, &hsd[ii], 0);
+		blasfeo_pack_dvec(nb[ii]+ns[ii], ub[ii], 1, &hsd[ii], nt0);
+		}
+	// general constraints
+	for(ii=0; ii<=N; ii++)
+		{
+		nt0 = nb[ii]+ns[ii]+ng[ii];
+		blasfeo_pack_dvec(ng[ii], lg[ii], 1, &hsd[ii], nb[ii]+ns[ii]);
+		blasfeo_pack_dvec(ng[ii], ug[ii], 1, &hsd[ii], nt0+nb[ii]+ns[ii]);
+		}
+
+
+
+	// align (again) to (typical) cache line size
+	addr = (( (size_t) c_ptr ) + 63 ) / 64 * 64;
+	c_ptr = (char *) addr;
+
+	// ipm work space
+	work_ipm = (void *) c_ptr;
+	c_ptr += d_ip2_res_mpc_soft_work_space_size_bytes_libstr(N, nx, nu, nb, ng, ns);
+
+	// initial guess
+	if(warm_start)
+		{
+
+		for(ii=0; ii<N; ii++)
+			blasfeo_pack_dvec(nu[ii], u[ii], 1, &hsux[ii], 0);
+
+		for(ii=0; ii<=N; ii++)
+			blasfeo_pack_dvec(nx[ii], x[ii], 1, &hsux[ii], nu[ii]);
+
+		}
+
+	// IPM solver on full space system
+	hpmpc_status = d_ip2_res_mpc_soft_libstr(kk, k_max, mu0, mu_tol, alpha_min, warm_start, stat, N, nx, nu, nb, hidxb, ng, ns, hsBAbt, hsRSQrq, hsZ, hsz, hsDCt, hsd, hsux, 1, hspi, hslam, hst, work_ipm);
+
+
+
+	// copy back inputs and states
+	for(ii=0; ii<N; ii++)
+		blasfeo_unpack_dvec(nu[ii], &hsux[ii], 0, u[ii], 1);
+
+	for(ii=0; ii<=N; ii++)
+		blasfeo_unpack_dvec(nx[ii], &hsux[ii], nu[ii], x[ii], 1);
+
+
+
+	// compute infinity norm of residuals on exit
+
+	double mu;
+
+	d_res_res_mpc_soft_libstr(N, nx, nu, nb, hidxb, ng, ns, hsBAbt, hsb, hsRSQrq, hsrq, hsZ, hsz, hsux, hsDCt, hsd, hspi, hslam, hst, hsrrq, hsrb, hsrd, hsrm, hsrz, &mu, work_res);
+
+	double *ptr;
+
+	// stationarity, slack variables included
+	ptr = hsrrq[0].pa;
+	temp = fabs(ptr[0]);
+	for(ii=0; ii<=N; ii++)
+		{
+		ptr = hsrrq[ii].pa;
+		for(jj=0; jj<nu[ii]+nx[ii]; jj++) 
+			temp = fmax( temp, fabs(ptr[jj]) );
+		ptr = hsrz[ii].pa;
+		for(jj=0; jj<2*ns[ii]; jj++) 
+			temp = fmax( temp, fabs(ptr[jj]) );
+		}
+	inf_norm_res[0] = temp;
+
+	ptr = hsrb[0].pa;
+	temp = fabs(ptr[0]);
+	for(ii=0; ii<N; ii++)
+		{
+		ptr = hsrb[ii].pa;
+		for(jj=0; jj<nx[ii+1]; jj++) 
+			temp = fmax( temp, fabs(ptr[jj]) );
+		}
+	inf_norm_res[1] = temp;
+
+	ptr = hsrd[0].pa;
+	temp = fabs(ptr[0]);
+	for(ii=0; ii<=N; ii++)
+		{
+		ptr = hsrd[ii].pa;
+		for(jj=0; jj<2*nb[ii]+2*ns[ii]+2*ng[ii]; jj++) 
+			temp = fmax( temp, fabs(ptr[jj]) );
+		}
+	inf_norm_res[2] = temp;
+
+	inf_norm_res[3] = mu;
+
+
+
+	// copy back multipliers
+
+	for(ii=0; ii<N; ii++)
+		blasfeo_unpack_dvec(nx[ii+1], &hspi[ii+1], 0, pi[ii], 1);
+
+	for(ii=0; ii<=N; ii++)
+		{
+		nt0 = nb[ii]+ns[ii]+ng[ii];
+		blasfeo_unpack_dvec(nb[ii], &hslam[ii], 0, lam[ii]+0, 1);
+		blasfeo_unpack_dvec(nb[ii], &hslam[ii], nt0, lam[ii]+nb[ii], 1);
+		blasfeo_unpack_dvec(ng[ii], &hslam[ii], nb[ii]+ns[ii], lam[ii]+2*nb[ii], 1);
+		blasfeo_unpack_dvec(ng[ii], &hslam[ii], nt0+nb[ii]+ns[ii], lam[ii]+2*nb[ii]+ng[ii], 1);
+		blasfeo_unpack_dvec(ns[ii], &hslam[ii], nb[ii], lam[ii]+2*nb[ii]+2*ng[ii], 1);
+		blasfeo_unpack_dvec(ns[ii], &hslam[ii], nt0+nb[ii], lam[ii]+2*nb[ii]+2*ng[ii]+ns[ii], 1);
+		blasfeo_unpack_dvec(2*ns[ii], &hslam[ii], 2*nt0, lam[ii]+2*nb[ii]+2*ng[ii]+2*ns[ii], 1);
+		}
+
+    return hpmpc_status;
+
+	}
+
+
+
+
+// batch of independent problems: one work space slice per thread
+int hpmpc_d_ip_ocp_hard_tv_batch_work_space_size_bytes(int n_thread, int n_prob, int *N, int **nx, int **nu, int **nb, int ***hidxb, int **ng, int *N2)
+	{
+	int ll;
+	int size;
+	int max_size = 0;
+	for(ll=0; ll<n_prob; ll++)
+		{
+		size = hpmpc_d_ip_ocp_hard_tv_work_space_size_bytes(N[ll], nx[ll], nu[ll], nb[ll], hidxb[ll], ng[ll], N2[ll]);
+		max_size = size>max_size ? size : max_size;
+		}
+	max_size = (max_size+63)/64*64; // slices on distinct cache lines
+	if(n_thread<1)
+		n_thread = 1;
+	size = n_thread*max_size;
+	size += n_prob*sizeof(double); // cost
+	size += n_prob*sizeof(int); // order
+	return size + 64; // typical cache line size, used for alignement
+	}
+
+
+
+int fortran_order_d_ip_ocp_hard_tv_batch(int n_thread, int n_prob, int *kk, int k_max, double mu0, double mu_tol, int *N, int **nx, int **nu, int **nb, int ***hidxb, int **ng, int *N2, int warm_start, double ***A, double ***B, double ***b, double ***Q, double ***S, double ***R, double ***q, double ***r, double ***lb, double ***ub, double ***C, double ***D, double ***lg, double ***ug, double ***x, double ***u, double ***pi, double ***lam, double **inf_norm_res, void *work0, double **stat, int *status)
+	{
+
+	int ii, jj, ll, idx;
+
+	if(n_prob<1)
+		return 0;
+
+	if(n_thread<1)
+		n_thread = 1;
+
+	// slice size, as in the work space size routine
+	int size;
+	int max_size = 0;
+	for(ll=0; ll<n_prob; ll++)
+		{
+		size = hpmpc_d_ip_ocp_hard_tv_work_space_size_bytes(N[ll], nx[ll], nu[ll], nb[ll], hidxb[ll], ng[ll], N2[ll]);
+		max_size = size>max_size ? size : max_size;
+		}
+	max_size = (max_size+63)/64*64;
+
+	size_t addr = (( (size_t) work0 ) + 63 ) / 64 * 64;
+	char *c_ptr = (char *) addr;
+
+	// scheduling data after the slices
+	double *cost = (double *) (c_ptr + n_thread*max_size);
+	int *order = (int *) (cost + n_prob);
+
+	// estimated cost of one iteration, the largest problems are scheduled first
+	double nv;
+	for(ll=0; ll<n_prob; ll++)
+		{
+		cost[ll] = 0.0;
+		for(ii=0; ii<=N[ll]; ii++)
+			{
+			nv = nu[ll][ii] + nx[ll][ii] + ng[ll][ii];
+			cost[ll] += nv*nv*nv;
+			}
+		for(ii=ll; ii>0 && cost[order[ii-1]]<cost[ll]; ii--)
+			order[ii] = order[ii-1];
+		order[ii] = ll;
+		}
+
+	// threads are pinned (spread over the places given by OMP_PLACES) and keep their own slice,
+	// which is first touched, and therefore placed on the local NUMA node, by the thread using it;
+	// unless nesting is enabled, a parallel region in the solver runs on a single thread, avoiding oversubscription
+#if defined(_OPENMP)
+	#pragma omp parallel for num_threads(n_thread) proc_bind(spread) schedule(dynamic, 1) private(idx)
+#endif
+	for(ll=0; ll<n_prob; ll++)
+		{
+		idx = order[ll];
+#if defined(_OPENMP)
+		char *work = c_ptr + omp_get_thread_num()*max_size;
+#else
+		char *work = c_ptr;
+#endif
+		status[idx] = fortran_order_d_ip_ocp_hard_tv(&kk[idx], k_max, mu0, mu_tol, N[idx], nx[idx], nu[idx], nb[idx], hidxb[idx], ng[idx], N2[idx], warm_start, A[idx], B[idx], b[idx], Q[idx], S[idx], R[idx], q[idx], r[idx], lb[idx], ub[idx], C[idx], D[idx], lg[idx], ug[idx], x[idx], u[idx], pi[idx], lam[idx], inf_norm_res[idx], (void *) work, stat[idx]);
+		}
+
+	// number of problems not solved to the required accuracy
+	jj = 0;
+	for(ll=0; ll<n_prob; ll++)
+		if(status[ll]!=0)
+			jj++;
+
+	return jj;
+
+	}
+
+
+
+
+// partial condensing horizon selection
+#define TUNE_IPM_ITER 10 // IPM iterations per solve, weighting the condensing against the IPM
+#define TUNE_FLOP_PER_BYTE 4.0 // machine balance: flops costing as much as one byte streamed from memory
+#define TUNE_STAGE_OVERHEAD 2000.0 // fixed cost of one stage in flops (calls, loops, vector routines)
+#define TUNE_N_CAL 3 // best model candidates timed by the calibration
+#define TUNE_CACHE_SIZE 16
+
+struct hpmpc_tune_N2_entry
+	{
+	unsigned long long signature;
+	int N;
+	int calibrated;
+	int N2;
+	};
+
+static struct hpmpc_tune_N2_entry hpmpc_tune_N2_cache[TUNE_CACHE_SIZE];
+static int hpmpc_tune_N2_cache_next = 0;
+
+
+
+// FNV-1a hash of the problem size
+static unsigned long long hpmpc_tune_N2_signature(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng)
+	{
+	int ii, jj;
+	unsigned long long h = 14695981039346656037ULL;
+#define TUNE_HASH(a) { h ^= (unsigned int) (a); h *= 1099511628211ULL; }
+	TUNE_HASH(N);
+	TUNE_HASH(D_MR);
+	for(ii=0; ii<=N; ii++)
+		{
+		TUNE_HASH(nx[ii]);
+		TUNE_HASH(nu[ii]);
+		TUNE_HASH(nb[ii]);
+		TUNE_HASH(ng[ii]);
+		for(jj=0; jj<nb[ii]; jj++)
+			TUNE_HASH(hidxb[ii][jj]);
+		}
+#undef TUNE_HASH
+	return h;
+	}
+
+
+
+// flops of a kernel call, scaled by the efficiency of the kernels on a matrix with n rows (half of the peak at 2*D_MR rows)
+static double hpmpc_tune_N2_flops(double flops, int n)
+	{
+	return flops * (n + 2.0*D_MR) / (n + 1.0);
+	}
+
+
+
+// cost of one Riccati factorization and two solutions on a stage, in flops
+static double hpmpc_tune_N2_stage_cost(int nx0, int nu0, int nx1, int ng0)
+	{
+	double nz = nu0 + nx0;
+	double cost = 0.0;
+	cost += hpmpc_tune_N2_flops(nz*nx1*nx1 + nz*nz*(nx1+ng0) + nz*nz*nz/3.0, nz+1); // trmm, syrk, potrf
+	cost += hpmpc_tune_N2_flops(2.0*(4.0*nz*nx1 + nz*nz + 2.0*nz*ng0), nz+1); // two solutions
+	cost += TUNE_FLOP_PER_BYTE * 8.0 * 3.0 * (nz*nz + nz*nx1 + nz*ng0); // L, BAbt, RSQrq, DCt streamed
+	cost += TUNE_STAGE_OVERHEAD;
+	return cost;
+	}
+
+
+
+// model of the solution time of fortran_order_d_ip_ocp_hard_tv with partial condensing horizon N2, in flops
+static double hpmpc_tune_N2_model(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int N2)
+	{
+
+	int ii, jj;
+
+	int nx2[N2+1];
+	int nu2[N2+1];
+	int nb2[N2+1];
+	int ng2[N2+1];
+
+	if(N2<N)
+		d_part_cond_compute_problem_size_libstr(N, nx, nu, nb, hidxb, ng, N2, nx2, nu2, nb2, ng2);
+	else
+		for(ii=0; ii<=N; ii++)
+			{
+			nx2[ii] = nx[ii];
+			nu2[ii] = nu[ii];
+			nb2[ii] = nb[ii];
+			ng2[ii] = ng[ii];
+			}
+
+	// IPM on the condensed problem
+	double ipm_cost = 0.0;
+	for(ii=0; ii<N2; ii++)
+		ipm_cost += hpmpc_tune_N2_stage_cost(nx2[ii], nu2[ii], nx2[ii+1], ng2[ii]);
+	ipm_cost += hpmpc_tune_N2_stage_cost(nx2[N2], nu2[N2], 0, ng2[N2]);
+
+	// condensing, once per solve
+	double cond_cost = 0.0;
+	if(N2<N)
+		{
+		int N1 = N/N2;
+		int R1 = N - N2*N1;
+		int M1 = R1>0 ? N1+1 : N1;
+		int T1, N_tmp;
+		double nz, nu_tmp;
+		N_tmp = 0;
+		for(ii=0; ii<N2; ii++)
+			{
+			T1 = ii<R1 ? M1 : N1;
+			nu_tmp = 0;
+			for(jj=0; jj<T1; jj++)
+				{
+				nu_tmp += nu[N_tmp+jj];
+				nz = nx[N_tmp] + nu_tmp;
+				cond_cost += hpmpc_tune_N2_flops(2.0*nz*nx[N_tmp+jj]*nx[N_tmp+jj+1], nz+1); // Gamma
+				cond_cost += hpmpc_tune_N2_flops(2.0*nz*nz*(nu[N_tmp+jj]+nx[N_tmp+jj]), nz+1); // RSQrq
+				cond_cost += hpmpc_tune_N2_flops(2.0*nz*nx[N_tmp+jj]*ng[N_tmp+jj], nz+1); // DCt
+				cond_cost += TUNE_STAGE_OVERHEAD;
+				}
+			N_tmp += T1;
+			}
+		}
+
+	return cond_cost + TUNE_IPM_ITER*ipm_cost;
+
+	}
+
+
+
+// time of one solve of a synthetic problem of the given size with partial condensing horizon N2, in seconds
+static double hpmpc_tune_N2_time(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int N2)
+	{
+
+	int ii, jj, kk;
+
+	double *A[N], *B[N], *b[N];
+	double *Q[N+1], *S[N+1], *R[N+1], *q[N+1], *r[N+1];
+	double *lb[N+1], *ub[N+1], *C[N+1], *D[N+1], *lg[N+1], *ug[N+1];
+	double *x[N+1], *u[N+1], *pi[N+1], *lam[N+1];
+
+	// stable dynamics and inactive constraints: all IPM iterations take a full step
+	for(ii=0; ii<=N; ii++)
+		{
+		if(ii<N)
+			{
+			A[ii] = (double *) calloc(nx[ii+1]*nx[ii]+1, sizeof(double));
+			for(jj=0; jj<nx[ii+1] && jj<nx[ii]; jj++) A[ii][jj*(nx[ii+1]+1)] = 0.9;
+			B[ii] = (double *) calloc(nx[ii+1]*nu[ii]+1, sizeof(double));
+			for(jj=0; jj<nx[ii+1]*nu[ii]; jj++) B[ii][jj] = 0.1;
+			b[ii] = (double *) calloc(nx[ii+1]+1, sizeof(double));
+			}
+		Q[ii] = (double *) calloc(nx[ii]*nx[ii]+1, sizeof(double));
+		for(jj=0; jj<nx[ii]; jj++) Q[ii][jj*(nx[ii]+1)] = 1.0;
+		S[ii] = (double *) calloc(nu[ii]*nx[ii]+1, sizeof(double));
+		R[ii] = (double *) calloc(nu[ii]*nu[ii]+1, sizeof(double));
+		for(jj=0; jj<nu[ii]; jj++) R[ii][jj*(nu[ii]+1)] = 1.0;
+		q[ii] = (double *) calloc(nx[ii]+1, sizeof(double));
+		for(jj=0; jj<nx[ii]; jj++) q[ii][jj] = 0.1;
+		r[ii] = (double *) calloc(nu[ii]+1, sizeof(double));
+		lb[ii] = (double *) calloc(nb[ii]+1, sizeof(double));
+		ub[ii] = (double *) calloc(nb[ii]+1, sizeof(double));
+		for(jj=0; jj<nb[ii]; jj++) { lb[ii][jj] = -10.0; ub[ii][jj] = 10.0; }
+		C[ii] = (double *) calloc(ng[ii]*nx[ii]+1, sizeof(double));
+		D[ii] = (double *) calloc(ng[ii]*nu[ii]+1, sizeof(double));
+		for(jj=0; jj<ng[ii]*nu[ii]; jj++) D[ii][jj] = 0.1;
+		lg[ii] = (double *) calloc(ng[ii]+1, sizeof(double));
+		ug[ii] = (double *) calloc(ng[ii]+1, sizeof(double));
+		for(jj=0; jj<ng[ii]; jj++) { lg[ii][jj] = -10.0; ug[ii][jj] = 10.0; }
+		x[ii] = (double *) calloc(nx[ii]+1, sizeof(double));
+		u[ii] = (double *) calloc(nu[ii]+1, sizeof(double));
+		pi[ii] = (double *) calloc((ii<N ? nx[ii+1] : nx[ii])+1, sizeof(double));
+		lam[ii] = (double *) calloc(2*nb[ii]+2*ng[ii]+1, sizeof(double));
+		}
+
+	void *work = malloc(hpmpc_d_ip_ocp_hard_tv_work_space_size_bytes(N, nx, nu, nb, hidxb, ng, N2));
+	double stat[5*TUNE_IPM_ITER];
+	double inf_norm_res[4];
+
+	struct timespec ts0, ts1;
+	double time, time_min = 1e30;
+	int rep;
+
+	// negative mu_tol: exactly TUNE_IPM_ITER iterations; the best of 3 runs, after a warm up
+	for(rep=0; rep<4; rep++)
+		{
+		clock_gettime(CLOCK_MONOTONIC, &ts0);
+		fortran_order_d_ip_ocp_hard_tv(&kk, TUNE_IPM_ITER, 0.0, -1.0, N, nx, nu, nb, hidxb, ng, N2, 0, A, B, b, Q, S, R, q, r, lb, ub, C, D, lg, ug, x, u, pi, lam, inf_norm_res, work, stat);
+		clock_gettime(CLOCK_MONOTONIC, &ts1);
+		time = (ts1.tv_sec-ts0.tv_sec) + 1e-9*(ts1.tv_nsec-ts0.tv_nsec);
+		if(rep>0 && time<time_min)
+			time_min = time;
+		}
+
+	free(work);
+	for(ii=0; ii<=N; ii++)
+		{
+		if(ii<N)
+			{
+			free(A[ii]);
+			free(B[ii]);
+			free(b[ii]);
+			}
+		free(Q[ii]);
+		free(S[ii]);
+		free(R[ii]);
+		free(q[ii]);
+		free(r[ii]);
+		free(lb[ii]);
+		free(ub[ii]);
+		free(C[ii]);
+		free(D[ii]);
+		free(lg[ii]);
+		free(ug[ii]);
+		free(x[ii]);
+		free(u[ii]);
+		free(pi[ii]);
+		free(lam[ii]);
+		}
+
+	return time_min;
+
+	}
+
+
+
+int hpmpc_d_ip_ocp_hard_tv_tune_N2(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int calibrate, int *block_horizon)
+	{
+
+	int ii, jj;
+
+	int N2 = -1;
+
+	// no stage to partition
+	if(N<1)
+		return N;
+
+	calibrate = calibrate!=0;
+
+	unsigned long long signature = hpmpc_tune_N2_signature(N, nx, nu, nb, hidxb, ng);
+
+	// cached choice
+#if defined(_OPENMP)
+	#pragma omp critical (hpmpc_tune_N2)
+#endif
+	for(ii=0; ii<TUNE_CACHE_SIZE; ii++)
+		{
+		if(hpmpc_tune_N2_cache[ii].N==N && hpmpc_tune_N2_cache[ii].signature==signature && hpmpc_tune_N2_cache[ii].calibrated>=calibrate && hpmpc_tune_N2_cache[ii].N2>0)
+			{
+			N2 = hpmpc_tune_N2_cache[ii].N2;
+			break;
+			}
+		}
+
+	if(N2<=0)
+		{
+
+		// cost model over all horizons
+		double cost[N+1];
+		int best[TUNE_N_CAL];
+		int n_best = 0;
+		for(ii=1; ii<=N; ii++)
+			{
+			cost[ii] = hpmpc_tune_N2_model(N, nx, nu, nb, hidxb, ng, ii);
+			// insertion in the list of the best candidates, if not worse than all of them
+			if(n_best<TUNE_N_CAL || cost[ii]<cost[best[TUNE_N_CAL-1]])
+				{
+				for(jj=n_best<TUNE_N_CAL ? n_best : TUNE_N_CAL-1; jj>0 && cost[best[jj-1]]>cost[ii]; jj--)
+					best[jj] = best[jj-1];
+				best[jj] = ii;
+				if(n_best<TUNE_N_CAL)
+					n_best++;
+				}
+			}
+		N2 = best[0];
+
+		// calibration: time the best candidates on this machine
+		if(calibrate)
+			{
+			double time, time_min = 1e30;
+			for(ii=0; ii<n_best; ii++)
+				{
+				time = hpmpc_tune_N2_time(N, nx, nu, nb, hidxb, ng, best[ii]);
+				if(time<time_min)
+					{
+					time_min = time;
+					N2 = best[ii];
+					}
+				}
+			}
+
+#if defined(_OPENMP)
+		#pragma omp critical (hpmpc_tune_N2)
+#endif
+			{
+			ii = hpmpc_tune_N2_cache_next;
+			hpmpc_tune_N2_cache[ii].signature = signature;
+			hpmpc_tune_N2_cache[ii].N = N;
+			hpmpc_tune_N2_cache[ii].calibrated = calibrate;
+			hpmpc_tune_N2_cache[ii].N2 = N2;
+			hpmpc_tune_N2_cache_next = (ii+1)%TUNE_CACHE_SIZE;
+			}
+
+		}
+
+	// block partition, as in d_part_cond_libstr: the first R1 blocks have one more stage
+	if(block_horizon!=NULL)
+		{
+		int N1 = N/N2;
+		int R1 = N - N2*N1;
+		for(ii=0; ii<N2; ii++)
+			block_horizon[ii] = ii<R1 ? N1+1 : N1;
+		}
+
+	return N2;
+
+	}
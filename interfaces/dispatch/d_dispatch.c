@@ -0,0 +1,191 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/c_interface.h"
+#include "d_dispatch.h"
+
+
+
+// missing from c_interface.h
+int hpmpc_d_ip_mpc_hard_tv_work_space_size_bytes(int N, int nx, int nu, int nb, int ng, int ngN);
+
+
+
+// one table for each target built into the library, from the fastest to the most portable
+extern struct d_dispatch_table d_dispatch_table_X64_AVX512;
+extern struct d_dispatch_table d_dispatch_table_X64_AVX2;
+extern struct d_dispatch_table d_dispatch_table_X64_AVX;
+extern struct d_dispatch_table d_dispatch_table_X64_SSE3;
+
+static struct d_dispatch_table *d_dispatch_table = 0;
+
+
+
+static int d_dispatch_supported(struct d_dispatch_table *table)
+	{
+	if(table==&d_dispatch_table_X64_AVX512)
+		return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl");
+	if(table==&d_dispatch_table_X64_AVX2)
+		return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+	if(table==&d_dispatch_table_X64_AVX)
+		return __builtin_cpu_supports("avx");
+	return __builtin_cpu_supports("sse3");
+	}
+
+
+
+// pick the fastest target supported by the cpu; the HPMPC_TARGET environment variable
+// can force a slower one (e.g. HPMPC_TARGET=X64_AVX), and is ignored if not supported
+static struct d_dispatch_table *d_dispatch_select()
+	{
+
+	struct d_dispatch_table *tables[] = {&d_dispatch_table_X64_AVX512, &d_dispatch_table_X64_AVX2, &d_dispatch_table_X64_AVX, &d_dispatch_table_X64_SSE3};
+	const int n_tables = sizeof(tables)/sizeof(tables[0]);
+
+	int ii;
+
+	__builtin_cpu_init();
+
+	char *env = getenv("HPMPC_TARGET");
+	if(env!=NULL)
+		{
+		for(ii=0; ii<n_tables; ii++)
+			if(strcmp(env, tables[ii]->target)==0 && d_dispatch_supported(tables[ii]))
+				return tables[ii];
+		}
+
+	for(ii=0; ii<n_tables-1; ii++)
+		if(d_dispatch_supported(tables[ii]))
+			return tables[ii];
+
+	// SSE3 is the baseline of the dispatch library
+	return tables[n_tables-1];
+
+	}
+
+
+
+// the selection is idempotent, so a race between two first calls is harmless
+static struct d_dispatch_table *d_dispatch()
+	{
+	if(d_dispatch_table==0)
+		d_dispatch_table = d_dispatch_select();
+	return d_dispatch_table;
+	}
+
+
+
+// name of the target selected at run time
+const char *hpmpc_dispatch_target()
+	{
+	return d_dispatch()->target;
+	}
+
+
+
+int hpmpc_d_ip_mpc_hard_tv_work_space_size_bytes(int N, int nx, int nu, int nb, int ng, int ngN)
+	{
+	return d_dispatch()->hpmpc_d_ip_mpc_hard_tv_work_space_size_bytes(N, nx, nu, nb, ng, ngN);
+	}
+
+
+
+int hpmpc_d_ip_ocp_hard_tv_work_space_size_bytes(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int N2)
+	{
+	return d_dispatch()->hpmpc_d_ip_ocp_hard_tv_work_space_size_bytes(N, nx, nu, nb, hidxb, ng, N2);
+	}
+
+
+
+int hpmpc_d_ip_ocp_soft_tv_work_space_size_bytes(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int *ns)
+	{
+	return d_dispatch()->hpmpc_d_ip_ocp_soft_tv_work_space_size_bytes(N, nx, nu, nb, hidxb, ng, ns);
+	}
+
+
+
+int c_order_d_ip_ocp_hard_tv(int *kk, int k_max, double mu0, double mu_tol, int N, int *nx, int *nu_N, int *nb, int **hidxb, int *ng, int N2, int warm_start, double **A, double **B, double **b, double **Q, double **S, double **R, double **q, double **r, double **lb, double **ub, double **C, double **D, double **lg, double **ug, double **x, double **u, double **pi, double **lam, double *inf_norm_res, void *work0, double *stat)
+	{
+	return d_dispatch()->c_order_d_ip_ocp_hard_tv(kk, k_max, mu0, mu_tol, N, nx, nu_N, nb, hidxb, ng, N2, warm_start, A, B, b, Q, S, R, q, r, lb, ub, C, D, lg, ug, x, u, pi, lam, inf_norm_res, work0, stat);
+	}
+
+
+
+void c_order_d_solve_kkt_new_rhs_ocp_hard_tv(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, double **A, double **B, double **b, double **Q, double **S, double **R, double **q, double **r, double **lb, double **ub, double **C, double **D, double **lg, double **ug, double **x, double **u, double **pi, double **lam, double *inf_norm_res, double *work0)
+	{
+	d_dispatch()->c_order_d_solve_kkt_new_rhs_ocp_hard_tv(N, nx, nu, nb, hidxb, ng, A, B, b, Q, S, R, q, r, lb, ub, C, D, lg, ug, x, u, pi, lam, inf_norm_res, work0);
+	}
+
+
+
+int c_order_d_ip_mpc_hard_tv(int *kk, int k_max, double mu0, double mu_tol, int N, int nx, int nu, int nb, int ng, int ngN, int time_invariant, int free_x0, int warm_start, double* A, double* B, double* b, double* Q, double* Qf, double* S, double* R, double* q, double* qf, double* r, double *lb, double *ub, double *C, double *D, double *lg, double *ug, double *Cf, double *lgf, double *ugf, double* x, double* u, double *pi, double *lam, double *t, double *inf_norm_res, double *work0, double *stat)
+	{
+	return d_dispatch()->c_order_d_ip_mpc_hard_tv(kk, k_max, mu0, mu_tol, N, nx, nu, nb, ng, ngN, time_invariant, free_x0, warm_start, A, B, b, Q, Qf, S, R, q, qf, r, lb, ub, C, D, lg, ug, Cf, lgf, ugf, x, u, pi, lam, t, inf_norm_res, work0, stat);
+	}
+
+
+
+void c_order_d_solve_kkt_new_rhs_mpc_hard_tv(int N, int nx, int nu, int nb, int ng, int ngN, int time_invariant, int free_x0, double* A, double* B, double* b, double* Q, double* Qf, double* S, double* R, double* q, double* qf, double* r, double *lb, double *ub, double *C, double *D, double *lg, double *ug, double *Cf, double *lgf, double *ugf, double* x, double* u, double *pi, double *lam, double *t, double *inf_norm_res, double *work0)
+	{
+	d_dispatch()->c_order_d_solve_kkt_new_rhs_mpc_hard_tv(N, nx, nu, nb, ng, ngN, time_invariant, free_x0, A, B, b, Q, Qf, S, R, q, qf, r, lb, ub, C, D, lg, ug, Cf, lgf, ugf, x, u, pi, lam, t, inf_norm_res, work0);
+	}
+
+
+
+int fortran_order_d_ip_ocp_hard_tv(int *kk, int k_max, double mu0, double mu_tol, int N, int *nx, int *nu_N, int *nb, int **hidxb, int *ng, int N2, int warm_start, double **A, double **B, double **b, double **Q, double **S, double **R, double **q, double **r, double **lb, double **ub, double **C, double **D, double **lg, double **ug, double **x, double **u, double **pi, double **lam, double *inf_norm_res, void *work0, double *stat)
+	{
+	return d_dispatch()->fortran_order_d_ip_ocp_hard_tv(kk, k_max, mu0, mu_tol, N, nx, nu_N, nb, hidxb, ng, N2, warm_start, A, B, b, Q, S, R, q, r, lb, ub, C, D, lg, ug, x, u, pi, lam, inf_norm_res, work0, stat);
+	}
+
+
+
+void fortran_order_d_solve_kkt_new_rhs_ocp_hard_tv(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, double **A, double **B, double **b, double **Q, double **S, double **R, double **q, double **r, double **lb, double **ub, double **C, double **D, double **lg, double **ug, double **x, double **u, double **pi, double **lam, double *inf_norm_res, double *work0)
+	{
+	d_dispatch()->fortran_order_d_solve_kkt_new_rhs_ocp_hard_tv(N, nx, nu, nb, hidxb, ng, A, B, b, Q, S, R, q, r, lb, ub, C, D, lg, ug, x, u, pi, lam, inf_norm_res, work0);
+	}
+
+
+
+int fortran_order_d_ip_ocp_soft_tv(int *kk, int k_max, double mu0, double mu_tol, int N, int *nx, int *nu_N, int *nb, int **hidxb, int *ng, int *ns, int warm_start, double **A, double **B, double **b, double **Q, double **S, double **R, double **q, double **r, double **Z, double **z, double **lb, double **ub, double **C, double **D, double **lg, double **ug, double **x, double **u, double **pi, double **lam, double *inf_norm_res, void *work0, double *stat)
+	{
+	return d_dispatch()->fortran_order_d_ip_ocp_soft_tv(kk, k_max, mu0, mu_tol, N, nx, nu_N, nb, hidxb, ng, ns, warm_start, A, B, b, Q, S, R, q, r, Z, z, lb, ub, C, D, lg, ug, x, u, pi, lam, inf_norm_res, work0, stat);
+	}
+
+
+
+int fortran_order_d_ip_mpc_hard_tv(int *kk, int k_max, double mu0, double mu_tol, int N, int nx, int nu, int nb, int ng, int ngN, int time_invariant, int free_x0, int warm_start, double* A, double* B, double* b, double* Q, double* Qf, double* S, double* R, double* q, double* qf, double* r, double *lb, double *ub, double *C, double *D, double *lg, double *ug, double *Cf, double *lgf, double *ugf, double* x, double* u, double *pi, double *lam, double *t, double *inf_norm_res, double *work0, double *stat)
+	{
+	return d_dispatch()->fortran_order_d_ip_mpc_hard_tv(kk, k_max, mu0, mu_tol, N, nx, nu, nb, ng, ngN, time_invariant, free_x0, warm_start, A, B, b, Q, Qf, S, R, q, qf, r, lb, ub, C, D, lg, ug, Cf, lgf, ugf, x, u, pi, lam, t, inf_norm_res, work0, stat);
+	}
+
+
+
+void fortran_order_d_solve_kkt_new_rhs_mpc_hard_tv(int N, int nx, int nu, int nb, int ng, int ngN, int time_invariant, int free_x0, double* A, double* B, double* b, double* Q, double* Qf, double* S, double* R, double* q, double* qf, double* r, double *lb, double *ub, double *C, double *D, double *lg, double *ug, double *Cf, double *lgf, double *ugf, double* x, double* u, double *pi, double *lam, double *t, double *inf_norm_res, double *work0)
+	{
+	d_dispatch()->fortran_order_d_solve_kkt_new_rhs_mpc_hard_tv(N, nx, nu, nb, ng, ngN, time_invariant, free_x0, A, B, b, Q, Qf, S, R, q, qf, r, lb, ub, C, D, lg, ug, Cf, lgf, ugf, x, u, pi, lam, t, inf_norm_res, work0);
+	}
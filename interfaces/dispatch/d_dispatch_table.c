@@ -0,0 +1,71 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include "../../include/target.h"
+#include "../../include/c_interface.h"
+#include "d_dispatch.h"
+
+
+
+// missing from c_interface.h
+int hpmpc_d_ip_mpc_hard_tv_work_space_size_bytes(int N, int nx, int nu, int nb, int ng, int ngN);
+
+
+
+// the table is the only symbol kept global in the relocatable object of each target
+#if defined(TARGET_X64_AVX512)
+struct d_dispatch_table d_dispatch_table_X64_AVX512 =
+#elif defined(TARGET_X64_AVX2)
+struct d_dispatch_table d_dispatch_table_X64_AVX2 =
+#elif defined(TARGET_X64_AVX)
+struct d_dispatch_table d_dispatch_table_X64_AVX =
+#elif defined(TARGET_X64_SSE3)
+struct d_dispatch_table d_dispatch_table_X64_SSE3 =
+#else
+#error "target not supported by the dispatch library"
+#endif
+	{
+#if defined(TARGET_X64_AVX512)
+	"X64_AVX512",
+#elif defined(TARGET_X64_AVX2)
+	"X64_AVX2",
+#elif defined(TARGET_X64_AVX)
+	"X64_AVX",
+#else
+	"X64_SSE3",
+#endif
+	&hpmpc_d_ip_mpc_hard_tv_work_space_size_bytes,
+	&hpmpc_d_ip_ocp_hard_tv_work_space_size_bytes,
+	&hpmpc_d_ip_ocp_soft_tv_work_space_size_bytes,
+	&c_order_d_ip_ocp_hard_tv,
+	&c_order_d_solve_kkt_new_rhs_ocp_hard_tv,
+	&c_order_d_ip_mpc_hard_tv,
+	&c_order_d_solve_kkt_new_rhs_mpc_hard_tv,
+	&fortran_order_d_ip_ocp_hard_tv,
+	&fortran_order_d_solve_kkt_new_rhs_ocp_hard_tv,
+	&fortran_order_d_ip_ocp_soft_tv,
+	&fortran_order_d_ip_mpc_hard_tv,
+	&fortran_order_d_solve_kkt_new_rhs_mpc_hard_tv
+	};
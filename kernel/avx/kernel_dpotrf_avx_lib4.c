@@ -3541,3 +3541,394 @@ void kernel_dsyrk_dpotrf_nt_2x2_vs_lib4_new(int km, int kn, int kadd, int tri_A,
 
 
 
+// fused dtrmm + dsyrk + dpotrf: the panel W = A * B' (B upper triangular) is built one column at a time
+// and accumulated into W * W' while still in registers; R is added to the row ir of W if ir>=0
+void kernel_dtrmm_dsyrk_dpotrf_nt_4x4_vs_lib4_new(int km, int kn, int kadd, double *A, double *B, int sdb, double *R, int ir, int alg, double *C, double *W, double *D, double *inv_diag_D)
+	{
+
+	const int bs = 4;
+
+	static double d_mask[4] = {0.5, 1.5, 2.5, 3.5};
+	static double d_idx[4] = {0.0, 1.0, 2.0, 3.0};
+
+	double d_temp;
+
+	int k, kk;
+
+	double
+		*B_k;
+
+	__m256d
+		r_mask, ab_temp,
+		a_0, A_0, b_0, B_0,
+		w_0, W_0,
+		d_00, d_01, d_02, d_03;
+
+	__m256i
+		mask0, mask1;
+
+	// compute store mask
+	d_temp = km-0.0;
+	mask0 = _mm256_castpd_si256( _mm256_sub_pd( _mm256_loadu_pd( d_mask ), _mm256_broadcast_sd( &d_temp ) ) );
+
+	// row of W to add R to
+	d_temp = ir-0.0;
+	r_mask = _mm256_cmp_pd( _mm256_loadu_pd( d_idx ), _mm256_broadcast_sd( &d_temp ), _CMP_EQ_OQ );
+
+	// zero registers
+	d_00 = _mm256_setzero_pd();
+	d_01 = _mm256_setzero_pd();
+	d_02 = _mm256_setzero_pd();
+	d_03 = _mm256_setzero_pd();
+
+	for(k=0; k<kadd; k++)
+		{
+
+		// k-th column of W: row k of B is non-zero from column k
+		B_k = B + k/bs*bs*sdb + k%bs;
+
+		w_0 = _mm256_setzero_pd();
+		W_0 = _mm256_setzero_pd();
+
+		kk = k;
+		for(; kk<kadd-1; kk+=2)
+			{
+
+			a_0 = _mm256_load_pd( &A[0+bs*(kk+0)] );
+			b_0 = _mm256_broadcast_sd( &B_k[bs*(kk+0)] );
+			A_0 = _mm256_load_pd( &A[0+bs*(kk+1)] );
+			B_0 = _mm256_broadcast_sd( &B_k[bs*(kk+1)] );
+			ab_temp = _mm256_mul_pd( a_0, b_0 );
+			w_0 = _mm256_add_pd( w_0, ab_temp );
+			ab_temp = _mm256_mul_pd( A_0, B_0 );
+			W_0 = _mm256_add_pd( W_0, ab_temp );
+
+			}
+		for(; kk<kadd; kk++)
+			{
+
+			a_0 = _mm256_load_pd( &A[0+bs*kk] );
+			b_0 = _mm256_broadcast_sd( &B_k[bs*kk] );
+			ab_temp = _mm256_mul_pd( a_0, b_0 );
+			w_0 = _mm256_add_pd( w_0, ab_temp );
+
+			}
+		w_0 = _mm256_add_pd( w_0, W_0 );
+
+		if(ir>=0)
+			{
+			b_0 = _mm256_broadcast_sd( &R[bs*k] );
+			b_0 = _mm256_and_pd( b_0, r_mask );
+			w_0 = _mm256_add_pd( w_0, b_0 );
+			}
+
+		_mm256_store_pd( &W[0+bs*k], w_0 );
+
+		b_0  = _mm256_permute2f128_pd( w_0, w_0, 0x00 );
+		b_0  = _mm256_permute_pd( b_0, 0x0 );
+		ab_temp = _mm256_mul_pd( w_0, b_0 );
+		d_00 = _mm256_add_pd( d_00, ab_temp );
+		b_0  = _mm256_permute2f128_pd( w_0, w_0, 0x00 );
+		b_0  = _mm256_permute_pd( b_0, 0xf );
+		ab_temp = _mm256_mul_pd( w_0, b_0 );
+		d_01 = _mm256_add_pd( d_01, ab_temp );
+		b_0  = _mm256_permute2f128_pd( w_0, w_0, 0x11 );
+		b_0  = _mm256_permute_pd( b_0, 0x0 );
+		ab_temp = _mm256_mul_pd( w_0, b_0 );
+		d_02 = _mm256_add_pd( d_02, ab_temp );
+		b_0  = _mm256_permute2f128_pd( w_0, w_0, 0x11 );
+		b_0  = _mm256_permute_pd( b_0, 0xf );
+		ab_temp = _mm256_mul_pd( w_0, b_0 );
+		d_03 = _mm256_add_pd( d_03, ab_temp );
+
+		}
+
+	if(alg!=0)
+		{
+		d_00 = _mm256_add_pd( d_00, _mm256_load_pd( &C[0+bs*0] ) );
+		if(kn>=2)
+			d_01 = _mm256_add_pd( d_01, _mm256_load_pd( &C[0+bs*1] ) );
+		if(kn>=3)
+			d_02 = _mm256_add_pd( d_02, _mm256_load_pd( &C[0+bs*2] ) );
+		if(kn>=4)
+			d_03 = _mm256_add_pd( d_03, _mm256_load_pd( &C[0+bs*3] ) );
+		}
+
+	// factorize
+	__m128d
+		sa_00, sa_11, sa_22, sa_33;
+
+	__m256d
+		a_00, a_10, a_20, a_30, a_11, a_21, a_31, a_22, a_32, a_33;
+
+	// first column
+	sa_00 = _mm256_castpd256_pd128( d_00 );
+	if( _mm_comigt_sd( sa_00, _mm_set_sd( 1e-15 ) ) )
+		{
+		sa_00 = _mm_sqrt_sd( sa_00, sa_00 );
+		sa_00 = _mm_div_sd( _mm_set_sd( 1.0 ), sa_00 );
+		_mm_store_sd( &inv_diag_D[0], sa_00 );
+		a_00 = _mm256_broadcast_sd( &inv_diag_D[0] );
+		d_00 = _mm256_mul_pd( d_00, a_00 );
+		}
+	else // comile
+		{
+		d_00 = _mm256_setzero_pd();
+		_mm_store_sd( &inv_diag_D[0], _mm256_castpd256_pd128( d_00 ) );
+		}
+	_mm256_maskstore_pd( &D[0+bs*0], mask0, d_00 );
+
+	if(kn==1 || km==1)
+		return;
+
+	// second column
+	a_10 = _mm256_permute2f128_pd( d_00, d_00, 0x00 );
+	a_10 = _mm256_permute_pd( a_10, 0xf );
+	ab_temp = _mm256_mul_pd( d_00, a_10 );
+	d_01 = _mm256_sub_pd( d_01, ab_temp );
+	sa_11 = _mm_permute_pd( _mm256_castpd256_pd128( d_01 ), 0x3 );
+	if( _mm_comigt_sd( sa_11, _mm_set_sd( 1e-15 ) ) )
+		{
+		sa_11 = _mm_sqrt_sd( sa_11, sa_11 );
+		sa_11 = _mm_div_sd( _mm_set_sd( 1.0 ), sa_11 );
+		_mm_store_sd( &inv_diag_D[1], sa_11 );
+		a_11 = _mm256_broadcast_sd( &inv_diag_D[1] );
+		d_01 = _mm256_mul_pd( d_01, a_11 );
+		}
+	else // comile
+		{
+		d_01 = _mm256_setzero_pd();
+		_mm_store_sd( &inv_diag_D[1], _mm256_castpd256_pd128( d_01 ) );
+		}
+	mask1 = _mm256_set_epi64x( -1, -1, -1, 1 );
+	mask1 = _mm256_castpd_si256( _mm256_and_pd( _mm256_castsi256_pd( mask0 ), _mm256_castsi256_pd( mask1 ) ) );
+	_mm256_maskstore_pd( &D[0+bs*1], mask1, d_01 );
+
+	if(kn==2 || km==2)
+		return;
+
+	// third column
+	a_20 = _mm256_permute2f128_pd( d_00, d_00, 0x11 );
+	a_20 = _mm256_permute_pd( a_20, 0x0 );
+	ab_temp = _mm256_mul_pd( d_00, a_20 );
+	d_02 = _mm256_sub_pd( d_02, ab_temp );
+	a_21 = _mm256_permute2f128_pd( d_01, d_01, 0x11 );
+	a_21 = _mm256_permute_pd( a_21, 0x0 );
+	ab_temp = _mm256_mul_pd( d_01, a_21 );
+	d_02 = _mm256_sub_pd( d_02, ab_temp );
+	sa_22 = _mm256_extractf128_pd( d_02, 0x1 );
+	if( _mm_comigt_sd( sa_22, _mm_set_sd( 1e-15 ) ) )
+		{
+		sa_22 = _mm_sqrt_sd( sa_22, sa_22 );
+		sa_22 = _mm_div_sd( _mm_set_sd( 1.0 ), sa_22 );
+		_mm_store_sd( &inv_diag_D[2], sa_22 );
+		a_22 = _mm256_broadcast_sd( &inv_diag_D[2] );
+		d_02 = _mm256_mul_pd( d_02, a_22 );
+		}
+	else // comile
+		{
+		d_02 = _mm256_setzero_pd();
+		_mm_store_sd( &inv_diag_D[2], _mm256_castpd256_pd128( d_02 ) );
+		}
+	mask1 = _mm256_set_epi64x( -1, -1, 1, 1 );
+	mask1 = _mm256_castpd_si256( _mm256_and_pd( _mm256_castsi256_pd( mask0 ), _mm256_castsi256_pd( mask1 ) ) );
+	_mm256_maskstore_pd( &D[0+bs*2], mask1, d_02 );
+
+	if(kn==3 || km==3)
+		return;
+
+	// fourth column
+	a_30 = _mm256_permute2f128_pd( d_00, d_00, 0x11 );
+	a_30 = _mm256_permute_pd( a_30, 0xf );
+	ab_temp = _mm256_mul_pd( d_00, a_30 );
+	d_03 = _mm256_sub_pd( d_03, ab_temp );
+	a_31 = _mm256_permute2f128_pd( d_01, d_01, 0x11 );
+	a_31 = _mm256_permute_pd( a_31, 0xf );
+	ab_temp = _mm256_mul_pd( d_01, a_31 );
+	d_03 = _mm256_sub_pd( d_03, ab_temp );
+	a_32 = _mm256_permute2f128_pd( d_02, d_02, 0x11 );
+	a_32 = _mm256_permute_pd( a_32, 0xf );
+	ab_temp = _mm256_mul_pd( d_02, a_32 );
+	d_03 = _mm256_sub_pd( d_03, ab_temp );
+	sa_33 = _mm256_extractf128_pd( d_03, 0x1 );
+	sa_33 = _mm_permute_pd( sa_33, 0x3 );
+	if( _mm_comigt_sd( sa_33, _mm_set_sd( 1e-15 ) ) )
+		{
+		sa_33 = _mm_sqrt_sd( sa_33, sa_33 );
+		sa_33 = _mm_div_sd( _mm_set_sd( 1.0 ), sa_33 );
+		_mm_store_sd( &inv_diag_D[3], sa_33 );
+		a_33 = _mm256_broadcast_sd( &inv_diag_D[3] );
+		d_03 = _mm256_mul_pd( d_03, a_33 );
+		}
+	else // comile
+		{
+		d_03 = _mm256_setzero_pd();
+		_mm_store_sd( &inv_diag_D[3], _mm256_castpd256_pd128( d_03 ) );
+		}
+	mask1 = _mm256_set_epi64x( -1, 1, 1, 1 );
+	mask1 = _mm256_castpd_si256( _mm256_and_pd( _mm256_castsi256_pd( mask0 ), _mm256_castsi256_pd( mask1 ) ) );
+	_mm256_maskstore_pd( &D[0+bs*3], mask1, d_03 );
+
+	}
+
+
+
+// fused dtrmm + dgemm + dtrsm: as above, but the panel W is multiplied by the panel Wp of the rows above,
+// and the result is solved with the factorized diagonal block E
+void kernel_dtrmm_dgemm_dtrsm_nt_4x4_vs_lib4_new(int km, int kn, int kadd, double *A, double *B, int sdb, double *R, int ir, double *Wp, int alg, double *C, double *W, double *D, double *E, double *inv_diag_E)
+	{
+
+	const int bs = 4;
+
+	static double d_mask[4] = {0.5, 1.5, 2.5, 3.5};
+	static double d_idx[4] = {0.0, 1.0, 2.0, 3.0};
+
+	double d_temp;
+
+	int k, kk;
+
+	double
+		*B_k;
+
+	__m256d
+		r_mask, ab_temp,
+		a_0, A_0, b_0, B_0,
+		w_0, W_0,
+		d_00, d_01, d_02, d_03;
+
+	__m256i
+		mask0;
+
+	// compute store mask
+	d_temp = km-0.0;
+	mask0 = _mm256_castpd_si256( _mm256_sub_pd( _mm256_loadu_pd( d_mask ), _mm256_broadcast_sd( &d_temp ) ) );
+
+	// row of W to add R to
+	d_temp = ir-0.0;
+	r_mask = _mm256_cmp_pd( _mm256_loadu_pd( d_idx ), _mm256_broadcast_sd( &d_temp ), _CMP_EQ_OQ );
+
+	// zero registers
+	d_00 = _mm256_setzero_pd();
+	d_01 = _mm256_setzero_pd();
+	d_02 = _mm256_setzero_pd();
+	d_03 = _mm256_setzero_pd();
+
+	for(k=0; k<kadd; k++)
+		{
+
+		// k-th column of W: row k of B is non-zero from column k
+		B_k = B + k/bs*bs*sdb + k%bs;
+
+		w_0 = _mm256_setzero_pd();
+		W_0 = _mm256_setzero_pd();
+
+		kk = k;
+		for(; kk<kadd-1; kk+=2)
+			{
+
+			a_0 = _mm256_load_pd( &A[0+bs*(kk+0)] );
+			b_0 = _mm256_broadcast_sd( &B_k[bs*(kk+0)] );
+			A_0 = _mm256_load_pd( &A[0+bs*(kk+1)] );
+			B_0 = _mm256_broadcast_sd( &B_k[bs*(kk+1)] );
+			ab_temp = _mm256_mul_pd( a_0, b_0 );
+			w_0 = _mm256_add_pd( w_0, ab_temp );
+			ab_temp = _mm256_mul_pd( A_0, B_0 );
+			W_0 = _mm256_add_pd( W_0, ab_temp );
+
+			}
+		for(; kk<kadd; kk++)
+			{
+
+			a_0 = _mm256_load_pd( &A[0+bs*kk] );
+			b_0 = _mm256_broadcast_sd( &B_k[bs*kk] );
+			ab_temp = _mm256_mul_pd( a_0, b_0 );
+			w_0 = _mm256_add_pd( w_0, ab_temp );
+
+			}
+		w_0 = _mm256_add_pd( w_0, W_0 );
+
+		if(ir>=0)
+			{
+			b_0 = _mm256_broadcast_sd( &R[bs*k] );
+			b_0 = _mm256_and_pd( b_0, r_mask );
+			w_0 = _mm256_add_pd( w_0, b_0 );
+			}
+
+		_mm256_store_pd( &W[0+bs*k], w_0 );
+
+		b_0  = _mm256_broadcast_sd( &Wp[0+bs*k] );
+		ab_temp = _mm256_mul_pd( w_0, b_0 );
+		d_00 = _mm256_add_pd( d_00, ab_temp );
+		b_0  = _mm256_broadcast_sd( &Wp[1+bs*k] );
+		ab_temp = _mm256_mul_pd( w_0, b_0 );
+		d_01 = _mm256_add_pd( d_01, ab_temp );
+		b_0  = _mm256_broadcast_sd( &Wp[2+bs*k] );
+		ab_temp = _mm256_mul_pd( w_0, b_0 );
+		d_02 = _mm256_add_pd( d_02, ab_temp );
+		b_0  = _mm256_broadcast_sd( &Wp[3+bs*k] );
+		ab_temp = _mm256_mul_pd( w_0, b_0 );
+		d_03 = _mm256_add_pd( d_03, ab_temp );
+
+		}
+
+	if(alg!=0)
+		{
+		d_00 = _mm256_add_pd( d_00, _mm256_load_pd( &C[0+bs*0] ) );
+		if(kn>=2)
+			d_01 = _mm256_add_pd( d_01, _mm256_load_pd( &C[0+bs*1] ) );
+		if(kn>=3)
+			d_02 = _mm256_add_pd( d_02, _mm256_load_pd( &C[0+bs*2] ) );
+		if(kn>=4)
+			d_03 = _mm256_add_pd( d_03, _mm256_load_pd( &C[0+bs*3] ) );
+		}
+
+	// dtrsm
+	__m256d
+		a_00, a_10, a_20, a_30, a_11, a_21, a_31, a_22, a_32, a_33;
+
+	a_00 = _mm256_broadcast_sd( &inv_diag_E[0] );
+	d_00 = _mm256_mul_pd( d_00, a_00 );
+	_mm256_maskstore_pd( &D[0+bs*0], mask0, d_00 );
+
+	if(kn==1)
+		return;
+
+	a_10 = _mm256_broadcast_sd( &E[1+bs*0] );
+	ab_temp = _mm256_mul_pd( d_00, a_10 );
+	d_01 = _mm256_sub_pd( d_01, ab_temp );
+	a_11 = _mm256_broadcast_sd( &inv_diag_E[1] );
+	d_01 = _mm256_mul_pd( d_01, a_11 );
+	_mm256_maskstore_pd( &D[0+bs*1], mask0, d_01 );
+
+	if(kn==2)
+		return;
+
+	a_20 = _mm256_broadcast_sd( &E[2+bs*0] );
+	ab_temp = _mm256_mul_pd( d_00, a_20 );
+	d_02 = _mm256_sub_pd( d_02, ab_temp );
+	a_21 = _mm256_broadcast_sd( &E[2+bs*1] );
+	ab_temp = _mm256_mul_pd( d_01, a_21 );
+	d_02 = _mm256_sub_pd( d_02, ab_temp );
+	a_22 = _mm256_broadcast_sd( &inv_diag_E[2] );
+	d_02 = _mm256_mul_pd( d_02, a_22 );
+	_mm256_maskstore_pd( &D[0+bs*2], mask0, d_02 );
+
+	if(kn==3)
+		return;
+
+	a_30 = _mm256_broadcast_sd( &E[3+bs*0] );
+	ab_temp = _mm256_mul_pd( d_00, a_30 );
+	d_03 = _mm256_sub_pd( d_03, ab_temp );
+	a_31 = _mm256_broadcast_sd( &E[3+bs*1] );
+	ab_temp = _mm256_mul_pd( d_01, a_31 );
+	d_03 = _mm256_sub_pd( d_03, ab_temp );
+	a_32 = _mm256_broadcast_sd( &E[3+bs*2] );
+	ab_temp = _mm256_mul_pd( d_02, a_32 );
+	d_03 = _mm256_sub_pd( d_03, ab_temp );
+	a_33 = _mm256_broadcast_sd( &inv_diag_E[3] );
+	d_03 = _mm256_mul_pd( d_03, a_33 );
+	_mm256_maskstore_pd( &D[0+bs*3], mask0, d_03 );
+
+	}
+
+
@@ -281,7 +281,7 @@ void kernel_sgemm_nt_16x4_lib8(int kmax, float *A0, float *A1, float *B, float *
 		temp = _mm256_mul_ps( a_07, b_0 );
 		c_03 = _mm256_add_ps( c_03, temp );
 		temp = _mm256_mul_ps( a_8f, b_0 );
-		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );
+/*		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );*/
 		c_83 = _mm256_add_ps( c_83, temp );
 
 		}
@@ -598,7 +598,7 @@ void kernel_sgemm_nt_12x4_lib8(int kmax, float *A0, float *A1, float *B, float *
 		temp = _mm256_mul_ps( a_07, b_0 );
 		c_03 = _mm256_add_ps( c_03, temp );
 		temp = _mm256_mul_ps( a_8f, b_0 );
-		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );
+/*		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );*/
 		c_83 = _mm256_add_ps( c_83, temp );
 
 		}
@@ -691,7 +691,7 @@ void kernel_sgemm_nt_12x4_lib8_prova(int kmax, float *A0, float *A1, float *B, f
 
 	__m256
 		temp,
-		a_07, a_8f,
+		a_8f,
 		b_03, b_0, b_1, b_2, b_3,
 /*		c_00, c_01, c_02, c_03,*/
 		c_80, c_81, c_82, c_83;
@@ -2181,7 +2181,7 @@ void kernel_sgemm_nt_4x8_lib8(int kmax, float *A0, float *B, float *C0, float *D
 	__m256
 		t_0, t_1,
 		a_0, A_0,
-		b_0, b_1, b_2, b_3,
+		b_0, b_1,
 		c_0, c_1, c_2, c_3;
 	
 	// prefetch
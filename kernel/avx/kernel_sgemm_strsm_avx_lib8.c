@@ -283,7 +283,7 @@ void kernel_sgemm_strsm_nt_16x4_lib8(int kadd, int ksub, float *A0, float *A1, f
 		temp = _mm256_mul_ps( a_07, b_0 );
 		c_03 = _mm256_add_ps( c_03, temp );
 		temp = _mm256_mul_ps( a_8f, b_0 );
-		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );
+/*		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );*/
 		c_83 = _mm256_add_ps( c_83, temp );
 
 		A0 += 8; // keep it !!!
@@ -699,7 +699,7 @@ void kernel_sgemm_strsm_nt_8x4_lib8(int kadd, int ksub, float *A0, float *B, flo
 	
 		temp = _mm256_mul_ps( a_07, b_0 );
 		c_03 = _mm256_add_ps( c_03, temp );
-		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );
+/*		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );*/
 
 		A0 += 8; // keep it !!!
 		B  += 8; // keep it !!!
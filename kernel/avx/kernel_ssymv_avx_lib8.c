@@ -44,13 +44,12 @@ void kernel_ssymv_4_lib8(int kmax, int kna, float *A, int sda, float *x_n, float
 	__builtin_prefetch( A + 2*lda );
 
 	int 
-		k, k_left, ii;
+		k, k_left;
 	
 	float 
 		k_left_d;
 
 	const float mask_f[] = {7.5, 6.5, 5.5, 4.5, 3.5, 2.5, 1.5, 0.5};
-	float temp_space[8] = {};
 
 	__m256
 		mask,
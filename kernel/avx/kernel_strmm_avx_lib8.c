@@ -421,7 +421,7 @@ void kernel_strmm_nt_16x4_lib8(int kadd, float *A0, float *A1, float *B, float *
 		temp = _mm256_mul_ps( a_07, b_0 );
 		c_03 = _mm256_add_ps( c_03, temp );
 		temp = _mm256_mul_ps( a_8f, b_0 );
-		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );
+/*		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );*/
 		c_83 = _mm256_add_ps( c_83, temp );
 
 		}
@@ -686,7 +686,7 @@ void kernel_strmm_nt_8x4_lib8(int kadd, float *A0, float *B, float *D0)
 	
 		temp = _mm256_mul_ps( a_07, b_0 );
 		c_03 = _mm256_add_ps( c_03, temp );
-		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );
+/*		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );*/
 
 		}
 
@@ -815,7 +815,6 @@ void corner_strmm_nt_16x1_lib8(float *A0, float *A1, float *B, float *C0, float
 	const int ldc = 8;
 
 	__m256
-		temp,
 		a_00, a_80,
 		b_00,
 		c_00, c_80;
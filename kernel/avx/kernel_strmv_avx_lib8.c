@@ -209,7 +209,7 @@ void kernel_strmv_u_t_4_lib8(int kmax, float *A, int sda, float *x, float *y, in
 		ax_temp,
 		a_00, a_01, a_02, a_03,
 		x_0,
-		y_0, y_1, y_2, y_3, y_4, y_5, y_6, y_7;
+		y_0, y_1, y_2, y_3;
 	
 	zeros = _mm256_setzero_ps();
 
@@ -217,10 +217,6 @@ void kernel_strmv_u_t_4_lib8(int kmax, float *A, int sda, float *x, float *y, in
 	y_1 = _mm256_setzero_ps();
 	y_2 = _mm256_setzero_ps();
 	y_3 = _mm256_setzero_ps();
-	y_4 = _mm256_setzero_ps();
-	y_5 = _mm256_setzero_ps();
-	y_6 = _mm256_setzero_ps();
-	y_7 = _mm256_setzero_ps();
 	
 	k=0;
 	for(; k<kmax-7; k+=8)
@@ -442,7 +438,7 @@ void kernel_strmv_u_t_1_lib8(int kmax, float *A, int sda, float *x, float *y, in
 		y_0=0;
 	
 	k=0;
-	for(; k<kmax-3; k+=4)
+	for(; k<kmax-7; k+=8)
 		{
 		
 		x_0 = x[0];
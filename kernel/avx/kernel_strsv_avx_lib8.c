@@ -732,7 +732,7 @@ void kernel_strsv_t_3_lib8(int kmax, int kna, float *A, int sda, float *x)
 
 	__m128
 		tmp, tmA,
-		z_0, z_1, z_2, z_3;
+		z_0, z_1, z_2;
 
 	y_0 = _mm256_hadd_ps(y_0, y_1);
 /*	y_2 = _mm256_hadd_ps(y_2, y_3);*/
@@ -1121,7 +1121,7 @@ void kernel_strsv_t_2_lib8(int kmax, int kna, float *A, int sda, float *x)
 
 	__m128
 		tmp, tmA,
-		z_0, z_1, z_2, z_3;
+		z_0, z_1;
 
 	y_0 = _mm256_hadd_ps(y_0, y_1);
 /*	y_2 = _mm256_hadd_ps(y_2, y_3);*/
@@ -1492,7 +1492,7 @@ void kernel_strsv_t_1_lib8(int kmax, int kna, float *A, int sda, float *x)
 
 	__m128
 		tmp, tmA,
-		z_0, z_1, z_2, z_3;
+		z_0, z_1;
 
 /*	y_0 = _mm256_hadd_ps(y_0, y_1);*/
 	y_0 = _mm256_hadd_ps(y_0, zeros);
@@ -1274,7 +1274,7 @@ void kernel_sgemm_nt_12x4_lib8(int kmax, float *A0, float *A1, float *B, float *
 
 	__m256
 		temp,
-		a_07, a_8f,
+		a_8f,
 		b_03, b_0, b_1, b_2, b_3,
 /*		c_00, c_01, c_02, c_03,*/
 		c_80, c_81, c_82, c_83;
@@ -2764,7 +2764,7 @@ void kernel_sgemm_nt_4x8_lib8(int kmax, float *A0, float *B, float *C0, float *D
 	__m256
 		t_0, t_1,
 		a_0, A_0,
-		b_0, b_1, b_2, b_3,
+		b_0, b_1,
 		c_0, c_1, c_2, c_3;
 	
 	// prefetch
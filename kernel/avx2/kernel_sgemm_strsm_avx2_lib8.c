@@ -258,6 +258,11 @@ void kernel_sgemm_strsm_nt_24x4_lib8(int kadd, int ksub, float *A0, float *A1, f
 		c_83 = _mm256_fmadd_ps( a_8, b_0, c_83 );
 		c_g3 = _mm256_fmadd_ps( a_g, b_0, c_g3 );
 
+		A0 += 8; // keep it !!!
+		A1 += 8; // keep it !!!
+		A2 += 8; // keep it !!!
+		B  += 8; // keep it !!!
+
 		}
 
 	if(ksub>0)
@@ -280,101 +285,101 @@ void kernel_sgemm_strsm_nt_24x4_lib8(int kadd, int ksub, float *A0, float *A1, f
 		{
 
 		b_0 = _mm256_broadcast_ps( (__m128 *) &B[0] );
-		c_00 = _mm256_fmsub_ps( a_0, b_0, c_00 );
-		c_80 = _mm256_fmsub_ps( a_8, b_0, c_80 );
-		c_g0 = _mm256_fmsub_ps( a_g, b_0, c_g0 );
+		c_00 = _mm256_fnmadd_ps( a_0, b_0, c_00 );
+		c_80 = _mm256_fnmadd_ps( a_8, b_0, c_80 );
+		c_g0 = _mm256_fnmadd_ps( a_g, b_0, c_g0 );
 		
 		b_0  = _mm256_permute_ps( b_0, 0xb1 );
-		c_01 = _mm256_fmsub_ps( a_0, b_0, c_01 );
-		c_81 = _mm256_fmsub_ps( a_8, b_0, c_81 );
-		c_g1 = _mm256_fmsub_ps( a_g, b_0, c_g1 );
+		c_01 = _mm256_fnmadd_ps( a_0, b_0, c_01 );
+		c_81 = _mm256_fnmadd_ps( a_8, b_0, c_81 );
+		c_g1 = _mm256_fnmadd_ps( a_g, b_0, c_g1 );
 		
 		b_0  = _mm256_permute_ps( b_0, 0x4e );
-		c_02 = _mm256_fmsub_ps( a_0, b_0, c_02 );
-		c_82 = _mm256_fmsub_ps( a_8, b_0, c_82 );
-		c_g2 = _mm256_fmsub_ps( a_g, b_0, c_g2 );
+		c_02 = _mm256_fnmadd_ps( a_0, b_0, c_02 );
+		c_82 = _mm256_fnmadd_ps( a_8, b_0, c_82 );
+		c_g2 = _mm256_fnmadd_ps( a_g, b_0, c_g2 );
 	
 		b_0  = _mm256_permute_ps( b_0, 0xb1 );
-		c_03 = _mm256_fmsub_ps( a_0, b_0, c_03 );
+		c_03 = _mm256_fnmadd_ps( a_0, b_0, c_03 );
 		a_0 = _mm256_load_ps( &A0[8] );
-		c_83 = _mm256_fmsub_ps( a_8, b_0, c_83 );
+		c_83 = _mm256_fnmadd_ps( a_8, b_0, c_83 );
 		a_8 = _mm256_load_ps( &A1[8] );
-		c_g3 = _mm256_fmsub_ps( a_g, b_0, c_g3 );
+		c_g3 = _mm256_fnmadd_ps( a_g, b_0, c_g3 );
 		a_g = _mm256_load_ps( &A2[8] );
 		
 		
 		
 		b_0 = _mm256_broadcast_ps( (__m128 *) &B[8] );
-		c_00 = _mm256_fmsub_ps( a_0, b_0, c_00 );
-		c_80 = _mm256_fmsub_ps( a_8, b_0, c_80 );
-		c_g0 = _mm256_fmsub_ps( a_g, b_0, c_g0 );
+		c_00 = _mm256_fnmadd_ps( a_0, b_0, c_00 );
+		c_80 = _mm256_fnmadd_ps( a_8, b_0, c_80 );
+		c_g0 = _mm256_fnmadd_ps( a_g, b_0, c_g0 );
 		
 		b_0  = _mm256_permute_ps( b_0, 0xb1 );
-		c_01 = _mm256_fmsub_ps( a_0, b_0, c_01 );
-		c_81 = _mm256_fmsub_ps( a_8, b_0, c_81 );
-		c_g1 = _mm256_fmsub_ps( a_g, b_0, c_g1 );
+		c_01 = _mm256_fnmadd_ps( a_0, b_0, c_01 );
+		c_81 = _mm256_fnmadd_ps( a_8, b_0, c_81 );
+		c_g1 = _mm256_fnmadd_ps( a_g, b_0, c_g1 );
 		
 		b_0  = _mm256_permute_ps( b_0, 0x4e );
-		c_02 = _mm256_fmsub_ps( a_0, b_0, c_02 );
-		c_82 = _mm256_fmsub_ps( a_8, b_0, c_82 );
-		c_g2 = _mm256_fmsub_ps( a_g, b_0, c_g2 );
+		c_02 = _mm256_fnmadd_ps( a_0, b_0, c_02 );
+		c_82 = _mm256_fnmadd_ps( a_8, b_0, c_82 );
+		c_g2 = _mm256_fnmadd_ps( a_g, b_0, c_g2 );
 	
 		b_0  = _mm256_permute_ps( b_0, 0xb1 );
-		c_03 = _mm256_fmsub_ps( a_0, b_0, c_03 );
+		c_03 = _mm256_fnmadd_ps( a_0, b_0, c_03 );
 		a_0 = _mm256_load_ps( &A0[16] );
-		c_83 = _mm256_fmsub_ps( a_8, b_0, c_83 );
+		c_83 = _mm256_fnmadd_ps( a_8, b_0, c_83 );
 		a_8 = _mm256_load_ps( &A1[16] );
-		c_g3 = _mm256_fmsub_ps( a_g, b_0, c_g3 );
+		c_g3 = _mm256_fnmadd_ps( a_g, b_0, c_g3 );
 		a_g = _mm256_load_ps( &A2[16] );
 
 		
 		
 		b_0 = _mm256_broadcast_ps( (__m128 *) &B[16] );
-		c_00 = _mm256_fmsub_ps( a_0, b_0, c_00 );
-		c_80 = _mm256_fmsub_ps( a_8, b_0, c_80 );
-		c_g0 = _mm256_fmsub_ps( a_g, b_0, c_g0 );
+		c_00 = _mm256_fnmadd_ps( a_0, b_0, c_00 );
+		c_80 = _mm256_fnmadd_ps( a_8, b_0, c_80 );
+		c_g0 = _mm256_fnmadd_ps( a_g, b_0, c_g0 );
 		
 		b_0  = _mm256_permute_ps( b_0, 0xb1 );
-		c_01 = _mm256_fmsub_ps( a_0, b_0, c_01 );
-		c_81 = _mm256_fmsub_ps( a_8, b_0, c_81 );
-		c_g1 = _mm256_fmsub_ps( a_g, b_0, c_g1 );
+		c_01 = _mm256_fnmadd_ps( a_0, b_0, c_01 );
+		c_81 = _mm256_fnmadd_ps( a_8, b_0, c_81 );
+		c_g1 = _mm256_fnmadd_ps( a_g, b_0, c_g1 );
 		
 		b_0  = _mm256_permute_ps( b_0, 0x4e );
-		c_02 = _mm256_fmsub_ps( a_0, b_0, c_02 );
-		c_82 = _mm256_fmsub_ps( a_8, b_0, c_82 );
-		c_g2 = _mm256_fmsub_ps( a_g, b_0, c_g2 );
+		c_02 = _mm256_fnmadd_ps( a_0, b_0, c_02 );
+		c_82 = _mm256_fnmadd_ps( a_8, b_0, c_82 );
+		c_g2 = _mm256_fnmadd_ps( a_g, b_0, c_g2 );
 	
 		b_0  = _mm256_permute_ps( b_0, 0xb1 );
-		c_03 = _mm256_fmsub_ps( a_0, b_0, c_03 );
+		c_03 = _mm256_fnmadd_ps( a_0, b_0, c_03 );
 		a_0 = _mm256_load_ps( &A0[24] );
-		c_83 = _mm256_fmsub_ps( a_8, b_0, c_83 );
+		c_83 = _mm256_fnmadd_ps( a_8, b_0, c_83 );
 		a_8 = _mm256_load_ps( &A1[24] );
-		c_g3 = _mm256_fmsub_ps( a_g, b_0, c_g3 );
+		c_g3 = _mm256_fnmadd_ps( a_g, b_0, c_g3 );
 		a_g = _mm256_load_ps( &A2[24] );
 
 		
 		
 		b_0 = _mm256_broadcast_ps( (__m128 *) &B[24] );
-		c_00 = _mm256_fmsub_ps( a_0, b_0, c_00 );
-		c_80 = _mm256_fmsub_ps( a_8, b_0, c_80 );
-		c_g0 = _mm256_fmsub_ps( a_g, b_0, c_g0 );
+		c_00 = _mm256_fnmadd_ps( a_0, b_0, c_00 );
+		c_80 = _mm256_fnmadd_ps( a_8, b_0, c_80 );
+		c_g0 = _mm256_fnmadd_ps( a_g, b_0, c_g0 );
 		
 		b_0  = _mm256_permute_ps( b_0, 0xb1 );
-		c_01 = _mm256_fmsub_ps( a_0, b_0, c_01 );
-		c_81 = _mm256_fmsub_ps( a_8, b_0, c_81 );
-		c_g1 = _mm256_fmsub_ps( a_g, b_0, c_g1 );
+		c_01 = _mm256_fnmadd_ps( a_0, b_0, c_01 );
+		c_81 = _mm256_fnmadd_ps( a_8, b_0, c_81 );
+		c_g1 = _mm256_fnmadd_ps( a_g, b_0, c_g1 );
 		
 		b_0  = _mm256_permute_ps( b_0, 0x4e );
-		c_02 = _mm256_fmsub_ps( a_0, b_0, c_02 );
-		c_82 = _mm256_fmsub_ps( a_8, b_0, c_82 );
-		c_g2 = _mm256_fmsub_ps( a_g, b_0, c_g2 );
+		c_02 = _mm256_fnmadd_ps( a_0, b_0, c_02 );
+		c_82 = _mm256_fnmadd_ps( a_8, b_0, c_82 );
+		c_g2 = _mm256_fnmadd_ps( a_g, b_0, c_g2 );
 	
 		b_0  = _mm256_permute_ps( b_0, 0xb1 );
-		c_03 = _mm256_fmsub_ps( a_0, b_0, c_03 );
+		c_03 = _mm256_fnmadd_ps( a_0, b_0, c_03 );
 		a_0 = _mm256_load_ps( &A0[32] );
-		c_83 = _mm256_fmsub_ps( a_8, b_0, c_83 );
+		c_83 = _mm256_fnmadd_ps( a_8, b_0, c_83 );
 		a_8 = _mm256_load_ps( &A1[32] );
-		c_g3 = _mm256_fmsub_ps( a_g, b_0, c_g3 );
+		c_g3 = _mm256_fnmadd_ps( a_g, b_0, c_g3 );
 		a_g = _mm256_load_ps( &A2[32] );
 
 
@@ -458,9 +463,9 @@ void kernel_sgemm_strsm_nt_24x4_lib8(int kadd, int ksub, float *A0, float *A1, f
 	// second row
 	a_10 = _mm256_broadcast_ss( &fact[1] );
 	a_11 = _mm256_broadcast_ss( &fact[2] );
-	d_01  = _mm256_fmsub_ps( d_00, a_10, d_01 );
-	d_81  = _mm256_fmsub_ps( d_80, a_10, d_81 );
-	d_g1  = _mm256_fmsub_ps( d_g0, a_10, d_g1 );
+	d_01  = _mm256_fnmadd_ps( d_00, a_10, d_01 );
+	d_81  = _mm256_fnmadd_ps( d_80, a_10, d_81 );
+	d_g1  = _mm256_fnmadd_ps( d_g0, a_10, d_g1 );
 	d_01  = _mm256_mul_ps( d_01, a_11 );
 	_mm256_store_ps( &D0[0+ldc*1], d_01 ); // a_00
 	d_81 = _mm256_mul_ps( d_81, a_11 );
@@ -472,12 +477,12 @@ void kernel_sgemm_strsm_nt_24x4_lib8(int kadd, int ksub, float *A0, float *A1, f
 	a_20 = _mm256_broadcast_ss( &fact[3] );
 	a_21 = _mm256_broadcast_ss( &fact[4] );
 	a_22 = _mm256_broadcast_ss( &fact[5] );
-	d_02  = _mm256_fmsub_ps( d_00, a_20, d_02 );
-	d_82  = _mm256_fmsub_ps( d_80, a_20, d_82 );
-	d_g2  = _mm256_fmsub_ps( d_g0, a_20, d_g2 );
-	d_02  = _mm256_fmsub_ps( d_01, a_21, d_02 );
-	d_82  = _mm256_fmsub_ps( d_81, a_21, d_82 );
-	d_g2  = _mm256_fmsub_ps( d_g1, a_21, d_g2 );
+	d_02  = _mm256_fnmadd_ps( d_00, a_20, d_02 );
+	d_82  = _mm256_fnmadd_ps( d_80, a_20, d_82 );
+	d_g2  = _mm256_fnmadd_ps( d_g0, a_20, d_g2 );
+	d_02  = _mm256_fnmadd_ps( d_01, a_21, d_02 );
+	d_82  = _mm256_fnmadd_ps( d_81, a_21, d_82 );
+	d_g2  = _mm256_fnmadd_ps( d_g1, a_21, d_g2 );
 	d_02  = _mm256_mul_ps( d_02, a_22 );
 	_mm256_store_ps( &D0[0+ldc*2], d_02 ); // a_00
 	d_82 = _mm256_mul_ps( d_82, a_22 );
@@ -490,19 +495,21 @@ void kernel_sgemm_strsm_nt_24x4_lib8(int kadd, int ksub, float *A0, float *A1, f
 	a_31 = _mm256_broadcast_ss( &fact[7] );
 	a_32 = _mm256_broadcast_ss( &fact[8] );
 	a_33 = _mm256_broadcast_ss( &fact[9] );
-	d_03  = _mm256_fmsub_ps( d_00, a_30, d_03 );
-	d_83  = _mm256_fmsub_ps( d_80, a_30, d_83 );
-	d_g3  = _mm256_fmsub_ps( d_g0, a_30, d_g3 );
-	d_03  = _mm256_fmsub_ps( d_01, a_31, d_03 );
-	d_83  = _mm256_fmsub_ps( d_81, a_31, d_83 );
-	d_g3  = _mm256_fmsub_ps( d_g1, a_31, d_g3 );
-	d_03  = _mm256_fmsub_ps( d_02, a_32, d_03 );
-	d_83  = _mm256_fmsub_ps( d_82, a_32, d_83 );
-	d_g3  = _mm256_fmsub_ps( d_g2, a_32, d_g3 );
+	d_03  = _mm256_fnmadd_ps( d_00, a_30, d_03 );
+	d_83  = _mm256_fnmadd_ps( d_80, a_30, d_83 );
+	d_g3  = _mm256_fnmadd_ps( d_g0, a_30, d_g3 );
+	d_03  = _mm256_fnmadd_ps( d_01, a_31, d_03 );
+	d_83  = _mm256_fnmadd_ps( d_81, a_31, d_83 );
+	d_g3  = _mm256_fnmadd_ps( d_g1, a_31, d_g3 );
+	d_03  = _mm256_fnmadd_ps( d_02, a_32, d_03 );
+	d_83  = _mm256_fnmadd_ps( d_82, a_32, d_83 );
+	d_g3  = _mm256_fnmadd_ps( d_g2, a_32, d_g3 );
 	d_03  = _mm256_mul_ps( d_03, a_33 );
 	_mm256_store_ps( &D0[0+ldc*3], d_03 ); // a_00
 	d_83 = _mm256_mul_ps( d_83, a_33 );
 	_mm256_store_ps( &D1[0+ldc*3], d_83 );
+	d_g3 = _mm256_mul_ps( d_g3, a_33 );
+	_mm256_store_ps( &D2[0+ldc*3], d_g3 );
 
 	}
 
@@ -759,7 +766,7 @@ void kernel_sgemm_strsm_nt_16x4_lib8(int kadd, int ksub, float *A0, float *A1, f
 		temp = _mm256_mul_ps( a_07, b_0 );
 		c_03 = _mm256_add_ps( c_03, temp );
 		temp = _mm256_mul_ps( a_8f, b_0 );
-		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );
+/*		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );*/
 		c_83 = _mm256_add_ps( c_83, temp );
 
 		A0 += 8; // keep it !!!
@@ -1175,7 +1182,7 @@ void kernel_sgemm_strsm_nt_8x4_lib8(int kadd, int ksub, float *A0, float *B, flo
 	
 		temp = _mm256_mul_ps( a_07, b_0 );
 		c_03 = _mm256_add_ps( c_03, temp );
-		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );
+/*		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );*/
 
 		A0 += 8; // keep it !!!
 		B  += 8; // keep it !!!
@@ -283,7 +283,7 @@ void kernel_ssyrk_spotrf_nt_16x4_lib8(int kadd, int ksub, float *A0, float *A1,
 		temp = _mm256_mul_ps( a_07, b_0 );
 		c_03 = _mm256_add_ps( c_03, temp );
 		temp = _mm256_mul_ps( a_8f, b_0 );
-		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );
+/*		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );*/
 		c_83 = _mm256_add_ps( c_83, temp );
 
 		A0 += 8; // keep it !!!
@@ -456,7 +456,7 @@ void kernel_ssyrk_spotrf_nt_16x4_lib8(int kadd, int ksub, float *A0, float *A1,
 
 	// factorize the upper 4x4 matrix
 	__m128
-		zeros_ones, sab_temp,
+		zeros_ones,
 		sa_00, sa_10, sa_20, sa_30, sa_11, sa_21, sa_31, sa_22, sa_32, sa_33;
 
 	__m256
@@ -466,7 +466,7 @@ void kernel_ssyrk_spotrf_nt_16x4_lib8(int kadd, int ksub, float *A0, float *A1,
 		mask;
 	
 	// first row
-	sa_00 = _mm_move_ss( sa_00, _mm256_castps256_ps128(d_00) );
+	sa_00 = _mm_move_ss( _mm_setzero_ps(), _mm256_castps256_ps128(d_00) );
 	zeros_ones = _mm_set_ss( 1e-7 ); // 0.0 ???
 	if( _mm_comigt_ss ( sa_00, zeros_ones ) )
 		{
@@ -863,7 +863,7 @@ void kernel_ssyrk_spotrf_nt_12x4_lib8(int kadd, int ksub, float *A0, float *A1,
 		temp = _mm256_mul_ps( a_07, b_0 );
 		c_03 = _mm256_add_ps( c_03, temp );
 		temp = _mm256_mul_ps( a_8f, b_0 );
-		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );
+/*		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );*/
 		c_83 = _mm256_add_ps( c_83, temp );
 
 		A0 += 8; // keep it !!!
@@ -1058,7 +1058,7 @@ void kernel_ssyrk_spotrf_nt_12x4_lib8(int kadd, int ksub, float *A0, float *A1,
 
 
 	// first row
-	sa_00 = _mm_move_ss( sa_00, d_40 );
+	sa_00 = _mm_move_ss( _mm_setzero_ps(), d_40 );
 	zeros_ones = _mm_set_ss( 1e-7 ); // 0.0 ???
 	if( _mm_comigt_ss ( sa_00, zeros_ones ) )
 		{
@@ -1381,7 +1381,7 @@ void kernel_ssyrk_spotrf_nt_8x4_lib8(int kadd, int ksub, float *A0, float *B, fl
 	
 		temp = _mm256_mul_ps( a_07, b_0 );
 		c_03 = _mm256_add_ps( c_03, temp );
-		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );
+/*		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );*/
 
 		A0 += 8; // keep it !!!
 		B  += 8; // keep it !!!
@@ -1504,7 +1504,7 @@ void kernel_ssyrk_spotrf_nt_8x4_lib8(int kadd, int ksub, float *A0, float *B, fl
 
 	// factorize the upper 4x4 matrix
 	__m128
-		zeros_ones, sab_temp,
+		zeros_ones,
 		sa_00, sa_10, sa_20, sa_30, sa_11, sa_21, sa_31, sa_22, sa_32, sa_33;
 
 	__m256
@@ -1516,7 +1516,7 @@ void kernel_ssyrk_spotrf_nt_8x4_lib8(int kadd, int ksub, float *A0, float *B, fl
 
 
 	// first row
-	sa_00 = _mm_move_ss( sa_00, _mm256_castps256_ps128(d_00) );
+	sa_00 = _mm_move_ss( _mm_setzero_ps(), _mm256_castps256_ps128(d_00) );
 	zeros_ones = _mm_set_ss( 1e-7 ); // 0.0 ???
 	if( _mm_comigt_ss ( sa_00, zeros_ones ) )
 		{
@@ -1815,7 +1815,7 @@ void kernel_ssyrk_spotrf_nt_8x2_lib8(int kadd, int ksub, float *A0, float *B, fl
 	
 		temp = _mm256_mul_ps( a_07, b_0 );
 		c_03 = _mm256_add_ps( c_03, temp );
-		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );
+/*		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );*/
 
 		A0 += 8; // keep it !!!
 		B  += 8; // keep it !!!
@@ -1938,11 +1938,11 @@ void kernel_ssyrk_spotrf_nt_8x2_lib8(int kadd, int ksub, float *A0, float *B, fl
 
 	// factorize the upper 4x4 matrix
 	__m128
-		zeros_ones, sab_temp,
-		sa_00, sa_10, sa_20, sa_30, sa_11, sa_21, sa_31, sa_22, sa_32, sa_33;
+		zeros_ones,
+		sa_00, sa_10, sa_11;
 
 	__m256
-		a_00, a_10, a_20, a_30, a_11, a_21, a_31, a_22, a_32, a_33;
+		a_00, a_10, a_11;
 	
 	__m256i
 		mask;
@@ -1950,7 +1950,7 @@ void kernel_ssyrk_spotrf_nt_8x2_lib8(int kadd, int ksub, float *A0, float *B, fl
 
 
 	// first row
-	sa_00 = _mm_move_ss( sa_00, _mm256_castps256_ps128(d_00) );
+	sa_00 = _mm_move_ss( _mm_setzero_ps(), _mm256_castps256_ps128(d_00) );
 	zeros_ones = _mm_set_ss( 1e-7 ); // 0.0 ???
 	if( _mm_comigt_ss ( sa_00, zeros_ones ) )
 		{
@@ -2305,7 +2305,7 @@ void kernel_ssyrk_spotrf_nt_4x4_lib8(int kadd, int ksub, float *A0, float *B, fl
 		sa_00, sa_10, sa_20, sa_30, sa_11, sa_21, sa_31, sa_22, sa_32, sa_33;
 
 	__m256
-		a_00, a_10, a_20, a_30, a_11, a_21, a_31, a_22, a_32, a_33;
+		a_00, a_11, a_22, a_33;
 	
 	__m128i
 		mask;
@@ -2313,7 +2313,7 @@ void kernel_ssyrk_spotrf_nt_4x4_lib8(int kadd, int ksub, float *A0, float *B, fl
 
 
 	// first row
-	sa_00 = _mm_move_ss( sa_00, d_00 );
+	sa_00 = _mm_move_ss( _mm_setzero_ps(), d_00 );
 	zeros_ones = _mm_set_ss( 1e-7 ); // 0.0 ???
 	if( _mm_comigt_ss ( sa_00, zeros_ones ) )
 		{
@@ -2336,7 +2336,6 @@ void kernel_ssyrk_spotrf_nt_4x4_lib8(int kadd, int ksub, float *A0, float *B, fl
 	// second row
 	sa_10 = _mm_permute_ps( d_00, 0x55 );
 	_mm_store_ss( &fact[1], sa_10 );
-	a_10  = _mm256_permute2f128_ps( _mm256_castps128_ps256( sa_10 ), _mm256_castps128_ps256( sa_10 ), 0x00 );
 	tem   = _mm_mul_ps( d_00, sa_10 );
 	d_01  = _mm_sub_ps( d_01, tem );
 	sa_11 = _mm_permute_ps( d_01, 0x55 );
@@ -2363,12 +2362,10 @@ void kernel_ssyrk_spotrf_nt_4x4_lib8(int kadd, int ksub, float *A0, float *B, fl
 	// third row
 	sa_20 = _mm_permute_ps( d_00, 0xaa );
 	_mm_store_ss( &fact[3], sa_20 );
-	a_20  = _mm256_permute2f128_ps( _mm256_castps128_ps256( sa_20 ), _mm256_castps128_ps256( sa_20 ), 0x00 );
 	tem   = _mm_mul_ps( d_00, sa_20 );
 	d_02  = _mm_sub_ps( d_02, tem );
 	sa_21 = _mm_permute_ps( d_01, 0xaa );
 	_mm_store_ss( &fact[4], sa_21 );
-	a_21  = _mm256_permute2f128_ps( _mm256_castps128_ps256( sa_21 ), _mm256_castps128_ps256( sa_21 ), 0x00 );
 	tem   = _mm_mul_ps( d_01, sa_21 );
 	d_02  = _mm_sub_ps( d_02, tem );
 	sa_22 = _mm_permute_ps( d_02, 0xaa );
@@ -2394,18 +2391,15 @@ void kernel_ssyrk_spotrf_nt_4x4_lib8(int kadd, int ksub, float *A0, float *B, fl
 
 	// fourth row
 	sa_30 = _mm_permute_ps( d_00, 0xff );
-	a_30  = _mm256_permute2f128_ps( _mm256_castps128_ps256( sa_30 ), _mm256_castps128_ps256( sa_30 ), 0x00 );
 	_mm_store_ss( &fact[6], sa_30 );
 	tem   = _mm_mul_ps( d_00, sa_30 );
 	d_03  = _mm_sub_ps( d_03, tem );
 	sa_31 = _mm_permute_ps( d_01, 0xff );
 	_mm_store_ss( &fact[7], sa_31 );
-	a_31  = _mm256_permute2f128_ps( _mm256_castps128_ps256( sa_31 ), _mm256_castps128_ps256( sa_31 ), 0x00 );
 	tem   = _mm_mul_ps( d_01, sa_31 );
 	d_03  = _mm_sub_ps( d_03, tem );
 	sa_32 = _mm_permute_ps( d_02, 0xff );
 	_mm_store_ss( &fact[8], sa_32 );
-	a_32  = _mm256_permute2f128_ps( _mm256_castps128_ps256( sa_32 ), _mm256_castps128_ps256( sa_32 ), 0x00 );
 	tem   = _mm_mul_ps( d_02, sa_32 );
 	d_03  = _mm_sub_ps( d_03, tem );
 	sa_33 = _mm_permute_ps( d_03, 0xff );
@@ -2734,10 +2728,10 @@ void kernel_ssyrk_spotrf_nt_4x2_lib8(int kadd, int ksub, float *A0, float *B, fl
 	// factorize the upper 4x4 matrix
 	__m128
 		tem, zeros_ones,
-		sa_00, sa_10, sa_20, sa_30, sa_11, sa_21, sa_31, sa_22, sa_32, sa_33;
+		sa_00, sa_10, sa_11;
 
 	__m256
-		a_00, a_10, a_20, a_30, a_11, a_21, a_31, a_22, a_32, a_33;
+		a_00, a_11;
 	
 	__m128i
 		mask;
@@ -2745,7 +2739,7 @@ void kernel_ssyrk_spotrf_nt_4x2_lib8(int kadd, int ksub, float *A0, float *B, fl
 
 
 	// first row
-	sa_00 = _mm_move_ss( sa_00, d_00 );
+	sa_00 = _mm_move_ss( _mm_setzero_ps(), d_00 );
 	zeros_ones = _mm_set_ss( 1e-7 ); // 0.0 ???
 	if( _mm_comigt_ss ( sa_00, zeros_ones ) )
 		{
@@ -2768,7 +2762,6 @@ void kernel_ssyrk_spotrf_nt_4x2_lib8(int kadd, int ksub, float *A0, float *B, fl
 	// second row
 	sa_10 = _mm_permute_ps( d_00, 0x55 );
 	_mm_store_ss( &fact[1], sa_10 );
-	a_10  = _mm256_permute2f128_ps( _mm256_castps128_ps256( sa_10 ), _mm256_castps128_ps256( sa_10 ), 0x00 );
 	tem   = _mm_mul_ps( d_00, sa_10 );
 	d_01  = _mm_sub_ps( d_01, tem );
 	sa_11 = _mm_permute_ps( d_01, 0x55 );
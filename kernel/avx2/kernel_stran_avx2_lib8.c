@@ -45,8 +45,8 @@ void kernel_stran_8_lib8(int kmax, int kna, float *A, int sda, float *C) // TODO
 	const int bs = 8;
 
 	__m128
-		u0, u1, u2, u3, u4, u5, u6, u7,
-		u8, u9, ua, ub, uc, ud, ue, uf;
+		u0, u1, u2, u3,
+		u8, u9, ua, ub;
 
 	__m256
 		v0, v1, v2, v3, v4, v5, v6, v7,
@@ -56,14 +56,14 @@ void kernel_strmm_nt_16x4_lib8(int kadd, float *A0, float *A1, float *B, float *
 	a_8f = _mm256_load_ps( &A1[0] );
 	b_0 = _mm256_shuffle_ps( b_03, b_03, 0 );
 
-/*	c_00 = _mm256_setzero_ps();*/
-/*	c_01 = _mm256_setzero_ps();*/
-/*	c_02 = _mm256_setzero_ps();*/
-/*	c_03 = _mm256_setzero_ps();*/
-/*	c_80 = _mm256_setzero_ps();*/
-/*	c_81 = _mm256_setzero_ps();*/
-/*	c_82 = _mm256_setzero_ps();*/
-/*	c_83 = _mm256_setzero_ps();*/
+	c_00 = _mm256_setzero_ps();
+	c_01 = _mm256_setzero_ps();
+	c_02 = _mm256_setzero_ps();
+	c_03 = _mm256_setzero_ps();
+	c_80 = _mm256_setzero_ps();
+	c_81 = _mm256_setzero_ps();
+	c_82 = _mm256_setzero_ps();
+	c_83 = _mm256_setzero_ps();
 
 
 
@@ -408,7 +408,7 @@ void kernel_strmm_nt_16x4_lib8(int kadd, float *A0, float *A1, float *B, float *
 		temp = _mm256_mul_ps( a_07, b_0 );
 		c_03 = _mm256_add_ps( c_03, temp );
 		temp = _mm256_mul_ps( a_8f, b_0 );
-		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );
+/*		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );*/
 		c_83 = _mm256_add_ps( c_83, temp );
 
 		}
@@ -448,6 +448,11 @@ void kernel_strmm_nt_8x4_lib8(int kadd, float *A0, float *B, float *D0)
 	a_07 = _mm256_load_ps( &A0[0] );
 	b_0 = _mm256_shuffle_ps( b_03, b_03, 0 );
 
+	c_00 = _mm256_setzero_ps();
+	c_01 = _mm256_setzero_ps();
+	c_02 = _mm256_setzero_ps();
+	c_03 = _mm256_setzero_ps();
+
 
 
 	// k==0
@@ -669,7 +674,7 @@ void kernel_strmm_nt_8x4_lib8(int kadd, float *A0, float *B, float *D0)
 	
 		temp = _mm256_mul_ps( a_07, b_0 );
 		c_03 = _mm256_add_ps( c_03, temp );
-		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );
+/*		b_0 = _mm256_shuffle_ps( B_03, B_03, 0 );*/
 
 		}
 
@@ -798,7 +803,6 @@ void corner_strmm_nt_16x1_lib8(float *A0, float *A1, float *B, float *C0, float
 	const int ldc = 8;
 
 	__m256
-		temp,
 		a_00, a_80,
 		b_00,
 		c_00, c_80;
@@ -871,7 +875,7 @@ void corner_strmm_nt_8x3_lib8(float *A0, float *B, float *C0)
 
 
 
-void corner_strmm_nt_8x2_lib8(float *A0, float *A1, float *B, float *C0, float *C1)
+void corner_strmm_nt_8x2_lib8(float *A0, float *B, float *C0)
 	{
 	
 	const int ldc = 8;
@@ -906,13 +910,12 @@ void corner_strmm_nt_8x2_lib8(float *A0, float *A1, float *B, float *C0, float *
 	}
 
 
-void corner_strmm_nt_8x1_lib8(float *A0, float *A1, float *B, float *C0, float *C1)
+void corner_strmm_nt_8x1_lib8(float *A0, float *B, float *C0)
 	{
 	
 	const int ldc = 8;
 
 	__m256
-		temp,
 		a_00,
 		b_00,
 		c_00;
@@ -458,7 +458,7 @@ void kernel_strsv_t_4_lib8(int kmax, int kna, float *A, int sda, float *x)
 	if(k<kmax)
 		{
 		
-		k_left_d = (float) kmax-k;
+		k_left_d = 8.0 - (kmax - k);
 		
 		x_0 = _mm256_loadu_ps( &x[0] );
 /*		x_0 = _mm256_blend_ps( x_0, zeros, 0xf0 );*/
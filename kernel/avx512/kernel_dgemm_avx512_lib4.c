@@ -0,0 +1,329 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <mmintrin.h>
+#include <xmmintrin.h>  // SSE
+#include <emmintrin.h>  // SSE2
+#include <pmmintrin.h>  // SSE3
+#include <smmintrin.h>  // SSE4
+#include <immintrin.h>  // AVX AVX2 AVX-512
+
+
+#if ! defined(BLASFEO)
+
+// D = C + A * B' (alg==1), C - A * B' (alg==-1) or A * B' (alg==0) on a 8x8 block of two 4-row panels;
+// each column lives in a zmm register, the rows km and columns kn are masked on store
+void kernel_dgemm_nt_8x8_vs_lib4(int km, int kn, int kmax, double *A0, int sda, double *B0, int sdb, double *C0, int sdc, double *D0, int sdd, int alg)
+	{
+
+	const int bs = 4;
+
+	double
+		*A1 = A0 + bs*sda,
+		*B1 = B0 + bs*sdb,
+		*C1 = C0 + bs*sdc,
+		*D1 = D0 + bs*sdd;
+
+	// do not read past the last panel
+	if(km<=4)
+		A1 = A0;
+	if(kn<=4)
+		B1 = B0;
+
+	int k;
+
+	__mmask8
+		mask_0, mask_1;
+
+	__m512d
+		a_0, b_0, d_0,
+		c_0, c_1, c_2, c_3, c_4, c_5, c_6, c_7;
+
+	c_0 = _mm512_setzero_pd();
+	c_1 = _mm512_setzero_pd();
+	c_2 = _mm512_setzero_pd();
+	c_3 = _mm512_setzero_pd();
+	c_4 = _mm512_setzero_pd();
+	c_5 = _mm512_setzero_pd();
+	c_6 = _mm512_setzero_pd();
+	c_7 = _mm512_setzero_pd();
+
+	if(kn<=4) // 8x4
+		{
+		for(k=0; k<kmax; k++)
+			{
+			a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A0[0] ) ), _mm256_load_pd( &A1[0] ), 0x1 );
+			b_0 = _mm512_set1_pd( B0[0] );
+			c_0 = _mm512_fmadd_pd( a_0, b_0, c_0 );
+			b_0 = _mm512_set1_pd( B0[1] );
+			c_1 = _mm512_fmadd_pd( a_0, b_0, c_1 );
+			b_0 = _mm512_set1_pd( B0[2] );
+			c_2 = _mm512_fmadd_pd( a_0, b_0, c_2 );
+			b_0 = _mm512_set1_pd( B0[3] );
+			c_3 = _mm512_fmadd_pd( a_0, b_0, c_3 );
+
+			A0 += 4;
+			A1 += 4;
+			B0 += 4;
+			}
+		}
+	else // 8x8
+		{
+		for(k=0; k<kmax; k++)
+			{
+			a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A0[0] ) ), _mm256_load_pd( &A1[0] ), 0x1 );
+			b_0 = _mm512_set1_pd( B0[0] );
+			c_0 = _mm512_fmadd_pd( a_0, b_0, c_0 );
+			b_0 = _mm512_set1_pd( B0[1] );
+			c_1 = _mm512_fmadd_pd( a_0, b_0, c_1 );
+			b_0 = _mm512_set1_pd( B0[2] );
+			c_2 = _mm512_fmadd_pd( a_0, b_0, c_2 );
+			b_0 = _mm512_set1_pd( B0[3] );
+			c_3 = _mm512_fmadd_pd( a_0, b_0, c_3 );
+			b_0 = _mm512_set1_pd( B1[0] );
+			c_4 = _mm512_fmadd_pd( a_0, b_0, c_4 );
+			b_0 = _mm512_set1_pd( B1[1] );
+			c_5 = _mm512_fmadd_pd( a_0, b_0, c_5 );
+			b_0 = _mm512_set1_pd( B1[2] );
+			c_6 = _mm512_fmadd_pd( a_0, b_0, c_6 );
+			b_0 = _mm512_set1_pd( B1[3] );
+			c_7 = _mm512_fmadd_pd( a_0, b_0, c_7 );
+
+			A0 += 4;
+			A1 += 4;
+			B0 += 4;
+			B1 += 4;
+			}
+		}
+
+	mask_0 = km>=4 ? 0xf : (1<<km)-1;
+	mask_1 = km>=8 ? 0xf : ( km>4 ? (1<<(km-4))-1 : 0x0 );
+
+	if(alg!=0)
+		{
+		if(alg==1) // C += A * B'
+			{
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*0] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*0] ), 0x1 );
+			c_0 = _mm512_add_pd( d_0, c_0 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*1] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*1] ), 0x1 );
+			c_1 = _mm512_add_pd( d_0, c_1 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*2] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*2] ), 0x1 );
+			c_2 = _mm512_add_pd( d_0, c_2 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*3] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*3] ), 0x1 );
+			c_3 = _mm512_add_pd( d_0, c_3 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*4] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*4] ), 0x1 );
+			c_4 = _mm512_add_pd( d_0, c_4 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*5] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*5] ), 0x1 );
+			c_5 = _mm512_add_pd( d_0, c_5 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*6] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*6] ), 0x1 );
+			c_6 = _mm512_add_pd( d_0, c_6 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*7] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*7] ), 0x1 );
+			c_7 = _mm512_add_pd( d_0, c_7 );
+			}
+		else // C -= A * B'
+			{
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*0] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*0] ), 0x1 );
+			c_0 = _mm512_sub_pd( d_0, c_0 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*1] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*1] ), 0x1 );
+			c_1 = _mm512_sub_pd( d_0, c_1 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*2] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*2] ), 0x1 );
+			c_2 = _mm512_sub_pd( d_0, c_2 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*3] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*3] ), 0x1 );
+			c_3 = _mm512_sub_pd( d_0, c_3 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*4] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*4] ), 0x1 );
+			c_4 = _mm512_sub_pd( d_0, c_4 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*5] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*5] ), 0x1 );
+			c_5 = _mm512_sub_pd( d_0, c_5 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*6] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*6] ), 0x1 );
+			c_6 = _mm512_sub_pd( d_0, c_6 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*7] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*7] ), 0x1 );
+			c_7 = _mm512_sub_pd( d_0, c_7 );
+			}
+		}
+
+	// store
+	_mm256_mask_store_pd( &D0[bs*0], mask_0, _mm512_castpd512_pd256( c_0 ) );
+	_mm256_mask_store_pd( &D1[bs*0], mask_1, _mm512_extractf64x4_pd( c_0, 0x1 ) );
+	if(kn<=1)
+		return;
+	_mm256_mask_store_pd( &D0[bs*1], mask_0, _mm512_castpd512_pd256( c_1 ) );
+	_mm256_mask_store_pd( &D1[bs*1], mask_1, _mm512_extractf64x4_pd( c_1, 0x1 ) );
+	if(kn<=2)
+		return;
+	_mm256_mask_store_pd( &D0[bs*2], mask_0, _mm512_castpd512_pd256( c_2 ) );
+	_mm256_mask_store_pd( &D1[bs*2], mask_1, _mm512_extractf64x4_pd( c_2, 0x1 ) );
+	if(kn<=3)
+		return;
+	_mm256_mask_store_pd( &D0[bs*3], mask_0, _mm512_castpd512_pd256( c_3 ) );
+	_mm256_mask_store_pd( &D1[bs*3], mask_1, _mm512_extractf64x4_pd( c_3, 0x1 ) );
+	if(kn<=4)
+		return;
+	_mm256_mask_store_pd( &D0[bs*4], mask_0, _mm512_castpd512_pd256( c_4 ) );
+	_mm256_mask_store_pd( &D1[bs*4], mask_1, _mm512_extractf64x4_pd( c_4, 0x1 ) );
+	if(kn<=5)
+		return;
+	_mm256_mask_store_pd( &D0[bs*5], mask_0, _mm512_castpd512_pd256( c_5 ) );
+	_mm256_mask_store_pd( &D1[bs*5], mask_1, _mm512_extractf64x4_pd( c_5, 0x1 ) );
+	if(kn<=6)
+		return;
+	_mm256_mask_store_pd( &D0[bs*6], mask_0, _mm512_castpd512_pd256( c_6 ) );
+	_mm256_mask_store_pd( &D1[bs*6], mask_1, _mm512_extractf64x4_pd( c_6, 0x1 ) );
+	if(kn<=7)
+		return;
+	_mm256_mask_store_pd( &D0[bs*7], mask_0, _mm512_castpd512_pd256( c_7 ) );
+	_mm256_mask_store_pd( &D1[bs*7], mask_1, _mm512_extractf64x4_pd( c_7, 0x1 ) );
+
+	}
+
+
+
+void kernel_dgemm_nt_8x8_lib4(int kmax, double *A0, int sda, double *B0, int sdb, double *C0, int sdc, double *D0, int sdd, int alg)
+	{
+
+	kernel_dgemm_nt_8x8_vs_lib4(8, 8, kmax, A0, sda, B0, sdb, C0, sdc, D0, sdd, alg);
+
+	}
+
+
+
+// lower triangular part of D = C + A * B' (alg==1), C - A * B' (alg==-1) or A * B' (alg==0) on a 8x8 diagonal block;
+// the lower-right 4x4 corner only needs the bottom panel, so it is computed in ymm registers
+void kernel_dsyrk_nt_8x8_lib4(int kmax, double *A0, int sda, double *B0, int sdb, double *C0, int sdc, double *D0, int sdd, int alg)
+	{
+
+	const int bs = 4;
+
+	double
+		*A1 = A0 + bs*sda,
+		*B1 = B0 + bs*sdb,
+		*C1 = C0 + bs*sdc,
+		*D1 = D0 + bs*sdd;
+
+	int k;
+
+	__m512d
+		a_0, b_0, d_0,
+		c_0, c_1, c_2, c_3;
+
+	__m256d
+		a_4, b_4, d_4,
+		c_4, c_5, c_6, c_7;
+
+	c_0 = _mm512_setzero_pd();
+	c_1 = _mm512_setzero_pd();
+	c_2 = _mm512_setzero_pd();
+	c_3 = _mm512_setzero_pd();
+	c_4 = _mm256_setzero_pd();
+	c_5 = _mm256_setzero_pd();
+	c_6 = _mm256_setzero_pd();
+	c_7 = _mm256_setzero_pd();
+
+	for(k=0; k<kmax; k++)
+		{
+		a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A0[0] ) ), _mm256_load_pd( &A1[0] ), 0x1 );
+		b_0 = _mm512_set1_pd( B0[0] );
+		c_0 = _mm512_fmadd_pd( a_0, b_0, c_0 );
+		b_0 = _mm512_set1_pd( B0[1] );
+		c_1 = _mm512_fmadd_pd( a_0, b_0, c_1 );
+		b_0 = _mm512_set1_pd( B0[2] );
+		c_2 = _mm512_fmadd_pd( a_0, b_0, c_2 );
+		b_0 = _mm512_set1_pd( B0[3] );
+		c_3 = _mm512_fmadd_pd( a_0, b_0, c_3 );
+		a_4 = _mm512_extractf64x4_pd( a_0, 0x1 );
+		b_4 = _mm256_broadcast_sd( &B1[0] );
+		c_4 = _mm256_fmadd_pd( a_4, b_4, c_4 );
+		b_4 = _mm256_broadcast_sd( &B1[1] );
+		c_5 = _mm256_fmadd_pd( a_4, b_4, c_5 );
+		b_4 = _mm256_broadcast_sd( &B1[2] );
+		c_6 = _mm256_fmadd_pd( a_4, b_4, c_6 );
+		b_4 = _mm256_broadcast_sd( &B1[3] );
+		c_7 = _mm256_fmadd_pd( a_4, b_4, c_7 );
+
+		A0 += 4;
+		A1 += 4;
+		B0 += 4;
+		B1 += 4;
+		}
+
+	if(alg!=0)
+		{
+		if(alg==1) // C += A * B'
+			{
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*0] ) ), _mm256_load_pd( &C1[bs*0] ), 0x1 );
+			c_0 = _mm512_add_pd( d_0, c_0 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*1] ) ), _mm256_load_pd( &C1[bs*1] ), 0x1 );
+			c_1 = _mm512_add_pd( d_0, c_1 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*2] ) ), _mm256_load_pd( &C1[bs*2] ), 0x1 );
+			c_2 = _mm512_add_pd( d_0, c_2 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*3] ) ), _mm256_load_pd( &C1[bs*3] ), 0x1 );
+			c_3 = _mm512_add_pd( d_0, c_3 );
+			d_4 = _mm256_load_pd( &C1[bs*4] );
+			c_4 = _mm256_add_pd( d_4, c_4 );
+			d_4 = _mm256_load_pd( &C1[bs*5] );
+			c_5 = _mm256_add_pd( d_4, c_5 );
+			d_4 = _mm256_load_pd( &C1[bs*6] );
+			c_6 = _mm256_add_pd( d_4, c_6 );
+			d_4 = _mm256_load_pd( &C1[bs*7] );
+			c_7 = _mm256_add_pd( d_4, c_7 );
+			}
+		else // C -= A * B'
+			{
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*0] ) ), _mm256_load_pd( &C1[bs*0] ), 0x1 );
+			c_0 = _mm512_sub_pd( d_0, c_0 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*1] ) ), _mm256_load_pd( &C1[bs*1] ), 0x1 );
+			c_1 = _mm512_sub_pd( d_0, c_1 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*2] ) ), _mm256_load_pd( &C1[bs*2] ), 0x1 );
+			c_2 = _mm512_sub_pd( d_0, c_2 );
+			d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*3] ) ), _mm256_load_pd( &C1[bs*3] ), 0x1 );
+			c_3 = _mm512_sub_pd( d_0, c_3 );
+			d_4 = _mm256_load_pd( &C1[bs*4] );
+			c_4 = _mm256_sub_pd( d_4, c_4 );
+			d_4 = _mm256_load_pd( &C1[bs*5] );
+			c_5 = _mm256_sub_pd( d_4, c_5 );
+			d_4 = _mm256_load_pd( &C1[bs*6] );
+			c_6 = _mm256_sub_pd( d_4, c_6 );
+			d_4 = _mm256_load_pd( &C1[bs*7] );
+			c_7 = _mm256_sub_pd( d_4, c_7 );
+			}
+		}
+
+	// store lower triangle
+	_mm256_mask_store_pd( &D0[bs*0], 0xf, _mm512_castpd512_pd256( c_0 ) );
+	_mm256_store_pd( &D1[bs*0], _mm512_extractf64x4_pd( c_0, 0x1 ) );
+	_mm256_mask_store_pd( &D0[bs*1], 0xe, _mm512_castpd512_pd256( c_1 ) );
+	_mm256_store_pd( &D1[bs*1], _mm512_extractf64x4_pd( c_1, 0x1 ) );
+	_mm256_mask_store_pd( &D0[bs*2], 0xc, _mm512_castpd512_pd256( c_2 ) );
+	_mm256_store_pd( &D1[bs*2], _mm512_extractf64x4_pd( c_2, 0x1 ) );
+	_mm256_mask_store_pd( &D0[bs*3], 0x8, _mm512_castpd512_pd256( c_3 ) );
+	_mm256_store_pd( &D1[bs*3], _mm512_extractf64x4_pd( c_3, 0x1 ) );
+	_mm256_mask_store_pd( &D1[bs*4], 0xf, c_4 );
+	_mm256_mask_store_pd( &D1[bs*5], 0xe, c_5 );
+	_mm256_mask_store_pd( &D1[bs*6], 0xc, c_6 );
+	_mm256_mask_store_pd( &D1[bs*7], 0x8, c_7 );
+
+	}
+
+#endif
+
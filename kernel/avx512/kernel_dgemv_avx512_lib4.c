@@ -0,0 +1,246 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <mmintrin.h>
+#include <xmmintrin.h>  // SSE
+#include <emmintrin.h>  // SSE2
+#include <pmmintrin.h>  // SSE3
+#include <smmintrin.h>  // SSE4
+#include <immintrin.h>  // AVX AVX2 AVX-512
+
+
+#if ! defined(BLASFEO)
+
+// z = y + A * x (alg==1), y - A * x (alg==-1) or A * x (alg==0), with A 16 rows (four panels) by kmax columns
+void kernel_dgemv_n_16_lib4(int kmax, double *A0, int sda, double *x, double *y, double *z, int alg)
+	{
+
+	const int bs = 4;
+
+	double
+		*A1 = A0 + bs*sda,
+		*A2 = A1 + bs*sda,
+		*A3 = A2 + bs*sda;
+
+	int k;
+
+	__m512d
+		x_0, a_01, a_23,
+		y_01a, y_23a, y_01b, y_23b, y_01c, y_23c, y_01d, y_23d;
+
+	y_01a = _mm512_setzero_pd();
+	y_23a = _mm512_setzero_pd();
+	y_01b = _mm512_setzero_pd();
+	y_23b = _mm512_setzero_pd();
+	y_01c = _mm512_setzero_pd();
+	y_23c = _mm512_setzero_pd();
+	y_01d = _mm512_setzero_pd();
+	y_23d = _mm512_setzero_pd();
+
+	k = 0;
+	for(; k<kmax-3; k+=4)
+		{
+		x_0  = _mm512_set1_pd( x[0] );
+		a_01 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A0[0] ) ), _mm256_load_pd( &A1[0] ), 0x1 );
+		a_23 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A2[0] ) ), _mm256_load_pd( &A3[0] ), 0x1 );
+		y_01a = _mm512_fmadd_pd( a_01, x_0, y_01a );
+		y_23a = _mm512_fmadd_pd( a_23, x_0, y_23a );
+
+		x_0  = _mm512_set1_pd( x[1] );
+		a_01 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A0[4] ) ), _mm256_load_pd( &A1[4] ), 0x1 );
+		a_23 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A2[4] ) ), _mm256_load_pd( &A3[4] ), 0x1 );
+		y_01b = _mm512_fmadd_pd( a_01, x_0, y_01b );
+		y_23b = _mm512_fmadd_pd( a_23, x_0, y_23b );
+
+		x_0  = _mm512_set1_pd( x[2] );
+		a_01 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A0[8] ) ), _mm256_load_pd( &A1[8] ), 0x1 );
+		a_23 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A2[8] ) ), _mm256_load_pd( &A3[8] ), 0x1 );
+		y_01c = _mm512_fmadd_pd( a_01, x_0, y_01c );
+		y_23c = _mm512_fmadd_pd( a_23, x_0, y_23c );
+
+		x_0  = _mm512_set1_pd( x[3] );
+		a_01 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A0[12] ) ), _mm256_load_pd( &A1[12] ), 0x1 );
+		a_23 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A2[12] ) ), _mm256_load_pd( &A3[12] ), 0x1 );
+		y_01d = _mm512_fmadd_pd( a_01, x_0, y_01d );
+		y_23d = _mm512_fmadd_pd( a_23, x_0, y_23d );
+
+		A0 += 16;
+		A1 += 16;
+		A2 += 16;
+		A3 += 16;
+		x  += 4;
+		}
+	for(; k<kmax; k++)
+		{
+		x_0  = _mm512_set1_pd( x[0] );
+		a_01 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A0[0] ) ), _mm256_load_pd( &A1[0] ), 0x1 );
+		a_23 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A2[0] ) ), _mm256_load_pd( &A3[0] ), 0x1 );
+		y_01a = _mm512_fmadd_pd( a_01, x_0, y_01a );
+		y_23a = _mm512_fmadd_pd( a_23, x_0, y_23a );
+
+		A0 += 4;
+		A1 += 4;
+		A2 += 4;
+		A3 += 4;
+		x  += 1;
+		}
+
+	y_01a = _mm512_add_pd( y_01a, y_01b );
+	y_23a = _mm512_add_pd( y_23a, y_23b );
+	y_01c = _mm512_add_pd( y_01c, y_01d );
+	y_23c = _mm512_add_pd( y_23c, y_23d );
+	y_01a = _mm512_add_pd( y_01a, y_01c );
+	y_23a = _mm512_add_pd( y_23a, y_23c );
+
+	if(alg!=0)
+		{
+		if(alg==1)
+			{
+			y_01a = _mm512_add_pd( _mm512_loadu_pd( &y[0] ), y_01a );
+			y_23a = _mm512_add_pd( _mm512_loadu_pd( &y[8] ), y_23a );
+			}
+		else // alg==-1
+			{
+			y_01a = _mm512_sub_pd( _mm512_loadu_pd( &y[0] ), y_01a );
+			y_23a = _mm512_sub_pd( _mm512_loadu_pd( &y[8] ), y_23a );
+			}
+		}
+
+	_mm512_storeu_pd( &z[0], y_01a );
+	_mm512_storeu_pd( &z[8], y_23a );
+
+	}
+
+
+
+// z = y + A' * x (alg==1), y - A' * x (alg==-1) or A' * x (alg==0), with A kmax rows by 16 columns;
+// a row panel of 16 columns is 8 contiguous zmm registers, each holding two columns
+void kernel_dgemv_t_16_lib4(int kmax, double *A, int sda, double *x, double *y, double *z, int alg)
+	{
+
+	if(kmax<=0)
+		return;
+
+	const int bs = 4;
+
+	int k;
+
+	__mmask8
+		mask;
+
+	__m512d
+		x_0, a_0, t_0, t_1, t_2, t_3,
+		y_0, y_1, y_2, y_3, y_4, y_5, y_6, y_7;
+
+	y_0 = _mm512_setzero_pd();
+	y_1 = _mm512_setzero_pd();
+	y_2 = _mm512_setzero_pd();
+	y_3 = _mm512_setzero_pd();
+	y_4 = _mm512_setzero_pd();
+	y_5 = _mm512_setzero_pd();
+	y_6 = _mm512_setzero_pd();
+	y_7 = _mm512_setzero_pd();
+
+	k = 0;
+	for(; k<kmax-3; k+=4)
+		{
+		x_0 = _mm512_broadcast_f64x4( _mm256_loadu_pd( &x[0] ) );
+		a_0 = _mm512_loadu_pd( &A[0] );
+		y_0 = _mm512_fmadd_pd( a_0, x_0, y_0 );
+		a_0 = _mm512_loadu_pd( &A[8] );
+		y_1 = _mm512_fmadd_pd( a_0, x_0, y_1 );
+		a_0 = _mm512_loadu_pd( &A[16] );
+		y_2 = _mm512_fmadd_pd( a_0, x_0, y_2 );
+		a_0 = _mm512_loadu_pd( &A[24] );
+		y_3 = _mm512_fmadd_pd( a_0, x_0, y_3 );
+		a_0 = _mm512_loadu_pd( &A[32] );
+		y_4 = _mm512_fmadd_pd( a_0, x_0, y_4 );
+		a_0 = _mm512_loadu_pd( &A[40] );
+		y_5 = _mm512_fmadd_pd( a_0, x_0, y_5 );
+		a_0 = _mm512_loadu_pd( &A[48] );
+		y_6 = _mm512_fmadd_pd( a_0, x_0, y_6 );
+		a_0 = _mm512_loadu_pd( &A[56] );
+		y_7 = _mm512_fmadd_pd( a_0, x_0, y_7 );
+
+		A += bs*sda;
+		x += 4;
+		}
+	if(k<kmax)
+		{
+		mask = (1<<(kmax-k))-1;
+		mask = mask | (mask<<4);
+		x_0 = _mm512_broadcast_f64x4( _mm256_maskz_loadu_pd( mask & 0xf, &x[0] ) );
+		a_0 = _mm512_maskz_loadu_pd( mask, &A[0] );
+		y_0 = _mm512_fmadd_pd( a_0, x_0, y_0 );
+		a_0 = _mm512_maskz_loadu_pd( mask, &A[8] );
+		y_1 = _mm512_fmadd_pd( a_0, x_0, y_1 );
+		a_0 = _mm512_maskz_loadu_pd( mask, &A[16] );
+		y_2 = _mm512_fmadd_pd( a_0, x_0, y_2 );
+		a_0 = _mm512_maskz_loadu_pd( mask, &A[24] );
+		y_3 = _mm512_fmadd_pd( a_0, x_0, y_3 );
+		a_0 = _mm512_maskz_loadu_pd( mask, &A[32] );
+		y_4 = _mm512_fmadd_pd( a_0, x_0, y_4 );
+		a_0 = _mm512_maskz_loadu_pd( mask, &A[40] );
+		y_5 = _mm512_fmadd_pd( a_0, x_0, y_5 );
+		a_0 = _mm512_maskz_loadu_pd( mask, &A[48] );
+		y_6 = _mm512_fmadd_pd( a_0, x_0, y_6 );
+		a_0 = _mm512_maskz_loadu_pd( mask, &A[56] );
+		y_7 = _mm512_fmadd_pd( a_0, x_0, y_7 );
+		}
+
+	// reduce: y_j holds columns 2j (low half) and 2j+1 (high half)
+	t_0 = _mm512_add_pd( _mm512_unpacklo_pd( y_0, y_1 ), _mm512_unpackhi_pd( y_0, y_1 ) );
+	t_0 = _mm512_add_pd( t_0, _mm512_shuffle_f64x2( t_0, t_0, 0xb1 ) );
+	t_1 = _mm512_add_pd( _mm512_unpacklo_pd( y_2, y_3 ), _mm512_unpackhi_pd( y_2, y_3 ) );
+	t_1 = _mm512_add_pd( t_1, _mm512_shuffle_f64x2( t_1, t_1, 0xb1 ) );
+	t_2 = _mm512_add_pd( _mm512_unpacklo_pd( y_4, y_5 ), _mm512_unpackhi_pd( y_4, y_5 ) );
+	t_2 = _mm512_add_pd( t_2, _mm512_shuffle_f64x2( t_2, t_2, 0xb1 ) );
+	t_3 = _mm512_add_pd( _mm512_unpacklo_pd( y_6, y_7 ), _mm512_unpackhi_pd( y_6, y_7 ) );
+	t_3 = _mm512_add_pd( t_3, _mm512_shuffle_f64x2( t_3, t_3, 0xb1 ) );
+	// columns 4q, 4q+2 are in lanes 0, 1 and columns 4q+1, 4q+3 are in lanes 4, 5 of t_q
+	y_0 = _mm512_permutex2var_pd( t_0, _mm512_set_epi64( 13, 9, 12, 8, 5, 1, 4, 0 ), t_1 );
+	y_1 = _mm512_permutex2var_pd( t_2, _mm512_set_epi64( 13, 9, 12, 8, 5, 1, 4, 0 ), t_3 );
+
+	if(alg!=0)
+		{
+		if(alg==1)
+			{
+			y_0 = _mm512_add_pd( _mm512_loadu_pd( &y[0] ), y_0 );
+			y_1 = _mm512_add_pd( _mm512_loadu_pd( &y[8] ), y_1 );
+			}
+		else // alg==-1
+			{
+			y_0 = _mm512_sub_pd( _mm512_loadu_pd( &y[0] ), y_0 );
+			y_1 = _mm512_sub_pd( _mm512_loadu_pd( &y[8] ), y_1 );
+			}
+		}
+
+	_mm512_storeu_pd( &z[0], y_0 );
+	_mm512_storeu_pd( &z[8], y_1 );
+
+	}
+
+#endif
+
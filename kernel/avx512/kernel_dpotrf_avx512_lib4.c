@@ -0,0 +1,275 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <mmintrin.h>
+#include <xmmintrin.h>  // SSE
+#include <emmintrin.h>  // SSE2
+#include <pmmintrin.h>  // SSE3
+#include <smmintrin.h>  // SSE4
+#include <immintrin.h>  // AVX AVX2 AVX-512
+#include <math.h>
+
+
+#if ! defined(BLASFEO)
+
+// D = chol( C + Ap * Bp' - Am * Bm' ) on a 8x8 diagonal block (only the lower triangle is stored);
+// right-looking factorization with each column of the block in a zmm register
+void kernel_dsyrk_dpotrf_nt_8x8_lib4(int kadd, double *Ap0, int sdap, double *Bp0, int sdbp, int ksub, double *Am0, int sdam, double *Bm0, int sdbm, int alg, double *C0, int sdc, double *D0, int sdd, double *inv_diag_D)
+	{
+
+	const int bs = 4;
+
+	double
+		*Ap1 = Ap0 + bs*sdap,
+		*Bp1 = Bp0 + bs*sdbp,
+		*Am1 = Am0 + bs*sdam,
+		*Bm1 = Bm0 + bs*sdbm,
+		*C1  = C0  + bs*sdc,
+		*D1  = D0  + bs*sdd;
+
+	int k;
+
+	double
+		d_ii;
+
+	__m512d
+		a_0, b_0, d_0,
+		c_0, c_1, c_2, c_3, c_4, c_5, c_6, c_7;
+
+	c_0 = _mm512_setzero_pd();
+	c_1 = _mm512_setzero_pd();
+	c_2 = _mm512_setzero_pd();
+	c_3 = _mm512_setzero_pd();
+	c_4 = _mm512_setzero_pd();
+	c_5 = _mm512_setzero_pd();
+	c_6 = _mm512_setzero_pd();
+	c_7 = _mm512_setzero_pd();
+
+	if(kadd>0)
+		{
+
+		for(k=0; k<kadd; k++)
+			{
+			a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &Ap0[0] ) ), _mm256_load_pd( &Ap1[0] ), 0x1 );
+			b_0 = _mm512_set1_pd( Bp0[0] );
+			c_0 = _mm512_fmadd_pd( a_0, b_0, c_0 );
+			b_0 = _mm512_set1_pd( Bp0[1] );
+			c_1 = _mm512_fmadd_pd( a_0, b_0, c_1 );
+			b_0 = _mm512_set1_pd( Bp0[2] );
+			c_2 = _mm512_fmadd_pd( a_0, b_0, c_2 );
+			b_0 = _mm512_set1_pd( Bp0[3] );
+			c_3 = _mm512_fmadd_pd( a_0, b_0, c_3 );
+			b_0 = _mm512_set1_pd( Bp1[0] );
+			c_4 = _mm512_fmadd_pd( a_0, b_0, c_4 );
+			b_0 = _mm512_set1_pd( Bp1[1] );
+			c_5 = _mm512_fmadd_pd( a_0, b_0, c_5 );
+			b_0 = _mm512_set1_pd( Bp1[2] );
+			c_6 = _mm512_fmadd_pd( a_0, b_0, c_6 );
+			b_0 = _mm512_set1_pd( Bp1[3] );
+			c_7 = _mm512_fmadd_pd( a_0, b_0, c_7 );
+
+			Ap0 += 4;
+			Ap1 += 4;
+			Bp0 += 4;
+			Bp1 += 4;
+			}
+
+		if(alg==-1)
+			{
+			c_0 = _mm512_sub_pd( _mm512_setzero_pd(), c_0 );
+			c_1 = _mm512_sub_pd( _mm512_setzero_pd(), c_1 );
+			c_2 = _mm512_sub_pd( _mm512_setzero_pd(), c_2 );
+			c_3 = _mm512_sub_pd( _mm512_setzero_pd(), c_3 );
+			c_4 = _mm512_sub_pd( _mm512_setzero_pd(), c_4 );
+			c_5 = _mm512_sub_pd( _mm512_setzero_pd(), c_5 );
+			c_6 = _mm512_sub_pd( _mm512_setzero_pd(), c_6 );
+			c_7 = _mm512_sub_pd( _mm512_setzero_pd(), c_7 );
+			}
+
+		}
+
+	if(ksub>0)
+		{
+
+		for(k=0; k<ksub; k++)
+			{
+			a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &Am0[0] ) ), _mm256_load_pd( &Am1[0] ), 0x1 );
+			b_0 = _mm512_set1_pd( Bm0[0] );
+			c_0 = _mm512_fnmadd_pd( a_0, b_0, c_0 );
+			b_0 = _mm512_set1_pd( Bm0[1] );
+			c_1 = _mm512_fnmadd_pd( a_0, b_0, c_1 );
+			b_0 = _mm512_set1_pd( Bm0[2] );
+			c_2 = _mm512_fnmadd_pd( a_0, b_0, c_2 );
+			b_0 = _mm512_set1_pd( Bm0[3] );
+			c_3 = _mm512_fnmadd_pd( a_0, b_0, c_3 );
+			b_0 = _mm512_set1_pd( Bm1[0] );
+			c_4 = _mm512_fnmadd_pd( a_0, b_0, c_4 );
+			b_0 = _mm512_set1_pd( Bm1[1] );
+			c_5 = _mm512_fnmadd_pd( a_0, b_0, c_5 );
+			b_0 = _mm512_set1_pd( Bm1[2] );
+			c_6 = _mm512_fnmadd_pd( a_0, b_0, c_6 );
+			b_0 = _mm512_set1_pd( Bm1[3] );
+			c_7 = _mm512_fnmadd_pd( a_0, b_0, c_7 );
+
+			Am0 += 4;
+			Am1 += 4;
+			Bm0 += 4;
+			Bm1 += 4;
+			}
+
+		}
+
+	if(alg!=0)
+		{
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*0] ) ), _mm256_load_pd( &C1[bs*0] ), 0x1 );
+		c_0 = _mm512_add_pd( c_0, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*1] ) ), _mm256_load_pd( &C1[bs*1] ), 0x1 );
+		c_1 = _mm512_add_pd( c_1, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*2] ) ), _mm256_load_pd( &C1[bs*2] ), 0x1 );
+		c_2 = _mm512_add_pd( c_2, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*3] ) ), _mm256_load_pd( &C1[bs*3] ), 0x1 );
+		c_3 = _mm512_add_pd( c_3, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*4] ) ), _mm256_load_pd( &C1[bs*4] ), 0x1 );
+		c_4 = _mm512_add_pd( c_4, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*5] ) ), _mm256_load_pd( &C1[bs*5] ), 0x1 );
+		c_5 = _mm512_add_pd( c_5, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*6] ) ), _mm256_load_pd( &C1[bs*6] ), 0x1 );
+		c_6 = _mm512_add_pd( c_6, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*7] ) ), _mm256_load_pd( &C1[bs*7] ), 0x1 );
+		c_7 = _mm512_add_pd( c_7, d_0 );
+		}
+
+	// factorize
+
+	d_ii = _mm_cvtsd_f64( _mm512_castpd512_pd128( _mm512_permutexvar_pd( _mm512_set1_epi64( 0 ), c_0 ) ) );
+	if(d_ii>1e-15)
+		d_ii = 1.0/sqrt(d_ii);
+	else
+		d_ii = 0.0;
+	inv_diag_D[0] = d_ii;
+	c_0 = _mm512_mul_pd( c_0, _mm512_set1_pd( d_ii ) );
+	c_1 = _mm512_fnmadd_pd( c_0, _mm512_permutexvar_pd( _mm512_set1_epi64( 1 ), c_0 ), c_1 );
+	c_2 = _mm512_fnmadd_pd( c_0, _mm512_permutexvar_pd( _mm512_set1_epi64( 2 ), c_0 ), c_2 );
+	c_3 = _mm512_fnmadd_pd( c_0, _mm512_permutexvar_pd( _mm512_set1_epi64( 3 ), c_0 ), c_3 );
+	c_4 = _mm512_fnmadd_pd( c_0, _mm512_permutexvar_pd( _mm512_set1_epi64( 4 ), c_0 ), c_4 );
+	c_5 = _mm512_fnmadd_pd( c_0, _mm512_permutexvar_pd( _mm512_set1_epi64( 5 ), c_0 ), c_5 );
+	c_6 = _mm512_fnmadd_pd( c_0, _mm512_permutexvar_pd( _mm512_set1_epi64( 6 ), c_0 ), c_6 );
+	c_7 = _mm512_fnmadd_pd( c_0, _mm512_permutexvar_pd( _mm512_set1_epi64( 7 ), c_0 ), c_7 );
+
+	d_ii = _mm_cvtsd_f64( _mm512_castpd512_pd128( _mm512_permutexvar_pd( _mm512_set1_epi64( 1 ), c_1 ) ) );
+	if(d_ii>1e-15)
+		d_ii = 1.0/sqrt(d_ii);
+	else
+		d_ii = 0.0;
+	inv_diag_D[1] = d_ii;
+	c_1 = _mm512_mul_pd( c_1, _mm512_set1_pd( d_ii ) );
+	c_2 = _mm512_fnmadd_pd( c_1, _mm512_permutexvar_pd( _mm512_set1_epi64( 2 ), c_1 ), c_2 );
+	c_3 = _mm512_fnmadd_pd( c_1, _mm512_permutexvar_pd( _mm512_set1_epi64( 3 ), c_1 ), c_3 );
+	c_4 = _mm512_fnmadd_pd( c_1, _mm512_permutexvar_pd( _mm512_set1_epi64( 4 ), c_1 ), c_4 );
+	c_5 = _mm512_fnmadd_pd( c_1, _mm512_permutexvar_pd( _mm512_set1_epi64( 5 ), c_1 ), c_5 );
+	c_6 = _mm512_fnmadd_pd( c_1, _mm512_permutexvar_pd( _mm512_set1_epi64( 6 ), c_1 ), c_6 );
+	c_7 = _mm512_fnmadd_pd( c_1, _mm512_permutexvar_pd( _mm512_set1_epi64( 7 ), c_1 ), c_7 );
+
+	d_ii = _mm_cvtsd_f64( _mm512_castpd512_pd128( _mm512_permutexvar_pd( _mm512_set1_epi64( 2 ), c_2 ) ) );
+	if(d_ii>1e-15)
+		d_ii = 1.0/sqrt(d_ii);
+	else
+		d_ii = 0.0;
+	inv_diag_D[2] = d_ii;
+	c_2 = _mm512_mul_pd( c_2, _mm512_set1_pd( d_ii ) );
+	c_3 = _mm512_fnmadd_pd( c_2, _mm512_permutexvar_pd( _mm512_set1_epi64( 3 ), c_2 ), c_3 );
+	c_4 = _mm512_fnmadd_pd( c_2, _mm512_permutexvar_pd( _mm512_set1_epi64( 4 ), c_2 ), c_4 );
+	c_5 = _mm512_fnmadd_pd( c_2, _mm512_permutexvar_pd( _mm512_set1_epi64( 5 ), c_2 ), c_5 );
+	c_6 = _mm512_fnmadd_pd( c_2, _mm512_permutexvar_pd( _mm512_set1_epi64( 6 ), c_2 ), c_6 );
+	c_7 = _mm512_fnmadd_pd( c_2, _mm512_permutexvar_pd( _mm512_set1_epi64( 7 ), c_2 ), c_7 );
+
+	d_ii = _mm_cvtsd_f64( _mm512_castpd512_pd128( _mm512_permutexvar_pd( _mm512_set1_epi64( 3 ), c_3 ) ) );
+	if(d_ii>1e-15)
+		d_ii = 1.0/sqrt(d_ii);
+	else
+		d_ii = 0.0;
+	inv_diag_D[3] = d_ii;
+	c_3 = _mm512_mul_pd( c_3, _mm512_set1_pd( d_ii ) );
+	c_4 = _mm512_fnmadd_pd( c_3, _mm512_permutexvar_pd( _mm512_set1_epi64( 4 ), c_3 ), c_4 );
+	c_5 = _mm512_fnmadd_pd( c_3, _mm512_permutexvar_pd( _mm512_set1_epi64( 5 ), c_3 ), c_5 );
+	c_6 = _mm512_fnmadd_pd( c_3, _mm512_permutexvar_pd( _mm512_set1_epi64( 6 ), c_3 ), c_6 );
+	c_7 = _mm512_fnmadd_pd( c_3, _mm512_permutexvar_pd( _mm512_set1_epi64( 7 ), c_3 ), c_7 );
+
+	d_ii = _mm_cvtsd_f64( _mm512_castpd512_pd128( _mm512_permutexvar_pd( _mm512_set1_epi64( 4 ), c_4 ) ) );
+	if(d_ii>1e-15)
+		d_ii = 1.0/sqrt(d_ii);
+	else
+		d_ii = 0.0;
+	inv_diag_D[4] = d_ii;
+	c_4 = _mm512_mul_pd( c_4, _mm512_set1_pd( d_ii ) );
+	c_5 = _mm512_fnmadd_pd( c_4, _mm512_permutexvar_pd( _mm512_set1_epi64( 5 ), c_4 ), c_5 );
+	c_6 = _mm512_fnmadd_pd( c_4, _mm512_permutexvar_pd( _mm512_set1_epi64( 6 ), c_4 ), c_6 );
+	c_7 = _mm512_fnmadd_pd( c_4, _mm512_permutexvar_pd( _mm512_set1_epi64( 7 ), c_4 ), c_7 );
+
+	d_ii = _mm_cvtsd_f64( _mm512_castpd512_pd128( _mm512_permutexvar_pd( _mm512_set1_epi64( 5 ), c_5 ) ) );
+	if(d_ii>1e-15)
+		d_ii = 1.0/sqrt(d_ii);
+	else
+		d_ii = 0.0;
+	inv_diag_D[5] = d_ii;
+	c_5 = _mm512_mul_pd( c_5, _mm512_set1_pd( d_ii ) );
+	c_6 = _mm512_fnmadd_pd( c_5, _mm512_permutexvar_pd( _mm512_set1_epi64( 6 ), c_5 ), c_6 );
+	c_7 = _mm512_fnmadd_pd( c_5, _mm512_permutexvar_pd( _mm512_set1_epi64( 7 ), c_5 ), c_7 );
+
+	d_ii = _mm_cvtsd_f64( _mm512_castpd512_pd128( _mm512_permutexvar_pd( _mm512_set1_epi64( 6 ), c_6 ) ) );
+	if(d_ii>1e-15)
+		d_ii = 1.0/sqrt(d_ii);
+	else
+		d_ii = 0.0;
+	inv_diag_D[6] = d_ii;
+	c_6 = _mm512_mul_pd( c_6, _mm512_set1_pd( d_ii ) );
+	c_7 = _mm512_fnmadd_pd( c_6, _mm512_permutexvar_pd( _mm512_set1_epi64( 7 ), c_6 ), c_7 );
+
+	d_ii = _mm_cvtsd_f64( _mm512_castpd512_pd128( _mm512_permutexvar_pd( _mm512_set1_epi64( 7 ), c_7 ) ) );
+	if(d_ii>1e-15)
+		d_ii = 1.0/sqrt(d_ii);
+	else
+		d_ii = 0.0;
+	inv_diag_D[7] = d_ii;
+	c_7 = _mm512_mul_pd( c_7, _mm512_set1_pd( d_ii ) );
+
+	// store lower triangle
+	_mm256_mask_store_pd( &D0[bs*0], 0xf, _mm512_castpd512_pd256( c_0 ) );
+	_mm256_mask_store_pd( &D1[bs*0], 0xf, _mm512_extractf64x4_pd( c_0, 0x1 ) );
+	_mm256_mask_store_pd( &D0[bs*1], 0xe, _mm512_castpd512_pd256( c_1 ) );
+	_mm256_mask_store_pd( &D1[bs*1], 0xf, _mm512_extractf64x4_pd( c_1, 0x1 ) );
+	_mm256_mask_store_pd( &D0[bs*2], 0xc, _mm512_castpd512_pd256( c_2 ) );
+	_mm256_mask_store_pd( &D1[bs*2], 0xf, _mm512_extractf64x4_pd( c_2, 0x1 ) );
+	_mm256_mask_store_pd( &D0[bs*3], 0x8, _mm512_castpd512_pd256( c_3 ) );
+	_mm256_mask_store_pd( &D1[bs*3], 0xf, _mm512_extractf64x4_pd( c_3, 0x1 ) );
+	_mm256_mask_store_pd( &D1[bs*4], 0xf, _mm512_extractf64x4_pd( c_4, 0x1 ) );
+	_mm256_mask_store_pd( &D1[bs*5], 0xe, _mm512_extractf64x4_pd( c_5, 0x1 ) );
+	_mm256_mask_store_pd( &D1[bs*6], 0xc, _mm512_extractf64x4_pd( c_6, 0x1 ) );
+	_mm256_mask_store_pd( &D1[bs*7], 0x8, _mm512_extractf64x4_pd( c_7, 0x1 ) );
+
+	}
+
+#endif
+
@@ -0,0 +1,201 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <mmintrin.h>
+#include <xmmintrin.h>  // SSE
+#include <emmintrin.h>  // SSE2
+#include <pmmintrin.h>  // SSE3
+#include <smmintrin.h>  // SSE4
+#include <immintrin.h>  // AVX AVX2 AVX-512
+
+
+#if ! defined(BLASFEO)
+
+// D = A * B' on a 8x8 block, with B upper triangular in its first 8 columns (kadd>=8);
+// the triangle is unrolled, so the zeros below the diagonal of B are never read
+void kernel_dtrmm_nt_u_8x8_lib4(int kadd, double *A0, int sda, double *B0, int sdb, double *D0, int sdd)
+	{
+
+	const int bs = 4;
+
+	double
+		*A1 = A0 + bs*sda,
+		*B1 = B0 + bs*sdb,
+		*D1 = D0 + bs*sdd;
+
+	int k;
+
+	__m512d
+		a_0, b_0,
+		c_0, c_1, c_2, c_3, c_4, c_5, c_6, c_7;
+
+	// k = 0
+	a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A0[0] ) ), _mm256_load_pd( &A1[0] ), 0x1 );
+	b_0 = _mm512_set1_pd( B0[0] );
+	c_0 = _mm512_mul_pd( a_0, b_0 );
+
+	// k = 1
+	a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A0[4] ) ), _mm256_load_pd( &A1[4] ), 0x1 );
+	b_0 = _mm512_set1_pd( B0[4] );
+	c_0 = _mm512_fmadd_pd( a_0, b_0, c_0 );
+	b_0 = _mm512_set1_pd( B0[5] );
+	c_1 = _mm512_mul_pd( a_0, b_0 );
+
+	// k = 2
+	a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A0[8] ) ), _mm256_load_pd( &A1[8] ), 0x1 );
+	b_0 = _mm512_set1_pd( B0[8] );
+	c_0 = _mm512_fmadd_pd( a_0, b_0, c_0 );
+	b_0 = _mm512_set1_pd( B0[9] );
+	c_1 = _mm512_fmadd_pd( a_0, b_0, c_1 );
+	b_0 = _mm512_set1_pd( B0[10] );
+	c_2 = _mm512_mul_pd( a_0, b_0 );
+
+	// k = 3
+	a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A0[12] ) ), _mm256_load_pd( &A1[12] ), 0x1 );
+	b_0 = _mm512_set1_pd( B0[12] );
+	c_0 = _mm512_fmadd_pd( a_0, b_0, c_0 );
+	b_0 = _mm512_set1_pd( B0[13] );
+	c_1 = _mm512_fmadd_pd( a_0, b_0, c_1 );
+	b_0 = _mm512_set1_pd( B0[14] );
+	c_2 = _mm512_fmadd_pd( a_0, b_0, c_2 );
+	b_0 = _mm512_set1_pd( B0[15] );
+	c_3 = _mm512_mul_pd( a_0, b_0 );
+
+	// k = 4
+	a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A0[16] ) ), _mm256_load_pd( &A1[16] ), 0x1 );
+	b_0 = _mm512_set1_pd( B0[16] );
+	c_0 = _mm512_fmadd_pd( a_0, b_0, c_0 );
+	b_0 = _mm512_set1_pd( B0[17] );
+	c_1 = _mm512_fmadd_pd( a_0, b_0, c_1 );
+	b_0 = _mm512_set1_pd( B0[18] );
+	c_2 = _mm512_fmadd_pd( a_0, b_0, c_2 );
+	b_0 = _mm512_set1_pd( B0[19] );
+	c_3 = _mm512_fmadd_pd( a_0, b_0, c_3 );
+	b_0 = _mm512_set1_pd( B1[16] );
+	c_4 = _mm512_mul_pd( a_0, b_0 );
+
+	// k = 5
+	a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A0[20] ) ), _mm256_load_pd( &A1[20] ), 0x1 );
+	b_0 = _mm512_set1_pd( B0[20] );
+	c_0 = _mm512_fmadd_pd( a_0, b_0, c_0 );
+	b_0 = _mm512_set1_pd( B0[21] );
+	c_1 = _mm512_fmadd_pd( a_0, b_0, c_1 );
+	b_0 = _mm512_set1_pd( B0[22] );
+	c_2 = _mm512_fmadd_pd( a_0, b_0, c_2 );
+	b_0 = _mm512_set1_pd( B0[23] );
+	c_3 = _mm512_fmadd_pd( a_0, b_0, c_3 );
+	b_0 = _mm512_set1_pd( B1[20] );
+	c_4 = _mm512_fmadd_pd( a_0, b_0, c_4 );
+	b_0 = _mm512_set1_pd( B1[21] );
+	c_5 = _mm512_mul_pd( a_0, b_0 );
+
+	// k = 6
+	a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A0[24] ) ), _mm256_load_pd( &A1[24] ), 0x1 );
+	b_0 = _mm512_set1_pd( B0[24] );
+	c_0 = _mm512_fmadd_pd( a_0, b_0, c_0 );
+	b_0 = _mm512_set1_pd( B0[25] );
+	c_1 = _mm512_fmadd_pd( a_0, b_0, c_1 );
+	b_0 = _mm512_set1_pd( B0[26] );
+	c_2 = _mm512_fmadd_pd( a_0, b_0, c_2 );
+	b_0 = _mm512_set1_pd( B0[27] );
+	c_3 = _mm512_fmadd_pd( a_0, b_0, c_3 );
+	b_0 = _mm512_set1_pd( B1[24] );
+	c_4 = _mm512_fmadd_pd( a_0, b_0, c_4 );
+	b_0 = _mm512_set1_pd( B1[25] );
+	c_5 = _mm512_fmadd_pd( a_0, b_0, c_5 );
+	b_0 = _mm512_set1_pd( B1[26] );
+	c_6 = _mm512_mul_pd( a_0, b_0 );
+
+	// k = 7
+	a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A0[28] ) ), _mm256_load_pd( &A1[28] ), 0x1 );
+	b_0 = _mm512_set1_pd( B0[28] );
+	c_0 = _mm512_fmadd_pd( a_0, b_0, c_0 );
+	b_0 = _mm512_set1_pd( B0[29] );
+	c_1 = _mm512_fmadd_pd( a_0, b_0, c_1 );
+	b_0 = _mm512_set1_pd( B0[30] );
+	c_2 = _mm512_fmadd_pd( a_0, b_0, c_2 );
+	b_0 = _mm512_set1_pd( B0[31] );
+	c_3 = _mm512_fmadd_pd( a_0, b_0, c_3 );
+	b_0 = _mm512_set1_pd( B1[28] );
+	c_4 = _mm512_fmadd_pd( a_0, b_0, c_4 );
+	b_0 = _mm512_set1_pd( B1[29] );
+	c_5 = _mm512_fmadd_pd( a_0, b_0, c_5 );
+	b_0 = _mm512_set1_pd( B1[30] );
+	c_6 = _mm512_fmadd_pd( a_0, b_0, c_6 );
+	b_0 = _mm512_set1_pd( B1[31] );
+	c_7 = _mm512_mul_pd( a_0, b_0 );
+
+	A0 += 32;
+	A1 += 32;
+	B0 += 32;
+	B1 += 32;
+
+	for(k=8; k<kadd; k++)
+		{
+		a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &A0[0] ) ), _mm256_load_pd( &A1[0] ), 0x1 );
+		b_0 = _mm512_set1_pd( B0[0] );
+		c_0 = _mm512_fmadd_pd( a_0, b_0, c_0 );
+		b_0 = _mm512_set1_pd( B0[1] );
+		c_1 = _mm512_fmadd_pd( a_0, b_0, c_1 );
+		b_0 = _mm512_set1_pd( B0[2] );
+		c_2 = _mm512_fmadd_pd( a_0, b_0, c_2 );
+		b_0 = _mm512_set1_pd( B0[3] );
+		c_3 = _mm512_fmadd_pd( a_0, b_0, c_3 );
+		b_0 = _mm512_set1_pd( B1[0] );
+		c_4 = _mm512_fmadd_pd( a_0, b_0, c_4 );
+		b_0 = _mm512_set1_pd( B1[1] );
+		c_5 = _mm512_fmadd_pd( a_0, b_0, c_5 );
+		b_0 = _mm512_set1_pd( B1[2] );
+		c_6 = _mm512_fmadd_pd( a_0, b_0, c_6 );
+		b_0 = _mm512_set1_pd( B1[3] );
+		c_7 = _mm512_fmadd_pd( a_0, b_0, c_7 );
+
+		A0 += 4;
+		A1 += 4;
+		B0 += 4;
+		B1 += 4;
+		}
+
+	_mm256_store_pd( &D0[bs*0], _mm512_castpd512_pd256( c_0 ) );
+	_mm256_store_pd( &D1[bs*0], _mm512_extractf64x4_pd( c_0, 0x1 ) );
+	_mm256_store_pd( &D0[bs*1], _mm512_castpd512_pd256( c_1 ) );
+	_mm256_store_pd( &D1[bs*1], _mm512_extractf64x4_pd( c_1, 0x1 ) );
+	_mm256_store_pd( &D0[bs*2], _mm512_castpd512_pd256( c_2 ) );
+	_mm256_store_pd( &D1[bs*2], _mm512_extractf64x4_pd( c_2, 0x1 ) );
+	_mm256_store_pd( &D0[bs*3], _mm512_castpd512_pd256( c_3 ) );
+	_mm256_store_pd( &D1[bs*3], _mm512_extractf64x4_pd( c_3, 0x1 ) );
+	_mm256_store_pd( &D0[bs*4], _mm512_castpd512_pd256( c_4 ) );
+	_mm256_store_pd( &D1[bs*4], _mm512_extractf64x4_pd( c_4, 0x1 ) );
+	_mm256_store_pd( &D0[bs*5], _mm512_castpd512_pd256( c_5 ) );
+	_mm256_store_pd( &D1[bs*5], _mm512_extractf64x4_pd( c_5, 0x1 ) );
+	_mm256_store_pd( &D0[bs*6], _mm512_castpd512_pd256( c_6 ) );
+	_mm256_store_pd( &D1[bs*6], _mm512_extractf64x4_pd( c_6, 0x1 ) );
+	_mm256_store_pd( &D0[bs*7], _mm512_castpd512_pd256( c_7 ) );
+	_mm256_store_pd( &D1[bs*7], _mm512_extractf64x4_pd( c_7, 0x1 ) );
+
+	}
+
+#endif
+
@@ -0,0 +1,594 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <mmintrin.h>
+#include <xmmintrin.h>  // SSE
+#include <emmintrin.h>  // SSE2
+#include <pmmintrin.h>  // SSE3
+#include <smmintrin.h>  // SSE4
+#include <immintrin.h>  // AVX AVX2 AVX-512
+
+
+#if ! defined(BLASFEO)
+
+// D = ( C + Ap * Bp' - Am * Bm' ) * E^{-T} on a 8x8 block, with E lower triangular (8x8, two panels);
+// each column of the block is in a zmm register, and the solve eliminates one column at a time
+void kernel_dgemm_dtrsm_nt_8x8_lib4_new(int kadd, double *Ap0, int sdap, double *Bp0, int sdbp, int ksub, double *Am0, int sdam, double *Bm0, int sdbm, int alg, double *C0, int sdc, double *D0, int sdd, double *E0, int sde, int use_inv_diag_E, double *inv_diag_E)
+	{
+
+	const int bs = 4;
+
+	double
+		*Ap1 = Ap0 + bs*sdap,
+		*Bp1 = Bp0 + bs*sdbp,
+		*Am1 = Am0 + bs*sdam,
+		*Bm1 = Bm0 + bs*sdbm,
+		*C1  = C0  + bs*sdc,
+		*D1  = D0  + bs*sdd,
+		*E1  = E0  + bs*sde;
+
+	int k;
+
+	__m512d
+		a_0, b_0, d_0,
+		c_0, c_1, c_2, c_3, c_4, c_5, c_6, c_7;
+
+	c_0 = _mm512_setzero_pd();
+	c_1 = _mm512_setzero_pd();
+	c_2 = _mm512_setzero_pd();
+	c_3 = _mm512_setzero_pd();
+	c_4 = _mm512_setzero_pd();
+	c_5 = _mm512_setzero_pd();
+	c_6 = _mm512_setzero_pd();
+	c_7 = _mm512_setzero_pd();
+
+	if(kadd>0)
+		{
+
+		for(k=0; k<kadd; k++)
+			{
+			a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &Ap0[0] ) ), _mm256_load_pd( &Ap1[0] ), 0x1 );
+			b_0 = _mm512_set1_pd( Bp0[0] );
+			c_0 = _mm512_fmadd_pd( a_0, b_0, c_0 );
+			b_0 = _mm512_set1_pd( Bp0[1] );
+			c_1 = _mm512_fmadd_pd( a_0, b_0, c_1 );
+			b_0 = _mm512_set1_pd( Bp0[2] );
+			c_2 = _mm512_fmadd_pd( a_0, b_0, c_2 );
+			b_0 = _mm512_set1_pd( Bp0[3] );
+			c_3 = _mm512_fmadd_pd( a_0, b_0, c_3 );
+			b_0 = _mm512_set1_pd( Bp1[0] );
+			c_4 = _mm512_fmadd_pd( a_0, b_0, c_4 );
+			b_0 = _mm512_set1_pd( Bp1[1] );
+			c_5 = _mm512_fmadd_pd( a_0, b_0, c_5 );
+			b_0 = _mm512_set1_pd( Bp1[2] );
+			c_6 = _mm512_fmadd_pd( a_0, b_0, c_6 );
+			b_0 = _mm512_set1_pd( Bp1[3] );
+			c_7 = _mm512_fmadd_pd( a_0, b_0, c_7 );
+
+			Ap0 += 4;
+			Ap1 += 4;
+			Bp0 += 4;
+			Bp1 += 4;
+			}
+
+		if(alg==-1)
+			{
+			c_0 = _mm512_sub_pd( _mm512_setzero_pd(), c_0 );
+			c_1 = _mm512_sub_pd( _mm512_setzero_pd(), c_1 );
+			c_2 = _mm512_sub_pd( _mm512_setzero_pd(), c_2 );
+			c_3 = _mm512_sub_pd( _mm512_setzero_pd(), c_3 );
+			c_4 = _mm512_sub_pd( _mm512_setzero_pd(), c_4 );
+			c_5 = _mm512_sub_pd( _mm512_setzero_pd(), c_5 );
+			c_6 = _mm512_sub_pd( _mm512_setzero_pd(), c_6 );
+			c_7 = _mm512_sub_pd( _mm512_setzero_pd(), c_7 );
+			}
+
+		}
+
+	if(ksub>0)
+		{
+
+		for(k=0; k<ksub; k++)
+			{
+			a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &Am0[0] ) ), _mm256_load_pd( &Am1[0] ), 0x1 );
+			b_0 = _mm512_set1_pd( Bm0[0] );
+			c_0 = _mm512_fnmadd_pd( a_0, b_0, c_0 );
+			b_0 = _mm512_set1_pd( Bm0[1] );
+			c_1 = _mm512_fnmadd_pd( a_0, b_0, c_1 );
+			b_0 = _mm512_set1_pd( Bm0[2] );
+			c_2 = _mm512_fnmadd_pd( a_0, b_0, c_2 );
+			b_0 = _mm512_set1_pd( Bm0[3] );
+			c_3 = _mm512_fnmadd_pd( a_0, b_0, c_3 );
+			b_0 = _mm512_set1_pd( Bm1[0] );
+			c_4 = _mm512_fnmadd_pd( a_0, b_0, c_4 );
+			b_0 = _mm512_set1_pd( Bm1[1] );
+			c_5 = _mm512_fnmadd_pd( a_0, b_0, c_5 );
+			b_0 = _mm512_set1_pd( Bm1[2] );
+			c_6 = _mm512_fnmadd_pd( a_0, b_0, c_6 );
+			b_0 = _mm512_set1_pd( Bm1[3] );
+			c_7 = _mm512_fnmadd_pd( a_0, b_0, c_7 );
+
+			Am0 += 4;
+			Am1 += 4;
+			Bm0 += 4;
+			Bm1 += 4;
+			}
+
+		}
+
+	if(alg!=0)
+		{
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*0] ) ), _mm256_load_pd( &C1[bs*0] ), 0x1 );
+		c_0 = _mm512_add_pd( c_0, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*1] ) ), _mm256_load_pd( &C1[bs*1] ), 0x1 );
+		c_1 = _mm512_add_pd( c_1, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*2] ) ), _mm256_load_pd( &C1[bs*2] ), 0x1 );
+		c_2 = _mm512_add_pd( c_2, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*3] ) ), _mm256_load_pd( &C1[bs*3] ), 0x1 );
+		c_3 = _mm512_add_pd( c_3, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*4] ) ), _mm256_load_pd( &C1[bs*4] ), 0x1 );
+		c_4 = _mm512_add_pd( c_4, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*5] ) ), _mm256_load_pd( &C1[bs*5] ), 0x1 );
+		c_5 = _mm512_add_pd( c_5, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*6] ) ), _mm256_load_pd( &C1[bs*6] ), 0x1 );
+		c_6 = _mm512_add_pd( c_6, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &C0[bs*7] ) ), _mm256_load_pd( &C1[bs*7] ), 0x1 );
+		c_7 = _mm512_add_pd( c_7, d_0 );
+		}
+
+	// solve
+
+	if(use_inv_diag_E)
+		b_0 = _mm512_set1_pd( inv_diag_E[0] );
+	else
+		b_0 = _mm512_set1_pd( 1.0/E0[0+bs*0] );
+	c_0 = _mm512_mul_pd( c_0, b_0 );
+	b_0 = _mm512_set1_pd( E0[1+bs*0] );
+	c_1 = _mm512_fnmadd_pd( c_0, b_0, c_1 );
+	b_0 = _mm512_set1_pd( E0[2+bs*0] );
+	c_2 = _mm512_fnmadd_pd( c_0, b_0, c_2 );
+	b_0 = _mm512_set1_pd( E0[3+bs*0] );
+	c_3 = _mm512_fnmadd_pd( c_0, b_0, c_3 );
+	b_0 = _mm512_set1_pd( E1[0+bs*0] );
+	c_4 = _mm512_fnmadd_pd( c_0, b_0, c_4 );
+	b_0 = _mm512_set1_pd( E1[1+bs*0] );
+	c_5 = _mm512_fnmadd_pd( c_0, b_0, c_5 );
+	b_0 = _mm512_set1_pd( E1[2+bs*0] );
+	c_6 = _mm512_fnmadd_pd( c_0, b_0, c_6 );
+	b_0 = _mm512_set1_pd( E1[3+bs*0] );
+	c_7 = _mm512_fnmadd_pd( c_0, b_0, c_7 );
+
+	if(use_inv_diag_E)
+		b_0 = _mm512_set1_pd( inv_diag_E[1] );
+	else
+		b_0 = _mm512_set1_pd( 1.0/E0[1+bs*1] );
+	c_1 = _mm512_mul_pd( c_1, b_0 );
+	b_0 = _mm512_set1_pd( E0[2+bs*1] );
+	c_2 = _mm512_fnmadd_pd( c_1, b_0, c_2 );
+	b_0 = _mm512_set1_pd( E0[3+bs*1] );
+	c_3 = _mm512_fnmadd_pd( c_1, b_0, c_3 );
+	b_0 = _mm512_set1_pd( E1[0+bs*1] );
+	c_4 = _mm512_fnmadd_pd( c_1, b_0, c_4 );
+	b_0 = _mm512_set1_pd( E1[1+bs*1] );
+	c_5 = _mm512_fnmadd_pd( c_1, b_0, c_5 );
+	b_0 = _mm512_set1_pd( E1[2+bs*1] );
+	c_6 = _mm512_fnmadd_pd( c_1, b_0, c_6 );
+	b_0 = _mm512_set1_pd( E1[3+bs*1] );
+	c_7 = _mm512_fnmadd_pd( c_1, b_0, c_7 );
+
+	if(use_inv_diag_E)
+		b_0 = _mm512_set1_pd( inv_diag_E[2] );
+	else
+		b_0 = _mm512_set1_pd( 1.0/E0[2+bs*2] );
+	c_2 = _mm512_mul_pd( c_2, b_0 );
+	b_0 = _mm512_set1_pd( E0[3+bs*2] );
+	c_3 = _mm512_fnmadd_pd( c_2, b_0, c_3 );
+	b_0 = _mm512_set1_pd( E1[0+bs*2] );
+	c_4 = _mm512_fnmadd_pd( c_2, b_0, c_4 );
+	b_0 = _mm512_set1_pd( E1[1+bs*2] );
+	c_5 = _mm512_fnmadd_pd( c_2, b_0, c_5 );
+	b_0 = _mm512_set1_pd( E1[2+bs*2] );
+	c_6 = _mm512_fnmadd_pd( c_2, b_0, c_6 );
+	b_0 = _mm512_set1_pd( E1[3+bs*2] );
+	c_7 = _mm512_fnmadd_pd( c_2, b_0, c_7 );
+
+	if(use_inv_diag_E)
+		b_0 = _mm512_set1_pd( inv_diag_E[3] );
+	else
+		b_0 = _mm512_set1_pd( 1.0/E0[3+bs*3] );
+	c_3 = _mm512_mul_pd( c_3, b_0 );
+	b_0 = _mm512_set1_pd( E1[0+bs*3] );
+	c_4 = _mm512_fnmadd_pd( c_3, b_0, c_4 );
+	b_0 = _mm512_set1_pd( E1[1+bs*3] );
+	c_5 = _mm512_fnmadd_pd( c_3, b_0, c_5 );
+	b_0 = _mm512_set1_pd( E1[2+bs*3] );
+	c_6 = _mm512_fnmadd_pd( c_3, b_0, c_6 );
+	b_0 = _mm512_set1_pd( E1[3+bs*3] );
+	c_7 = _mm512_fnmadd_pd( c_3, b_0, c_7 );
+
+	if(use_inv_diag_E)
+		b_0 = _mm512_set1_pd( inv_diag_E[4] );
+	else
+		b_0 = _mm512_set1_pd( 1.0/E1[0+bs*4] );
+	c_4 = _mm512_mul_pd( c_4, b_0 );
+	b_0 = _mm512_set1_pd( E1[1+bs*4] );
+	c_5 = _mm512_fnmadd_pd( c_4, b_0, c_5 );
+	b_0 = _mm512_set1_pd( E1[2+bs*4] );
+	c_6 = _mm512_fnmadd_pd( c_4, b_0, c_6 );
+	b_0 = _mm512_set1_pd( E1[3+bs*4] );
+	c_7 = _mm512_fnmadd_pd( c_4, b_0, c_7 );
+
+	if(use_inv_diag_E)
+		b_0 = _mm512_set1_pd( inv_diag_E[5] );
+	else
+		b_0 = _mm512_set1_pd( 1.0/E1[1+bs*5] );
+	c_5 = _mm512_mul_pd( c_5, b_0 );
+	b_0 = _mm512_set1_pd( E1[2+bs*5] );
+	c_6 = _mm512_fnmadd_pd( c_5, b_0, c_6 );
+	b_0 = _mm512_set1_pd( E1[3+bs*5] );
+	c_7 = _mm512_fnmadd_pd( c_5, b_0, c_7 );
+
+	if(use_inv_diag_E)
+		b_0 = _mm512_set1_pd( inv_diag_E[6] );
+	else
+		b_0 = _mm512_set1_pd( 1.0/E1[2+bs*6] );
+	c_6 = _mm512_mul_pd( c_6, b_0 );
+	b_0 = _mm512_set1_pd( E1[3+bs*6] );
+	c_7 = _mm512_fnmadd_pd( c_6, b_0, c_7 );
+
+	if(use_inv_diag_E)
+		b_0 = _mm512_set1_pd( inv_diag_E[7] );
+	else
+		b_0 = _mm512_set1_pd( 1.0/E1[3+bs*7] );
+	c_7 = _mm512_mul_pd( c_7, b_0 );
+
+	// store
+	_mm256_store_pd( &D0[bs*0], _mm512_castpd512_pd256( c_0 ) );
+	_mm256_store_pd( &D1[bs*0], _mm512_extractf64x4_pd( c_0, 0x1 ) );
+	_mm256_store_pd( &D0[bs*1], _mm512_castpd512_pd256( c_1 ) );
+	_mm256_store_pd( &D1[bs*1], _mm512_extractf64x4_pd( c_1, 0x1 ) );
+	_mm256_store_pd( &D0[bs*2], _mm512_castpd512_pd256( c_2 ) );
+	_mm256_store_pd( &D1[bs*2], _mm512_extractf64x4_pd( c_2, 0x1 ) );
+	_mm256_store_pd( &D0[bs*3], _mm512_castpd512_pd256( c_3 ) );
+	_mm256_store_pd( &D1[bs*3], _mm512_extractf64x4_pd( c_3, 0x1 ) );
+	_mm256_store_pd( &D0[bs*4], _mm512_castpd512_pd256( c_4 ) );
+	_mm256_store_pd( &D1[bs*4], _mm512_extractf64x4_pd( c_4, 0x1 ) );
+	_mm256_store_pd( &D0[bs*5], _mm512_castpd512_pd256( c_5 ) );
+	_mm256_store_pd( &D1[bs*5], _mm512_extractf64x4_pd( c_5, 0x1 ) );
+	_mm256_store_pd( &D0[bs*6], _mm512_castpd512_pd256( c_6 ) );
+	_mm256_store_pd( &D1[bs*6], _mm512_extractf64x4_pd( c_6, 0x1 ) );
+	_mm256_store_pd( &D0[bs*7], _mm512_castpd512_pd256( c_7 ) );
+	_mm256_store_pd( &D1[bs*7], _mm512_extractf64x4_pd( c_7, 0x1 ) );
+
+	}
+
+
+
+// as above, with the rows km and the columns kn masked on store
+void kernel_dgemm_dtrsm_nt_8x8_vs_lib4_new(int km, int kn, int kadd, double *Ap0, int sdap, double *Bp0, int sdbp, int ksub, double *Am0, int sdam, double *Bm0, int sdbm, int alg, double *C0, int sdc, double *D0, int sdd, double *E0, int sde, int use_inv_diag_E, double *inv_diag_E)
+	{
+
+	const int bs = 4;
+
+	double
+		*Ap1 = Ap0 + bs*sdap,
+		*Bp1 = Bp0 + bs*sdbp,
+		*Am1 = Am0 + bs*sdam,
+		*Bm1 = Bm0 + bs*sdbm,
+		*C1  = C0  + bs*sdc,
+		*D1  = D0  + bs*sdd,
+		*E1  = E0  + bs*sde;
+
+	// do not read past the last panel
+	if(km<=4)
+		{
+		Ap1 = Ap0;
+		Am1 = Am0;
+		}
+	if(kn<=4)
+		{
+		Bp1 = Bp0;
+		Bm1 = Bm0;
+		E1  = E0;
+		}
+
+	int k;
+
+	__mmask8
+		mask_0, mask_1;
+
+	__m512d
+		a_0, b_0, d_0,
+		c_0, c_1, c_2, c_3, c_4, c_5, c_6, c_7;
+
+	mask_0 = km>=4 ? 0xf : (1<<km)-1;
+	mask_1 = km>=8 ? 0xf : ( km>4 ? (1<<(km-4))-1 : 0x0 );
+
+	c_0 = _mm512_setzero_pd();
+	c_1 = _mm512_setzero_pd();
+	c_2 = _mm512_setzero_pd();
+	c_3 = _mm512_setzero_pd();
+	c_4 = _mm512_setzero_pd();
+	c_5 = _mm512_setzero_pd();
+	c_6 = _mm512_setzero_pd();
+	c_7 = _mm512_setzero_pd();
+
+	if(kadd>0)
+		{
+
+		for(k=0; k<kadd; k++)
+			{
+			a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &Ap0[0] ) ), _mm256_load_pd( &Ap1[0] ), 0x1 );
+			b_0 = _mm512_set1_pd( Bp0[0] );
+			c_0 = _mm512_fmadd_pd( a_0, b_0, c_0 );
+			b_0 = _mm512_set1_pd( Bp0[1] );
+			c_1 = _mm512_fmadd_pd( a_0, b_0, c_1 );
+			b_0 = _mm512_set1_pd( Bp0[2] );
+			c_2 = _mm512_fmadd_pd( a_0, b_0, c_2 );
+			b_0 = _mm512_set1_pd( Bp0[3] );
+			c_3 = _mm512_fmadd_pd( a_0, b_0, c_3 );
+			b_0 = _mm512_set1_pd( Bp1[0] );
+			c_4 = _mm512_fmadd_pd( a_0, b_0, c_4 );
+			b_0 = _mm512_set1_pd( Bp1[1] );
+			c_5 = _mm512_fmadd_pd( a_0, b_0, c_5 );
+			b_0 = _mm512_set1_pd( Bp1[2] );
+			c_6 = _mm512_fmadd_pd( a_0, b_0, c_6 );
+			b_0 = _mm512_set1_pd( Bp1[3] );
+			c_7 = _mm512_fmadd_pd( a_0, b_0, c_7 );
+
+			Ap0 += 4;
+			Ap1 += 4;
+			Bp0 += 4;
+			Bp1 += 4;
+			}
+
+		if(alg==-1)
+			{
+			c_0 = _mm512_sub_pd( _mm512_setzero_pd(), c_0 );
+			c_1 = _mm512_sub_pd( _mm512_setzero_pd(), c_1 );
+			c_2 = _mm512_sub_pd( _mm512_setzero_pd(), c_2 );
+			c_3 = _mm512_sub_pd( _mm512_setzero_pd(), c_3 );
+			c_4 = _mm512_sub_pd( _mm512_setzero_pd(), c_4 );
+			c_5 = _mm512_sub_pd( _mm512_setzero_pd(), c_5 );
+			c_6 = _mm512_sub_pd( _mm512_setzero_pd(), c_6 );
+			c_7 = _mm512_sub_pd( _mm512_setzero_pd(), c_7 );
+			}
+
+		}
+
+	if(ksub>0)
+		{
+
+		for(k=0; k<ksub; k++)
+			{
+			a_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_load_pd( &Am0[0] ) ), _mm256_load_pd( &Am1[0] ), 0x1 );
+			b_0 = _mm512_set1_pd( Bm0[0] );
+			c_0 = _mm512_fnmadd_pd( a_0, b_0, c_0 );
+			b_0 = _mm512_set1_pd( Bm0[1] );
+			c_1 = _mm512_fnmadd_pd( a_0, b_0, c_1 );
+			b_0 = _mm512_set1_pd( Bm0[2] );
+			c_2 = _mm512_fnmadd_pd( a_0, b_0, c_2 );
+			b_0 = _mm512_set1_pd( Bm0[3] );
+			c_3 = _mm512_fnmadd_pd( a_0, b_0, c_3 );
+			b_0 = _mm512_set1_pd( Bm1[0] );
+			c_4 = _mm512_fnmadd_pd( a_0, b_0, c_4 );
+			b_0 = _mm512_set1_pd( Bm1[1] );
+			c_5 = _mm512_fnmadd_pd( a_0, b_0, c_5 );
+			b_0 = _mm512_set1_pd( Bm1[2] );
+			c_6 = _mm512_fnmadd_pd( a_0, b_0, c_6 );
+			b_0 = _mm512_set1_pd( Bm1[3] );
+			c_7 = _mm512_fnmadd_pd( a_0, b_0, c_7 );
+
+			Am0 += 4;
+			Am1 += 4;
+			Bm0 += 4;
+			Bm1 += 4;
+			}
+
+		}
+
+	if(alg!=0)
+		{
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*0] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*0] ), 0x1 );
+		c_0 = _mm512_add_pd( c_0, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*1] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*1] ), 0x1 );
+		c_1 = _mm512_add_pd( c_1, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*2] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*2] ), 0x1 );
+		c_2 = _mm512_add_pd( c_2, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*3] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*3] ), 0x1 );
+		c_3 = _mm512_add_pd( c_3, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*4] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*4] ), 0x1 );
+		c_4 = _mm512_add_pd( c_4, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*5] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*5] ), 0x1 );
+		c_5 = _mm512_add_pd( c_5, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*6] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*6] ), 0x1 );
+		c_6 = _mm512_add_pd( c_6, d_0 );
+		d_0 = _mm512_insertf64x4( _mm512_castpd256_pd512( _mm256_maskz_load_pd( mask_0, &C0[bs*7] ) ), _mm256_maskz_load_pd( mask_1, &C1[bs*7] ), 0x1 );
+		c_7 = _mm512_add_pd( c_7, d_0 );
+		}
+
+	// solve
+
+	if(use_inv_diag_E)
+		b_0 = _mm512_set1_pd( inv_diag_E[0] );
+	else
+		b_0 = _mm512_set1_pd( 1.0/E0[0+bs*0] );
+	c_0 = _mm512_mul_pd( c_0, b_0 );
+	b_0 = _mm512_set1_pd( E0[1+bs*0] );
+	c_1 = _mm512_fnmadd_pd( c_0, b_0, c_1 );
+	b_0 = _mm512_set1_pd( E0[2+bs*0] );
+	c_2 = _mm512_fnmadd_pd( c_0, b_0, c_2 );
+	b_0 = _mm512_set1_pd( E0[3+bs*0] );
+	c_3 = _mm512_fnmadd_pd( c_0, b_0, c_3 );
+	b_0 = _mm512_set1_pd( E1[0+bs*0] );
+	c_4 = _mm512_fnmadd_pd( c_0, b_0, c_4 );
+	b_0 = _mm512_set1_pd( E1[1+bs*0] );
+	c_5 = _mm512_fnmadd_pd( c_0, b_0, c_5 );
+	b_0 = _mm512_set1_pd( E1[2+bs*0] );
+	c_6 = _mm512_fnmadd_pd( c_0, b_0, c_6 );
+	b_0 = _mm512_set1_pd( E1[3+bs*0] );
+	c_7 = _mm512_fnmadd_pd( c_0, b_0, c_7 );
+
+	if(kn<=1)
+		goto store;
+
+	if(use_inv_diag_E)
+		b_0 = _mm512_set1_pd( inv_diag_E[1] );
+	else
+		b_0 = _mm512_set1_pd( 1.0/E0[1+bs*1] );
+	c_1 = _mm512_mul_pd( c_1, b_0 );
+	b_0 = _mm512_set1_pd( E0[2+bs*1] );
+	c_2 = _mm512_fnmadd_pd( c_1, b_0, c_2 );
+	b_0 = _mm512_set1_pd( E0[3+bs*1] );
+	c_3 = _mm512_fnmadd_pd( c_1, b_0, c_3 );
+	b_0 = _mm512_set1_pd( E1[0+bs*1] );
+	c_4 = _mm512_fnmadd_pd( c_1, b_0, c_4 );
+	b_0 = _mm512_set1_pd( E1[1+bs*1] );
+	c_5 = _mm512_fnmadd_pd( c_1, b_0, c_5 );
+	b_0 = _mm512_set1_pd( E1[2+bs*1] );
+	c_6 = _mm512_fnmadd_pd( c_1, b_0, c_6 );
+	b_0 = _mm512_set1_pd( E1[3+bs*1] );
+	c_7 = _mm512_fnmadd_pd( c_1, b_0, c_7 );
+
+	if(kn<=2)
+		goto store;
+
+	if(use_inv_diag_E)
+		b_0 = _mm512_set1_pd( inv_diag_E[2] );
+	else
+		b_0 = _mm512_set1_pd( 1.0/E0[2+bs*2] );
+	c_2 = _mm512_mul_pd( c_2, b_0 );
+	b_0 = _mm512_set1_pd( E0[3+bs*2] );
+	c_3 = _mm512_fnmadd_pd( c_2, b_0, c_3 );
+	b_0 = _mm512_set1_pd( E1[0+bs*2] );
+	c_4 = _mm512_fnmadd_pd( c_2, b_0, c_4 );
+	b_0 = _mm512_set1_pd( E1[1+bs*2] );
+	c_5 = _mm512_fnmadd_pd( c_2, b_0, c_5 );
+	b_0 = _mm512_set1_pd( E1[2+bs*2] );
+	c_6 = _mm512_fnmadd_pd( c_2, b_0, c_6 );
+	b_0 = _mm512_set1_pd( E1[3+bs*2] );
+	c_7 = _mm512_fnmadd_pd( c_2, b_0, c_7 );
+
+	if(kn<=3)
+		goto store;
+
+	if(use_inv_diag_E)
+		b_0 = _mm512_set1_pd( inv_diag_E[3] );
+	else
+		b_0 = _mm512_set1_pd( 1.0/E0[3+bs*3] );
+	c_3 = _mm512_mul_pd( c_3, b_0 );
+	b_0 = _mm512_set1_pd( E1[0+bs*3] );
+	c_4 = _mm512_fnmadd_pd( c_3, b_0, c_4 );
+	b_0 = _mm512_set1_pd( E1[1+bs*3] );
+	c_5 = _mm512_fnmadd_pd( c_3, b_0, c_5 );
+	b_0 = _mm512_set1_pd( E1[2+bs*3] );
+	c_6 = _mm512_fnmadd_pd( c_3, b_0, c_6 );
+	b_0 = _mm512_set1_pd( E1[3+bs*3] );
+	c_7 = _mm512_fnmadd_pd( c_3, b_0, c_7 );
+
+	if(kn<=4)
+		goto store;
+
+	if(use_inv_diag_E)
+		b_0 = _mm512_set1_pd( inv_diag_E[4] );
+	else
+		b_0 = _mm512_set1_pd( 1.0/E1[0+bs*4] );
+	c_4 = _mm512_mul_pd( c_4, b_0 );
+	b_0 = _mm512_set1_pd( E1[1+bs*4] );
+	c_5 = _mm512_fnmadd_pd( c_4, b_0, c_5 );
+	b_0 = _mm512_set1_pd( E1[2+bs*4] );
+	c_6 = _mm512_fnmadd_pd( c_4, b_0, c_6 );
+	b_0 = _mm512_set1_pd( E1[3+bs*4] );
+	c_7 = _mm512_fnmadd_pd( c_4, b_0, c_7 );
+
+	if(kn<=5)
+		goto store;
+
+	if(use_inv_diag_E)
+		b_0 = _mm512_set1_pd( inv_diag_E[5] );
+	else
+		b_0 = _mm512_set1_pd( 1.0/E1[1+bs*5] );
+	c_5 = _mm512_mul_pd( c_5, b_0 );
+	b_0 = _mm512_set1_pd( E1[2+bs*5] );
+	c_6 = _mm512_fnmadd_pd( c_5, b_0, c_6 );
+	b_0 = _mm512_set1_pd( E1[3+bs*5] );
+	c_7 = _mm512_fnmadd_pd( c_5, b_0, c_7 );
+
+	if(kn<=6)
+		goto store;
+
+	if(use_inv_diag_E)
+		b_0 = _mm512_set1_pd( inv_diag_E[6] );
+	else
+		b_0 = _mm512_set1_pd( 1.0/E1[2+bs*6] );
+	c_6 = _mm512_mul_pd( c_6, b_0 );
+	b_0 = _mm512_set1_pd( E1[3+bs*6] );
+	c_7 = _mm512_fnmadd_pd( c_6, b_0, c_7 );
+
+	if(kn<=7)
+		goto store;
+
+	if(use_inv_diag_E)
+		b_0 = _mm512_set1_pd( inv_diag_E[7] );
+	else
+		b_0 = _mm512_set1_pd( 1.0/E1[3+bs*7] );
+	c_7 = _mm512_mul_pd( c_7, b_0 );
+
+	store:
+	_mm256_mask_store_pd( &D0[bs*0], mask_0, _mm512_castpd512_pd256( c_0 ) );
+	_mm256_mask_store_pd( &D1[bs*0], mask_1, _mm512_extractf64x4_pd( c_0, 0x1 ) );
+	if(kn<=1)
+		return;
+	_mm256_mask_store_pd( &D0[bs*1], mask_0, _mm512_castpd512_pd256( c_1 ) );
+	_mm256_mask_store_pd( &D1[bs*1], mask_1, _mm512_extractf64x4_pd( c_1, 0x1 ) );
+	if(kn<=2)
+		return;
+	_mm256_mask_store_pd( &D0[bs*2], mask_0, _mm512_castpd512_pd256( c_2 ) );
+	_mm256_mask_store_pd( &D1[bs*2], mask_1, _mm512_extractf64x4_pd( c_2, 0x1 ) );
+	if(kn<=3)
+		return;
+	_mm256_mask_store_pd( &D0[bs*3], mask_0, _mm512_castpd512_pd256( c_3 ) );
+	_mm256_mask_store_pd( &D1[bs*3], mask_1, _mm512_extractf64x4_pd( c_3, 0x1 ) );
+	if(kn<=4)
+		return;
+	_mm256_mask_store_pd( &D0[bs*4], mask_0, _mm512_castpd512_pd256( c_4 ) );
+	_mm256_mask_store_pd( &D1[bs*4], mask_1, _mm512_extractf64x4_pd( c_4, 0x1 ) );
+	if(kn<=5)
+		return;
+	_mm256_mask_store_pd( &D0[bs*5], mask_0, _mm512_castpd512_pd256( c_5 ) );
+	_mm256_mask_store_pd( &D1[bs*5], mask_1, _mm512_extractf64x4_pd( c_5, 0x1 ) );
+	if(kn<=6)
+		return;
+	_mm256_mask_store_pd( &D0[bs*6], mask_0, _mm512_castpd512_pd256( c_6 ) );
+	_mm256_mask_store_pd( &D1[bs*6], mask_1, _mm512_extractf64x4_pd( c_6, 0x1 ) );
+	if(kn<=7)
+		return;
+	_mm256_mask_store_pd( &D0[bs*7], mask_0, _mm512_castpd512_pd256( c_7 ) );
+	_mm256_mask_store_pd( &D1[bs*7], mask_1, _mm512_extractf64x4_pd( c_7, 0x1 ) );
+
+	}
+
+#endif
+
@@ -0,0 +1,113 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <mmintrin.h>
+#include <xmmintrin.h>  // SSE
+#include <emmintrin.h>  // SSE2
+#include <pmmintrin.h>  // SSE3
+#include <smmintrin.h>  // SSE4
+#include <immintrin.h>  // AVX AVX2 AVX-512
+
+#include "../../include/kernel_d_lib4.h"
+
+
+#if ! defined(BLASFEO)
+
+// it moves vertically across blocks: the part below the 8x8 triangle is reduced in zmm registers,
+// then the two 4x4 triangles are solved by the AVX2 kernel
+void kernel_dtrsv_t_8_lib4_new(int kmax, double *A, int sda, int use_inv_diag_A, double *inv_diag_A, double *x)
+	{
+
+	if(kmax<=0)
+		return;
+
+	const int bs = 4;
+
+	double
+		*tA = A + 2*bs*sda,
+		*tx = x + 8;
+
+	int k;
+
+	__mmask8
+		mask;
+
+	__m512d
+		x_0, a_0, t_0, t_1,
+		y_0, y_1, y_2, y_3;
+
+	y_0 = _mm512_setzero_pd();
+	y_1 = _mm512_setzero_pd();
+	y_2 = _mm512_setzero_pd();
+	y_3 = _mm512_setzero_pd();
+
+	k = 8;
+	for(; k<kmax-3; k+=4)
+		{
+		x_0 = _mm512_broadcast_f64x4( _mm256_loadu_pd( &tx[0] ) );
+		a_0 = _mm512_loadu_pd( &tA[0] );
+		y_0 = _mm512_fmadd_pd( a_0, x_0, y_0 );
+		a_0 = _mm512_loadu_pd( &tA[8] );
+		y_1 = _mm512_fmadd_pd( a_0, x_0, y_1 );
+		a_0 = _mm512_loadu_pd( &tA[16] );
+		y_2 = _mm512_fmadd_pd( a_0, x_0, y_2 );
+		a_0 = _mm512_loadu_pd( &tA[24] );
+		y_3 = _mm512_fmadd_pd( a_0, x_0, y_3 );
+
+		tA += bs*sda;
+		tx += 4;
+		}
+	if(k<kmax)
+		{
+		mask = (1<<(kmax-k))-1;
+		x_0 = _mm512_broadcast_f64x4( _mm256_maskz_loadu_pd( mask, &tx[0] ) );
+		mask = mask | (mask<<4);
+		a_0 = _mm512_maskz_loadu_pd( mask, &tA[0] );
+		y_0 = _mm512_fmadd_pd( a_0, x_0, y_0 );
+		a_0 = _mm512_maskz_loadu_pd( mask, &tA[8] );
+		y_1 = _mm512_fmadd_pd( a_0, x_0, y_1 );
+		a_0 = _mm512_maskz_loadu_pd( mask, &tA[16] );
+		y_2 = _mm512_fmadd_pd( a_0, x_0, y_2 );
+		a_0 = _mm512_maskz_loadu_pd( mask, &tA[24] );
+		y_3 = _mm512_fmadd_pd( a_0, x_0, y_3 );
+		}
+
+	// reduce: y_j holds columns 2j (low half) and 2j+1 (high half)
+	t_0 = _mm512_add_pd( _mm512_unpacklo_pd( y_0, y_1 ), _mm512_unpackhi_pd( y_0, y_1 ) );
+	t_0 = _mm512_add_pd( t_0, _mm512_shuffle_f64x2( t_0, t_0, 0xb1 ) );
+	t_1 = _mm512_add_pd( _mm512_unpacklo_pd( y_2, y_3 ), _mm512_unpackhi_pd( y_2, y_3 ) );
+	t_1 = _mm512_add_pd( t_1, _mm512_shuffle_f64x2( t_1, t_1, 0xb1 ) );
+	y_0 = _mm512_permutex2var_pd( t_0, _mm512_set_epi64( 13, 9, 12, 8, 5, 1, 4, 0 ), t_1 );
+
+	_mm512_storeu_pd( &x[0], _mm512_sub_pd( _mm512_loadu_pd( &x[0] ), y_0 ) );
+
+	// bottom triangle, then top triangle with the square block below it
+	kernel_dtrsv_t_4_lib4_new(4, A+bs*sda+4*bs, sda, use_inv_diag_A, inv_diag_A+4, x+4);
+	kernel_dtrsv_t_4_lib4_new(8, A, sda, use_inv_diag_A, inv_diag_A, x);
+
+	}
+
+#endif
+
@@ -1891,3 +1891,424 @@ void kernel_dsyrk_dpotrf_nt_2x2_vs_lib4_new(int km, int kn, int kadd, int tri_A,
 	}
 
 
+
+// fused dtrmm + dsyrk + dpotrf: the panel W = A * B' (B upper triangular) is built one column at a time
+// and accumulated into W * W' while still in registers; R is added to the row ir of W if ir>=0
+void kernel_dtrmm_dsyrk_dpotrf_nt_4x4_vs_lib4_new(int km, int kn, int kadd, double *A, double *B, int sdb, double *R, int ir, int alg, double *C, double *W, double *D, double *inv_diag_D)
+	{
+
+	const int bs = 4;
+
+	int k, kk;
+
+	double
+		*B_k,
+		b_0,
+		w_0, w_1, w_2, w_3,
+		c_00=0,
+		c_10=0, c_11=0,
+		c_20=0, c_21=0, c_22=0,
+		c_30=0, c_31=0, c_32=0, c_33=0;
+
+	for(k=0; k<kadd; k++)
+		{
+
+		// k-th column of W: row k of B is non-zero from column k
+		B_k = B + k/bs*bs*sdb + k%bs;
+
+		w_0 = 0.0;
+		w_1 = 0.0;
+		w_2 = 0.0;
+		w_3 = 0.0;
+
+		for(kk=k; kk<kadd; kk++)
+			{
+
+			b_0 = B_k[bs*kk];
+
+			w_0 += A[0+bs*kk] * b_0;
+			w_1 += A[1+bs*kk] * b_0;
+			w_2 += A[2+bs*kk] * b_0;
+			w_3 += A[3+bs*kk] * b_0;
+
+			}
+
+		if(ir>=0)
+			{
+			if(ir==0)
+				w_0 += R[bs*k];
+			else if(ir==1)
+				w_1 += R[bs*k];
+			else if(ir==2)
+				w_2 += R[bs*k];
+			else
+				w_3 += R[bs*k];
+			}
+
+		W[0+bs*k] = w_0;
+		W[1+bs*k] = w_1;
+		W[2+bs*k] = w_2;
+		W[3+bs*k] = w_3;
+
+		c_00 += w_0 * w_0;
+		c_10 += w_1 * w_0;
+		c_20 += w_2 * w_0;
+		c_30 += w_3 * w_0;
+
+		c_11 += w_1 * w_1;
+		c_21 += w_2 * w_1;
+		c_31 += w_3 * w_1;
+
+		c_22 += w_2 * w_2;
+		c_32 += w_3 * w_2;
+
+		c_33 += w_3 * w_3;
+
+		}
+
+	if(alg!=0)
+		{
+		c_00 += C[0+bs*0];
+		c_10 += C[1+bs*0];
+		c_20 += C[2+bs*0];
+		c_30 += C[3+bs*0];
+
+		if(kn>=2)
+			{
+			c_11 += C[1+bs*1];
+			c_21 += C[2+bs*1];
+			c_31 += C[3+bs*1];
+			}
+
+		if(kn>=3)
+			{
+			c_22 += C[2+bs*2];
+			c_32 += C[3+bs*2];
+			}
+
+		if(kn>=4)
+			c_33 += C[3+bs*3];
+		}
+
+	// first column
+	if(c_00 > 1e-15)
+		{
+		c_00 = sqrt(c_00);
+		D[0+bs*0] = c_00;
+		c_00 = 1.0/c_00;
+		inv_diag_D[0] = c_00;
+		c_10 *= c_00;
+		c_20 *= c_00;
+		c_30 *= c_00;
+		}
+	else
+		{
+		c_00 = 0.0;
+		D[0+bs*0] = c_00;
+		inv_diag_D[0] = c_00;
+		c_10 = 0.0;
+		c_20 = 0.0;
+		c_30 = 0.0;
+		}
+	if(km>=2)
+		D[1+bs*0] = c_10;
+	if(km>=3)
+		D[2+bs*0] = c_20;
+	if(km>=4)
+		D[3+bs*0] = c_30;
+
+	if(kn==1 || km==1)
+		return;
+
+	// second column
+	c_11 -= c_10*c_10;
+	c_21 -= c_20*c_10;
+	c_31 -= c_30*c_10;
+	if(c_11 > 1e-15)
+		{
+		c_11 = sqrt(c_11);
+		D[1+bs*1] = c_11;
+		c_11 = 1.0/c_11;
+		inv_diag_D[1] = c_11;
+		c_21 *= c_11;
+		c_31 *= c_11;
+		}
+	else
+		{
+		c_11 = 0.0;
+		D[1+bs*1] = c_11;
+		inv_diag_D[1] = c_11;
+		c_21 = 0.0;
+		c_31 = 0.0;
+		}
+	if(km>=3)
+		D[2+bs*1] = c_21;
+	if(km>=4)
+		D[3+bs*1] = c_31;
+
+	if(kn==2 || km==2)
+		return;
+
+	// third column
+	c_22 -= c_20*c_20;
+	c_22 -= c_21*c_21;
+	c_32 -= c_30*c_20;
+	c_32 -= c_31*c_21;
+	if(c_22 > 1e-15)
+		{
+		c_22 = sqrt(c_22);
+		D[2+bs*2] = c_22;
+		c_22 = 1.0/c_22;
+		inv_diag_D[2] = c_22;
+		c_32 *= c_22;
+		}
+	else
+		{
+		c_22 = 0.0;
+		D[2+bs*2] = c_22;
+		inv_diag_D[2] = c_22;
+		c_32 = 0.0;
+		}
+	if(km>=4)
+		D[3+bs*2] = c_32;
+
+	if(kn==3 || km==3)
+		return;
+
+	// fourth column
+	c_33 -= c_30*c_30;
+	c_33 -= c_31*c_31;
+	c_33 -= c_32*c_32;
+	if(c_33 > 1e-15)
+		{
+		c_33 = sqrt(c_33);
+		D[3+bs*3] = c_33;
+		c_33 = 1.0/c_33;
+		inv_diag_D[3] = c_33;
+		}
+	else
+		{
+		c_33 = 0.0;
+		D[3+bs*3] = c_33;
+		inv_diag_D[3] = c_33;
+		}
+
+	}
+
+
+
+// fused dtrmm + dgemm + dtrsm: as above, but the panel W is multiplied by the panel Wp of the rows above,
+// and the result is solved with the factorized diagonal block E
+void kernel_dtrmm_dgemm_dtrsm_nt_4x4_vs_lib4_new(int km, int kn, int kadd, double *A, double *B, int sdb, double *R, int ir, double *Wp, int alg, double *C, double *W, double *D, double *E, double *inv_diag_E)
+	{
+
+	const int bs = 4;
+
+	int k, kk;
+
+	double
+		*B_k,
+		b_0, b_1, b_2, b_3,
+		w_0, w_1, w_2, w_3,
+		c_00=0, c_01=0, c_02=0, c_03=0,
+		c_10=0, c_11=0, c_12=0, c_13=0,
+		c_20=0, c_21=0, c_22=0, c_23=0,
+		c_30=0, c_31=0, c_32=0, c_33=0;
+
+	for(k=0; k<kadd; k++)
+		{
+
+		// k-th column of W: row k of B is non-zero from column k
+		B_k = B + k/bs*bs*sdb + k%bs;
+
+		w_0 = 0.0;
+		w_1 = 0.0;
+		w_2 = 0.0;
+		w_3 = 0.0;
+
+		for(kk=k; kk<kadd; kk++)
+			{
+
+			b_0 = B_k[bs*kk];
+
+			w_0 += A[0+bs*kk] * b_0;
+			w_1 += A[1+bs*kk] * b_0;
+			w_2 += A[2+bs*kk] * b_0;
+			w_3 += A[3+bs*kk] * b_0;
+
+			}
+
+		if(ir>=0)
+			{
+			if(ir==0)
+				w_0 += R[bs*k];
+			else if(ir==1)
+				w_1 += R[bs*k];
+			else if(ir==2)
+				w_2 += R[bs*k];
+			else
+				w_3 += R[bs*k];
+			}
+
+		W[0+bs*k] = w_0;
+		W[1+bs*k] = w_1;
+		W[2+bs*k] = w_2;
+		W[3+bs*k] = w_3;
+
+		b_0 = Wp[0+bs*k];
+		b_1 = Wp[1+bs*k];
+		b_2 = Wp[2+bs*k];
+		b_3 = Wp[3+bs*k];
+
+		c_00 += w_0 * b_0;
+		c_10 += w_1 * b_0;
+		c_20 += w_2 * b_0;
+		c_30 += w_3 * b_0;
+
+		c_01 += w_0 * b_1;
+		c_11 += w_1 * b_1;
+		c_21 += w_2 * b_1;
+		c_31 += w_3 * b_1;
+
+		c_02 += w_0 * b_2;
+		c_12 += w_1 * b_2;
+		c_22 += w_2 * b_2;
+		c_32 += w_3 * b_2;
+
+		c_03 += w_0 * b_3;
+		c_13 += w_1 * b_3;
+		c_23 += w_2 * b_3;
+		c_33 += w_3 * b_3;
+
+		}
+
+	if(alg!=0)
+		{
+		c_00 += C[0+bs*0];
+		c_10 += C[1+bs*0];
+		c_20 += C[2+bs*0];
+		c_30 += C[3+bs*0];
+
+		if(kn>=2)
+			{
+			c_01 += C[0+bs*1];
+			c_11 += C[1+bs*1];
+			c_21 += C[2+bs*1];
+			c_31 += C[3+bs*1];
+			}
+
+		if(kn>=3)
+			{
+			c_02 += C[0+bs*2];
+			c_12 += C[1+bs*2];
+			c_22 += C[2+bs*2];
+			c_32 += C[3+bs*2];
+			}
+
+		if(kn>=4)
+			{
+			c_03 += C[0+bs*3];
+			c_13 += C[1+bs*3];
+			c_23 += C[2+bs*3];
+			c_33 += C[3+bs*3];
+			}
+		}
+
+	// dtrsm
+	double
+		a_00, a_10, a_20, a_30, a_11, a_21, a_31, a_22, a_32, a_33;
+
+	a_00 = inv_diag_E[0];
+	c_00 *= a_00;
+	c_10 *= a_00;
+	c_20 *= a_00;
+	c_30 *= a_00;
+	D[0+bs*0] = c_00;
+	if(km>=2)
+		D[1+bs*0] = c_10;
+	if(km>=3)
+		D[2+bs*0] = c_20;
+	if(km>=4)
+		D[3+bs*0] = c_30;
+
+	if(kn==1)
+		return;
+
+	a_10 = E[1+bs*0];
+	a_11 = inv_diag_E[1];
+	c_01 -= c_00*a_10;
+	c_11 -= c_10*a_10;
+	c_21 -= c_20*a_10;
+	c_31 -= c_30*a_10;
+	c_01 *= a_11;
+	c_11 *= a_11;
+	c_21 *= a_11;
+	c_31 *= a_11;
+	D[0+bs*1] = c_01;
+	if(km>=2)
+		D[1+bs*1] = c_11;
+	if(km>=3)
+		D[2+bs*1] = c_21;
+	if(km>=4)
+		D[3+bs*1] = c_31;
+
+	if(kn==2)
+		return;
+
+	a_20 = E[2+bs*0];
+	a_21 = E[2+bs*1];
+	a_22 = inv_diag_E[2];
+	c_02 -= c_00*a_20;
+	c_12 -= c_10*a_20;
+	c_22 -= c_20*a_20;
+	c_32 -= c_30*a_20;
+	c_02 -= c_01*a_21;
+	c_12 -= c_11*a_21;
+	c_22 -= c_21*a_21;
+	c_32 -= c_31*a_21;
+	c_02 *= a_22;
+	c_12 *= a_22;
+	c_22 *= a_22;
+	c_32 *= a_22;
+	D[0+bs*2] = c_02;
+	if(km>=2)
+		D[1+bs*2] = c_12;
+	if(km>=3)
+		D[2+bs*2] = c_22;
+	if(km>=4)
+		D[3+bs*2] = c_32;
+
+	if(kn==3)
+		return;
+
+	a_30 = E[3+bs*0];
+	a_31 = E[3+bs*1];
+	a_32 = E[3+bs*2];
+	a_33 = inv_diag_E[3];
+	c_03 -= c_00*a_30;
+	c_13 -= c_10*a_30;
+	c_23 -= c_20*a_30;
+	c_33 -= c_30*a_30;
+	c_03 -= c_01*a_31;
+	c_13 -= c_11*a_31;
+	c_23 -= c_21*a_31;
+	c_33 -= c_31*a_31;
+	c_03 -= c_02*a_32;
+	c_13 -= c_12*a_32;
+	c_23 -= c_22*a_32;
+	c_33 -= c_32*a_32;
+	c_03 *= a_33;
+	c_13 *= a_33;
+	c_23 *= a_33;
+	c_33 *= a_33;
+	D[0+bs*3] = c_03;
+	if(km>=2)
+		D[1+bs*3] = c_13;
+	if(km>=3)
+		D[2+bs*3] = c_23;
+	if(km>=4)
+		D[3+bs*3] = c_33;
+
+	}
+
+
@@ -645,9 +645,6 @@ void kernel_sgemm_strsm_nt_8x4_lib4(int kadd, int ksub, float *A0, float *A1, fl
 void kernel_sgemm_strsm_nt_4x4_lib4(int kadd, int ksub, float *A0, float *B, float *C0, float *D0, float *fact)
 	{
 	
-	float *A1;
-	float *C1;
-	float *D1;
 	
 	int ki_add = kadd/4;
 	int kl_add = kadd%4;
@@ -1101,7 +1101,7 @@ void corner_strmm_nt_4x3_lib4(float *A, float *B, float *C)
 
 	float
 		a_0, a_1, a_2, a_3,
-		b_0, b_1, b_2, b_3,
+		b_0, b_1, b_2,
 		c_00=0, c_01=0, c_02=0,
 		c_10=0, c_11=0, c_12=0,
 		c_20=0, c_21=0, c_22=0,
@@ -1194,7 +1194,7 @@ void corner_strmm_nt_4x2_lib4(float *A, float *B, float *C)
 
 	float
 		a_0, a_1, a_2, a_3,
-		b_0, b_1, b_2, b_3,
+		b_0, b_1,
 		c_00=0, c_01=0,
 		c_10=0, c_11=0,
 		c_20=0, c_21=0,
@@ -1257,7 +1257,7 @@ void corner_strmm_nt_4x1_lib4(float *A, float *B, float *C)
 
 	float
 		a_0, a_1, a_2, a_3,
-		b_0, b_1, b_2, b_3,
+		b_0,
 		c_00=0,
 		c_10=0,
 		c_20=0,
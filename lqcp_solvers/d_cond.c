@@ -1239,7 +1239,7 @@ void d_cond_fact_R_N2_nx2_permute(int N, int nx, int nu, int free_x0, double **p
 
 			dsyrk_nt_lib(nx, nx, nx, pGamma_w[0], cnx, pAt[0], cnx, 0, pQs, cnx, pQs, cnx);
 			ddiaad_lib(nx, 1.0, pQ[0], 0, pQs, cnx);
-#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			dsyrk_dpotrf_lib(nx, nx, nu, pD+pnu*cnu, cnu, pD+pnu*cnu, cnu, -1, pQs, cnx, pQs, cnx, diag);
 #else
 			dsyrk_nt_lib(nx, nx, nu, pD+pnu*cnu, cnu, pD+pnu*cnu, cnu, -1, pQs, cnx, pQs, cnx);
@@ -1313,7 +1313,7 @@ void d_cond_fact_R_N2_nx2_permute(int N, int nx, int nu, int free_x0, double **p
 			for(ii=N-1; ii>0; ii--)
 				{
 
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 				dgemm_nt_lib(nx, (ii+1)*nu, nx, pAt[ii], cnx, pGamma_w[ii], cnx, 0, pGamma_w[ii-1], cnx, pGamma_w[ii-1], cnx, 1, 1);
 #else
 				dgemm_nt_lib((ii+1)*nu, nx, nx, pGamma_w[ii], cnx, pAt[ii], cnx, 0, pGamma_w[ii-1], cnx, pGamma_w[ii-1], cnx, 0, 0);
@@ -1337,7 +1337,7 @@ void d_cond_fact_R_N2_nx2_permute(int N, int nx, int nu, int free_x0, double **p
 				ddiain_lib(nx, pQ[ii], 0, pQs, cnx);
 				dsyrk_nt_lib(nx, nx, nu, pD+pnu*cnu, cnu, pD+pnu*cnu, cnu, -1, pQs, cnx, pQs, cnx);
 				dtrtr_l_lib(nx, 0, pQs, cnx, 0, pQs, cnx);	
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 				dgemm_nt_lib(nx, ii*nu, nx, pQs, cnx, pGamma_u[ii-1], cnx, 1, pGamma_w[ii-1], cnx, pGamma_w[ii-1], cnx, 1, 1);
 #else
 				dgemm_nt_lib(ii*nu, nx, nx, pGamma_u[ii-1], cnx, pQs, cnx, 1, pGamma_w[ii-1], cnx, pGamma_w[ii-1], cnx, 0, 0);
@@ -1357,7 +1357,7 @@ void d_cond_fact_R_N2_nx2_permute(int N, int nx, int nu, int free_x0, double **p
 
 			// last stage
 			dgecp_lib(nx, nx, 0, pQ[N], cnx, 0, pQs, cnx);
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 			dgemm_nt_lib(nx, N*nu, nx, pQs, cnx, pGamma_u[N-1], cnx, 0, pGamma_w[N-1], cnx, pGamma_w[N-1], cnx, 0, 1);
 #else
 			dgemm_nt_lib(N*nu, nx, nx, pGamma_u[N-1], cnx, pQs, cnx, 0, pGamma_w[N-1], cnx, pGamma_w[N-1], cnx, 0, 0);
@@ -1367,7 +1367,7 @@ void d_cond_fact_R_N2_nx2_permute(int N, int nx, int nu, int free_x0, double **p
 			for(ii=N-1; ii>0; ii--)
 				{
 
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 				dgemm_nt_lib(nx, (ii+1)*nu, nx, pAt[ii], cnx, pGamma_w[ii], cnx, 0, pGamma_w[ii-1], cnx, pGamma_w[ii-1], cnx, 1, 1);
 #else
 				dgemm_nt_lib((ii+1)*nu, nx, nx, pGamma_w[ii], cnx, pAt[ii], cnx, 0, pGamma_w[ii-1], cnx, pGamma_w[ii-1], cnx, 0, 0);
@@ -1390,7 +1390,7 @@ void d_cond_fact_R_N2_nx2_permute(int N, int nx, int nu, int free_x0, double **p
 
 				dsyrk_nt_lib(nx, nx, nu, pD+pnu*cnu, cnu, pD+pnu*cnu, cnu, -1, pQ[ii], cnx, pQs, cnx);
 				dtrtr_l_lib(nx, 0, pQs, cnx, 0, pQs, cnx);	
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 				dgemm_nt_lib(nx, ii*nu, nx, pQs, cnx, pGamma_u[ii-1], cnx, 1, pGamma_w[ii-1], cnx, pGamma_w[ii-1], cnx, 1, 1);
 #else
 				dgemm_nt_lib(ii*nu, nx, nx, pGamma_u[ii-1], cnx, pQs, cnx, 1, pGamma_w[ii-1], cnx, pGamma_w[ii-1], cnx, 0, 0);
@@ -2398,7 +2398,7 @@ void d_cond_R(int N, int nx, int nu, int alg, double **pA, double **pAt, double
 		for(ii=1; ii<N; ii++)
 			{
 			offset = ii*nu;
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 			dgemm_nt_lib(nx, ii*nu, nx, pA[ii], cnx, pGamma_u[ii-1], cnx, 0, pGamma_u[ii], cnx, pGamma_u[ii], cnx, 0, 1); // (A * Gamma_u^T)^T
 #else
 			dgemm_nt_lib(ii*nu, nx, nx, pGamma_u[ii-1], cnx, pA[ii], cnx, 0, pGamma_u[ii], cnx, pGamma_u[ii], cnx, 0, 0); // Gamma_u * A^T
@@ -2447,7 +2447,7 @@ void d_cond_R(int N, int nx, int nu, int alg, double **pA, double **pAt, double
 					}
 				else
 					{
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 					dgemm_nt_lib(nx, (ii+1)*nu, nx, pQ[ii+1], cnx, pGamma_u[ii], cnx, 0, pGamma_u_Q[ii], cnx, pGamma_u_Q[ii], cnx, 0, 1); // (A * Gamma_u^T)^T
 #else
 					dgemm_nt_lib((ii+1)*nu, nx, nx, pGamma_u[ii], cnx, pQ[ii+1], cnx, 0, pGamma_u_Q[ii], cnx, pGamma_u_Q[ii], cnx, 0, 0); // Gamma_u * A^T
@@ -2517,7 +2517,7 @@ void d_cond_R(int N, int nx, int nu, int alg, double **pA, double **pAt, double
 			dgecp_lib(N1*nu, nx, 0, pGamma_u_Q[N1-1], cnx, 0, pGamma_u_Q_A[N1-1], cnx);
 			for(ii=N1-1; ii>0; ii--)
 				{
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 				//dgemm_nt_lib(nx, ii*nu, nx, pAt[ii], cnx, pGamma_u_Q_A[ii], cnx, pGamma_u_Q[ii-1], cnx, pGamma_u_Q_A[ii-1], cnx, 1, 1, 1);
 				dgemm_nt_lib(nx, (ii+1)*nu, nx, pAt[ii], cnx, pGamma_u_Q_A[ii], cnx, 1, pGamma_u_Q[ii-1], cnx, pGamma_u_Q_A[ii-1], cnx, 1, 1);
 #else
@@ -2566,7 +2566,7 @@ void d_cond_R(int N, int nx, int nu, int alg, double **pA, double **pAt, double
 			{
 			for(ii=0; ii<N1; ii++)
 				{
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 				dgemm_nt_lib(nx, (ii+1)*nu, nx, pQ[ii+1], cnx, pGamma_u[ii], cnx, 0, pGamma_u_Q[ii], cnx, pGamma_u_Q[ii], cnx, 0, 1); // (A * Gamma_u^T)^T
 #else
 				dgemm_nt_lib((ii+1)*nu, nx, nx, pGamma_u[ii], cnx, pQ[ii+1], cnx, 0, pGamma_u_Q[ii], cnx, pGamma_u_Q[ii], cnx, 0, 0); // Gamma_u * A^T
@@ -2592,7 +2592,7 @@ void d_cond_R(int N, int nx, int nu, int alg, double **pA, double **pAt, double
 			dgecp_lib(N1*nu, nx, 0, pGamma_u_Q[N1-1], cnx, 0, pGamma_u_Q_A[N1-1], cnx);
 			for(ii=N1-1; ii>0; ii--)
 				{
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 				dgemm_nt_lib(nx, (ii+1)*nu, nx, pAt[ii], cnx, pGamma_u_Q_A[ii], cnx, 1, pGamma_u_Q[ii-1], cnx, pGamma_u_Q_A[ii-1], cnx, 1, 1);
 #else
 				dgemm_nt_lib((ii+1)*nu, nx, nx, pGamma_u_Q_A[ii], cnx, pAt[ii], cnx, 1, pGamma_u_Q[ii-1], cnx, pGamma_u_Q_A[ii-1], cnx, 0, 0);
@@ -2967,7 +2967,7 @@ void d_cond_B(int N, int nx, int nu, double **pA, double **pBt, int compute_Gamm
 		for(ii=1; ii<N; ii++)
 			{
 			offset = ii*nu;
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 			dgemm_nt_lib(nx, ii*nu, nx, pA[ii], cnx, pGamma_u[ii-1], cnx, 0, pGamma_u[ii], cnx, pGamma_u[ii], cnx, 0, 1); // (A * Gamma_u^T)^T
 #else
 			dgemm_nt_lib(ii*nu, nx, nx, pGamma_u[ii-1], cnx, pA[ii], cnx, 0, pGamma_u[ii], cnx, pGamma_u[ii], cnx, 0, 0); // Gamma_u * A^T
@@ -3997,7 +3997,7 @@ void d_cond_fact_R(int N, int nx, int nu, int nx2_fact, double **pA, double **pA
 			for(ii=1; ii<N; ii++)
 				{
 				offset = ii*nu;
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 				dgemm_nt_lib(nx, ii*nu, nx, pA[ii], cnx, pGamma_u[ii-1], cnx, 0, pGamma_u[ii], cnx, pGamma_u[ii], cnx, 0, 1); // (A * Gamma_u^T)^T
 #else
 				dgemm_nt_lib(ii*nu, nx, nx, pGamma_u[ii-1], cnx, pA[ii], cnx, 0, pGamma_u[ii], cnx, pGamma_u[ii], cnx, 0, 0); // Gamma_u * A^T
@@ -4017,7 +4017,7 @@ void d_cond_fact_R(int N, int nx, int nu, int nx2_fact, double **pA, double **pA
 			for(ii=N-1; ii>0; ii--)
 				{
 
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 				dgemm_nt_lib(nx, (ii+1)*nu, nx, pAt[ii], cnx, pGamma_w[ii], cnx, 0, pGamma_w[ii-1], cnx, pGamma_w[ii-1], cnx, 1, 1);
 #else
 				dgemm_nt_lib((ii+1)*nu, nx, nx, pGamma_w[ii], cnx, pAt[ii], cnx, 0, pGamma_w[ii-1], cnx, pGamma_w[ii-1], cnx, 0, 0);
@@ -4041,7 +4041,7 @@ void d_cond_fact_R(int N, int nx, int nu, int nx2_fact, double **pA, double **pA
 				ddiain_lib(nx, pQ[ii], 0, pQs, cnx);
 				dsyrk_nt_lib(nx, nx, nu, pD+pnu*cnu, cnu, pD+pnu*cnu, cnu, -1, pQs, cnx, pQs, cnx);
 				dtrtr_l_lib(nx, 0, pQs, cnx, 0, pQs, cnx);	
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 				dgemm_nt_lib(nx, ii*nu, nx, pQs, cnx, pGamma_u[ii-1], cnx, 1, pGamma_w[ii-1], cnx, pGamma_w[ii-1], cnx, 1, 1);
 #else
 				dgemm_nt_lib(ii*nu, nx, nx, pGamma_u[ii-1], cnx, pQs, cnx, 1, pGamma_w[ii-1], cnx, pGamma_w[ii-1], cnx, 0, 0);
@@ -4061,7 +4061,7 @@ void d_cond_fact_R(int N, int nx, int nu, int nx2_fact, double **pA, double **pA
 
 			// last stage
 			dgecp_lib(nx, nx, 0, pQ[N], cnx, 0, pQs, cnx);
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 			dgemm_nt_lib(nx, N*nu, nx, pQs, cnx, pGamma_u[N-1], cnx, 0, pGamma_w[N-1], cnx, pGamma_w[N-1], cnx, 0, 1);
 #else
 			dgemm_nt_lib(N*nu, nx, nx, pGamma_u[N-1], cnx, pQs, cnx, 0, pGamma_w[N-1], cnx, pGamma_w[N-1], cnx, 0, 0);
@@ -4071,7 +4071,7 @@ void d_cond_fact_R(int N, int nx, int nu, int nx2_fact, double **pA, double **pA
 			for(ii=N-1; ii>0; ii--)
 				{
 
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 				dgemm_nt_lib(nx, (ii+1)*nu, nx, pAt[ii], cnx, pGamma_w[ii], cnx, 0, pGamma_w[ii-1], cnx, pGamma_w[ii-1], cnx, 1, 1);
 #else
 				dgemm_nt_lib((ii+1)*nu, nx, nx, pGamma_w[ii], cnx, pAt[ii], cnx, 0, pGamma_w[ii-1], cnx, pGamma_w[ii-1], cnx, 0, 0);
@@ -4094,7 +4094,7 @@ void d_cond_fact_R(int N, int nx, int nu, int nx2_fact, double **pA, double **pA
 
 				dsyrk_nt_lib(nx, nx, nu, pD+pnu*cnu, cnu, pD+pnu*cnu, cnu, -1, pQ[ii], cnx, pQs, cnx);
 				dtrtr_l_lib(nx, 0, pQs, cnx, 0, pQs, cnx);	
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 				dgemm_nt_lib(nx, ii*nu, nx, pQs, cnx, pGamma_u[ii-1], cnx, 1, pGamma_w[ii-1], cnx, pGamma_w[ii-1], cnx, 1, 1);
 #else
 				dgemm_nt_lib(ii*nu, nx, nx, pGamma_u[ii-1], cnx, pQs, cnx, 1, pGamma_w[ii-1], cnx, pGamma_w[ii-1], cnx, 0, 0);
@@ -4120,7 +4120,7 @@ void d_cond_fact_R(int N, int nx, int nu, int nx2_fact, double **pA, double **pA
 			for(ii=1; ii<N-1; ii++)
 				{
 				offset = ii*nu;
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 				dgemm_nt_lib(nx, ii*nu, nx, pA[ii], cnx, pGamma_u[ii-1], cnx, 0, pGamma_u[ii], cnx, pGamma_u[ii], cnx, 0, 1); // (A * Gamma_u^T)^T
 #else
 				dgemm_nt_lib(ii*nu, nx, nx, pGamma_u[ii-1], cnx, pA[ii], cnx, 0, pGamma_u[ii], cnx, pGamma_u[ii], cnx, 0, 0); // Gamma_u * A^T
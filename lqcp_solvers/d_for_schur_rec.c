@@ -299,7 +299,7 @@ int d_forward_schur_trf_tv(int N, int *nv, int *ne, double reg, int *diag_hessia
 			ddiareg_lib(nv0, reg, 0, hpLA[ii], cnv0);
 
 			// assume that A is aligned to a panel boundary, and that the lower part of A is copied between Q and A
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			dlauum_dpotrf_lib(nve0, nv0, ne1, hpLe[ii-1], cne1, hpLe[ii-1], cne1, 1, hpLA[ii], cnv0, hpLA[ii], cnv0, hdLA[ii]);
 #else
 			dlauum_lib(ne1, hpLe[ii-1], cne1, hpLe[ii-1], cne1, 1, hpLA[ii], cnv0, hpLA[ii], cnv0);
@@ -0,0 +1,688 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#ifdef BLASFEO
+
+#include <blasfeo_target.h>
+#include <blasfeo_common.h>
+#include <blasfeo_d_aux.h>
+#include <blasfeo_d_kernel.h>
+#include <blasfeo_d_blas.h>
+
+
+
+/*
+parallel-in-time Riccati recursion: the horizon is split into n_chunk chunks of consecutive stages.
+Each chunk is factorized concurrently as an independent problem with zero terminal cost, and it is
+summarized by the map x_e = Phi*x_s + f - G*lam_e between its first and last state, where lam_e is the
+multiplier of the last state.
+The coarse system in the chunks boundary states is then solved by a (short) sequential Riccati
+recursion, and the solution is recovered by a second parallel backward-forward substitution.
+The factorization in hsL holds the local (zero terminal cost) factors, and the coarse factorization is
+kept in the work space: the trf and trs routines have to be called with the same n_chunk and work.
+*/
+
+
+
+// data and scratch space of a chunk; all matrices and vectors are sized with the max dimensions
+struct d_par_ric_chunk
+	{
+	struct blasfeo_dmat Phi; // transition matrix from first to last state
+	struct blasfeo_dmat G; // (full) gramian of the last state w.r.t. its multiplier
+	struct blasfeo_dmat Lm; // cholesky factor of I + Lpi_e' * G * Lpi_e
+	struct blasfeo_dmat Lpi; // cholesky factor of the cost-to-go hessian at the first state
+	struct blasfeo_dmat T0, T1, Y;
+	struct blasfeo_dmat work_mat_0, work_mat_1;
+	struct blasfeo_dvec f; // last state for zero first state and multiplier
+	struct blasfeo_dvec rho; // cost-to-go gradient at the first state
+	struct blasfeo_dvec xs; // first state
+	struct blasfeo_dvec pie; // multiplier of the last state
+	struct blasfeo_dvec work_vec_0, work_vec_1, work_vec_2;
+	};
+
+
+
+static void d_par_ric_max_dims(int N, int *nx, int *nu, int *ng, int *nxM, int *nuxM, int *nxgM, int *ngM)
+	{
+
+	int ii;
+
+	*nxM = 0;
+	*nuxM = 0;
+	*ngM = 0;
+	*nxgM = ng[N];
+	for(ii=0; ii<=N; ii++)
+		{
+		*nxM = nx[ii]>*nxM ? nx[ii] : *nxM;
+		*nuxM = nu[ii]+nx[ii]>*nuxM ? nu[ii]+nx[ii] : *nuxM;
+		*ngM = ng[ii]>*ngM ? ng[ii] : *ngM;
+		if(ii<N)
+			*nxgM = nx[ii+1]+ng[ii]>*nxgM ? nx[ii+1]+ng[ii] : *nxgM;
+		}
+
+	return;
+
+	}
+
+
+
+static int d_par_ric_chunk_size(int nxM, int nuxM, int nxgM, int ngM)
+	{
+
+	int size = 0;
+
+	size += 6*blasfeo_memsize_dmat(nxM, nxM); // Phi, G, Lm, Lpi, T0, T1
+	size += blasfeo_memsize_dmat(nxM, nuxM); // Y
+	size += blasfeo_memsize_dmat(nuxM+1, nxgM); // work_mat_0
+	if(ngM>0)
+		size += blasfeo_memsize_dmat(nuxM, nxgM); // work_mat_1
+	size += 7*blasfeo_memsize_dvec(nxM); // f, rho, xs, pie, work_vec_0, work_vec_1, work_vec_2
+
+	size = (size+63)/64*64;
+
+	return size;
+
+	}
+
+
+
+static void d_par_ric_create_chunk(int nxM, int nuxM, int nxgM, int ngM, struct d_par_ric_chunk *ch, void *mem)
+	{
+
+	char *c_ptr = (char *) mem;
+
+	blasfeo_create_dmat(nxM, nxM, &ch->Phi, (void *) c_ptr);
+	c_ptr += ch->Phi.memsize;
+	blasfeo_create_dmat(nxM, nxM, &ch->G, (void *) c_ptr);
+	c_ptr += ch->G.memsize;
+	blasfeo_create_dmat(nxM, nxM, &ch->Lm, (void *) c_ptr);
+	c_ptr += ch->Lm.memsize;
+	blasfeo_create_dmat(nxM, nxM, &ch->Lpi, (void *) c_ptr);
+	c_ptr += ch->Lpi.memsize;
+	blasfeo_create_dmat(nxM, nxM, &ch->T0, (void *) c_ptr);
+	c_ptr += ch->T0.memsize;
+	blasfeo_create_dmat(nxM, nxM, &ch->T1, (void *) c_ptr);
+	c_ptr += ch->T1.memsize;
+	blasfeo_create_dmat(nxM, nuxM, &ch->Y, (void *) c_ptr);
+	c_ptr += ch->Y.memsize;
+	blasfeo_create_dmat(nuxM+1, nxgM, &ch->work_mat_0, (void *) c_ptr);
+	c_ptr += ch->work_mat_0.memsize;
+	if(ngM>0)
+		{
+		blasfeo_create_dmat(nuxM, nxgM, &ch->work_mat_1, (void *) c_ptr);
+		c_ptr += ch->work_mat_1.memsize;
+		}
+	blasfeo_create_dvec(nxM, &ch->f, (void *) c_ptr);
+	c_ptr += ch->f.memsize;
+	blasfeo_create_dvec(nxM, &ch->rho, (void *) c_ptr);
+	c_ptr += ch->rho.memsize;
+	blasfeo_create_dvec(nxM, &ch->xs, (void *) c_ptr);
+	c_ptr += ch->xs.memsize;
+	blasfeo_create_dvec(nxM, &ch->pie, (void *) c_ptr);
+	c_ptr += ch->pie.memsize;
+	blasfeo_create_dvec(nxM, &ch->work_vec_0, (void *) c_ptr);
+	c_ptr += ch->work_vec_0.memsize;
+	blasfeo_create_dvec(nxM, &ch->work_vec_1, (void *) c_ptr);
+	c_ptr += ch->work_vec_1.memsize;
+	blasfeo_create_dvec(nxM, &ch->work_vec_2, (void *) c_ptr);
+	c_ptr += ch->work_vec_2.memsize;
+
+	return;
+
+	}
+
+
+
+static int d_par_ric_n_chunk(int N, int n_chunk)
+	{
+	if(n_chunk>N)
+		n_chunk = N;
+	if(n_chunk<1)
+		n_chunk = 1;
+	return n_chunk;
+	}
+
+
+
+// first stage of chunk p: chunk p holds stages [s_p, s_{p+1}), the last chunk holds [s_{n_chunk-1}, N]
+static int d_par_ric_chunk_start(int N, int n_chunk, int p)
+	{
+	return p*N/n_chunk;
+	}
+
+
+
+static void d_par_ric_create_chunks(int N, int *nx, int *nu, int *ng, int n_chunk, struct d_par_ric_chunk *chunk, void *work)
+	{
+
+	int nxM, nuxM, nxgM, ngM;
+	d_par_ric_max_dims(N, nx, nu, ng, &nxM, &nuxM, &nxgM, &ngM);
+
+	int chunk_size = d_par_ric_chunk_size(nxM, nuxM, nxgM, ngM);
+
+	char *c_ptr = (char *) work;
+
+	int ii;
+
+	for(ii=0; ii<n_chunk; ii++)
+		{
+		d_par_ric_create_chunk(nxM, nuxM, nxgM, ngM, &chunk[ii], (void *) c_ptr);
+		c_ptr += chunk_size;
+		}
+
+	return;
+
+	}
+
+
+
+// factorization of stage k with zero cost-to-go at stage k+1
+static void d_par_ric_trf_last_stage(int k, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dmat *hsL, struct d_par_ric_chunk *ch)
+	{
+
+	if(nb[k]>0 || ng[k]>0)
+		{
+		blasfeo_dtrcp_l(nu[k]+nx[k], &hsRSQrq[k], 0, 0, &hsL[k], 0, 0);
+		if(nb[k]>0)
+			{
+			blasfeo_ddiaad_sp(nb[k], 1.0, &hsQx[k], 0, hidxb[k], &hsL[k], 0, 0);
+			}
+		if(ng[k]>0)
+			{
+			blasfeo_dgemm_nd(nu[k]+nx[k], ng[k], 1.0, &hsDCt[k], 0, 0, &hsQx[k], nb[k], 0.0, &ch->work_mat_0, 0, 0, &ch->work_mat_0, 0, 0);
+			blasfeo_dsyrk_dpotrf_ln_mn(nu[k]+nx[k], nu[k]+nx[k], ng[k], &ch->work_mat_0, 0, 0, &hsDCt[k], 0, 0, &hsL[k], 0, 0, &hsL[k], 0, 0);
+			}
+		else
+			{
+			blasfeo_dpotrf_l(nu[k]+nx[k], &hsL[k], 0, 0, &hsL[k], 0, 0);
+			}
+		}
+	else
+		{
+		blasfeo_dpotrf_l(nu[k]+nx[k], &hsRSQrq[k], 0, 0, &hsL[k], 0, 0);
+		}
+
+	return;
+
+	}
+
+
+
+// factorization of stage k given the factorization of stage k+1
+static void d_par_ric_trf_stage(int k, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dmat *hsL, struct d_par_ric_chunk *ch)
+	{
+
+	blasfeo_dtrmm_rlnn(nu[k]+nx[k], nx[k+1], 1.0, &hsL[k+1], nu[k+1], nu[k+1], &hsBAbt[k], 0, 0, &ch->work_mat_0, 0, 0);
+	if(nb[k]>0 || ng[k]>0)
+		{
+		blasfeo_dtrcp_l(nu[k]+nx[k], &hsRSQrq[k], 0, 0, &hsL[k], 0, 0);
+		if(nb[k]>0)
+			{
+			blasfeo_ddiaad_sp(nb[k], 1.0, &hsQx[k], 0, hidxb[k], &hsL[k], 0, 0);
+			}
+		if(ng[k]>0)
+			{
+			blasfeo_dgemm_nd(nu[k]+nx[k], ng[k], 1.0, &hsDCt[k], 0, 0, &hsQx[k], nb[k], 0.0, &ch->work_mat_0, 0, nx[k+1], &ch->work_mat_0, 0, nx[k+1]);
+			blasfeo_dgecp(nu[k]+nx[k], nx[k+1], &ch->work_mat_0, 0, 0, &ch->work_mat_1, 0, 0);
+			blasfeo_dgecp(nu[k]+nx[k], ng[k], &hsDCt[k], 0, 0, &ch->work_mat_1, 0, nx[k+1]);
+			blasfeo_dsyrk_dpotrf_ln_mn(nu[k]+nx[k], nu[k]+nx[k], nx[k+1]+ng[k], &ch->work_mat_0, 0, 0, &ch->work_mat_1, 0, 0, &hsL[k], 0, 0, &hsL[k], 0, 0);
+			}
+		else
+			{
+			blasfeo_dsyrk_dpotrf_ln_mn(nu[k]+nx[k], nu[k]+nx[k], nx[k+1], &ch->work_mat_0, 0, 0, &ch->work_mat_0, 0, 0, &hsL[k], 0, 0, &hsL[k], 0, 0);
+			}
+		}
+	else
+		{
+		blasfeo_dsyrk_dpotrf_ln_mn(nu[k]+nx[k], nu[k]+nx[k], nx[k+1], &ch->work_mat_0, 0, 0, &ch->work_mat_0, 0, 0, &hsRSQrq[k], 0, 0, &hsL[k], 0, 0);
+		}
+
+	return;
+
+	}
+
+
+
+// local factorization of chunk p, and its transition matrix Phi and gramian G
+static void d_par_ric_trf_chunk(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dmat *hsL, int n_chunk, int p, struct d_par_ric_chunk *ch)
+	{
+
+	struct blasfeo_dmat *T0, *T1, *Ttmp;
+
+	int nn, nuk;
+
+	int s = d_par_ric_chunk_start(N, n_chunk, p);
+
+	// last chunk: standard riccati recursion
+	if(p==n_chunk-1)
+		{
+		d_par_ric_trf_last_stage(N, nx, nu, nb, hidxb, ng, hsRSQrq, hsDCt, hsQx, hsL, ch);
+		for(nn=N-1; nn>=s; nn--)
+			{
+			d_par_ric_trf_stage(nn, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsQx, hsL, ch);
+			}
+		if(p>0)
+			{
+			blasfeo_dtrcp_l(nx[s], &hsL[s], nu[s], nu[s], &ch->Lpi, 0, 0);
+			}
+		return;
+		}
+
+	int e = d_par_ric_chunk_start(N, n_chunk, p+1);
+	int ne = nx[e];
+
+	// T = Phi(e, nn+1), transition matrix of the closed-loop system
+	T0 = &ch->T0;
+	T1 = &ch->T1;
+	blasfeo_dgese(ne, ne, 0.0, T0, 0, 0);
+	blasfeo_ddiare(ne, 1.0, T0, 0, 0);
+	blasfeo_dgese(ne, ne, 0.0, &ch->G, 0, 0);
+
+	for(nn=e-1; nn>=s; nn--)
+		{
+		if(nn==e-1)
+			d_par_ric_trf_last_stage(nn, nx, nu, nb, hidxb, ng, hsRSQrq, hsDCt, hsQx, hsL, ch);
+		else
+			d_par_ric_trf_stage(nn, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsQx, hsL, ch);
+		// the first state of the horizon is eliminated together with the inputs
+		nuk = nn==0 ? nu[nn]+nx[nn] : nu[nn];
+		if(nuk>0)
+			{
+			// Y = T * B * Lu^{-T}, G += Y * Y'
+			blasfeo_dgemm_nt(ne, nuk, nx[nn+1], 1.0, T0, 0, 0, &hsBAbt[nn], 0, 0, 0.0, &ch->Y, 0, 0, &ch->Y, 0, 0);
+			blasfeo_dtrsm_rltn(ne, nuk, 1.0, &hsL[nn], 0, 0, &ch->Y, 0, 0, &ch->Y, 0, 0);
+			blasfeo_dgemm_nt(ne, ne, nuk, 1.0, &ch->Y, 0, 0, &ch->Y, 0, 0, 1.0, &ch->G, 0, 0, &ch->G, 0, 0);
+			}
+		if(nn>0)
+			{
+			// T = T * (A - B * Lu^{-T} * Lxu')
+			blasfeo_dgemm_nt(ne, nx[nn], nx[nn+1], 1.0, T0, 0, 0, &hsBAbt[nn], nu[nn], 0, 0.0, T1, 0, 0, T1, 0, 0);
+			if(nuk>0)
+				blasfeo_dgemm_nt(ne, nx[nn], nuk, -1.0, &ch->Y, 0, 0, &hsL[nn], nu[nn], 0, 1.0, T1, 0, 0, T1, 0, 0);
+			Ttmp = T0;
+			T0 = T1;
+			T1 = Ttmp;
+			}
+		}
+
+	if(s>0)
+		{
+		blasfeo_dgecp(ne, nx[s], T0, 0, 0, &ch->Phi, 0, 0);
+		}
+
+	return;
+
+	}
+
+
+
+// coarse factorization: Lpi of the chunks first state, from the last chunk backward
+static void d_par_ric_trf_coarse(int N, int *nx, int *nu, struct blasfeo_dmat *hsL, int n_chunk, struct d_par_ric_chunk *chunk)
+	{
+
+	int p, s, e, ne;
+
+	struct d_par_ric_chunk *ch, *nxt;
+
+	for(p=n_chunk-2; p>=0; p--)
+		{
+		ch = &chunk[p];
+		nxt = &chunk[p+1];
+		s = d_par_ric_chunk_start(N, n_chunk, p);
+		e = d_par_ric_chunk_start(N, n_chunk, p+1);
+		ne = nx[e];
+		// Lm = chol(I + Lpi_e' * G * Lpi_e)
+		blasfeo_dtrmm_rlnn(ne, ne, 1.0, &nxt->Lpi, 0, 0, &ch->G, 0, 0, &ch->T0, 0, 0);
+		blasfeo_dgetr(ne, ne, &ch->T0, 0, 0, &ch->T1, 0, 0);
+		blasfeo_dtrmm_rlnn(ne, ne, 1.0, &nxt->Lpi, 0, 0, &ch->T1, 0, 0, &ch->T0, 0, 0);
+		blasfeo_ddiare(ne, 1.0, &ch->T0, 0, 0);
+		blasfeo_dpotrf_l(ne, &ch->T0, 0, 0, &ch->Lm, 0, 0);
+		if(p>0)
+			{
+			// K = Phi' * Lpi_e * Lm^{-T}
+			blasfeo_dgetr(ne, nx[s], &ch->Phi, 0, 0, &ch->T1, 0, 0);
+			blasfeo_dtrmm_rlnn(nx[s], ne, 1.0, &nxt->Lpi, 0, 0, &ch->T1, 0, 0, &ch->T0, 0, 0);
+			blasfeo_dtrsm_rltn(nx[s], ne, 1.0, &ch->Lm, 0, 0, &ch->T0, 0, 0, &ch->T0, 0, 0);
+			// Lpi = chol(Lxx * Lxx' + K * K')
+			blasfeo_dgese(nx[s], nx[s], 0.0, &ch->T1, 0, 0);
+			blasfeo_dtrcp_l(nx[s], &hsL[s], nu[s], nu[s], &ch->T1, 0, 0);
+			blasfeo_dgese(nx[s], nx[s], 0.0, &ch->Lpi, 0, 0);
+			blasfeo_dsyrk_ln(nx[s], nx[s], 1.0, &ch->T1, 0, 0, &ch->T1, 0, 0, 1.0, &ch->Lpi, 0, 0, &ch->Lpi, 0, 0);
+			blasfeo_dsyrk_dpotrf_ln_mn(nx[s], nx[s], ne, &ch->T0, 0, 0, &ch->T0, 0, 0, &ch->Lpi, 0, 0, &ch->Lpi, 0, 0);
+			}
+		}
+
+	return;
+
+	}
+
+
+
+// backward substitution over the stages [s, e) of a chunk, with multiplier pie of the last state;
+// if last, the stages [s, N] are processed with the standard riccati recursion
+static void d_par_ric_trs_back_chunk(int s, int e, int last, int *nx, int *nu, int *nb, int **idxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsqx, struct blasfeo_dvec *hsux, int compute_Pb, struct blasfeo_dvec *hsPb, struct blasfeo_dmat *hsL, struct blasfeo_dvec *pie, struct d_par_ric_chunk *ch)
+	{
+
+	int nn;
+
+	for(nn=e-1; nn>=s; nn--)
+		{
+		blasfeo_dveccp(nu[nn]+nx[nn], &hsrq[nn], 0, &hsux[nn], 0);
+		if(nb[nn]>0)
+			{
+			blasfeo_dvecad_sp(nb[nn], 1.0, &hsqx[nn], 0, idxb[nn], &hsux[nn], 0);
+			}
+		if(ng[nn]>0)
+			{
+			blasfeo_dgemv_n(nu[nn]+nx[nn], ng[nn], 1.0, &hsDCt[nn], 0, 0, &hsqx[nn], nb[nn], 1.0, &hsux[nn], 0, &hsux[nn], 0);
+			}
+		if(last && nn==e-1)
+			{
+			// last stage of the horizon
+			continue;
+			}
+		if(nn==e-1)
+			{
+			if(pie!=NULL)
+				blasfeo_dgemv_n(nu[nn]+nx[nn], nx[nn+1], 1.0, &hsBAbt[nn], 0, 0, pie, 0, 1.0, &hsux[nn], 0, &hsux[nn], 0);
+			}
+		else
+			{
+			if(compute_Pb)
+				{
+				blasfeo_dtrmv_ltn(nx[nn+1], nx[nn+1], &hsL[nn+1], nu[nn+1], nu[nn+1], &hsb[nn], 0, &hsPb[nn+1], 0);
+				blasfeo_dtrmv_lnn(nx[nn+1], nx[nn+1], &hsL[nn+1], nu[nn+1], nu[nn+1], &hsPb[nn+1], 0, &hsPb[nn+1], 0);
+				}
+			blasfeo_daxpy(nx[nn+1], 1.0, &hsux[nn+1], nu[nn+1], &hsPb[nn+1], 0, &ch->work_vec_0, 0);
+			blasfeo_dgemv_n(nu[nn]+nx[nn], nx[nn+1], 1.0, &hsBAbt[nn], 0, 0, &ch->work_vec_0, 0, 1.0, &hsux[nn], 0, &hsux[nn], 0);
+			}
+		blasfeo_dtrsv_lnn_mn(nu[nn]+nx[nn], nn==0 ? nu[nn]+nx[nn] : nu[nn], &hsL[nn], 0, 0, &hsux[nn], 0, &hsux[nn], 0);
+		}
+
+	return;
+
+	}
+
+
+
+// forward substitution over the stages [s, e) of a chunk, from the first state xs (if s>0);
+// the last state is returned in xe (if not NULL) and its multiplier pie is copied in hspi[e]
+static void d_par_ric_trs_forw_chunk(int s, int e, int *nx, int *nu, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dvec *hsux, int compute_pi, struct blasfeo_dvec *hspi, struct blasfeo_dmat *hsL, struct blasfeo_dvec *xs, struct blasfeo_dvec *xe, struct blasfeo_dvec *pie, struct d_par_ric_chunk *ch)
+	{
+
+	int nn;
+
+	for(nn=s; nn<e; nn++)
+		{
+		if(nn==0)
+			{
+			blasfeo_dvecsc(nu[nn]+nx[nn], -1.0, &hsux[nn], 0);
+			blasfeo_dtrsv_ltn_mn(nu[nn]+nx[nn], nu[nn]+nx[nn], &hsL[nn], 0, 0, &hsux[nn], 0, &hsux[nn], 0);
+			}
+		else
+			{
+			if(nn==s)
+				{
+				if(xs!=NULL)
+					blasfeo_dveccp(nx[nn], xs, 0, &hsux[nn], nu[nn]);
+				else
+					blasfeo_dvecse(nx[nn], 0.0, &hsux[nn], nu[nn]);
+				}
+			blasfeo_dvecsc(nu[nn], -1.0, &hsux[nn], 0);
+			blasfeo_dtrsv_ltn_mn(nu[nn]+nx[nn], nu[nn], &hsL[nn], 0, 0, &hsux[nn], 0, &hsux[nn], 0);
+			}
+		if(nn==e-1 && xe!=NULL)
+			{
+			blasfeo_dgemv_t(nu[nn]+nx[nn], nx[nn+1], 1.0, &hsBAbt[nn], 0, 0, &hsux[nn], 0, 1.0, &hsb[nn], 0, xe, 0);
+			}
+		else if(nn==e-1 && pie!=NULL)
+			{
+			if(compute_pi)
+				blasfeo_dveccp(nx[nn+1], pie, 0, &hspi[nn+1], 0);
+			}
+		else
+			{
+			if(compute_pi)
+				{
+				blasfeo_dveccp(nx[nn+1], &hsux[nn+1], nu[nn+1], &hspi[nn+1], 0);
+				}
+			blasfeo_dgemv_t(nu[nn]+nx[nn], nx[nn+1], 1.0, &hsBAbt[nn], 0, 0, &hsux[nn], 0, 1.0, &hsb[nn], 0, &hsux[nn+1], nu[nn+1]);
+			if(compute_pi)
+				{
+				blasfeo_dveccp(nx[nn+1], &hsux[nn+1], nu[nn+1], &ch->work_vec_0, 0);
+				blasfeo_dtrmv_ltn(nx[nn+1], nx[nn+1], &hsL[nn+1], nu[nn+1], nu[nn+1], &ch->work_vec_0, 0, &ch->work_vec_0, 0);
+				blasfeo_dtrmv_lnn(nx[nn+1], nx[nn+1], &hsL[nn+1], nu[nn+1], nu[nn+1], &ch->work_vec_0, 0, &ch->work_vec_0, 0);
+				blasfeo_daxpy(nx[nn+1], 1.0, &ch->work_vec_0, 0, &hspi[nn+1], 0, &hspi[nn+1], 0);
+				}
+			}
+		}
+
+	return;
+
+	}
+
+
+
+// w = (I - Lpi * Lm^{-T} * Lm^{-1} * Lpi' * G) * v ; if trans, w = (I - G * Lpi * Lm^{-T} * Lm^{-1} * Lpi') * v
+static void d_par_ric_coarse_inv(int ne, int trans, struct blasfeo_dmat *Lpi, struct d_par_ric_chunk *ch, struct blasfeo_dvec *v, struct blasfeo_dvec *w)
+	{
+
+	struct blasfeo_dvec *tmp = &ch->work_vec_2;
+
+	if(trans)
+		blasfeo_dveccp(ne, v, 0, tmp, 0);
+	else
+		blasfeo_dgemv_n(ne, ne, 1.0, &ch->G, 0, 0, v, 0, 0.0, tmp, 0, tmp, 0);
+	blasfeo_dtrmv_ltn(ne, ne, Lpi, 0, 0, tmp, 0, tmp, 0);
+	blasfeo_dtrsv_lnn(ne, &ch->Lm, 0, 0, tmp, 0, tmp, 0);
+	blasfeo_dtrsv_ltn(ne, &ch->Lm, 0, 0, tmp, 0, tmp, 0);
+	blasfeo_dtrmv_lnn(ne, ne, Lpi, 0, 0, tmp, 0, tmp, 0);
+	if(trans)
+		blasfeo_dgemv_n(ne, ne, -1.0, &ch->G, 0, 0, tmp, 0, 1.0, v, 0, w, 0);
+	else
+		blasfeo_daxpy(ne, -1.0, tmp, 0, v, 0, w, 0);
+
+	return;
+
+	}
+
+
+
+// coarse substitution: cost-to-go gradient rho backward, and boundary states xs and multipliers pie forward
+static void d_par_ric_trs_coarse(int N, int *nx, int n_chunk, struct d_par_ric_chunk *chunk)
+	{
+
+	int p, s, e, ne;
+
+	struct d_par_ric_chunk *ch, *nxt;
+
+	// backward
+	for(p=n_chunk-2; p>0; p--)
+		{
+		ch = &chunk[p];
+		nxt = &chunk[p+1];
+		s = d_par_ric_chunk_start(N, n_chunk, p);
+		e = d_par_ric_chunk_start(N, n_chunk, p+1);
+		ne = nx[e];
+		// rho = rho + Phi' * (I + Pi*G)^{-1} * (Pi * f + rho_e)
+		blasfeo_dtrmv_ltn(ne, ne, &nxt->Lpi, 0, 0, &ch->f, 0, &ch->work_vec_0, 0);
+		blasfeo_dtrmv_lnn(ne, ne, &nxt->Lpi, 0, 0, &ch->work_vec_0, 0, &ch->work_vec_0, 0);
+		blasfeo_daxpy(ne, 1.0, &nxt->rho, 0, &ch->work_vec_0, 0, &ch->work_vec_0, 0);
+		d_par_ric_coarse_inv(ne, 0, &nxt->Lpi, ch, &ch->work_vec_0, &ch->work_vec_1);
+		blasfeo_dgemv_t(ne, nx[s], 1.0, &ch->Phi, 0, 0, &ch->work_vec_1, 0, 1.0, &ch->rho, 0, &ch->rho, 0);
+		}
+
+	// forward
+	for(p=0; p<n_chunk-1; p++)
+		{
+		ch = &chunk[p];
+		nxt = &chunk[p+1];
+		s = d_par_ric_chunk_start(N, n_chunk, p);
+		e = d_par_ric_chunk_start(N, n_chunk, p+1);
+		ne = nx[e];
+		// xe = (I + G*Pi)^{-1} * (Phi * xs + f - G * rho_e)
+		if(p>0)
+			blasfeo_dgemv_n(ne, nx[s], 1.0, &ch->Phi, 0, 0, &ch->xs, 0, 1.0, &ch->f, 0, &ch->work_vec_0, 0);
+		else
+			blasfeo_dveccp(ne, &ch->f, 0, &ch->work_vec_0, 0);
+		blasfeo_dgemv_n(ne, ne, -1.0, &ch->G, 0, 0, &nxt->rho, 0, 1.0, &ch->work_vec_0, 0, &ch->work_vec_0, 0);
+		d_par_ric_coarse_inv(ne, 1, &nxt->Lpi, ch, &ch->work_vec_0, &nxt->xs);
+		// pie = Pi * xe + rho_e
+		blasfeo_dtrmv_ltn(ne, ne, &nxt->Lpi, 0, 0, &nxt->xs, 0, &ch->pie, 0);
+		blasfeo_dtrmv_lnn(ne, ne, &nxt->Lpi, 0, 0, &ch->pie, 0, &ch->pie, 0);
+		blasfeo_daxpy(ne, 1.0, &nxt->rho, 0, &ch->pie, 0, &ch->pie, 0);
+		}
+
+	return;
+
+	}
+
+
+
+int d_par_back_ric_rec_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int *ng, int n_chunk)
+	{
+
+	int nxM, nuxM, nxgM, ngM;
+	d_par_ric_max_dims(N, nx, nu, ng, &nxM, &nuxM, &nxgM, &ngM);
+
+	n_chunk = d_par_ric_n_chunk(N, n_chunk);
+
+	int size = n_chunk*d_par_ric_chunk_size(nxM, nuxM, nxgM, ngM);
+
+	// make multiple of (typical) cache line size
+	size = (size+63)/64*64;
+
+	return size;
+
+	}
+
+
+
+void d_par_back_ric_rec_trf_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dmat *hsL, int n_chunk, void *work)
+	{
+
+	int p;
+
+	n_chunk = d_par_ric_n_chunk(N, n_chunk);
+
+	struct d_par_ric_chunk chunk[n_chunk];
+	d_par_ric_create_chunks(N, nx, nu, ng, n_chunk, chunk, work);
+
+	// local factorizations
+#if defined(_OPENMP)
+	#pragma omp parallel for schedule(static)
+#endif
+	for(p=0; p<n_chunk; p++)
+		{
+		d_par_ric_trf_chunk(N, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsQx, hsL, n_chunk, p, &chunk[p]);
+		}
+
+	// coarse factorization
+	d_par_ric_trf_coarse(N, nx, nu, hsL, n_chunk, chunk);
+
+	return;
+
+	}
+
+
+
+void d_par_back_ric_rec_trs_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsqx, struct blasfeo_dvec *hsux, int compute_pi, struct blasfeo_dvec *hspi, int compute_Pb, struct blasfeo_dvec *hsPb, struct blasfeo_dmat *hsL, int n_chunk, void *work)
+	{
+
+	int p;
+
+	n_chunk = d_par_ric_n_chunk(N, n_chunk);
+
+	struct d_par_ric_chunk chunk[n_chunk];
+	d_par_ric_create_chunks(N, nx, nu, ng, n_chunk, chunk, work);
+
+	// local substitutions with zero first state and last multiplier
+#if defined(_OPENMP)
+	#pragma omp parallel for schedule(static)
+#endif
+	for(p=0; p<n_chunk; p++)
+		{
+		int s = d_par_ric_chunk_start(N, n_chunk, p);
+		int e = d_par_ric_chunk_start(N, n_chunk, p+1);
+		if(p==n_chunk-1)
+			{
+			d_par_ric_trs_back_chunk(s, N+1, 1, nx, nu, nb, idxb, ng, hsBAbt, hsb, hsrq, hsDCt, hsqx, hsux, compute_Pb, hsPb, hsL, NULL, &chunk[p]);
+			if(p>0)
+				blasfeo_dveccp(nx[s], &hsux[s], nu[s], &chunk[p].rho, 0);
+			}
+		else
+			{
+			d_par_ric_trs_back_chunk(s, e, 0, nx, nu, nb, idxb, ng, hsBAbt, hsb, hsrq, hsDCt, hsqx, hsux, compute_Pb, hsPb, hsL, NULL, &chunk[p]);
+			if(p>0)
+				blasfeo_dveccp(nx[s], &hsux[s], nu[s], &chunk[p].rho, 0);
+			d_par_ric_trs_forw_chunk(s, e, nx, nu, hsBAbt, hsb, hsux, 0, hspi, hsL, NULL, &chunk[p].f, NULL, &chunk[p]);
+			}
+		}
+
+	// coarse substitution
+	d_par_ric_trs_coarse(N, nx, n_chunk, chunk);
+
+	// local substitutions with the coarse first state and last multiplier
+#if defined(_OPENMP)
+	#pragma omp parallel for schedule(static)
+#endif
+	for(p=0; p<n_chunk; p++)
+		{
+		int s = d_par_ric_chunk_start(N, n_chunk, p);
+		int e = d_par_ric_chunk_start(N, n_chunk, p+1);
+		if(p==n_chunk-1)
+			{
+			d_par_ric_trs_forw_chunk(s, N, nx, nu, hsBAbt, hsb, hsux, compute_pi, hspi, hsL, p>0 ? &chunk[p].xs : NULL, NULL, NULL, &chunk[p]);
+			}
+		else
+			{
+			d_par_ric_trs_back_chunk(s, e, 0, nx, nu, nb, idxb, ng, hsBAbt, hsb, hsrq, hsDCt, hsqx, hsux, 0, hsPb, hsL, &chunk[p].pie, &chunk[p]);
+			d_par_ric_trs_forw_chunk(s, e, nx, nu, hsBAbt, hsb, hsux, compute_pi, hspi, hsL, p>0 ? &chunk[p].xs : NULL, NULL, &chunk[p].pie, &chunk[p]);
+			}
+		}
+
+	return;
+
+	}
+
+
+
+void d_par_back_ric_rec_sv_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dvec *hsqx, struct blasfeo_dvec *hsux, int compute_pi, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hsPb, struct blasfeo_dmat *hsL, int n_chunk, void *work)
+	{
+
+	d_par_back_ric_rec_trf_libstr(N, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsQx, hsL, n_chunk, work);
+
+	d_par_back_ric_rec_trs_libstr(N, nx, nu, nb, hidxb, ng, hsBAbt, hsb, hsrq, hsDCt, hsqx, hsux, compute_pi, hspi, 1, hsPb, hsL, n_chunk, work);
+
+	return;
+
+	}
+
+
+
+#endif
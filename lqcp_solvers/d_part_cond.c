@@ -102,7 +102,7 @@ void d_cond_B(int N, int *nx, int *nu, double **pBAbt, double *work, double **pG
 	for(ii=1; ii<N; ii++)
 		{
 		dgetr_lib(nx[ii], nx[ii+1], 1.0, nu[ii], pBAbt[ii]+nu[ii]/bs*bs*cnx[ii+1]+nu[ii]%bs, cnx[ii+1], 0, work, cnx[ii]); // pA in work
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 		dgemm_nt_lib(nx[ii+1], nu_tmp, nx[ii], work, cnx[ii], pGamma_u[ii-1], cnx[ii], 0, pGamma_u[ii], cnx[ii+1], pGamma_u[ii], cnx[ii+1], 0, 1); // (A * Gamma_u^T)^T
 #else
 		dgemm_nt_lib(nu_tmp, nx[ii+1], nx[ii], pGamma_u[ii-1], cnx[ii], work, cnx[ii], 0, pGamma_u[ii], cnx[ii+1], pGamma_u[ii], cnx[ii+1], 0, 0); // Gamma_u * A^T
@@ -184,7 +184,7 @@ void d_cond_BAb(int N, int *nx, int *nu, double **pBAbt, double *work, double **
 		// TODO check for equal pointers and avoid copy
 		dgetr_lib(nx[ii], nx[ii+1], 1.0, nu[ii], pBAbt[ii]+nu[ii]/bs*bs*cnx[ii+1]+nu[ii]%bs, cnx[ii+1], 0, work, cnx[ii]); // pA in work
 		// B
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX) || defined(TARGET_C99_4X4)
 		dgemm_nt_lib(nx[ii+1], nu_tmp, nx[ii], work, cnx[ii], pGamma_u[ii-1], cnx[ii], 0, pGamma_u[ii], cnx[ii+1], pGamma_u[ii], cnx[ii+1], 0, 1); // (A * Gamma_u^T)^T
 #else
 		dgemm_nt_lib(nu_tmp, nx[ii+1], nx[ii], pGamma_u[ii-1], cnx[ii], work, cnx[ii], 0, pGamma_u[ii], cnx[ii+1], pGamma_u[ii], cnx[ii+1], 0, 0); // Gamma_u * A^T
@@ -352,6 +352,9 @@ void d_cond_RSQrq(int N, int *nx, int *nu, double **hpBAbt, double **hpRSQrq, do
 		nuM = nu[nn]>nuM ? nu[nn] : nuM;
 		nxM = nx[nn]>nxM ? nx[nn] : nxM;
 		nuxM = nu[nn]+nx[nn]>nuxM ? nu[nn]+nx[nn] : nuxM;
+		}
+	for(nn=0; nn<N; nn++)
+		{
 		nu2[nn+1] = nu2[nn] + nu[nn];
 		nu3[nn+1] = nu3[nn] + nu[N-nn-1];
 		}
@@ -575,8 +578,7 @@ for(nn=0; nn<=N; nn++)
 
 
 
-// TODO general constraints !!!!!
-void d_cond_DCtd(int N, int *nx, int *nu, int *nb, int **hidxb, double **hd, double **hpGamma, double *pDCt2, double *d2, int *idxb2)
+void d_cond_DCtd(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, double **hpDCt, double **hd, double **hpGamma, double *work, double *pDCt2, double *d2, int *idxb2)
 	{
 
 	// early return
@@ -589,11 +591,15 @@ void d_cond_DCtd(int N, int *nx, int *nu, int *nb, int **hidxb, double **hd, dou
 	int ii, jj;
 
 	int pnb[N+1];
+	int png[N+1];
 	int cnx[N+1];
+	int cng[N+1];
 	for(ii=0; ii<=N; ii++)
 		{
 		pnb[ii] = (nb[ii]+bs-1)/bs*bs;
+		png[ii] = (ng[ii]+bs-1)/bs*bs;
 		cnx[ii] = (nx[ii]+ncl-1)/ncl*ncl;
+		cng[ii] = (ng[ii]+ncl-1)/ncl*ncl;
 		}
 
 	int nbb = nb[0]; // box that remain box constraints
@@ -605,21 +611,21 @@ void d_cond_DCtd(int N, int *nx, int *nu, int *nb, int **hidxb, double **hd, dou
 			else
 				nbg++;
 	
-	int pnbb = (nbb+bs-1)/bs*bs;
-	int pnbg = (nbg+bs-1)/bs*bs;
-	int cnbg = (nbg+ncl-1)/ncl*ncl;
-
-//	int nx_tmp = 0;
-//	for(ii=1; ii<N; ii++)
-//		nx_tmp += nx[ii];
-	
-//	int cnxm2 = (nx_tmp+ncl-1)/ncl*ncl;
+	int nu2 = 0;
+	int ngg = 0; // general that remain general constraints
+	for(ii=0; ii<N; ii++)
+		{
+		nu2 += nu[ii];
+		ngg += ng[ii];
+		}
+	int ng2 = nbg + ngg;
 
-//	int nu2 = 0;
-//	for(ii=0; ii<N; ii++)
-//		nu2 += nu[ii];
+	int pnbb = (nbb+bs-1)/bs*bs;
+	int png2 = (ng2+bs-1)/bs*bs;
+	int cng2 = (ng2+ncl-1)/ncl*ncl;
 
-//	nx_tmp = 0;
+	// set constraint matrix to zero (it's 2 lower triangular matrices atm)
+	dgeset_lib(nu2+nx[0], ng2, 0.0, 0, pDCt2, cng2);
 
 	int nu_tmp = 0;
 
@@ -650,12 +656,12 @@ void d_cond_DCtd(int N, int *nx, int *nu, int *nb, int **hidxb, double **hd, dou
 				{
 				idx_g = hidxb[N-1-ii][jj]-nu[N-1-ii];
 				tmp = hpGamma[N-2-ii][idx_gammab/bs*bs*cnx[N-1-ii]+idx_gammab%bs+idx_g*bs];
-				d2[2*pnbb+0*pnbg+ig] = hd[N-1-ii][0*pnb[N-1-ii]+jj] - tmp;
-				d2[2*pnbb+1*pnbg+ig] = hd[N-1-ii][1*pnb[N-1-ii]+jj] - tmp;
+				d2[2*pnbb+0*png2+ig] = hd[N-1-ii][0*pnb[N-1-ii]+jj] - tmp;
+				d2[2*pnbb+1*png2+ig] = hd[N-1-ii][1*pnb[N-1-ii]+jj] - tmp;
 #ifdef BLASFEO
-				dgecp_lib(idx_gammab, 1, 1.0, 0, hpGamma[N-ii-2]+idx_g*bs, cnx[N-ii-1], nu_tmp, pDCt2+nu_tmp/bs*bs*cnbg+nu_tmp%bs+ig*bs, cnbg);
+				dgecp_lib(idx_gammab, 1, 1.0, 0, hpGamma[N-ii-2]+idx_g*bs, cnx[N-ii-1], nu_tmp, pDCt2+nu_tmp/bs*bs*cng2+nu_tmp%bs+ig*bs, cng2);
 #else
-				dgecp_lib(idx_gammab, 1, 0, hpGamma[N-ii-2]+idx_g*bs, cnx[N-ii-1], nu_tmp, pDCt2+nu_tmp/bs*bs*cnbg+nu_tmp%bs+ig*bs, cnbg);
+				dgecp_lib(idx_gammab, 1, 0, hpGamma[N-ii-2]+idx_g*bs, cnx[N-ii-1], nu_tmp, pDCt2+nu_tmp/bs*bs*cng2+nu_tmp%bs+ig*bs, cng2);
 #endif
 				ig++;
 				}
@@ -677,12 +683,99 @@ void d_cond_DCtd(int N, int *nx, int *nu, int *nb, int **hidxb, double **hd, dou
 		ib++;
 		}
 
-//	for(ii=0; ii<N-1; ii++)
-//		{
-//		nu_tmp += nu[N-ii-1];
-//		dgecp_lib(nu2-nu_tmp+nx[0], nx[N-ii-1], 0, hpGamma[N-ii-2], cnx[N-ii-1], nu_tmp, pDCt2+nu_tmp/bs*bs*cnxm2+nu_tmp%bs+nx_tmp*bs, cnxm2);
-//		nx_tmp += nx[N-ii-1];
-//		}
+	// XXX for now, just shift after box-to-general constraints
+	// better interleave them, to keep the block lower trianlgular structure !!!
+
+	// general constraints (ig==nbg here)
+
+	int nu0, nx0, ng0, nr0;
+	double *pCt, *buffer, *ptr_d2, *ptr_d;
+
+	nu_tmp = 0;
+	for(ii=0; ii<N-1; ii++)
+		{
+
+		nu0 = nu[N-1-ii];
+		nx0 = nx[N-1-ii];
+		ng0 = ng[N-1-ii];
+
+		if(ng0>0)
+			{
+
+			// D: inputs of the current stage
+#ifdef BLASFEO
+			dgecp_lib(nu0, ng0, 1.0, 0, hpDCt[N-1-ii], cng[N-1-ii], nu_tmp, pDCt2+nu_tmp/bs*bs*cng2+nu_tmp%bs+ig*bs, cng2);
+#else
+			dgecp_lib(nu0, ng0, 0, hpDCt[N-1-ii], cng[N-1-ii], nu_tmp, pDCt2+nu_tmp/bs*bs*cng2+nu_tmp%bs+ig*bs, cng2);
+#endif
+
+			nu_tmp += nu0;
+
+			// rows of Gamma, without the b row
+			nr0 = nu2 - nu_tmp + nx[0];
+
+			pCt = work;
+			buffer = work + png[N-1-ii]*cnx[N-1-ii];
+
+			// C: through Gamma, b row included
+#ifdef BLASFEO
+			dgetr_lib(nx0, ng0, 1.0, nu0, hpDCt[N-1-ii]+nu0/bs*bs*cng[N-1-ii]+nu0%bs, cng[N-1-ii], 0, pCt, cnx[N-1-ii]);
+
+			dgemm_nt_lib(nr0+1, ng0, nx0, 1.0, hpGamma[N-2-ii], cnx[N-1-ii], pCt, cnx[N-1-ii], 0.0, buffer, cng[N-1-ii], buffer, cng[N-1-ii]); // add unaligned stores in BLASFEO !!!!!!
+
+			dgecp_lib(nr0, ng0, 1.0, 0, buffer, cng[N-1-ii], nu_tmp, pDCt2+nu_tmp/bs*bs*cng2+nu_tmp%bs+ig*bs, cng2);
+#else
+			dgetr_lib(nx0, ng0, nu0, hpDCt[N-1-ii]+nu0/bs*bs*cng[N-1-ii]+nu0%bs, cng[N-1-ii], 0, pCt, cnx[N-1-ii]);
+
+			dgemm_nt_lib(nr0+1, ng0, nx0, hpGamma[N-2-ii], cnx[N-1-ii], pCt, cnx[N-1-ii], 0, buffer, cng[N-1-ii], buffer, cng[N-1-ii], 0, 0); // add unaligned stores in BLASFEO !!!!!!
+
+			dgecp_lib(nr0, ng0, 0, buffer, cng[N-1-ii], nu_tmp, pDCt2+nu_tmp/bs*bs*cng2+nu_tmp%bs+ig*bs, cng2);
+#endif
+
+			// d - C * Gammab
+			ptr_d = hd[N-1-ii] + 2*pnb[N-1-ii];
+			ptr_d2 = d2 + 2*pnbb + ig;
+			buffer += nr0/bs*bs*cng[N-1-ii] + nr0%bs;
+			for(jj=0; jj<ng0; jj++)
+				{
+				tmp = buffer[jj*bs];
+				ptr_d2[0*png2+jj] = ptr_d[0*png[N-1-ii]+jj] - tmp;
+				ptr_d2[1*png2+jj] = ptr_d[1*png[N-1-ii]+jj] - tmp;
+				}
+
+			ig += ng0;
+
+			}
+		else
+			{
+
+			nu_tmp += nu0;
+
+			}
+
+		}
+
+	// initial stage: both inputs and states
+	ng0 = ng[0];
+
+	if(ng0>0)
+		{
+
+#ifdef BLASFEO
+		dgecp_lib(nu[0]+nx[0], ng0, 1.0, 0, hpDCt[0], cng[0], nu_tmp, pDCt2+nu_tmp/bs*bs*cng2+nu_tmp%bs+ig*bs, cng2);
+#else
+		dgecp_lib(nu[0]+nx[0], ng0, 0, hpDCt[0], cng[0], nu_tmp, pDCt2+nu_tmp/bs*bs*cng2+nu_tmp%bs+ig*bs, cng2);
+#endif
+
+		ptr_d = hd[0] + 2*pnb[0];
+		ptr_d2 = d2 + 2*pnbb + ig;
+		for(jj=0; jj<ng0; jj++)
+			{
+			ptr_d2[0*png2+jj] = ptr_d[0*png[0]+jj];
+			ptr_d2[1*png2+jj] = ptr_d[1*png[0]+jj];
+			}
+
+		}
 
 	return;
 
@@ -749,15 +842,19 @@ int d_part_cond_work_space_size_bytes(int N, int *nx, int *nu, int *nb, int **hi
 	int pnx[N+1];
 	int pnu[N+1];
 	int pnz[N+1];
+	int png[N+1];
 	int cnx[N+1];
 	int cnu[N+1];
+	int cng[N+1];
 	for(ii=0; ii<=N; ii++)
 		{
 		pnx[ii] = (nx[ii]+bs-1)/bs*bs;
 		pnu[ii] = (nu[ii]+bs-1)/bs*bs;
 		pnz[ii] = (nu[ii]+nx[ii]+1+bs-1)/bs*bs;
+		png[ii] = (ng[ii]+bs-1)/bs*bs;
 		cnx[ii] = (nx[ii]+ncl-1)/ncl*ncl;
 		cnu[ii] = (nu[ii]+ncl-1)/ncl*ncl;
+		cng[ii] = (ng[ii]+ncl-1)/ncl*ncl;
 		}
 
 	int N1 = N/N2; // (floor) horizon of small blocks
@@ -774,6 +871,7 @@ int d_part_cond_work_space_size_bytes(int N, int *nx, int *nu, int *nb, int **hi
 	int buffer_size;
 	int pBAbtL_size;
 	int pM_size;
+	int pCt_size;
 	int tmp_size;
 
 	int nuM, nxM, nuxM;
@@ -840,6 +938,24 @@ int d_part_cond_work_space_size_bytes(int N, int *nx, int *nu, int *nb, int **hi
 		tmp_size = Gamma_size + pBAbtL_size + buffer_size + pM_size + pnzM*cnuxM + pnx1M*cnxM + pnx1M;
 		stage_size = tmp_size > stage_size ? tmp_size : stage_size;
 
+		pCt_size = 0;
+		buffer_size = 0;
+		nu_tmp = nu[N_tmp+0];
+		for(jj=1; jj<T1; jj++)
+			{
+			// pCt
+			tmp_size = png[N_tmp+jj]*cnx[N_tmp+jj];
+			pCt_size = tmp_size > pCt_size ? tmp_size : pCt_size;
+			// buffer
+			tmp_size = ((nu_tmp+nx[N_tmp+0]+1+bs-1)/bs*bs) * cng[N_tmp+jj];
+			buffer_size = tmp_size > buffer_size ? tmp_size : buffer_size;
+			//
+			nu_tmp += nu[N_tmp+jj];
+			}
+
+		tmp_size = Gamma_size + pCt_size + buffer_size;
+		stage_size = tmp_size > stage_size ? tmp_size : stage_size;
+
 		N_tmp += T1;
 		}
 	
@@ -966,16 +1082,8 @@ void d_part_cond(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, double
 		exit(1);
 		}
 	
-	// general constraints not implemented (can be only ng[N]>0)
-	for(ii=0; ii<N; ii++)
-		if(ng[ii]>0)
-			{
-			printf("\nError: it must be ng>0, general constraints case not implemented\n\n");
-			exit(1);
-			}
-
 	// packing quantities - 1
-	int cnx[N];
+	int cnx[N+1];
 	for(ii=0; ii<=N; ii++)
 		{
 		cnx[ii] = (nx[ii]+ncl-1)/ncl*ncl;
@@ -1053,7 +1161,7 @@ void d_part_cond(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, double
 			}
 		d_cond_BAbt(T1, &nx[N_tmp], &nu[N_tmp], &hpBAbt[N_tmp], ptr, hpGamma, hpBAbt2[ii]);
 		d_cond_RSQrq(T1, &nx[N_tmp], &nu[N_tmp], &hpBAbt[N_tmp], &hpRSQrq[N_tmp], hpGamma, ptr, hpRSQrq2[ii]);
-		d_cond_DCtd(T1, &nx[N_tmp], &nu[N_tmp], &nb[N_tmp], &hidxb[N_tmp], &hd[N_tmp], hpGamma, hpDCt2[ii], hd2[ii], hidxb2[ii]);
+		d_cond_DCtd(T1, &nx[N_tmp], &nu[N_tmp], &nb[N_tmp], &hidxb[N_tmp], &ng[N_tmp], &hpDCt[N_tmp], &hd[N_tmp], hpGamma, ptr, hpDCt2[ii], hd2[ii], hidxb2[ii]);
 		N_tmp += T1;
 		}
 
@@ -1156,7 +1264,7 @@ void d_part_expand_solution(int N, int *nx, int *nu, int *nb, int **hidxb, int *
 	int M1 = R1>0 ? N1+1 : N1; // (ceil) horizon of large blocks
 	int T1; // horizon of current block
 	int N_tmp, nu_tmp;
-	int nbb2, nbg2, nbb2_tmp, nbg2_tmp;
+	int nbb2_tmp, nbg2_tmp, ngg2_tmp;
 	int stg;
 
 	// inputs & initial states
@@ -1212,40 +1320,49 @@ void d_part_expand_solution(int N, int *nx, int *nu, int *nb, int **hidxb, int *
 		// final stages
 		for(jj=0; jj<T1-1; jj++)
 			{
-			nbb2 = 0;
-			nbg2 = 0;
-			for(ll=0; ll<nb[N_tmp+T1-1-jj]; ll++)
-				if(hidxb[N_tmp+T1-1-jj][ll]<nu[N_tmp+T1-1-jj])
-					nbb2++;
-				else
-					nbg2++;
-			for(ll=0; ll<nbb2; ll++) // box as box
-				{
-				hlam[N_tmp+T1-1-jj][0*pnb[N_tmp+T1-1-jj]+ll] = hlam2[ii][0*pnb2[ii]+nbb2_tmp+ll];
-				hlam[N_tmp+T1-1-jj][1*pnb[N_tmp+T1-1-jj]+ll] = hlam2[ii][1*pnb2[ii]+nbb2_tmp+ll];
-				ht[N_tmp+T1-1-jj][0*pnb[N_tmp+T1-1-jj]+ll] = ht2[ii][0*pnb2[ii]+nbb2_tmp+ll];
-				ht[N_tmp+T1-1-jj][1*pnb[N_tmp+T1-1-jj]+ll] = ht2[ii][1*pnb2[ii]+nbb2_tmp+ll];
-				}
-			for(ll=0; ll<nbg2; ll++) // box as general XXX change when decide where nbg are placed wrt ng
+			stg = N_tmp+T1-1-jj;
+			for(ll=0; ll<nb[stg]; ll++)
 				{
-				hlam[N_tmp+T1-1-jj][0*pnb[N_tmp+T1-1-jj]+nbb2+ll] = hlam2[ii][2*pnb2[ii]+0*png2[ii]+nbg2_tmp+ll];
-				hlam[N_tmp+T1-1-jj][1*pnb[N_tmp+T1-1-jj]+nbb2+ll] = hlam2[ii][2*pnb2[ii]+1*png2[ii]+nbg2_tmp+ll];
-				ht[N_tmp+T1-1-jj][0*pnb[N_tmp+T1-1-jj]+nbb2+ll] = ht2[ii][2*pnb2[ii]+0*png2[ii]+nbg2_tmp+ll];
-				ht[N_tmp+T1-1-jj][1*pnb[N_tmp+T1-1-jj]+nbb2+ll] = ht2[ii][2*pnb2[ii]+1*png2[ii]+nbg2_tmp+ll];
+				if(hidxb[stg][ll]<nu[stg]) // box as box
+					{
+					hlam[stg][0*pnb[stg]+ll] = hlam2[ii][0*pnb2[ii]+nbb2_tmp];
+					hlam[stg][1*pnb[stg]+ll] = hlam2[ii][1*pnb2[ii]+nbb2_tmp];
+					ht[stg][0*pnb[stg]+ll] = ht2[ii][0*pnb2[ii]+nbb2_tmp];
+					ht[stg][1*pnb[stg]+ll] = ht2[ii][1*pnb2[ii]+nbb2_tmp];
+					nbb2_tmp++;
+					}
+				else // box as general XXX change when decide where nbg are placed wrt ng
+					{
+					hlam[stg][0*pnb[stg]+ll] = hlam2[ii][2*pnb2[ii]+0*png2[ii]+nbg2_tmp];
+					hlam[stg][1*pnb[stg]+ll] = hlam2[ii][2*pnb2[ii]+1*png2[ii]+nbg2_tmp];
+					ht[stg][0*pnb[stg]+ll] = ht2[ii][2*pnb2[ii]+0*png2[ii]+nbg2_tmp];
+					ht[stg][1*pnb[stg]+ll] = ht2[ii][2*pnb2[ii]+1*png2[ii]+nbg2_tmp];
+					nbg2_tmp++;
+					}
 				}
-			nbb2_tmp += nbb2;
-			nbg2_tmp += nbg2;
 			}
 		// first stage
 		for(ll=0; ll<nb[N_tmp+0]; ll++) // all remain box
 			{
-			hlam[N_tmp+T1-1-jj][0*pnb[N_tmp+T1-1-jj]+ll] = hlam2[ii][0*pnb2[ii]+nbb2_tmp+ll];
-			hlam[N_tmp+T1-1-jj][1*pnb[N_tmp+T1-1-jj]+ll] = hlam2[ii][1*pnb2[ii]+nbb2_tmp+ll];
-			ht[N_tmp+T1-1-jj][0*pnb[N_tmp+T1-1-jj]+ll] = ht2[ii][0*pnb2[ii]+nbb2_tmp+ll];
-			ht[N_tmp+T1-1-jj][1*pnb[N_tmp+T1-1-jj]+ll] = ht2[ii][1*pnb2[ii]+nbb2_tmp+ll];
+			hlam[N_tmp+0][0*pnb[N_tmp+0]+ll] = hlam2[ii][0*pnb2[ii]+nbb2_tmp+ll];
+			hlam[N_tmp+0][1*pnb[N_tmp+0]+ll] = hlam2[ii][1*pnb2[ii]+nbb2_tmp+ll];
+			ht[N_tmp+0][0*pnb[N_tmp+0]+ll] = ht2[ii][0*pnb2[ii]+nbb2_tmp+ll];
+			ht[N_tmp+0][1*pnb[N_tmp+0]+ll] = ht2[ii][1*pnb2[ii]+nbb2_tmp+ll];
+			}
+		// general as general, after the box as general
+		ngg2_tmp = nbg2_tmp;
+		for(jj=0; jj<T1; jj++)
+			{
+			stg = N_tmp+T1-1-jj;
+			for(ll=0; ll<ng[stg]; ll++)
+				{
+				hlam[stg][2*pnb[stg]+0*png[stg]+ll] = hlam2[ii][2*pnb2[ii]+0*png2[ii]+ngg2_tmp+ll];
+				hlam[stg][2*pnb[stg]+1*png[stg]+ll] = hlam2[ii][2*pnb2[ii]+1*png2[ii]+ngg2_tmp+ll];
+				ht[stg][2*pnb[stg]+0*png[stg]+ll] = ht2[ii][2*pnb2[ii]+0*png2[ii]+ngg2_tmp+ll];
+				ht[stg][2*pnb[stg]+1*png[stg]+ll] = ht2[ii][2*pnb2[ii]+1*png2[ii]+ngg2_tmp+ll];
+				}
+			ngg2_tmp += ng[stg];
 			}
-//		nbb2_tmp += nbb2;
-//		nbg2_tmp += nbg2;
 		//
 		N_tmp += T1;
 		}
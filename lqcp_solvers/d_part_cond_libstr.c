@@ -105,7 +105,8 @@ static void d_comp_Gammab_libstr(int N, int *nx, int *nu, struct blasfeo_dmat *h
 
 
 
-static void d_cond_BAbt_libstr(int N, int *nx, int *nu, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsGamma, struct blasfeo_dmat *sBAbt2)
+// hsGamma[0] ... hsGamma[first-1] are still valid from a previous call and are not recomputed
+static void d_cond_BAbt_libstr(int N, int *nx, int *nu, struct blasfeo_dmat *hsBAbt, int first, struct blasfeo_dmat *hsGamma, struct blasfeo_dmat *sBAbt2)
 	{
 
 	int ii, jj;
@@ -115,14 +116,18 @@ static void d_cond_BAbt_libstr(int N, int *nx, int *nu, struct blasfeo_dmat *hsB
 	int nu_tmp;
 
 	nu_tmp = 0;
-	ii = 0;
-	// B & A & b
-	blasfeo_dgecp(nu[0]+nx[0]+1, nx[1], &hsBAbt[0], 0, 0, &hsGamma[0], 0, 0);
-	//
-	nu_tmp += nu[0];
-	ii++;
+	for(ii=0; ii<first; ii++)
+		nu_tmp += nu[ii];
 
-	for(ii=1; ii<N; ii++)
+	if(first==0)
+		{
+		// B & A & b
+		blasfeo_dgecp(nu[0]+nx[0]+1, nx[1], &hsBAbt[0], 0, 0, &hsGamma[0], 0, 0);
+		//
+		nu_tmp += nu[0];
+		}
+
+	for(ii=(first>1 ? first : 1); ii<N; ii++)
 		{
 		// TODO check for equal pointers and avoid copy
 
@@ -176,7 +181,8 @@ static void d_cond_b_libstr(int N, int *nx, int *nu, struct blasfeo_dmat *hsBAbt
 
 
 
-static void d_cond_RSQrq_libstr(int N, int *nx, int *nu, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsGamma, struct blasfeo_dmat *sRSQrq2, struct blasfeo_dmat *hsL, void *work_space, int *work_space_sizes)
+// hsL[last+1] ... hsL[N] are still valid from a previous call and are not factorized again
+static void d_cond_RSQrq_libstr(int N, int *nx, int *nu, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, int last, struct blasfeo_dmat *hsGamma, struct blasfeo_dmat *sRSQrq2, struct blasfeo_dmat *hsL, void *work_space, int *work_space_sizes)
 	{
 
 	// early return
@@ -212,7 +218,8 @@ static void d_cond_RSQrq_libstr(int N, int *nx, int *nu, struct blasfeo_dmat *hs
 	// final stage 
 	nub -= nu[N];
 
-	blasfeo_dgecp(nu[N]+nx[N]+1, nu[N]+nx[N], &hsRSQrq[N], 0, 0, &hsL[N], 0, 0);
+	if(last>=N)
+		blasfeo_dgecp(nu[N]+nx[N]+1, nu[N]+nx[N], &hsRSQrq[N], 0, 0, &hsL[N], 0, 0);
 
 	// D
 	blasfeo_dtrcp_l(nu[N], &hsL[N], 0, 0, sRSQrq2, nuf, nuf);
@@ -231,23 +238,29 @@ static void d_cond_RSQrq_libstr(int N, int *nx, int *nu, struct blasfeo_dmat *hs
 		{	
 		nub -= nu[N-nn-1];
 
-		blasfeo_create_dmat(nx[N-nn]+1, nx[N-nn], &sLx, (void *) c_ptr[0]);
-		blasfeo_create_dmat(nu[N-nn-1]+nx[N-nn-1]+1, nx[N-nn], &sBAbtL, (void *) c_ptr[1]);
+		// the Gamma-dependent part below is always recomputed
+		if(N-nn-1<=last)
+			{
+
+			blasfeo_create_dmat(nx[N-nn]+1, nx[N-nn], &sLx, (void *) c_ptr[0]);
+			blasfeo_create_dmat(nu[N-nn-1]+nx[N-nn-1]+1, nx[N-nn], &sBAbtL, (void *) c_ptr[1]);
 
 #if defined(LA_HIGH_PERFORMANCE)
-		blasfeo_dgecp(nx[N-nn]+1, nx[N-nn], &hsL[N-nn], nu[N-nn], nu[N-nn], &sLx, 0, 0);
+			blasfeo_dgecp(nx[N-nn]+1, nx[N-nn], &hsL[N-nn], nu[N-nn], nu[N-nn], &sLx, 0, 0);
 
-		blasfeo_dpotrf_l_mn(nx[N-nn]+1, nx[N-nn], &sLx, 0, 0, &sLx, 0, 0);
+			blasfeo_dpotrf_l_mn(nx[N-nn]+1, nx[N-nn], &sLx, 0, 0, &sLx, 0, 0);
 
-		blasfeo_dtrmm_rlnn(nu[N-nn-1]+nx[N-nn-1]+1, nx[N-nn], 1.0, &sLx, 0, 0, &hsBAbt[N-nn-1], 0, 0, &sBAbtL, 0, 0);
+			blasfeo_dtrmm_rlnn(nu[N-nn-1]+nx[N-nn-1]+1, nx[N-nn], 1.0, &sLx, 0, 0, &hsBAbt[N-nn-1], 0, 0, &sBAbtL, 0, 0);
 #else
-		blasfeo_dpotrf_l_mn(nx[N-nn]+1, nx[N-nn], &hsL[N-nn], nu[N-nn], nu[N-nn], &sLx, 0, 0);
+			blasfeo_dpotrf_l_mn(nx[N-nn]+1, nx[N-nn], &hsL[N-nn], nu[N-nn], nu[N-nn], &sLx, 0, 0);
 
-		blasfeo_dtrmm_rlnn(nu[N-nn-1]+nx[N-nn-1]+1, nx[N-nn], 1.0, &sLx, 0, 0, &hsBAbt[N-nn-1], 0, 0, &sBAbtL, 0, 0);
+			blasfeo_dtrmm_rlnn(nu[N-nn-1]+nx[N-nn-1]+1, nx[N-nn], 1.0, &sLx, 0, 0, &hsBAbt[N-nn-1], 0, 0, &sBAbtL, 0, 0);
 #endif
-		blasfeo_dgead(1, nx[N-nn], 1.0, &sLx, nx[N-nn], 0, &sBAbtL, nu[N-nn-1]+nx[N-nn-1], 0);
+			blasfeo_dgead(1, nx[N-nn], 1.0, &sLx, nx[N-nn], 0, &sBAbtL, nu[N-nn-1]+nx[N-nn-1], 0);
+
+			blasfeo_dsyrk_ln_mn(nu[N-nn-1]+nx[N-nn-1]+1, nu[N-nn-1]+nx[N-nn-1], nx[N-nn], 1.0, &sBAbtL, 0, 0, &sBAbtL, 0, 0, 1.0, &hsRSQrq[N-nn-1], 0, 0, &hsL[N-nn-1], 0, 0);
 
-		blasfeo_dsyrk_ln_mn(nu[N-nn-1]+nx[N-nn-1]+1, nu[N-nn-1]+nx[N-nn-1], nx[N-nn], 1.0, &sBAbtL, 0, 0, &sBAbtL, 0, 0, 1.0, &hsRSQrq[N-nn-1], 0, 0, &hsL[N-nn-1], 0, 0);
+			}
 
 		// D
 		blasfeo_dtrcp_l(nu[N-nn-1], &hsL[N-nn-1], 0, 0, sRSQrq2, nuf, nuf);
@@ -485,6 +498,7 @@ static void d_cond_DCtd_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, in
 
 		nx0 = nx[N-ii];
 		nu0 = nu[N-ii];
+		nb0 = nb[N-ii];
 		ng0 = ng[N-ii];
 		nt0 = nb0 + ng0;
 
@@ -530,6 +544,7 @@ static void d_cond_DCtd_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, in
 
 	nx0 = nx[0];
 	nu0 = nu[0];
+	nb0 = nb[0];
 	ng0 = ng[0];
 	nt0 = nb0 + ng0;
 
@@ -661,6 +676,7 @@ static void d_cond_d_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *
 
 		nx0 = nx[N-ii];
 		nu0 = nu[N-ii];
+		nb0 = nb[N-ii];
 		ng0 = ng[N-ii];
 		nt0 = nb0 + ng0;
 
@@ -689,6 +705,7 @@ static void d_cond_d_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *
 
 	nx0 = nx[0];
 	nu0 = nu[0];
+	nb0 = nb[0];
 	ng0 = ng[0];
 	nt0 = nb0 + ng0;
 
@@ -791,15 +808,10 @@ void d_part_cond_compute_problem_size_libstr_noidxb(int N, int *nx, int *nu, int
 
 
 
-int d_part_cond_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int N2, int *nx2, int *nu2, int *nb2, int *ng2, int *work_space_sizes)
+// work space of the condensing of one block
+static int d_part_cond_block_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *ng, int N2, int *work_space_sizes)
 	{
 
-	// early return
-	if(N2==N)
-		{
-		return 0;
-		}
-
 	int ii, jj;
 	int nu_tmp;
 
@@ -809,7 +821,8 @@ int d_part_cond_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, i
 	int T1; // horizon of current block
 	int N_tmp; // temporary sum of horizons
 
-	int Gamma_size = 0;
+	int Gammab_size = 0;
+	int DCt_size = 0;
 	work_space_sizes[0] = 0;
 	work_space_sizes[1] = 0;
 	work_space_sizes[2] = 0;
@@ -823,15 +836,13 @@ int d_part_cond_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, i
 
 		T1 = ii<R1 ? M1 : N1;
 
-		// hsGamma // XXX size(hsGamma) > size(hsGammab) !!!!!
-		nu_tmp = 0;
+		// hsGammab (hsGamma is in the memory space)
 		tmp_size = 0;
 		for(jj=0; jj<T1; jj++)
 			{
-			nu_tmp += nu[N_tmp+jj];
-			tmp_size += blasfeo_memsize_dmat(nx[N_tmp]+nu_tmp+1, nx[N_tmp+jj+1]);
+			tmp_size += blasfeo_memsize_dvec(nx[N_tmp+jj+1]);
 			}
-		Gamma_size = tmp_size>Gamma_size ? tmp_size : Gamma_size;
+		Gammab_size = tmp_size>Gammab_size ? tmp_size : Gammab_size;
 
 		// sLx : 1 => N-1
 		for(jj=1; jj<T1; jj++)
@@ -861,13 +872,21 @@ int d_part_cond_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, i
 			work_space_sizes[3] = tmp_size>work_space_sizes[3] ? tmp_size : work_space_sizes[3];
 			}
 
+		// sGammab, sCGammab : 1 => N-1
+		for(jj=1; jj<T1; jj++)
+			{
+			tmp_size = blasfeo_memsize_dvec(nx[N_tmp+jj]) + blasfeo_memsize_dvec(ng[N_tmp+jj]);
+			DCt_size = tmp_size>DCt_size ? tmp_size : DCt_size;
+			}
+
 		N_tmp += T1;
 
 		}
 	
 	tmp_size = work_space_sizes[0] + work_space_sizes[1];
 	tmp_size = work_space_sizes[2]+work_space_sizes[3]>tmp_size ? work_space_sizes[2]+work_space_sizes[3] : tmp_size;
-	int size = Gamma_size+tmp_size;
+	tmp_size = DCt_size>tmp_size ? DCt_size : tmp_size;
+	int size = Gammab_size+tmp_size;
 	
 	size = (size + 63) / 64 * 64; // make work space multiple of (typical) cache line size
 
@@ -877,6 +896,28 @@ int d_part_cond_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, i
 
 
 
+int d_part_cond_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int N2, int *nx2, int *nu2, int *nb2, int *ng2, int *work_space_sizes)
+	{
+
+	// early return
+	if(N2==N)
+		{
+		return 0;
+		}
+
+	int size = d_part_cond_block_work_space_size_bytes_libstr(N, nx, nu, ng, N2, work_space_sizes);
+
+#if defined(_OPENMP)
+	// blocks are condensed concurrently: one work space per block
+	size *= N2;
+#endif
+
+	return size;
+
+	}
+
+
+
 int d_part_cond_memory_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int N2, int *nx2, int *nu2, int *nb2, int *ng2)
 	{
 
@@ -896,6 +937,26 @@ int d_part_cond_memory_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb,
 		size += blasfeo_memsize_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii]);
 		}
 
+	int N1 = N/N2; // (floor) horizon of small blocks
+	int R1 = N - N2*N1; // the first R1 blocks have horizon N1+1
+	int M1 = R1>0 ? N1+1 : N1; // (ceil) horizon of large blocks
+
+	int jj, T1, N_tmp, nu_tmp;
+
+	N_tmp = 0;
+	for(ii=0; ii<N2; ii++)
+		{
+		T1 = ii<R1 ? M1 : N1;
+		// hsGamma
+		nu_tmp = 0;
+		for(jj=0; jj<T1; jj++)
+			{
+			nu_tmp += nu[N_tmp+jj];
+			size += blasfeo_memsize_dmat(nx[N_tmp]+nu_tmp+1, nx[N_tmp+jj+1]);
+			}
+		N_tmp += T1;
+		}
+
 	// make memory space multiple of (typical) cache line size
 	size = (size + 63) / 64 * 64;
 
@@ -905,17 +966,21 @@ int d_part_cond_memory_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb,
 
 
 
-void d_part_cond_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, int N2, int *nx2, int *nu2, int *nb2, int **hidxb2, int *ng2, struct blasfeo_dmat *hsBAbt2, struct blasfeo_dmat *hsRSQrq2, struct blasfeo_dmat *hsDCt2, struct blasfeo_dvec *hsd2, void *memory, void *work, int *work_space_sizes)
+// incremental partial condensing: dirty[ii]!=0 flags the stages whose BAbt, RSQrq or DCt changed since the previous call with the same memory and output;
+// blocks without dirty stages are left untouched; in the other blocks Gamma is recomputed from the first dirty stage and hsL from the last dirty stage,
+// while the condensed Hessian and constraints of the block are assembled again. dirty==NULL condenses all blocks
+void d_part_cond_update_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int *dirty, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, int N2, int *nx2, int *nu2, int *nb2, int **hidxb2, int *ng2, struct blasfeo_dmat *hsBAbt2, struct blasfeo_dmat *hsRSQrq2, struct blasfeo_dmat *hsDCt2, struct blasfeo_dvec *hsd2, void *memory, void *work, int *work_space_sizes)
 	{
 
 	int ii, jj, kk;
-	int nu_tmp;
 
 	// early return
 	if(N2==N)
 		{
 		for(ii=0; ii<N; ii++)
 			{
+			if(dirty!=NULL && dirty[ii]==0)
+				continue;
 			for(jj=0; jj<nb[ii]; jj++) hidxb2[ii][jj] = hidxb[ii][jj];
 			blasfeo_dgecp(nu[ii]+nx[ii]+1, nx[ii+1], &hsBAbt[ii], 0, 0, &hsBAbt2[ii], 0, 0);
 			blasfeo_dgecp(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], &hsRSQrq[ii], 0, 0, &hsRSQrq2[ii], 0, 0);
@@ -935,8 +1000,6 @@ void d_part_cond_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng,
 	int N1 = N/N2; // (floor) horizon of small blocks
 	int R1 = N - N2*N1; // the first R1 blocks have horizon N1+1
 	int M1 = R1>0 ? N1+1 : N1; // (ceil) horizon of large blocks
-	int T1; // horizon of current block
-	int N_tmp = 0; // temporary sum of horizons
 
 	// memory space
 	char *c_ptr = (char *) memory;
@@ -947,36 +1010,68 @@ void d_part_cond_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng,
 		blasfeo_create_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], &hsL[ii], (void *) c_ptr);
 		c_ptr += hsL[ii].memsize;
 		}
+	// Gamma of each block (memory space), hsGamma[N_tmp+jj] for stage jj of the block starting at N_tmp
+	struct blasfeo_dmat hsGamma[N];
+	for(ii=0; ii<N2; ii++)
+		{
+		int T1 = ii<R1 ? M1 : N1; // horizon of current block
+		int N_tmp = ii*N1 + (ii<R1 ? ii : R1); // first stage of current block
+		int nu_tmp = nu[N_tmp+0];
+		for(jj=0; jj<T1; jj++)
+			{
+			blasfeo_create_dmat(nx[N_tmp+0]+nu_tmp+1, nx[N_tmp+jj+1], &hsGamma[N_tmp+jj], (void *) c_ptr);
+			c_ptr += hsGamma[N_tmp+jj].memsize;
+			nu_tmp += nu[N_tmp+jj+1];
+			}
+		}
 
 	// work space
-	struct blasfeo_dmat hsGamma[M1];
-	int tmp_i, tmp_size;
+#if defined(_OPENMP)
+	int tmp_sizes[4];
+	int block_size = d_part_cond_block_work_space_size_bytes_libstr(N, nx, nu, ng, N2, tmp_sizes);
+#endif
 
-	// other stages
-	N_tmp = 0;
+	// other stages: the blocks are independent
+#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic)
+#endif
 	for(ii=0; ii<N2; ii++)
 		{
 
-		T1 = ii<R1 ? M1 : N1;
+		int jj;
+		int T1 = ii<R1 ? M1 : N1; // horizon of current block
+		int N_tmp = ii*N1 + (ii<R1 ? ii : R1); // first stage of current block
+		int first = 0; // first dirty stage of current block
+		int last = T1-1; // last dirty stage of current block
 
-		c_ptr = (char *) work;
-
-		// sGamma
-		nu_tmp = nu[N_tmp+0];
-		for(jj=0; jj<T1; jj++)
+		if(dirty!=NULL)
 			{
-			blasfeo_create_dmat(nx[N_tmp+0]+nu_tmp+1, nx[N_tmp+jj+1], &hsGamma[jj], (void *) c_ptr);
-			c_ptr += hsGamma[jj].memsize;
-			nu_tmp += nu[N_tmp+jj+1];
+			first = T1;
+			last = -1;
+			for(jj=0; jj<T1; jj++)
+				{
+				if(dirty[N_tmp+jj]!=0)
+					{
+					first = jj<first ? jj : first;
+					last = jj;
+					}
+				}
+			// clean block: condensed matrices, Gamma and hsL from the previous call are still valid
+			if(last<0)
+				continue;
 			}
-		// sA
-		// no c_ptr += ... : overwrite sA
-		d_cond_BAbt_libstr(T1, &nx[N_tmp], &nu[N_tmp], &hsBAbt[N_tmp], hsGamma, &hsBAbt2[ii]);
 
-		d_cond_RSQrq_libstr(T1-1, &nx[N_tmp], &nu[N_tmp], &hsBAbt[N_tmp], &hsRSQrq[N_tmp], hsGamma, &hsRSQrq2[ii], &hsL[N_tmp], (void *) c_ptr, work_space_sizes);
+#if defined(_OPENMP)
+		char *c_ptr = (char *) work + ii*block_size;
+#else
+		char *c_ptr = (char *) work;
+#endif
 
-		d_cond_DCtd_libstr(T1-1, &nx[N_tmp], &nu[N_tmp], &nb[N_tmp], &hidxb[N_tmp], &ng[N_tmp], &hsDCt[N_tmp], &hsd[N_tmp], hsGamma, &hsDCt2[ii], &hsd2[ii], hidxb2[ii], (void *) c_ptr);
-		N_tmp += T1;
+		d_cond_BAbt_libstr(T1, &nx[N_tmp], &nu[N_tmp], &hsBAbt[N_tmp], first, &hsGamma[N_tmp], &hsBAbt2[ii]);
+
+		d_cond_RSQrq_libstr(T1-1, &nx[N_tmp], &nu[N_tmp], &hsBAbt[N_tmp], &hsRSQrq[N_tmp], last, &hsGamma[N_tmp], &hsRSQrq2[ii], &hsL[N_tmp], (void *) c_ptr, work_space_sizes);
+
+		d_cond_DCtd_libstr(T1-1, &nx[N_tmp], &nu[N_tmp], &nb[N_tmp], &hidxb[N_tmp], &ng[N_tmp], &hsDCt[N_tmp], &hsd[N_tmp], &hsGamma[N_tmp], &hsDCt2[ii], &hsd2[ii], hidxb2[ii], (void *) c_ptr);
 //exit(1);
 		}
 	
@@ -988,6 +1083,17 @@ void d_part_cond_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng,
 
 
 
+void d_part_cond_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, int N2, int *nx2, int *nu2, int *nb2, int **hidxb2, int *ng2, struct blasfeo_dmat *hsBAbt2, struct blasfeo_dmat *hsRSQrq2, struct blasfeo_dmat *hsDCt2, struct blasfeo_dvec *hsd2, void *memory, void *work, int *work_space_sizes)
+	{
+
+	d_part_cond_update_libstr(N, nx, nu, nb, hidxb, ng, NULL, hsBAbt, hsRSQrq, hsDCt, hsd, N2, nx2, nu2, nb2, hidxb2, ng2, hsBAbt2, hsRSQrq2, hsDCt2, hsd2, memory, work, work_space_sizes);
+
+	return;
+
+	}
+
+
+
 void d_part_cond_rhs_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, int N2, int *nx2, int *nu2, int *nb2, int **hidxb2, int *ng2, struct blasfeo_dmat *hsBAbt2, struct blasfeo_dvec *hsb2, struct blasfeo_dmat *hsRSQrq2, struct blasfeo_dvec *hsrq2, struct blasfeo_dmat *hsDCt2, struct blasfeo_dvec *hsd2, void *memory, void *work, int *work_space_sizes)
 	{
 
@@ -1019,8 +1125,6 @@ void d_part_cond_rhs_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *
 	int N1 = N/N2; // (floor) horizon of small blocks
 	int R1 = N - N2*N1; // the first R1 blocks have horizon N1+1
 	int M1 = R1>0 ? N1+1 : N1; // (ceil) horizon of large blocks
-	int T1; // horizon of current block
-	int N_tmp = 0; // temporary sum of horizons
 
 	// memory space
 	char *c_ptr = (char *) memory;
@@ -1033,17 +1137,28 @@ void d_part_cond_rhs_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *
 		}
 
 	// work space
-	struct blasfeo_dvec hsGammab[M1];
-	int tmp_i, tmp_size;
+#if defined(_OPENMP)
+	int tmp_sizes[4];
+	int block_size = d_part_cond_block_work_space_size_bytes_libstr(N, nx, nu, ng, N2, tmp_sizes);
+#endif
 
-	// other stages
-	N_tmp = 0;
+	// other stages: the blocks are independent
+#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic)
+#endif
 	for(ii=0; ii<N2; ii++)
 		{
 
-		T1 = ii<R1 ? M1 : N1;
+		int jj;
+		int T1 = ii<R1 ? M1 : N1; // horizon of current block
+		int N_tmp = ii*N1 + (ii<R1 ? ii : R1); // first stage of current block
+		struct blasfeo_dvec hsGammab[M1];
 
-		c_ptr = (char *) work;
+#if defined(_OPENMP)
+		char *c_ptr = (char *) work + ii*block_size;
+#else
+		char *c_ptr = (char *) work;
+#endif
 
 		// sGamma
 		for(jj=0; jj<T1; jj++)
@@ -1056,7 +1171,6 @@ void d_part_cond_rhs_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *
 		d_cond_rq_libstr(T1-1, &nx[N_tmp], &nu[N_tmp], &hsBAbt[N_tmp], &hsb[N_tmp], &hsrq[N_tmp], &hsL[N_tmp], hsGammab, &hsrq2[ii], (void *) c_ptr, work_space_sizes);
 
 		d_cond_d_libstr(T1-1, &nx[N_tmp], &nu[N_tmp], &nb[N_tmp], &hidxb[N_tmp], &ng[N_tmp], &hsDCt[N_tmp], &hsd[N_tmp], hsGammab, &hsd2[ii], (void *) c_ptr);
-		N_tmp += T1;
 //exit(1);
 		}
 	
@@ -1091,6 +1205,11 @@ int d_part_expand_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb,
 
 	size = (size + 63) / 64 * 64; // make multiple of (typical) cache line size
 
+#if defined(_OPENMP)
+	// blocks are expanded concurrently: one work space per block, at most N blocks
+	size *= N;
+#endif
+
 	return size;
 
 	}
@@ -1100,31 +1219,46 @@ int d_part_expand_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb,
 void d_part_expand_solution_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, int N2, int *nx2, int *nu2, int *nb2, int **hidxb2, int *ng2, struct blasfeo_dvec *hsux2, struct blasfeo_dvec *hspi2, struct blasfeo_dvec *hslam2, struct blasfeo_dvec *hst2, void *work_space, int *work_space_sizes)
 	{
 
-	int ii, jj, ll;
-
-	int nu0, nx0, nx1, nb0, ng0, nt0, nt2;
-
-	struct blasfeo_dvec workvec[2];
-
-	double *ptr_work0, *ptr_work1, *ptr_lam, *ptr_t, *ptr_lam2, *ptr_t2;
-
-	char *c_ptr[2];
-	c_ptr[0] = (char *) work_space;
-	c_ptr[1] = c_ptr[0] + work_space_sizes[0];
+	int ii;
 
 	int N1 = N/N2; // (floor) horizon of small blocks
 	int R1 = N - N2*N1; // the first R1 blocks have horizion N1+1
 	int M1 = R1>0 ? N1+1 : N1; // (ceil) horizon of large blocks
-	int T1; // horizon of current block
-	int N_tmp, nu_tmp;
-	int nbb2, nbg2, ngg2;
-	int stg;
 
-	// inputs & initial states
-	N_tmp = 0;
+#if defined(_OPENMP)
+	int block_size = (work_space_sizes[0] + work_space_sizes[1] + 63) / 64 * 64;
+#endif
+
+	// the blocks are independent
+#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic)
+#endif
 	for(ii=0; ii<N2; ii++)
 		{
-		T1 = ii<R1 ? M1 : N1;
+
+		int jj, ll;
+
+		int nu0, nx0, nx1, nb0, ng0, nt0, nt2;
+
+		struct blasfeo_dvec workvec[2];
+
+		double *ptr_work0, *ptr_work1, *ptr_lam, *ptr_t, *ptr_lam2, *ptr_t2;
+
+		char *c_ptr[2];
+#if defined(_OPENMP)
+		c_ptr[0] = (char *) work_space + ii*block_size;
+#else
+		c_ptr[0] = (char *) work_space;
+#endif
+		c_ptr[1] = c_ptr[0] + work_space_sizes[0];
+
+		int T1 = ii<R1 ? M1 : N1; // horizon of current block
+		int N_tmp = ii*N1 + (ii<R1 ? ii : R1); // first stage of current block
+		int nu_tmp;
+		int nbb2, nbg2, ngg2;
+		int stg;
+
+		// inputs & initial states
 		nu_tmp = 0;
 		// final stages: copy only input
 		for(jj=0; jj<T1-1; jj++)
@@ -1134,35 +1268,20 @@ void d_part_expand_solution_libstr(int N, int *nx, int *nu, int *nb, int **hidxb
 			}
 		// first stage: copy input and state
 		blasfeo_dveccp(nu[N_tmp+0]+nx[N_tmp+0], &hsux2[ii], nu_tmp, &hsux[N_tmp+0], 0);
-		//
-		N_tmp += T1;
-		}
-	// no last stage
 
-	// compute missing states by simulation within each block
-	N_tmp = 0;
-	for(ii=0; ii<N2; ii++)
-		{
-		T1 = ii<R1 ? M1 : N1;
+		// compute missing states by simulation within the block
 		for(jj=0; jj<T1-1; jj++) // last stage is already there !!!
 			{
 			blasfeo_dgemv_t(nu[N_tmp+jj]+nx[N_tmp+jj], nx[N_tmp+jj+1], 1.0, &hsBAbt[N_tmp+jj], 0, 0, &hsux[N_tmp+jj], 0, 1.0, &hsb[N_tmp+jj], 0, &hsux[N_tmp+jj+1], nu[N_tmp+jj+1]);
 			}
-		//
-		N_tmp += T1;
-		}
 
-	// slack variables and ineq lagrange multipliers
-	N_tmp = 0;
-	for(ii=0; ii<N2; ii++)
-		{
+		// slack variables and ineq lagrange multipliers
 		ptr_lam2 = hslam2[ii].pa;
 		ptr_t2 = hst2[ii].pa;
 		nbb2 = 0;
 		nbg2 = 0;
 		ngg2 = 0;
 		nt2 = nb2[ii]+ng2[ii];
-		T1 = ii<R1 ? M1 : N1;
 		// final stages
 		for(jj=0; jj<T1-1; jj++)
 			{
@@ -1227,17 +1346,9 @@ void d_part_expand_solution_libstr(int N, int *nx, int *nu, int *nb, int **hidxb
 		blasfeo_dveccp(ng0, &hslam2[ii], nb2[ii]+1*nt2+nbg2+ngg2, &hslam[stg], nb0+1*nt0);
 		blasfeo_dveccp(ng0, &hst2[ii], nb2[ii]+0*nt2+nbg2+ngg2, &hst[stg], nb0+0*nt0);
 		blasfeo_dveccp(ng0, &hst2[ii], nb2[ii]+1*nt2+nbg2+ngg2, &hst[stg], nb0+1*nt0);
-		//
-		N_tmp += T1;
-		}
-	// no last stage
 
-	// lagrange multipliers of equality constraints
-	// TODO avoid to multiply by R and B (i.e. the u part)
-	N_tmp = 0;
-	for(ii=0; ii<N2; ii++)
-		{
-		T1 = ii<R1 ? M1 : N1;
+		// lagrange multipliers of equality constraints
+		// TODO avoid to multiply by R and B (i.e. the u part)
 		// last stage: just copy
 		blasfeo_dveccp(nx[N_tmp+T1], &hspi2[ii+1], 0, &hspi[N_tmp+T1], 0);
 		// middle stages: backward simulation
@@ -1265,8 +1376,9 @@ void d_part_expand_solution_libstr(int N, int *nx, int *nu, int *nb, int **hidxb
 			blasfeo_dgemv_n(nu0+nx0, ng0, 1.0, &hsDCt[stg], 0, 0, &workvec[1], 0, 1.0, &workvec[0], 0, &workvec[0], 0);
 			blasfeo_dveccp(nx0, &workvec[0], nu0,  &hspi[stg], 0);
 			}
-		N_tmp += T1;
+
 		}
+	// no last stage
 
 	return;
 
@@ -1320,6 +1432,7 @@ int d_cond_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int **
 	int nu_tmp;
 
 	int Gamma_size = 0;
+	int DCt_size = 0;
 	work_space_sizes[0] = 0;
 	work_space_sizes[1] = 0;
 	work_space_sizes[2] = 0;
@@ -1364,9 +1477,17 @@ int d_cond_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int **
 		tmp_size = blasfeo_memsize_dvec(nx[1+ii]);
 		work_space_sizes[3] = tmp_size>work_space_sizes[3] ? tmp_size : work_space_sizes[3];
 		}
+
+	// sGammab, sCGammab : 1 => N
+	for(ii=1; ii<=N; ii++)
+		{
+		tmp_size = blasfeo_memsize_dvec(nx[ii]) + blasfeo_memsize_dvec(ng[ii]);
+		DCt_size = tmp_size>DCt_size ? tmp_size : DCt_size;
+		}
 	
 	tmp_size = work_space_sizes[0] + work_space_sizes[1];
 	tmp_size = work_space_sizes[2]+work_space_sizes[3]>tmp_size ? work_space_sizes[2]+work_space_sizes[3] : tmp_size;
+	tmp_size = DCt_size>tmp_size ? DCt_size : tmp_size;
 	int size = Gamma_size+tmp_size;
 	
 	size = (size + 63) / 64 * 64; // make work space multiple of (typical) cache line size
@@ -1438,7 +1559,7 @@ void d_cond_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, struc
 	// TODO avoid copying back BAbt2 !!!!!
 	d_comp_Gamma_libstr(N, nx, nu, hsBAbt, hsGamma);
 
-	d_cond_RSQrq_libstr(N, nx, nu, hsBAbt, hsRSQrq, hsGamma, &hsRSQrq2[0], hsL, (void *) c_ptr, work_space_sizes);
+	d_cond_RSQrq_libstr(N, nx, nu, hsBAbt, hsRSQrq, N, hsGamma, &hsRSQrq2[0], hsL, (void *) c_ptr, work_space_sizes);
 
 	d_cond_DCtd_libstr(N, nx, nu, nb, hidxb, ng, hsDCt, hsd, hsGamma, &hsDCt2[0], &hsd2[0], hidxb2[0], (void *) c_ptr);
 
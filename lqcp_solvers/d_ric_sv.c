@@ -1131,7 +1131,7 @@ void d_ric_eye_sv_mpc(int nx, int nu, int N, double **hpBt, double **hpR, double
 	for(nn=0; nn<N; nn++)
 		{
 		// PB = P*(B')'
-#if defined(TARGET_C99_4X4) || defined(TARGET_C99_4X4_PREFETCH) || defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2)
+#if defined(TARGET_C99_4X4) || defined(TARGET_C99_4X4_PREFETCH) || defined(TARGET_X64_AVX) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 		dgemm_nt_lib(nx, nu, nx, hpP[N-nn], cnx, hpBt[N-nn-1], cnx, 0, pPB, cnu, pPBt, cnx, 0, 1); // TODO embed transpose of result in dgemm_nt
 #else
 		dgemm_nt_lib(nx, nu, nx, hpP[N-nn], cnx, hpBt[N-nn-1], cnx, 0, pPB, cnu, pPB, cnu, 0, 0);
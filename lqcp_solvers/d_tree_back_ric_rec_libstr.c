@@ -38,8 +38,8 @@
 
 
 
-// work space
-int d_tree_back_ric_rec_work_space_size_bytes_libstr(int Nn, struct node *tree, int *nx, int *nu, int *nb, int *ng)
+// work space of a single node
+static int d_tree_back_ric_rec_node_work_space_size_bytes_libstr(int Nn, struct node *tree, int *nx, int *nu, int *nb, int *ng)
 	{
 
 	int ii, jj;
@@ -67,7 +67,26 @@ int d_tree_back_ric_rec_work_space_size_bytes_libstr(int Nn, struct node *tree,
 		}
 
 	size += blasfeo_memsize_dmat(nuxM+1, nxgM); // ric_work_mat[0]
-	size += blasfeo_memsize_dvec(nxM); // ric_work_vec[0]
+	size += blasfeo_memsize_dvec(nxgM); // ric_work_vec[0]
+
+	// make multiple of (typical) cache line size
+	size = (size+63)/64*64;
+
+	return size;
+	}
+
+
+
+// work space
+int d_tree_back_ric_rec_work_space_size_bytes_libstr(int Nn, struct node *tree, int *nx, int *nu, int *nb, int *ng)
+	{
+
+	int size = d_tree_back_ric_rec_node_work_space_size_bytes_libstr(Nn, tree, nx, nu, nb, ng);
+
+#if defined(_OPENMP)
+	// sibling subtrees are processed concurrently: one work space per node
+	size *= Nn;
+#endif
 
 	return size;
 	}
@@ -519,68 +538,81 @@ static void d_back_ric_trs_forw_1_libstr(int nkids, int nx0, int *nx1, int nu0,
 
 
 
-// Riccati recursion routines
+// tree traversal
 
-void d_tree_back_ric_rec_sv_libstr(int Nn, struct node *tree, int *nx, int *nu, int *nb, int **hidxb, int *ng, int update_b, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, int update_rq, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dvec *hsqx, struct blasfeo_dvec *hsux, int compute_pi, struct blasfeo_dvec *hspi, int compute_Pb, struct blasfeo_dvec *hsPb, struct blasfeo_dmat *hsL, void *work)
+// problem data shared by the per-node routines
+struct d_tree_ric_args
+	{
+	struct node *tree;
+	int *nx;
+	int *nu;
+	int *nb;
+	int **hidxb;
+	int *ng;
+	int update_b;
+	struct blasfeo_dmat *hsBAbt;
+	struct blasfeo_dvec *hsb;
+	int update_rq;
+	struct blasfeo_dmat *hsRSQrq;
+	struct blasfeo_dvec *hsrq;
+	struct blasfeo_dmat *hsDCt;
+	struct blasfeo_dvec *hsQx;
+	struct blasfeo_dvec *hsqx;
+	struct blasfeo_dvec *hsux;
+	int compute_pi;
+	struct blasfeo_dvec *hspi;
+	int compute_Pb;
+	struct blasfeo_dvec *hsPb;
+	struct blasfeo_dmat *hsL;
+	char *work;
+	int work_size; // work space size of a node, 0 if all nodes share the same one
+	};
+
+
+
+static void d_tree_ric_init_args(int Nn, struct node *tree, int *nx, int *nu, int *nb, int **hidxb, int *ng, void *work, struct d_tree_ric_args *arg)
 	{
 
-	int nn, ii;
+	arg->tree = tree;
+	arg->nx = nx;
+	arg->nu = nu;
+	arg->nb = nb;
+	arg->hidxb = hidxb;
+	arg->ng = ng;
+	arg->work = (char *) work;
+#if defined(_OPENMP)
+	arg->work_size = d_tree_back_ric_rec_node_work_space_size_bytes_libstr(Nn, tree, nx, nu, nb, ng);
+#else
+	arg->work_size = 0;
+#endif
 
-	int nkids, idxkid, dad;
+	return;
 
-	struct blasfeo_dmat hswork_mat_0;
+	}
 
-	// factorization and backward substitution
 
-	// process one node at the time, starting from the last one
-	for(nn=Nn-1; nn>=0; nn--)
-		{
 
-		nkids = tree[nn].nkids;
+typedef void (*d_tree_ric_node_fun)(int nn, struct d_tree_ric_args *arg);
 
-		if(nkids==0) // has no kids: last stage
-			{
-			d_back_ric_sv_back_N_libstr(nx[nn], nu[nn], nb[nn], hidxb[nn], ng[nn], update_rq, &hsRSQrq[nn], &hsrq[nn], &hsDCt[nn], &hsQx[nn], &hsqx[nn], &hsL[nn], work);
-			}
-		else // has at least one kid
-			{
-			idxkid = tree[nn].kids[0];
-			d_back_ric_sv_back_1_libstr(nkids, nx[nn], &nx[idxkid], nu[nn], &nu[idxkid], nb[nn], hidxb[nn], ng[nn], update_b, &hsBAbt[idxkid-1], &hsb[idxkid-1], update_rq, &hsRSQrq[nn], &hsrq[nn], &hsDCt[nn], &hsQx[nn], &hsqx[nn], compute_Pb, &hsPb[idxkid], &hsL[nn], &hsL[idxkid], work);
-			}
-		}
 
-	// forward substitution
 
-	// process one node at the time, starting from the first one
-	for(nn=0; nn<Nn; nn++)
+#if defined(_OPENMP)
+// the kids are processed as concurrent tasks before their dad
+static void d_tree_ric_back_task(int nn, d_tree_ric_node_fun fun, struct d_tree_ric_args *arg)
+	{
+
+	int ii;
+
+	int nkids = arg->tree[nn].nkids;
+
+	for(ii=0; ii<nkids; ii++)
 		{
-		dad = tree[nn].dad;
-		nkids = tree[nn].nkids;
-		if(dad<0) // root
-			{
-			if(nkids>0) // has kids
-				{
-				idxkid = tree[nn].kids[0];
-				d_back_ric_sv_forw_0_libstr(nkids, nx[nn], &nx[idxkid], nu[nn], &nu[idxkid], &hsBAbt[idxkid-1], &hsL[nn], &hsL[idxkid], &hsux[nn], &hsux[idxkid], compute_pi, &hspi[idxkid], work);
-				}
-			else // no kids
-				{
-				// TODO
-				}
-			}
-		else // kids
-			{
-			if(nkids>0) // has kids
-				{
-				idxkid = tree[nn].kids[0];
-				d_back_ric_sv_forw_1_libstr(nkids, nx[nn], &nx[idxkid], nu[nn], &nu[idxkid], &hsBAbt[idxkid-1], &hsL[nn], &hsL[idxkid], &hsux[nn], &hsux[idxkid], compute_pi, &hspi[idxkid], work);
-				}
-			else // has no kids: last stage
-				{
-				// nothing to do
-				}
-			}
+		#pragma omp task if(nkids>1)
+		d_tree_ric_back_task(arg->tree[nn].kids[ii], fun, arg);
 		}
+	#pragma omp taskwait
+
+	fun(nn, arg);
 
 	return;
 
@@ -588,33 +620,125 @@ void d_tree_back_ric_rec_sv_libstr(int Nn, struct node *tree, int *nx, int *nu,
 
 
 
-void d_tree_back_ric_rec_trf_libstr(int Nn, struct node *tree, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dmat *hsL, void *work)
+// the kids are processed as concurrent tasks after their dad
+static void d_tree_ric_forw_task(int nn, d_tree_ric_node_fun fun, struct d_tree_ric_args *arg)
 	{
 
-	int nn, ii;
+	int ii;
 
-	int nkids, idxkid;
+	int nkids = arg->tree[nn].nkids;
 
-	struct blasfeo_dmat hswork_mat_0;
+	fun(nn, arg);
 
-	// factorization
+	for(ii=0; ii<nkids; ii++)
+		{
+		#pragma omp task if(nkids>1)
+		d_tree_ric_forw_task(arg->tree[nn].kids[ii], fun, arg);
+		}
 
+	return;
+
+	}
+#endif
+
+
+
+// process all nodes, each one after its kids
+static void d_tree_ric_back_sweep(int Nn, d_tree_ric_node_fun fun, struct d_tree_ric_args *arg)
+	{
+
+#if defined(_OPENMP)
+	#pragma omp parallel
+	{
+	#pragma omp single nowait
+	d_tree_ric_back_task(0, fun, arg);
+	}
+#else
+	int nn;
 	// process one node at the time, starting from the last one
 	for(nn=Nn-1; nn>=0; nn--)
+		fun(nn, arg);
+#endif
+
+	return;
+
+	}
+
+
+
+// process all nodes, each one before its kids
+static void d_tree_ric_forw_sweep(int Nn, d_tree_ric_node_fun fun, struct d_tree_ric_args *arg)
+	{
+
+#if defined(_OPENMP)
+	#pragma omp parallel
+	{
+	#pragma omp single nowait
+	d_tree_ric_forw_task(0, fun, arg);
+	}
+#else
+	int nn;
+	// process one node at the time, starting from the first one
+	for(nn=0; nn<Nn; nn++)
+		fun(nn, arg);
+#endif
+
+	return;
+
+	}
+
+
+
+// per-node routines
+
+static void d_tree_ric_sv_back_node(int nn, struct d_tree_ric_args *arg)
+	{
+
+	int *nx = arg->nx;
+	int *nu = arg->nu;
+	int *nb = arg->nb;
+	int *ng = arg->ng;
+	void *work = arg->work + nn*arg->work_size;
+
+	int nkids = arg->tree[nn].nkids;
+	int idxkid;
+
+	if(nkids==0) // has no kids: last stage
 		{
+		d_back_ric_sv_back_N_libstr(nx[nn], nu[nn], nb[nn], arg->hidxb[nn], ng[nn], arg->update_rq, &arg->hsRSQrq[nn], &arg->hsrq[nn], &arg->hsDCt[nn], &arg->hsQx[nn], &arg->hsqx[nn], &arg->hsL[nn], work);
+		}
+	else // has at least one kid
+		{
+		idxkid = arg->tree[nn].kids[0];
+		d_back_ric_sv_back_1_libstr(nkids, nx[nn], &nx[idxkid], nu[nn], &nu[idxkid], nb[nn], arg->hidxb[nn], ng[nn], arg->update_b, &arg->hsBAbt[idxkid-1], &arg->hsb[idxkid-1], arg->update_rq, &arg->hsRSQrq[nn], &arg->hsrq[nn], &arg->hsDCt[nn], &arg->hsQx[nn], &arg->hsqx[nn], arg->compute_Pb, &arg->hsPb[idxkid], &arg->hsL[nn], &arg->hsL[idxkid], work);
+		}
 
-		nkids = tree[nn].nkids;
+	return;
 
-		if(nkids==0) // has no kids: last stage
-			{
-			d_back_ric_trf_N_libstr(nx[nn], nu[nn], nb[nn], hidxb[nn], ng[nn], &hsRSQrq[nn], &hsDCt[nn], &hsQx[nn], &hsL[nn], work);
-			}
-		else // has at least one kid
-			{
-			idxkid = tree[nn].kids[0];
-			d_back_ric_trf_1_libstr(nkids, nx[nn], &nx[idxkid], nu[nn], &nu[idxkid], nb[nn], hidxb[nn], ng[nn], &hsBAbt[idxkid-1], &hsRSQrq[nn], &hsDCt[nn], &hsQx[nn], &hsL[nn], &hsL[idxkid], work);
-			}
+	}
+
+
+
+static void d_tree_ric_sv_forw_node(int nn, struct d_tree_ric_args *arg)
+	{
+
+	int *nx = arg->nx;
+	int *nu = arg->nu;
+	void *work = arg->work + nn*arg->work_size;
+
+	int dad = arg->tree[nn].dad;
+	int nkids = arg->tree[nn].nkids;
+	int idxkid;
+
+	if(nkids>0) // has kids
+		{
+		idxkid = arg->tree[nn].kids[0];
+		if(dad<0) // root
+			d_back_ric_sv_forw_0_libstr(nkids, nx[nn], &nx[idxkid], nu[nn], &nu[idxkid], &arg->hsBAbt[idxkid-1], &arg->hsL[nn], &arg->hsL[idxkid], &arg->hsux[nn], &arg->hsux[idxkid], arg->compute_pi, &arg->hspi[idxkid], work);
+		else
+			d_back_ric_sv_forw_1_libstr(nkids, nx[nn], &nx[idxkid], nu[nn], &nu[idxkid], &arg->hsBAbt[idxkid-1], &arg->hsL[nn], &arg->hsL[idxkid], &arg->hsux[nn], &arg->hsux[idxkid], arg->compute_pi, &arg->hspi[idxkid], work);
 		}
+	// else: root without kids TODO, last stage nothing to do
 
 	return;
 
@@ -622,78 +746,172 @@ void d_tree_back_ric_rec_trf_libstr(int Nn, struct node *tree, int *nx, int *nu,
 
 
 
-void d_tree_back_ric_rec_trs_libstr(int Nn, struct node *tree, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsqx, struct blasfeo_dvec *hsux, int compute_pi, struct blasfeo_dvec *hspi, int compute_Pb, struct blasfeo_dvec *hsPb, struct blasfeo_dmat *hsL, void *work)
+static void d_tree_ric_trf_node(int nn, struct d_tree_ric_args *arg)
 	{
 
-	int nn;
+	int *nx = arg->nx;
+	int *nu = arg->nu;
+	int *nb = arg->nb;
+	int *ng = arg->ng;
+	void *work = arg->work + nn*arg->work_size;
 
-	int dad, nkids, idxkid;
+	int nkids = arg->tree[nn].nkids;
+	int idxkid;
 
-	// backward substitution
+	if(nkids==0) // has no kids: last stage
+		{
+		d_back_ric_trf_N_libstr(nx[nn], nu[nn], nb[nn], arg->hidxb[nn], ng[nn], &arg->hsRSQrq[nn], &arg->hsDCt[nn], &arg->hsQx[nn], &arg->hsL[nn], work);
+		}
+	else // has at least one kid
+		{
+		idxkid = arg->tree[nn].kids[0];
+		d_back_ric_trf_1_libstr(nkids, nx[nn], &nx[idxkid], nu[nn], &nu[idxkid], nb[nn], arg->hidxb[nn], ng[nn], &arg->hsBAbt[idxkid-1], &arg->hsRSQrq[nn], &arg->hsDCt[nn], &arg->hsQx[nn], &arg->hsL[nn], &arg->hsL[idxkid], work);
+		}
 
-	// process one node at the time, starting from the last one
-	for(nn=Nn-1; nn>=0; nn--)
+	return;
+
+	}
+
+
+
+static void d_tree_ric_trs_back_node(int nn, struct d_tree_ric_args *arg)
+	{
+
+	int *nx = arg->nx;
+	int *nu = arg->nu;
+	int *nb = arg->nb;
+	int *ng = arg->ng;
+	void *work = arg->work + nn*arg->work_size;
+
+	int dad = arg->tree[nn].dad;
+	int nkids = arg->tree[nn].nkids;
+	int idxkid;
+
+	if(nkids>0) // has kids
 		{
-		dad = tree[nn].dad;
-		nkids = tree[nn].nkids;
+		idxkid = arg->tree[nn].kids[0];
 		if(dad<0) // root
-			{
-			if(nkids>0) // has kids
-				{
-				idxkid = tree[nn].kids[0];
-				d_back_ric_trs_back_0_libstr(nkids, nx[nn], &nx[idxkid], nu[nn], &nu[idxkid], nb[nn], hidxb[nn], ng[nn], &hsBAbt[idxkid-1], &hsb[idxkid-1], &hsrq[nn], &hsDCt[nn], &hsqx[nn], &hsL[nn], &hsL[idxkid], compute_Pb, &hsPb[idxkid], &hsux[nn], &hsux[idxkid], work);
-				}
-			else // has no kids: last stage
-				{
-				// TODO
-				}
-			}
-		else // kid
-			{
-			if(nkids>0) // has kids
-				{
-				idxkid = tree[nn].kids[0];
-				d_back_ric_trs_back_1_libstr(nkids, nx[nn], &nx[idxkid], nu[nn], &nu[idxkid], nb[nn], hidxb[nn], ng[nn], &hsBAbt[idxkid-1], &hsb[idxkid-1], &hsrq[nn], &hsDCt[nn], &hsqx[nn], &hsL[nn], &hsL[idxkid], compute_Pb, &hsPb[idxkid], &hsux[nn], &hsux[idxkid], work);
-				}
-			else // has no kids: last stage
-				{
-				d_back_ric_trs_back_N_libstr(nx[nn], nu[nn], nb[nn], hidxb[nn], ng[nn], &hsrq[nn], &hsDCt[nn], &hsqx[nn], &hsux[nn]);
-				}
-			}
+			d_back_ric_trs_back_0_libstr(nkids, nx[nn], &nx[idxkid], nu[nn], &nu[idxkid], nb[nn], arg->hidxb[nn], ng[nn], &arg->hsBAbt[idxkid-1], &arg->hsb[idxkid-1], &arg->hsrq[nn], &arg->hsDCt[nn], &arg->hsqx[nn], &arg->hsL[nn], &arg->hsL[idxkid], arg->compute_Pb, &arg->hsPb[idxkid], &arg->hsux[nn], &arg->hsux[idxkid], work);
+		else
+			d_back_ric_trs_back_1_libstr(nkids, nx[nn], &nx[idxkid], nu[nn], &nu[idxkid], nb[nn], arg->hidxb[nn], ng[nn], &arg->hsBAbt[idxkid-1], &arg->hsb[idxkid-1], &arg->hsrq[nn], &arg->hsDCt[nn], &arg->hsqx[nn], &arg->hsL[nn], &arg->hsL[idxkid], arg->compute_Pb, &arg->hsPb[idxkid], &arg->hsux[nn], &arg->hsux[idxkid], work);
 		}
+	else if(dad>=0) // has no kids: last stage
+		{
+		d_back_ric_trs_back_N_libstr(nx[nn], nu[nn], nb[nn], arg->hidxb[nn], ng[nn], &arg->hsrq[nn], &arg->hsDCt[nn], &arg->hsqx[nn], &arg->hsux[nn]);
+		}
+	// else: root without kids TODO
 
-	// forward substitution
+	return;
 
-	// process one node at the time, starting from the first one
-	for(nn=0; nn<Nn; nn++)
+	}
+
+
+
+static void d_tree_ric_trs_forw_node(int nn, struct d_tree_ric_args *arg)
+	{
+
+	int *nx = arg->nx;
+	int *nu = arg->nu;
+	void *work = arg->work + nn*arg->work_size;
+
+	int dad = arg->tree[nn].dad;
+	int nkids = arg->tree[nn].nkids;
+	int idxkid;
+
+	if(nkids>0) // has kids
 		{
-		dad = tree[nn].dad;
-		nkids = tree[nn].nkids;
+		idxkid = arg->tree[nn].kids[0];
 		if(dad<0) // root
-			{
-			if(nkids>0) // has kids
-				{
-				idxkid = tree[nn].kids[0];
-				d_back_ric_trs_forw_0_libstr(nkids, nx[nn], &nx[idxkid], nu[nn], &nu[idxkid], &hsBAbt[idxkid-1], &hsb[idxkid-1], &hsL[nn], &hsL[idxkid], &hsux[nn], &hsux[idxkid], compute_pi, &hspi[idxkid], work);
-				}
-			else // no kids
-				{
-				// TODO
-				}
-			}
-		else // kids
-			{
-			if(nkids>0) // has kids
-				{
-				idxkid = tree[nn].kids[0];
-				d_back_ric_trs_forw_1_libstr(nkids, nx[nn], &nx[idxkid], nu[nn], &nu[idxkid], &hsBAbt[idxkid-1], &hsb[idxkid-1], &hsL[nn], &hsL[idxkid], &hsux[nn], &hsux[idxkid], compute_pi, &hspi[idxkid], work);
-				}
-			else // has no kids: last stage
-				{
-				// nothing to do
-				}
-			}
+			d_back_ric_trs_forw_0_libstr(nkids, nx[nn], &nx[idxkid], nu[nn], &nu[idxkid], &arg->hsBAbt[idxkid-1], &arg->hsb[idxkid-1], &arg->hsL[nn], &arg->hsL[idxkid], &arg->hsux[nn], &arg->hsux[idxkid], arg->compute_pi, &arg->hspi[idxkid], work);
+		else
+			d_back_ric_trs_forw_1_libstr(nkids, nx[nn], &nx[idxkid], nu[nn], &nu[idxkid], &arg->hsBAbt[idxkid-1], &arg->hsb[idxkid-1], &arg->hsL[nn], &arg->hsL[idxkid], &arg->hsux[nn], &arg->hsux[idxkid], arg->compute_pi, &arg->hspi[idxkid], work);
 		}
+	// else: root without kids TODO, last stage nothing to do
+
+	return;
+
+	}
+
+
+
+// Riccati recursion routines
+// if the library is built with OpenMP, sibling subtrees are processed concurrently as tasks
+
+void d_tree_back_ric_rec_sv_libstr(int Nn, struct node *tree, int *nx, int *nu, int *nb, int **hidxb, int *ng, int update_b, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, int update_rq, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dvec *hsqx, struct blasfeo_dvec *hsux, int compute_pi, struct blasfeo_dvec *hspi, int compute_Pb, struct blasfeo_dvec *hsPb, struct blasfeo_dmat *hsL, void *work)
+	{
+
+	struct d_tree_ric_args arg;
+	d_tree_ric_init_args(Nn, tree, nx, nu, nb, hidxb, ng, work, &arg);
+	arg.update_b = update_b;
+	arg.hsBAbt = hsBAbt;
+	arg.hsb = hsb;
+	arg.update_rq = update_rq;
+	arg.hsRSQrq = hsRSQrq;
+	arg.hsrq = hsrq;
+	arg.hsDCt = hsDCt;
+	arg.hsQx = hsQx;
+	arg.hsqx = hsqx;
+	arg.hsux = hsux;
+	arg.compute_pi = compute_pi;
+	arg.hspi = hspi;
+	arg.compute_Pb = compute_Pb;
+	arg.hsPb = hsPb;
+	arg.hsL = hsL;
+
+	// factorization and backward substitution
+	d_tree_ric_back_sweep(Nn, &d_tree_ric_sv_back_node, &arg);
+
+	// forward substitution
+	d_tree_ric_forw_sweep(Nn, &d_tree_ric_sv_forw_node, &arg);
+
+	return;
+
+	}
+
+
+
+void d_tree_back_ric_rec_trf_libstr(int Nn, struct node *tree, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dmat *hsL, void *work)
+	{
+
+	struct d_tree_ric_args arg;
+	d_tree_ric_init_args(Nn, tree, nx, nu, nb, hidxb, ng, work, &arg);
+	arg.hsBAbt = hsBAbt;
+	arg.hsRSQrq = hsRSQrq;
+	arg.hsDCt = hsDCt;
+	arg.hsQx = hsQx;
+	arg.hsL = hsL;
+
+	// factorization
+	d_tree_ric_back_sweep(Nn, &d_tree_ric_trf_node, &arg);
+
+	return;
+
+	}
+
+
+
+void d_tree_back_ric_rec_trs_libstr(int Nn, struct node *tree, int *nx, int *nu, int *nb, int **hidxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsqx, struct blasfeo_dvec *hsux, int compute_pi, struct blasfeo_dvec *hspi, int compute_Pb, struct blasfeo_dvec *hsPb, struct blasfeo_dmat *hsL, void *work)
+	{
+
+	struct d_tree_ric_args arg;
+	d_tree_ric_init_args(Nn, tree, nx, nu, nb, hidxb, ng, work, &arg);
+	arg.hsBAbt = hsBAbt;
+	arg.hsb = hsb;
+	arg.hsrq = hsrq;
+	arg.hsDCt = hsDCt;
+	arg.hsqx = hsqx;
+	arg.hsux = hsux;
+	arg.compute_pi = compute_pi;
+	arg.hspi = hspi;
+	arg.compute_Pb = compute_Pb;
+	arg.hsPb = hsPb;
+	arg.hsL = hsL;
+
+	// backward substitution
+	d_tree_ric_back_sweep(Nn, &d_tree_ric_trs_back_node, &arg);
+
+	// forward substitution
+	d_tree_ric_forw_sweep(Nn, &d_tree_ric_trs_forw_node, &arg);
 
 	return;
 
@@ -0,0 +1,75 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+
+#include "../include/blas_s.h"
+#include "../include/block_size.h"
+
+
+
+// residuals of the unconstrained MPC problem (pi[ii+1] is the multiplier of the ii-th dynamics)
+void s_res_mpc(int nx, int nu, int N, float **hpBAbt, float **hpQ, float **hq, float **hux, float **hpi, float **hrq, float **hrb)
+	{
+
+	const int bs = S_MR;
+	const int ncl = S_NCL;
+
+	const int nz = nx+nu+1;
+	const int cnz = ncl*((nz+ncl-1)/ncl);
+	const int cnx = ncl*((nx+ncl-1)/ncl);
+
+	const int nux = nu+nx;
+	const int row_b = (nux/bs)*bs*cnx+nux%bs; // row of b in BAbt
+
+	int ii, jj;
+
+	// first and middle stages
+	for(ii=0; ii<N; ii++)
+		{
+		for(jj=0; jj<nu; jj++)
+			hrq[ii][jj] = - hq[ii][jj];
+		if(ii>0)
+			for(jj=0; jj<nx; jj++)
+				hrq[ii][nu+jj] = hpi[ii][jj] - hq[ii][nu+jj];
+		else
+			for(jj=0; jj<nx; jj++)
+				hrq[ii][nu+jj] = - hq[ii][nu+jj];
+		ssymv_lib(nux, 0, hpQ[ii], cnz, hux[ii], hrq[ii], -1);
+		sgemv_n_lib(nux, nx, hpBAbt[ii], cnx, hpi[ii+1], hrq[ii], -1);
+
+		for(jj=0; jj<nx; jj++)
+			hrb[ii][jj] = hux[ii+1][nu+jj] - hpBAbt[ii][row_b+jj*bs];
+		sgemv_t_lib(nux, nx, 0, hpBAbt[ii], cnx, hux[ii], hrb[ii], -1);
+		}
+
+	// last stage
+	for(jj=0; jj<nu; jj++)
+		hrq[N][jj] = 0.0;
+	for(jj=0; jj<nx; jj++)
+		hrq[N][nu+jj] = hpi[N][jj] - hq[N][nu+jj];
+	ssymv_lib(nx, nu, hpQ[N]+(nu/bs)*bs*cnz+nu%bs+nu*bs, cnz, hux[N]+nu, hrq[N]+nu, -1);
+
+	}
@@ -0,0 +1,182 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "../include/aux_s.h"
+#include "../include/blas_s.h"
+#include "../include/block_size.h"
+
+
+
+/* layout of hpL[ii] (pnz x cnl, panel-major with sda=cnl):                        */
+/* columns [0, nx)             : BAbt * Lxx of the following stage                 */
+/* columns [nx+pad, ...)       : Cholesky factor of the stage Hessian, last row l  */
+/* rows [0,nx), col nx+pad+ncl : Lxx' (upper triangular), in the unused upper part */
+
+// Riccati recursion: factorization and solution
+void s_ric_sv_mpc(int nx, int nu, int N, float **hpBAbt, float **hpQ, float **hux, float **hpL, float *work, float *diag, int compute_pi, float **hpi)
+	{
+
+	const int bs = S_MR;
+	const int ncl = S_NCL;
+
+	const int nz = nx+nu+1;
+	const int cnz = ncl*((nz+ncl-1)/ncl);
+	const int cnx = ncl*((nx+ncl-1)/ncl);
+	const int pad = (ncl-nx%ncl)%ncl; // packing between BAbtL & P
+	const int cnl = cnz<cnx+ncl ? nx+pad+cnx+ncl : nx+pad+cnz;
+
+	const int nux = nu+nx;
+	const int row_l = (nux/bs)*bs*cnl+nux%bs; // row of the gradient in the factor
+	const int row_b = (nux/bs)*bs*cnx+nux%bs; // row of b in BAbt
+
+	int ii, jj, ll;
+
+	float *ptr, *ptr_l;
+
+	// last stage: factorize the state block of Q_N
+	for(ll=0; ll<=nx; ll++)
+		for(jj=0; jj<nx; jj++)
+			hpL[N][(ll/bs)*bs*cnl+ll%bs+jj*bs] = hpQ[N][((nu+ll)/bs)*bs*cnz+(nu+ll)%bs+(nu+jj)*bs];
+	ssyrk_spotrf_lib(nx+1, nx, 0, hpL[N]+(nx+pad)*bs, cnl, hpL[N], cnl, diag);
+	strtr_l_lib(nx, 0, hpL[N]+(nx+pad)*bs, cnl, hpL[N]+(nx+pad+ncl)*bs, cnl);
+	ptr_l = hpL[N]+(nx+pad)*bs+(nx/bs)*bs*cnl+nx%bs;
+
+	// middle stages
+	for(ii=N-1; ii>=0; ii--)
+		{
+		// BAbt * Lxx, plus l_x in the last row
+		strmm_lib(nz, nx, hpBAbt[ii], cnx, hpL[ii+1]+(nx+pad+ncl)*bs, cnl, hpL[ii], cnl);
+		for(jj=0; jj<nx; jj++)
+			hpL[ii][row_l+jj*bs] += ptr_l[jj*bs];
+
+		ptr = hpL[ii]+(nx+pad)*bs;
+		if(ii>0)
+			{
+			ssyrk_spotrf_lib(nz, nux, nx, hpL[ii], cnl, hpQ[ii], cnz, diag);
+			// the triangular solves want the inverted diagonal of the u block
+			for(jj=0; jj<nu; jj++)
+				ptr[(jj/bs)*bs*cnl+jj%bs+jj*bs] = diag[jj];
+			strtr_l_lib(nx, nu, ptr+(nu/bs)*bs*cnl+nu%bs+nu*bs, cnl, hpL[ii]+(nx+pad+ncl)*bs, cnl);
+			ptr_l = ptr+row_l+nu*bs;
+			}
+		else
+			{
+			ssyrk_spotrf_lib(nz, nu, nx, hpL[ii], cnl, hpQ[ii], cnz, diag);
+			for(jj=0; jj<nu; jj++)
+				ptr[(jj/bs)*bs*cnl+jj%bs+jj*bs] = diag[jj];
+			}
+		}
+
+	// forward substitution
+	for(ii=0; ii<N; ii++)
+		{
+		ptr = hpL[ii]+(nx+pad)*bs;
+		for(jj=0; jj<nu; jj++)
+			hux[ii][jj] = - ptr[row_l+jj*bs];
+		strsv_sgemv_t_lib(nu, nux, ptr, cnl, hux[ii]);
+		for(jj=0; jj<nx; jj++)
+			hux[ii+1][nu+jj] = hpBAbt[ii][row_b+jj*bs];
+		sgemv_t_lib(nux, nx, 0, hpBAbt[ii], cnx, hux[ii], hux[ii+1]+nu, 1);
+		if(compute_pi)
+			{
+			// pi = Lxx * (Lxx' * x + l_x)
+			if(ii<N-1)
+				ptr_l = hpL[ii+1]+(nx+pad)*bs+row_l+nu*bs;
+			else
+				ptr_l = hpL[N]+(nx+pad)*bs+(nx/bs)*bs*cnl+nx%bs;
+			strmv_u_n_lib(nx, hpL[ii+1]+(nx+pad+ncl)*bs, cnl, hux[ii+1]+nu, work, 0);
+			for(jj=0; jj<nx; jj++)
+				work[jj] += ptr_l[jj*bs];
+			strmv_u_t_lib(nx, hpL[ii+1]+(nx+pad+ncl)*bs, cnl, work, hpi[ii+1], 0);
+			}
+		}
+
+	}
+
+
+
+// Riccati recursion: solution for a new gradient hq (overwritten)
+void s_ric_trs_mpc(int nx, int nu, int N, float **hpBAbt, float **hpL, float **hq, float **hux, float *work, int compute_Pb, float **hPb, int compute_pi, float **hpi)
+	{
+
+	const int bs = S_MR;
+	const int ncl = S_NCL;
+	const int nal = bs*ncl;
+
+	const int nz = nx+nu+1;
+	const int anz = nal*((nz+nal-1)/nal);
+	const int cnz = ncl*((nz+ncl-1)/ncl);
+	const int cnx = ncl*((nx+ncl-1)/ncl);
+	const int pad = (ncl-nx%ncl)%ncl; // packing between BAbtL & P
+	const int cnl = cnz<cnx+ncl ? nx+pad+cnx+ncl : nx+pad+cnz;
+
+	const int nux = nu+nx;
+	const int row_b = (nux/bs)*bs*cnx+nux%bs; // row of b in BAbt
+
+	int ii, jj;
+
+	float *ptr;
+
+	// backward substitution
+	for(ii=N-1; ii>=0; ii--)
+		{
+		ptr = hpL[ii+1]+(nx+pad+ncl)*bs;
+		if(compute_Pb)
+			{
+			for(jj=0; jj<nx; jj++)
+				work[jj] = hpBAbt[ii][row_b+jj*bs];
+			strmv_u_n_lib(nx, ptr, cnl, work, work+anz, 0);
+			strmv_u_t_lib(nx, ptr, cnl, work+anz, hPb[ii], 0);
+			}
+		for(jj=0; jj<nx; jj++)
+			work[jj] = hPb[ii][jj] + hq[ii+1][nu+jj];
+		sgemv_n_lib(nux, nx, hpBAbt[ii], cnx, work, hq[ii], 1);
+		strsv_sgemv_n_lib(nu, nux, hpL[ii]+(nx+pad)*bs, cnl, hq[ii]);
+		}
+
+	// forward substitution
+	for(ii=0; ii<N; ii++)
+		{
+		for(jj=0; jj<nu; jj++)
+			hux[ii][jj] = - hq[ii][jj];
+		strsv_sgemv_t_lib(nu, nux, hpL[ii]+(nx+pad)*bs, cnl, hux[ii]);
+		for(jj=0; jj<nx; jj++)
+			hux[ii+1][nu+jj] = hpBAbt[ii][row_b+jj*bs];
+		sgemv_t_lib(nux, nx, 0, hpBAbt[ii], cnx, hux[ii], hux[ii+1]+nu, 1);
+		if(compute_pi)
+			{
+			// pi = Lxx * Lxx' * x + p
+			ptr = hpL[ii+1]+(nx+pad+ncl)*bs;
+			strmv_u_n_lib(nx, ptr, cnl, hux[ii+1]+nu, work, 0);
+			strmv_u_t_lib(nx, ptr, cnl, work, hpi[ii+1], 0);
+			for(jj=0; jj<nx; jj++)
+				hpi[ii+1][jj] += hq[ii+1][nu+jj];
+			}
+		}
+
+	}
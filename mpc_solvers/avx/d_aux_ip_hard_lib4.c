@@ -1018,7 +1018,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			v_pi  = _mm256_load_pd( &ptr_pi[ll] );
 			v_dpi = _mm256_load_pd( &ptr_dpi[ll] );
 			v_dpi = _mm256_sub_pd( v_dpi, v_pi );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_pi  = _mm256_fmadd_pd( v_alpha, v_dpi, v_pi );
 #else
 			v_dpi = _mm256_mul_pd( v_alpha, v_dpi );
@@ -1036,7 +1036,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			v_pi  = _mm256_load_pd( &ptr_pi[ll] );
 			v_dpi = _mm256_load_pd( &ptr_dpi[ll] );
 			v_dpi = _mm256_sub_pd( v_dpi, v_pi );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_pi  = _mm256_fmadd_pd( v_alpha, v_dpi, v_pi );
 #else
 			v_dpi = _mm256_mul_pd( v_alpha, v_dpi );
@@ -1062,7 +1062,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[pnb+ll] );
 			v_dux   = _mm256_sub_pd( v_dux, v_ux );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -1085,7 +1085,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			_mm256_store_pd( &ptr_lam[ll], v_lam0 );
 			_mm256_store_pd( &ptr_lam[pnb+ll], v_lam1 );
 			_mm256_store_pd( &ptr_ux[ll], v_ux );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
 			v_mu1   = _mm256_fmadd_pd( v_lam1, v_t1, v_mu1 );
 #else
@@ -1114,7 +1114,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[pnb+ll] );
 			v_dux   = _mm256_sub_pd( v_dux, v_ux );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -1137,7 +1137,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			_mm256_maskstore_pd( &ptr_lam[ll], i_mask, v_lam0 );
 			_mm256_maskstore_pd( &ptr_lam[pnb+ll], i_mask, v_lam1 );
 			_mm256_maskstore_pd( &ptr_ux[ll], i_mask, v_ux );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_lam0  = _mm256_blendv_pd( v_zeros, v_lam0, v_mask );
 			v_lam1  = _mm256_blendv_pd( v_zeros, v_lam1, v_mask );
 			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
@@ -1161,7 +1161,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 				v_ux  = _mm256_load_pd( &ptr_ux[ll] );
 				v_dux = _mm256_load_pd( &ptr_dux[ll] );
 				v_dux = _mm256_sub_pd( v_dux, v_ux );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 				v_ux    = _mm256_fmadd_pd( v_alpha, v_dux, v_ux );
 #else
 				v_dux = _mm256_mul_pd( v_alpha, v_dux );
@@ -1179,7 +1179,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 				v_ux  = _mm256_load_pd( &ptr_ux[ll] );
 				v_dux = _mm256_load_pd( &ptr_dux[ll] );
 				v_dux = _mm256_sub_pd( v_dux, v_ux );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 				v_ux    = _mm256_fmadd_pd( v_alpha, v_dux, v_ux );
 #else
 				v_dux = _mm256_mul_pd( v_alpha, v_dux );
@@ -1199,7 +1199,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 				v_dt1   = _mm256_load_pd( &ptr_dt[pnb+ll] );
 				v_dlam0 = _mm256_load_pd( &ptr_dlam[ll] );
 				v_dlam1 = _mm256_load_pd( &ptr_dlam[pnb+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 				v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 				v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 				v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -1218,7 +1218,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 				_mm256_store_pd( &ptr_t[pnb+ll], v_t1 );
 				_mm256_store_pd( &ptr_lam[ll], v_lam0 );
 				_mm256_store_pd( &ptr_lam[pnb+ll], v_lam1 );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 				v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
 				v_mu1   = _mm256_fmadd_pd( v_lam1, v_t1, v_mu1 );
 #else
@@ -1244,7 +1244,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 				v_dt1   = _mm256_load_pd( &ptr_dt[pnb+ll] );
 				v_dlam0 = _mm256_load_pd( &ptr_dlam[ll] );
 				v_dlam1 = _mm256_load_pd( &ptr_dlam[pnb+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 				v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 				v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 				v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -1263,7 +1263,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 				_mm256_maskstore_pd( &ptr_t[pnb+ll], i_mask, v_t1 );
 				_mm256_maskstore_pd( &ptr_lam[ll], i_mask, v_lam0 );
 				_mm256_maskstore_pd( &ptr_lam[pnb+ll], i_mask, v_lam1 );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 				v_lam0  = _mm256_blendv_pd( v_zeros, v_lam0, v_mask );
 				v_lam1  = _mm256_blendv_pd( v_zeros, v_lam1, v_mask );
 				v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
@@ -1287,7 +1287,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			v_ux  = _mm256_load_pd( &ptr_ux[ll] );
 			v_dux = _mm256_load_pd( &ptr_dux[ll] );
 			v_dux = _mm256_sub_pd( v_dux, v_ux );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_ux    = _mm256_fmadd_pd( v_alpha, v_dux, v_ux );
 #else
 			v_dux = _mm256_mul_pd( v_alpha, v_dux );
@@ -1305,7 +1305,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			v_ux  = _mm256_load_pd( &ptr_ux[ll] );
 			v_dux = _mm256_load_pd( &ptr_dux[ll] );
 			v_dux = _mm256_sub_pd( v_dux, v_ux );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_ux    = _mm256_fmadd_pd( v_alpha, v_dux, v_ux );
 #else
 			v_dux = _mm256_mul_pd( v_alpha, v_dux );
@@ -1325,7 +1325,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			v_dt1   = _mm256_load_pd( &ptr_dt[1*pnb+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[0*pnb+ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*pnb+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -1344,7 +1344,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			_mm256_store_pd( &ptr_t[1*pnb+ll], v_t1 );
 			_mm256_store_pd( &ptr_lam[0*pnb+ll], v_lam0 );
 			_mm256_store_pd( &ptr_lam[1*pnb+ll], v_lam1 );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
 			v_mu1   = _mm256_fmadd_pd( v_lam1, v_t1, v_mu1 );
 #else
@@ -1370,7 +1370,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			v_dt1   = _mm256_load_pd( &ptr_dt[1*pnb+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[0*pnb+ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*pnb+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -1389,7 +1389,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			_mm256_maskstore_pd( &ptr_t[1*pnb+ll], i_mask, v_t1 );
 			_mm256_maskstore_pd( &ptr_lam[0*pnb+ll], i_mask, v_lam0 );
 			_mm256_maskstore_pd( &ptr_lam[1*pnb+ll], i_mask, v_lam1 );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_lam0  = _mm256_blendv_pd( v_zeros, v_lam0, v_mask );
 			v_lam1  = _mm256_blendv_pd( v_zeros, v_lam1, v_mask );
 			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
@@ -1422,7 +1422,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			v_dt1   = _mm256_load_pd( &ptr_dt[1*png+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[0*png+ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*png+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -1441,7 +1441,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			_mm256_store_pd( &ptr_t[1*png+ll], v_t1 );
 			_mm256_store_pd( &ptr_lam[0*png+ll], v_lam0 );
 			_mm256_store_pd( &ptr_lam[1*png+ll], v_lam1 );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
 			v_mu1   = _mm256_fmadd_pd( v_lam1, v_t1, v_mu1 );
 #else
@@ -1468,7 +1468,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			v_dt1   = _mm256_load_pd( &ptr_dt[1*png+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[0*png+ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*png+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -1487,7 +1487,7 @@ void d_update_var_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			_mm256_maskstore_pd( &ptr_t[1*png+ll], i_mask, v_t1 );
 			_mm256_maskstore_pd( &ptr_lam[0*png+ll], i_mask, v_lam0 );
 			_mm256_maskstore_pd( &ptr_lam[1*png+ll], i_mask, v_lam1 );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_lam0  = _mm256_blendv_pd( v_zeros, v_lam0, v_mask );
 			v_lam1  = _mm256_blendv_pd( v_zeros, v_lam1, v_mask );
 			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
@@ -1571,7 +1571,7 @@ void d_compute_mu_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			v_dt1   = _mm256_load_pd( &ptr_dt[1*pnb+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[0*pnb+ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*pnb+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -1608,7 +1608,7 @@ void d_compute_mu_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			v_dt1   = _mm256_load_pd( &ptr_dt[1*pnb+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[0*pnb+ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*pnb+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -1653,7 +1653,7 @@ void d_compute_mu_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			v_dt1   = _mm256_load_pd( &ptr_dt[png+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[png+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -1690,7 +1690,7 @@ void d_compute_mu_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, double
 			v_dt1   = _mm256_load_pd( &ptr_dt[png+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[png+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -3093,7 +3093,7 @@ void d_compute_mu_res_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, dou
 			v_dt1   = _mm256_load_pd( &ptr_dt[1*pnb+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[0*pnb+ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*pnb+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -3131,7 +3131,7 @@ void d_compute_mu_res_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, dou
 			v_dt1   = _mm256_load_pd( &ptr_dt[1*pnb+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[0*pnb+ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*pnb+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -3177,7 +3177,7 @@ void d_compute_mu_res_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, dou
 			v_dt1   = _mm256_load_pd( &ptr_dt[png+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[png+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -3215,7 +3215,7 @@ void d_compute_mu_res_mpc_hard_tv(int N, int *nx, int *nu, int *nb, int *ng, dou
 			v_dt1   = _mm256_load_pd( &ptr_dt[png+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[png+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
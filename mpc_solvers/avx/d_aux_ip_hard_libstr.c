@@ -71,6 +71,11 @@ void d_init_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, i
 		}
 
 
+	// full warm start: ux, pi, t>0 & lam>0 as given (e.g. by d_shift_warm_start_mpc_hard_libstr)
+	if(warm_start==2)
+		return;
+
+
 	// check bounds & initialize multipliers
 	for(jj=0; jj<=N; jj++)
 		{
@@ -333,6 +338,69 @@ void d_update_gradient_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng
 	}
 
 
+void d_compute_gondzio_correction_mpc_hard_libstr(int N, int *nb, int *ng, double alpha, double mu_min, double mu_max, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hslamt, struct blasfeo_dvec *hstinv, struct blasfeo_dvec *hsqx)
+	{
+
+	int ii, jj, ll;
+
+	int nt0;
+
+	double
+		*ptr_t, *ptr_dt, *ptr_lam, *ptr_dlam, *ptr_lamt, *ptr_tinv, *ptr_qx;
+	
+	double
+		tmp, cor0, cor1;
+	
+	for(jj=0; jj<=N; jj++)
+		{
+
+		ptr_t     = hst[jj].pa;
+		ptr_dt    = hsdt[jj].pa;
+		ptr_lam   = hslam[jj].pa;
+		ptr_dlam  = hsdlam[jj].pa;
+		ptr_lamt  = hslamt[jj].pa;
+		ptr_tinv  = hstinv[jj].pa;
+		ptr_qx    = hsqx[jj].pa;
+
+		nt0 = nb[jj]+ng[jj];
+
+		for(ii=0; ii<nt0; ii++)
+			{
+
+			// lower constraint
+			ll = ii;
+			// complementarity products at the trial step, projected onto [mu_min, mu_max]
+			tmp = ( ptr_t[ll] + alpha*ptr_dt[ll] ) * ( ptr_lam[ll] + alpha*ptr_dlam[ll] );
+			cor0 = 0.0;
+			if(tmp<mu_min)
+				cor0 = ptr_tinv[ll] * ( mu_min - tmp );
+			else if(tmp>mu_max)
+				cor0 = ptr_tinv[ll] * ( mu_max-tmp<-mu_max ? -mu_max : mu_max-tmp );
+			// right-hand side as left by d_update_gradient_mpc_hard_libstr, plus the correction
+			ptr_dlam[ll] += ptr_lamt[ll] * ptr_dt[ll] + ptr_lam[ll] + cor0;
+
+			// upper constraint
+			ll = ii+nt0;
+			tmp = ( ptr_t[ll] + alpha*ptr_dt[ll] ) * ( ptr_lam[ll] + alpha*ptr_dlam[ll] );
+			cor1 = 0.0;
+			if(tmp<mu_min)
+				cor1 = ptr_tinv[ll] * ( mu_min - tmp );
+			else if(tmp>mu_max)
+				cor1 = ptr_tinv[ll] * ( mu_max-tmp<-mu_max ? -mu_max : mu_max-tmp );
+			ptr_dlam[ll] += ptr_lamt[ll] * ptr_dt[ll] + ptr_lam[ll] + cor1;
+
+			ptr_qx[ii] += cor1 - cor0;
+
+			}
+
+		}
+
+	return;
+
+	}
+
+
+
 void d_compute_alpha_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, double *ptr_alpha, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hslamt, struct blasfeo_dvec *hsdux, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsdb)
 	{
 	
@@ -549,64 +617,597 @@ void d_compute_alpha_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int **idx
 				t_tmp0   = _mm256_blendv_ps( t_ones, t_tmp0, t_mask0 );
 				t_alpha0 = _mm256_min_ps( t_alpha0, t_tmp0 );
 
-				}
+				}
+			}
+		}		
+
+	// reduce alpha
+	t_alpha0 = _mm256_min_ps( t_alpha0, t_alpha1 );
+	s_alpha0 = _mm256_extractf128_ps( t_alpha0, 0x1 );
+//	s_alpha1 = _mm256_extractf128_ps( t_alpha0, 0x1 );
+//	s_alpha0  = _mm_min_ps( s_alpha0 , s_alpha1 );
+	s_alpha1 = _mm256_castps256_ps128( t_alpha0 );
+	s_alpha0 = _mm_min_ps( s_alpha0, s_alpha1 );
+	
+	v_alpha = _mm256_cvtps_pd( s_alpha0 );
+	u_alpha = _mm256_extractf128_pd( v_alpha, 0x1 );
+	u_alpha = _mm_min_pd( u_alpha, _mm256_castpd256_pd128( v_alpha ) );
+	u_alpha = _mm_min_sd( u_alpha, _mm_permute_pd( u_alpha, 0x1 ) );
+/*	u_alpha = _mm_min_sd( u_alpha, _mm_load_sd( &alpha ) );*/
+	_mm_store_sd( &alpha, u_alpha );
+
+	
+	ptr_alpha[0] = alpha;
+
+	return;
+	
+	}
+
+
+
+void d_compute_alpha_mu_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, double *ptr_alpha, double *ptr_mu_poly, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hslamt, struct blasfeo_dvec *hsdux, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsdb)
+	{
+	
+	int jj, ll;
+
+	__m256
+		t_sign, t_ones, t_zeros,
+		t_mask0, t_mask1,
+		t_lam, t_dlam, t_t, t_dt,
+		t_tmp0, t_tmp1,
+		t_alpha0, t_alpha1;
+
+	__m128
+		s_mask, s_alpha0, s_alpha1;
+	
+	__m256d
+		v_sign, v_alpha, v_mask, v_left,
+		v_temp0, v_dt0, v_db0, v_dlam0, v_lamt0, v_t0, v_lam0,
+		v_temp1, v_dt1, v_db1, v_dlam1, v_lamt1, v_t1, v_lam1,
+		v_zeros, v_mu0, v_mu1, v_mu2;
+	
+	__m128d
+		u_mu, u_alpha;
+	
+	__m256i
+		i_mask;
+	
+	int nu0, nx0, nb0, ng0, nt0;
+
+	long long long_sign = 0x8000000000000000;
+	v_sign = _mm256_broadcast_sd( (double *) &long_sign );
+
+	int int_sign = 0x80000000;
+	t_sign = _mm256_broadcast_ss( (float *) &int_sign );
+	
+	s_alpha0 = _mm_set_ps( 1.0, 1.0, 1.0, 1.0 );
+
+	t_ones  = _mm256_set_ps( 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 );
+	t_zeros = _mm256_setzero_ps( );
+
+	t_alpha0 = _mm256_set_ps( 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 );
+	t_alpha1 = _mm256_set_ps( 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 );
+
+	// coefficients of the duality gap as a polynomial in the step length
+	v_zeros = _mm256_setzero_pd( );
+	v_mu0 = _mm256_setzero_pd( );
+	v_mu1 = _mm256_setzero_pd( );
+	v_mu2 = _mm256_setzero_pd( );
+	
+	double ll_left;
+
+	static double d_mask[4]  = {0.5, 1.5, 2.5, 3.5};
+
+	double alpha = ptr_alpha[0];
+
+	double
+		*ptr_db, *ptr_dux, *ptr_t, *ptr_dt, *ptr_lamt, *ptr_lam, *ptr_dlam;
+	
+	int
+		*ptr_idxb;
+	
+	for(jj=0; jj<=N; jj++)
+		{
+
+		ptr_db   = hsdb[jj].pa;
+		ptr_dux  = hsdux[jj].pa;
+		ptr_t    = hst[jj].pa;
+		ptr_dt   = hsdt[jj].pa;
+		ptr_lamt = hslamt[jj].pa;
+		ptr_lam  = hslam[jj].pa;
+		ptr_dlam = hsdlam[jj].pa;
+		ptr_idxb = idxb[jj];
+
+		nu0 = nu[jj];
+		nx0 = nx[jj];
+		nb0 = nb[jj];
+		ng0 = ng[jj];
+		nt0 = nb0 + ng0;
+
+		// box constraints // TODO dvecex_libstr
+		for(ll=0; ll<nb0; ll++)
+			ptr_dt[ll] = ptr_dux[ptr_idxb[ll]];
+
+		// general constraints
+		blasfeo_dgemv_t(nx0+nu0, ng0, 1.0, &hsDCt[jj], 0, 0, &hsdux[jj], 0, 0.0, &hsdt[jj], nb0, &hsdt[jj], nb0);
+
+		// all constraints
+		for(ll=0; ll<nt0-3; ll+=4)
+			{
+			v_dt0   = _mm256_loadu_pd( &ptr_dt[0*nt0+ll] );
+			v_dt1   = _mm256_xor_pd( v_dt0, v_sign );
+			v_db0   = _mm256_loadu_pd( &ptr_db[0*nt0+ll] );
+			v_db1   = _mm256_loadu_pd( &ptr_db[1*nt0+ll] );
+			v_dt0   = _mm256_sub_pd ( v_dt0, v_db0 );
+			v_dt1   = _mm256_add_pd ( v_dt1, v_db1 );
+			v_t0    = _mm256_loadu_pd( &ptr_t[0*nt0+ll] );
+			v_t1    = _mm256_loadu_pd( &ptr_t[1*nt0+ll] );
+			v_dt0   = _mm256_sub_pd( v_dt0, v_t0 );
+			v_dt1   = _mm256_sub_pd( v_dt1, v_t1 );
+			_mm256_storeu_pd( &ptr_dt[0*nt0+ll], v_dt0 );
+			_mm256_storeu_pd( &ptr_dt[1*nt0+ll], v_dt1 );
+
+			v_lamt0 = _mm256_loadu_pd( &ptr_lamt[0*nt0+ll] );
+			v_lamt1 = _mm256_loadu_pd( &ptr_lamt[1*nt0+ll] );
+			v_temp0 = _mm256_mul_pd( v_lamt0, v_dt0 );
+			v_temp1 = _mm256_mul_pd( v_lamt1, v_dt1 );
+			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[0*nt0+ll] );
+			v_dlam1 = _mm256_loadu_pd( &ptr_dlam[1*nt0+ll] );
+			v_lam0  = _mm256_loadu_pd( &ptr_lam[0*nt0+ll] );
+			v_lam1  = _mm256_loadu_pd( &ptr_lam[1*nt0+ll] );
+			v_dlam0 = _mm256_sub_pd( v_dlam0, v_lam0 );
+			v_dlam1 = _mm256_sub_pd( v_dlam1, v_lam1 );
+			v_dlam0 = _mm256_sub_pd( v_dlam0, v_temp0 );
+			v_dlam1 = _mm256_sub_pd( v_dlam1, v_temp1 );
+			_mm256_storeu_pd( &ptr_dlam[0*nt0+ll], v_dlam0 );
+			_mm256_storeu_pd( &ptr_dlam[1*nt0+ll], v_dlam1 );
+
+			v_temp0 = _mm256_add_pd( _mm256_mul_pd( v_lam0, v_t0 ), _mm256_mul_pd( v_lam1, v_t1 ) );
+			v_mu0   = _mm256_add_pd( v_mu0, v_temp0 );
+			v_temp0 = _mm256_add_pd( _mm256_mul_pd( v_lam0, v_dt0 ), _mm256_mul_pd( v_dlam0, v_t0 ) );
+			v_temp1 = _mm256_add_pd( _mm256_mul_pd( v_lam1, v_dt1 ), _mm256_mul_pd( v_dlam1, v_t1 ) );
+			v_mu1   = _mm256_add_pd( v_mu1, _mm256_add_pd( v_temp0, v_temp1 ) );
+			v_temp0 = _mm256_add_pd( _mm256_mul_pd( v_dlam0, v_dt0 ), _mm256_mul_pd( v_dlam1, v_dt1 ) );
+			v_mu2   = _mm256_add_pd( v_mu2, v_temp0 );
+
+			t_dlam   = _mm256_permute2f128_ps( _mm256_castps128_ps256( _mm256_cvtpd_ps( v_dlam0 ) ), _mm256_castps128_ps256( _mm256_cvtpd_ps( v_dlam1 ) ), 0x20 );
+			t_dt     = _mm256_permute2f128_ps( _mm256_castps128_ps256( _mm256_cvtpd_ps( v_dt0 ) ), _mm256_castps128_ps256( _mm256_cvtpd_ps( v_dt1 ) ), 0x20 );
+			t_mask0  = _mm256_cmp_ps( t_dlam, t_zeros, 0x01 );
+			t_mask1  = _mm256_cmp_ps( t_dt, t_zeros, 0x01 );
+			t_lam    = _mm256_permute2f128_ps( _mm256_castps128_ps256( _mm256_cvtpd_ps( v_lam0 ) ), _mm256_castps128_ps256( _mm256_cvtpd_ps( v_lam1 ) ), 0x20 );
+			t_t      = _mm256_permute2f128_ps( _mm256_castps128_ps256( _mm256_cvtpd_ps( v_t0 ) ), _mm256_castps128_ps256( _mm256_cvtpd_ps( v_t1 ) ), 0x20 );
+			t_lam    = _mm256_xor_ps( t_lam, t_sign );
+			t_t      = _mm256_xor_ps( t_t, t_sign );
+			t_tmp0   = _mm256_div_ps( t_lam, t_dlam );
+			t_tmp1   = _mm256_div_ps( t_t, t_dt );
+			t_tmp0   = _mm256_blendv_ps( t_ones, t_tmp0, t_mask0 );
+			t_tmp1   = _mm256_blendv_ps( t_ones, t_tmp1, t_mask1 );
+			t_alpha0 = _mm256_min_ps( t_alpha0, t_tmp0 );
+			t_alpha1 = _mm256_min_ps( t_alpha1, t_tmp1 );
+
+			}
+		if(ll<nt0)
+			{
+
+			ll_left = nt0 - ll;
+			v_left  = _mm256_broadcast_sd( &ll_left );
+			v_mask  = _mm256_loadu_pd( d_mask );
+			v_mask  = _mm256_sub_pd( v_mask, v_left );
+			i_mask  = _mm256_castpd_si256( v_mask );
+
+			v_dt0   = _mm256_loadu_pd( &ptr_dt[0*nt0+ll] );
+			v_dt1   = _mm256_xor_pd( v_dt0, v_sign );
+			v_db0   = _mm256_loadu_pd( &ptr_db[0*nt0+ll] );
+			v_db1   = _mm256_loadu_pd( &ptr_db[1*nt0+ll] );
+			v_dt0   = _mm256_sub_pd ( v_dt0, v_db0 );
+			v_dt1   = _mm256_add_pd ( v_dt1, v_db1 );
+			v_t0    = _mm256_loadu_pd( &ptr_t[0*nt0+ll] );
+			v_t1    = _mm256_loadu_pd( &ptr_t[1*nt0+ll] );
+			v_dt0   = _mm256_sub_pd( v_dt0, v_t0 );
+			v_dt1   = _mm256_sub_pd( v_dt1, v_t1 );
+			_mm256_maskstore_pd( &ptr_dt[0*nt0+ll], i_mask, v_dt0 );
+			_mm256_maskstore_pd( &ptr_dt[1*nt0+ll], i_mask, v_dt1 );
+
+			v_lamt0 = _mm256_loadu_pd( &ptr_lamt[0*nt0+ll] );
+			v_lamt1 = _mm256_loadu_pd( &ptr_lamt[1*nt0+ll] );
+			v_temp0 = _mm256_mul_pd( v_lamt0, v_dt0 );
+			v_temp1 = _mm256_mul_pd( v_lamt1, v_dt1 );
+			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[0*nt0+ll] );
+			v_dlam1 = _mm256_loadu_pd( &ptr_dlam[1*nt0+ll] );
+			v_lam0  = _mm256_loadu_pd( &ptr_lam[0*nt0+ll] );
+			v_lam1  = _mm256_loadu_pd( &ptr_lam[1*nt0+ll] );
+			v_dlam0 = _mm256_sub_pd( v_dlam0, v_lam0 );
+			v_dlam1 = _mm256_sub_pd( v_dlam1, v_lam1 );
+			v_dlam0 = _mm256_sub_pd( v_dlam0, v_temp0 );
+			v_dlam1 = _mm256_sub_pd( v_dlam1, v_temp1 );
+			_mm256_maskstore_pd( &ptr_dlam[0*nt0+ll], i_mask, v_dlam0 );
+			_mm256_maskstore_pd( &ptr_dlam[1*nt0+ll], i_mask, v_dlam1 );
+
+			v_temp0 = _mm256_add_pd( _mm256_mul_pd( v_lam0, v_t0 ), _mm256_mul_pd( v_lam1, v_t1 ) );
+			v_mu0   = _mm256_add_pd( v_mu0, _mm256_blendv_pd( v_zeros, v_temp0, v_mask ) );
+			v_temp0 = _mm256_add_pd( _mm256_mul_pd( v_lam0, v_dt0 ), _mm256_mul_pd( v_dlam0, v_t0 ) );
+			v_temp1 = _mm256_add_pd( _mm256_mul_pd( v_lam1, v_dt1 ), _mm256_mul_pd( v_dlam1, v_t1 ) );
+			v_temp0 = _mm256_add_pd( v_temp0, v_temp1 );
+			v_mu1   = _mm256_add_pd( v_mu1, _mm256_blendv_pd( v_zeros, v_temp0, v_mask ) );
+			v_temp0 = _mm256_add_pd( _mm256_mul_pd( v_dlam0, v_dt0 ), _mm256_mul_pd( v_dlam1, v_dt1 ) );
+			v_mu2   = _mm256_add_pd( v_mu2, _mm256_blendv_pd( v_zeros, v_temp0, v_mask ) );
+
+			if(ll<nt0-2) // 3 left
+				{
+
+				t_dlam   = _mm256_permute2f128_ps( _mm256_castps128_ps256( _mm256_cvtpd_ps( v_dlam0 ) ), _mm256_castps128_ps256( _mm256_cvtpd_ps( v_dlam1 ) ), 0x20 );
+				t_dt     = _mm256_permute2f128_ps( _mm256_castps128_ps256( _mm256_cvtpd_ps( v_dt0 ) ), _mm256_castps128_ps256( _mm256_cvtpd_ps( v_dt1 ) ), 0x20 );
+				t_mask0  = _mm256_cmp_ps( t_dlam, t_zeros, 0x01 );
+				t_mask1  = _mm256_cmp_ps( t_dt, t_zeros, 0x01 );
+				t_lam    = _mm256_permute2f128_ps( _mm256_castps128_ps256( _mm256_cvtpd_ps( v_lam0 ) ), _mm256_castps128_ps256( _mm256_cvtpd_ps( v_lam1 ) ), 0x20 );
+				t_t      = _mm256_permute2f128_ps( _mm256_castps128_ps256( _mm256_cvtpd_ps( v_t0 ) ), _mm256_castps128_ps256( _mm256_cvtpd_ps( v_t1 ) ), 0x20 );
+				t_lam    = _mm256_xor_ps( t_lam, t_sign );
+				t_t      = _mm256_xor_ps( t_t, t_sign );
+				t_tmp0   = _mm256_div_ps( t_lam, t_dlam );
+				t_tmp1   = _mm256_div_ps( t_t, t_dt );
+				t_mask0  = _mm256_blend_ps( t_zeros, t_mask0, 0x77 );
+				t_mask1  = _mm256_blend_ps( t_zeros, t_mask1, 0x77 );
+				t_tmp0   = _mm256_blendv_ps( t_ones, t_tmp0, t_mask0 );
+				t_tmp1   = _mm256_blendv_ps( t_ones, t_tmp1, t_mask1 );
+				t_alpha0 = _mm256_min_ps( t_alpha0, t_tmp0 );
+				t_alpha1 = _mm256_min_ps( t_alpha1, t_tmp1 );
+
+				}
+			else // 1 or 2 left
+				{
+
+				s_mask   = _mm256_cvtpd_ps( v_mask );
+				s_mask   = _mm_shuffle_ps( s_mask, s_mask, 0x44 );
+				t_mask1  = _mm256_permute2f128_ps( _mm256_castps128_ps256( s_mask ), _mm256_castps128_ps256( s_mask ), 0x20 );
+				t_mask1  = _mm256_cmp_ps( t_mask1, t_zeros, 0x01 );
+
+				v_dt0    = _mm256_permute2f128_pd( v_dt0, v_dt1, 0x20 );
+				v_t0     = _mm256_permute2f128_pd( v_t0, v_t1, 0x20 );
+				v_dlam0  = _mm256_permute2f128_pd( v_dlam0, v_dlam1, 0x20 );
+				v_lam0   = _mm256_permute2f128_pd( v_lam0, v_lam1, 0x20 );
+
+				t_dlam   = _mm256_permute2f128_ps( _mm256_castps128_ps256( _mm256_cvtpd_ps( v_dlam0 ) ), _mm256_castps128_ps256( _mm256_cvtpd_ps( v_dt0 ) ), 0x20 );
+				t_mask0  = _mm256_cmp_ps( t_dlam, t_zeros, 0x01 );
+				t_lam    = _mm256_permute2f128_ps( _mm256_castps128_ps256( _mm256_cvtpd_ps( v_lam0 ) ), _mm256_castps128_ps256( _mm256_cvtpd_ps( v_t0 ) ), 0x20 );
+				t_mask0  = _mm256_and_ps( t_mask0, t_mask1 );
+				t_lam    = _mm256_xor_ps( t_lam, t_sign );
+				t_tmp0   = _mm256_div_ps( t_lam, t_dlam );
+				t_tmp0   = _mm256_blendv_ps( t_ones, t_tmp0, t_mask0 );
+				t_alpha0 = _mm256_min_ps( t_alpha0, t_tmp0 );
+
+				}
+			}
+		}		
+
+	// reduce alpha
+	t_alpha0 = _mm256_min_ps( t_alpha0, t_alpha1 );
+	s_alpha0 = _mm256_extractf128_ps( t_alpha0, 0x1 );
+//	s_alpha1 = _mm256_extractf128_ps( t_alpha0, 0x1 );
+//	s_alpha0  = _mm_min_ps( s_alpha0 , s_alpha1 );
+	s_alpha1 = _mm256_castps256_ps128( t_alpha0 );
+	s_alpha0 = _mm_min_ps( s_alpha0, s_alpha1 );
+	
+	v_alpha = _mm256_cvtps_pd( s_alpha0 );
+	u_alpha = _mm256_extractf128_pd( v_alpha, 0x1 );
+	u_alpha = _mm_min_pd( u_alpha, _mm256_castpd256_pd128( v_alpha ) );
+	u_alpha = _mm_min_sd( u_alpha, _mm_permute_pd( u_alpha, 0x1 ) );
+/*	u_alpha = _mm_min_sd( u_alpha, _mm_load_sd( &alpha ) );*/
+	_mm_store_sd( &alpha, u_alpha );
+
+	
+	ptr_alpha[0] = alpha;
+
+	// reduce and store mu(alpha) = mu_poly[0] + alpha*mu_poly[1] + alpha^2*mu_poly[2], not scaled
+	u_mu = _mm_add_pd( _mm256_castpd256_pd128( v_mu0 ), _mm256_extractf128_pd( v_mu0, 0x1 ) );
+	u_mu = _mm_hadd_pd( u_mu, u_mu );
+	_mm_store_sd( &ptr_mu_poly[0], u_mu );
+	u_mu = _mm_add_pd( _mm256_castpd256_pd128( v_mu1 ), _mm256_extractf128_pd( v_mu1, 0x1 ) );
+	u_mu = _mm_hadd_pd( u_mu, u_mu );
+	_mm_store_sd( &ptr_mu_poly[1], u_mu );
+	u_mu = _mm_add_pd( _mm256_castpd256_pd128( v_mu2 ), _mm256_extractf128_pd( v_mu2, 0x1 ) );
+	u_mu = _mm_hadd_pd( u_mu, u_mu );
+	_mm_store_sd( &ptr_mu_poly[2], u_mu );
+
+	return;
+	
+	}
+
+
+
+void d_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, double *ptr_mu, double mu_scal, double alpha, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hsdux, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hsdpi, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam)
+	{
+
+	int ii;
+
+	ptr_mu[0] = 0.0;
+	
+	// backup and update equality constrains multipliers
+	for(ii=1; ii<=N; ii++)
+		{
+		blasfeo_daxpy(nx[ii], -1.0, &hspi[ii], 0, &hsdpi[ii], 0, &hsdpi[ii], 0);
+		blasfeo_daxpy(nx[ii], alpha, &hsdpi[ii], 0, &hspi[ii], 0, &hspi[ii], 0);
+		}
+
+	// backup and update inputs and states
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_daxpy(nu[ii]+nx[ii], -1.0, &hsux[ii], 0, &hsdux[ii], 0, &hsdux[ii], 0);
+		blasfeo_daxpy(nu[ii]+nx[ii], alpha, &hsdux[ii], 0, &hsux[ii], 0, &hsux[ii], 0);
+		}
+
+	// backup and update inequality constraints multipliers and slack variables
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_daxpy(2*nb[ii]+2*ng[ii], alpha, &hsdlam[ii], 0, &hslam[ii], 0, &hslam[ii], 0);
+		blasfeo_daxpy(2*nb[ii]+2*ng[ii], alpha, &hsdt[ii], 0, &hst[ii], 0, &hst[ii], 0);
+		ptr_mu[0] += blasfeo_ddot(2*nb[ii]+2*ng[ii], &hst[ii], 0, &hslam[ii], 0);
+		}
+	
+	ptr_mu[0] *= mu_scal;
+
+	return;
+	
+	}
+
+
+
+void d_backup_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, double *ptr_mu, double mu_scal, double alpha, struct blasfeo_dvec *hsux_bkp, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hsdux, struct blasfeo_dvec *hspi_bkp, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hsdpi, struct blasfeo_dvec *hst_bkp, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam_bkp, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam)
+	{
+	
+	int ii;
+
+	int nu0, nx0, nx1, nb0, ng0, nt0;
+
+	int jj, ll, ll_bkp, ll_end;
+	double ll_left;
+	
+	double d_mask[4] = {0.5, 1.5, 2.5, 3.5};
+	
+	__m128d
+		u_mu0, u_tmp;
+
+	__m256d
+		v_mask, v_left, v_zeros,
+		v_alpha, v_ux, v_dux, v_pi, v_dpi, 
+		v_t0, v_dt0, v_lam0, v_dlam0, v_mu0,
+		v_t1, v_dt1, v_lam1, v_dlam1, v_mu1;
+		
+	__m256i
+		i_mask;
+		
+	v_alpha = _mm256_broadcast_sd( &alpha );
+	
+	v_zeros = _mm256_setzero_pd();
+	v_mu0 = _mm256_setzero_pd();
+	v_mu1 = _mm256_setzero_pd();
+
+	double
+		*ptr_pi_bkp, *ptr_pi, *ptr_dpi, *ptr_ux_bkp, *ptr_ux, *ptr_dux, *ptr_t_bkp, *ptr_t, *ptr_dt, *ptr_lam_bkp, *ptr_lam, *ptr_dlam;
+
+	// multipliers of equality constraints: backup, compute step, update
+	for(jj=1; jj<=N; jj++)
+		{
+
+		nx0 = nx[jj];
+
+		ptr_pi_bkp = hspi_bkp[jj].pa;
+		ptr_pi     = hspi[jj].pa;
+		ptr_dpi    = hsdpi[jj].pa;
+
+		ll = 0;
+		for(; ll<nx0-3; ll+=4)
+			{
+			v_pi  = _mm256_loadu_pd( &ptr_pi[ll] );
+			v_dpi = _mm256_loadu_pd( &ptr_dpi[ll] );
+			_mm256_storeu_pd( &ptr_pi_bkp[ll], v_pi );
+			v_dpi = _mm256_sub_pd( v_dpi, v_pi );
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
+			v_pi  = _mm256_fmadd_pd( v_alpha, v_dpi, v_pi );
+#else
+			v_dpi = _mm256_mul_pd( v_alpha, v_dpi );
+			v_pi  = _mm256_add_pd( v_pi, v_dpi );
+#endif
+			_mm256_storeu_pd( &ptr_pi[ll], v_pi );
+			}
+		if(ll<nx0)
+			{
+			ll_left = nx0-ll;
+			v_left= _mm256_broadcast_sd( &ll_left );
+			v_mask= _mm256_loadu_pd( d_mask );
+			i_mask= _mm256_castpd_si256( _mm256_sub_pd( v_mask, v_left ) );
+
+			v_pi  = _mm256_loadu_pd( &ptr_pi[ll] );
+			v_dpi = _mm256_loadu_pd( &ptr_dpi[ll] );
+			_mm256_maskstore_pd( &ptr_pi_bkp[ll], i_mask, v_pi );
+			v_dpi = _mm256_sub_pd( v_dpi, v_pi );
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
+			v_pi  = _mm256_fmadd_pd( v_alpha, v_dpi, v_pi );
+#else
+			v_dpi = _mm256_mul_pd( v_alpha, v_dpi );
+			v_pi  = _mm256_add_pd( v_pi, v_dpi );
+#endif
+			_mm256_maskstore_pd( &ptr_pi[ll], i_mask, v_pi );
+			}
+
+		}
+
+	// inputs and states: backup, compute step, update
+	for(jj=0; jj<=N; jj++)
+		{
+
+		nx0 = nx[jj];
+		nu0 = nu[jj];
+		
+		ptr_ux_bkp  = hsux_bkp[jj].pa;
+		ptr_ux      = hsux[jj].pa;
+		ptr_dux     = hsdux[jj].pa;
+
+		for(ll=0; ll<nu0+nx0-3; ll+=4)
+			{
+			v_ux  = _mm256_loadu_pd( &ptr_ux[ll] );
+			v_dux = _mm256_loadu_pd( &ptr_dux[ll] );
+			_mm256_storeu_pd( &ptr_ux_bkp[ll], v_ux );
+			v_dux = _mm256_sub_pd( v_dux, v_ux );
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
+			v_ux    = _mm256_fmadd_pd( v_alpha, v_dux, v_ux );
+#else
+			v_dux = _mm256_mul_pd( v_alpha, v_dux );
+			v_ux  = _mm256_add_pd( v_ux, v_dux );
+#endif
+			_mm256_storeu_pd( &ptr_ux[ll], v_ux );
+			}
+		if(ll<nu0+nx0)
+			{
+			ll_left = nu0+nx0-ll;
+			v_left = _mm256_broadcast_sd( &ll_left );
+			v_mask = _mm256_loadu_pd( d_mask );
+			i_mask = _mm256_castpd_si256( _mm256_sub_pd( v_mask, v_left ) );
+
+			v_ux  = _mm256_loadu_pd( &ptr_ux[ll] );
+			v_dux = _mm256_loadu_pd( &ptr_dux[ll] );
+			_mm256_maskstore_pd( &ptr_ux_bkp[ll], i_mask, v_ux );
+			v_dux = _mm256_sub_pd( v_dux, v_ux );
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
+			v_ux    = _mm256_fmadd_pd( v_alpha, v_dux, v_ux );
+#else
+			v_dux = _mm256_mul_pd( v_alpha, v_dux );
+			v_ux  = _mm256_add_pd( v_ux, v_dux );
+#endif
+			_mm256_maskstore_pd( &ptr_ux[ll], i_mask, v_ux );
+			}
+
+		}
+
+	// multipliers and slack of inequalities: backup, update, compute mu
+	for(jj=0; jj<=N; jj++)
+		{
+
+		nb0 = nb[jj];
+		ng0 = ng[jj];
+		nt0 = nb0 + ng0;
+		
+		ptr_t_bkp   = hst_bkp[jj].pa;
+		ptr_t       = hst[jj].pa;
+		ptr_dt      = hsdt[jj].pa;
+		ptr_lam_bkp = hslam_bkp[jj].pa;
+		ptr_lam     = hslam[jj].pa;
+		ptr_dlam    = hsdlam[jj].pa;
+
+		// box constraints
+		ll = 0;
+		for(; ll<2*nt0-7; ll+=8)
+			{
+			v_t0    = _mm256_loadu_pd( &ptr_t[ll+0] );
+			v_t1    = _mm256_loadu_pd( &ptr_t[ll+4] );
+			v_lam0  = _mm256_loadu_pd( &ptr_lam[ll+0] );
+			v_lam1  = _mm256_loadu_pd( &ptr_lam[ll+4] );
+			v_dt0   = _mm256_loadu_pd( &ptr_dt[ll+0] );
+			v_dt1   = _mm256_loadu_pd( &ptr_dt[ll+4] );
+			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[ll+0] );
+			v_dlam1 = _mm256_loadu_pd( &ptr_dlam[ll+4] );
+			_mm256_storeu_pd( &ptr_t_bkp[ll+0], v_t0 );
+			_mm256_storeu_pd( &ptr_t_bkp[ll+4], v_t1 );
+			_mm256_storeu_pd( &ptr_lam_bkp[ll+0], v_lam0 );
+			_mm256_storeu_pd( &ptr_lam_bkp[ll+4], v_lam1 );
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
+			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
+			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
+			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
+			v_lam1  = _mm256_fmadd_pd( v_alpha, v_dlam1, v_lam1 );
+#else
+			v_dt0   = _mm256_mul_pd( v_alpha, v_dt0 );
+			v_dt1   = _mm256_mul_pd( v_alpha, v_dt1 );
+			v_dlam0 = _mm256_mul_pd( v_alpha, v_dlam0 );
+			v_dlam1 = _mm256_mul_pd( v_alpha, v_dlam1 );
+			v_t0    = _mm256_add_pd( v_t0, v_dt0 );
+			v_t1    = _mm256_add_pd( v_t1, v_dt1 );
+			v_lam0  = _mm256_add_pd( v_lam0, v_dlam0 );
+			v_lam1  = _mm256_add_pd( v_lam1, v_dlam1 );
+#endif
+			_mm256_storeu_pd( &ptr_t[ll+0], v_t0 );
+			_mm256_storeu_pd( &ptr_t[ll+4], v_t1 );
+			_mm256_storeu_pd( &ptr_lam[ll+0], v_lam0 );
+			_mm256_storeu_pd( &ptr_lam[ll+4], v_lam1 );
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
+			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
+			v_mu1   = _mm256_fmadd_pd( v_lam1, v_t1, v_mu1 );
+#else
+			v_lam0  = _mm256_mul_pd( v_lam0, v_t0 );
+			v_lam1  = _mm256_mul_pd( v_lam1, v_t1 );
+			v_mu0   = _mm256_add_pd( v_mu0, v_lam0 );
+			v_mu1   = _mm256_add_pd( v_mu1, v_lam1 );
+#endif
+			}
+		for(; ll<2*nt0-3; ll+=4)
+			{
+			v_t0    = _mm256_loadu_pd( &ptr_t[ll+0] );
+			v_lam0  = _mm256_loadu_pd( &ptr_lam[ll+0] );
+			v_dt0   = _mm256_loadu_pd( &ptr_dt[ll+0] );
+			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[ll+0] );
+			_mm256_storeu_pd( &ptr_t_bkp[ll+0], v_t0 );
+			_mm256_storeu_pd( &ptr_lam_bkp[ll+0], v_lam0 );
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
+			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
+			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
+#else
+			v_dt0   = _mm256_mul_pd( v_alpha, v_dt0 );
+			v_dlam0 = _mm256_mul_pd( v_alpha, v_dlam0 );
+			v_t0    = _mm256_add_pd( v_t0, v_dt0 );
+			v_lam0  = _mm256_add_pd( v_lam0, v_dlam0 );
+#endif
+			_mm256_storeu_pd( &ptr_t[ll+0], v_t0 );
+			_mm256_storeu_pd( &ptr_lam[ll+0], v_lam0 );
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
+			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
+#else
+			v_lam0  = _mm256_mul_pd( v_lam0, v_t0 );
+			v_mu0   = _mm256_add_pd( v_mu0, v_lam0 );
+#endif
+			}
+		if(ll<2*nt0)
+			{
+			ll_left = 2*nt0-ll;
+			v_left  = _mm256_broadcast_sd( &ll_left );
+			v_mask  = _mm256_loadu_pd( d_mask );
+			v_mask  = _mm256_sub_pd( v_mask, v_left );
+			i_mask  = _mm256_castpd_si256( v_mask );
+
+			v_t0    = _mm256_loadu_pd( &ptr_t[ll+0] );
+			v_lam0  = _mm256_loadu_pd( &ptr_lam[ll+0] );
+			v_dt0   = _mm256_loadu_pd( &ptr_dt[ll+0] );
+			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[ll+0] );
+			_mm256_maskstore_pd( &ptr_t_bkp[ll+0], i_mask, v_t0 );
+			_mm256_maskstore_pd( &ptr_lam_bkp[ll+0], i_mask, v_lam0 );
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
+			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
+			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
+#else
+			v_dt0   = _mm256_mul_pd( v_alpha, v_dt0 );
+			v_dlam0 = _mm256_mul_pd( v_alpha, v_dlam0 );
+			v_t0    = _mm256_add_pd( v_t0, v_dt0 );
+			v_lam0  = _mm256_add_pd( v_lam0, v_dlam0 );
+#endif
+			_mm256_maskstore_pd( &ptr_t[ll+0], i_mask, v_t0 );
+			_mm256_maskstore_pd( &ptr_lam[ll+0], i_mask, v_lam0 );
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
+			v_lam0  = _mm256_blendv_pd( v_zeros, v_lam0, v_mask );
+			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
+#else
+			v_lam0  = _mm256_mul_pd( v_lam0, v_t0 );
+			v_lam0  = _mm256_blendv_pd( v_zeros, v_lam0, v_mask );
+			v_mu0   = _mm256_add_pd( v_mu0, v_lam0 );
+#endif
 			}
-		}		
-
-	// reduce alpha
-	t_alpha0 = _mm256_min_ps( t_alpha0, t_alpha1 );
-	s_alpha0 = _mm256_extractf128_ps( t_alpha0, 0x1 );
-//	s_alpha1 = _mm256_extractf128_ps( t_alpha0, 0x1 );
-//	s_alpha0  = _mm_min_ps( s_alpha0 , s_alpha1 );
-	s_alpha1 = _mm256_castps256_ps128( t_alpha0 );
-	s_alpha0 = _mm_min_ps( s_alpha0, s_alpha1 );
-	
-	v_alpha = _mm256_cvtps_pd( s_alpha0 );
-	u_alpha = _mm256_extractf128_pd( v_alpha, 0x1 );
-	u_alpha = _mm_min_pd( u_alpha, _mm256_castpd256_pd128( v_alpha ) );
-	u_alpha = _mm_min_sd( u_alpha, _mm_permute_pd( u_alpha, 0x1 ) );
-/*	u_alpha = _mm_min_sd( u_alpha, _mm_load_sd( &alpha ) );*/
-	_mm_store_sd( &alpha, u_alpha );
-
-	
-	ptr_alpha[0] = alpha;
-
-	return;
-	
-	}
-
-
-
-void d_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, double *ptr_mu, double mu_scal, double alpha, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hsdux, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hsdpi, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam)
-	{
-
-	int ii;
-
-	ptr_mu[0] = 0.0;
-	
-	// backup and update equality constrains multipliers
-	for(ii=1; ii<=N; ii++)
-		{
-		blasfeo_daxpy(nx[ii], -1.0, &hspi[ii], 0, &hsdpi[ii], 0, &hsdpi[ii], 0);
-		blasfeo_daxpy(nx[ii], alpha, &hsdpi[ii], 0, &hspi[ii], 0, &hspi[ii], 0);
-		}
 
-	// backup and update inputs and states
-	for(ii=0; ii<=N; ii++)
-		{
-		blasfeo_daxpy(nu[ii]+nx[ii], -1.0, &hsux[ii], 0, &hsdux[ii], 0, &hsdux[ii], 0);
-		blasfeo_daxpy(nu[ii]+nx[ii], alpha, &hsdux[ii], 0, &hsux[ii], 0, &hsux[ii], 0);
 		}
 
-	// backup and update inequality constraints multipliers and slack variables
-	for(ii=0; ii<=N; ii++)
-		{
-		blasfeo_daxpy(2*nb[ii]+2*ng[ii], alpha, &hsdlam[ii], 0, &hslam[ii], 0, &hslam[ii], 0);
-		blasfeo_daxpy(2*nb[ii]+2*ng[ii], alpha, &hsdt[ii], 0, &hst[ii], 0, &hst[ii], 0);
-		ptr_mu[0] += blasfeo_ddot(2*nb[ii]+2*ng[ii], &hst[ii], 0, &hslam[ii], 0);
-		}
-	
-	ptr_mu[0] *= mu_scal;
+	// reduce mu
+	v_mu0 = _mm256_add_pd( v_mu0, v_mu1 );
+	u_mu0 = _mm_add_pd( _mm256_castpd256_pd128( v_mu0 ), _mm256_extractf128_pd( v_mu0, 0x1 ) );
+	u_mu0 = _mm_hadd_pd( u_mu0, u_mu0 );
+	u_tmp = _mm_load_sd( &mu_scal );
+	u_mu0 = _mm_mul_sd( u_mu0, u_tmp );
+	_mm_store_sd( ptr_mu, u_mu0 );
 
 	return;
 	
@@ -614,14 +1215,12 @@ void d_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, dou
 
 
 
-void d_backup_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, double *ptr_mu, double mu_scal, double alpha, struct blasfeo_dvec *hsux_bkp, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hsdux, struct blasfeo_dvec *hspi_bkp, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hsdpi, struct blasfeo_dvec *hst_bkp, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam_bkp, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam)
+void d_backup_update_var_hessian_gradient_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, double *ptr_mu, double mu_scal, double alpha, struct blasfeo_dvec *hsux_bkp, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hsdux, struct blasfeo_dvec *hspi_bkp, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hsdpi, struct blasfeo_dvec *hst_bkp, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam_bkp, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hsdb, double sigma_mu, struct blasfeo_dvec *hstinv, struct blasfeo_dvec *hslamt, struct blasfeo_dvec *hsQx, struct blasfeo_dvec *hsqx)
 	{
 	
-	int ii;
-
-	int nu0, nx0, nx1, nb0, ng0, nt0;
+	int nu0, nx0, nb0, ng0, nt0;
 
-	int jj, ll, ll_bkp, ll_end;
+	int jj, ll;
 	double ll_left;
 	
 	double d_mask[4] = {0.5, 1.5, 2.5, 3.5};
@@ -633,7 +1232,8 @@ void d_backup_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *
 		v_mask, v_left, v_zeros,
 		v_alpha, v_ux, v_dux, v_pi, v_dpi, 
 		v_t0, v_dt0, v_lam0, v_dlam0, v_mu0,
-		v_t1, v_dt1, v_lam1, v_dlam1, v_mu1;
+		v_t1, v_dt1, v_lam1, v_dlam1, v_mu1,
+		v_ones, v_sigma_mu, v_tinv0, v_tinv1, v_lamt0, v_lamt1, v_qx0, v_qx1, v_Qx0;
 		
 	__m256i
 		i_mask;
@@ -644,8 +1244,12 @@ void d_backup_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *
 	v_mu0 = _mm256_setzero_pd();
 	v_mu1 = _mm256_setzero_pd();
 
+	v_ones = _mm256_set_pd( 1.0, 1.0, 1.0, 1.0 );
+	v_sigma_mu = _mm256_broadcast_sd( &sigma_mu );
+
 	double
-		*ptr_pi_bkp, *ptr_pi, *ptr_dpi, *ptr_ux_bkp, *ptr_ux, *ptr_dux, *ptr_t_bkp, *ptr_t, *ptr_dt, *ptr_lam_bkp, *ptr_lam, *ptr_dlam;
+		*ptr_pi_bkp, *ptr_pi, *ptr_dpi, *ptr_ux_bkp, *ptr_ux, *ptr_dux, *ptr_t_bkp, *ptr_t, *ptr_dt, *ptr_lam_bkp, *ptr_lam, *ptr_dlam,
+		*ptr_tinv, *ptr_lamt, *ptr_db, *ptr_Qx, *ptr_qx;
 
 	// multipliers of equality constraints: backup, compute step, update
 	for(jj=1; jj<=N; jj++)
@@ -664,7 +1268,7 @@ void d_backup_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *
 			v_dpi = _mm256_loadu_pd( &ptr_dpi[ll] );
 			_mm256_storeu_pd( &ptr_pi_bkp[ll], v_pi );
 			v_dpi = _mm256_sub_pd( v_dpi, v_pi );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_pi  = _mm256_fmadd_pd( v_alpha, v_dpi, v_pi );
 #else
 			v_dpi = _mm256_mul_pd( v_alpha, v_dpi );
@@ -683,7 +1287,7 @@ void d_backup_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *
 			v_dpi = _mm256_loadu_pd( &ptr_dpi[ll] );
 			_mm256_maskstore_pd( &ptr_pi_bkp[ll], i_mask, v_pi );
 			v_dpi = _mm256_sub_pd( v_dpi, v_pi );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_pi  = _mm256_fmadd_pd( v_alpha, v_dpi, v_pi );
 #else
 			v_dpi = _mm256_mul_pd( v_alpha, v_dpi );
@@ -711,7 +1315,7 @@ void d_backup_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *
 			v_dux = _mm256_loadu_pd( &ptr_dux[ll] );
 			_mm256_storeu_pd( &ptr_ux_bkp[ll], v_ux );
 			v_dux = _mm256_sub_pd( v_dux, v_ux );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_ux    = _mm256_fmadd_pd( v_alpha, v_dux, v_ux );
 #else
 			v_dux = _mm256_mul_pd( v_alpha, v_dux );
@@ -730,7 +1334,7 @@ void d_backup_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *
 			v_dux = _mm256_loadu_pd( &ptr_dux[ll] );
 			_mm256_maskstore_pd( &ptr_ux_bkp[ll], i_mask, v_ux );
 			v_dux = _mm256_sub_pd( v_dux, v_ux );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_ux    = _mm256_fmadd_pd( v_alpha, v_dux, v_ux );
 #else
 			v_dux = _mm256_mul_pd( v_alpha, v_dux );
@@ -741,7 +1345,8 @@ void d_backup_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *
 
 		}
 
-	// multipliers and slack of inequalities: backup, update, compute mu
+	// multipliers and slack of inequalities: backup, update, compute mu,
+	// and update cost function matrices and vectors for the next iteration in the same pass
 	for(jj=0; jj<=N; jj++)
 		{
 
@@ -752,31 +1357,37 @@ void d_backup_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *
 		ptr_t_bkp   = hst_bkp[jj].pa;
 		ptr_t       = hst[jj].pa;
 		ptr_dt      = hsdt[jj].pa;
+		ptr_tinv    = hstinv[jj].pa;
 		ptr_lam_bkp = hslam_bkp[jj].pa;
 		ptr_lam     = hslam[jj].pa;
 		ptr_dlam    = hsdlam[jj].pa;
+		ptr_lamt    = hslamt[jj].pa;
+		ptr_db      = hsdb[jj].pa;
+		ptr_Qx      = hsQx[jj].pa;
+		ptr_qx      = hsqx[jj].pa;
 
-		// box constraints
 		ll = 0;
-		for(; ll<2*nt0-7; ll+=8)
+		for(; ll<nt0-3; ll+=4)
 			{
-			v_t0    = _mm256_loadu_pd( &ptr_t[ll+0] );
-			v_t1    = _mm256_loadu_pd( &ptr_t[ll+4] );
-			v_lam0  = _mm256_loadu_pd( &ptr_lam[ll+0] );
-			v_lam1  = _mm256_loadu_pd( &ptr_lam[ll+4] );
-			v_dt0   = _mm256_loadu_pd( &ptr_dt[ll+0] );
-			v_dt1   = _mm256_loadu_pd( &ptr_dt[ll+4] );
-			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[ll+0] );
-			v_dlam1 = _mm256_loadu_pd( &ptr_dlam[ll+4] );
-			_mm256_storeu_pd( &ptr_t_bkp[ll+0], v_t0 );
-			_mm256_storeu_pd( &ptr_t_bkp[ll+4], v_t1 );
-			_mm256_storeu_pd( &ptr_lam_bkp[ll+0], v_lam0 );
-			_mm256_storeu_pd( &ptr_lam_bkp[ll+4], v_lam1 );
-#if defined(TARGET_X64_AVX2)
+			v_t0    = _mm256_loadu_pd( &ptr_t[0*nt0+ll] );
+			v_t1    = _mm256_loadu_pd( &ptr_t[1*nt0+ll] );
+			v_lam0  = _mm256_loadu_pd( &ptr_lam[0*nt0+ll] );
+			v_lam1  = _mm256_loadu_pd( &ptr_lam[1*nt0+ll] );
+			v_dt0   = _mm256_loadu_pd( &ptr_dt[0*nt0+ll] );
+			v_dt1   = _mm256_loadu_pd( &ptr_dt[1*nt0+ll] );
+			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[0*nt0+ll] );
+			v_dlam1 = _mm256_loadu_pd( &ptr_dlam[1*nt0+ll] );
+			_mm256_storeu_pd( &ptr_t_bkp[0*nt0+ll], v_t0 );
+			_mm256_storeu_pd( &ptr_t_bkp[1*nt0+ll], v_t1 );
+			_mm256_storeu_pd( &ptr_lam_bkp[0*nt0+ll], v_lam0 );
+			_mm256_storeu_pd( &ptr_lam_bkp[1*nt0+ll], v_lam1 );
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
 			v_lam1  = _mm256_fmadd_pd( v_alpha, v_dlam1, v_lam1 );
+			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
+			v_mu1   = _mm256_fmadd_pd( v_lam1, v_t1, v_mu1 );
 #else
 			v_dt0   = _mm256_mul_pd( v_alpha, v_dt0 );
 			v_dt1   = _mm256_mul_pd( v_alpha, v_dt1 );
@@ -786,80 +1397,94 @@ void d_backup_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *
 			v_t1    = _mm256_add_pd( v_t1, v_dt1 );
 			v_lam0  = _mm256_add_pd( v_lam0, v_dlam0 );
 			v_lam1  = _mm256_add_pd( v_lam1, v_dlam1 );
+			v_mu0   = _mm256_add_pd( v_mu0, _mm256_mul_pd( v_lam0, v_t0 ) );
+			v_mu1   = _mm256_add_pd( v_mu1, _mm256_mul_pd( v_lam1, v_t1 ) );
 #endif
-			_mm256_storeu_pd( &ptr_t[ll+0], v_t0 );
-			_mm256_storeu_pd( &ptr_t[ll+4], v_t1 );
-			_mm256_storeu_pd( &ptr_lam[ll+0], v_lam0 );
-			_mm256_storeu_pd( &ptr_lam[ll+4], v_lam1 );
-#if defined(TARGET_X64_AVX2)
-			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
-			v_mu1   = _mm256_fmadd_pd( v_lam1, v_t1, v_mu1 );
-#else
-			v_lam0  = _mm256_mul_pd( v_lam0, v_t0 );
-			v_lam1  = _mm256_mul_pd( v_lam1, v_t1 );
-			v_mu0   = _mm256_add_pd( v_mu0, v_lam0 );
-			v_mu1   = _mm256_add_pd( v_mu1, v_lam1 );
-#endif
-			}
-		for(; ll<2*nt0-3; ll+=4)
-			{
-			v_t0    = _mm256_loadu_pd( &ptr_t[ll+0] );
-			v_lam0  = _mm256_loadu_pd( &ptr_lam[ll+0] );
-			v_dt0   = _mm256_loadu_pd( &ptr_dt[ll+0] );
-			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[ll+0] );
-			_mm256_storeu_pd( &ptr_t_bkp[ll+0], v_t0 );
-			_mm256_storeu_pd( &ptr_lam_bkp[ll+0], v_lam0 );
-#if defined(TARGET_X64_AVX2)
-			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
-			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
-#else
-			v_dt0   = _mm256_mul_pd( v_alpha, v_dt0 );
-			v_dlam0 = _mm256_mul_pd( v_alpha, v_dlam0 );
-			v_t0    = _mm256_add_pd( v_t0, v_dt0 );
+			_mm256_storeu_pd( &ptr_t[0*nt0+ll], v_t0 );
+			_mm256_storeu_pd( &ptr_t[1*nt0+ll], v_t1 );
+			_mm256_storeu_pd( &ptr_lam[0*nt0+ll], v_lam0 );
+			_mm256_storeu_pd( &ptr_lam[1*nt0+ll], v_lam1 );
+			// hessian & gradient
+			v_tinv0 = _mm256_div_pd( v_ones, v_t0 );
+			v_tinv1 = _mm256_div_pd( v_ones, v_t1 );
+			_mm256_storeu_pd( &ptr_tinv[0*nt0+ll], v_tinv0 );
+			_mm256_storeu_pd( &ptr_tinv[1*nt0+ll], v_tinv1 );
+			v_lamt0 = _mm256_mul_pd( v_tinv0, v_lam0 );
+			v_lamt1 = _mm256_mul_pd( v_tinv1, v_lam1 );
+			_mm256_storeu_pd( &ptr_lamt[0*nt0+ll], v_lamt0 );
+			_mm256_storeu_pd( &ptr_lamt[1*nt0+ll], v_lamt1 );
+			v_dlam0 = _mm256_mul_pd( v_tinv0, v_sigma_mu );
+			v_dlam1 = _mm256_mul_pd( v_tinv1, v_sigma_mu );
+			_mm256_storeu_pd( &ptr_dlam[0*nt0+ll], v_dlam0 );
+			_mm256_storeu_pd( &ptr_dlam[1*nt0+ll], v_dlam1 );
+			v_qx0   = _mm256_loadu_pd( &ptr_db[0*nt0+ll] );
+			v_qx1   = _mm256_loadu_pd( &ptr_db[1*nt0+ll] );
+			v_qx0   = _mm256_mul_pd( v_qx0, v_lamt0 );
+			v_qx1   = _mm256_mul_pd( v_qx1, v_lamt1 );
 			v_lam0  = _mm256_add_pd( v_lam0, v_dlam0 );
-#endif
-			_mm256_storeu_pd( &ptr_t[ll+0], v_t0 );
-			_mm256_storeu_pd( &ptr_lam[ll+0], v_lam0 );
-#if defined(TARGET_X64_AVX2)
-			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
-#else
-			v_lam0  = _mm256_mul_pd( v_lam0, v_t0 );
-			v_mu0   = _mm256_add_pd( v_mu0, v_lam0 );
-#endif
+			v_lam1  = _mm256_add_pd( v_lam1, v_dlam1 );
+			v_qx0   = _mm256_add_pd( v_qx0, v_lam0 );
+			v_qx1   = _mm256_sub_pd( v_lam1, v_qx1 );
+			v_Qx0   = _mm256_add_pd( v_lamt0, v_lamt1 );
+			v_qx0   = _mm256_sub_pd( v_qx1, v_qx0 );
+			_mm256_storeu_pd( &ptr_Qx[ll], v_Qx0 );
+			_mm256_storeu_pd( &ptr_qx[ll], v_qx0 );
 			}
-		if(ll<2*nt0)
+		if(ll<nt0)
 			{
-			ll_left = 2*nt0-ll;
+			ll_left = nt0-ll;
 			v_left  = _mm256_broadcast_sd( &ll_left );
 			v_mask  = _mm256_loadu_pd( d_mask );
 			v_mask  = _mm256_sub_pd( v_mask, v_left );
 			i_mask  = _mm256_castpd_si256( v_mask );
 
-			v_t0    = _mm256_loadu_pd( &ptr_t[ll+0] );
-			v_lam0  = _mm256_loadu_pd( &ptr_lam[ll+0] );
-			v_dt0   = _mm256_loadu_pd( &ptr_dt[ll+0] );
-			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[ll+0] );
-			_mm256_maskstore_pd( &ptr_t_bkp[ll+0], i_mask, v_t0 );
-			_mm256_maskstore_pd( &ptr_lam_bkp[ll+0], i_mask, v_lam0 );
-#if defined(TARGET_X64_AVX2)
-			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
-			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
-#else
-			v_dt0   = _mm256_mul_pd( v_alpha, v_dt0 );
-			v_dlam0 = _mm256_mul_pd( v_alpha, v_dlam0 );
-			v_t0    = _mm256_add_pd( v_t0, v_dt0 );
+			v_t0    = _mm256_loadu_pd( &ptr_t[0*nt0+ll] );
+			v_t1    = _mm256_loadu_pd( &ptr_t[1*nt0+ll] );
+			v_lam0  = _mm256_loadu_pd( &ptr_lam[0*nt0+ll] );
+			v_lam1  = _mm256_loadu_pd( &ptr_lam[1*nt0+ll] );
+			v_dt0   = _mm256_loadu_pd( &ptr_dt[0*nt0+ll] );
+			v_dt1   = _mm256_loadu_pd( &ptr_dt[1*nt0+ll] );
+			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[0*nt0+ll] );
+			v_dlam1 = _mm256_loadu_pd( &ptr_dlam[1*nt0+ll] );
+			_mm256_maskstore_pd( &ptr_t_bkp[0*nt0+ll], i_mask, v_t0 );
+			_mm256_maskstore_pd( &ptr_t_bkp[1*nt0+ll], i_mask, v_t1 );
+			_mm256_maskstore_pd( &ptr_lam_bkp[0*nt0+ll], i_mask, v_lam0 );
+			_mm256_maskstore_pd( &ptr_lam_bkp[1*nt0+ll], i_mask, v_lam1 );
+			v_t0    = _mm256_add_pd( v_t0, _mm256_mul_pd( v_alpha, v_dt0 ) );
+			v_t1    = _mm256_add_pd( v_t1, _mm256_mul_pd( v_alpha, v_dt1 ) );
+			v_lam0  = _mm256_add_pd( v_lam0, _mm256_mul_pd( v_alpha, v_dlam0 ) );
+			v_lam1  = _mm256_add_pd( v_lam1, _mm256_mul_pd( v_alpha, v_dlam1 ) );
+			v_mu0   = _mm256_add_pd( v_mu0, _mm256_blendv_pd( v_zeros, _mm256_mul_pd( v_lam0, v_t0 ), v_mask ) );
+			v_mu1   = _mm256_add_pd( v_mu1, _mm256_blendv_pd( v_zeros, _mm256_mul_pd( v_lam1, v_t1 ), v_mask ) );
+			_mm256_maskstore_pd( &ptr_t[0*nt0+ll], i_mask, v_t0 );
+			_mm256_maskstore_pd( &ptr_t[1*nt0+ll], i_mask, v_t1 );
+			_mm256_maskstore_pd( &ptr_lam[0*nt0+ll], i_mask, v_lam0 );
+			_mm256_maskstore_pd( &ptr_lam[1*nt0+ll], i_mask, v_lam1 );
+			// hessian & gradient
+			v_tinv0 = _mm256_div_pd( v_ones, v_t0 );
+			v_tinv1 = _mm256_div_pd( v_ones, v_t1 );
+			_mm256_maskstore_pd( &ptr_tinv[0*nt0+ll], i_mask, v_tinv0 );
+			_mm256_maskstore_pd( &ptr_tinv[1*nt0+ll], i_mask, v_tinv1 );
+			v_lamt0 = _mm256_mul_pd( v_tinv0, v_lam0 );
+			v_lamt1 = _mm256_mul_pd( v_tinv1, v_lam1 );
+			_mm256_maskstore_pd( &ptr_lamt[0*nt0+ll], i_mask, v_lamt0 );
+			_mm256_maskstore_pd( &ptr_lamt[1*nt0+ll], i_mask, v_lamt1 );
+			v_dlam0 = _mm256_mul_pd( v_tinv0, v_sigma_mu );
+			v_dlam1 = _mm256_mul_pd( v_tinv1, v_sigma_mu );
+			_mm256_maskstore_pd( &ptr_dlam[0*nt0+ll], i_mask, v_dlam0 );
+			_mm256_maskstore_pd( &ptr_dlam[1*nt0+ll], i_mask, v_dlam1 );
+			v_qx0   = _mm256_loadu_pd( &ptr_db[0*nt0+ll] );
+			v_qx1   = _mm256_loadu_pd( &ptr_db[1*nt0+ll] );
+			v_qx0   = _mm256_mul_pd( v_qx0, v_lamt0 );
+			v_qx1   = _mm256_mul_pd( v_qx1, v_lamt1 );
 			v_lam0  = _mm256_add_pd( v_lam0, v_dlam0 );
-#endif
-			_mm256_maskstore_pd( &ptr_t[ll+0], i_mask, v_t0 );
-			_mm256_maskstore_pd( &ptr_lam[ll+0], i_mask, v_lam0 );
-#if defined(TARGET_X64_AVX2)
-			v_lam0  = _mm256_blendv_pd( v_zeros, v_lam0, v_mask );
-			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
-#else
-			v_lam0  = _mm256_mul_pd( v_lam0, v_t0 );
-			v_lam0  = _mm256_blendv_pd( v_zeros, v_lam0, v_mask );
-			v_mu0   = _mm256_add_pd( v_mu0, v_lam0 );
-#endif
+			v_lam1  = _mm256_add_pd( v_lam1, v_dlam1 );
+			v_qx0   = _mm256_add_pd( v_qx0, v_lam0 );
+			v_qx1   = _mm256_sub_pd( v_lam1, v_qx1 );
+			v_Qx0   = _mm256_add_pd( v_lamt0, v_lamt1 );
+			v_qx0   = _mm256_sub_pd( v_qx1, v_qx0 );
+			_mm256_maskstore_pd( &ptr_Qx[ll], i_mask, v_Qx0 );
+			_mm256_maskstore_pd( &ptr_qx[ll], i_mask, v_qx0 );
 			}
 
 		}
@@ -930,7 +1555,7 @@ void d_compute_mu_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, dou
 			v_dt1   = _mm256_loadu_pd( &ptr_dt[ll+4] );
 			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[ll+0] );
 			v_dlam1 = _mm256_loadu_pd( &ptr_dlam[ll+4] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -958,7 +1583,7 @@ void d_compute_mu_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, dou
 			v_lam0  = _mm256_loadu_pd( &ptr_lam[0*nb0+ll] );
 			v_dt0   = _mm256_loadu_pd( &ptr_dt[0*nb0+ll] );
 			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[0*nb0+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
 			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
@@ -982,7 +1607,7 @@ void d_compute_mu_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, dou
 			v_lam0  = _mm256_loadu_pd( &ptr_lam[0*nb0+ll] );
 			v_dt0   = _mm256_loadu_pd( &ptr_dt[0*nb0+ll] );
 			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[0*nb0+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
 			v_lam0  = _mm256_blendv_pd( v_zeros, v_lam0, v_mask );
@@ -1475,7 +2100,7 @@ void d_update_var_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng,
 			{
 			v_pi  = _mm256_loadu_pd( &ptr_pi[ll] );
 			v_dpi = _mm256_loadu_pd( &ptr_dpi[ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_pi  = _mm256_fmadd_pd( v_alpha, v_dpi, v_pi );
 #else
 			v_dpi = _mm256_mul_pd( v_alpha, v_dpi );
@@ -1492,7 +2117,7 @@ void d_update_var_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng,
 
 			v_pi  = _mm256_loadu_pd( &ptr_pi[ll] );
 			v_dpi = _mm256_loadu_pd( &ptr_dpi[ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_pi  = _mm256_fmadd_pd( v_alpha, v_dpi, v_pi );
 #else
 			v_dpi = _mm256_mul_pd( v_alpha, v_dpi );
@@ -1517,7 +2142,7 @@ void d_update_var_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng,
 			{
 			v_ux  = _mm256_loadu_pd( &ptr_ux[ll] );
 			v_dux = _mm256_loadu_pd( &ptr_dux[ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_ux    = _mm256_fmadd_pd( v_alpha, v_dux, v_ux );
 #else
 			v_dux = _mm256_mul_pd( v_alpha, v_dux );
@@ -1534,7 +2159,7 @@ void d_update_var_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng,
 
 			v_ux  = _mm256_loadu_pd( &ptr_ux[ll] );
 			v_dux = _mm256_loadu_pd( &ptr_dux[ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_ux    = _mm256_fmadd_pd( v_alpha, v_dux, v_ux );
 #else
 			v_dux = _mm256_mul_pd( v_alpha, v_dux );
@@ -1569,7 +2194,7 @@ void d_update_var_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng,
 			v_dt1   = _mm256_loadu_pd( &ptr_dt[ll+4] );
 			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[ll+0] );
 			v_dlam1 = _mm256_loadu_pd( &ptr_dlam[ll+4] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -1595,7 +2220,7 @@ void d_update_var_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng,
 			v_lam0  = _mm256_loadu_pd( &ptr_lam[ll+0] );
 			v_dt0   = _mm256_loadu_pd( &ptr_dt[ll+0] );
 			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[ll+0] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
 #else
@@ -1619,7 +2244,7 @@ void d_update_var_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng,
 			v_lam0  = _mm256_loadu_pd( &ptr_lam[ll+0] );
 			v_dt0   = _mm256_loadu_pd( &ptr_dt[ll+0] );
 			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[ll+0] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
 #else
@@ -1689,7 +2314,7 @@ void d_backup_update_var_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, i
 			v_pi  = _mm256_loadu_pd( &ptr_pi[ll] );
 			v_dpi = _mm256_loadu_pd( &ptr_dpi[ll] );
 			_mm256_storeu_pd( &ptr_pi_bkp[ll], v_pi );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_pi  = _mm256_fmadd_pd( v_alpha, v_dpi, v_pi );
 #else
 			v_dpi = _mm256_mul_pd( v_alpha, v_dpi );
@@ -1707,7 +2332,7 @@ void d_backup_update_var_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, i
 			v_pi  = _mm256_loadu_pd( &ptr_pi[ll] );
 			v_dpi = _mm256_loadu_pd( &ptr_dpi[ll] );
 			_mm256_maskstore_pd( &ptr_pi_bkp[ll], i_mask, v_pi );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_pi  = _mm256_fmadd_pd( v_alpha, v_dpi, v_pi );
 #else
 			v_dpi = _mm256_mul_pd( v_alpha, v_dpi );
@@ -1734,7 +2359,7 @@ void d_backup_update_var_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, i
 			v_ux  = _mm256_loadu_pd( &ptr_ux[ll] );
 			v_dux = _mm256_loadu_pd( &ptr_dux[ll] );
 			_mm256_storeu_pd( &ptr_ux_bkp[ll], v_ux );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_ux    = _mm256_fmadd_pd( v_alpha, v_dux, v_ux );
 #else
 			v_dux = _mm256_mul_pd( v_alpha, v_dux );
@@ -1752,7 +2377,7 @@ void d_backup_update_var_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, i
 			v_ux  = _mm256_loadu_pd( &ptr_ux[ll] );
 			v_dux = _mm256_loadu_pd( &ptr_dux[ll] );
 			_mm256_maskstore_pd( &ptr_ux_bkp[ll], i_mask, v_ux );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_ux    = _mm256_fmadd_pd( v_alpha, v_dux, v_ux );
 #else
 			v_dux = _mm256_mul_pd( v_alpha, v_dux );
@@ -1794,7 +2419,7 @@ void d_backup_update_var_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, i
 			_mm256_storeu_pd( &ptr_t_bkp[ll+4], v_t1 );
 			_mm256_storeu_pd( &ptr_lam_bkp[ll+0], v_lam0 );
 			_mm256_storeu_pd( &ptr_lam_bkp[ll+4], v_lam1 );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -1822,7 +2447,7 @@ void d_backup_update_var_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, i
 			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[ll+0] );
 			_mm256_storeu_pd( &ptr_t_bkp[ll+0], v_t0 );
 			_mm256_storeu_pd( &ptr_lam_bkp[ll+0], v_lam0 );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
 #else
@@ -1848,7 +2473,7 @@ void d_backup_update_var_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, i
 			v_dlam0 = _mm256_loadu_pd( &ptr_dlam[ll+0] );
 			_mm256_maskstore_pd( &ptr_t_bkp[ll+0], i_mask, v_t0 );
 			_mm256_maskstore_pd( &ptr_lam_bkp[ll+0], i_mask, v_lam0 );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
 #else
@@ -1950,6 +2575,83 @@ void d_compute_centering_correction_res_mpc_hard_libstr(int N, int *nb, int *ng,
 
 
 
+void d_compute_gondzio_correction_res_mpc_hard_libstr(int N, int *nb, int *ng, double alpha, double mu_min, double mu_max, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hsres_m)
+	{
+
+	int ii, jj;
+
+	int nt0;
+
+	double
+		*ptr_res_m, *ptr_t, *ptr_dt, *ptr_lam, *ptr_dlam;
+	
+	double mmu_max = - mu_max;
+
+	__m256d
+		v_alpha, v_mu_min, v_mu_max, v_mmu_max, v_zeros,
+		v_t0, v_lam0, v_tmp0, v_cor0, v_resm0;
+	
+	__m256i
+		i_mask;
+	
+	double ii_left;
+
+	static double d_mask[4] = {0.5, 1.5, 2.5, 3.5};
+
+	v_alpha   = _mm256_broadcast_sd( &alpha );
+	v_mu_min  = _mm256_broadcast_sd( &mu_min );
+	v_mu_max  = _mm256_broadcast_sd( &mu_max );
+	v_mmu_max = _mm256_broadcast_sd( &mmu_max );
+	v_zeros   = _mm256_setzero_pd( );
+
+	for(ii=0; ii<=N; ii++)
+		{
+
+		ptr_res_m = hsres_m[ii].pa;
+		ptr_t     = hst[ii].pa;
+		ptr_dt    = hsdt[ii].pa;
+		ptr_lam   = hslam[ii].pa;
+		ptr_dlam  = hsdlam[ii].pa;
+
+		nt0 = nb[ii]+ng[ii];
+
+		jj = 0;
+		for(; jj<2*nt0-3; jj+=4)
+			{
+			// complementarity products at the trial step
+			v_t0    = _mm256_add_pd( _mm256_loadu_pd( &ptr_t[jj+0] ), _mm256_mul_pd( v_alpha, _mm256_loadu_pd( &ptr_dt[jj+0] ) ) );
+			v_lam0  = _mm256_add_pd( _mm256_loadu_pd( &ptr_lam[jj+0] ), _mm256_mul_pd( v_alpha, _mm256_loadu_pd( &ptr_dlam[jj+0] ) ) );
+			v_tmp0  = _mm256_mul_pd( v_t0, v_lam0 );
+			// project onto [mu_min, mu_max], limiting the correction of large products
+			v_cor0  = _mm256_max_pd( _mm256_sub_pd( v_mu_min, v_tmp0 ), v_zeros );
+			v_tmp0  = _mm256_max_pd( _mm256_min_pd( _mm256_sub_pd( v_mu_max, v_tmp0 ), v_zeros ), v_mmu_max );
+			v_cor0  = _mm256_add_pd( v_cor0, v_tmp0 );
+			v_resm0 = _mm256_loadu_pd( &ptr_res_m[jj+0] );
+			v_resm0 = _mm256_sub_pd( v_resm0, v_cor0 );
+			_mm256_storeu_pd( &ptr_res_m[jj+0], v_resm0 );
+			}
+		if(jj<2*nt0)
+			{
+			ii_left = 2*nt0-jj;
+			i_mask  = _mm256_castpd_si256( _mm256_sub_pd( _mm256_loadu_pd( d_mask ), _mm256_broadcast_sd( &ii_left ) ) );
+
+			v_t0    = _mm256_add_pd( _mm256_maskload_pd( &ptr_t[jj+0], i_mask ), _mm256_mul_pd( v_alpha, _mm256_maskload_pd( &ptr_dt[jj+0], i_mask ) ) );
+			v_lam0  = _mm256_add_pd( _mm256_maskload_pd( &ptr_lam[jj+0], i_mask ), _mm256_mul_pd( v_alpha, _mm256_maskload_pd( &ptr_dlam[jj+0], i_mask ) ) );
+			v_tmp0  = _mm256_mul_pd( v_t0, v_lam0 );
+			v_cor0  = _mm256_max_pd( _mm256_sub_pd( v_mu_min, v_tmp0 ), v_zeros );
+			v_tmp0  = _mm256_max_pd( _mm256_min_pd( _mm256_sub_pd( v_mu_max, v_tmp0 ), v_zeros ), v_mmu_max );
+			v_cor0  = _mm256_add_pd( v_cor0, v_tmp0 );
+			v_resm0 = _mm256_maskload_pd( &ptr_res_m[jj+0], i_mask );
+			v_resm0 = _mm256_sub_pd( v_resm0, v_cor0 );
+			_mm256_maskstore_pd( &ptr_res_m[jj+0], i_mask, v_resm0 );
+			}
+
+		}
+
+	}
+
+
+
 void d_update_gradient_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, struct blasfeo_dvec *hsres_d, struct blasfeo_dvec *hsres_m, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hstinv, struct blasfeo_dvec *hsqx)
 	{
 	
@@ -1482,7 +1482,7 @@ void d_update_var_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			v_pi  = _mm256_load_pd( &ptr_pi[ll] );
 			v_dpi = _mm256_load_pd( &ptr_dpi[ll] );
 			v_dpi = _mm256_sub_pd( v_dpi, v_pi );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_pi  = _mm256_fmadd_pd( v_alpha, v_dpi, v_pi );
 #else
 			v_dpi = _mm256_mul_pd( v_alpha, v_dpi );
@@ -1500,7 +1500,7 @@ void d_update_var_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			v_pi  = _mm256_load_pd( &ptr_pi[ll] );
 			v_dpi = _mm256_load_pd( &ptr_dpi[ll] );
 			v_dpi = _mm256_sub_pd( v_dpi, v_pi );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_pi  = _mm256_fmadd_pd( v_alpha, v_dpi, v_pi );
 #else
 			v_dpi = _mm256_mul_pd( v_alpha, v_dpi );
@@ -1515,7 +1515,7 @@ void d_update_var_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			v_ux  = _mm256_load_pd( &ptr_ux[ll] );
 			v_dux = _mm256_load_pd( &ptr_dux[ll] );
 			v_dux = _mm256_sub_pd( v_dux, v_ux );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_ux    = _mm256_fmadd_pd( v_alpha, v_dux, v_ux );
 #else
 			v_dux = _mm256_mul_pd( v_alpha, v_dux );
@@ -1533,7 +1533,7 @@ void d_update_var_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			v_ux  = _mm256_load_pd( &ptr_ux[ll] );
 			v_dux = _mm256_load_pd( &ptr_dux[ll] );
 			v_dux = _mm256_sub_pd( v_dux, v_ux );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_ux    = _mm256_fmadd_pd( v_alpha, v_dux, v_ux );
 #else
 			v_dux = _mm256_mul_pd( v_alpha, v_dux );
@@ -1555,7 +1555,7 @@ void d_update_var_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			v_dt1   = _mm256_load_pd( &ptr_dt[1*pnb+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[0*pnb+ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*pnb+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -1574,7 +1574,7 @@ void d_update_var_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			_mm256_store_pd( &ptr_t[1*pnb+ll], v_t1 );
 			_mm256_store_pd( &ptr_lam[0*pnb+ll], v_lam0 );
 			_mm256_store_pd( &ptr_lam[1*pnb+ll], v_lam1 );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
 			v_mu1   = _mm256_fmadd_pd( v_lam1, v_t1, v_mu1 );
 #else
@@ -1600,7 +1600,7 @@ void d_update_var_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			v_dt1   = _mm256_load_pd( &ptr_dt[1*pnb+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[0*pnb+ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*pnb+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -1619,7 +1619,7 @@ void d_update_var_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			_mm256_maskstore_pd( &ptr_t[1*pnb+ll], i_mask, v_t1 );
 			_mm256_maskstore_pd( &ptr_lam[0*pnb+ll], i_mask, v_lam0 );
 			_mm256_maskstore_pd( &ptr_lam[1*pnb+ll], i_mask, v_lam1 );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_lam0  = _mm256_blendv_pd( v_zeros, v_lam0, v_mask );
 			v_lam1  = _mm256_blendv_pd( v_zeros, v_lam1, v_mask );
 			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
@@ -1652,7 +1652,7 @@ void d_update_var_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			v_dt1   = _mm256_load_pd( &ptr_dt[1*png+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[0*png+ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*png+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -1671,7 +1671,7 @@ void d_update_var_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			_mm256_store_pd( &ptr_t[1*png+ll], v_t1 );
 			_mm256_store_pd( &ptr_lam[0*png+ll], v_lam0 );
 			_mm256_store_pd( &ptr_lam[1*png+ll], v_lam1 );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
 			v_mu1   = _mm256_fmadd_pd( v_lam1, v_t1, v_mu1 );
 #else
@@ -1698,7 +1698,7 @@ void d_update_var_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			v_dt1   = _mm256_load_pd( &ptr_dt[1*png+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[0*png+ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*png+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -1717,7 +1717,7 @@ void d_update_var_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			_mm256_maskstore_pd( &ptr_t[1*png+ll], i_mask, v_t1 );
 			_mm256_maskstore_pd( &ptr_lam[0*png+ll], i_mask, v_lam0 );
 			_mm256_maskstore_pd( &ptr_lam[1*png+ll], i_mask, v_lam1 );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_lam0  = _mm256_blendv_pd( v_zeros, v_lam0, v_mask );
 			v_lam1  = _mm256_blendv_pd( v_zeros, v_lam1, v_mask );
 			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
@@ -1759,7 +1759,7 @@ void d_update_var_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*pns+ll] );
 			v_dlam2 = _mm256_load_pd( &ptr_dlam[2*pns+ll] );
 			v_dlam3 = _mm256_load_pd( &ptr_dlam[3*pns+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_t2    = _mm256_fmadd_pd( v_alpha, v_dt2, v_t2 );
@@ -1794,7 +1794,7 @@ void d_update_var_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			_mm256_store_pd( &ptr_lam[1*pns+ll], v_lam1 );
 			_mm256_store_pd( &ptr_lam[2*pns+ll], v_lam2 );
 			_mm256_store_pd( &ptr_lam[3*pns+ll], v_lam3 );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
 			v_mu1   = _mm256_fmadd_pd( v_lam1, v_t1, v_mu1 );
 			v_mu0   = _mm256_fmadd_pd( v_lam2, v_t2, v_mu0 );
@@ -1834,7 +1834,7 @@ void d_update_var_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*pns+ll] );
 			v_dlam2 = _mm256_load_pd( &ptr_dlam[2*pns+ll] );
 			v_dlam3 = _mm256_load_pd( &ptr_dlam[3*pns+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_t2    = _mm256_fmadd_pd( v_alpha, v_dt2, v_t2 );
@@ -1869,7 +1869,7 @@ void d_update_var_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			_mm256_maskstore_pd( &ptr_lam[1*pns+ll], i_mask, v_lam1 );
 			_mm256_maskstore_pd( &ptr_lam[2*pns+ll], i_mask, v_lam2 );
 			_mm256_maskstore_pd( &ptr_lam[3*pns+ll], i_mask, v_lam3 );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_lam0  = _mm256_blendv_pd( v_zeros, v_lam0, v_mask );
 			v_lam1  = _mm256_blendv_pd( v_zeros, v_lam1, v_mask );
 			v_mu0   = _mm256_fmadd_pd( v_lam0, v_t0, v_mu0 );
@@ -1964,7 +1964,7 @@ void d_compute_mu_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			v_dt1   = _mm256_load_pd( &ptr_dt[1*pnb+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[0*pnb+ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*pnb+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -2001,7 +2001,7 @@ void d_compute_mu_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			v_dt1   = _mm256_load_pd( &ptr_dt[1*pnb+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[0*pnb+ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*pnb+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -2046,7 +2046,7 @@ void d_compute_mu_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			v_dt1   = _mm256_load_pd( &ptr_dt[png+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[png+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -2083,7 +2083,7 @@ void d_compute_mu_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			v_dt1   = _mm256_load_pd( &ptr_dt[png+ll] );
 			v_dlam0 = _mm256_load_pd( &ptr_dlam[ll] );
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[png+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_lam0  = _mm256_fmadd_pd( v_alpha, v_dlam0, v_lam0 );
@@ -2136,7 +2136,7 @@ void d_compute_mu_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*pns+ll] );
 			v_dlam2 = _mm256_load_pd( &ptr_dlam[2*pns+ll] );
 			v_dlam3 = _mm256_load_pd( &ptr_dlam[3*pns+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_t2    = _mm256_fmadd_pd( v_alpha, v_dt2, v_t2 );
@@ -2199,7 +2199,7 @@ void d_compute_mu_mpc_soft_tv(int N, int *nx, int *nu, int *nb, int *ng, int *ns
 			v_dlam1 = _mm256_load_pd( &ptr_dlam[1*pns+ll] );
 			v_dlam2 = _mm256_load_pd( &ptr_dlam[2*pns+ll] );
 			v_dlam3 = _mm256_load_pd( &ptr_dlam[3*pns+ll] );
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX512)
 			v_t0    = _mm256_fmadd_pd( v_alpha, v_dt0, v_t0 );
 			v_t1    = _mm256_fmadd_pd( v_alpha, v_dt1, v_t1 );
 			v_t2    = _mm256_fmadd_pd( v_alpha, v_dt2, v_t2 );
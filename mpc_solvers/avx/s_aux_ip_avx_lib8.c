@@ -266,14 +266,13 @@ void s_update_hessian_box_mpc(int N, int k0, int k1, int kmax, int cnz, float si
 		v_tmp, v_lam, v_lamt, v_dlam, v_db;
 		
 	__m128
-		u_tmp, u_lamt, u_bd, u_bl, u_lam, u_dlam, u_db;
+		u_lamt, u_bd, u_bl, u_lam;
 	
 	v_ones = _mm256_set_ps( 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 );
 	v_sigma_mu = _mm256_set_ps( sigma_mu, sigma_mu, sigma_mu, sigma_mu, sigma_mu, sigma_mu, sigma_mu, sigma_mu );
 	
 	const int bs = 8; //s_get_mr();
 	
-	float temp0, temp1;
 	
 	float *ptr_t, *ptr_lam, *ptr_lamt, *ptr_dlam, *ptr_t_inv, *ptr_pd, *ptr_pl, *ptr_pl2, *ptr_bd, *ptr_bl, *ptr_db;
 	
@@ -1139,7 +1138,7 @@ void s_update_var_mpc(int nx, int nu, int N, int nb, int nbu, float *ptr_mu, flo
 		u_mu, u_tmp;
 
 	__m256
-		mask, zeros, alpha_mask,
+		mask, zeros, alpha_mask, tmp_mask,
 		v_alpha, v_ux, v_dux, v_pi, v_dpi, v_t, v_dt, v_lam, v_dlam, v_mu;
 		
 	v_alpha = _mm256_set_ps( alpha, alpha, alpha, alpha, alpha, alpha, alpha, alpha );
@@ -1157,24 +1156,24 @@ void s_update_var_mpc(int nx, int nu, int N, int nb, int nbu, float *ptr_mu, flo
 	ll = 0;
 	for(; ll<nu-7; ll+=8)
 		{
-		v_ux  = _mm256_load_ps( &ux[jj][ll] );
-		v_dux = _mm256_load_ps( &dux[jj][ll] );
+		v_ux  = _mm256_load_ps( &ux[0][ll] );
+		v_dux = _mm256_load_ps( &dux[0][ll] );
 		v_dux = _mm256_sub_ps( v_dux, v_ux );
 		v_dux = _mm256_mul_ps( v_alpha, v_dux );
 		v_ux  = _mm256_add_ps( v_ux, v_dux );
-		_mm256_store_ps( &ux[jj][ll], v_ux );
+		_mm256_store_ps( &ux[0][ll], v_ux );
 		}
 	ll_left = nu - ll;
 	if( ll_left>0 )
 		{
 		ll_left_f = 8.0 - ll_left;
 		alpha_mask = _mm256_blendv_ps( v_alpha, zeros, _mm256_sub_ps( mask, _mm256_broadcast_ss( &ll_left_f) ) );
-		v_ux  = _mm256_load_ps( &ux[jj][ll] );
-		v_dux = _mm256_load_ps( &dux[jj][ll] );
+		v_ux  = _mm256_load_ps( &ux[0][ll] );
+		v_dux = _mm256_load_ps( &dux[0][ll] );
 		v_dux = _mm256_sub_ps( v_dux, v_ux );
 		v_dux = _mm256_mul_ps( alpha_mask, v_dux );
 		v_ux  = _mm256_add_ps( v_ux, v_dux );
-		_mm256_store_ps( &ux[jj][ll], v_ux );
+		_mm256_store_ps( &ux[0][ll], v_ux );
 		}
 
 	// box constraints
@@ -1318,13 +1317,14 @@ void s_update_var_mpc(int nx, int nu, int N, int nb, int nbu, float *ptr_mu, flo
 	if( ll_left>0 )
 		{
 		ll_left_f = 8.0 - ll_left;
+		tmp_mask = _mm256_sub_ps( _mm256_broadcast_ss( &ll_left_f ), mask );
 		alpha_mask = _mm256_blendv_ps( v_alpha, zeros, _mm256_sub_ps( mask, _mm256_broadcast_ss( &ll_left_f) ) );
-		v_ux  = _mm256_loadu_ps( &ux[N][nu+ll] );
-		v_dux = _mm256_loadu_ps( &dux[N][nu+ll] );
+		v_ux  = _mm256_maskload_ps( &ux[N][nu+ll], _mm256_castps_si256( tmp_mask ) );
+		v_dux = _mm256_maskload_ps( &dux[N][nu+ll], _mm256_castps_si256( tmp_mask ) );
 		v_dux = _mm256_sub_ps( v_dux, v_ux );
 		v_dux = _mm256_mul_ps( alpha_mask, v_dux );
 		v_ux  = _mm256_add_ps( v_ux, v_dux );
-		_mm256_storeu_ps( &ux[N][nu+ll], v_ux );
+		_mm256_maskstore_ps( &ux[N][nu+ll], _mm256_castps_si256( tmp_mask ), v_ux );
 		}
 
 	// update equality constrained multipliers
@@ -1373,17 +1373,18 @@ void s_update_var_mpc(int nx, int nu, int N, int nb, int nbu, float *ptr_mu, flo
 	if( ll_left>0 )
 		{
 		ll_left_f = 8.0 - ll_left;
+		tmp_mask = _mm256_sub_ps( _mm256_broadcast_ss( &ll_left_f ), mask );
 		alpha_mask = _mm256_blendv_ps( v_alpha, zeros, _mm256_sub_ps( mask, _mm256_broadcast_ss( &ll_left_f) ) );
-		v_t    = _mm256_loadu_ps( &t[N][ll] );
-		v_lam  = _mm256_loadu_ps( &lam[N][ll] );
-		v_dt   = _mm256_loadu_ps( &dt[N][ll] );
-		v_dlam = _mm256_loadu_ps( &dlam[N][ll] );
+		v_t    = _mm256_maskload_ps( &t[N][ll], _mm256_castps_si256( tmp_mask ) );
+		v_lam  = _mm256_maskload_ps( &lam[N][ll], _mm256_castps_si256( tmp_mask ) );
+		v_dt   = _mm256_maskload_ps( &dt[N][ll], _mm256_castps_si256( tmp_mask ) );
+		v_dlam = _mm256_maskload_ps( &dlam[N][ll], _mm256_castps_si256( tmp_mask ) );
 		v_dt   = _mm256_mul_ps( alpha_mask, v_dt );
 		v_dlam = _mm256_mul_ps( alpha_mask, v_dlam );
 		v_t    = _mm256_add_ps( v_t, v_dt );
 		v_lam  = _mm256_add_ps( v_lam, v_dlam );
-		_mm256_storeu_ps( &t[N][ll], v_t );
-		_mm256_storeu_ps( &lam[N][ll], v_lam );
+		_mm256_maskstore_ps( &t[N][ll], _mm256_castps_si256( tmp_mask ), v_t );
+		_mm256_maskstore_ps( &lam[N][ll], _mm256_castps_si256( tmp_mask ), v_lam );
 		v_lam  = _mm256_mul_ps( v_lam, v_t );
 		v_lam = _mm256_blendv_ps( v_lam, zeros, _mm256_sub_ps( mask, _mm256_broadcast_ss( &ll_left_f) ) );
 		v_mu   = _mm256_add_ps( v_mu, v_lam );
@@ -1418,7 +1419,7 @@ void s_compute_mu_mpc(int N, int nbu, int nu, int nb, float *ptr_mu, float mu_sc
 		u_mu, u_tmp;
 
 	__m256
-		mask, zeros, alpha_mask,
+		mask, zeros, tmp_mask,
 		v_alpha, v_t, v_dt, v_lam, v_dlam, v_mu;
 		
 	v_alpha = _mm256_set_ps( alpha, alpha, alpha, alpha, alpha, alpha, alpha, alpha );
@@ -1492,7 +1493,7 @@ void s_compute_mu_mpc(int N, int nbu, int nu, int nb, float *ptr_mu, float mu_sc
 		if( ll_left>0 )
 			{
 			ll_left_f = 8.0 - ll_left;
-			alpha_mask = _mm256_blendv_ps( v_alpha, zeros, _mm256_sub_ps( mask, _mm256_broadcast_ss( &ll_left_f) ) );
+/*			alpha_mask = _mm256_blendv_ps( v_alpha, zeros, _mm256_sub_ps( mask, _mm256_broadcast_ss( &ll_left_f) ) );*/
 			v_t    = _mm256_load_ps( &t[jj][ll] );
 			v_lam  = _mm256_load_ps( &lam[jj][ll] );
 			v_dt   = _mm256_load_ps( &dt[jj][ll] );
@@ -1531,11 +1532,12 @@ void s_compute_mu_mpc(int N, int nbu, int nu, int nb, float *ptr_mu, float mu_sc
 	if( ll_left>0 )
 		{
 		ll_left_f = 8.0 - ll_left;
-		alpha_mask = _mm256_blendv_ps( v_alpha, zeros, _mm256_sub_ps( mask, _mm256_broadcast_ss( &ll_left_f) ) );
-		v_t    = _mm256_loadu_ps( &t[N][ll] );
-		v_lam  = _mm256_loadu_ps( &lam[N][ll] );
-		v_dt   = _mm256_loadu_ps( &dt[N][ll] );
-		v_dlam = _mm256_loadu_ps( &dlam[N][ll] );
+		tmp_mask = _mm256_sub_ps( _mm256_broadcast_ss( &ll_left_f ), mask );
+/*		alpha_mask = _mm256_blendv_ps( v_alpha, zeros, _mm256_sub_ps( mask, _mm256_broadcast_ss( &ll_left_f) ) );*/
+		v_t    = _mm256_maskload_ps( &t[N][ll], _mm256_castps_si256( tmp_mask ) );
+		v_lam  = _mm256_maskload_ps( &lam[N][ll], _mm256_castps_si256( tmp_mask ) );
+		v_dt   = _mm256_maskload_ps( &dt[N][ll], _mm256_castps_si256( tmp_mask ) );
+		v_dlam = _mm256_maskload_ps( &dlam[N][ll], _mm256_castps_si256( tmp_mask ) );
 		v_dt   = _mm256_mul_ps( v_alpha, v_dt );
 		v_dlam = _mm256_mul_ps( v_alpha, v_dlam );
 		v_t    = _mm256_add_ps( v_t, v_dt );
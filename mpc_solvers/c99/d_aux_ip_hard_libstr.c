@@ -64,6 +64,11 @@ void d_init_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, i
 		}
 
 
+	// full warm start: ux, pi, t>0 & lam>0 as given (e.g. by d_shift_warm_start_mpc_hard_libstr)
+	if(warm_start==2)
+		return;
+
+
 	// check bounds & initialize multipliers
 	for(jj=0; jj<=N; jj++)
 		{
@@ -288,6 +293,69 @@ void d_update_gradient_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng
 
 
 
+void d_compute_gondzio_correction_mpc_hard_libstr(int N, int *nb, int *ng, double alpha, double mu_min, double mu_max, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hslamt, struct blasfeo_dvec *hstinv, struct blasfeo_dvec *hsqx)
+	{
+
+	int ii, jj, ll;
+
+	int nt0;
+
+	double
+		*ptr_t, *ptr_dt, *ptr_lam, *ptr_dlam, *ptr_lamt, *ptr_tinv, *ptr_qx;
+	
+	double
+		tmp, cor0, cor1;
+	
+	for(jj=0; jj<=N; jj++)
+		{
+
+		ptr_t     = hst[jj].pa;
+		ptr_dt    = hsdt[jj].pa;
+		ptr_lam   = hslam[jj].pa;
+		ptr_dlam  = hsdlam[jj].pa;
+		ptr_lamt  = hslamt[jj].pa;
+		ptr_tinv  = hstinv[jj].pa;
+		ptr_qx    = hsqx[jj].pa;
+
+		nt0 = nb[jj]+ng[jj];
+
+		for(ii=0; ii<nt0; ii++)
+			{
+
+			// lower constraint
+			ll = ii;
+			// complementarity products at the trial step, projected onto [mu_min, mu_max]
+			tmp = ( ptr_t[ll] + alpha*ptr_dt[ll] ) * ( ptr_lam[ll] + alpha*ptr_dlam[ll] );
+			cor0 = 0.0;
+			if(tmp<mu_min)
+				cor0 = ptr_tinv[ll] * ( mu_min - tmp );
+			else if(tmp>mu_max)
+				cor0 = ptr_tinv[ll] * ( mu_max-tmp<-mu_max ? -mu_max : mu_max-tmp );
+			// right-hand side as left by d_update_gradient_mpc_hard_libstr, plus the correction
+			ptr_dlam[ll] += ptr_lamt[ll] * ptr_dt[ll] + ptr_lam[ll] + cor0;
+
+			// upper constraint
+			ll = ii+nt0;
+			tmp = ( ptr_t[ll] + alpha*ptr_dt[ll] ) * ( ptr_lam[ll] + alpha*ptr_dlam[ll] );
+			cor1 = 0.0;
+			if(tmp<mu_min)
+				cor1 = ptr_tinv[ll] * ( mu_min - tmp );
+			else if(tmp>mu_max)
+				cor1 = ptr_tinv[ll] * ( mu_max-tmp<-mu_max ? -mu_max : mu_max-tmp );
+			ptr_dlam[ll] += ptr_lamt[ll] * ptr_dt[ll] + ptr_lam[ll] + cor1;
+
+			ptr_qx[ii] += cor1 - cor0;
+
+			}
+
+		}
+
+	return;
+
+	}
+
+
+
 void d_compute_alpha_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, double *ptr_alpha, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hslamt, struct blasfeo_dvec *hsdux, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsdb)
 	{
 	
@@ -366,6 +434,97 @@ void d_compute_alpha_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int **idx
 
 
 
+void d_compute_alpha_mu_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, double *ptr_alpha, double *ptr_mu_poly, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hslamt, struct blasfeo_dvec *hsdux, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsdb)
+	{
+	
+	int nu0, nx0, nb0, ng0, nt0;
+
+	double alpha = ptr_alpha[0];
+	
+	double
+		*ptr_db, *ptr_dux, *ptr_t, *ptr_dt, *ptr_lamt, *ptr_lam, *ptr_dlam;
+	
+	int
+		*ptr_idxb;
+	
+	int jj, ll;
+
+	// coefficients of the duality gap as a polynomial in the step length
+	double mu0 = 0.0;
+	double mu1 = 0.0;
+	double mu2 = 0.0;
+
+	for(jj=0; jj<=N; jj++)
+		{
+
+		ptr_db   = hsdb[jj].pa;
+		ptr_dux  = hsdux[jj].pa;
+		ptr_t    = hst[jj].pa;
+		ptr_dt   = hsdt[jj].pa;
+		ptr_lamt = hslamt[jj].pa;
+		ptr_lam  = hslam[jj].pa;
+		ptr_dlam = hsdlam[jj].pa;
+		ptr_idxb = idxb[jj];
+
+		nu0 = nu[jj];
+		nx0 = nx[jj];
+		nb0 = nb[jj];
+		ng0 = ng[jj];
+		nt0 = nb0 + ng0;
+
+		// box constraints // TODO dvecex_libstr
+		for(ll=0; ll<nb0; ll++)
+			ptr_dt[ll] = ptr_dux[ptr_idxb[ll]];
+
+		// general constraints
+		blasfeo_dgemv_t(nx0+nu0, ng0, 1.0, &hsDCt[jj], 0, 0, &hsdux[jj], 0, 0.0, &hsdt[jj], nb0, &hsdt[jj], nb0);
+
+		// all constraints
+		for(ll=0; ll<nt0; ll++)
+			{
+			ptr_dt[ll+nt0] = - ptr_dt[ll];
+			ptr_dt[ll+0]   += - ptr_db[ll+0]   - ptr_t[ll+0];
+			ptr_dt[ll+nt0] +=   ptr_db[ll+nt0] - ptr_t[ll+nt0];
+			ptr_dlam[ll+0]   -= ptr_lamt[ll+0]   * ptr_dt[ll+0]   + ptr_lam[ll+0];
+			ptr_dlam[ll+nt0] -= ptr_lamt[ll+nt0] * ptr_dt[ll+nt0] + ptr_lam[ll+nt0];
+			mu0 += ptr_lam[ll+0] * ptr_t[ll+0] + ptr_lam[ll+nt0] * ptr_t[ll+nt0];
+			mu1 += ptr_lam[ll+0] * ptr_dt[ll+0] + ptr_dlam[ll+0] * ptr_t[ll+0] + ptr_lam[ll+nt0] * ptr_dt[ll+nt0] + ptr_dlam[ll+nt0] * ptr_t[ll+nt0];
+			mu2 += ptr_dlam[ll+0] * ptr_dt[ll+0] + ptr_dlam[ll+nt0] * ptr_dt[ll+nt0];
+			if( -alpha*ptr_dlam[ll+0]>ptr_lam[ll+0] )
+				{
+				alpha = - ptr_lam[ll+0] / ptr_dlam[ll+0];
+				}
+			if( -alpha*ptr_dlam[ll+nt0]>ptr_lam[ll+nt0] )
+				{
+				alpha = - ptr_lam[ll+nt0] / ptr_dlam[ll+nt0];
+				}
+			if( -alpha*ptr_dt[ll+0]>ptr_t[ll+0] )
+				{
+				alpha = - ptr_t[ll+0] / ptr_dt[ll+0];
+				}
+			if( -alpha*ptr_dt[ll+nt0]>ptr_t[ll+nt0] )
+				{
+				alpha = - ptr_t[ll+nt0] / ptr_dt[ll+nt0];
+				}
+
+			}
+
+		}		
+
+	// store alpha
+	ptr_alpha[0] = alpha;
+
+	// store mu(alpha) = mu_poly[0] + alpha*mu_poly[1] + alpha^2*mu_poly[2], not scaled
+	ptr_mu_poly[0] = mu0;
+	ptr_mu_poly[1] = mu1;
+	ptr_mu_poly[2] = mu2;
+
+	return;
+	
+	}
+
+
+
 void d_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, double *ptr_mu, double mu_scal, double alpha, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hsdux, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hsdpi, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam)
 	{
 
@@ -444,6 +603,95 @@ void d_backup_update_var_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *
 
 
 
+void d_backup_update_var_hessian_gradient_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, double *ptr_mu, double mu_scal, double alpha, struct blasfeo_dvec *hsux_bkp, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hsdux, struct blasfeo_dvec *hspi_bkp, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hsdpi, struct blasfeo_dvec *hst_bkp, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam_bkp, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hsdb, double sigma_mu, struct blasfeo_dvec *hstinv, struct blasfeo_dvec *hslamt, struct blasfeo_dvec *hsQx, struct blasfeo_dvec *hsqx)
+	{
+
+	int ii, jj, ll;
+
+	int nt0;
+
+	double
+		*ptr_db, *ptr_Qx, *ptr_qx,
+		*ptr_t_bkp, *ptr_t, *ptr_dt, *ptr_tinv,
+		*ptr_lam_bkp, *ptr_lam, *ptr_dlam, *ptr_lamt;
+
+	double mu = 0.0;
+
+	// backup and update equality constrains multipliers
+	for(ii=1; ii<=N; ii++)
+		{
+		blasfeo_dveccp(nx[ii], &hspi[ii], 0, &hspi_bkp[ii], 0);
+		blasfeo_daxpy(nx[ii], -1.0, &hspi[ii], 0, &hsdpi[ii], 0, &hsdpi[ii], 0);
+		blasfeo_daxpy(nx[ii], alpha, &hsdpi[ii], 0, &hspi[ii], 0, &hspi[ii], 0);
+		}
+
+	// backup and update inputs and states
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_dveccp(nu[ii]+nx[ii], &hsux[ii], 0, &hsux_bkp[ii], 0);
+		blasfeo_daxpy(nu[ii]+nx[ii], -1.0, &hsux[ii], 0, &hsdux[ii], 0, &hsdux[ii], 0);
+		blasfeo_daxpy(nu[ii]+nx[ii], alpha, &hsdux[ii], 0, &hsux[ii], 0, &hsux[ii], 0);
+		}
+
+	// backup and update inequality constraints multipliers and slack variables,
+	// and update cost function matrices and vectors for the next iteration in the same pass
+	for(jj=0; jj<=N; jj++)
+		{
+
+		ptr_t_bkp   = hst_bkp[jj].pa;
+		ptr_t       = hst[jj].pa;
+		ptr_dt      = hsdt[jj].pa;
+		ptr_tinv    = hstinv[jj].pa;
+		ptr_lam_bkp = hslam_bkp[jj].pa;
+		ptr_lam     = hslam[jj].pa;
+		ptr_dlam    = hsdlam[jj].pa;
+		ptr_lamt    = hslamt[jj].pa;
+		ptr_db      = hsdb[jj].pa;
+		ptr_Qx      = hsQx[jj].pa;
+		ptr_qx      = hsqx[jj].pa;
+
+		nt0 = nb[jj] + ng[jj];
+
+		for(ii=0; ii<nt0; ii++)
+			{
+
+			// lower constraint
+			ll = ii;
+			ptr_t_bkp[ll] = ptr_t[ll];
+			ptr_lam_bkp[ll] = ptr_lam[ll];
+			ptr_t[ll] += alpha*ptr_dt[ll];
+			ptr_lam[ll] += alpha*ptr_dlam[ll];
+			mu += ptr_lam[ll] * ptr_t[ll];
+			ptr_tinv[ll] = 1.0/ptr_t[ll];
+			ptr_lamt[ll] = ptr_lam[ll]*ptr_tinv[ll];
+			ptr_dlam[ll] = ptr_tinv[ll]*sigma_mu;
+
+			// upper constraint
+			ll = ii+nt0;
+			ptr_t_bkp[ll] = ptr_t[ll];
+			ptr_lam_bkp[ll] = ptr_lam[ll];
+			ptr_t[ll] += alpha*ptr_dt[ll];
+			ptr_lam[ll] += alpha*ptr_dlam[ll];
+			mu += ptr_lam[ll] * ptr_t[ll];
+			ptr_tinv[ll] = 1.0/ptr_t[ll];
+			ptr_lamt[ll] = ptr_lam[ll]*ptr_tinv[ll];
+			ptr_dlam[ll] = ptr_tinv[ll]*sigma_mu;
+
+			ptr_Qx[ii] = ptr_lamt[ii] + ptr_lamt[ii+nt0];
+			ptr_qx[ii] = ptr_lam[ii+nt0] - ptr_lamt[ii+nt0]*ptr_db[ii+nt0] + ptr_dlam[ii+nt0] - ptr_lam[ii] - ptr_lamt[ii]*ptr_db[ii] - ptr_dlam[ii];
+
+			}
+
+		}
+
+	ptr_mu[0] = mu*mu_scal;
+
+	return;
+
+	}
+
+
+
 void d_compute_mu_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, double *ptr_mu, double mu_scal, double alpha, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt)
 	{
 	
@@ -748,6 +996,46 @@ void d_compute_centering_correction_res_mpc_hard_libstr(int N, int *nb, int *ng,
 
 
 
+void d_compute_gondzio_correction_res_mpc_hard_libstr(int N, int *nb, int *ng, double alpha, double mu_min, double mu_max, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hsres_m)
+	{
+
+	int ii, jj, jjmax;
+
+	double
+		*ptr_res_m, *ptr_t, *ptr_dt, *ptr_lam, *ptr_dlam;
+	
+	double
+		tmp, cor;
+	
+	for(ii=0; ii<=N; ii++)
+		{
+
+		ptr_res_m = hsres_m[ii].pa;
+		ptr_t     = hst[ii].pa;
+		ptr_dt    = hsdt[ii].pa;
+		ptr_lam   = hslam[ii].pa;
+		ptr_dlam  = hsdlam[ii].pa;
+
+		jjmax = 2*nb[ii]+2*ng[ii];
+
+		for(jj=0; jj<jjmax; jj++)
+			{
+			// complementarity products at the trial step
+			tmp = ( ptr_t[jj] + alpha*ptr_dt[jj] ) * ( ptr_lam[jj] + alpha*ptr_dlam[jj] );
+			// project onto [mu_min, mu_max], limiting the correction of large products
+			cor = 0.0;
+			if(tmp<mu_min)
+				cor = mu_min - tmp;
+			else if(tmp>mu_max)
+				cor = mu_max-tmp<-mu_max ? -mu_max : mu_max-tmp;
+			ptr_res_m[jj] -= cor;
+			}
+		}
+
+	}
+
+
+
 void d_update_gradient_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, struct blasfeo_dvec *hsres_d, struct blasfeo_dvec *hsres_m, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst_inv, struct blasfeo_dvec *hsqx)
 	{
 	
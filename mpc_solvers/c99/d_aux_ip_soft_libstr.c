@@ -0,0 +1,507 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <math.h>
+
+#ifdef BLASFEO
+
+#include <blasfeo_target.h>
+#include <blasfeo_common.h>
+#include <blasfeo_d_aux.h>
+#include <blasfeo_d_blas.h>
+
+
+
+// soft constraints layout, at each stage:
+// idxb: [hard boxes (nb) | soft boxes (ns)]
+// d: [lb ls lg | ub us ug], with nt = nb+ns+ng entries each
+// t, lam: [lower (nt) | upper (nt) | lower slack (ns) | upper slack (ns)]
+// Z, z, Zl, zl, res_z: [lower (ns) | upper (ns)]
+// the slack variables are the t of their own positivity constraints
+
+
+
+// initialize variables
+
+void d_init_var_mpc_soft_libstr(int N, int *nx, int *nu, int *nb, int **hidxb, int *ng, int *ns, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hspi, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsdb, struct blasfeo_dvec *hst, struct blasfeo_dvec *hslam, double mu0, int warm_start)
+	{
+
+	int jj, ll, ii;
+
+	double *ptr_ux, *ptr_pi, *ptr_db, *ptr_t, *ptr_lam;
+
+	int nb0, ns0, ng0, nbs0, nt0;
+
+	double tl, tu;
+	
+	double thr0 = 0.1; // minimum vale of t (minimum distance from a constraint)
+
+
+	// cold start
+	if(warm_start==0)
+		{
+		for(jj=0; jj<=N; jj++)
+			{
+			ptr_ux = hsux[jj].pa;
+			for(ll=0; ll<nu[jj]+nx[jj]; ll++)
+				{
+				ptr_ux[ll] = 0.0;
+				}
+			}
+		}
+
+
+	// full warm start: ux, pi, t>0 & lam>0 as given
+	if(warm_start==2)
+		return;
+
+
+	// check bounds & initialize multipliers
+	for(jj=0; jj<=N; jj++)
+		{
+		nb0 = nb[jj];
+		ns0 = ns[jj];
+		nbs0 = nb0+ns0;
+		nt0 = nbs0+ng[jj];
+		ptr_ux = hsux[jj].pa;
+		ptr_db = hsdb[jj].pa;
+		ptr_lam = hslam[jj].pa;
+		ptr_t = hst[jj].pa;
+		// hard boxes: move ux inside the bounds
+		for(ll=0; ll<nb0; ll++)
+			{
+			ptr_t[ll]     = - ptr_db[ll]     + ptr_ux[hidxb[jj][ll]];
+			ptr_t[nt0+ll] =   ptr_db[nt0+ll] - ptr_ux[hidxb[jj][ll]];
+			if(ptr_t[ll] < thr0)
+				{
+				if(ptr_t[nt0+ll] < thr0)
+					{
+					ptr_ux[hidxb[jj][ll]] = ( - ptr_db[nt0+ll] + ptr_db[ll])*0.5;
+					ptr_t[ll]     = thr0;
+					ptr_t[nt0+ll] = thr0;
+					}
+				else
+					{
+					ptr_t[ll] = thr0;
+					ptr_ux[hidxb[jj][ll]] = ptr_db[ll] + thr0;
+					}
+				}
+			else if(ptr_t[nt0+ll] < thr0)
+				{
+				ptr_t[nt0+ll] = thr0;
+				ptr_ux[hidxb[jj][ll]] = ptr_db[nt0+ll] - thr0;
+				}
+			ptr_lam[ll]     = mu0/ptr_t[ll];
+			ptr_lam[nt0+ll] = mu0/ptr_t[nt0+ll];
+			}
+		// soft boxes: leave ux alone, the slacks absorb the violation
+		for(ii=0; ii<ns0; ii++)
+			{
+			ll = nb0+ii;
+			tl = - ptr_db[ll]     + ptr_ux[hidxb[jj][ll]];
+			tu =   ptr_db[nt0+ll] - ptr_ux[hidxb[jj][ll]];
+			ptr_t[2*nt0+ii]     = fmax( thr0, thr0-tl );
+			ptr_t[2*nt0+ns0+ii] = fmax( thr0, thr0-tu );
+			ptr_t[ll]     = tl + ptr_t[2*nt0+ii];
+			ptr_t[nt0+ll] = tu + ptr_t[2*nt0+ns0+ii];
+			ptr_lam[ll]             = mu0/ptr_t[ll];
+			ptr_lam[nt0+ll]         = mu0/ptr_t[nt0+ll];
+			ptr_lam[2*nt0+ii]       = mu0/ptr_t[2*nt0+ii];
+			ptr_lam[2*nt0+ns0+ii]   = mu0/ptr_t[2*nt0+ns0+ii];
+			}
+		}
+
+
+	// initialize pi
+	for(jj=1; jj<=N; jj++)
+		{
+		ptr_pi = hspi[jj].pa;
+		for(ll=0; ll<nx[jj]; ll++)
+			ptr_pi[ll] = 0.0; // initialize multipliers to zero
+		}
+
+
+	// general constraints
+	for(jj=0; jj<=N; jj++)
+		{
+		nbs0 = nb[jj] + ns[jj];
+		ng0 = ng[jj];
+		nt0 = nbs0 + ng0;
+		if(ng0>0)
+			{
+			ptr_t   = hst[jj].pa;
+			ptr_lam = hslam[jj].pa;
+			ptr_db  = hsdb[jj].pa;
+			blasfeo_dgemv_t(nu[jj]+nx[jj], ng0, 1.0, &hsDCt[jj], 0, 0, &hsux[jj], 0, 0.0, &hst[jj], nbs0, &hst[jj], nbs0);
+			for(ll=nbs0; ll<nt0; ll++)
+				{
+				ptr_t[ll+nt0] = - ptr_t[ll];
+				ptr_t[ll]     -= ptr_db[ll];
+				ptr_t[ll+nt0] += ptr_db[ll+nt0];
+				ptr_t[ll]     = fmax( thr0, ptr_t[ll] );
+				ptr_t[nt0+ll] = fmax( thr0, ptr_t[nt0+ll] );
+				ptr_lam[ll]     = mu0/ptr_t[ll];
+				ptr_lam[nt0+ll] = mu0/ptr_t[nt0+ll];
+				}
+			}
+		}
+
+	}
+
+
+
+// IPM with residuals
+
+// the slack variables are eliminated stage-wise: their Hessian is diagonal, so the reduced Hessian and gradient
+// only update the diagonal Qx and qx entries of the soft boxes, and the hard Riccati recursion is used as is
+void d_update_hessian_gradient_res_mpc_soft_libstr(int N, int *nx, int *nu, int *nb, int *ng, int *ns, struct blasfeo_dvec *hsres_d, struct blasfeo_dvec *hsres_m, struct blasfeo_dvec *hsres_z, struct blasfeo_dvec *hst, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst_inv, struct blasfeo_dvec *hsZ, struct blasfeo_dvec *hsZl, struct blasfeo_dvec *hszl, struct blasfeo_dvec *hsQx, struct blasfeo_dvec *hsqx)
+	{
+	
+	int nb0, ns0, nt0;
+	
+	double Ql, Qu, gl, gu;
+	
+	double 
+		*ptr_res_d, *ptr_Qx, *ptr_qx, *ptr_t, *ptr_lam, *ptr_res_m, *ptr_t_inv, *ptr_res_z, *ptr_Z, *ptr_Zl, *ptr_zl;
+	
+	int ii, jj, ll;
+	
+	for(jj=0; jj<=N; jj++)
+		{
+		
+		ptr_t     = hst[jj].pa;
+		ptr_lam   = hslam[jj].pa;
+		ptr_t_inv = hst_inv[jj].pa;
+		ptr_res_d = hsres_d[jj].pa;
+		ptr_res_m = hsres_m[jj].pa;
+		ptr_Qx    = hsQx[jj].pa;
+		ptr_qx    = hsqx[jj].pa;
+
+		nb0 = nb[jj];
+		ns0 = ns[jj];
+		nt0 = nb0 + ns0 + ng[jj];
+
+		for(ii=0; ii<nt0; ii++)
+			{
+			ptr_t_inv[ii+0] = 1.0/ptr_t[ii+0];
+			ptr_t_inv[ii+nt0] = 1.0/ptr_t[ii+nt0];
+			ptr_Qx[ii] = ptr_t_inv[ii+0]*ptr_lam[ii+0] + ptr_t_inv[ii+nt0]*ptr_lam[ii+nt0];
+			ptr_qx[ii] = ptr_t_inv[ii+0]*(ptr_res_m[ii+0]-ptr_lam[ii+0]*ptr_res_d[ii+0]) - ptr_t_inv[ii+nt0]*(ptr_res_m[ii+nt0]+ptr_lam[ii+nt0]*ptr_res_d[ii+nt0]);
+			}
+
+		if(ns0>0)
+			{
+
+			ptr_res_z = hsres_z[jj].pa;
+			ptr_Z     = hsZ[jj].pa;
+			ptr_Zl    = hsZl[jj].pa;
+			ptr_zl    = hszl[jj].pa;
+
+			for(ii=0; ii<2*ns0; ii++)
+				ptr_t_inv[2*nt0+ii] = 1.0/ptr_t[2*nt0+ii];
+
+			for(ii=0; ii<ns0; ii++)
+				{
+				ll = nb0+ii;
+
+				Ql = ptr_t_inv[ll]*ptr_lam[ll];
+				Qu = ptr_t_inv[ll+nt0]*ptr_lam[ll+nt0];
+				gl = ptr_t_inv[ll]*(ptr_res_m[ll]-ptr_lam[ll]*ptr_res_d[ll]);
+				gu = ptr_t_inv[ll+nt0]*(ptr_res_m[ll+nt0]+ptr_lam[ll+nt0]*ptr_res_d[ll+nt0]);
+
+				ptr_Zl[ii]     = 1.0 / ( ptr_Z[ii]     + Ql + ptr_t_inv[2*nt0+ii]*ptr_lam[2*nt0+ii] );
+				ptr_Zl[ns0+ii] = 1.0 / ( ptr_Z[ns0+ii] + Qu + ptr_t_inv[2*nt0+ns0+ii]*ptr_lam[2*nt0+ns0+ii] );
+				ptr_zl[ii]     = ptr_res_z[ii]     + gl + ptr_t_inv[2*nt0+ii]*ptr_res_m[2*nt0+ii];
+				ptr_zl[ns0+ii] = ptr_res_z[ns0+ii] + gu + ptr_t_inv[2*nt0+ns0+ii]*ptr_res_m[2*nt0+ns0+ii];
+
+				ptr_Qx[ll] -= Ql*Ql*ptr_Zl[ii] + Qu*Qu*ptr_Zl[ns0+ii];
+				ptr_qx[ll] += - Ql*ptr_zl[ii]*ptr_Zl[ii] + Qu*ptr_zl[ns0+ii]*ptr_Zl[ns0+ii];
+				}
+
+			}
+
+		}
+
+	return;
+
+	}
+
+
+
+void d_update_gradient_res_mpc_soft_libstr(int N, int *nx, int *nu, int *nb, int *ng, int *ns, struct blasfeo_dvec *hsres_d, struct blasfeo_dvec *hsres_m, struct blasfeo_dvec *hsres_z, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst_inv, struct blasfeo_dvec *hsZl, struct blasfeo_dvec *hszl, struct blasfeo_dvec *hsqx)
+	{
+	
+	int nb0, ns0, nt0;
+	
+	double Ql, Qu, gl, gu;
+	
+	double 
+		*ptr_res_d, *ptr_qx, *ptr_lam, *ptr_res_m, *ptr_t_inv, *ptr_res_z, *ptr_Zl, *ptr_zl;
+	
+	int ii, jj, ll;
+	
+	for(jj=0; jj<=N; jj++)
+		{
+		
+		ptr_lam   = hslam[jj].pa;
+		ptr_t_inv = hst_inv[jj].pa;
+		ptr_res_d = hsres_d[jj].pa;
+		ptr_res_m = hsres_m[jj].pa;
+		ptr_qx    = hsqx[jj].pa;
+
+		nb0 = nb[jj];
+		ns0 = ns[jj];
+		nt0 = nb0 + ns0 + ng[jj];
+
+		for(ii=0; ii<nt0; ii++)
+			{
+			ptr_qx[ii] = ptr_t_inv[ii+0]*(ptr_res_m[ii+0]-ptr_lam[ii+0]*ptr_res_d[ii+0]) - ptr_t_inv[ii+nt0]*(ptr_res_m[ii+nt0]+ptr_lam[ii+nt0]*ptr_res_d[ii+nt0]);
+			}
+
+		if(ns0>0)
+			{
+
+			ptr_res_z = hsres_z[jj].pa;
+			ptr_Zl    = hsZl[jj].pa;
+			ptr_zl    = hszl[jj].pa;
+
+			for(ii=0; ii<ns0; ii++)
+				{
+				ll = nb0+ii;
+
+				Ql = ptr_t_inv[ll]*ptr_lam[ll];
+				Qu = ptr_t_inv[ll+nt0]*ptr_lam[ll+nt0];
+				gl = ptr_t_inv[ll]*(ptr_res_m[ll]-ptr_lam[ll]*ptr_res_d[ll]);
+				gu = ptr_t_inv[ll+nt0]*(ptr_res_m[ll+nt0]+ptr_lam[ll+nt0]*ptr_res_d[ll+nt0]);
+
+				ptr_zl[ii]     = ptr_res_z[ii]     + gl + ptr_t_inv[2*nt0+ii]*ptr_res_m[2*nt0+ii];
+				ptr_zl[ns0+ii] = ptr_res_z[ns0+ii] + gu + ptr_t_inv[2*nt0+ns0+ii]*ptr_res_m[2*nt0+ns0+ii];
+
+				ptr_qx[ll] += - Ql*ptr_zl[ii]*ptr_Zl[ii] + Qu*ptr_zl[ns0+ii]*ptr_Zl[ns0+ii];
+				}
+
+			}
+
+		}
+
+	return;
+
+	}
+
+
+
+void d_compute_alpha_res_mpc_soft_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, int *ns, struct blasfeo_dvec *hsdux, struct blasfeo_dvec *hst, struct blasfeo_dvec *hst_inv, struct blasfeo_dvec *hslam, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsres_d, struct blasfeo_dvec *hsres_m, struct blasfeo_dvec *hsZl, struct blasfeo_dvec *hszl, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hsdlam, double *ptr_alpha)
+	{
+	
+	int nu0, nx0, nb0, ns0, nbs0, ng0, nt0;
+
+	double alpha = ptr_alpha[0];
+
+	double Ql, Qu;
+	
+	double
+		*ptr_res_d, *ptr_res_m, *ptr_dux, *ptr_t, *ptr_t_inv, *ptr_dt, *ptr_lam, *ptr_dlam, *ptr_Zl, *ptr_zl;
+	
+	int
+		*ptr_idxb;
+	
+	int ii, jj, ll;
+
+	for(jj=0; jj<=N; jj++)
+		{
+
+		ptr_res_d = hsres_d[jj].pa;
+		ptr_res_m = hsres_m[jj].pa;
+		ptr_dux   = hsdux[jj].pa;
+		ptr_t     = hst[jj].pa;
+		ptr_t_inv = hst_inv[jj].pa;
+		ptr_dt    = hsdt[jj].pa;
+		ptr_lam   = hslam[jj].pa;
+		ptr_dlam  = hsdlam[jj].pa;
+		ptr_idxb  = idxb[jj];
+
+		nu0 = nu[jj];
+		nx0 = nx[jj];
+		nb0 = nb[jj];
+		ns0 = ns[jj];
+		nbs0 = nb0 + ns0;
+		ng0 = ng[jj];
+		nt0 = nbs0 + ng0;
+
+		// box constraints
+		for(ll=0; ll<nbs0; ll++)
+			ptr_dt[ll] = ptr_dux[ptr_idxb[ll]];
+
+		// general constraints
+		blasfeo_dgemv_t(nx0+nu0, ng0, 1.0, &hsDCt[jj], 0, 0, &hsdux[jj], 0, 0.0, &hsdt[jj], nbs0, &hsdt[jj], nbs0);
+
+		// recover the slack variables step
+		if(ns0>0)
+			{
+			ptr_Zl = hsZl[jj].pa;
+			ptr_zl = hszl[jj].pa;
+			for(ii=0; ii<ns0; ii++)
+				{
+				ll = nb0+ii;
+				Ql = ptr_t_inv[ll]*ptr_lam[ll];
+				Qu = ptr_t_inv[ll+nt0]*ptr_lam[ll+nt0];
+				ptr_dt[2*nt0+ii]     = - ( ptr_zl[ii] + Ql*ptr_dt[ll] ) * ptr_Zl[ii];
+				ptr_dt[2*nt0+ns0+ii] = ( Qu*ptr_dt[ll] - ptr_zl[ns0+ii] ) * ptr_Zl[ns0+ii];
+				}
+			}
+
+		for(ll=0; ll<nt0; ll++)
+			{
+			ptr_dt[ll+nt0] = - ptr_dt[ll];
+			ptr_dt[ll+0]   -= ptr_res_d[ll+0];
+			ptr_dt[ll+nt0] += ptr_res_d[ll+nt0];
+			}
+
+		for(ii=0; ii<ns0; ii++)
+			{
+			ptr_dt[nb0+ii]     += ptr_dt[2*nt0+ii];
+			ptr_dt[nt0+nb0+ii] += ptr_dt[2*nt0+ns0+ii];
+			}
+
+		for(ll=0; ll<2*nt0+2*ns0; ll++)
+			{
+
+			ptr_dlam[ll] = - ptr_t_inv[ll] * ( ptr_lam[ll]*ptr_dt[ll] + ptr_res_m[ll] );
+
+			if( -alpha*ptr_dlam[ll]>ptr_lam[ll] )
+				{
+				alpha = - ptr_lam[ll] / ptr_dlam[ll];
+				}
+			if( -alpha*ptr_dt[ll]>ptr_t[ll] )
+				{
+				alpha = - ptr_t[ll] / ptr_dt[ll];
+				}
+
+			}
+
+		}		
+
+	// store alpha
+	ptr_alpha[0] = alpha;
+
+	return;
+	
+	}
+
+
+
+void d_compute_mu_mpc_soft_libstr(int N, int *nx, int *nu, int *nb, int *ng, int *ns, double *ptr_mu, double mu_scal, double alpha, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt)
+	{
+	
+	int jj, ll, llmax;
+	
+	double
+		*ptr_t, *ptr_lam, *ptr_dt, *ptr_dlam;
+		
+	double mu = 0;
+	
+	for(jj=0; jj<=N; jj++)
+		{
+		
+		ptr_t    = hst[jj].pa;
+		ptr_lam  = hslam[jj].pa;
+		ptr_dt   = hsdt[jj].pa;
+		ptr_dlam = hsdlam[jj].pa;
+
+		llmax = 2*nb[jj]+2*ng[jj]+4*ns[jj];
+
+		for(ll=0; ll<llmax; ll++)
+			{
+			mu += (ptr_lam[ll] + alpha*ptr_dlam[ll]) * (ptr_t[ll] + alpha*ptr_dt[ll]);
+			}
+
+		}
+
+	// scale mu
+	mu *= mu_scal;
+		
+	ptr_mu[0] = mu;
+
+	return;
+
+	}
+
+
+
+void d_compute_centering_correction_res_mpc_soft_libstr(int N, int *nb, int *ng, int *ns, double sigma_mu, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hsres_m)
+	{
+
+	int ii, jj, jjmax;
+
+	double
+		*ptr_res_m, *ptr_dt, *ptr_dlam;
+	
+	for(ii=0; ii<=N; ii++)
+		{
+
+		ptr_res_m = hsres_m[ii].pa;
+		ptr_dt    = hsdt[ii].pa;
+		ptr_dlam  = hsdlam[ii].pa;
+
+		jjmax = 2*nb[ii]+2*ng[ii]+4*ns[ii];
+
+		for(jj=0; jj<jjmax; jj++)
+			{
+			ptr_res_m[jj] += ptr_dt[jj] * ptr_dlam[jj] - sigma_mu;
+			}
+		}
+
+	}
+
+
+
+void d_update_var_res_mpc_soft_libstr(int N, int *nx, int *nu, int *nb, int *ng, int *ns, double alpha, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hsdux, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hsdpi, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsdlam)
+	{
+
+	int ii;
+	
+	// update equality constrains multipliers
+	for(ii=1; ii<=N; ii++)
+		blasfeo_daxpy(nx[ii], alpha, &hsdpi[ii], 0, &hspi[ii], 0, &hspi[ii], 0);
+
+	// update inputs and states
+	for(ii=0; ii<=N; ii++)
+		blasfeo_daxpy(nu[ii]+nx[ii], alpha, &hsdux[ii], 0, &hsux[ii], 0, &hsux[ii], 0);
+
+	// update inequality constraints multipliers
+	for(ii=0; ii<=N; ii++)
+		blasfeo_daxpy(2*nb[ii]+2*ng[ii]+4*ns[ii], alpha, &hsdlam[ii], 0, &hslam[ii], 0, &hslam[ii], 0);
+
+	// update slack variables (the soft constraints slacks included)
+	for(ii=0; ii<=N; ii++)
+		blasfeo_daxpy(2*nb[ii]+2*ng[ii]+4*ns[ii], alpha, &hsdt[ii], 0, &hst[ii], 0, &hst[ii], 0);
+
+	return;
+	
+	}
+
+
+
+#endif
@@ -259,7 +259,6 @@ void s_update_hessian_box_mpc(int N, int k0, int k1, int kmax, int cnz, float si
 
 	const int bs = 4; //d_get_mr();
 	
-	float temp0, temp1;
 	
 	float *ptr_t, *ptr_lam, *ptr_lamt, *ptr_dlam, *ptr_tinv, *ptr_pd, *ptr_pl, *ptr_pl2, *ptr_bd, *ptr_bl, *ptr_db;
 	
@@ -541,11 +540,8 @@ void s_update_hessian_box_mpc(int N, int k0, int k1, int kmax, int cnz, float si
 void s_compute_alpha_box_mpc(int N, int k0, int k1, int kmax, float *ptr_alpha, float **t, float **dt, float **lam, float **dlam, float **lamt, float **dux, float **db)
 	{
 	
-	const int bs = 4; //d_get_mr();
-	
 	float alpha = ptr_alpha[0];
 	
-	int kna = ((k1+bs-1)/bs)*bs;
 
 	int jj, ll;
 
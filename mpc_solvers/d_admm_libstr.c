@@ -0,0 +1,339 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <math.h>
+
+#ifdef BLASFEO
+
+#include <blasfeo_target.h>
+#include <blasfeo_common.h>
+#include <blasfeo_d_aux.h>
+#include <blasfeo_d_blas.h>
+
+#include "../include/lqcp_solvers.h"
+#include "../include/mpc_solvers.h"
+
+
+
+// rho is checked every ADMM_RHO_CHECK iterations, and scaled by ADMM_RHO_SCALE (with refactorization) if the primal and dual residuals differ by more than ADMM_RHO_RATIO
+#ifndef ADMM_RHO_CHECK
+#define ADMM_RHO_CHECK 10
+#endif
+#define ADMM_RHO_RATIO 10.0
+#define ADMM_RHO_SCALE 5.0
+
+
+
+/*
+ADMM splitting of the box and soft constraints: the copy v of the constrained components ux[idxb] carries
+the constraints, w is the scaled dual variable. At stage ii, with nbs = nb+ns:
+  idxb = [hard(nb) | soft(ns)]
+  d    = [lb(nbs) | ub(nbs)]
+  Z, z = [lower(ns) | upper(ns)] quadratic and linear penalty of the soft constraints violation
+  v, w, lam (nbs, nbs, 2*nbs)
+The ux update is an unconstrained LQCP with the diagonal rho added at idxb: its Riccati factorization
+(kept at the start of the work space) only depends on rho, so each iteration is a single Riccati solution.
+*/
+
+
+
+// work space size
+int d_admm_mpc_soft_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int *ns)
+	{
+
+	int ii;
+
+	int nbs[N+1];
+	int ng[N+1];
+	for(ii=0; ii<=N; ii++)
+		{
+		nbs[ii] = nb[ii] + ns[ii];
+		ng[ii] = 0;
+		}
+
+	int size = 0;
+
+	for(ii=0; ii<=N; ii++)
+		{
+		size += blasfeo_memsize_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii]); // L
+		size += 2*blasfeo_memsize_dvec(nx[ii]); // b, Pb
+		size += 1*blasfeo_memsize_dvec(nu[ii]+nx[ii]); // rq
+		size += 2*blasfeo_memsize_dvec(nbs[ii]); // Qx, qx
+		}
+
+	// riccati work space size
+	size += d_back_ric_rec_work_space_size_bytes_libstr(N, nx, nu, nbs, ng);
+
+	// make multiple of (typical) cache line size
+	size = (size+63)/64*64;
+
+	return size;
+	}
+
+
+
+/* ADMM with cached Riccati factorization, box and soft constraints, time variant matrices, time variant size (mpc version) */
+int d_admm_mpc_soft_libstr(int *kk, int k_max, double tol_p, double tol_d, int warm_start, int compute_fact, double *rho, double alpha, double *stat, int N, int *nx, int *nu, int *nb, int **idxb, int *ns, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsZ, struct blasfeo_dvec *hsz, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hsv, struct blasfeo_dvec *hsw, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, void *work)
+	{
+
+	// indeces
+	int jj, ll, ii;
+
+
+	int nbs[N+1];
+	int ng[N+1];
+	for(ii=0; ii<=N; ii++)
+		{
+		nbs[ii] = nb[ii] + ns[ii];
+		ng[ii] = 0;
+		}
+
+	struct blasfeo_dvec hsb[N];
+	struct blasfeo_dvec hsrq[N+1];
+	struct blasfeo_dvec hsQx[N+1];
+	struct blasfeo_dvec hsqx[N+1];
+	struct blasfeo_dvec hsPb[N+1];
+	struct blasfeo_dmat hsL[N+1];
+
+	void *d_back_ric_rec_work_space;
+
+	char *c_ptr = work;
+
+	// L first, so that the factorization stays in place between calls
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_create_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], &hsL[ii], (void *) c_ptr);
+		c_ptr += hsL[ii].memsize;
+		}
+
+	// riccati work space
+	d_back_ric_rec_work_space = (void *) c_ptr;
+	c_ptr += d_back_ric_rec_work_space_size_bytes_libstr(N, nx, nu, nbs, ng);
+
+	// b as vector
+	for(ii=0; ii<N; ii++)
+		{
+		blasfeo_create_dvec(nx[ii+1], &hsb[ii], (void *) c_ptr);
+		c_ptr += hsb[ii].memsize;
+		}
+
+	// backup of P*b
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_create_dvec(nx[ii], &hsPb[ii], (void *) c_ptr);
+		c_ptr += hsPb[ii].memsize;
+		}
+
+	// linear part of cost function
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_create_dvec(nu[ii]+nx[ii], &hsrq[ii], (void *) c_ptr);
+		c_ptr += hsrq[ii].memsize;
+		}
+
+	// diagonal Hessian and gradient of the augmented Lagrangian term
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_create_dvec(nbs[ii], &hsQx[ii], (void *) c_ptr);
+		c_ptr += hsQx[ii].memsize;
+		blasfeo_create_dvec(nbs[ii], &hsqx[ii], (void *) c_ptr);
+		c_ptr += hsqx[ii].memsize;
+		}
+
+	// extract b and rq
+	for(ii=0; ii<N; ii++)
+		blasfeo_drowex(nx[ii+1], 1.0, &hsBAbt[ii], nu[ii]+nx[ii], 0, &hsb[ii], 0);
+	for(ii=0; ii<=N; ii++)
+		blasfeo_drowex(nu[ii]+nx[ii], 1.0, &hsRSQrq[ii], nu[ii]+nx[ii], 0, &hsrq[ii], 0);
+
+	// factorization, reused from the previous call otherwise
+	if(compute_fact)
+		{
+		for(ii=0; ii<=N; ii++)
+			blasfeo_dvecse(nbs[ii], *rho, &hsQx[ii], 0);
+		d_back_ric_rec_trf_libstr(N, nx, nu, nbs, idxb, ng, hsBAbt, hsRSQrq, NULL, hsQx, hsL, d_back_ric_rec_work_space);
+		}
+
+	double *ptr_ux, *ptr_v, *ptr_w, *ptr_d, *ptr_Z, *ptr_z, *ptr_qx, *ptr_lam;
+	double x_tmp, v_tmp, y_tmp, v_old;
+	double r_p, r_d;
+	double rho_old;
+
+	// initial guess of the splitting variables
+	if(!warm_start)
+		{
+		for(ii=0; ii<=N; ii++)
+			{
+			ptr_d = hsd[ii].pa;
+			ptr_v = hsv[ii].pa;
+			for(jj=0; jj<nbs[ii]; jj++)
+				ptr_v[jj] = fmin( fmax( 0.0, ptr_d[jj] ), ptr_d[nbs[ii]+jj] );
+			blasfeo_dvecse(nbs[ii], 0.0, &hsw[ii], 0);
+			}
+		}
+
+	int compute_Pb = 1;
+	int converged = 0;
+
+	*kk = 0;
+	while(*kk<k_max)
+		{
+
+		// ux update: minimize the cost plus rho/2*|ux[idxb]-v+w|^2 subject to the dynamics
+		for(ii=0; ii<=N; ii++)
+			{
+			ptr_v = hsv[ii].pa;
+			ptr_w = hsw[ii].pa;
+			ptr_qx = hsqx[ii].pa;
+			for(jj=0; jj<nbs[ii]; jj++)
+				ptr_qx[jj] = *rho * ( ptr_w[jj] - ptr_v[jj] );
+			}
+		d_back_ric_rec_trs_libstr(N, nx, nu, nbs, idxb, ng, hsBAbt, hsb, hsrq, NULL, hsqx, hsux, compute_mult, hspi, compute_Pb, hsPb, hsL, d_back_ric_rec_work_space);
+		compute_Pb = 0;
+
+		// relaxed v update (projection onto the box, proximal operator of the soft penalty) and w update
+		r_p = 0.0;
+		r_d = 0.0;
+		for(ii=0; ii<=N; ii++)
+			{
+			ptr_ux = hsux[ii].pa;
+			ptr_v = hsv[ii].pa;
+			ptr_w = hsw[ii].pa;
+			ptr_d = hsd[ii].pa;
+			for(jj=0; jj<nbs[ii]; jj++)
+				{
+				x_tmp = ptr_ux[idxb[ii][jj]];
+				v_old = ptr_v[jj];
+				y_tmp = alpha*x_tmp + (1.0-alpha)*v_old + ptr_w[jj];
+				v_tmp = fmin( fmax( y_tmp, ptr_d[jj] ), ptr_d[nbs[ii]+jj] );
+				if(jj>=nb[ii])
+					{
+					ll = jj - nb[ii];
+					ptr_Z = hsZ[ii].pa;
+					ptr_z = hsz[ii].pa;
+					if(y_tmp<ptr_d[jj])
+						v_tmp = fmin( ( ptr_Z[ll]*ptr_d[jj] + ptr_z[ll] + *rho*y_tmp ) / ( ptr_Z[ll] + *rho ), ptr_d[jj] );
+					else if(y_tmp>ptr_d[nbs[ii]+jj])
+						v_tmp = fmax( ( ptr_Z[ns[ii]+ll]*ptr_d[nbs[ii]+jj] - ptr_z[ns[ii]+ll] + *rho*y_tmp ) / ( ptr_Z[ns[ii]+ll] + *rho ), ptr_d[nbs[ii]+jj] );
+					}
+				ptr_v[jj] = v_tmp;
+				ptr_w[jj] = y_tmp - v_tmp;
+				r_p = fmax( r_p, fabs( x_tmp - v_tmp ) );
+				r_d = fmax( r_d, fabs( v_tmp - v_old ) );
+				}
+			}
+		r_d *= *rho;
+
+		// save statistics
+		stat[5*(*kk)+0] = *rho;
+		stat[5*(*kk)+1] = r_p;
+		stat[5*(*kk)+2] = r_d;
+
+		(*kk)++;
+
+		if(r_p<=tol_p && r_d<=tol_d)
+			{
+			converged = 1;
+			break;
+			}
+
+		// residual balancing: refactorize only if the residuals are far apart
+		if((*kk)%ADMM_RHO_CHECK==0 && *kk<k_max)
+			{
+			rho_old = *rho;
+			if(r_p>ADMM_RHO_RATIO*r_d)
+				*rho *= ADMM_RHO_SCALE;
+			else if(r_d>ADMM_RHO_RATIO*r_p)
+				*rho /= ADMM_RHO_SCALE;
+			if(*rho!=rho_old)
+				{
+				for(ii=0; ii<=N; ii++)
+					{
+					blasfeo_dvecsc(nbs[ii], rho_old / *rho, &hsw[ii], 0);
+					blasfeo_dvecse(nbs[ii], *rho, &hsQx[ii], 0);
+					}
+				d_back_ric_rec_trf_libstr(N, nx, nu, nbs, idxb, ng, hsBAbt, hsRSQrq, NULL, hsQx, hsL, d_back_ric_rec_work_space);
+				compute_Pb = 1;
+				}
+			}
+
+		}
+
+	// multipliers of the box constraints from the scaled dual variable
+	if(compute_mult)
+		{
+		for(ii=0; ii<=N; ii++)
+			{
+			ptr_w = hsw[ii].pa;
+			ptr_lam = hslam[ii].pa;
+			for(jj=0; jj<nbs[ii]; jj++)
+				{
+				ptr_lam[jj] = fmax( - *rho * ptr_w[jj], 0.0 );
+				ptr_lam[nbs[ii]+jj] = fmax( *rho * ptr_w[jj], 0.0 );
+				}
+			}
+		}
+
+	if(converged)
+		return 0;
+
+	// max number of iterations reached
+	return 1;
+
+	}
+
+
+
+int d_admm_mpc_hard_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb)
+	{
+
+	int ii;
+
+	int ns[N+1];
+	for(ii=0; ii<=N; ii++)
+		ns[ii] = 0;
+
+	return d_admm_mpc_soft_work_space_size_bytes_libstr(N, nx, nu, nb, ns);
+
+	}
+
+
+
+/* ADMM with cached Riccati factorization, box constraints only */
+int d_admm_mpc_hard_libstr(int *kk, int k_max, double tol_p, double tol_d, int warm_start, int compute_fact, double *rho, double alpha, double *stat, int N, int *nx, int *nu, int *nb, int **idxb, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hsv, struct blasfeo_dvec *hsw, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, void *work)
+	{
+
+	int ii;
+
+	int ns[N+1];
+	for(ii=0; ii<=N; ii++)
+		ns[ii] = 0;
+
+	return d_admm_mpc_soft_libstr(kk, k_max, tol_p, tol_d, warm_start, compute_fact, rho, alpha, stat, N, nx, nu, nb, idxb, ns, hsBAbt, hsRSQrq, NULL, NULL, hsd, hsux, hsv, hsw, compute_mult, hspi, hslam, work);
+
+	}
+
+#endif
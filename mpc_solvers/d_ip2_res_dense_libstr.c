@@ -0,0 +1,437 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <math.h>
+
+#ifdef BLASFEO
+
+#include <blasfeo_target.h>
+#include <blasfeo_common.h>
+#include <blasfeo_d_aux.h>
+#include <blasfeo_d_blas.h>
+
+#include "../include/mpc_aux.h"
+#include "../include/mpc_solvers.h"
+
+
+
+/*
+dense QP in the form of the fully condensed problem
+
+  min  1/2 v' H v + g' v
+  s.t. lb <= v[idxb] <= ub
+       lg <= DCt' v  <= ug
+
+with H and g packed in the (nv+1)x(nv) matrix sH (g in the last row), as returned by d_cond_libstr.
+The box and general constraints are collected in E = [I[:,idxb] DCt], and the KKT system
+
+  ( H + E Q E' ) dv = - ( r + E q )
+
+is solved either by the normal equations (Cholesky factorization of the nv x nv matrix, every iteration),
+or by the Schur complement on the constraints, if there are less constraints than variables and H is
+positive definite: H = L L' and W = L^{-1} E are computed once per call, and only the (nb+ng)x(nb+ng) matrix
+
+  S = W' W + Q^{-1}
+
+is factorized every iteration.
+*/
+
+
+
+// work space size
+int d_ip2_res_dense_qp_work_space_size_bytes_libstr(int nv, int nb, int ng)
+	{
+
+	int nx0[1]; nx0[0] = 0;
+	int nu0[1]; nu0[0] = nv;
+	int nb0[1]; nb0[0] = nb;
+	int ng0[1]; ng0[0] = ng;
+
+	int nt = nb + ng;
+
+	int size = 0;
+
+	size += blasfeo_memsize_dmat(nv, nv); // L
+	size += blasfeo_memsize_dmat(nv, ng); // DCt*Qg
+	size += blasfeo_memsize_dmat(nt, nv); // Wt
+	size += 2*blasfeo_memsize_dmat(nt, nt); // G, Ls
+	size += 5*blasfeo_memsize_dvec(nv); // rq, dv, res_rq, r, Ld
+	size += 4*blasfeo_memsize_dvec(nt); // Qx, qx, Qxinv, z
+	size += 5*blasfeo_memsize_dvec(2*nt); // dlam, dt, tinv, res_d, res_m
+	size += 2*blasfeo_memsize_dvec(0); // pi, dpi
+
+	// residuals work space size
+	size += d_res_res_mpc_hard_work_space_size_bytes_libstr(0, nx0, nu0, nb0, ng0);
+
+	// make multiple of (typical) cache line size
+	size = (size+63)/64*64;
+
+	return size;
+	}
+
+
+
+// factorize H and compute the constant part of the Schur complement; return 0 if the normal equations have to be used instead
+static int d_dense_qp_schur_init_libstr(int nv, int nb, int *idxb, int ng, struct blasfeo_dmat *sH, struct blasfeo_dmat *sDCt, struct blasfeo_dmat *sL, struct blasfeo_dvec *sLd, struct blasfeo_dmat *sWt, struct blasfeo_dmat *sG)
+	{
+
+	int ii;
+
+	int nt = nb + ng;
+
+	// the Schur complement is smaller than the normal equations matrix
+	if(nt>=nv)
+		return 0;
+
+	// H has to be positive definite
+	blasfeo_dpotrf_l(nv, sH, 0, 0, sL, 0, 0);
+	blasfeo_ddiaex(nv, 1.0, sL, 0, 0, sLd, 0);
+	for(ii=0; ii<nv; ii++)
+		if(!(sLd->pa[ii]>0.0))
+			return 0;
+
+	// Wt = E' L^{-T}
+	blasfeo_dgese(nb, nv, 0.0, sWt, 0, 0);
+	for(ii=0; ii<nb; ii++)
+		blasfeo_dgein1(1.0, sWt, ii, idxb[ii]);
+	if(ng>0)
+		blasfeo_dgetr(nv, ng, sDCt, 0, 0, sWt, nb, 0);
+	blasfeo_dtrsm_rltn(nt, nv, 1.0, sL, 0, 0, sWt, 0, 0, sWt, 0, 0);
+
+	// G = Wt Wt'
+	blasfeo_dgese(nt, nt, 0.0, sG, 0, 0);
+	blasfeo_dsyrk_ln(nt, nv, 1.0, sWt, 0, 0, sWt, 0, 0, 0.0, sG, 0, 0, sG, 0, 0);
+
+	return 1;
+
+	}
+
+
+
+// factorize the KKT system
+static void d_dense_qp_trf_libstr(int use_schur, int nv, int nb, int *idxb, int ng, struct blasfeo_dmat *sH, struct blasfeo_dmat *sDCt, struct blasfeo_dvec *sQx, struct blasfeo_dvec *sQxinv, struct blasfeo_dmat *sL, struct blasfeo_dmat *sDCtQ, struct blasfeo_dmat *sG, struct blasfeo_dmat *sLs)
+	{
+
+	int ii;
+
+	int nt = nb + ng;
+
+	if(use_schur)
+		{
+		// Ls = chol( G + Q^{-1} )
+		for(ii=0; ii<nt; ii++)
+			sQxinv->pa[ii] = 1.0 / sQx->pa[ii];
+		blasfeo_dtrcp_l(nt, sG, 0, 0, sLs, 0, 0);
+		blasfeo_ddiaad(nt, 1.0, sQxinv, 0, sLs, 0, 0);
+		blasfeo_dpotrf_l(nt, sLs, 0, 0, sLs, 0, 0);
+		}
+	else
+		{
+		// L = chol( H + Qb + DCt Qg DCt' )
+		blasfeo_dtrcp_l(nv, sH, 0, 0, sL, 0, 0);
+		if(nb>0)
+			blasfeo_ddiaad_sp(nb, 1.0, sQx, 0, idxb, sL, 0, 0);
+		if(ng>0)
+			{
+			blasfeo_dgemm_nd(nv, ng, 1.0, sDCt, 0, 0, sQx, nb, 0.0, sDCt, 0, 0, sDCtQ, 0, 0);
+			blasfeo_dsyrk_dpotrf_ln(nv, ng, sDCtQ, 0, 0, sDCt, 0, 0, sL, 0, 0, sL, 0, 0);
+			}
+		else
+			{
+			blasfeo_dpotrf_l(nv, sL, 0, 0, sL, 0, 0);
+			}
+		}
+
+	return;
+
+	}
+
+
+
+// solve the KKT system for the search direction dv
+static void d_dense_qp_trs_libstr(int use_schur, int nv, int nb, int *idxb, int ng, struct blasfeo_dmat *sDCt, struct blasfeo_dvec *sres_rq, struct blasfeo_dvec *sqx, struct blasfeo_dvec *sQxinv, struct blasfeo_dmat *sL, struct blasfeo_dmat *sWt, struct blasfeo_dmat *sLs, struct blasfeo_dvec *sr, struct blasfeo_dvec *sz, struct blasfeo_dvec *sdv)
+	{
+
+	int ii;
+
+	int nt = nb + ng;
+
+	if(use_schur)
+		{
+		// z = S^{-1} ( Q^{-1} qx - Wt L^{-1} res_rq ), then dv = - L^{-T} ( L^{-1} res_rq + Wt' z ):
+		// E qx (large for the active constraints) is never formed
+		blasfeo_dtrsv_lnn(nv, sL, 0, 0, sres_rq, 0, sr, 0);
+		for(ii=0; ii<nt; ii++)
+			sz->pa[ii] = sQxinv->pa[ii] * sqx->pa[ii];
+		blasfeo_dgemv_n(nt, nv, -1.0, sWt, 0, 0, sr, 0, 1.0, sz, 0, sz, 0);
+		blasfeo_dtrsv_lnn(nt, sLs, 0, 0, sz, 0, sz, 0);
+		blasfeo_dtrsv_ltn(nt, sLs, 0, 0, sz, 0, sz, 0);
+		blasfeo_dgemv_t(nt, nv, 1.0, sWt, 0, 0, sz, 0, 1.0, sr, 0, sr, 0);
+		}
+	else
+		{
+		// r = L^{-1} ( res_rq + E qx )
+		blasfeo_dveccp(nv, sres_rq, 0, sr, 0);
+		if(nb>0)
+			blasfeo_dvecad_sp(nb, 1.0, sqx, 0, idxb, sr, 0);
+		if(ng>0)
+			blasfeo_dgemv_n(nv, ng, 1.0, sDCt, 0, 0, sqx, nb, 1.0, sr, 0, sr, 0);
+		blasfeo_dtrsv_lnn(nv, sL, 0, 0, sr, 0, sr, 0);
+		}
+
+	blasfeo_dtrsv_ltn(nv, sL, 0, 0, sr, 0, sdv, 0);
+	blasfeo_dvecsc(nv, -1.0, sdv, 0);
+
+	return;
+
+	}
+
+
+
+/* primal-dual interior-point method computing residuals at each iteration, dense QP (e.g. from full condensing) */
+int d_ip2_res_dense_qp_libstr(int *kk, int k_max, double mu0, double mu_tol, double alpha_min, int warm_start, double *stat, int nv, int nb, int *idxb, int ng, struct blasfeo_dmat *sH, struct blasfeo_dmat *sDCt, struct blasfeo_dvec *sd, struct blasfeo_dvec *sv, struct blasfeo_dvec *slam, struct blasfeo_dvec *st, void *work_memory)
+	{
+
+
+	// the dense QP is seen as a single stage problem by the auxiliary routines of the hard IPM
+	int nx0[1]; nx0[0] = 0;
+	int nu0[1]; nu0[0] = nv;
+	int nb0[1]; nb0[0] = nb;
+	int ng0[1]; ng0[0] = ng;
+	int *idxb0[1]; idxb0[0] = idxb;
+
+	int nt = nb + ng;
+
+	struct blasfeo_dmat sL, sDCtQ, sWt, sG, sLs;
+	struct blasfeo_dvec srq, sdv, sres_rq, sr, sLd;
+	struct blasfeo_dvec sQx, sqx, sQxinv, sz;
+	struct blasfeo_dvec sdlam, sdt, stinv, sres_d, sres_m;
+	struct blasfeo_dvec spi, sdpi;
+
+	void *d_res_res_mpc_hard_work_space;
+
+	char *c_ptr = work_memory;
+
+	// residuals work space
+	d_res_res_mpc_hard_work_space = (void *) c_ptr;
+	c_ptr += d_res_res_mpc_hard_work_space_size_bytes_libstr(0, nx0, nu0, nb0, ng0);
+
+	blasfeo_create_dmat(nv, nv, &sL, (void *) c_ptr);
+	c_ptr += sL.memsize;
+	blasfeo_create_dmat(nv, ng, &sDCtQ, (void *) c_ptr);
+	c_ptr += sDCtQ.memsize;
+	blasfeo_create_dmat(nt, nv, &sWt, (void *) c_ptr);
+	c_ptr += sWt.memsize;
+	blasfeo_create_dmat(nt, nt, &sG, (void *) c_ptr);
+	c_ptr += sG.memsize;
+	blasfeo_create_dmat(nt, nt, &sLs, (void *) c_ptr);
+	c_ptr += sLs.memsize;
+
+	blasfeo_create_dvec(nv, &srq, (void *) c_ptr);
+	c_ptr += srq.memsize;
+	blasfeo_create_dvec(nv, &sdv, (void *) c_ptr);
+	c_ptr += sdv.memsize;
+	blasfeo_create_dvec(nv, &sres_rq, (void *) c_ptr);
+	c_ptr += sres_rq.memsize;
+	blasfeo_create_dvec(nv, &sr, (void *) c_ptr);
+	c_ptr += sr.memsize;
+	blasfeo_create_dvec(nv, &sLd, (void *) c_ptr);
+	c_ptr += sLd.memsize;
+
+	blasfeo_create_dvec(nt, &sQx, (void *) c_ptr);
+	c_ptr += sQx.memsize;
+	blasfeo_create_dvec(nt, &sqx, (void *) c_ptr);
+	c_ptr += sqx.memsize;
+	blasfeo_create_dvec(nt, &sQxinv, (void *) c_ptr);
+	c_ptr += sQxinv.memsize;
+	blasfeo_create_dvec(nt, &sz, (void *) c_ptr);
+	c_ptr += sz.memsize;
+
+	blasfeo_create_dvec(2*nt, &sdlam, (void *) c_ptr);
+	c_ptr += sdlam.memsize;
+	blasfeo_create_dvec(2*nt, &sdt, (void *) c_ptr);
+	c_ptr += sdt.memsize;
+	blasfeo_create_dvec(2*nt, &stinv, (void *) c_ptr);
+	c_ptr += stinv.memsize;
+	blasfeo_create_dvec(2*nt, &sres_d, (void *) c_ptr);
+	c_ptr += sres_d.memsize;
+	blasfeo_create_dvec(2*nt, &sres_m, (void *) c_ptr);
+	c_ptr += sres_m.memsize;
+
+	// no equality constraints
+	blasfeo_create_dvec(0, &spi, (void *) c_ptr);
+	c_ptr += spi.memsize;
+	blasfeo_create_dvec(0, &sdpi, (void *) c_ptr);
+	c_ptr += sdpi.memsize;
+
+	// extract g
+	blasfeo_drowex(nv, 1.0, sH, nv, 0, &srq, 0);
+
+
+
+	double alpha, mu, mu_aff;
+
+	// check if there are inequality constraints
+	double mu_scal = 2*nb + 2*ng;
+	if(mu_scal!=0.0) // there are some constraints
+		{
+		mu_scal = 1.0 / mu_scal;
+		}
+	else // solve the unconstrained QP and return
+		{
+		blasfeo_dpotrf_l(nv, sH, 0, 0, &sL, 0, 0);
+		blasfeo_dtrsv_lnn(nv, &sL, 0, 0, &srq, 0, sv, 0);
+		blasfeo_dtrsv_ltn(nv, &sL, 0, 0, sv, 0, sv, 0);
+		blasfeo_dvecsc(nv, -1.0, sv, 0);
+		// no IPM iterations
+		*kk = 0;
+		// return success
+		return 0;
+		}
+
+	double sigma = 0.0;
+
+	// the Hessian does not change over the iterations: choose the KKT solver once
+	int use_schur = d_dense_qp_schur_init_libstr(nv, nb, idxb, ng, sH, sDCt, &sL, &sLd, &sWt, &sG);
+
+
+
+	// initialize v & t>0 & lam>0
+	d_init_var_mpc_hard_libstr(0, nx0, nu0, nb0, idxb0, ng0, sv, &spi, sDCt, sd, st, slam, mu0, warm_start);
+
+	// compute residuals
+	d_res_res_mpc_hard_libstr(0, nx0, nu0, nb0, idxb0, ng0, NULL, NULL, sH, &srq, sv, sDCt, sd, &spi, slam, st, &sres_rq, NULL, &sres_d, &sres_m, &mu, d_res_res_mpc_hard_work_space);
+
+	// set to zero iteration count
+	*kk = 0;	
+
+	// larger than minimum accepted step size
+	alpha = 1.0;
+
+
+
+	// IP loop		
+	while( *kk<k_max && mu>mu_tol && alpha>=alpha_min )
+		{
+
+		// compute the update of Hessian and gradient from box and general constraints
+		d_update_hessian_gradient_res_mpc_hard_libstr(0, nx0, nu0, nb0, ng0, &sres_d, &sres_m, st, slam, &stinv, &sQx, &sqx);
+
+
+
+		// compute the search direction: factorize and solve the KKT system
+		d_dense_qp_trf_libstr(use_schur, nv, nb, idxb, ng, sH, sDCt, &sQx, &sQxinv, &sL, &sDCtQ, &sG, &sLs);
+		d_dense_qp_trs_libstr(use_schur, nv, nb, idxb, ng, sDCt, &sres_rq, &sqx, &sQxinv, &sL, &sWt, &sLs, &sr, &sz, &sdv);
+
+
+
+		// compute t_aff & dlam_aff & dt_aff & alpha
+		alpha = 1.0;
+		d_compute_alpha_res_mpc_hard_libstr(0, nx0, nu0, nb0, idxb0, ng0, &sdv, st, &stinv, slam, sDCt, &sres_d, &sres_m, &sdt, &sdlam, &alpha);
+
+		stat[5*(*kk)] = sigma;
+		stat[5*(*kk)+1] = alpha;
+			
+		alpha *= 0.995;
+
+
+
+		// compute the affine duality gap
+		d_compute_mu_mpc_hard_libstr(0, nx0, nu0, nb0, ng0, &mu_aff, mu_scal, alpha, slam, &sdlam, st, &sdt);
+
+		stat[5*(*kk)+2] = mu_aff;
+
+
+
+		// compute sigma
+		sigma = mu_aff/mu;
+		sigma = sigma*sigma*sigma;
+
+
+
+		// update res_m
+		d_compute_centering_correction_res_mpc_hard_libstr(0, nb0, ng0, sigma*mu, &sdt, &sdlam, &sres_m);
+
+		// update gradient
+		d_update_gradient_res_mpc_hard_libstr(0, nx0, nu0, nb0, ng0, &sres_d, &sres_m, slam, &stinv, &sqx);
+
+
+
+		// solve the KKT system
+		d_dense_qp_trs_libstr(use_schur, nv, nb, idxb, ng, sDCt, &sres_rq, &sqx, &sQxinv, &sL, &sWt, &sLs, &sr, &sz, &sdv);
+
+
+
+		// compute t & dlam & dt & alpha
+		alpha = 1.0;
+		d_compute_alpha_res_mpc_hard_libstr(0, nx0, nu0, nb0, idxb0, ng0, &sdv, st, &stinv, slam, sDCt, &sres_d, &sres_m, &sdt, &sdlam, &alpha);
+
+		stat[5*(*kk)] = sigma;
+		stat[5*(*kk)+3] = alpha;
+			
+		alpha *= 0.995;
+
+
+
+		// update v, lam, t
+		d_update_var_res_mpc_hard_libstr(0, nx0, nu0, nb0, ng0, alpha, sv, &sdv, &spi, &sdpi, st, &sdt, slam, &sdlam);
+
+
+
+		// compute residuals
+		d_res_res_mpc_hard_libstr(0, nx0, nu0, nb0, idxb0, ng0, NULL, NULL, sH, &srq, sv, sDCt, sd, &spi, slam, st, &sres_rq, NULL, &sres_d, &sres_m, &mu, d_res_res_mpc_hard_work_space);
+
+		stat[5*(*kk)+4] = mu;
+
+
+
+		// increment loop index
+		(*kk)++;
+
+		} // end of IP loop
+
+
+
+	// successful exit
+	if(mu<=mu_tol)
+		return 0;
+	
+	// max number of iterations reached
+	if(*kk>=k_max)
+		return 1;
+	
+	// no improvement
+	if(alpha<alpha_min)
+		return 2;
+	
+	// impossible
+	return -1;
+
+	} // end of ipsolver
+
+
+
+#endif
@@ -0,0 +1,875 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <math.h>
+
+#if defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+#include <mmintrin.h>
+#include <xmmintrin.h>  // SSE
+#include <emmintrin.h>  // SSE2
+#include <pmmintrin.h>  // SSE3
+#include <smmintrin.h>  // SSE4
+#include <immintrin.h>  // AVX
+#endif
+
+#ifdef BLASFEO
+#include <blasfeo_target.h>
+#include <blasfeo_common.h>
+#endif
+
+#include "../include/block_size.h"
+#include "../include/mpc_solvers.h"
+
+
+
+// batched layout: D_BATCH problems of identical size are interleaved, so that the element e of
+// problem (lane) p of a vector is stored at x[e*D_BATCH+p], and the element (i,j) of a m x n
+// matrix is stored at A[(i+j*m)*D_BATCH+p] (column-major, each scalar replaced by a simd vector);
+// every operation below is the scalar operation of d_ip2_res_mpc_hard_tv applied to all lanes
+
+
+
+#if defined(TARGET_X64_AVX512)
+
+typedef __m512d d_lane;
+
+static inline d_lane d_lane_load(double *x) { return _mm512_loadu_pd(x); }
+static inline void d_lane_store(double *x, d_lane a) { _mm512_storeu_pd(x, a); }
+static inline d_lane d_lane_set(double a) { return _mm512_set1_pd(a); }
+static inline d_lane d_lane_add(d_lane a, d_lane b) { return _mm512_add_pd(a, b); }
+static inline d_lane d_lane_sub(d_lane a, d_lane b) { return _mm512_sub_pd(a, b); }
+static inline d_lane d_lane_mul(d_lane a, d_lane b) { return _mm512_mul_pd(a, b); }
+static inline d_lane d_lane_div(d_lane a, d_lane b) { return _mm512_div_pd(a, b); }
+static inline d_lane d_lane_sqrt(d_lane a) { return _mm512_sqrt_pd(a); }
+static inline d_lane d_lane_min(d_lane a, d_lane b) { return _mm512_min_pd(a, b); }
+static inline d_lane d_lane_max(d_lane a, d_lane b) { return _mm512_max_pd(a, b); }
+// c + a*b
+static inline d_lane d_lane_fmadd(d_lane a, d_lane b, d_lane c) { return _mm512_fmadd_pd(a, b, c); }
+// c - a*b
+static inline d_lane d_lane_fnmadd(d_lane a, d_lane b, d_lane c) { return _mm512_fnmadd_pd(a, b, c); }
+// x<y ? a : b
+static inline d_lane d_lane_sel_lt(d_lane x, d_lane y, d_lane a, d_lane b) { return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(x, y, _CMP_LT_OQ), b, a); }
+
+#elif defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX)
+
+typedef __m256d d_lane;
+
+static inline d_lane d_lane_load(double *x) { return _mm256_loadu_pd(x); }
+static inline void d_lane_store(double *x, d_lane a) { _mm256_storeu_pd(x, a); }
+static inline d_lane d_lane_set(double a) { return _mm256_set1_pd(a); }
+static inline d_lane d_lane_add(d_lane a, d_lane b) { return _mm256_add_pd(a, b); }
+static inline d_lane d_lane_sub(d_lane a, d_lane b) { return _mm256_sub_pd(a, b); }
+static inline d_lane d_lane_mul(d_lane a, d_lane b) { return _mm256_mul_pd(a, b); }
+static inline d_lane d_lane_div(d_lane a, d_lane b) { return _mm256_div_pd(a, b); }
+static inline d_lane d_lane_sqrt(d_lane a) { return _mm256_sqrt_pd(a); }
+static inline d_lane d_lane_min(d_lane a, d_lane b) { return _mm256_min_pd(a, b); }
+static inline d_lane d_lane_max(d_lane a, d_lane b) { return _mm256_max_pd(a, b); }
+#if defined(TARGET_X64_AVX2)
+static inline d_lane d_lane_fmadd(d_lane a, d_lane b, d_lane c) { return _mm256_fmadd_pd(a, b, c); }
+static inline d_lane d_lane_fnmadd(d_lane a, d_lane b, d_lane c) { return _mm256_fnmadd_pd(a, b, c); }
+#else
+static inline d_lane d_lane_fmadd(d_lane a, d_lane b, d_lane c) { return _mm256_add_pd(c, _mm256_mul_pd(a, b)); }
+static inline d_lane d_lane_fnmadd(d_lane a, d_lane b, d_lane c) { return _mm256_sub_pd(c, _mm256_mul_pd(a, b)); }
+#endif
+static inline d_lane d_lane_sel_lt(d_lane x, d_lane y, d_lane a, d_lane b) { return _mm256_blendv_pd(b, a, _mm256_cmp_pd(x, y, _CMP_LT_OQ)); }
+
+#else
+
+// plain C lanes: the fixed trip count loops are left to the compiler
+typedef struct { double v[D_BATCH]; } d_lane;
+
+static inline d_lane d_lane_load(double *x) { d_lane c; int ll; for(ll=0; ll<D_BATCH; ll++) c.v[ll] = x[ll]; return c; }
+static inline void d_lane_store(double *x, d_lane a) { int ll; for(ll=0; ll<D_BATCH; ll++) x[ll] = a.v[ll]; }
+static inline d_lane d_lane_set(double a) { d_lane c; int ll; for(ll=0; ll<D_BATCH; ll++) c.v[ll] = a; return c; }
+static inline d_lane d_lane_add(d_lane a, d_lane b) { d_lane c; int ll; for(ll=0; ll<D_BATCH; ll++) c.v[ll] = a.v[ll] + b.v[ll]; return c; }
+static inline d_lane d_lane_sub(d_lane a, d_lane b) { d_lane c; int ll; for(ll=0; ll<D_BATCH; ll++) c.v[ll] = a.v[ll] - b.v[ll]; return c; }
+static inline d_lane d_lane_mul(d_lane a, d_lane b) { d_lane c; int ll; for(ll=0; ll<D_BATCH; ll++) c.v[ll] = a.v[ll] * b.v[ll]; return c; }
+static inline d_lane d_lane_div(d_lane a, d_lane b) { d_lane c; int ll; for(ll=0; ll<D_BATCH; ll++) c.v[ll] = a.v[ll] / b.v[ll]; return c; }
+static inline d_lane d_lane_sqrt(d_lane a) { d_lane c; int ll; for(ll=0; ll<D_BATCH; ll++) c.v[ll] = sqrt(a.v[ll]); return c; }
+static inline d_lane d_lane_min(d_lane a, d_lane b) { d_lane c; int ll; for(ll=0; ll<D_BATCH; ll++) c.v[ll] = a.v[ll]<b.v[ll] ? a.v[ll] : b.v[ll]; return c; }
+static inline d_lane d_lane_max(d_lane a, d_lane b) { d_lane c; int ll; for(ll=0; ll<D_BATCH; ll++) c.v[ll] = a.v[ll]>b.v[ll] ? a.v[ll] : b.v[ll]; return c; }
+static inline d_lane d_lane_fmadd(d_lane a, d_lane b, d_lane c) { int ll; for(ll=0; ll<D_BATCH; ll++) c.v[ll] += a.v[ll] * b.v[ll]; return c; }
+static inline d_lane d_lane_fnmadd(d_lane a, d_lane b, d_lane c) { int ll; for(ll=0; ll<D_BATCH; ll++) c.v[ll] -= a.v[ll] * b.v[ll]; return c; }
+static inline d_lane d_lane_sel_lt(d_lane x, d_lane y, d_lane a, d_lane b) { d_lane c; int ll; for(ll=0; ll<D_BATCH; ll++) c.v[ll] = x.v[ll]<y.v[ll] ? a.v[ll] : b.v[ll]; return c; }
+
+#endif
+
+
+
+// copy the column-major m x n matrix A into the lane of the batched matrix bA
+void d_cvt_mat2bmat(int m, int n, double *A, int lda, int lane, double *bA)
+	{
+	const int vl = D_BATCH;
+	int ii, jj;
+	for(jj=0; jj<n; jj++)
+		for(ii=0; ii<m; ii++)
+			bA[(ii+jj*m)*vl+lane] = A[ii+jj*lda];
+	}
+
+
+
+// copy the lane of the batched m x n matrix bA into the column-major matrix A
+void d_cvt_bmat2mat(int m, int n, double *bA, int lane, double *A, int lda)
+	{
+	const int vl = D_BATCH;
+	int ii, jj;
+	for(jj=0; jj<n; jj++)
+		for(ii=0; ii<m; ii++)
+			A[ii+jj*lda] = bA[(ii+jj*m)*vl+lane];
+	}
+
+
+
+void d_cvt_vec2bvec(int m, double *x, int lane, double *bx)
+	{
+	const int vl = D_BATCH;
+	int ii;
+	for(ii=0; ii<m; ii++)
+		bx[ii*vl+lane] = x[ii];
+	}
+
+
+
+void d_cvt_bvec2vec(int m, double *bx, int lane, double *x)
+	{
+	const int vl = D_BATCH;
+	int ii;
+	for(ii=0; ii<m; ii++)
+		x[ii] = bx[ii*vl+lane];
+	}
+
+
+
+/* computes work space size */
+int d_ip2_res_mpc_hard_batch_work_space_size_bytes(int N, int *nx, int *nu, int *nb)
+	{
+
+	int ii, nu0, nz0, nx1;
+
+	int d_size = 0;
+	int nzM = 0;
+	for(ii=0; ii<=N; ii++)
+		{
+		nu0 = ii<N ? nu[ii] : 0;
+		nz0 = nu0+nx[ii];
+		nx1 = ii<N ? nx[ii+1] : 0;
+		if(nz0*nx1>nzM) nzM = nz0*nx1;
+		// factor, inverted diagonal, gradient row, value function
+		d_size += nz0*nz0 + 2*nz0 + nx[ii]*nx[ii] + nx[ii];
+		// search direction & residuals of the equality constraints
+		d_size += 2*nz0 + 2*nx1;
+		// dt, dlam, t_inv, res_d, res_m, Qx, qx
+		d_size += 12*nb[ii];
+		}
+	d_size += nzM;
+
+	int size = d_size*D_BATCH*sizeof(double);
+
+	size = (size + 63) / 64 * 64; // make work space multiple of (typical) cache line size
+
+	return size;
+	}
+
+
+
+// residuals & duality measure of all lanes
+static void d_res_res_mpc_hard_batch(int N, int *nx, int *nu, int *nb, int **idxb, double **bBAbt, double **bRSQrq, double **bux, double **bd, double **bpi, double **blam, double **bt, double **res_q, double **res_b, double **res_d, double **res_m, double mu_scal, double *mu)
+	{
+
+	const int vl = D_BATCH;
+
+	int ii, jj, ll, nu0, nx0, nz0, nu1, nx1, nb0, idx;
+
+	d_lane
+		v_acc, v_ux, v_t0, v_t1, v_l0, v_l1, v_m0, v_m1, v_mu;
+
+	double
+		*ptr_A, *ptr_ux, *ptr_rq;
+
+	v_mu = d_lane_set(0.0);
+
+	for(ii=0; ii<=N; ii++)
+		{
+
+		nu0 = ii<N ? nu[ii] : 0;
+		nx0 = nx[ii];
+		nz0 = nu0+nx0;
+		ptr_A = bRSQrq[ii];
+		ptr_ux = bux[ii];
+		ptr_rq = res_q[ii];
+
+		// gradient of the cost: q + RSQ*ux (lower triangle of RSQ stored)
+		for(jj=0; jj<nz0; jj++)
+			{
+			v_acc = d_lane_load(&ptr_A[(nz0+jj*(nz0+1))*vl]);
+			for(ll=0; ll<jj; ll++)
+				v_acc = d_lane_fmadd(d_lane_load(&ptr_A[(jj+ll*(nz0+1))*vl]), d_lane_load(&ptr_ux[ll*vl]), v_acc);
+			for(ll=jj; ll<nz0; ll++)
+				v_acc = d_lane_fmadd(d_lane_load(&ptr_A[(ll+jj*(nz0+1))*vl]), d_lane_load(&ptr_ux[ll*vl]), v_acc);
+			if(ii>0 && jj>=nu0)
+				v_acc = d_lane_sub(v_acc, d_lane_load(&bpi[ii-1][(jj-nu0)*vl]));
+			d_lane_store(&ptr_rq[jj*vl], v_acc);
+			}
+
+		// dynamics
+		if(ii<N)
+			{
+			nu1 = ii+1<N ? nu[ii+1] : 0;
+			nx1 = nx[ii+1];
+			ptr_A = bBAbt[ii];
+			for(jj=0; jj<nx1; jj++)
+				{
+				v_acc = d_lane_load(&ptr_A[(nz0+jj*(nz0+1))*vl]);
+				for(ll=0; ll<nz0; ll++)
+					v_acc = d_lane_fmadd(d_lane_load(&ptr_A[(ll+jj*(nz0+1))*vl]), d_lane_load(&ptr_ux[ll*vl]), v_acc);
+				v_acc = d_lane_sub(v_acc, d_lane_load(&bux[ii+1][(nu1+jj)*vl]));
+				d_lane_store(&res_b[ii][jj*vl], v_acc);
+				}
+			for(ll=0; ll<nz0; ll++)
+				{
+				v_acc = d_lane_load(&ptr_rq[ll*vl]);
+				for(jj=0; jj<nx1; jj++)
+					v_acc = d_lane_fmadd(d_lane_load(&ptr_A[(ll+jj*(nz0+1))*vl]), d_lane_load(&bpi[ii][jj*vl]), v_acc);
+				d_lane_store(&ptr_rq[ll*vl], v_acc);
+				}
+			}
+
+		// box constraints
+		nb0 = nb[ii];
+		for(jj=0; jj<nb0; jj++)
+			{
+			idx = idxb[ii][jj];
+			v_ux = d_lane_load(&ptr_ux[idx*vl]);
+			v_t0 = d_lane_load(&bt[ii][jj*vl]);
+			v_t1 = d_lane_load(&bt[ii][(nb0+jj)*vl]);
+			v_l0 = d_lane_load(&blam[ii][jj*vl]);
+			v_l1 = d_lane_load(&blam[ii][(nb0+jj)*vl]);
+			d_lane_store(&ptr_rq[idx*vl], d_lane_add(d_lane_load(&ptr_rq[idx*vl]), d_lane_sub(v_l1, v_l0)));
+			d_lane_store(&res_d[ii][jj*vl], d_lane_add(d_lane_sub(d_lane_load(&bd[ii][jj*vl]), v_ux), v_t0));
+			d_lane_store(&res_d[ii][(nb0+jj)*vl], d_lane_sub(d_lane_sub(d_lane_load(&bd[ii][(nb0+jj)*vl]), v_ux), v_t1));
+			v_m0 = d_lane_mul(v_l0, v_t0);
+			v_m1 = d_lane_mul(v_l1, v_t1);
+			d_lane_store(&res_m[ii][jj*vl], v_m0);
+			d_lane_store(&res_m[ii][(nb0+jj)*vl], v_m1);
+			v_mu = d_lane_add(v_mu, d_lane_add(v_m0, v_m1));
+			}
+
+		}
+
+	d_lane_store(mu, d_lane_mul(v_mu, d_lane_set(mu_scal)));
+
+	}
+
+
+
+// factorize the KKT system with a Riccati recursion on all lanes, one stage at a time
+static void d_back_ric_trf_batch(int N, int *nx, int *nu, int *nb, int **idxb, double **bBAbt, double **bRSQrq, double **Qx, double **L, double **inv_diag_L, double **P, double *work)
+	{
+
+	const int vl = D_BATCH;
+
+	int ii, jj, kk, ll, nu0, nx0, nz0, nx1;
+
+	d_lane
+		v_acc, v_inv, v_zero;
+
+	double
+		*ptr_A, *ptr_L, *ptr_P;
+
+	v_zero = d_lane_set(0.0);
+
+	for(ii=N; ii>=0; ii--)
+		{
+
+		nu0 = ii<N ? nu[ii] : 0;
+		nx0 = nx[ii];
+		nz0 = nu0+nx0;
+		ptr_L = L[ii];
+
+		// lower triangle of RSQ
+		ptr_A = bRSQrq[ii];
+		for(jj=0; jj<nz0; jj++)
+			for(kk=jj; kk<nz0; kk++)
+				d_lane_store(&ptr_L[(kk+jj*nz0)*vl], d_lane_load(&ptr_A[(kk+jj*(nz0+1))*vl]));
+
+		// box constraints on the diagonal
+		for(jj=0; jj<nb[ii]; jj++)
+			{
+			kk = idxb[ii][jj];
+			d_lane_store(&ptr_L[(kk+kk*nz0)*vl], d_lane_add(d_lane_load(&ptr_L[(kk+kk*nz0)*vl]), d_lane_load(&Qx[ii][jj*vl])));
+			}
+
+		// BAt * P * BAt'
+		if(ii<N)
+			{
+			nx1 = nx[ii+1];
+			ptr_A = bBAbt[ii];
+			ptr_P = P[ii+1];
+			for(kk=0; kk<nx1; kk++)
+				for(jj=0; jj<nz0; jj++)
+					{
+					v_acc = v_zero;
+					for(ll=0; ll<kk; ll++)
+						v_acc = d_lane_fmadd(d_lane_load(&ptr_A[(jj+ll*(nz0+1))*vl]), d_lane_load(&ptr_P[(kk+ll*nx1)*vl]), v_acc);
+					for(ll=kk; ll<nx1; ll++)
+						v_acc = d_lane_fmadd(d_lane_load(&ptr_A[(jj+ll*(nz0+1))*vl]), d_lane_load(&ptr_P[(ll+kk*nx1)*vl]), v_acc);
+					d_lane_store(&work[(jj+kk*nz0)*vl], v_acc);
+					}
+			for(jj=0; jj<nz0; jj++)
+				for(kk=jj; kk<nz0; kk++)
+					{
+					v_acc = d_lane_load(&ptr_L[(kk+jj*nz0)*vl]);
+					for(ll=0; ll<nx1; ll++)
+						v_acc = d_lane_fmadd(d_lane_load(&work[(kk+ll*nz0)*vl]), d_lane_load(&ptr_A[(jj+ll*(nz0+1))*vl]), v_acc);
+					d_lane_store(&ptr_L[(kk+jj*nz0)*vl], v_acc);
+					}
+			}
+
+		// cholesky factorization, left-looking; non-positive pivots give zero columns as in the kernels
+		for(jj=0; jj<nz0; jj++)
+			{
+			v_acc = d_lane_load(&ptr_L[(jj+jj*nz0)*vl]);
+			for(ll=0; ll<jj; ll++)
+				v_acc = d_lane_fnmadd(d_lane_load(&ptr_L[(jj+ll*nz0)*vl]), d_lane_load(&ptr_L[(jj+ll*nz0)*vl]), v_acc);
+			v_acc = d_lane_max(v_acc, v_zero);
+			v_acc = d_lane_sqrt(v_acc);
+			v_inv = d_lane_sel_lt(v_zero, v_acc, d_lane_div(d_lane_set(1.0), v_acc), v_zero);
+			d_lane_store(&ptr_L[(jj+jj*nz0)*vl], v_acc);
+			d_lane_store(&inv_diag_L[ii][jj*vl], v_inv);
+			for(kk=jj+1; kk<nz0; kk++)
+				{
+				v_acc = d_lane_load(&ptr_L[(kk+jj*nz0)*vl]);
+				for(ll=0; ll<jj; ll++)
+					v_acc = d_lane_fnmadd(d_lane_load(&ptr_L[(kk+ll*nz0)*vl]), d_lane_load(&ptr_L[(jj+ll*nz0)*vl]), v_acc);
+				d_lane_store(&ptr_L[(kk+jj*nz0)*vl], d_lane_mul(v_acc, v_inv));
+				}
+			}
+
+		// P = Lxx * Lxx' (lower triangle)
+		if(ii>0)
+			{
+			ptr_P = P[ii];
+			for(jj=0; jj<nx0; jj++)
+				for(kk=jj; kk<nx0; kk++)
+					{
+					v_acc = v_zero;
+					for(ll=0; ll<=jj; ll++)
+						v_acc = d_lane_fmadd(d_lane_load(&ptr_L[(nu0+kk+(nu0+ll)*nz0)*vl]), d_lane_load(&ptr_L[(nu0+jj+(nu0+ll)*nz0)*vl]), v_acc);
+					d_lane_store(&ptr_P[(kk+jj*nx0)*vl], v_acc);
+					}
+			}
+
+		}
+
+	}
+
+
+
+// solve the factorized KKT system for the gradient res_q+qx and the dynamics residuals res_b
+static void d_back_ric_trs_batch(int N, int *nx, int *nu, int *nb, int **idxb, double **bBAbt, double **res_b, double **res_q, double **qx, double **L, double **inv_diag_L, double **P, double **l, double **p, double **dux, double **dpi, double *work)
+	{
+
+	const int vl = D_BATCH;
+
+	int ii, jj, kk, ll, nu0, nx0, nz0, nx1, nu1;
+
+	d_lane
+		v_acc;
+
+	double
+		*ptr_A, *ptr_L, *ptr_P, *ptr_l, *ptr_p, *ptr_z;
+
+	// backward substitution
+	for(ii=N; ii>=0; ii--)
+		{
+
+		nu0 = ii<N ? nu[ii] : 0;
+		nx0 = nx[ii];
+		nz0 = nu0+nx0;
+		ptr_L = L[ii];
+		ptr_l = l[ii];
+
+		for(jj=0; jj<nz0; jj++)
+			d_lane_store(&ptr_l[jj*vl], d_lane_load(&res_q[ii][jj*vl]));
+		for(jj=0; jj<nb[ii]; jj++)
+			{
+			kk = idxb[ii][jj];
+			d_lane_store(&ptr_l[kk*vl], d_lane_add(d_lane_load(&ptr_l[kk*vl]), d_lane_load(&qx[ii][jj*vl])));
+			}
+
+		// g += BAt * (P*b + p)
+		if(ii<N)
+			{
+			nx1 = nx[ii+1];
+			ptr_A = bBAbt[ii];
+			ptr_P = P[ii+1];
+			ptr_p = p[ii+1];
+			for(kk=0; kk<nx1; kk++)
+				{
+				v_acc = d_lane_load(&ptr_p[kk*vl]);
+				for(ll=0; ll<kk; ll++)
+					v_acc = d_lane_fmadd(d_lane_load(&ptr_P[(kk+ll*nx1)*vl]), d_lane_load(&res_b[ii][ll*vl]), v_acc);
+				for(ll=kk; ll<nx1; ll++)
+					v_acc = d_lane_fmadd(d_lane_load(&ptr_P[(ll+kk*nx1)*vl]), d_lane_load(&res_b[ii][ll*vl]), v_acc);
+				d_lane_store(&work[kk*vl], v_acc);
+				}
+			for(jj=0; jj<nz0; jj++)
+				{
+				v_acc = d_lane_load(&ptr_l[jj*vl]);
+				for(kk=0; kk<nx1; kk++)
+					v_acc = d_lane_fmadd(d_lane_load(&ptr_A[(jj+kk*(nz0+1))*vl]), d_lane_load(&work[kk*vl]), v_acc);
+				d_lane_store(&ptr_l[jj*vl], v_acc);
+				}
+			}
+
+		// l = L \ g
+		for(jj=0; jj<nz0; jj++)
+			{
+			v_acc = d_lane_load(&ptr_l[jj*vl]);
+			for(ll=0; ll<jj; ll++)
+				v_acc = d_lane_fnmadd(d_lane_load(&ptr_L[(jj+ll*nz0)*vl]), d_lane_load(&ptr_l[ll*vl]), v_acc);
+			d_lane_store(&ptr_l[jj*vl], d_lane_mul(v_acc, d_lane_load(&inv_diag_L[ii][jj*vl])));
+			}
+
+		// p = Lxx * lx
+		if(ii>0)
+			{
+			ptr_p = p[ii];
+			for(kk=0; kk<nx0; kk++)
+				{
+				v_acc = d_lane_set(0.0);
+				for(ll=0; ll<=kk; ll++)
+					v_acc = d_lane_fmadd(d_lane_load(&ptr_L[(nu0+kk+(nu0+ll)*nz0)*vl]), d_lane_load(&ptr_l[(nu0+ll)*vl]), v_acc);
+				d_lane_store(&ptr_p[kk*vl], v_acc);
+				}
+			}
+
+		}
+
+	// forward substitution
+	for(ii=0; ii<=N; ii++)
+		{
+
+		nu0 = ii<N ? nu[ii] : 0;
+		nx0 = nx[ii];
+		nz0 = nu0+nx0;
+		ptr_L = L[ii];
+		ptr_l = l[ii];
+		ptr_z = dux[ii];
+
+		// the initial state is free, later states come from the dynamics
+		for(jj=(ii==0 ? nz0 : nu0)-1; jj>=0; jj--)
+			{
+			v_acc = d_lane_sub(d_lane_set(0.0), d_lane_load(&ptr_l[jj*vl]));
+			for(ll=jj+1; ll<nz0; ll++)
+				v_acc = d_lane_fnmadd(d_lane_load(&ptr_L[(ll+jj*nz0)*vl]), d_lane_load(&ptr_z[ll*vl]), v_acc);
+			d_lane_store(&ptr_z[jj*vl], d_lane_mul(v_acc, d_lane_load(&inv_diag_L[ii][jj*vl])));
+			}
+
+		if(ii<N)
+			{
+			nu1 = ii+1<N ? nu[ii+1] : 0;
+			nx1 = nx[ii+1];
+			ptr_A = bBAbt[ii];
+			for(kk=0; kk<nx1; kk++)
+				{
+				v_acc = d_lane_load(&res_b[ii][kk*vl]);
+				for(jj=0; jj<nz0; jj++)
+					v_acc = d_lane_fmadd(d_lane_load(&ptr_A[(jj+kk*(nz0+1))*vl]), d_lane_load(&ptr_z[jj*vl]), v_acc);
+				d_lane_store(&dux[ii+1][(nu1+kk)*vl], v_acc);
+				}
+			// equality constraints multipliers: pi = P*x + p
+			ptr_P = P[ii+1];
+			ptr_p = p[ii+1];
+			ptr_z = dux[ii+1]+nu1*vl;
+			for(kk=0; kk<nx1; kk++)
+				{
+				v_acc = d_lane_load(&ptr_p[kk*vl]);
+				for(ll=0; ll<kk; ll++)
+					v_acc = d_lane_fmadd(d_lane_load(&ptr_P[(kk+ll*nx1)*vl]), d_lane_load(&ptr_z[ll*vl]), v_acc);
+				for(ll=kk; ll<nx1; ll++)
+					v_acc = d_lane_fmadd(d_lane_load(&ptr_P[(ll+kk*nx1)*vl]), d_lane_load(&ptr_z[ll*vl]), v_acc);
+				d_lane_store(&dpi[ii][kk*vl], v_acc);
+				}
+			}
+
+		}
+
+	}
+
+
+
+// dt, dlam and the largest step in [0, alpha] keeping t and lam positive, for each lane
+static void d_compute_alpha_res_mpc_hard_batch(int N, int *nb, int **idxb, double **dux, double **t, double **t_inv, double **lam, double **res_d, double **res_m, double **dt, double **dlam, double *alpha)
+	{
+
+	const int vl = D_BATCH;
+
+	int ii, jj, kk, nb0;
+
+	d_lane
+		v_alpha, v_zero, v_dux, v_dt, v_dlam, v_t, v_lam;
+
+	v_zero = d_lane_set(0.0);
+	v_alpha = d_lane_load(alpha);
+
+	for(ii=0; ii<=N; ii++)
+		{
+		nb0 = nb[ii];
+		for(jj=0; jj<2*nb0; jj++)
+			{
+			kk = jj<nb0 ? jj : jj-nb0;
+			v_dux = d_lane_load(&dux[ii][idxb[ii][kk]*vl]);
+			v_dt = d_lane_sub(v_dux, d_lane_load(&res_d[ii][jj*vl]));
+			if(jj>=nb0)
+				v_dt = d_lane_sub(v_zero, v_dt);
+			v_t = d_lane_load(&t[ii][jj*vl]);
+			v_lam = d_lane_load(&lam[ii][jj*vl]);
+			v_dlam = d_lane_sub(v_zero, d_lane_mul(d_lane_load(&t_inv[ii][jj*vl]), d_lane_fmadd(v_lam, v_dt, d_lane_load(&res_m[ii][jj*vl]))));
+			d_lane_store(&dt[ii][jj*vl], v_dt);
+			d_lane_store(&dlam[ii][jj*vl], v_dlam);
+			// alpha = min(alpha, -lam/dlam) where dlam<0, same for t
+			v_alpha = d_lane_sel_lt(v_dlam, v_zero, d_lane_min(v_alpha, d_lane_div(v_lam, d_lane_sub(v_zero, v_dlam))), v_alpha);
+			v_alpha = d_lane_sel_lt(v_dt, v_zero, d_lane_min(v_alpha, d_lane_div(v_t, d_lane_sub(v_zero, v_dt))), v_alpha);
+			}
+		}
+
+	d_lane_store(alpha, v_alpha);
+
+	}
+
+
+
+/* primal-dual interior-point method computing residuals at each iteration, hard box constraints, D_BATCH problems of identical size solved at once across the simd lanes */
+int d_ip2_res_mpc_hard_batch(int *kk, int k_max, double mu0, double mu_tol, double alpha_min, int warm_start, double *stat, int N, int *nx, int *nu, int *nb, int **idxb, double **bBAbt, double **bRSQrq, double **bd, double **bux, int compute_mult, double **bpi, double **blam, double **bt, double *double_work_memory)
+	{
+
+	const int vl = D_BATCH;
+
+	int ii, jj, ll, it, nu0, nz0, nx1, nb0, n_active, hpmpc_status;
+
+	d_lane
+		v_alpha, v_sigma_mu, v_mu, v_t, v_lam, v_tinv0, v_tinv1, v_rm0, v_rm1, v_rd0, v_rd1, v_l0, v_l1, v_thr, v_zero;
+
+	double alpha[D_BATCH], alpha_end[D_BATCH], mu[D_BATCH], mu_aff[D_BATCH], sigma_mu[D_BATCH];
+	int active[D_BATCH];
+
+	// initialize work space
+	double *ptr = double_work_memory;
+
+	double *L[N+1];
+	double *inv_diag_L[N+1];
+	double *l[N+1];
+	double *P[N+1];
+	double *p[N+1];
+	double *dux[N+1];
+	double *dpi[N];
+	double *res_q[N+1];
+	double *res_b[N];
+	double *dt[N+1];
+	double *dlam[N+1];
+	double *t_inv[N+1];
+	double *res_d[N+1];
+	double *res_m[N+1];
+	double *Qx[N+1];
+	double *qx[N+1];
+	double *work;
+
+	int nzM = 0;
+	for(ii=0; ii<=N; ii++)
+		{
+		nu0 = ii<N ? nu[ii] : 0;
+		nz0 = nu0+nx[ii];
+		nx1 = ii<N ? nx[ii+1] : 0;
+		nb0 = nb[ii];
+		if(nz0*nx1>nzM) nzM = nz0*nx1;
+		L[ii] = ptr;
+		ptr += nz0*nz0*vl;
+		inv_diag_L[ii] = ptr;
+		ptr += nz0*vl;
+		l[ii] = ptr;
+		ptr += nz0*vl;
+		P[ii] = ptr;
+		ptr += nx[ii]*nx[ii]*vl;
+		p[ii] = ptr;
+		ptr += nx[ii]*vl;
+		dux[ii] = ptr;
+		ptr += nz0*vl;
+		res_q[ii] = ptr;
+		ptr += nz0*vl;
+		if(ii<N)
+			{
+			dpi[ii] = ptr;
+			ptr += nx1*vl;
+			res_b[ii] = ptr;
+			ptr += nx1*vl;
+			}
+		dt[ii] = ptr;
+		ptr += 2*nb0*vl;
+		dlam[ii] = ptr;
+		ptr += 2*nb0*vl;
+		t_inv[ii] = ptr;
+		ptr += 2*nb0*vl;
+		res_d[ii] = ptr;
+		ptr += 2*nb0*vl;
+		res_m[ii] = ptr;
+		ptr += 2*nb0*vl;
+		Qx[ii] = ptr;
+		ptr += nb0*vl;
+		qx[ii] = ptr;
+		ptr += nb0*vl;
+		}
+	work = ptr;
+	ptr += nzM*vl;
+
+	v_zero = d_lane_set(0.0);
+
+	// check if there are inequality constraints
+	double mu_scal = 0.0;
+	for(ii=0; ii<=N; ii++) mu_scal += 2*nb[ii];
+
+	// initialize ux & pi & t>0 & lam>0
+	if(warm_start==0)
+		for(ii=0; ii<=N; ii++)
+			for(jj=0; jj<((ii<N ? nu[ii] : 0)+nx[ii])*vl; jj++)
+				bux[ii][jj] = 0.0;
+	for(ii=0; ii<N; ii++)
+		for(jj=0; jj<nx[ii+1]*vl; jj++)
+			bpi[ii][jj] = 0.0;
+
+	if(mu_scal==0.0) // no constraints: call the riccati solver and return
+		{
+		d_res_res_mpc_hard_batch(N, nx, nu, nb, idxb, bBAbt, bRSQrq, bux, bd, bpi, blam, bt, res_q, res_b, res_d, res_m, 0.0, mu);
+		d_back_ric_trf_batch(N, nx, nu, nb, idxb, bBAbt, bRSQrq, Qx, L, inv_diag_L, P, work);
+		d_back_ric_trs_batch(N, nx, nu, nb, idxb, bBAbt, res_b, res_q, qx, L, inv_diag_L, P, l, p, dux, dpi, work);
+		for(ii=0; ii<=N; ii++)
+			for(jj=0; jj<((ii<N ? nu[ii] : 0)+nx[ii])*vl; jj++)
+				bux[ii][jj] += dux[ii][jj];
+		for(ii=0; ii<N; ii++)
+			for(jj=0; jj<nx[ii+1]*vl; jj++)
+				bpi[ii][jj] += dpi[ii][jj];
+		for(ll=0; ll<vl; ll++)
+			kk[ll] = 0;
+		return 0;
+		}
+
+	mu_scal = 1.0 / mu_scal;
+
+	double thr0 = 0.1; // minimum vale of t (minimum distance from a constraint)
+	v_thr = d_lane_set(thr0);
+	for(ii=0; ii<=N; ii++)
+		{
+		nb0 = nb[ii];
+		for(jj=0; jj<nb0; jj++)
+			{
+			double *ptr_ux = &bux[ii][idxb[ii][jj]*vl];
+			d_lane v_ux = d_lane_load(ptr_ux);
+			d_lane v_lb = d_lane_load(&bd[ii][jj*vl]);
+			d_lane v_ub = d_lane_load(&bd[ii][(nb0+jj)*vl]);
+			d_lane v_t0 = d_lane_sub(v_ux, v_lb);
+			d_lane v_t1 = d_lane_sub(v_ub, v_ux);
+			// move ux inside the box if closer than thr0 to a bound (to the middle if closer to both)
+			d_lane v_mid = d_lane_mul(d_lane_set(0.5), d_lane_add(v_lb, v_ub));
+			d_lane v_new = d_lane_sel_lt(v_t1, v_thr, d_lane_sub(v_ub, v_thr), v_ux);
+			v_new = d_lane_sel_lt(v_t0, v_thr, d_lane_sel_lt(v_t1, v_thr, v_mid, d_lane_add(v_lb, v_thr)), v_new);
+			d_lane_store(ptr_ux, v_new);
+			v_t0 = d_lane_max(v_t0, v_thr);
+			v_t1 = d_lane_max(v_t1, v_thr);
+			d_lane_store(&bt[ii][jj*vl], v_t0);
+			d_lane_store(&bt[ii][(nb0+jj)*vl], v_t1);
+			d_lane_store(&blam[ii][jj*vl], d_lane_div(d_lane_set(mu0), v_t0));
+			d_lane_store(&blam[ii][(nb0+jj)*vl], d_lane_div(d_lane_set(mu0), v_t1));
+			}
+		}
+
+	// compute residuals
+	d_res_res_mpc_hard_batch(N, nx, nu, nb, idxb, bBAbt, bRSQrq, bux, bd, bpi, blam, bt, res_q, res_b, res_d, res_m, mu_scal, mu);
+
+	// set to zero iteration count
+	n_active = 0;
+	for(ll=0; ll<vl; ll++)
+		{
+		kk[ll] = 0;
+		alpha_end[ll] = 1.0;
+		active[ll] = k_max>0 && mu[ll]>mu_tol;
+		n_active += active[ll];
+		}
+
+	// IP loop: all lanes iterate together, converged lanes take zero steps
+	for(it=0; it<k_max && n_active>0; it++)
+		{
+
+		// compute the update of Hessian and gradient from box constraints
+		for(ii=0; ii<=N; ii++)
+			{
+			nb0 = nb[ii];
+			for(jj=0; jj<nb0; jj++)
+				{
+				v_tinv0 = d_lane_div(d_lane_set(1.0), d_lane_load(&bt[ii][jj*vl]));
+				v_tinv1 = d_lane_div(d_lane_set(1.0), d_lane_load(&bt[ii][(nb0+jj)*vl]));
+				v_l0 = d_lane_load(&blam[ii][jj*vl]);
+				v_l1 = d_lane_load(&blam[ii][(nb0+jj)*vl]);
+				v_rm0 = d_lane_load(&res_m[ii][jj*vl]);
+				v_rm1 = d_lane_load(&res_m[ii][(nb0+jj)*vl]);
+				v_rd0 = d_lane_load(&res_d[ii][jj*vl]);
+				v_rd1 = d_lane_load(&res_d[ii][(nb0+jj)*vl]);
+				d_lane_store(&t_inv[ii][jj*vl], v_tinv0);
+				d_lane_store(&t_inv[ii][(nb0+jj)*vl], v_tinv1);
+				d_lane_store(&Qx[ii][jj*vl], d_lane_fmadd(v_tinv0, v_l0, d_lane_mul(v_tinv1, v_l1)));
+				d_lane_store(&qx[ii][jj*vl], d_lane_sub(d_lane_mul(v_tinv0, d_lane_fnmadd(v_l0, v_rd0, v_rm0)), d_lane_mul(v_tinv1, d_lane_fmadd(v_l1, v_rd1, v_rm1))));
+				}
+			}
+
+		// compute the search direction: factorize and solve the KKT system
+		d_back_ric_trf_batch(N, nx, nu, nb, idxb, bBAbt, bRSQrq, Qx, L, inv_diag_L, P, work);
+		d_back_ric_trs_batch(N, nx, nu, nb, idxb, bBAbt, res_b, res_q, qx, L, inv_diag_L, P, l, p, dux, dpi, work);
+
+		// compute t_aff & dlam_aff & dt_aff & alpha
+		for(ll=0; ll<vl; ll++)
+			alpha[ll] = 1.0;
+		d_compute_alpha_res_mpc_hard_batch(N, nb, idxb, dux, bt, t_inv, blam, res_d, res_m, dt, dlam, alpha);
+
+		for(ll=0; ll<vl; ll++)
+			{
+			if(active[ll])
+				stat[(5*it+1)*vl+ll] = alpha[ll];
+			alpha[ll] *= 0.995;
+			}
+
+		// compute the affine duality gap
+		v_alpha = d_lane_load(alpha);
+		v_mu = v_zero;
+		for(ii=0; ii<=N; ii++)
+			for(jj=0; jj<2*nb[ii]; jj++)
+				{
+				v_lam = d_lane_fmadd(v_alpha, d_lane_load(&dlam[ii][jj*vl]), d_lane_load(&blam[ii][jj*vl]));
+				v_t = d_lane_fmadd(v_alpha, d_lane_load(&dt[ii][jj*vl]), d_lane_load(&bt[ii][jj*vl]));
+				v_mu = d_lane_fmadd(v_lam, v_t, v_mu);
+				}
+		d_lane_store(mu_aff, d_lane_mul(v_mu, d_lane_set(mu_scal)));
+
+		// compute sigma
+		for(ll=0; ll<vl; ll++)
+			{
+			double sigma = mu_aff[ll]/mu[ll];
+			sigma = sigma*sigma*sigma;
+			sigma_mu[ll] = sigma*mu[ll];
+			if(active[ll])
+				{
+				stat[(5*it+0)*vl+ll] = sigma;
+				stat[(5*it+2)*vl+ll] = mu_aff[ll];
+				}
+			}
+
+		// centering correction and update of the gradient
+		v_sigma_mu = d_lane_load(sigma_mu);
+		for(ii=0; ii<=N; ii++)
+			{
+			nb0 = nb[ii];
+			for(jj=0; jj<nb0; jj++)
+				{
+				v_rm0 = d_lane_add(d_lane_load(&res_m[ii][jj*vl]), d_lane_sub(d_lane_mul(d_lane_load(&dt[ii][jj*vl]), d_lane_load(&dlam[ii][jj*vl])), v_sigma_mu));
+				v_rm1 = d_lane_add(d_lane_load(&res_m[ii][(nb0+jj)*vl]), d_lane_sub(d_lane_mul(d_lane_load(&dt[ii][(nb0+jj)*vl]), d_lane_load(&dlam[ii][(nb0+jj)*vl])), v_sigma_mu));
+				d_lane_store(&res_m[ii][jj*vl], v_rm0);
+				d_lane_store(&res_m[ii][(nb0+jj)*vl], v_rm1);
+				v_l0 = d_lane_load(&blam[ii][jj*vl]);
+				v_l1 = d_lane_load(&blam[ii][(nb0+jj)*vl]);
+				v_rd0 = d_lane_load(&res_d[ii][jj*vl]);
+				v_rd1 = d_lane_load(&res_d[ii][(nb0+jj)*vl]);
+				d_lane_store(&qx[ii][jj*vl], d_lane_sub(d_lane_mul(d_lane_load(&t_inv[ii][jj*vl]), d_lane_fnmadd(v_l0, v_rd0, v_rm0)), d_lane_mul(d_lane_load(&t_inv[ii][(nb0+jj)*vl]), d_lane_fmadd(v_l1, v_rd1, v_rm1))));
+				}
+			}
+
+		// solve the system
+		d_back_ric_trs_batch(N, nx, nu, nb, idxb, bBAbt, res_b, res_q, qx, L, inv_diag_L, P, l, p, dux, dpi, work);
+
+		// compute t & dlam & dt & alpha
+		for(ll=0; ll<vl; ll++)
+			alpha[ll] = 1.0;
+		d_compute_alpha_res_mpc_hard_batch(N, nb, idxb, dux, bt, t_inv, blam, res_d, res_m, dt, dlam, alpha);
+
+		for(ll=0; ll<vl; ll++)
+			{
+			if(active[ll])
+				stat[(5*it+3)*vl+ll] = alpha[ll];
+			alpha[ll] *= 0.995;
+			}
+
+		// compute step & update x, u, pi, lam, t; lanes already done do not move
+		for(ll=0; ll<vl; ll++)
+			sigma_mu[ll] = active[ll] ? alpha[ll] : 0.0;
+		v_alpha = d_lane_load(sigma_mu);
+		for(ii=0; ii<=N; ii++)
+			{
+			nu0 = ii<N ? nu[ii] : 0;
+			for(jj=0; jj<nu0+nx[ii]; jj++)
+				d_lane_store(&bux[ii][jj*vl], d_lane_fmadd(v_alpha, d_lane_load(&dux[ii][jj*vl]), d_lane_load(&bux[ii][jj*vl])));
+			if(ii<N)
+				for(jj=0; jj<nx[ii+1]; jj++)
+					d_lane_store(&bpi[ii][jj*vl], d_lane_fmadd(v_alpha, d_lane_load(&dpi[ii][jj*vl]), d_lane_load(&bpi[ii][jj*vl])));
+			for(jj=0; jj<2*nb[ii]; jj++)
+				{
+				d_lane_store(&blam[ii][jj*vl], d_lane_fmadd(v_alpha, d_lane_load(&dlam[ii][jj*vl]), d_lane_load(&blam[ii][jj*vl])));
+				d_lane_store(&bt[ii][jj*vl], d_lane_fmadd(v_alpha, d_lane_load(&dt[ii][jj*vl]), d_lane_load(&bt[ii][jj*vl])));
+				}
+			}
+
+		// compute residuals
+		d_res_res_mpc_hard_batch(N, nx, nu, nb, idxb, bBAbt, bRSQrq, bux, bd, bpi, blam, bt, res_q, res_b, res_d, res_m, mu_scal, mu);
+
+		// increment loop index of the lanes still running
+		n_active = 0;
+		for(ll=0; ll<vl; ll++)
+			{
+			if(active[ll])
+				{
+				stat[(5*it+4)*vl+ll] = mu[ll];
+				kk[ll]++;
+				alpha_end[ll] = alpha[ll];
+				active[ll] = kk[ll]<k_max && mu[ll]>mu_tol && alpha[ll]>=alpha_min;
+				n_active += active[ll];
+				}
+			}
+
+		} // end of IP loop
+
+	// the worst exit status over the lanes, same codes as d_ip2_res_mpc_hard_tv
+	hpmpc_status = 0;
+	for(ll=0; ll<vl; ll++)
+		{
+		if(mu[ll]<=mu_tol)
+			continue;
+		if(kk[ll]>=k_max)
+			{
+			if(hpmpc_status<1) hpmpc_status = 1;
+			}
+		else if(alpha_end[ll]<alpha_min)
+			hpmpc_status = 2;
+		}
+
+	return hpmpc_status;
+
+	} // end of ipsolver
@@ -25,6 +25,11 @@
 
 #include <stdlib.h>
 #include <math.h>
+#if defined(OS_WINDOWS)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
 
 #ifdef BLASFEO
 
@@ -32,6 +37,8 @@
 #include <blasfeo_common.h>
 #include <blasfeo_d_aux.h>
 #include <blasfeo_d_blas.h>
+#include <blasfeo_s_aux.h>
+#include <blasfeo_s_blas.h>
 
 //#else
 #include "../include/blas_d.h"
@@ -47,16 +54,255 @@
 
 
 // use iterative refinement to increase accuracy of the solution of the equality constrained sub-problems
+#if defined(IPM_MIXED_PREC)
+// the KKT system is factorized in single precision, and refined with residuals in double precision
+#define ITER_REF 4
+#else
 #define ITER_REF 0
+#endif
 #define THR_ITER_REF 1e-5
+// relative accuracy of the refined solution, otherwise the KKT system is factorized in double precision
+#define TOL_ITER_REF 1e-11
 //#define ITER_REF_REG 0.0
 #define CORRECTOR_LOW 1
 #define CORRECTOR_HIGH 1
+// max number of Gondzio multiple centrality correctors per iteration with residuals computation, 0 to disable
+#ifndef IPM_GONDZIO
+#define IPM_GONDZIO 0
+#endif
+#define GONDZIO_BETA_MIN 0.1
+#define GONDZIO_BETA_MAX 10.0
+#define GONDZIO_DELTA 0.1
+#define GONDZIO_GAMMA 0.1
+// overlap the riccati and residuals work spaces: they are scratch memory of calls never overlapping, but in the mixed precision riccati
+#if ITER_REF==0
+#define ALIAS_RIC_RES_WORK_SPACE
+#endif
 
 
 
-// work space size 
-int d_ip2_res_mpc_hard_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int *ng)
+#if ITER_REF>0
+// work space size of the mixed precision KKT solver
+static int d_back_ric_rec_mixed_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int *ng)
+	{
+
+	int ii;
+
+	int size = 0;
+
+	for(ii=0; ii<=N; ii++)
+		{
+		size += blasfeo_memsize_smat(nu[ii]+nx[ii], nu[ii]+nx[ii]); // sL
+		size += 2*blasfeo_memsize_svec(nu[ii]+nx[ii]); // srq, sdux
+		size += 2*blasfeo_memsize_svec(nx[ii]); // sdpi, sPb
+		size += 2*blasfeo_memsize_dvec(nu[ii]+nx[ii]); // rq2, res_rq2
+		if(ii<N)
+			{
+			size += blasfeo_memsize_smat(nu[ii]+nx[ii], nx[ii+1]); // sBAbt
+			size += blasfeo_memsize_svec(nx[ii+1]); // sb
+			size += blasfeo_memsize_dvec(nx[ii+1]); // res_b2
+			}
+		}
+
+	size += s_back_ric_rec_work_space_size_bytes_libstr(N, nx, nu, nb, ng);
+
+	return size;
+
+	}
+
+
+
+static void d_cvt_vec2svec(int m, struct blasfeo_dvec *hsx, struct blasfeo_svec *hssx)
+	{
+	int ii;
+	double *x = hsx->pa;
+	float *sx = hssx->pa;
+	for(ii=0; ii<m; ii++)
+		sx[ii] = (float) x[ii];
+	}
+
+
+
+static void d_cvt_svec2vec(int m, struct blasfeo_svec *hssx, struct blasfeo_dvec *hsx)
+	{
+	int ii;
+	double *x = hsx->pa;
+	float *sx = hssx->pa;
+	for(ii=0; ii<m; ii++)
+		x[ii] = (double) sx[ii];
+	}
+
+
+
+// x += sx
+static void d_ad_svec2vec(int m, struct blasfeo_svec *hssx, struct blasfeo_dvec *hsx)
+	{
+	int ii;
+	double *x = hsx->pa;
+	float *sx = hssx->pa;
+	for(ii=0; ii<m; ii++)
+		x[ii] += (double) sx[ii];
+	}
+
+
+
+// lower triangle of an m x m matrix, or full m x n matrix
+static void d_cvt_mat2smat(int m, int n, int lower, struct blasfeo_dmat *hsA, struct blasfeo_smat *hssA)
+	{
+	int ii, jj;
+	for(jj=0; jj<n; jj++)
+		for(ii=(lower ? jj : 0); ii<m; ii++)
+			BLASFEO_SMATEL(hssA, ii, jj) = (float) BLASFEO_DMATEL(hsA, ii, jj);
+	}
+
+
+
+static double d_max_nrm_inf(int N, int *nx, int *nu, struct blasfeo_dvec *hsrq, struct blasfeo_dvec *hsb)
+	{
+	int ii;
+	double nrm, nrm_max = 0.0;
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_dvecnrm_inf(nu[ii]+nx[ii], &hsrq[ii], 0, &nrm);
+		nrm_max = nrm>nrm_max ? nrm : nrm_max;
+		if(ii<N)
+			{
+			blasfeo_dvecnrm_inf(nx[ii+1], &hsb[ii], 0, &nrm);
+			nrm_max = nrm>nrm_max ? nrm : nrm_max;
+			}
+		}
+	return nrm_max;
+	}
+
+
+
+/* solve the KKT system of the IPM iteration using a single precision Riccati factorization, and refine the solution using residuals in double precision;
+if factorize!=0, the Hessian H = RSQrq + Qx (box and general constraints) is built in the lower triangle of hsL and factorized in single precision;
+if the refinement does not converge, hsL is factorized in place in double precision, and *fallback is set to use it until the next factorization */
+static void d_back_ric_rec_sv_mixed_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, int factorize, int *fallback, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsQx, struct blasfeo_dvec *hsqx, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hsPb, struct blasfeo_dmat *hsL, struct d_ip2_res_mpc_hard_solver *ws)
+	{
+
+	int ii, it_ref;
+
+	int *nb0 = ws->i_zeros;
+	int *ng0 = ws->i_zeros;
+	struct blasfeo_smat *hssL = ws->hssL;
+	struct blasfeo_smat *hssBAbt = ws->hssBAbt;
+	struct blasfeo_svec *hssb = ws->hssb;
+	struct blasfeo_svec *hssrq = ws->hssrq;
+	struct blasfeo_svec *hssdux = ws->hssdux;
+	struct blasfeo_svec *hssdpi = ws->hssdpi;
+	struct blasfeo_svec *hssPb = ws->hssPb;
+	struct blasfeo_dvec *hsrq2 = ws->hsrq2;
+	struct blasfeo_dvec *hsres_rq2 = ws->hsres_rq2;
+	struct blasfeo_dvec *hsres_b2 = ws->hsres_b2;
+	struct blasfeo_dmat hswork_mat;
+
+	void *d_ric_work = ws->d_back_ric_rec_work_space;
+	void *d_res_work = ws->d_res_res_mpc_hard_work_space;
+	void *s_ric_work = ws->s_back_ric_rec_work_space;
+
+	double nrm_rhs, nrm_res, nrm_res_old, mu_dummy;
+
+	if(factorize)
+		{
+		*fallback = 0;
+		for(ii=0; ii<=N; ii++)
+			{
+			// Hessian of the equality constrained sub-problem
+			blasfeo_dtrcp_l(nu[ii]+nx[ii], &hsRSQrq[ii], 0, 0, &hsL[ii], 0, 0);
+			if(nb[ii]>0)
+				blasfeo_ddiaad_sp(nb[ii], 1.0, &hsQx[ii], 0, idxb[ii], &hsL[ii], 0, 0);
+			if(ng[ii]>0)
+				{
+				blasfeo_create_dmat(nu[ii]+nx[ii], ng[ii], &hswork_mat, d_ric_work);
+				blasfeo_dgemm_nd(nu[ii]+nx[ii], ng[ii], 1.0, &hsDCt[ii], 0, 0, &hsQx[ii], nb[ii], 0.0, &hswork_mat, 0, 0, &hswork_mat, 0, 0);
+				blasfeo_dsyrk_ln(nu[ii]+nx[ii], ng[ii], 1.0, &hswork_mat, 0, 0, &hsDCt[ii], 0, 0, 1.0, &hsL[ii], 0, 0, &hsL[ii], 0, 0);
+				}
+			d_cvt_mat2smat(nu[ii]+nx[ii], nu[ii]+nx[ii], 1, &hsL[ii], &hssL[ii]);
+			if(ii<N)
+				d_cvt_mat2smat(nu[ii]+nx[ii], nx[ii+1], 0, &hsBAbt[ii], &hssBAbt[ii]);
+			}
+		s_back_ric_rec_trf_libstr(N, nx, nu, nb0, idxb, ng0, hssBAbt, hssL, hssL, hssdux, hssL, s_ric_work);
+		}
+
+	// gradient of the equality constrained sub-problem
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_dveccp(nu[ii]+nx[ii], &hsrq[ii], 0, &hsrq2[ii], 0);
+		if(nb[ii]>0)
+			blasfeo_dvecad_sp(nb[ii], 1.0, &hsqx[ii], 0, idxb[ii], &hsrq2[ii], 0);
+		if(ng[ii]>0)
+			blasfeo_dgemv_n(nu[ii]+nx[ii], ng[ii], 1.0, &hsDCt[ii], 0, 0, &hsqx[ii], nb[ii], 1.0, &hsrq2[ii], 0, &hsrq2[ii], 0);
+		}
+
+	if(*fallback==0)
+		{
+
+		// solve in single precision
+		for(ii=0; ii<=N; ii++)
+			{
+			d_cvt_vec2svec(nu[ii]+nx[ii], &hsrq2[ii], &hssrq[ii]);
+			if(ii<N)
+				d_cvt_vec2svec(nx[ii+1], &hsb[ii], &hssb[ii]);
+			}
+		s_back_ric_rec_trs_libstr(N, nx, nu, nb0, idxb, ng0, hssBAbt, hssb, hssrq, hssL, hssdux, hssdux, 1, hssdpi, 1, hssPb, hssL, s_ric_work);
+		for(ii=0; ii<=N; ii++)
+			{
+			d_cvt_svec2vec(nu[ii]+nx[ii], &hssdux[ii], &hsux[ii]);
+			if(ii>0)
+				d_cvt_svec2vec(nx[ii], &hssdpi[ii], &hspi[ii]);
+			}
+
+		nrm_rhs = d_max_nrm_inf(N, nx, nu, hsrq2, hsb);
+		nrm_res_old = 0.0;
+
+		// iterative refinement
+		for(it_ref=0; it_ref<=ITER_REF; it_ref++)
+			{
+			// residuals of the equality constrained sub-problem
+			d_res_res_mpc_hard_libstr(N, nx, nu, nb0, idxb, ng0, hsBAbt, hsb, hsL, hsrq2, hsux, hsDCt, hsrq2, hspi, hsrq2, hsrq2, hsres_rq2, hsres_b2, hsrq2, hsrq2, &mu_dummy, d_res_work);
+			nrm_res = d_max_nrm_inf(N, nx, nu, hsres_rq2, hsres_b2);
+			if(nrm_res<=TOL_ITER_REF*nrm_rhs)
+				return;
+			// too slow convergence
+			if(it_ref==ITER_REF || (it_ref>0 && nrm_res>0.5*nrm_res_old))
+				break;
+			nrm_res_old = nrm_res;
+			// correction in single precision
+			for(ii=0; ii<=N; ii++)
+				{
+				d_cvt_vec2svec(nu[ii]+nx[ii], &hsres_rq2[ii], &hssrq[ii]);
+				if(ii<N)
+					d_cvt_vec2svec(nx[ii+1], &hsres_b2[ii], &hssb[ii]);
+				}
+			s_back_ric_rec_trs_libstr(N, nx, nu, nb0, idxb, ng0, hssBAbt, hssb, hssrq, hssL, hssdux, hssdux, 1, hssdpi, 1, hssPb, hssL, s_ric_work);
+			for(ii=0; ii<=N; ii++)
+				{
+				d_ad_svec2vec(nu[ii]+nx[ii], &hssdux[ii], &hsux[ii]);
+				if(ii>0)
+					d_ad_svec2vec(nx[ii], &hssdpi[ii], &hspi[ii]);
+				}
+			}
+
+		// factorize in double precision
+		d_back_ric_rec_trf_libstr(N, nx, nu, nb0, idxb, ng0, hsBAbt, hsL, hsL, hsrq2, hsL, d_ric_work);
+		*fallback = 1;
+
+		}
+
+	// solve in double precision
+	d_back_ric_rec_trs_libstr(N, nx, nu, nb0, idxb, ng0, hsBAbt, hsb, hsrq2, hsL, hsrq2, hsux, 1, hspi, 1, hsPb, hsL, d_ric_work);
+
+	return;
+
+	}
+#endif
+
+
+
+// work space size, each buffer in its own memory; the *_best buffers are only used in real-time mode, but are always included
+static int d_ip2_res_mpc_hard_work_space_size_bytes_no_alias_libstr(int N, int *nx, int *nu, int *nb, int *ng)
 	{
 
 	int ii;
@@ -66,10 +312,15 @@ int d_ip2_res_mpc_hard_work_space_size_bytes_libstr(int N, int *nx, int *nu, int
 	for(ii=0; ii<=N; ii++)
 		{
 		size += blasfeo_memsize_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii]); // L
-		size += 5*blasfeo_memsize_dvec(nx[ii]); // b, dpi, Pb, res_b, pi_bkp
-		size += 4*blasfeo_memsize_dvec(nu[ii]+nx[ii]); // dux, rq, res_rq, ux_bkp
-		size += 8*blasfeo_memsize_dvec(2*nb[ii]+2*ng[ii]); // dlam, dt, tinv, lamt, res_d, res_m, t_bkp, lam_bkp
+		size += 6*blasfeo_memsize_dvec(nx[ii]); // b, dpi, Pb, res_b, pi_bkp, pi_best
+		size += 5*blasfeo_memsize_dvec(nu[ii]+nx[ii]); // dux, rq, res_rq, ux_bkp, ux_best
+		size += 10*blasfeo_memsize_dvec(2*nb[ii]+2*ng[ii]); // dlam, dt, tinv, lamt, res_d, res_m, t_bkp, lam_bkp, t_best, lam_best
 		size += 2*blasfeo_memsize_dvec(nb[ii]+ng[ii]); // Qx, qx
+#if IPM_GONDZIO>0
+		size += blasfeo_memsize_dvec(nu[ii]+nx[ii]); // dux_cor
+		size += blasfeo_memsize_dvec(nx[ii]); // dpi_cor
+		size += 2*blasfeo_memsize_dvec(2*nb[ii]+2*ng[ii]); // dt_cor, dlam_cor
+#endif
 		}
 
 	// residuals work space size
@@ -78,6 +329,21 @@ int d_ip2_res_mpc_hard_work_space_size_bytes_libstr(int N, int *nx, int *nu, int
 	// riccati work space size
 	size += d_back_ric_rec_work_space_size_bytes_libstr(N, nx, nu, nb, ng);
 
+#if ITER_REF>0
+	// mixed precision riccati work space size
+	size += d_back_ric_rec_mixed_work_space_size_bytes_libstr(N, nx, nu, nb, ng);
+#endif
+
+#if defined(RIC_PAR_CHUNKS)
+	// parallel-in-time riccati work space size
+	size += d_par_back_ric_rec_work_space_size_bytes_libstr(N, nx, nu, nb, ng, RIC_PAR_CHUNKS);
+#endif
+
+#if defined(IPM_STAGE_MAJOR)
+	// each stage starts at (typical) cache line boundary
+	size += (N+1)*64;
+#endif
+
 	// make multiple of (typical) cache line size
 	size = (size+63)/64*64;
 
@@ -86,164 +352,660 @@ int d_ip2_res_mpc_hard_work_space_size_bytes_libstr(int N, int *nx, int *nu, int
 
 
 
-// basic working version
+// work space planner: buffers never live at the same time share the same memory:
+// lamt is only live in the iterations without residuals, res_m in the iterations with residuals and in the kkt solve with new rhs;
+// with ALIAS_RIC_RES_WORK_SPACE, the riccati and the residuals work spaces overlap
+void d_ip2_res_mpc_hard_work_space_plan_libstr(int N, int *nx, int *nu, int *nb, int *ng, int *size_no_alias, int *size)
+	{
 
-/* primal-dual interior-point method computing residuals at each iteration, hard constraints, time variant matrices, time variant size (mpc version) */
-int d_ip2_res_mpc_hard_libstr(int *kk, int k_max, double mu0, double mu_tol, double alpha_min, int warm_start, double *stat, int N, int *nx, int *nu, int *nb, int **idxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, void *work)
+	int ii;
+
+	*size_no_alias = d_ip2_res_mpc_hard_work_space_size_bytes_no_alias_libstr(N, nx, nu, nb, ng);
+
+	*size = *size_no_alias;
+
+	// res_m overlaps lamt
+	for(ii=0; ii<=N; ii++)
+		*size -= blasfeo_memsize_dvec(2*nb[ii]+2*ng[ii]);
+
+#if defined(ALIAS_RIC_RES_WORK_SPACE)
+	// riccati and residuals work spaces overlap
+	int size_ric = d_back_ric_rec_work_space_size_bytes_libstr(N, nx, nu, nb, ng);
+	int size_res = d_res_res_mpc_hard_work_space_size_bytes_libstr(N, nx, nu, nb, ng);
+	*size -= size_ric<size_res ? size_ric : size_res;
+#endif
+
+	// make multiple of (typical) cache line size
+	*size = (*size+63)/64*64;
+
+	return;
+	}
+
+
+
+// work space size
+int d_ip2_res_mpc_hard_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int *ng)
 	{
 
-	// indeces
-	int jj, ll, ii, it_ref;
+	int size_no_alias, size;
 
+	d_ip2_res_mpc_hard_work_space_plan_libstr(N, nx, nu, nb, ng, &size_no_alias, &size);
 
-	struct blasfeo_dmat *hsmatdummy;
-	struct blasfeo_dvec *hsvecdummy;
+	return size;
+	}
 
-	// TODO do not use variable size arrays !!!!!
-	struct blasfeo_dvec hsb[N];
-	struct blasfeo_dvec hsrq[N+1];
-	struct blasfeo_dvec hsQx[N+1];
-	struct blasfeo_dvec hsqx[N+1];
-	struct blasfeo_dvec hsdux[N+1];
-	struct blasfeo_dvec hsdpi[N+1];
-	struct blasfeo_dvec hsdt[N+1];
-	struct blasfeo_dvec hsdlam[N+1];
-	struct blasfeo_dvec hstinv[N+1];
-	struct blasfeo_dvec hslamt[N+1];
-	struct blasfeo_dvec hsPb[N+1];
-	struct blasfeo_dmat hsL[N+1];
-	struct blasfeo_dvec hsres_rq[N+1];
-	struct blasfeo_dvec hsres_b[N];
-	struct blasfeo_dvec hsres_d[N+1];
-	struct blasfeo_dvec hsres_m[N+1];
-	struct blasfeo_dmat hsric_work_mat[2];
-	struct blasfeo_dvec hsric_work_vec[1];
-	struct blasfeo_dvec hsux_bkp[N+1];
-	struct blasfeo_dvec hspi_bkp[N+1];
-	struct blasfeo_dvec hst_bkp[N+1];
-	struct blasfeo_dvec hslam_bkp[N+1];
-
-	void *d_back_ric_rec_work_space;
-	void *d_res_res_mpc_hard_work_space;
+
+
+// descriptors of the work space
+static int d_ip2_res_mpc_hard_ptr_memsize_libstr(int N)
+	{
+
+	int size = 0;
+
+	size += (N+1)*sizeof(struct blasfeo_dmat); // L
+	size += (2*N+21*(N+1))*sizeof(struct blasfeo_dvec); // b, res_b, rq, Qx, qx, dux, dpi, dt, dlam, tinv, lamt, Pb, res_rq, res_d, res_m, ux_bkp, pi_bkp, t_bkp, lam_bkp, ux_best, pi_best, t_best, lam_best
+	size += 4*(N+1)*sizeof(struct blasfeo_dvec); // dux_cor, dpi_cor, dt_cor, dlam_cor
+#if ITER_REF>0
+	size += (2*N+1)*sizeof(struct blasfeo_smat); // sL, sBAbt
+	size += (N+4*(N+1))*sizeof(struct blasfeo_svec); // sb, srq, sdux, sdpi, sPb
+	size += (N+2*(N+1))*sizeof(struct blasfeo_dvec); // res_b2, rq2, res_rq2
+	size += (N+1)*sizeof(int); // zeros
+#endif
+
+	return size;
+	}
+
+
+
+static void d_ip2_res_mpc_hard_create_ptr_libstr(int N, struct d_ip2_res_mpc_hard_solver *ws, void *memory)
+	{
+
+	struct blasfeo_dmat *sm_ptr = (struct blasfeo_dmat *) memory;
+
+	ws->hsL = sm_ptr;
+	sm_ptr += N+1;
+
+	struct blasfeo_dvec *sv_ptr = (struct blasfeo_dvec *) sm_ptr;
+
+	ws->hsb = sv_ptr;
+	sv_ptr += N;
+	ws->hsrq = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsQx = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsqx = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsdux = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsdpi = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsdt = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsdlam = sv_ptr;
+	sv_ptr += N+1;
+	ws->hstinv = sv_ptr;
+	sv_ptr += N+1;
+	ws->hslamt = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsPb = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsres_rq = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsres_b = sv_ptr;
+	sv_ptr += N;
+	ws->hsres_d = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsres_m = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsux_bkp = sv_ptr;
+	sv_ptr += N+1;
+	ws->hspi_bkp = sv_ptr;
+	sv_ptr += N+1;
+	ws->hst_bkp = sv_ptr;
+	sv_ptr += N+1;
+	ws->hslam_bkp = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsux_best = sv_ptr;
+	sv_ptr += N+1;
+	ws->hspi_best = sv_ptr;
+	sv_ptr += N+1;
+	ws->hst_best = sv_ptr;
+	sv_ptr += N+1;
+	ws->hslam_best = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsdux_cor = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsdpi_cor = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsdt_cor = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsdlam_cor = sv_ptr;
+	sv_ptr += N+1;
+
+#if ITER_REF>0
+	ws->hsrq2 = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsres_rq2 = sv_ptr;
+	sv_ptr += N+1;
+	ws->hsres_b2 = sv_ptr;
+	sv_ptr += N;
+
+	struct blasfeo_smat *ssm_ptr = (struct blasfeo_smat *) sv_ptr;
+
+	ws->hssL = ssm_ptr;
+	ssm_ptr += N+1;
+	ws->hssBAbt = ssm_ptr;
+	ssm_ptr += N;
+
+	struct blasfeo_svec *ssv_ptr = (struct blasfeo_svec *) ssm_ptr;
+
+	ws->hssb = ssv_ptr;
+	ssv_ptr += N;
+	ws->hssrq = ssv_ptr;
+	ssv_ptr += N+1;
+	ws->hssdux = ssv_ptr;
+	ssv_ptr += N+1;
+	ws->hssdpi = ssv_ptr;
+	ssv_ptr += N+1;
+	ws->hssPb = ssv_ptr;
+	ssv_ptr += N+1;
+
+	ws->i_zeros = (int *) ssv_ptr;
+#else
+	ws->hssL = NULL;
+	ws->hssBAbt = NULL;
+	ws->hssb = NULL;
+	ws->hssrq = NULL;
+	ws->hssdux = NULL;
+	ws->hssdpi = NULL;
+	ws->hssPb = NULL;
+	ws->hsrq2 = NULL;
+	ws->hsres_rq2 = NULL;
+	ws->hsres_b2 = NULL;
+	ws->i_zeros = NULL;
+#endif
+
+	return;
+
+	}
+
+
+
+// create the work space structures in work; the layout is shared by the IPM and the KKT solve with new rhs
+static void d_ip2_res_mpc_hard_create_work_space_libstr(struct d_ip2_res_mpc_hard_solver *ws, void *work)
+	{
+
+	int ii;
+
+	int N = ws->N;
+	int *nx = ws->nx;
+	int *nu = ws->nu;
+	int *nb = ws->nb;
+	int *ng = ws->ng;
+
+#if ITER_REF==0
+	ws->d_back_ric_rec_mixed_work_space = NULL;
+	ws->s_back_ric_rec_work_space = NULL;
+#endif
+#if !defined(RIC_PAR_CHUNKS)
+	ws->d_par_back_ric_rec_work_space = NULL;
+#endif
 
 	char *c_ptr = work;
 
+#if defined(ALIAS_RIC_RES_WORK_SPACE)
+	// riccati and residuals work spaces
+	int size_ric = d_back_ric_rec_work_space_size_bytes_libstr(N, nx, nu, nb, ng);
+	int size_res = d_res_res_mpc_hard_work_space_size_bytes_libstr(N, nx, nu, nb, ng);
+	ws->d_back_ric_rec_work_space = (void *) c_ptr;
+	ws->d_res_res_mpc_hard_work_space = (void *) c_ptr;
+	c_ptr += size_ric>size_res ? size_ric : size_res;
+#else
 	// riccati work space
-	d_back_ric_rec_work_space = (void *) c_ptr;
+	ws->d_back_ric_rec_work_space = (void *) c_ptr;
 	c_ptr += d_back_ric_rec_work_space_size_bytes_libstr(N, nx, nu, nb, ng);
 
 	// residuals work space
-	d_res_res_mpc_hard_work_space = (void *) c_ptr;
+	ws->d_res_res_mpc_hard_work_space = (void *) c_ptr;
 	c_ptr += d_res_res_mpc_hard_work_space_size_bytes_libstr(N, nx, nu, nb, ng);
+#endif
 
+#if ITER_REF>0
+	// mixed precision riccati work space: single precision factorization, double precision refinement
+	ws->d_back_ric_rec_mixed_work_space = (void *) c_ptr;
+	for(ii=0; ii<=N; ii++)
+		{
+		ws->i_zeros[ii] = 0;
+		blasfeo_create_smat(nu[ii]+nx[ii], nu[ii]+nx[ii], &ws->hssL[ii], (void *) c_ptr);
+		c_ptr += ws->hssL[ii].memsize;
+		blasfeo_create_svec(nu[ii]+nx[ii], &ws->hssrq[ii], (void *) c_ptr);
+		c_ptr += ws->hssrq[ii].memsize;
+		blasfeo_create_svec(nu[ii]+nx[ii], &ws->hssdux[ii], (void *) c_ptr);
+		c_ptr += ws->hssdux[ii].memsize;
+		blasfeo_create_svec(nx[ii], &ws->hssdpi[ii], (void *) c_ptr);
+		c_ptr += ws->hssdpi[ii].memsize;
+		blasfeo_create_svec(nx[ii], &ws->hssPb[ii], (void *) c_ptr);
+		c_ptr += ws->hssPb[ii].memsize;
+		blasfeo_create_dvec(nu[ii]+nx[ii], &ws->hsrq2[ii], (void *) c_ptr);
+		c_ptr += ws->hsrq2[ii].memsize;
+		blasfeo_create_dvec(nu[ii]+nx[ii], &ws->hsres_rq2[ii], (void *) c_ptr);
+		c_ptr += ws->hsres_rq2[ii].memsize;
+		if(ii<N)
+			{
+			blasfeo_create_smat(nu[ii]+nx[ii], nx[ii+1], &ws->hssBAbt[ii], (void *) c_ptr);
+			c_ptr += ws->hssBAbt[ii].memsize;
+			blasfeo_create_svec(nx[ii+1], &ws->hssb[ii], (void *) c_ptr);
+			c_ptr += ws->hssb[ii].memsize;
+			blasfeo_create_dvec(nx[ii+1], &ws->hsres_b2[ii], (void *) c_ptr);
+			c_ptr += ws->hsres_b2[ii].memsize;
+			}
+		}
+	ws->s_back_ric_rec_work_space = (void *) c_ptr;
+	c_ptr += s_back_ric_rec_work_space_size_bytes_libstr(N, nx, nu, nb, ng);
+#endif
+
+#if defined(RIC_PAR_CHUNKS)
+	// parallel-in-time riccati work space
+	ws->d_par_back_ric_rec_work_space = (void *) c_ptr;
+	c_ptr += d_par_back_ric_rec_work_space_size_bytes_libstr(N, nx, nu, nb, ng, RIC_PAR_CHUNKS);
+#endif
+
+#if defined(IPM_STAGE_MAJOR)
+	// stage-major layout: all the data of a stage are contiguous, and each stage starts at (typical) cache line boundary
+	size_t addr;
+	for(ii=0; ii<=N; ii++)
+		{
+		// L
+		blasfeo_create_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], &ws->hsL[ii], (void *) c_ptr);
+		c_ptr += ws->hsL[ii].memsize;
+		// b as vector, backup of P*b
+		if(ii<N)
+			{
+			blasfeo_create_dvec(nx[ii+1], &ws->hsb[ii], (void *) c_ptr);
+			c_ptr += ws->hsb[ii].memsize;
+			}
+		blasfeo_create_dvec(nx[ii], &ws->hsPb[ii], (void *) c_ptr);
+		c_ptr += ws->hsPb[ii].memsize;
+		// linear part of cost function
+		blasfeo_create_dvec(nu[ii]+nx[ii], &ws->hsrq[ii], (void *) c_ptr);
+		c_ptr += ws->hsrq[ii].memsize;
+		blasfeo_create_dvec(nb[ii]+ng[ii], &ws->hsQx[ii], (void *) c_ptr);
+		c_ptr += ws->hsQx[ii].memsize;
+		blasfeo_create_dvec(nb[ii]+ng[ii], &ws->hsqx[ii], (void *) c_ptr);
+		c_ptr += ws->hsqx[ii].memsize;
+		// inputs and states step, equality constr multipliers step
+		blasfeo_create_dvec(nu[ii]+nx[ii], &ws->hsdux[ii], (void *) c_ptr);
+		c_ptr += ws->hsdux[ii].memsize;
+		blasfeo_create_dvec(nx[ii], &ws->hsdpi[ii], (void *) c_ptr);
+		c_ptr += ws->hsdpi[ii].memsize;
+		// slack variables, Lagrangian multipliers for inequality constraints and work space
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hsdlam[ii], (void *) c_ptr);
+		c_ptr += ws->hsdlam[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hsdt[ii], (void *) c_ptr);
+		c_ptr += ws->hsdt[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hstinv[ii], (void *) c_ptr);
+		c_ptr += ws->hstinv[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hslamt[ii], (void *) c_ptr);
+		c_ptr += ws->hslamt[ii].memsize;
+		// residuals
+		blasfeo_create_dvec(nu[ii]+nx[ii], &ws->hsres_rq[ii], (void *) c_ptr);
+		c_ptr += ws->hsres_rq[ii].memsize;
+		if(ii<N)
+			{
+			blasfeo_create_dvec(nx[ii+1], &ws->hsres_b[ii], (void *) c_ptr);
+			c_ptr += ws->hsres_b[ii].memsize;
+			}
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hsres_d[ii], (void *) c_ptr);
+		c_ptr += ws->hsres_d[ii].memsize;
+		// res_m overlaps lamt
+		ws->hsres_m[ii] = ws->hslamt[ii];
+		// backup solution
+		blasfeo_create_dvec(nu[ii]+nx[ii], &ws->hsux_bkp[ii], (void *) c_ptr);
+		c_ptr += ws->hsux_bkp[ii].memsize;
+		blasfeo_create_dvec(nx[ii], &ws->hspi_bkp[ii], (void *) c_ptr);
+		c_ptr += ws->hspi_bkp[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hslam_bkp[ii], (void *) c_ptr);
+		c_ptr += ws->hslam_bkp[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hst_bkp[ii], (void *) c_ptr);
+		c_ptr += ws->hst_bkp[ii].memsize;
+		// best iterate in real-time mode
+		blasfeo_create_dvec(nu[ii]+nx[ii], &ws->hsux_best[ii], (void *) c_ptr);
+		c_ptr += ws->hsux_best[ii].memsize;
+		blasfeo_create_dvec(nx[ii], &ws->hspi_best[ii], (void *) c_ptr);
+		c_ptr += ws->hspi_best[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hslam_best[ii], (void *) c_ptr);
+		c_ptr += ws->hslam_best[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hst_best[ii], (void *) c_ptr);
+		c_ptr += ws->hst_best[ii].memsize;
+#if IPM_GONDZIO>0
+		// backup of the search direction
+		blasfeo_create_dvec(nu[ii]+nx[ii], &ws->hsdux_cor[ii], (void *) c_ptr);
+		c_ptr += ws->hsdux_cor[ii].memsize;
+		blasfeo_create_dvec(nx[ii], &ws->hsdpi_cor[ii], (void *) c_ptr);
+		c_ptr += ws->hsdpi_cor[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hsdt_cor[ii], (void *) c_ptr);
+		c_ptr += ws->hsdt_cor[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hsdlam_cor[ii], (void *) c_ptr);
+		c_ptr += ws->hsdlam_cor[ii].memsize;
+#endif
+		// next stage
+		addr = (( (size_t) c_ptr ) + 63 ) / 64 * 64;
+		c_ptr = (char *) addr;
+		}
+#else
+	// quantity-major layout: the data of each type are contiguous across the stages
 	// L
 	for(ii=0; ii<=N; ii++)
 		{
-		blasfeo_create_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], &hsL[ii], (void *) c_ptr);
-		c_ptr += hsL[ii].memsize;
+		blasfeo_create_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], &ws->hsL[ii], (void *) c_ptr);
+		c_ptr += ws->hsL[ii].memsize;
 		}
 
 	// b as vector
 	for(ii=0; ii<N; ii++)
 		{
-		blasfeo_create_dvec(nx[ii+1], &hsb[ii], (void *) c_ptr);
-		c_ptr += hsb[ii].memsize;
+		blasfeo_create_dvec(nx[ii+1], &ws->hsb[ii], (void *) c_ptr);
+		c_ptr += ws->hsb[ii].memsize;
 		}
 
 	// inputs and states step
 	for(ii=0; ii<=N; ii++)
 		{
-		blasfeo_create_dvec(nu[ii]+nx[ii], &hsdux[ii], (void *) c_ptr);
-		c_ptr += hsdux[ii].memsize;
+		blasfeo_create_dvec(nu[ii]+nx[ii], &ws->hsdux[ii], (void *) c_ptr);
+		c_ptr += ws->hsdux[ii].memsize;
 		}
 
 	// equality constr multipliers step
 	for(ii=0; ii<=N; ii++)
 		{
-		blasfeo_create_dvec(nx[ii], &hsdpi[ii], (void *) c_ptr);
-		c_ptr += hsdpi[ii].memsize;
+		blasfeo_create_dvec(nx[ii], &ws->hsdpi[ii], (void *) c_ptr);
+		c_ptr += ws->hsdpi[ii].memsize;
 		}
 
 	// backup of P*b
 	for(ii=0; ii<=N; ii++)
 		{
-		blasfeo_create_dvec(nx[ii], &hsPb[ii], (void *) c_ptr);
-		c_ptr += hsPb[ii].memsize;
+		blasfeo_create_dvec(nx[ii], &ws->hsPb[ii], (void *) c_ptr);
+		c_ptr += ws->hsPb[ii].memsize;
 		}
 
 	// linear part of cost function
 	for(ii=0; ii<=N; ii++)
 		{
-		blasfeo_create_dvec(nu[ii]+nx[ii], &hsrq[ii], (void *) c_ptr);
-		c_ptr += hsrq[ii].memsize;
+		blasfeo_create_dvec(nu[ii]+nx[ii], &ws->hsrq[ii], (void *) c_ptr);
+		c_ptr += ws->hsrq[ii].memsize;
 		}
 
 	// slack variables, Lagrangian multipliers for inequality constraints and work space
 	for(ii=0; ii<=N; ii++)
 		{
-		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &hsdlam[ii], (void *) c_ptr);
-		c_ptr += hsdlam[ii].memsize;
-		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &hsdt[ii], (void *) c_ptr);
-		c_ptr += hsdt[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hsdlam[ii], (void *) c_ptr);
+		c_ptr += ws->hsdlam[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hsdt[ii], (void *) c_ptr);
+		c_ptr += ws->hsdt[ii].memsize;
 		}
 
 	for(ii=0; ii<=N; ii++)
 		{
-		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &hstinv[ii], (void *) c_ptr);
-		c_ptr += hstinv[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hstinv[ii], (void *) c_ptr);
+		c_ptr += ws->hstinv[ii].memsize;
 		}
 
 	for(ii=0; ii<=N; ii++)
 		{
-		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &hslamt[ii], (void *) c_ptr);
-		c_ptr += hslamt[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hslamt[ii], (void *) c_ptr);
+		c_ptr += ws->hslamt[ii].memsize;
 		}
 
 	for(ii=0; ii<=N; ii++)
 		{
-		blasfeo_create_dvec(nb[ii]+ng[ii], &hsQx[ii], (void *) c_ptr);
-		c_ptr += hsQx[ii].memsize;
-		blasfeo_create_dvec(nb[ii]+ng[ii], &hsqx[ii], (void *) c_ptr);
-		c_ptr += hsqx[ii].memsize;
+		blasfeo_create_dvec(nb[ii]+ng[ii], &ws->hsQx[ii], (void *) c_ptr);
+		c_ptr += ws->hsQx[ii].memsize;
+		blasfeo_create_dvec(nb[ii]+ng[ii], &ws->hsqx[ii], (void *) c_ptr);
+		c_ptr += ws->hsqx[ii].memsize;
 		}
 
 	for(ii=0; ii<=N; ii++)
 		{
-		blasfeo_create_dvec(nu[ii]+nx[ii], &hsres_rq[ii], (void *) c_ptr);
-		c_ptr += hsres_rq[ii].memsize;
+		blasfeo_create_dvec(nu[ii]+nx[ii], &ws->hsres_rq[ii], (void *) c_ptr);
+		c_ptr += ws->hsres_rq[ii].memsize;
 		}
 
 	for(ii=0; ii<N; ii++)
 		{
-		blasfeo_create_dvec(nx[ii+1], &hsres_b[ii], (void *) c_ptr);
-		c_ptr += hsres_b[ii].memsize;
+		blasfeo_create_dvec(nx[ii+1], &ws->hsres_b[ii], (void *) c_ptr);
+		c_ptr += ws->hsres_b[ii].memsize;
 		}
 
 	for(ii=0; ii<=N; ii++)
 		{
-		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &hsres_d[ii], (void *) c_ptr);
-		c_ptr += hsres_d[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hsres_d[ii], (void *) c_ptr);
+		c_ptr += ws->hsres_d[ii].memsize;
 		}
 
+	// res_m overlaps lamt
 	for(ii=0; ii<=N; ii++)
 		{
-		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &hsres_m[ii], (void *) c_ptr);
-		c_ptr += hsres_m[ii].memsize;
+		ws->hsres_m[ii] = ws->hslamt[ii];
 		}
 
 	// backup solution
 	for(ii=0; ii<=N; ii++)
 		{
-		blasfeo_create_dvec(nu[ii]+nx[ii], &hsux_bkp[ii], (void *) c_ptr);
-		c_ptr += hsux_bkp[ii].memsize;
-		blasfeo_create_dvec(nx[ii], &hspi_bkp[ii], (void *) c_ptr);
-		c_ptr += hspi_bkp[ii].memsize;
-		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &hslam_bkp[ii], (void *) c_ptr);
-		c_ptr += hslam_bkp[ii].memsize;
-		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &hst_bkp[ii], (void *) c_ptr);
-		c_ptr += hst_bkp[ii].memsize;
+		blasfeo_create_dvec(nu[ii]+nx[ii], &ws->hsux_bkp[ii], (void *) c_ptr);
+		c_ptr += ws->hsux_bkp[ii].memsize;
+		blasfeo_create_dvec(nx[ii], &ws->hspi_bkp[ii], (void *) c_ptr);
+		c_ptr += ws->hspi_bkp[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hslam_bkp[ii], (void *) c_ptr);
+		c_ptr += ws->hslam_bkp[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hst_bkp[ii], (void *) c_ptr);
+		c_ptr += ws->hst_bkp[ii].memsize;
+		}
+
+	// best iterate in real-time mode
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_create_dvec(nu[ii]+nx[ii], &ws->hsux_best[ii], (void *) c_ptr);
+		c_ptr += ws->hsux_best[ii].memsize;
+		blasfeo_create_dvec(nx[ii], &ws->hspi_best[ii], (void *) c_ptr);
+		c_ptr += ws->hspi_best[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hslam_best[ii], (void *) c_ptr);
+		c_ptr += ws->hslam_best[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hst_best[ii], (void *) c_ptr);
+		c_ptr += ws->hst_best[ii].memsize;
+		}
+
+#if IPM_GONDZIO>0
+	// backup of the search direction
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_create_dvec(nu[ii]+nx[ii], &ws->hsdux_cor[ii], (void *) c_ptr);
+		c_ptr += ws->hsdux_cor[ii].memsize;
+		blasfeo_create_dvec(nx[ii], &ws->hsdpi_cor[ii], (void *) c_ptr);
+		c_ptr += ws->hsdpi_cor[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hsdt_cor[ii], (void *) c_ptr);
+		c_ptr += ws->hsdt_cor[ii].memsize;
+		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &ws->hsdlam_cor[ii], (void *) c_ptr);
+		c_ptr += ws->hsdlam_cor[ii].memsize;
+		}
+#endif
+
+#endif
+
+	return;
+
+	}
+
+
+
+// copy the search direction (or the iterate)
+static void d_ip2_res_mpc_hard_copy_dir_libstr(int N, int *nx, int *nu, int *nb, int *ng, struct blasfeo_dvec *hsdux, struct blasfeo_dvec *hsdpi, struct blasfeo_dvec *hsdt, struct blasfeo_dvec *hsdlam, struct blasfeo_dvec *hsdux_out, struct blasfeo_dvec *hsdpi_out, struct blasfeo_dvec *hsdt_out, struct blasfeo_dvec *hsdlam_out)
+	{
+
+	int ii;
+
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_dveccp(nu[ii]+nx[ii], &hsdux[ii], 0, &hsdux_out[ii], 0);
+		blasfeo_dveccp(nx[ii], &hsdpi[ii], 0, &hsdpi_out[ii], 0);
+		blasfeo_dveccp(2*nb[ii]+2*ng[ii], &hsdt[ii], 0, &hsdt_out[ii], 0);
+		blasfeo_dveccp(2*nb[ii]+2*ng[ii], &hsdlam[ii], 0, &hsdlam_out[ii], 0);
+		}
+
+	return;
+
+	}
+
+
+
+// monotonic wall clock time in seconds
+static double d_ip2_res_mpc_hard_time_libstr()
+	{
+#if defined(OS_WINDOWS)
+	LARGE_INTEGER freq, count;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&count);
+	return (double) count.QuadPart / freq.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + 1e-9*ts.tv_nsec;
+#endif
+	}
+
+
+
+// update the iteration timings; returns 1 if one more iteration is predicted to exceed the time budget
+static int d_ip2_res_mpc_hard_check_deadline_libstr(double time_budget, double t_start, double *t_last, double *t_iter_max)
+	{
+
+	if(time_budget<=0.0)
+		return 0;
+
+	double t_now = d_ip2_res_mpc_hard_time_libstr();
+	double t_iter = t_now - *t_last;
+	*t_last = t_now;
+	if(t_iter>*t_iter_max)
+		*t_iter_max = t_iter;
+
+	// predict the cost of the next iteration with the slowest one so far
+	return t_now - t_start + *t_iter_max > time_budget;
+
+	}
+
+
+
+// largest of the duality gap and of the inf norm of the residuals
+static double d_ip2_res_mpc_hard_res_nrm_libstr(int N, int *nx, int *nu, int *nb, int *ng, struct blasfeo_dvec *hsres_rq, struct blasfeo_dvec *hsres_b, struct blasfeo_dvec *hsres_d, double mu)
+	{
+	int ii;
+	double nrm, nrm_max = mu;
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_dvecnrm_inf(nu[ii]+nx[ii], &hsres_rq[ii], 0, &nrm);
+		nrm_max = nrm>nrm_max ? nrm : nrm_max;
+		if(ii<N)
+			{
+			blasfeo_dvecnrm_inf(nx[ii+1], &hsres_b[ii], 0, &nrm);
+			nrm_max = nrm>nrm_max ? nrm : nrm_max;
+			}
+		blasfeo_dvecnrm_inf(2*nb[ii]+2*ng[ii], &hsres_d[ii], 0, &nrm);
+		nrm_max = nrm>nrm_max ? nrm : nrm_max;
+		}
+	return nrm_max;
+	}
+
+
+
+// store the current iterate if its merit is the smallest so far (or if none is stored, i.e. *merit_best<0); returns 1 if stored
+static int d_ip2_res_mpc_hard_keep_best_libstr(int N, int *nx, int *nu, int *nb, int *ng, double merit, double *merit_best, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hst, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hsux_best, struct blasfeo_dvec *hspi_best, struct blasfeo_dvec *hst_best, struct blasfeo_dvec *hslam_best)
+	{
+
+	if(*merit_best>=0.0 && merit>=*merit_best)
+		return 0;
+
+	*merit_best = merit;
+	d_ip2_res_mpc_hard_copy_dir_libstr(N, nx, nu, nb, ng, hsux, hspi, hst, hslam, hsux_best, hspi_best, hst_best, hslam_best);
+
+	return 1;
+
+	}
+
+
+
+// basic working version
+
+/* primal-dual interior-point method computing residuals at each iteration, hard constraints, time variant matrices, time variant size (mpc version) */
+static int d_ip2_res_mpc_hard_ipm_libstr(int *kk, int k_max, double time_budget, double mu0, double mu_tol, double alpha_min, int warm_start, double *stat, int **idxb, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, struct d_ip2_res_mpc_hard_solver *ws)
+	{
+
+	// indeces
+	int jj;
+
+	// wall clock time budget
+	double t_start = 0.0;
+	double t_last = 0.0;
+	double t_iter_max = 0.0;
+	int deadline = 0;
+	double merit_best = -1.0; // no iterate stored yet
+	int best_is_last = 1;
+	if(time_budget>0.0)
+		{
+		t_start = d_ip2_res_mpc_hard_time_libstr();
+		t_last = t_start;
 		}
 
+
+	int N = ws->N;
+	int *nx = ws->nx;
+	int *nu = ws->nu;
+	int *nb = ws->nb;
+	int *ng = ws->ng;
+
+	struct blasfeo_dmat *hsL = ws->hsL;
+	struct blasfeo_dvec *hsb = ws->hsb;
+	struct blasfeo_dvec *hsrq = ws->hsrq;
+	struct blasfeo_dvec *hsQx = ws->hsQx;
+	struct blasfeo_dvec *hsqx = ws->hsqx;
+	struct blasfeo_dvec *hsdux = ws->hsdux;
+	struct blasfeo_dvec *hsdpi = ws->hsdpi;
+	struct blasfeo_dvec *hsdt = ws->hsdt;
+	struct blasfeo_dvec *hsdlam = ws->hsdlam;
+	struct blasfeo_dvec *hstinv = ws->hstinv;
+	struct blasfeo_dvec *hslamt = ws->hslamt;
+	struct blasfeo_dvec *hsPb = ws->hsPb;
+	struct blasfeo_dvec *hsres_rq = ws->hsres_rq;
+	struct blasfeo_dvec *hsres_b = ws->hsres_b;
+	struct blasfeo_dvec *hsres_d = ws->hsres_d;
+	struct blasfeo_dvec *hsres_m = ws->hsres_m;
+	struct blasfeo_dvec *hsux_bkp = ws->hsux_bkp;
+	struct blasfeo_dvec *hspi_bkp = ws->hspi_bkp;
+	struct blasfeo_dvec *hst_bkp = ws->hst_bkp;
+	struct blasfeo_dvec *hslam_bkp = ws->hslam_bkp;
+	struct blasfeo_dvec *hsux_best = ws->hsux_best;
+	struct blasfeo_dvec *hspi_best = ws->hspi_best;
+	struct blasfeo_dvec *hst_best = ws->hst_best;
+	struct blasfeo_dvec *hslam_best = ws->hslam_best;
+
+	void *d_back_ric_rec_work_space = ws->d_back_ric_rec_work_space;
+	void *d_res_res_mpc_hard_work_space = ws->d_res_res_mpc_hard_work_space;
+#if ITER_REF>0
+	int ric_fallback = 0;
+#endif
+#if defined(RIC_PAR_CHUNKS)
+	void *d_par_back_ric_rec_work_space = ws->d_par_back_ric_rec_work_space;
+#endif
+#if IPM_GONDZIO>0
+	struct blasfeo_dvec *hsdux_cor = ws->hsdux_cor;
+	struct blasfeo_dvec *hsdpi_cor = ws->hsdpi_cor;
+	struct blasfeo_dvec *hsdt_cor = ws->hsdt_cor;
+	struct blasfeo_dvec *hsdlam_cor = ws->hsdlam_cor;
+	int it_cor;
+	double alpha_trg, alpha_cor;
+#endif
+
+
+
 	// extract linear part of state space model and cost function	
 
 	// extract b
@@ -260,8 +1022,8 @@ int d_ip2_res_mpc_hard_libstr(int *kk, int k_max, double mu0, double mu_tol, dou
 
 
 
-	double temp0, temp1;
 	double alpha, mu, mu_aff;
+	double mu_poly[3];
 
 	// check if there are inequality constraints
 	double mu_scal = 0.0; 
@@ -272,7 +1034,7 @@ int d_ip2_res_mpc_hard_libstr(int *kk, int k_max, double mu0, double mu_tol, dou
 		}
 	else // call the riccati solver and return
 		{
-		d_back_ric_rec_sv_libstr(N, nx, nu, nb, idxb, ng, 0, hsBAbt, hsvecdummy, 0, hsRSQrq, hsvecdummy, hsmatdummy, hsvecdummy, hsvecdummy, hsux, compute_mult, hspi, 0, hsvecdummy, hsL, d_back_ric_rec_work_space);
+		d_back_ric_rec_sv_libstr(N, nx, nu, nb, idxb, ng, 0, hsBAbt, NULL, 0, hsRSQrq, NULL, NULL, NULL, NULL, hsux, compute_mult, hspi, 0, NULL, hsL, d_back_ric_rec_work_space);
 		// no IPM iterations
 		*kk = 0;
 		// return success
@@ -305,7 +1067,17 @@ exit(1);
 
 
 	// compute the duality gap
-	mu = mu0;
+	if(warm_start==2)
+		{
+		mu = 0.0;
+		for(jj=0; jj<=N; jj++)
+			mu += blasfeo_ddot(2*nb[jj]+2*ng[jj], &hst[jj], 0, &hslam[jj], 0);
+		mu *= mu_scal;
+		}
+	else
+		{
+		mu = mu0;
+		}
 
 	// set to zero iteration count
 	*kk = 0;	
@@ -324,10 +1096,14 @@ exit(1);
 //	double mu_tol_low = mu_tol;
 	double mu_tol_low = mu_tol<THR_ITER_REF ? THR_ITER_REF : mu_tol ;
 
+	// update cost function matrices and vectors (box constraints) for the first iteration;
+	// at the following ones this is fused with the update of the variables
+	d_update_hessian_gradient_mpc_hard_libstr(N, nx, nu, nb, ng, hsd, 0.0, hst, hstinv, hslam, hslamt, hsdlam, hsQx, hsqx);
+
 #if 0
 	if(0)
 #else
-	while( *kk<k_max && mu>mu_tol_low && alpha>=alpha_min )
+	while( *kk<k_max && mu>mu_tol_low && alpha>=alpha_min && deadline==0 )
 #endif
 		{
 
@@ -335,8 +1111,6 @@ exit(1);
 						
 
 
-		//update cost function matrices and vectors (box constraints)
-		d_update_hessian_gradient_mpc_hard_libstr(N, nx, nu, nb, ng, hsd, 0.0, hst, hstinv, hslam, hslamt, hsdlam, hsQx, hsqx);
 
 #if 0
 for(ii=0; ii<=N; ii++)
@@ -353,7 +1127,13 @@ exit(1);
 
 
 		// compute the search direction: factorize and solve the KKT system
-#if 1
+#if ITER_REF>0
+		d_back_ric_rec_sv_mixed_libstr(N, nx, nu, nb, idxb, ng, 1, &ric_fallback, hsBAbt, hsb, hsRSQrq, hsrq, hsDCt, hsQx, hsqx, hsdux, hsdpi, hsPb, hsL, ws);
+#elif defined(RIC_PAR_CHUNKS)
+		d_par_back_ric_rec_sv_libstr(N, nx, nu, nb, idxb, ng, hsBAbt, hsb, hsRSQrq, hsrq, hsDCt, hsQx, hsqx, hsdux, compute_mult, hsdpi, hsPb, hsL, RIC_PAR_CHUNKS, d_par_back_ric_rec_work_space);
+#elif defined(RIC_CODEGEN)
+		d_back_ric_rec_sv_codegen_libstr(N, nx, nu, nb, idxb, ng, 0, hsBAbt, hsb, 1, hsRSQrq, hsrq, hsDCt, hsQx, hsqx, hsdux, compute_mult, hsdpi, 1, hsPb, hsL, d_back_ric_rec_work_space);
+#elif 1
 		d_back_ric_rec_sv_libstr(N, nx, nu, nb, idxb, ng, 0, hsBAbt, hsb, 1, hsRSQrq, hsrq, hsDCt, hsQx, hsqx, hsdux, compute_mult, hsdpi, 1, hsPb, hsL, d_back_ric_rec_work_space);
 #else
 		d_back_ric_rec_trf_tv_res(N, nx, nu, pBAbt, pQ, pL, dL, work, nb, idxb, ng, pDCt, Qx, bd);
@@ -381,9 +1161,9 @@ exit(1);
 
 #if CORRECTOR_LOW==1 // IPM1
 
-		// compute t_aff & dlam_aff & dt_aff & alpha
+		// compute t_aff & dlam_aff & dt_aff & alpha, and the affine duality gap as a polynomial in alpha
 		alpha = 1.0;
-		d_compute_alpha_mpc_hard_libstr(N, nx, nu, nb, idxb, ng, &alpha, hst, hsdt, hslam, hsdlam, hslamt, hsdux, hsDCt, hsd);
+		d_compute_alpha_mu_mpc_hard_libstr(N, nx, nu, nb, idxb, ng, &alpha, mu_poly, hst, hsdt, hslam, hsdlam, hslamt, hsdux, hsDCt, hsd);
 
 		
 
@@ -399,7 +1179,7 @@ exit(1);
 
 
 		// compute the affine duality gap
-		d_compute_mu_mpc_hard_libstr(N, nx, nu, nb, ng, &mu_aff, mu_scal, alpha, hslam, hsdlam, hst, hsdt);
+		mu_aff = mu_scal * ( mu_poly[0] + alpha * ( mu_poly[1] + alpha * mu_poly[2] ) );
 
 		stat[5*(*kk)+2] = mu_aff;
 
@@ -439,7 +1219,13 @@ exit(1);
 
 
 		// solve the system
+#if ITER_REF>0
+		d_back_ric_rec_sv_mixed_libstr(N, nx, nu, nb, idxb, ng, 0, &ric_fallback, hsBAbt, hsb, hsRSQrq, hsrq, hsDCt, hsQx, hsqx, hsdux, hsdpi, hsPb, hsL, ws);
+#elif defined(RIC_PAR_CHUNKS)
+		d_par_back_ric_rec_trs_libstr(N, nx, nu, nb, idxb, ng, hsBAbt, hsb, hsrq, hsDCt, hsqx, hsdux, compute_mult, hsdpi, 0, hsPb, hsL, RIC_PAR_CHUNKS, d_par_back_ric_rec_work_space);
+#else
 		d_back_ric_rec_trs_libstr(N, nx, nu, nb, idxb, ng, hsBAbt, hsb, hsrq, hsDCt, hsqx, hsdux, compute_mult, hsdpi, 0, hsPb, hsL, d_back_ric_rec_work_space);
+#endif
 
 #if 0
 printf("\ndux\n");
@@ -469,6 +1255,45 @@ for(ii=0; ii<=N; ii++)
 exit(2);
 #endif
 
+#if IPM_GONDZIO>0
+		// Gondzio multiple centrality correctors: solve again with the same factorization,
+		// pushing the complementarity products at a longer step into [beta_min, beta_max]*sigma*mu
+		for(it_cor=0; it_cor<IPM_GONDZIO && alpha<1.0; it_cor++)
+			{
+
+			alpha_trg = alpha+GONDZIO_DELTA<1.0 ? alpha+GONDZIO_DELTA : 1.0;
+
+			// backup search direction
+			d_ip2_res_mpc_hard_copy_dir_libstr(N, nx, nu, nb, ng, hsdux, hsdpi, hsdt, hsdlam, hsdux_cor, hsdpi_cor, hsdt_cor, hsdlam_cor);
+
+			// update dlam & gradient
+			d_compute_gondzio_correction_mpc_hard_libstr(N, nb, ng, alpha_trg, GONDZIO_BETA_MIN*sigma*mu, GONDZIO_BETA_MAX*sigma*mu, hst, hsdt, hslam, hsdlam, hslamt, hstinv, hsqx);
+
+			// solve the KKT system
+#if ITER_REF>0
+			d_back_ric_rec_sv_mixed_libstr(N, nx, nu, nb, idxb, ng, 0, &ric_fallback, hsBAbt, hsb, hsRSQrq, hsrq, hsDCt, hsQx, hsqx, hsdux, hsdpi, hsPb, hsL, ws);
+#elif defined(RIC_PAR_CHUNKS)
+			d_par_back_ric_rec_trs_libstr(N, nx, nu, nb, idxb, ng, hsBAbt, hsb, hsrq, hsDCt, hsqx, hsdux, compute_mult, hsdpi, 0, hsPb, hsL, RIC_PAR_CHUNKS, d_par_back_ric_rec_work_space);
+#else
+			d_back_ric_rec_trs_libstr(N, nx, nu, nb, idxb, ng, hsBAbt, hsb, hsrq, hsDCt, hsqx, hsdux, compute_mult, hsdpi, 0, hsPb, hsL, d_back_ric_rec_work_space);
+#endif
+
+			// compute t & dlam & dt & alpha
+			alpha_cor = 1.0;
+			d_compute_alpha_mpc_hard_libstr(N, nx, nu, nb, idxb, ng, &alpha_cor, hst, hsdt, hslam, hsdlam, hslamt, hsdux, hsDCt, hsd);
+
+			// not enough step increase: restore search direction
+			if(alpha_cor<alpha+GONDZIO_GAMMA*GONDZIO_DELTA)
+				{
+				d_ip2_res_mpc_hard_copy_dir_libstr(N, nx, nu, nb, ng, hsdux_cor, hsdpi_cor, hsdt_cor, hsdlam_cor, hsdux, hsdpi, hsdt, hsdlam);
+				break;
+				}
+
+			alpha = alpha_cor;
+
+			}
+#endif
+
 		stat[5*(*kk)] = sigma;
 		stat[5*(*kk)+3] = alpha;
 			
@@ -493,8 +1318,9 @@ exit(1);
 #endif
 
 
-		// compute step dux, dpi & update ux, pi, lam, t & compute the duality gap mu
-		d_backup_update_var_mpc_hard_libstr(N, nx, nu, nb, ng, &mu, mu_scal, alpha, hsux_bkp, hsux, hsdux, hspi_bkp, hspi, hsdpi, hst_bkp, hst, hsdt, hslam_bkp, hslam, hsdlam);
+		// compute step dux, dpi & update ux, pi, lam, t & compute the duality gap mu,
+		// and update cost function matrices and vectors (box constraints) for the next iteration
+		d_backup_update_var_hessian_gradient_mpc_hard_libstr(N, nx, nu, nb, ng, &mu, mu_scal, alpha, hsux_bkp, hsux, hsdux, hspi_bkp, hspi, hsdpi, hst_bkp, hst, hsdt, hslam_bkp, hslam, hsdlam, hsd, 0.0, hstinv, hslamt, hsQx, hsqx);
 
 
 
@@ -519,9 +1345,16 @@ for(ii=0; ii<=N; ii++)
 #endif
 
 
+		// real-time mode: keep the iterate with the smallest duality gap (the residuals are not computed here)
+		if(time_budget>0.0)
+			best_is_last = d_ip2_res_mpc_hard_keep_best_libstr(N, nx, nu, nb, ng, mu, &merit_best, hsux, hspi, hst, hslam, hsux_best, hspi_best, hst_best, hslam_best);
+
 		// increment loop index
 		(*kk)++;
 
+		// check if one more iteration fits in the time budget
+		deadline = d_ip2_res_mpc_hard_check_deadline_libstr(time_budget, t_start, &t_last, &t_iter_max);
+
 
 		} // end of IP loop
 	
@@ -551,6 +1384,13 @@ for(ii=0; ii<=N; ii++)
 	// compute residuals
 	d_res_res_mpc_hard_libstr(N, nx, nu, nb, idxb, ng, hsBAbt, hsb, hsRSQrq, hsrq, hsux, hsDCt, hsd, hspi, hslam, hst, hsres_rq, hsres_b, hsres_d, hsres_m, &mu, d_res_res_mpc_hard_work_space);
 
+	// real-time mode: from now on the iterates are ranked by their residuals
+	if(time_budget>0.0 && deadline==0)
+		{
+		merit_best = -1.0;
+		best_is_last = d_ip2_res_mpc_hard_keep_best_libstr(N, nx, nu, nb, ng, d_ip2_res_mpc_hard_res_nrm_libstr(N, nx, nu, nb, ng, hsres_rq, hsres_b, hsres_d, mu), &merit_best, hsux, hspi, hst, hslam, hsux_best, hspi_best, hst_best, hslam_best);
+		}
+
 #if 0
 	printf("kk = %d\n", *kk);
 	printf("\nres_q\n");
@@ -579,7 +1419,7 @@ for(ii=0; ii<=N; ii++)
 	int ipm_it;
 	for(ipm_it=0; ipm_it<3; ipm_it++)
 #else
-	while( *kk<k_max && mu>mu_tol && alpha>=alpha_min ) // XXX exit conditions on residuals???
+	while( *kk<k_max && mu>mu_tol && alpha>=alpha_min && deadline==0 ) // XXX exit conditions on residuals???
 #endif
 		{
 
@@ -593,142 +1433,22 @@ printf("\nIPM it %d\n", *kk);
 
 
 		// compute the update of Hessian and gradient from box and general constraints
-		d_update_hessian_gradient_res_mpc_hard_libstr(N, nx, nu, nb, ng, hsres_d, hsres_m, hst, hslam, hstinv, hsQx, hsqx);
-
-#if 0
-for(ii=0; ii<=N; ii++)
-	blasfeo_print_tran_dvec(nb[ii]+ng[ii], &hsQx[ii], 0);
-for(ii=0; ii<=N; ii++)
-	blasfeo_print_tran_dvec(nb[ii]+ng[ii], &hsqx[ii], 0);
-//if(*kk==1)
-exit(1);
-#endif
-
-
-
-		// compute the search direction: factorize and solve the KKT system
-#if ITER_REF>0
-// TODO !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-		// update Hessian and gradient
-		for(ii=0; ii<=N; ii++)
-			{
-
-			// box constraints
-			// gradient
-			for(jj=0; jj<nu[ii]+nx[ii]; jj++)
-				q2[ii][jj] = res_q[ii][jj];
-			dvecad_libsp(nb[ii], idxb[ii], 1.0, qx[ii], q2[ii]);
-//			d_print_mat_e(1, nu[ii]+nx[ii], q2[ii], 1);
-			// hessian
-			for(jj=0; jj<pnz[ii]*cnux[ii]; jj++)
-				pQ2[ii][jj] = pQ[ii][jj];
-			ddiaad_libsp(nb[ii], idxb[ii], 1.0, Qx[ii], pQ2[ii], cnux[ii]);
-#ifdef BLASFEO
-			drowin_lib(cnux[ii], 1.0, q2[ii], pQ2[ii]+(nu[ii]+nx[ii])/bs*bs*cnux[ii]+(nu[ii]+nx[ii])%bs);
-#else
-			drowin_lib(cnux[ii], q2[ii], pQ2[ii]+(nu[ii]+nx[ii])/bs*bs*cnux[ii]+(nu[ii]+nx[ii])%bs);
-#endif
-//			drowin_lib(cnux[ii], res_q[ii], pQ2[ii]+(nu[ii]+nx[ii])/bs*bs*cnux[ii]+(nu[ii]+nx[ii])%bs);
-//			drowad_libsp(nb[ii], idxb[ii], 1.0, qx[ii], pQ2[ii]+(nu[ii]+nx[ii])/bs*bs*cnux[ii]+(nu[ii]+nx[ii])%bs);
-//			d_print_pmat_e(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], bs, pQ2[ii], cnux[ii]);
-
-			// general constraints
-			if(ng[ii]>0) // TODO unsymmetric update not requiring sqrt & div ???
-				{
-				work2 = work + pnz[ii]*cng[ii];
-//				for(jj=0; jj<ng[ii]; jj++) 
-//					Qx[ii][pnb[ii]+jj] = sqrt(Qx[ii][pnb[ii]+jj]); // XXX
-				dgemm_diag_right_lib(nu[ii]+nx[ii], ng[ii], pDCt[ii], cng[ii], Qx[ii]+pnb[ii], 0, work, cng[ii], work, cng[ii]);
-#ifdef BLASFEO
-				drowin_lib(ng[ii], 1.0, qx[ii]+pnb[ii], work+(nu[ii]+nx[ii])/bs*cng[ii]*bs+(nu[ii]+nx[ii])%bs);
-#else
-				drowin_lib(ng[ii], qx[ii]+pnb[ii], work+(nu[ii]+nx[ii])/bs*cng[ii]*bs+(nu[ii]+nx[ii])%bs);
-#endif
-//				for(jj=0; jj<ng[ii]; jj++) 
-//					work[(nu[ii]+nx[ii])/bs*cng[ii]*bs+(nu[ii]+nx[ii])%bs+jj*bs] /= Qx[ii][pnb[ii]+jj];
-#ifdef BLASFEO
-				dgecp_lib(nu[ii]+nx[ii], 1.0, ng[ii], 0, pDCt[ii], cng[ii], 0, work2, png[ii]);
-				dsyrk_nt_l_lib(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], ng[ii], 1.0, work, cng[ii], work2, cng[ii], 1.0, pQ2[ii], cnux[ii], pQ2[ii], cnux[ii]);
-				drowex_lib(cnux[ii], 1.0, pQ2[ii]+(nu[ii]+nx[ii])/bs*bs*cnux[ii]+(nu[ii]+nx[ii])%bs, q2[ii]);
-#else
-				dgecp_lib(nu[ii]+nx[ii], ng[ii], 0, pDCt[ii], cng[ii], 0, work2, png[ii]);
-				dsyrk_nt_lib(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], ng[ii], work, cng[ii], work2, cng[ii], 1, pQ2[ii], cnux[ii], pQ2[ii], cnux[ii]);
-				drowex_lib(cnux[ii], pQ2[ii]+(nu[ii]+nx[ii])/bs*bs*cnux[ii]+(nu[ii]+nx[ii])%bs, q2[ii]);
-#endif
-				}
-
-//			d_print_pmat_e(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], bs, pQ2[ii], cnux[ii]);
-
-//			// regularization
-//			ddiareg_lib(nu[ii]+nx[ii], ITER_REF_REG, 0, pQ2[ii], cnux[ii]);
-
-			}
-//		exit(2);
-
-		// factorize & solve KKT system
-		d_back_ric_rec_sv_libstr(N, nx, nu, nb2, idxb, ng2, 1, hsBAbt, hsres_b, 0, hsRSQrq2, hsres_q, hsmatdummy, hsvecdummy, hsvecdummy, hsdux, compute_mult, hsdpi, 1, hsPb, hsL, d_back_ric_rec_work_space);
-
-#if CORRECTOR_HIGH==1
-		if(0)
-#else
-		for(it_ref=0; it_ref<ITER_REF; it_ref++)
-#endif
-			{
-
-//			// remove regularization
-//			for(ii=0; ii<=N; ii++)
-//				ddiareg_lib(nu[ii]+nx[ii], -ITER_REF_REG, 0, pQ2[ii], cnux[ii]);
-
-			// compute residuals
-			d_res_res_mpc_hard_libstr(N, nx, nu, nb2, idxb, ng2, hsBAbt, hsres_b, hsRSQrq2, hsrq2, hsdux, hsmatdummy, hsvecdummy, hsdpi, hsvecdummy, hsvecdummy, hsres_q2, hsres_b2, hsvecdummy, hsvecdummy, pdummy, d_res_res_mpc_hard_work_space);
-
-#if 0
-			printf("\niterative refinemet %d\n", it_ref);
-			printf("\nres_q2\n");
-			for(ii=0; ii<=N; ii++)
-				d_print_mat_e(1, nu[ii]+nx[ii], res_q2[ii], 1);
-			printf("\nres_b2\n");
-			for(ii=1; ii<=N; ii++)
-				d_print_mat_e(1, nx[ii], res_b2[ii], 1);
-//			exit(2);
-#endif
-
-			// solve for residuals
-//			d_back_ric_rec_trs_tv_res(N, nx, nu, nb2, idxb, ng2, pBAbt, res_b2, res_q2, ppdummy, ppdummy, dux2, compute_mult, dpi2, 1, Pb2, memory, work);
-			d_back_ric_rec_trs_libstr(N, nx, nu, nb2, idxb, ng2, hsBAbt, hsres_b2, hsres_q2, hsmatdummy, hsvecdummy, hsdux2, compute_mult, hsdpi, 1, hsPb, hsL, d_back_ric_rec_work_space);
-
-	//		printf("\nux2\n");
-	//		for(ii=0; ii<=N; ii++)
-	//			d_print_mat_e(1, nu[ii]+nx[ii], dux2[ii], 1);
-	//		printf("\npi2\n");
-	//		for(ii=0; ii<N; ii++)
-	//			d_print_mat_e(1, nx[ii+1], dpi2[ii], 1);
-	//		exit(2);
-
-			// update solution
-			for(ii=0; ii<=N; ii++)
-				for(jj=0; jj<nu[ii]+nx[ii]; jj++)
-					dux[ii][jj] += dux2[ii][jj];
-			for(ii=1; ii<=N; ii++)
-				for(jj=0; jj<nx[ii]; jj++)
-					dpi[ii][jj] += dpi2[ii][jj];
-
-			}
+		d_update_hessian_gradient_res_mpc_hard_libstr(N, nx, nu, nb, ng, hsres_d, hsres_m, hst, hslam, hstinv, hsQx, hsqx);
 
 #if 0
-		// compute residuals again
-		d_res_res_mpc_hard_libstr(N, nx, nu, nb2, idxb, ng2, hsBAbt, hsres_b, hsRSQrq2, hsrq2, hsdux, hsmatdummy, hsvecdummy, hsdpi, hsvecdummy, hsvecdummy, hsres_q2, hsres_b2, hsvecdummy, hsvecdummy, pdummy, d_res_res_mpc_hard_work_space);
-
-		printf("\nres_q2\n");
-		for(ii=0; ii<=N; ii++)
-			d_print_mat_e(1, nu[ii]+nx[ii], res_q2[ii], 1);
-		printf("\nres_b2\n");
-		for(ii=0; ii<N; ii++)
-			d_print_mat_e(1, nx[ii+1], res_b2[ii], 1);
-//		exit(2);
+for(ii=0; ii<=N; ii++)
+	blasfeo_print_tran_dvec(nb[ii]+ng[ii], &hsQx[ii], 0);
+for(ii=0; ii<=N; ii++)
+	blasfeo_print_tran_dvec(nb[ii]+ng[ii], &hsqx[ii], 0);
+//if(*kk==1)
+exit(1);
 #endif
 
 
+
+		// compute the search direction: factorize and solve the KKT system
+#if ITER_REF>0
+		d_back_ric_rec_sv_mixed_libstr(N, nx, nu, nb, idxb, ng, 1, &ric_fallback, hsBAbt, hsres_b, hsRSQrq, hsres_rq, hsDCt, hsQx, hsqx, hsdux, hsdpi, hsPb, hsL, ws);
 #else // no iterative refinement
 #if 0
 for(ii=0; ii<=N; ii++)
@@ -745,7 +1465,11 @@ for(ii=0; ii<N; ii++)
 	d_print_strmat(nu[ii]+nx[ii], nx[ii+1], &hsBAbt[ii+1], 0, 0);
 exit(1);
 #endif
-#if 1
+#if defined(RIC_PAR_CHUNKS)
+		d_par_back_ric_rec_sv_libstr(N, nx, nu, nb, idxb, ng, hsBAbt, hsres_b, hsRSQrq, hsres_rq, hsDCt, hsQx, hsqx, hsdux, compute_mult, hsdpi, hsPb, hsL, RIC_PAR_CHUNKS, d_par_back_ric_rec_work_space);
+#elif defined(RIC_CODEGEN)
+		d_back_ric_rec_sv_codegen_libstr(N, nx, nu, nb, idxb, ng, 1, hsBAbt, hsres_b, 1, hsRSQrq, hsres_rq, hsDCt, hsQx, hsqx, hsdux, compute_mult, hsdpi, 1, hsPb, hsL, d_back_ric_rec_work_space);
+#elif 1
 		d_back_ric_rec_sv_libstr(N, nx, nu, nb, idxb, ng, 1, hsBAbt, hsres_b, 1, hsRSQrq, hsres_rq, hsDCt, hsQx, hsqx, hsdux, compute_mult, hsdpi, 1, hsPb, hsL, d_back_ric_rec_work_space);
 #else
 		d_back_ric_rec_trf_tv_res(N, nx, nu, pBAbt, pQ, pL, dL, work, nb, idxb, ng, pDCt, Qx, bd);
@@ -897,100 +1621,17 @@ exit(1);
 
 #if ITER_REF>0
 
-// TODO !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-		// update gradient
-		for(ii=0; ii<=N; ii++)
-			{
-			// copy gradient
-			for(jj=0; jj<nu[ii]+nx[ii]; jj++)
-				q2[ii][jj] = res_q[ii][jj];
-			// box constraints
-			if(nb[ii]>0)
-				dvecad_libsp(nb[ii], idxb[ii], 1.0, qx[ii], q2[ii]);
-			// general constraints
-			if(ng[ii]>0)
-				blasfeo_dgemv_n(nu[ii]+nx[ii], ng[ii], 1.0, &hsDCt[ii], 0, 0, &hsqx[ii], nb[ii], 1.0, &hsrq2[ii], 0, &hsrq2[ii], 0);
-			}
-
 		// solve the KKT system
-//		d_back_ric_rec_trs_libstr(N, nx, nu, nb2, idxb, ng2, hsBAbt, hsres_b, hsq2, hsvecdummy, hsvecdummy, hsdux, compute_mult, hsdpi, 0, hsPb, memory, work);
-		d_back_ric_rec_trs_libstr(N, nx, nu, nb2, idxb, ng2, hsBAbt, hsres_b, hsrq2, hsmatdummy, hsvecdummy, hsdux, compute_mult, hsdpi, 0, hsPb, hsL, d_back_ric_rec_work_space);
-
-#if 0
-printf("\ndux\n");
-for(ii=0; ii<=N; ii++)
-	d_print_mat(1, nu[ii]+nx[ii], dux[ii], 1);
-//if(*kk==1)
-exit(1);
-#endif
-
-
-
-#if 0
-		if(0)
-#else
-		for(it_ref=0; it_ref<ITER_REF; it_ref++)
-#endif
-			{
-
-//			// remove regularization
-//			for(ii=0; ii<=N; ii++)
-//				ddiareg_lib(nu[ii]+nx[ii], -ITER_REF_REG, 0, pQ2[ii], cnux[ii]);
-
-			// compute residuals
-			d_res_res_mpc_hard_libstr(N, nx, nu, nb2, idxb, ng2, hsBAbt, hsres_b, hsRSQrq2, hsrq2, hsdux, hsmatdummy, hsvecdummy, hsdpi, hsvecdummy, hsvecdummy, hsres_q2, hsres_b2, hsvecdummy, hsvecdummy, pdummy, d_res_res_mpc_hard_work_space);
-
-#if 0
-			printf("\niterative refinemet %d\n", it_ref);
-			printf("\nres_q2\n");
-			for(ii=0; ii<=N; ii++)
-				d_print_mat_e(1, nu[ii]+nx[ii], res_q2[ii], 1);
-			printf("\nres_b2\n");
-			for(ii=0; ii<N; ii++)
-				d_print_mat_e(1, nx[ii+1], res_b2[ii], 1);
-//			exit(2);
-#endif
-
-			// solve for residuals
-//			d_back_ric_rec_trs_tv_res(N, nx, nu, nb2, idxb, ng2, pBAbt, res_b2, res_q2, ppdummy, ppdummy, dux2, compute_mult, dpi2, 1, Pb2, memory, work);
-			d_back_ric_rec_trs_libstr(N, nx, nu, nb2, idxb, ng2, hsBAbt, hsres_b, hsrq2, hsmatdummy, hsvecdummy, hsdux2, compute_mult, hsdpi2, 0, hsPb2, hsL, d_back_ric_rec_work_space);
-
-	//		printf("\nux2\n");
-	//		for(ii=0; ii<=N; ii++)
-	//			d_print_mat_e(1, nu[ii]+nx[ii], dux2[ii], 1);
-	//		printf("\npi2\n");
-	//		for(ii=0; ii<N; ii++)
-	//			d_print_mat_e(1, nx[ii+1], dpi2[ii], 1);
-	//		exit(2);
-
-			// update solution
-			for(ii=0; ii<=N; ii++)
-				for(jj=0; jj<nu[ii]+nx[ii]; jj++)
-					dux[ii][jj] += dux2[ii][jj];
-			for(ii=1; ii<=N; ii++)
-				for(jj=0; jj<nx[ii]; jj++)
-					dpi[ii][jj] += dpi2[ii][jj];
-
-			}
-
-#if 0
-		// compute residuals again
-		d_res_res_mpc_hard_tv(N, nx, nu, nb2, idxb, ng2, pBAbt, res_b, pQ2, q2, dux, ppdummy, ppdummy, dpi, ppdummy, ppdummy, res_work, res_q2, res_b2, ppdummy, ppdummy, pdummy);
-
-		printf("\nres_q2\n");
-		for(ii=0; ii<=N; ii++)
-			d_print_mat_e(1, nu[ii]+nx[ii], res_q2[ii], 1);
-		printf("\nres_b2\n");
-		for(ii=0; ii<N; ii++)
-			d_print_mat_e(1, nx[ii+1], res_b2[ii], 1);
-//		exit(2);
-#endif
-
+		d_back_ric_rec_sv_mixed_libstr(N, nx, nu, nb, idxb, ng, 0, &ric_fallback, hsBAbt, hsres_b, hsRSQrq, hsres_rq, hsDCt, hsQx, hsqx, hsdux, hsdpi, hsPb, hsL, ws);
 
 #else // no iter ref
 
 		// solve the KKT system
+#if defined(RIC_PAR_CHUNKS)
+		d_par_back_ric_rec_trs_libstr(N, nx, nu, nb, idxb, ng, hsBAbt, hsres_b, hsres_rq, hsDCt, hsqx, hsdux, compute_mult, hsdpi, 0, hsPb, hsL, RIC_PAR_CHUNKS, d_par_back_ric_rec_work_space);
+#else
 		d_back_ric_rec_trs_libstr(N, nx, nu, nb, idxb, ng, hsBAbt, hsres_b, hsres_rq, hsDCt, hsqx, hsdux, compute_mult, hsdpi, 0, hsPb, hsL, d_back_ric_rec_work_space);
+#endif
 
 
 #endif // iter ref
@@ -1021,6 +1662,48 @@ for(ii=0; ii<=N; ii++)
 exit(2);
 #endif
 
+#if IPM_GONDZIO>0
+		// Gondzio multiple centrality correctors: solve again with the same factorization,
+		// pushing the complementarity products at a longer step into [beta_min, beta_max]*sigma*mu
+		for(it_cor=0; it_cor<IPM_GONDZIO && alpha<1.0; it_cor++)
+			{
+
+			alpha_trg = alpha+GONDZIO_DELTA<1.0 ? alpha+GONDZIO_DELTA : 1.0;
+
+			// backup search direction
+			d_ip2_res_mpc_hard_copy_dir_libstr(N, nx, nu, nb, ng, hsdux, hsdpi, hsdt, hsdlam, hsdux_cor, hsdpi_cor, hsdt_cor, hsdlam_cor);
+
+			// update res_m
+			d_compute_gondzio_correction_res_mpc_hard_libstr(N, nb, ng, alpha_trg, GONDZIO_BETA_MIN*sigma*mu, GONDZIO_BETA_MAX*sigma*mu, hst, hsdt, hslam, hsdlam, hsres_m);
+
+			// update gradient
+			d_update_gradient_res_mpc_hard_libstr(N, nx, nu, nb, ng, hsres_d, hsres_m, hslam, hstinv, hsqx);
+
+			// solve the KKT system
+#if ITER_REF>0
+			d_back_ric_rec_sv_mixed_libstr(N, nx, nu, nb, idxb, ng, 0, &ric_fallback, hsBAbt, hsres_b, hsRSQrq, hsres_rq, hsDCt, hsQx, hsqx, hsdux, hsdpi, hsPb, hsL, ws);
+#elif defined(RIC_PAR_CHUNKS)
+			d_par_back_ric_rec_trs_libstr(N, nx, nu, nb, idxb, ng, hsBAbt, hsres_b, hsres_rq, hsDCt, hsqx, hsdux, compute_mult, hsdpi, 0, hsPb, hsL, RIC_PAR_CHUNKS, d_par_back_ric_rec_work_space);
+#else
+			d_back_ric_rec_trs_libstr(N, nx, nu, nb, idxb, ng, hsBAbt, hsres_b, hsres_rq, hsDCt, hsqx, hsdux, compute_mult, hsdpi, 0, hsPb, hsL, d_back_ric_rec_work_space);
+#endif
+
+			// compute t & dlam & dt & alpha
+			alpha_cor = 1.0;
+			d_compute_alpha_res_mpc_hard_libstr(N, nx, nu, nb, idxb, ng, hsdux, hst, hstinv, hslam, hsDCt, hsres_d, hsres_m, hsdt, hsdlam, &alpha_cor);
+
+			// not enough step increase: restore search direction
+			if(alpha_cor<alpha+GONDZIO_GAMMA*GONDZIO_DELTA)
+				{
+				d_ip2_res_mpc_hard_copy_dir_libstr(N, nx, nu, nb, ng, hsdux_cor, hsdpi_cor, hsdt_cor, hsdlam_cor, hsdux, hsdpi, hsdt, hsdlam);
+				break;
+				}
+
+			alpha = alpha_cor;
+
+			}
+#endif
+
 		stat[5*(*kk)] = sigma;
 		stat[5*(*kk)+3] = alpha;
 			
@@ -1082,9 +1765,16 @@ for(ii=0; ii<=N; ii++)
 
 
 
+		// real-time mode: keep the iterate with the smallest residuals
+		if(time_budget>0.0)
+			best_is_last = d_ip2_res_mpc_hard_keep_best_libstr(N, nx, nu, nb, ng, d_ip2_res_mpc_hard_res_nrm_libstr(N, nx, nu, nb, ng, hsres_rq, hsres_b, hsres_d, mu), &merit_best, hsux, hspi, hst, hslam, hsux_best, hspi_best, hst_best, hslam_best);
+
 		// increment loop index
 		(*kk)++;
 
+		// check if one more iteration fits in the time budget
+		deadline = d_ip2_res_mpc_hard_check_deadline_libstr(time_budget, t_start, &t_last, &t_iter_max);
+
 
 		} // end of IP loop
 	
@@ -1128,6 +1818,14 @@ exit(2);
 	if(mu<=mu_tol)
 		return 0;
 	
+	// time budget exhausted: return the best iterate
+	if(deadline)
+		{
+		if(!best_is_last)
+			d_ip2_res_mpc_hard_copy_dir_libstr(N, nx, nu, nb, ng, hsux_best, hspi_best, hst_best, hslam_best, hsux, hspi, hst, hslam);
+		return 3;
+		}
+
 	// max number of iterations reached
 	if(*kk>=k_max)
 		return 1;
@@ -1143,164 +1841,77 @@ exit(2);
 
 
 
-void d_kkt_solve_new_rhs_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, void *work)
+// real-time mode, with a wall clock time budget in seconds
+int d_ip2_res_mpc_hard_deadline_libstr(int *kk, int k_max, double time_budget, double mu0, double mu_tol, double alpha_min, int warm_start, double *stat, int N, int *nx, int *nu, int *nb, int **idxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, void *work)
 	{
-	
-	// indeces
-	int jj, ll, ii, bs0;
 
-	// matrices size
-	int idx;
-
-
-
-	struct blasfeo_dmat *hsmatdummy;
-	struct blasfeo_dvec *hsvecdummy;
+	struct d_ip2_res_mpc_hard_solver ws;
 
 	// TODO do not use variable size arrays !!!!!
-	struct blasfeo_dvec hsb_old[N];
-	struct blasfeo_dvec hsrq_old[N+1];
-	struct blasfeo_dvec hsQx[N+1];
-	struct blasfeo_dvec hsqx[N+1];
-	struct blasfeo_dvec hsdux[N+1];
-	struct blasfeo_dvec hsdpi[N+1];
-	struct blasfeo_dvec hsdt[N+1];
-	struct blasfeo_dvec hsdlam[N+1];
-	struct blasfeo_dvec hstinv[N+1];
-	struct blasfeo_dvec hslamt[N+1];
-	struct blasfeo_dvec hsPb[N+1];
-	struct blasfeo_dmat hsL[N+1];
-	struct blasfeo_dvec hsres_rq[N+1];
-	struct blasfeo_dvec hsres_b[N];
-	struct blasfeo_dvec hsres_d[N+1];
-	struct blasfeo_dvec hsres_m[N+1];
-	struct blasfeo_dmat hsric_work_mat[2];
-	struct blasfeo_dvec hsric_work_vec[1];
-	struct blasfeo_dvec hsux_bkp[N+1];
-	struct blasfeo_dvec hspi_bkp[N+1];
-	struct blasfeo_dvec hst_bkp[N+1];
-	struct blasfeo_dvec hslam_bkp[N+1];
-
-	void *d_back_ric_rec_work_space;
-	void *d_res_res_mpc_hard_work_space;
-
-	char *c_ptr = work;
-
-	// riccati work space
-	d_back_ric_rec_work_space = (void *) c_ptr;
-	c_ptr += d_back_ric_rec_work_space_size_bytes_libstr(N, nx, nu, nb, ng);
-
-	// residuals work space
-	d_res_res_mpc_hard_work_space = (void *) c_ptr;
-	c_ptr += d_res_res_mpc_hard_work_space_size_bytes_libstr(N, nx, nu, nb, ng);
-
-	// L
-	for(ii=0; ii<=N; ii++)
-		{
-		blasfeo_create_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], &hsL[ii], (void *) c_ptr);
-		c_ptr += hsL[ii].memsize;
-		}
-
-	// b as vector
-	for(ii=0; ii<N; ii++)
-		{
-		blasfeo_create_dvec(nx[ii+1], &hsb_old[ii], (void *) c_ptr);
-		c_ptr += hsb_old[ii].memsize;
-		}
+	double ptr_memory[(d_ip2_res_mpc_hard_ptr_memsize_libstr(N)+7)/8];
 
-	// inputs and states step
-	for(ii=0; ii<=N; ii++)
-		{
-		blasfeo_create_dvec(nu[ii]+nx[ii], &hsdux[ii], (void *) c_ptr);
-		c_ptr += hsdux[ii].memsize;
-		}
+	ws.N = N;
+	ws.nx = nx;
+	ws.nu = nu;
+	ws.nb = nb;
+	ws.ng = ng;
+	d_ip2_res_mpc_hard_create_ptr_libstr(N, &ws, (void *) ptr_memory);
+	d_ip2_res_mpc_hard_create_work_space_libstr(&ws, work);
 
-	// equality constr multipliers step
-	for(ii=0; ii<=N; ii++)
-		{
-		blasfeo_create_dvec(nx[ii], &hsdpi[ii], (void *) c_ptr);
-		c_ptr += hsdpi[ii].memsize;
-		}
+	return d_ip2_res_mpc_hard_ipm_libstr(kk, k_max, time_budget, mu0, mu_tol, alpha_min, warm_start, stat, idxb, hsBAbt, hsRSQrq, hsDCt, hsd, hsux, compute_mult, hspi, hslam, hst, &ws);
 
-	// backup of P*b
-	for(ii=0; ii<=N; ii++)
-		{
-		blasfeo_create_dvec(nx[ii], &hsPb[ii], (void *) c_ptr);
-		c_ptr += hsPb[ii].memsize;
-		}
+	}
 
-	// linear part of cost function
-	for(ii=0; ii<=N; ii++)
-		{
-		blasfeo_create_dvec(nu[ii]+nx[ii], &hsrq_old[ii], (void *) c_ptr);
-		c_ptr += hsrq_old[ii].memsize;
-		}
 
-	// slack variables, Lagrangian multipliers for inequality constraints and work space
-	for(ii=0; ii<=N; ii++)
-		{
-		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &hsdlam[ii], (void *) c_ptr);
-		c_ptr += hsdlam[ii].memsize;
-		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &hsdt[ii], (void *) c_ptr);
-		c_ptr += hsdt[ii].memsize;
-		}
 
-	for(ii=0; ii<=N; ii++)
-		{
-		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &hstinv[ii], (void *) c_ptr);
-		c_ptr += hstinv[ii].memsize;
-		}
+int d_ip2_res_mpc_hard_libstr(int *kk, int k_max, double mu0, double mu_tol, double alpha_min, int warm_start, double *stat, int N, int *nx, int *nu, int *nb, int **idxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, void *work)
+	{
 
-	for(ii=0; ii<=N; ii++)
-		{
-		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &hslamt[ii], (void *) c_ptr);
-		c_ptr += hslamt[ii].memsize;
-		}
+	return d_ip2_res_mpc_hard_deadline_libstr(kk, k_max, 0.0, mu0, mu_tol, alpha_min, warm_start, stat, N, nx, nu, nb, idxb, ng, hsBAbt, hsRSQrq, hsDCt, hsd, hsux, compute_mult, hspi, hslam, hst, work);
 
-	for(ii=0; ii<=N; ii++)
-		{
-		blasfeo_create_dvec(nb[ii]+ng[ii], &hsQx[ii], (void *) c_ptr);
-		c_ptr += hsQx[ii].memsize;
-		blasfeo_create_dvec(nb[ii]+ng[ii], &hsqx[ii], (void *) c_ptr);
-		c_ptr += hsqx[ii].memsize;
-		}
+	}
 
-	for(ii=0; ii<=N; ii++)
-		{
-		blasfeo_create_dvec(nu[ii]+nx[ii], &hsres_rq[ii], (void *) c_ptr);
-		c_ptr += hsres_rq[ii].memsize;
-		}
 
-	for(ii=0; ii<N; ii++)
-		{
-		blasfeo_create_dvec(nx[ii+1], &hsres_b[ii], (void *) c_ptr);
-		c_ptr += hsres_b[ii].memsize;
-		}
 
-	for(ii=0; ii<=N; ii++)
-		{
-		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &hsres_d[ii], (void *) c_ptr);
-		c_ptr += hsres_d[ii].memsize;
-		}
+static void d_kkt_solve_new_rhs_res_mpc_hard_ws_libstr(int **idxb, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, struct d_ip2_res_mpc_hard_solver *ws)
+	{
+	
+	// indeces
+	int ii;
 
-	for(ii=0; ii<=N; ii++)
-		{
-		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &hsres_m[ii], (void *) c_ptr);
-		c_ptr += hsres_m[ii].memsize;
-		}
+	int N = ws->N;
+	int *nx = ws->nx;
+	int *nu = ws->nu;
+	int *nb = ws->nb;
+	int *ng = ws->ng;
 
-	// backup solution
-	for(ii=0; ii<=N; ii++)
-		{
-		blasfeo_create_dvec(nu[ii]+nx[ii], &hsux_bkp[ii], (void *) c_ptr);
-		c_ptr += hsux_bkp[ii].memsize;
-		blasfeo_create_dvec(nx[ii], &hspi_bkp[ii], (void *) c_ptr);
-		c_ptr += hspi_bkp[ii].memsize;
-		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &hslam_bkp[ii], (void *) c_ptr);
-		c_ptr += hslam_bkp[ii].memsize;
-		blasfeo_create_dvec(2*nb[ii]+2*ng[ii], &hst_bkp[ii], (void *) c_ptr);
-		c_ptr += hst_bkp[ii].memsize;
-		}
+	struct blasfeo_dmat *hsL = ws->hsL;
+#if ITER_REF>0
+	struct blasfeo_dvec *hsQx = ws->hsQx;
+#endif
+	struct blasfeo_dvec *hsqx = ws->hsqx;
+	struct blasfeo_dvec *hsdux = ws->hsdux;
+	struct blasfeo_dvec *hsdpi = ws->hsdpi;
+	struct blasfeo_dvec *hsdt = ws->hsdt;
+	struct blasfeo_dvec *hsdlam = ws->hsdlam;
+	struct blasfeo_dvec *hstinv = ws->hstinv;
+	struct blasfeo_dvec *hsPb = ws->hsPb;
+	struct blasfeo_dvec *hsres_rq = ws->hsres_rq;
+	struct blasfeo_dvec *hsres_b = ws->hsres_b;
+	struct blasfeo_dvec *hsres_d = ws->hsres_d;
+	struct blasfeo_dvec *hsres_m = ws->hsres_m;
+	struct blasfeo_dvec *hsux_bkp = ws->hsux_bkp;
+	struct blasfeo_dvec *hspi_bkp = ws->hspi_bkp;
+	struct blasfeo_dvec *hst_bkp = ws->hst_bkp;
+	struct blasfeo_dvec *hslam_bkp = ws->hslam_bkp;
+
+	void *d_res_res_mpc_hard_work_space = ws->d_res_res_mpc_hard_work_space;
+#if ITER_REF>0
+	int ric_fallback = 0;
+#endif
+#if defined(RIC_PAR_CHUNKS)
+	void *d_par_back_ric_rec_work_space = ws->d_par_back_ric_rec_work_space;
+#endif
 
 
 
@@ -1337,7 +1948,15 @@ void d_kkt_solve_new_rhs_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, i
 
 
 	// solve the system
-	d_back_ric_rec_trs_libstr(N, nx, nu, nb, idxb, ng, hsBAbt, hsres_b, hsres_rq, hsDCt, hsqx, hsdux, compute_mult, hsdpi, 1, hsPb, hsL, d_back_ric_rec_work_space);
+#if ITER_REF>0
+	// the IPM leaves the factorization in single precision: factorize again, as Qx is left in the work space
+	d_back_ric_rec_sv_mixed_libstr(N, nx, nu, nb, idxb, ng, 1, &ric_fallback, hsBAbt, hsres_b, hsRSQrq, hsres_rq, hsDCt, hsQx, hsqx, hsdux, hsdpi, hsPb, hsL, ws);
+#elif defined(RIC_PAR_CHUNKS)
+	// the IPM leaves the parallel-in-time factorization, with the coarse system in its work space
+	d_par_back_ric_rec_trs_libstr(N, nx, nu, nb, idxb, ng, hsBAbt, hsres_b, hsres_rq, hsDCt, hsqx, hsdux, compute_mult, hsdpi, 1, hsPb, hsL, RIC_PAR_CHUNKS, d_par_back_ric_rec_work_space);
+#else
+	d_back_ric_rec_trs_libstr(N, nx, nu, nb, idxb, ng, hsBAbt, hsres_b, hsres_rq, hsDCt, hsqx, hsdux, compute_mult, hsdpi, 1, hsPb, hsL, ws->d_back_ric_rec_work_space);
+#endif
 
 
 
@@ -1361,4 +1980,184 @@ void d_kkt_solve_new_rhs_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, i
 
 	} // end of final kkt solve
 
+
+
+void d_kkt_solve_new_rhs_res_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, void *work)
+	{
+
+	struct d_ip2_res_mpc_hard_solver ws;
+
+	// TODO do not use variable size arrays !!!!!
+	double ptr_memory[(d_ip2_res_mpc_hard_ptr_memsize_libstr(N)+7)/8];
+
+	ws.N = N;
+	ws.nx = nx;
+	ws.nu = nu;
+	ws.nb = nb;
+	ws.ng = ng;
+	d_ip2_res_mpc_hard_create_ptr_libstr(N, &ws, (void *) ptr_memory);
+	d_ip2_res_mpc_hard_create_work_space_libstr(&ws, work);
+
+	d_kkt_solve_new_rhs_res_mpc_hard_ws_libstr(idxb, hsBAbt, hsb, hsRSQrq, hsq, hsDCt, hsd, hsux, compute_mult, hspi, hslam, hst, &ws);
+
+	return;
+
+	}
+
+
+// solver object
+
+int d_ip2_res_mpc_hard_solver_memsize_libstr(int N, int *nx, int *nu, int *nb, int *ng)
+	{
+
+	int size = 0;
+
+	size += 4*(N+1)*sizeof(int); // nx, nu, nb, ng
+	size += d_ip2_res_mpc_hard_ptr_memsize_libstr(N);
+
+	size += 64; // align the work space to (typical) cache line size
+	size += d_ip2_res_mpc_hard_work_space_size_bytes_libstr(N, nx, nu, nb, ng);
+
+	return size;
+	}
+
+
+
+void d_ip2_res_mpc_hard_solver_create_libstr(int N, int *nx, int *nu, int *nb, int *ng, struct d_ip2_res_mpc_hard_solver *solver, void *memory)
+	{
+
+	int ii;
+
+	// problem size
+	int *i_ptr = (int *) memory;
+
+	solver->N = N;
+	solver->nx = i_ptr;
+	i_ptr += N+1;
+	solver->nu = i_ptr;
+	i_ptr += N+1;
+	solver->nb = i_ptr;
+	i_ptr += N+1;
+	solver->ng = i_ptr;
+	i_ptr += N+1;
+	for(ii=0; ii<=N; ii++)
+		{
+		solver->nx[ii] = nx[ii];
+		solver->nu[ii] = nu[ii];
+		solver->nb[ii] = nb[ii];
+		solver->ng[ii] = ng[ii];
+		}
+
+	// descriptors
+	char *c_ptr = (char *) i_ptr;
+	d_ip2_res_mpc_hard_create_ptr_libstr(N, solver, (void *) c_ptr);
+	c_ptr += d_ip2_res_mpc_hard_ptr_memsize_libstr(N);
+
+	// work space
+	size_t addr = (( (size_t) c_ptr ) + 63 ) / 64 * 64;
+	solver->work = (void *) addr;
+	d_ip2_res_mpc_hard_create_work_space_libstr(solver, solver->work);
+
+	solver->memsize = d_ip2_res_mpc_hard_solver_memsize_libstr(N, nx, nu, nb, ng);
+
+	return;
+
+	}
+
+
+
+int d_ip2_res_mpc_hard_solver_solve_libstr(int *kk, int k_max, double mu0, double mu_tol, double alpha_min, int warm_start, double *stat, int **idxb, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, struct d_ip2_res_mpc_hard_solver *solver)
+	{
+
+	return d_ip2_res_mpc_hard_ipm_libstr(kk, k_max, 0.0, mu0, mu_tol, alpha_min, warm_start, stat, idxb, hsBAbt, hsRSQrq, hsDCt, hsd, hsux, compute_mult, hspi, hslam, hst, solver);
+
+	}
+
+
+
+int d_ip2_res_mpc_hard_solver_solve_deadline_libstr(int *kk, int k_max, double time_budget, double mu0, double mu_tol, double alpha_min, int warm_start, double *stat, int **idxb, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, struct d_ip2_res_mpc_hard_solver *solver)
+	{
+
+	return d_ip2_res_mpc_hard_ipm_libstr(kk, k_max, time_budget, mu0, mu_tol, alpha_min, warm_start, stat, idxb, hsBAbt, hsRSQrq, hsDCt, hsd, hsux, compute_mult, hspi, hslam, hst, solver);
+
+	}
+
+
+
+void d_ip2_res_mpc_hard_solver_kkt_solve_new_rhs_libstr(int **idxb, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsq, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, struct d_ip2_res_mpc_hard_solver *solver)
+	{
+
+	d_kkt_solve_new_rhs_res_mpc_hard_ws_libstr(idxb, hsBAbt, hsb, hsRSQrq, hsq, hsDCt, hsd, hsux, compute_mult, hspi, hslam, hst, solver);
+
+	return;
+
+	}
+
+
+
+// receding horizon warm start: shift ux, pi, t & lam by one stage and simulate the tail with the last stage dynamics
+void d_shift_warm_start_mpc_hard_libstr(int N, int *nx, int *nu, int *nb, int *ng, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsux, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, double mu_min)
+	{
+
+	int ii, jj;
+
+	int nu0, nx0, nt0;
+
+	double *ptr_t, *ptr_lam;
+
+	for(jj=0; jj<N; jj++)
+		{
+
+		// inputs & states: stage 0 may have no states, stage N no inputs
+		nu0 = nu[jj]<nu[jj+1] ? nu[jj] : nu[jj+1];
+		nx0 = nx[jj]<nx[jj+1] ? nx[jj] : nx[jj+1];
+		blasfeo_dveccp(nu0, &hsux[jj+1], 0, &hsux[jj], 0);
+		blasfeo_dveccp(nx0, &hsux[jj+1], nu[jj+1], &hsux[jj], nu[jj]);
+
+		// equality multipliers
+		if(jj>0)
+			blasfeo_dveccp(nx[jj]<nx[jj+1] ? nx[jj] : nx[jj+1], &hspi[jj+1], 0, &hspi[jj], 0);
+
+		// inequality slacks & multipliers, only between stages with the same constraints
+		if(nb[jj]==nb[jj+1] && ng[jj]==ng[jj+1])
+			{
+			blasfeo_dveccp(2*nb[jj]+2*ng[jj], &hst[jj+1], 0, &hst[jj], 0);
+			blasfeo_dveccp(2*nb[jj]+2*ng[jj], &hslam[jj+1], 0, &hslam[jj], 0);
+			}
+
+		}
+
+	// tail: hold last input, multipliers & slacks, and simulate the last state
+	if(N>0)
+		{
+		blasfeo_drowex(nx[N], 1.0, &hsBAbt[N-1], nu[N-1]+nx[N-1], 0, &hsux[N], nu[N]);
+		blasfeo_dgemv_t(nu[N-1]+nx[N-1], nx[N], 1.0, &hsBAbt[N-1], 0, 0, &hsux[N-1], 0, 1.0, &hsux[N], nu[N], &hsux[N], nu[N]);
+		}
+
+	// keep t & lam in the interior: raise the smaller of the two until t*lam>=mu_min,
+	// so that the active set information (small t, large lam or viceversa) is preserved
+	for(jj=0; jj<=N; jj++)
+		{
+		ptr_t = hst[jj].pa;
+		ptr_lam = hslam[jj].pa;
+		nt0 = nb[jj]+ng[jj];
+		for(ii=0; ii<2*nt0; ii++)
+			{
+			ptr_t[ii] = fmax( 1e-12, ptr_t[ii] );
+			ptr_lam[ii] = fmax( 1e-12, ptr_lam[ii] );
+			if(ptr_t[ii]*ptr_lam[ii]<mu_min)
+				{
+				if(ptr_t[ii]<ptr_lam[ii])
+					ptr_t[ii] = mu_min/ptr_lam[ii];
+				else
+					ptr_lam[ii] = mu_min/ptr_t[ii];
+				}
+			}
+		}
+
+	return;
+
+	}
+
+
 #endif
@@ -0,0 +1,377 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <math.h>
+
+#ifdef BLASFEO
+
+#include <blasfeo_target.h>
+#include <blasfeo_common.h>
+#include <blasfeo_d_aux.h>
+#include <blasfeo_d_blas.h>
+
+#include "../include/lqcp_solvers.h"
+#include "../include/mpc_aux.h"
+#include "../include/mpc_solvers.h"
+
+
+
+// work space size 
+int d_ip2_res_mpc_soft_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int *ng, int *ns)
+	{
+
+	int ii, nt0;
+
+	int nbs[N+1];
+	for(ii=0; ii<=N; ii++)
+		nbs[ii] = nb[ii] + ns[ii];
+
+	int size = 0;
+
+	for(ii=0; ii<=N; ii++)
+		{
+		nt0 = nbs[ii] + ng[ii];
+		size += blasfeo_memsize_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii]); // L
+		size += 4*blasfeo_memsize_dvec(nx[ii]); // b, dpi, Pb, res_b
+		size += 3*blasfeo_memsize_dvec(nu[ii]+nx[ii]); // dux, rq, res_rq
+		size += 4*blasfeo_memsize_dvec(2*nt0+2*ns[ii]); // dlam, dt, tinv, res_m
+		size += 1*blasfeo_memsize_dvec(2*nt0); // res_d
+		size += 2*blasfeo_memsize_dvec(nt0); // Qx, qx
+		size += 3*blasfeo_memsize_dvec(2*ns[ii]); // res_z, Zl, zl
+		}
+
+	// residuals work space size
+	size += d_res_res_mpc_soft_work_space_size_bytes_libstr(N, nx, nu, nb, ng, ns);
+
+	// riccati work space size: the soft boxes are seen as hard boxes by the riccati recursion
+	size += d_back_ric_rec_work_space_size_bytes_libstr(N, nx, nu, nbs, ng);
+
+	// make multiple of (typical) cache line size
+	size = (size+63)/64*64;
+
+	return size;
+	}
+
+
+
+/* primal-dual interior-point method computing residuals at each iteration, soft constraints, time variant matrices, time variant size (mpc version) */
+int d_ip2_res_mpc_soft_libstr(int *kk, int k_max, double mu0, double mu_tol, double alpha_min, int warm_start, double *stat, int N, int *nx, int *nu, int *nb, int **idxb, int *ng, int *ns, struct blasfeo_dmat *hsBAbt, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsZ, struct blasfeo_dvec *hsz, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hsux, int compute_mult, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, void *work)
+	{
+
+	// indeces
+	int jj, ii, nt0;
+
+
+
+	int nbs[N+1];
+	for(ii=0; ii<=N; ii++)
+		nbs[ii] = nb[ii] + ns[ii];
+
+	struct blasfeo_dvec hsb[N];
+	struct blasfeo_dvec hsrq[N+1];
+	struct blasfeo_dvec hsQx[N+1];
+	struct blasfeo_dvec hsqx[N+1];
+	struct blasfeo_dvec hsdux[N+1];
+	struct blasfeo_dvec hsdpi[N+1];
+	struct blasfeo_dvec hsdt[N+1];
+	struct blasfeo_dvec hsdlam[N+1];
+	struct blasfeo_dvec hstinv[N+1];
+	struct blasfeo_dvec hsPb[N+1];
+	struct blasfeo_dmat hsL[N+1];
+	struct blasfeo_dvec hsres_rq[N+1];
+	struct blasfeo_dvec hsres_b[N];
+	struct blasfeo_dvec hsres_d[N+1];
+	struct blasfeo_dvec hsres_m[N+1];
+	struct blasfeo_dvec hsres_z[N+1];
+	struct blasfeo_dvec hsZl[N+1];
+	struct blasfeo_dvec hszl[N+1];
+
+	void *d_back_ric_rec_work_space;
+	void *d_res_res_mpc_soft_work_space;
+
+	char *c_ptr = work;
+
+	// riccati work space
+	d_back_ric_rec_work_space = (void *) c_ptr;
+	c_ptr += d_back_ric_rec_work_space_size_bytes_libstr(N, nx, nu, nbs, ng);
+
+	// residuals work space
+	d_res_res_mpc_soft_work_space = (void *) c_ptr;
+	c_ptr += d_res_res_mpc_soft_work_space_size_bytes_libstr(N, nx, nu, nb, ng, ns);
+
+	// L
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_create_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], &hsL[ii], (void *) c_ptr);
+		c_ptr += hsL[ii].memsize;
+		}
+
+	// b as vector
+	for(ii=0; ii<N; ii++)
+		{
+		blasfeo_create_dvec(nx[ii+1], &hsb[ii], (void *) c_ptr);
+		c_ptr += hsb[ii].memsize;
+		}
+
+	// inputs and states step
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_create_dvec(nu[ii]+nx[ii], &hsdux[ii], (void *) c_ptr);
+		c_ptr += hsdux[ii].memsize;
+		}
+
+	// equality constr multipliers step
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_create_dvec(nx[ii], &hsdpi[ii], (void *) c_ptr);
+		c_ptr += hsdpi[ii].memsize;
+		}
+
+	// backup of P*b
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_create_dvec(nx[ii], &hsPb[ii], (void *) c_ptr);
+		c_ptr += hsPb[ii].memsize;
+		}
+
+	// linear part of cost function
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_create_dvec(nu[ii]+nx[ii], &hsrq[ii], (void *) c_ptr);
+		c_ptr += hsrq[ii].memsize;
+		}
+
+	// slack variables, Lagrangian multipliers for inequality constraints and work space
+	for(ii=0; ii<=N; ii++)
+		{
+		nt0 = nbs[ii] + ng[ii];
+		blasfeo_create_dvec(2*nt0+2*ns[ii], &hsdlam[ii], (void *) c_ptr);
+		c_ptr += hsdlam[ii].memsize;
+		blasfeo_create_dvec(2*nt0+2*ns[ii], &hsdt[ii], (void *) c_ptr);
+		c_ptr += hsdt[ii].memsize;
+		blasfeo_create_dvec(2*nt0+2*ns[ii], &hstinv[ii], (void *) c_ptr);
+		c_ptr += hstinv[ii].memsize;
+		}
+
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_create_dvec(nbs[ii]+ng[ii], &hsQx[ii], (void *) c_ptr);
+		c_ptr += hsQx[ii].memsize;
+		blasfeo_create_dvec(nbs[ii]+ng[ii], &hsqx[ii], (void *) c_ptr);
+		c_ptr += hsqx[ii].memsize;
+		}
+
+	// reduced Hessian and gradient of the slack variables
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_create_dvec(2*ns[ii], &hsZl[ii], (void *) c_ptr);
+		c_ptr += hsZl[ii].memsize;
+		blasfeo_create_dvec(2*ns[ii], &hszl[ii], (void *) c_ptr);
+		c_ptr += hszl[ii].memsize;
+		}
+
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_create_dvec(nu[ii]+nx[ii], &hsres_rq[ii], (void *) c_ptr);
+		c_ptr += hsres_rq[ii].memsize;
+		}
+
+	for(ii=0; ii<N; ii++)
+		{
+		blasfeo_create_dvec(nx[ii+1], &hsres_b[ii], (void *) c_ptr);
+		c_ptr += hsres_b[ii].memsize;
+		}
+
+	for(ii=0; ii<=N; ii++)
+		{
+		nt0 = nbs[ii] + ng[ii];
+		blasfeo_create_dvec(2*nt0, &hsres_d[ii], (void *) c_ptr);
+		c_ptr += hsres_d[ii].memsize;
+		blasfeo_create_dvec(2*nt0+2*ns[ii], &hsres_m[ii], (void *) c_ptr);
+		c_ptr += hsres_m[ii].memsize;
+		blasfeo_create_dvec(2*ns[ii], &hsres_z[ii], (void *) c_ptr);
+		c_ptr += hsres_z[ii].memsize;
+		}
+
+	// extract linear part of state space model and cost function	
+
+	// extract b
+	for(jj=0; jj<N; jj++)
+		{
+		blasfeo_drowex(nx[jj+1], 1.0, &hsBAbt[jj], nu[jj]+nx[jj], 0, &hsb[jj], 0);
+		}
+
+	// extract q
+	for(jj=0; jj<=N; jj++)
+		{
+		blasfeo_drowex(nu[jj]+nx[jj], 1.0, &hsRSQrq[jj], nu[jj]+nx[jj], 0, &hsrq[jj], 0);
+		}
+
+
+
+	double alpha, mu, mu_aff;
+
+	// check if there are inequality constraints
+	double mu_scal = 0.0; 
+	for(jj=0; jj<=N; jj++) mu_scal += 2*nb[jj] + 2*ng[jj] + 4*ns[jj];
+	if(mu_scal!=0.0) // there are some constraints
+		{
+		mu_scal = 1.0 / mu_scal;
+		}
+	else // call the riccati solver and return
+		{
+		d_back_ric_rec_sv_libstr(N, nx, nu, nb, idxb, ng, 0, hsBAbt, NULL, 0, hsRSQrq, NULL, NULL, NULL, NULL, hsux, compute_mult, hspi, 0, NULL, hsL, d_back_ric_rec_work_space);
+		// no IPM iterations
+		*kk = 0;
+		// return success
+		return 0;
+		}
+
+	double sigma = 0.0;
+
+
+
+	// initialize ux & pi & t>0 & lam>0 (slack variables included)
+	d_init_var_mpc_soft_libstr(N, nx, nu, nb, idxb, ng, ns, hsux, hspi, hsDCt, hsd, hst, hslam, mu0, warm_start);
+
+	// compute residuals
+	d_res_res_mpc_soft_libstr(N, nx, nu, nb, idxb, ng, ns, hsBAbt, hsb, hsRSQrq, hsrq, hsZ, hsz, hsux, hsDCt, hsd, hspi, hslam, hst, hsres_rq, hsres_b, hsres_d, hsres_m, hsres_z, &mu, d_res_res_mpc_soft_work_space);
+
+	// set to zero iteration count
+	*kk = 0;	
+
+	// larger than minimum accepted step size
+	alpha = 1.0;
+
+
+
+	// IP loop		
+	while( *kk<k_max && mu>mu_tol && alpha>=alpha_min )
+		{
+
+		// compute the update of Hessian and gradient from box and general constraints, eliminating the slack variables
+		d_update_hessian_gradient_res_mpc_soft_libstr(N, nx, nu, nb, ng, ns, hsres_d, hsres_m, hsres_z, hst, hslam, hstinv, hsZ, hsZl, hszl, hsQx, hsqx);
+
+
+
+		// compute the search direction: factorize and solve the KKT system
+		d_back_ric_rec_sv_libstr(N, nx, nu, nbs, idxb, ng, 1, hsBAbt, hsres_b, 1, hsRSQrq, hsres_rq, hsDCt, hsQx, hsqx, hsdux, compute_mult, hsdpi, 1, hsPb, hsL, d_back_ric_rec_work_space);
+
+
+
+		// compute t_aff & dlam_aff & dt_aff & alpha
+		alpha = 1.0;
+		d_compute_alpha_res_mpc_soft_libstr(N, nx, nu, nb, idxb, ng, ns, hsdux, hst, hstinv, hslam, hsDCt, hsres_d, hsres_m, hsZl, hszl, hsdt, hsdlam, &alpha);
+
+		stat[5*(*kk)] = sigma;
+		stat[5*(*kk)+1] = alpha;
+			
+		alpha *= 0.995;
+
+
+
+		// compute the affine duality gap
+		d_compute_mu_mpc_soft_libstr(N, nx, nu, nb, ng, ns, &mu_aff, mu_scal, alpha, hslam, hsdlam, hst, hsdt);
+
+		stat[5*(*kk)+2] = mu_aff;
+
+
+
+		// compute sigma
+		sigma = mu_aff/mu;
+		sigma = sigma*sigma*sigma;
+
+
+
+		// update res_m
+		d_compute_centering_correction_res_mpc_soft_libstr(N, nb, ng, ns, sigma*mu, hsdt, hsdlam, hsres_m);
+
+		// update gradient
+		d_update_gradient_res_mpc_soft_libstr(N, nx, nu, nb, ng, ns, hsres_d, hsres_m, hsres_z, hslam, hstinv, hsZl, hszl, hsqx);
+
+
+
+		// solve the KKT system
+		d_back_ric_rec_trs_libstr(N, nx, nu, nbs, idxb, ng, hsBAbt, hsres_b, hsres_rq, hsDCt, hsqx, hsdux, compute_mult, hsdpi, 0, hsPb, hsL, d_back_ric_rec_work_space);
+
+
+
+		// compute t & dlam & dt & alpha
+		alpha = 1.0;
+		d_compute_alpha_res_mpc_soft_libstr(N, nx, nu, nb, idxb, ng, ns, hsdux, hst, hstinv, hslam, hsDCt, hsres_d, hsres_m, hsZl, hszl, hsdt, hsdlam, &alpha);
+
+		stat[5*(*kk)] = sigma;
+		stat[5*(*kk)+3] = alpha;
+			
+		alpha *= 0.995;
+
+
+
+		// update x, u, pi, lam, t (slack variables included)
+		d_update_var_res_mpc_soft_libstr(N, nx, nu, nb, ng, ns, alpha, hsux, hsdux, hspi, hsdpi, hst, hsdt, hslam, hsdlam);
+
+
+
+		// restore dynamics
+		for(jj=0; jj<N; jj++)
+			blasfeo_drowin(nx[jj+1], 1.0, &hsb[jj], 0, &hsBAbt[jj], nu[jj]+nx[jj], 0);
+
+
+
+		// compute residuals
+		d_res_res_mpc_soft_libstr(N, nx, nu, nb, idxb, ng, ns, hsBAbt, hsb, hsRSQrq, hsrq, hsZ, hsz, hsux, hsDCt, hsd, hspi, hslam, hst, hsres_rq, hsres_b, hsres_d, hsres_m, hsres_z, &mu, d_res_res_mpc_soft_work_space);
+
+		stat[5*(*kk)+4] = mu;
+
+
+
+		// increment loop index
+		(*kk)++;
+
+		} // end of IP loop
+
+
+
+	// successful exit
+	if(mu<=mu_tol)
+		return 0;
+	
+	// max number of iterations reached
+	if(*kk>=k_max)
+		return 1;
+	
+	// no improvement
+	if(alpha<alpha_min)
+		return 2;
+	
+	// impossible
+	return -1;
+
+	} // end of ipsolver
+
+
+
+#endif
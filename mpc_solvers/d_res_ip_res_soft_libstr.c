@@ -0,0 +1,125 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#ifdef BLASFEO
+
+#include <blasfeo_target.h>
+#include <blasfeo_common.h>
+#include <blasfeo_d_aux.h>
+#include <blasfeo_d_blas.h>
+
+#include "../include/mpc_solvers.h"
+
+
+
+int d_res_res_mpc_soft_work_space_size_bytes_libstr(int N, int *nx, int *nu, int *nb, int *ng, int *ns)
+	{
+
+	int ii;
+
+	int nbs[N+1];
+	for(ii=0; ii<=N; ii++)
+		nbs[ii] = nb[ii] + ns[ii];
+
+	return d_res_res_mpc_hard_work_space_size_bytes_libstr(N, nx, nu, nbs, ng);
+
+	}
+
+
+
+// the soft boxes are handled as hard ones on [x+s_l, x-s_u], then corrected for the slack variables
+void d_res_res_mpc_soft_libstr(int N, int *nx, int *nu, int *nb, int **idxb, int *ng, int *ns, struct blasfeo_dmat *hsBAbt, struct blasfeo_dvec *hsb, struct blasfeo_dmat *hsRSQrq, struct blasfeo_dvec *hsrq, struct blasfeo_dvec *hsZ, struct blasfeo_dvec *hsz, struct blasfeo_dvec *hsux, struct blasfeo_dmat *hsDCt, struct blasfeo_dvec *hsd, struct blasfeo_dvec *hspi, struct blasfeo_dvec *hslam, struct blasfeo_dvec *hst, struct blasfeo_dvec *hsres_rq, struct blasfeo_dvec *hsres_b, struct blasfeo_dvec *hsres_d, struct blasfeo_dvec *hsres_m, struct blasfeo_dvec *hsres_z, double *mu, void *work)
+	{
+
+	int ii, jj;
+
+	int nb0, ns0, nt0, nt_tot, ns_tot;
+
+	double
+		*ptr_t, *ptr_lam, *ptr_res_d, *ptr_res_z, *ptr_Z, *ptr_z;
+
+	double
+		mu_h, mu2;
+
+	int nbs[N+1];
+	nt_tot = 0;
+	ns_tot = 0;
+	for(ii=0; ii<=N; ii++)
+		{
+		nbs[ii] = nb[ii] + ns[ii];
+		nt_tot += nbs[ii] + ng[ii];
+		ns_tot += ns[ii];
+		}
+
+	mu_h = 0.0;
+	d_res_res_mpc_hard_libstr(N, nx, nu, nbs, idxb, ng, hsBAbt, hsb, hsRSQrq, hsrq, hsux, hsDCt, hsd, hspi, hslam, hst, hsres_rq, hsres_b, hsres_d, hsres_m, &mu_h, work);
+
+	mu2 = 2.0*nt_tot*mu_h;
+
+	for(ii=0; ii<=N; ii++)
+		{
+
+		nb0 = nb[ii];
+		ns0 = ns[ii];
+		nt0 = nb0 + ns0 + ng[ii];
+
+		if(ns0>0)
+			{
+
+			ptr_t     = hst[ii].pa;
+			ptr_lam   = hslam[ii].pa;
+			ptr_res_d = hsres_d[ii].pa;
+			ptr_res_z = hsres_z[ii].pa;
+			ptr_Z     = hsZ[ii].pa;
+			ptr_z     = hsz[ii].pa;
+
+			for(jj=0; jj<ns0; jj++)
+				{
+				ptr_res_d[nb0+jj]     -= ptr_t[2*nt0+jj];
+				ptr_res_d[nt0+nb0+jj] += ptr_t[2*nt0+ns0+jj];
+				ptr_res_z[jj]     = ptr_Z[jj]*ptr_t[2*nt0+jj]         + ptr_z[jj]     - ptr_lam[nb0+jj]     - ptr_lam[2*nt0+jj];
+				ptr_res_z[ns0+jj] = ptr_Z[ns0+jj]*ptr_t[2*nt0+ns0+jj] + ptr_z[ns0+jj] - ptr_lam[nt0+nb0+jj] - ptr_lam[2*nt0+ns0+jj];
+				}
+
+			mu2 += blasfeo_dvecmuldot(2*ns0, &hslam[ii], 2*nt0, &hst[ii], 2*nt0, &hsres_m[ii], 2*nt0);
+
+			}
+
+		}
+
+	// normalize mu
+	if(nt_tot!=0)
+		{
+		mu2 /= 2.0*nt_tot + 2.0*ns_tot;
+		mu[0] = mu2;
+		}
+
+	return;
+
+	}
+
+
+
+#endif
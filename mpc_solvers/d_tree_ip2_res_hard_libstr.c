@@ -321,7 +321,17 @@ int d_tree_ip2_res_mpc_hard_libstr(int *kk, int k_max, double mu0, double mu_tol
 
 
 	// compute the duality gap
-	mu = mu0;
+	if(warm_start==2)
+		{
+		mu = 0.0;
+		for(jj=0; jj<=N; jj++)
+			mu += blasfeo_ddot(2*nb[jj]+2*ng[jj], &hst[jj], 0, &hslam[jj], 0);
+		mu *= mu_scal;
+		}
+	else
+		{
+		mu = mu0;
+		}
 
 	// set to zero iteration count
 	*kk = 0;	
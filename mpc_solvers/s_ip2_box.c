@@ -0,0 +1,297 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "../include/aux_s.h"
+#include "../include/lqcp_solvers.h"
+#include "../include/block_size.h"
+#include "../include/mpc_aux.h"
+
+
+
+/* Mehrotra's predictor-corrector interior-point method in single precision, box constraints, time-invariant matrices */
+int s_ip2_box_mpc(int *kk, int k_max, float mu_tol, float alpha_min, int warm_start, float *sigma_par, float *stat, int nx, int nu, int N, int nb, float **pBAbt, float **pQ, float **db, float **ux, int compute_mult, float **pi, float **lam, float **t, float *work_memory)
+	{
+
+	// indeces
+	int jj, ll;
+
+	// constants
+	const int bs = S_MR;
+	const int ncl = S_NCL;
+	const int nal = bs*ncl; // number of floats per cache line
+
+	const int nbu = nu<nb ? nu : nb ;
+
+	// matrices size
+	const int nz = nx+nu+1;
+	const int pnz = bs*((nz+bs-1)/bs);
+	const int anz = nal*((nz+nal-1)/nal);
+	const int anx = nal*((nx+nal-1)/nal);
+	const int anb = nal*((2*nb+nal-1)/nal); // cache aligned number of box constraints
+	const int cnz = ncl*((nx+nu+1+ncl-1)/ncl);
+	const int cnx = ncl*((nx+ncl-1)/ncl);
+	const int pad = (ncl-nx%ncl)%ncl; // packing between BAbtL & P
+	const int cnl = cnz<cnx+ncl ? nx+pad+cnx+ncl : nx+pad+cnz;
+
+
+
+	// initialize work space
+	// work_space_float_size_per_stage = pnz*cnl + 4*anz + 4*anb + 2*anx
+	// work_space_float_size_const = 3*anz
+	float *ptr;
+	ptr = work_memory; // supposed to be aligned to cache line boundaries
+
+	float *pL[N+1];
+	float *dux[N+1];
+	float *dpi[N+1];
+	float *pd[N+1]; // pointer to diagonal of Hessian
+	float *pl[N+1]; // pointer to linear part of Hessian
+	float *bd[N+1]; // backup diagonal of Hessian
+	float *bl[N+1]; // backup linear part of Hessian
+	float *work;
+	float *diag;
+	float *dlam[N+1];
+	float *dt[N+1];
+	float *lamt[N+1];
+	float *t_inv[N+1];
+	float *pl2[N+1];
+	float *Pb[N];
+
+	// Riccati factorization
+	for(jj=0; jj<=N; jj++)
+		{
+		pL[jj] = ptr;
+		ptr += pnz*cnl;
+		}
+	// work space
+	work = ptr;
+	ptr += 2*anz;
+	diag = ptr;
+	ptr += anz;
+	// inputs and states
+	for(jj=0; jj<=N; jj++)
+		{
+		dux[jj] = ptr;
+		ptr += anz;
+		}
+	// equality constr multipliers
+	for(jj=0; jj<=N; jj++)
+		{
+		dpi[jj] = ptr;
+		ptr += anx;
+		for(ll=0; ll<nx; ll++)
+			dpi[jj][ll] = 0.0;
+		}
+	// backup of P*b
+	for(jj=0; jj<N; jj++)
+		{
+		Pb[jj] = ptr;
+		ptr += anx;
+		}
+	// Hessian
+	for(jj=0; jj<=N; jj++)
+		{
+		pd[jj] = pQ[jj];
+		pl[jj] = pQ[jj] + ((nu+nx)/bs)*bs*cnz + (nu+nx)%bs;
+		bd[jj] = ptr;
+		bl[jj] = ptr + anz;
+		pl2[jj] = ptr + 2*anz;
+		ptr += 3*anz;
+		// backup
+		for(ll=0; ll<nx+nu; ll++)
+			{
+			bd[jj][ll] = pd[jj][(ll/bs)*bs*cnz+ll%bs+ll*bs];
+			bl[jj][ll] = pl[jj][ll*bs];
+			}
+		}
+	// slack variables, Lagrangian multipliers for inequality constraints and work space
+	for(jj=0; jj<=N; jj++)
+		{
+		dlam[jj] = ptr;
+		dt[jj]   = ptr + anb;
+		lamt[jj] = ptr + 2*anb;
+		t_inv[jj] = ptr + 3*anb;
+		ptr += 4*anb;
+		for(ll=0; ll<anb; ll++)
+			{
+			dlam[jj][ll] = 0.0;
+			dt[jj][ll] = 0.0;
+			}
+		}
+
+
+
+	float alpha, mu, mu_aff;
+
+	// check if there are inequality constraints
+	float mu_scal = 2*nbu + 2*(N-1)*nb;
+	if(nb>nu) mu_scal += 2*(nb-nu);
+	if(mu_scal!=0.0) // there are some constraints
+		{
+		mu_scal = 1.0 / mu_scal;
+		}
+	else // call the riccati solver and return
+		{
+		s_ric_sv_mpc(nx, nu, N, pBAbt, pQ, ux, pL, work, diag, compute_mult, pi);
+		*kk = 0;
+		return 0;
+		}
+
+	float sigma, sigma_min;
+
+	sigma = sigma_par[0]; // the initial sigma
+	sigma_min = sigma_par[2]; // the minimum value of sigma
+
+	// initialize ux & t>0 (slack variable)
+	s_init_ux_pi_t_box_mpc(N, nx, nu, nbu, nb, ux, pi, db, t, warm_start);
+
+	// initialize lambda>0 (multiplier of the inequality constr)
+	s_init_lam_mpc(N, nu, nbu, nb, t, lam);
+
+	// initialize dux
+	for(ll=0; ll<nx; ll++)
+		dux[0][nu+ll] = ux[0][nu+ll];
+
+	// compute the duality gap
+	alpha = 0.0; // needed to compute mu !!!!!
+	s_compute_mu_mpc(N, nbu, nu, nb, &mu, mu_scal, alpha, lam, dlam, t, dt);
+
+	// set to zero iteration count
+	*kk = 0;	
+
+	// larger than minimum accepted step size
+	alpha = 1.0;
+
+	// IP loop		
+	while( *kk<k_max && mu>mu_tol && alpha>=alpha_min )
+		{
+
+		//update cost function matrices and vectors (box constraints)
+		s_update_hessian_box_mpc(N, nbu, (nu/bs)*bs, nb, cnz, 0.0, t, t_inv, lam, lamt, dlam, bd, bl, pd, pl, pl2, db);
+
+		// gradient entries not affected by the box constraints
+		for(ll=nbu; ll<nx+nu; ll++)
+			pl2[0][ll] = bl[0][ll];
+		for(jj=1; jj<=N; jj++)
+			for(ll=nb; ll<nx+nu; ll++)
+				pl2[jj][ll] = bl[jj][ll];
+
+		// compute the search direction: factorize and solve the KKT system
+		s_ric_sv_mpc(nx, nu, N, pBAbt, pQ, dux, pL, work, diag, compute_mult, dpi);
+
+		// compute t_aff & dlam_aff & dt_aff & alpha
+		alpha = 1.0;
+		s_compute_alpha_box_mpc(N, 2*nbu, 2*nu, 2*nb, &alpha, t, dt, lam, dlam, lamt, dux, db);
+
+		stat[5*(*kk)+1] = alpha;
+
+		alpha *= 0.995;
+
+		// compute the affine duality gap
+		s_compute_mu_mpc(N, nbu, nu, nb, &mu_aff, mu_scal, alpha, lam, dlam, t, dt);
+
+		stat[5*(*kk)+2] = mu_aff;
+
+		// compute sigma
+		sigma = mu_aff/mu;
+		sigma = sigma*sigma*sigma;
+		if(sigma<sigma_min)
+			sigma = sigma_min;
+
+		// centering and second order correction of the gradient
+		for(ll=0; ll<2*nbu; ll+=2)
+			{
+			dlam[0][ll+0] = t_inv[0][ll+0]*(sigma*mu - dlam[0][ll+0]*dt[0][ll+0]);
+			dlam[0][ll+1] = t_inv[0][ll+1]*(sigma*mu - dlam[0][ll+1]*dt[0][ll+1]);
+			pl2[0][ll/2] += dlam[0][ll+1] - dlam[0][ll+0];
+			}
+		for(jj=1; jj<N; jj++)
+			{
+			for(ll=0; ll<2*nb; ll+=2)
+				{
+				dlam[jj][ll+0] = t_inv[jj][ll+0]*(sigma*mu - dlam[jj][ll+0]*dt[jj][ll+0]);
+				dlam[jj][ll+1] = t_inv[jj][ll+1]*(sigma*mu - dlam[jj][ll+1]*dt[jj][ll+1]);
+				pl2[jj][ll/2] += dlam[jj][ll+1] - dlam[jj][ll+0];
+				}
+			}
+		for(ll=2*nu; ll<2*nb; ll+=2)
+			{
+			dlam[N][ll+0] = t_inv[N][ll+0]*(sigma*mu - dlam[N][ll+0]*dt[N][ll+0]);
+			dlam[N][ll+1] = t_inv[N][ll+1]*(sigma*mu - dlam[N][ll+1]*dt[N][ll+1]);
+			pl2[N][ll/2] += dlam[N][ll+1] - dlam[N][ll+0];
+			}
+
+		// solve the system with the corrected gradient
+		s_ric_trs_mpc(nx, nu, N, pBAbt, pL, pl2, dux, work, 1, Pb, compute_mult, dpi);
+
+		// compute t & dlam & dt & alpha
+		alpha = 1.0;
+		s_compute_alpha_box_mpc(N, 2*nbu, 2*nu, 2*nb, &alpha, t, dt, lam, dlam, lamt, dux, db);
+
+		stat[5*(*kk)] = sigma;
+		stat[5*(*kk)+3] = alpha;
+
+		alpha *= 0.995;
+
+		// update x, u, lam, t & compute the duality gap mu
+		s_update_var_mpc(nx, nu, N, nb, nbu, &mu, mu_scal, alpha, ux, dux, t, dt, lam, dlam, pi, dpi);
+
+		stat[5*(*kk)+4] = mu;
+
+		// increment loop index
+		(*kk)++;
+
+		} // end of IP loop
+	
+
+	// restore Hessian
+	for(jj=0; jj<=N; jj++)
+		{
+		for(ll=0; ll<nx+nu; ll++)
+			{
+			pd[jj][(ll/bs)*bs*cnz+ll%bs+ll*bs] = bd[jj][ll];
+			pl[jj][ll*bs] = bl[jj][ll];
+			}
+		}
+
+	// successful exit
+	if(mu<=mu_tol)
+		return 0;
+	
+	// max number of iterations reached
+	if(*kk>=k_max)
+		return 1;
+	
+	// no improvement
+	if(alpha<alpha_min)
+		return 2;
+	
+	// impossible
+	return -1;
+
+	} // end of ipsolver
@@ -0,0 +1,80 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include "../include/lqcp_solvers.h"
+
+
+
+/* residuals of the box-constrained MPC problem, and duality measure */
+void s_res_ip_box_mpc(int nx, int nu, int N, int nb, float **hpBAbt, float **hpQ, float **hq, float **hux, float **hdb, float **hpi, float **hlam, float **ht, float **hrq, float **hrb, float **hrd, float *mu)
+	{
+
+	const int nbu = nu<nb ? nu : nb ;
+
+	int ii, jj;
+
+	float mu2 = 0;
+
+	// equality constraints and stationarity w.r.t. the unconstrained problem
+	s_res_mpc(nx, nu, N, hpBAbt, hpQ, hq, hux, hpi, hrq, hrb);
+
+	// first stage
+	for(jj=0; jj<nbu; jj++)
+		{
+		hrq[0][jj] += hlam[0][2*jj+0] - hlam[0][2*jj+1];
+		hrd[0][2*jj+0] =   hux[0][jj] - hdb[0][2*jj+0] - ht[0][2*jj+0];
+		hrd[0][2*jj+1] = - hdb[0][2*jj+1] - hux[0][jj] - ht[0][2*jj+1];
+		mu2 += hlam[0][2*jj+0] * ht[0][2*jj+0] + hlam[0][2*jj+1] * ht[0][2*jj+1];
+		}
+
+	// middle stages
+	for(ii=1; ii<N; ii++)
+		{
+		for(jj=0; jj<nb; jj++)
+			{
+			hrq[ii][jj] += hlam[ii][2*jj+0] - hlam[ii][2*jj+1];
+			hrd[ii][2*jj+0] =   hux[ii][jj] - hdb[ii][2*jj+0] - ht[ii][2*jj+0];
+			hrd[ii][2*jj+1] = - hdb[ii][2*jj+1] - hux[ii][jj] - ht[ii][2*jj+1];
+			mu2 += hlam[ii][2*jj+0] * ht[ii][2*jj+0] + hlam[ii][2*jj+1] * ht[ii][2*jj+1];
+			}
+		}
+
+	// last stage
+	for(jj=nu; jj<nb; jj++)
+		{
+		hrq[N][jj] += hlam[N][2*jj+0] - hlam[N][2*jj+1];
+		hrd[N][2*jj+0] =   hux[N][jj] - hdb[N][2*jj+0] - ht[N][2*jj+0];
+		hrd[N][2*jj+1] = - hdb[N][2*jj+1] - hux[N][jj] - ht[N][2*jj+1];
+		mu2 += hlam[N][2*jj+0] * ht[N][2*jj+0] + hlam[N][2*jj+1] * ht[N][2*jj+1];
+		}
+
+	ii = 2*nbu + 2*(N-1)*nb;
+	if(nb>nu) ii += 2*(nb-nu);
+	if(ii>0)
+		mu2 /= ii;
+
+	mu[0] = mu2;
+
+	}
@@ -0,0 +1,301 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "../include/aux_d.h"
+#include "../include/blas_d.h"
+#include "../include/block_size.h"
+
+
+
+// reference routines on column-major matrices, in plain C99
+
+// D <= C + alg * A * B', with A m x k and B n x k (leading dimension ldb)
+static void ref_dgemm_nt(int m, int n, int k, double *A, double *B, int ldb, int alg, double *C, double *D)
+	{
+
+	int ii, jj, kk;
+	double tmp;
+
+	for(jj=0; jj<n; jj++)
+		for(ii=0; ii<m; ii++)
+			{
+			tmp = 0.0;
+			for(kk=0; kk<k; kk++)
+				tmp += A[ii+m*kk] * B[jj+ldb*kk];
+			D[ii+m*jj] = alg==0 ? tmp : C[ii+m*jj] + alg*tmp;
+			}
+
+	}
+
+
+
+// D <= chol(C), with C m x n (m>=n), only the lower triangle is referenced
+static void ref_dpotrf(int m, int n, double *C, double *D, double *inv_diag_D)
+	{
+
+	int ii, jj, kk;
+
+	for(jj=0; jj<n; jj++)
+		for(ii=jj; ii<m; ii++)
+			D[ii+m*jj] = C[ii+m*jj];
+
+	for(jj=0; jj<n; jj++)
+		{
+		for(kk=0; kk<jj; kk++)
+			for(ii=jj; ii<m; ii++)
+				D[ii+m*jj] -= D[ii+m*kk] * D[jj+m*kk];
+		D[jj+m*jj] = sqrt(D[jj+m*jj]);
+		inv_diag_D[jj] = 1.0 / D[jj+m*jj];
+		for(ii=jj+1; ii<m; ii++)
+			D[ii+m*jj] *= inv_diag_D[jj];
+		}
+
+	}
+
+
+
+// max abs difference on the lower triangle (lower==1) or on the whole m x n matrix
+static double max_diff(int m, int n, int lower, double *A, double *B)
+	{
+
+	int ii, jj;
+	double tmp;
+	double diff = 0.0;
+
+	for(jj=0; jj<n; jj++)
+		for(ii=lower ? jj : 0; ii<m; ii++)
+			{
+			tmp = fabs(A[ii+m*jj] - B[ii+m*jj]);
+			diff = tmp>diff ? tmp : diff;
+			}
+
+	return diff;
+
+	}
+
+
+
+int main()
+	{
+
+	printf("\n");
+	printf("\n");
+	printf("\n");
+	printf(" HPMPC -- Library for High-Performance implementation of solvers for MPC.\n");
+	printf(" Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.\n");
+	printf("\n");
+	printf(" HPMPC is distributed in the hope that it will be useful,\n");
+	printf(" but WITHOUT ANY WARRANTY; without even the implied warranty of\n");
+	printf(" MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.\n");
+	printf(" See the GNU Lesser General Public License for more details.\n");
+	printf("\n");
+	printf("\n");
+	printf("\n");
+
+	printf("BLAS accuracy test on edge sizes - double precision\n");
+	printf("\n");
+
+#if defined(TARGET_X64_AVX512)
+	printf("Testing AVX-512 kernels (8x8 blocks, AVX2 kernels on the edges) against plain C99 loops\n");
+#else
+	printf("Testing the kernels of this target against plain C99 loops (build with TARGET=X64_AVX512 for the AVX-512 kernels)\n");
+#endif
+	printf("\n");
+
+	const int bs = D_MR;
+	const int ncl = D_NCL;
+
+	// sizes around the 4-row panels and the 8x8 blocks
+	int nn[] = {1, 2, 3, 4, 5, 7, 8, 9, 11, 12, 13, 15, 16, 17, 20, 23, 24, 25, 31, 32, 33};
+	int n_size = sizeof(nn)/sizeof(int);
+
+	int ii, jj, i_m, i_n, i_k, alg;
+	int m, n, k, pm, pn, cn, ck;
+
+	double tol = 1e-10;
+	double diff;
+	double err_gemm = 0.0;
+	double err_syrk = 0.0;
+	double err_potrf = 0.0;
+	double err_syrk_potrf = 0.0;
+	int n_fail = 0;
+
+	for(i_m=0; i_m<n_size; i_m++)
+		for(i_n=0; i_n<n_size; i_n++)
+			for(i_k=0; i_k<n_size; i_k++)
+				{
+
+				m = nn[i_m];
+				n = nn[i_n];
+				k = nn[i_k];
+
+				pm = (m+bs-1)/bs*bs;
+				pn = (n+bs-1)/bs*bs;
+				cn = (n+ncl-1)/ncl*ncl;
+				ck = (k+ncl-1)/ncl*ncl;
+
+				double *A; d_zeros(&A, m, k);
+				double *B; d_zeros(&B, n, k);
+				double *C; d_zeros(&C, m, n);
+				double *D; d_zeros(&D, m, n);
+				double *D_ref; d_zeros(&D_ref, m, n);
+				double *inv_diag; d_zeros(&inv_diag, n, 1);
+				double *inv_diag_ref; d_zeros(&inv_diag_ref, n, 1);
+
+				double *pA; d_zeros_align(&pA, pm, ck);
+				double *pB; d_zeros_align(&pB, pn, ck);
+				double *pBA; d_zeros_align(&pBA, pm, ck);
+				double *pC; d_zeros_align(&pC, pm, cn);
+				double *pD; d_zeros_align(&pD, pm, cn);
+
+				for(ii=0; ii<m*k; ii++)
+					A[ii] = ((ii*7)%13 - 6) / 6.0;
+				for(ii=0; ii<n*k; ii++)
+					B[ii] = ((ii*5)%11 - 5) / 5.0;
+				for(jj=0; jj<n; jj++)
+					for(ii=0; ii<m; ii++)
+						C[ii+m*jj] = ((ii+2*jj)%7 - 3) / 3.0;
+
+				d_cvt_mat2pmat(m, k, A, m, 0, pA, ck);
+				d_cvt_mat2pmat(n, k, B, n, 0, pB, ck);
+
+				// dgemm_nt
+				for(alg=-1; alg<=1; alg++)
+					{
+					d_cvt_mat2pmat(m, n, C, m, 0, pC, cn);
+					dgemm_nt_lib(m, n, k, pA, ck, pB, ck, alg, pC, cn, pD, cn, 0, 0);
+					d_cvt_pmat2mat(m, n, 0, pD, cn, D, m);
+					ref_dgemm_nt(m, n, k, A, B, n, alg, C, D_ref);
+					diff = max_diff(m, n, 0, D, D_ref);
+					err_gemm = diff>err_gemm ? diff : err_gemm;
+					if(diff>tol)
+						{
+						printf("dgemm_nt        m = %2d, n = %2d, k = %2d, alg = %2d: max |hpmpc - ref| = %e\n", m, n, k, alg, diff);
+						n_fail++;
+						}
+					}
+
+				if(m<n)
+					{
+					d_free(A);
+					d_free(B);
+					d_free(C);
+					d_free(D);
+					d_free(D_ref);
+					d_free(inv_diag);
+					d_free(inv_diag_ref);
+					d_free_align(pA);
+					d_free_align(pB);
+					d_free_align(pBA);
+					d_free_align(pC);
+					d_free_align(pD);
+					continue;
+					}
+
+				// dsyrk_nt (lower triangle)
+				for(alg=-1; alg<=1; alg+=2)
+					{
+					d_cvt_mat2pmat(m, n, C, m, 0, pC, cn);
+					dsyrk_nt_lib(m, n, k, pA, ck, pA, ck, alg, pC, cn, pD, cn);
+					d_cvt_pmat2mat(m, n, 0, pD, cn, D, m);
+					ref_dgemm_nt(m, n, k, A, A, m, alg, C, D_ref); // B = first n rows of A
+					diff = max_diff(m, n, 1, D, D_ref);
+					err_syrk = diff>err_syrk ? diff : err_syrk;
+					if(diff>tol)
+						{
+						printf("dsyrk_nt        m = %2d, n = %2d, k = %2d, alg = %2d: max |hpmpc - ref| = %e\n", m, n, k, alg, diff);
+						n_fail++;
+						}
+					}
+
+				// symmetric positive definite C (strictly diagonally dominant)
+				for(jj=0; jj<n; jj++)
+					C[jj+m*jj] = m + k + 1.0;
+				d_cvt_mat2pmat(m, n, C, m, 0, pC, cn);
+
+				// dpotrf (dtrsm on the rows below n)
+				dpotrf_lib(m, n, pC, cn, pD, cn, inv_diag);
+				d_cvt_pmat2mat(m, n, 0, pD, cn, D, m);
+				ref_dpotrf(m, n, C, D_ref, inv_diag_ref);
+				diff = max_diff(m, n, 1, D, D_ref);
+				if(max_diff(n, 1, 0, inv_diag, inv_diag_ref)>diff)
+					diff = max_diff(n, 1, 0, inv_diag, inv_diag_ref);
+				err_potrf = diff>err_potrf ? diff : err_potrf;
+				if(diff>tol)
+					{
+					printf("dpotrf          m = %2d, n = %2d:         max |hpmpc - ref| = %e\n", m, n, diff);
+					n_fail++;
+					}
+
+				// dsyrk_dpotrf: chol(C + A * A') with A scaled to keep C + A * A' definite
+				for(ii=0; ii<m*k; ii++)
+					A[ii] *= 0.1;
+				d_cvt_mat2pmat(m, k, A, m, 0, pBA, ck);
+				dsyrk_dpotrf_lib(m, n, k, pBA, ck, pBA, ck, 1, pC, cn, pD, cn, inv_diag);
+				d_cvt_pmat2mat(m, n, 0, pD, cn, D, m);
+				ref_dgemm_nt(m, n, k, A, A, m, 1, C, D_ref);
+				for(jj=0; jj<n; jj++)
+					for(ii=jj; ii<m; ii++)
+						C[ii+m*jj] = D_ref[ii+m*jj];
+				ref_dpotrf(m, n, C, D_ref, inv_diag_ref);
+				diff = max_diff(m, n, 1, D, D_ref);
+				if(max_diff(n, 1, 0, inv_diag, inv_diag_ref)>diff)
+					diff = max_diff(n, 1, 0, inv_diag, inv_diag_ref);
+				err_syrk_potrf = diff>err_syrk_potrf ? diff : err_syrk_potrf;
+				if(diff>tol)
+					{
+					printf("dsyrk_dpotrf    m = %2d, n = %2d, k = %2d:          max |hpmpc - ref| = %e\n", m, n, k, diff);
+					n_fail++;
+					}
+
+				d_free(A);
+				d_free(B);
+				d_free(C);
+				d_free(D);
+				d_free(D_ref);
+				d_free(inv_diag);
+				d_free(inv_diag_ref);
+				d_free_align(pA);
+				d_free_align(pB);
+				d_free_align(pBA);
+				d_free_align(pC);
+				d_free_align(pD);
+
+				}
+
+	printf("max |hpmpc - ref| over all sizes:\n");
+	printf("dgemm_nt     %e\n", err_gemm);
+	printf("dsyrk_nt     %e\n", err_syrk);
+	printf("dpotrf       %e\n", err_potrf);
+	printf("dsyrk_dpotrf %e\n", err_syrk_potrf);
+	printf("\n%d failures (tolerance %e)\n\n", n_fail, tol);
+
+	return n_fail;
+
+	}
@@ -238,7 +238,10 @@ int main()
 	printf("\n");
 
 	// maximum flops per cycle, double precision
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX512)
+	const float flops_max = 32;
+	printf("Testing BLAS version for AVX-512 & FMA3 instruction sets, 64 bit: theoretical peak %5.1f Gflops\n", flops_max*GHz_max);
+#elif defined(TARGET_X64_AVX2)
 	const float flops_max = 16;
 	printf("Testing BLAS version for AVX2 & FMA3 instruction sets, 64 bit: theoretical peak %5.1f Gflops\n", flops_max*GHz_max);
 #elif defined(TARGET_X64_AVX)
@@ -276,7 +279,10 @@ int main()
 	FILE *f;
 	f = fopen("./test_problems/results/test_blas.m", "w"); // a
 
-#if defined(TARGET_X64_AVX2)
+#if defined(TARGET_X64_AVX512)
+	fprintf(f, "C = 'd_x64_avx512';\n");
+	fprintf(f, "\n");
+#elif defined(TARGET_X64_AVX2)
 	fprintf(f, "C = 'd_x64_avx2';\n");
 	fprintf(f, "\n");
 #elif defined(TARGET_X64_AVX)
@@ -0,0 +1,506 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <sys/time.h>
+#if defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
+#include <xmmintrin.h> // needed to flush to zero sub-normals with _MM_SET_FLUSH_ZERO_MODE (_MM_FLUSH_ZERO_ON); in the main()
+#endif
+
+#ifdef BLASFEO
+#include <blasfeo_target.h>
+#include <blasfeo_common.h>
+#include <blasfeo_v_aux_ext_dep.h>
+#include <blasfeo_d_aux_ext_dep.h>
+#include <blasfeo_i_aux_ext_dep.h>
+#include <blasfeo_d_aux.h>
+#include <blasfeo_d_blas.h>
+#endif
+
+#include "../include/lqcp_solvers.h"
+#include "../include/mpc_solvers.h"
+#include "tools.h"
+
+
+// printing
+#define PRINT 0
+
+/************************************************ 
+Mass-spring system: nx/2 masses connected each other with springs (in a row), and the first and the last one to walls. nu (<=nx) controls act on the first nu masses. The system is sampled with sampling time Ts. 
+************************************************/
+void mass_spring_system(double Ts, int nx, int nu, int N, double *A, double *B, double *b, double *x0)
+	{
+
+	int nx2 = nx*nx;
+
+	int info = 0;
+
+	int pp = nx/2; // number of masses
+	
+/************************************************
+* build the continuous time system 
+************************************************/
+	
+	double *T; d_zeros(&T, pp, pp);
+	int ii;
+	for(ii=0; ii<pp; ii++) T[ii*(pp+1)] = -2;
+	for(ii=0; ii<pp-1; ii++) T[ii*(pp+1)+1] = 1;
+	for(ii=1; ii<pp; ii++) T[ii*(pp+1)-1] = 1;
+
+	double *Z; d_zeros(&Z, pp, pp);
+	double *I; d_zeros(&I, pp, pp); for(ii=0; ii<pp; ii++) I[ii*(pp+1)]=1.0; // = eye(pp);
+	double *Ac; d_zeros(&Ac, nx, nx);
+	dmcopy(pp, pp, Z, pp, Ac, nx);
+	dmcopy(pp, pp, T, pp, Ac+pp, nx);
+	dmcopy(pp, pp, I, pp, Ac+pp*nx, nx);
+	dmcopy(pp, pp, Z, pp, Ac+pp*(nx+1), nx); 
+	free(T);
+	free(Z);
+	free(I);
+	
+	d_zeros(&I, nu, nu); for(ii=0; ii<nu; ii++) I[ii*(nu+1)]=1.0; //I = eye(nu);
+	double *Bc; d_zeros(&Bc, nx, nu);
+	dmcopy(nu, nu, I, nu, Bc+pp, nx);
+	free(I);
+	
+/************************************************
+* compute the discrete time system 
+************************************************/
+
+	double *bb; d_zeros(&bb, nx, 1);
+	dmcopy(nx, 1, bb, nx, b, nx);
+		
+	dmcopy(nx, nx, Ac, nx, A, nx);
+	dscal_3l(nx2, Ts, A);
+	expm(nx, A);
+	
+	d_zeros(&T, nx, nx);
+	d_zeros(&I, nx, nx); for(ii=0; ii<nx; ii++) I[ii*(nx+1)]=1.0; //I = eye(nx);
+	dmcopy(nx, nx, A, nx, T, nx);
+	daxpy_3l(nx2, -1.0, I, T);
+	dgemm_nn_3l(nx, nu, nx, T, nx, Bc, nx, B, nx);
+	free(T);
+	free(I);
+	
+	int *ipiv = (int *) malloc(nx*sizeof(int));
+	dgesv_3l(nx, nu, Ac, nx, ipiv, B, nx, &info);
+	free(ipiv);
+
+	free(Ac);
+	free(Bc);
+	free(bb);
+	
+			
+/************************************************
+* initial state 
+************************************************/
+	
+	if(nx==4)
+		{
+		x0[0] = 5;
+		x0[1] = 10;
+		x0[2] = 15;
+		x0[3] = 20;
+		}
+	else
+		{
+		int jj;
+		for(jj=0; jj<nx; jj++)
+			x0[jj] = 1;
+		}
+
+	}
+
+
+
+int main()
+	{
+	
+	printf("\n");
+	printf("\n");
+	printf("\n");
+	printf(" HPMPC -- Library for High-Performance implementation of solvers for MPC.\n");
+	printf(" Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.\n");
+	printf("\n");
+	printf(" HPMPC is distributed in the hope that it will be useful,\n");
+	printf(" but WITHOUT ANY WARRANTY; without even the implied warranty of\n");
+	printf(" MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.\n");
+	printf(" See the GNU Lesser General Public License for more details.\n");
+	printf("\n");
+	printf("\n");
+	printf("\n");
+	
+#if defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
+	_MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON); // flush to zero subnormals !!! works only with one thread !!!
+#endif
+
+	int ii, jj;
+	
+	int rep;
+
+	int nx_ = 8; // number of states (it has to be even for the mass-spring system test problem)
+	int nu_ = 3; // number of inputs (controllers) (it has to be at least 1 and at most nx/2 for the mass-spring system test problem)
+	int N  = 10; // horizon lenght
+
+	// ADMM parameters
+	int k_max = 2000;
+	double tol_p = 1e-8;
+	double tol_d = 1e-8;
+	double rho = 1.0;
+	double alpha = 1.6; // over-relaxation
+
+	// IPM parameters, for the reference solution
+	int k_max_ipm = 50;
+	double mu0 = 2.0;
+	double mu_tol = 1e-14;
+	double alpha_min = 1e-8;
+
+	// number of calls to solver (for more accurate timings)
+	int nrep = 100;
+
+	// stage-wise variant size
+	int nx[N+1];
+	nx[0] = 0;
+	for(ii=1; ii<=N; ii++)
+		nx[ii] = nx_;
+
+	int nu[N+1];
+	for(ii=0; ii<N; ii++)
+		nu[ii] = nu_;
+	nu[N] = 0;
+
+	int ng[N+1];
+	for(ii=0; ii<=N; ii++)
+		ng[ii] = 0;
+
+	// hard problem: box constraints on inputs and states
+	int nb[N+1];
+	for(ii=0; ii<=N; ii++)
+		nb[ii] = nu[ii]+nx[ii];
+
+	// soft problem: hard box constraints on inputs, soft box constraints on states
+	int nbu[N+1];
+	int ns[N+1];
+	for(ii=0; ii<=N; ii++)
+		{
+		nbu[ii] = nu[ii];
+		ns[ii] = nx[ii];
+		}
+
+	printf(" Test problem: mass-spring system with %d masses and %d controls.\n", nx_/2, nu_);
+	printf("\n");
+	printf(" MPC problem size: %d states, %d inputs, %d horizon length, %d two-sided box constraints.\n", nx[1], nu[1], N, nb[1]);
+	printf("\n");
+	printf(" ADMM parameters: %d maximum iterations, %5.1e exit tolerance in primal and dual residuals, rho = %4.2f, alpha = %4.2f.\n", k_max, tol_p, rho, alpha);
+
+/************************************************
+* dynamical system
+************************************************/	
+
+	double *A; d_zeros(&A, nx_, nx_); // states update matrix
+
+	double *B; d_zeros(&B, nx_, nu_); // inputs matrix
+
+	double *b; d_zeros_align(&b, nx_, 1); // states offset
+	double *x0; d_zeros_align(&x0, nx_, 1); // initial state
+
+	double Ts = 0.5; // sampling time
+	mass_spring_system(Ts, nx_, nu_, N, A, B, b, x0);
+
+	for(jj=0; jj<nx_; jj++)
+		b[jj] = 0.1;
+
+	for(jj=0; jj<nx_; jj++)
+		x0[jj] = 0;
+	x0[0] = 2.5;
+	x0[1] = 2.5;
+
+	struct blasfeo_dmat sA;
+	blasfeo_allocate_dmat(nx_, nx_, &sA);
+	blasfeo_pack_dmat(nx_, nx_, A, nx_, &sA, 0, 0);
+
+	struct blasfeo_dvec sx0;
+	blasfeo_allocate_dvec(nx_, &sx0);
+	blasfeo_pack_dvec(nx_, x0, &sx0, 0);
+
+	// b0 = b + A*x0
+	struct blasfeo_dvec sb0;
+	blasfeo_allocate_dvec(nx_, &sb0);
+	blasfeo_pack_dvec(nx_, b, &sb0, 0);
+	blasfeo_dgemv_n(nx_, nx_, 1.0, &sA, 0, 0, &sx0, 0, 1.0, &sb0, 0, &sb0, 0);
+
+	struct blasfeo_dmat hsBAbt[N];
+	for(ii=0; ii<N; ii++)
+		{
+		blasfeo_allocate_dmat(nu[ii]+nx[ii]+1, nx[ii+1], &hsBAbt[ii]);
+		blasfeo_pack_tran_dmat(nx[ii+1], nu[ii], B, nx_, &hsBAbt[ii], 0, 0);
+		blasfeo_pack_tran_dmat(nx[ii+1], nx[ii], A, nx_, &hsBAbt[ii], nu[ii], 0);
+		if(ii==0)
+			blasfeo_drowin(nx[ii+1], 1.0, &sb0, 0, &hsBAbt[ii], nu[ii]+nx[ii], 0);
+		else
+			blasfeo_pack_tran_dmat(nx[ii+1], 1, b, nx_, &hsBAbt[ii], nu[ii]+nx[ii], 0);
+		}
+
+/************************************************
+* cost function
+************************************************/	
+	
+	double *Q; d_zeros(&Q, nx_, nx_);
+	for(ii=0; ii<nx_; ii++) Q[ii*(nx_+1)] = 1.0;
+
+	double *R; d_zeros(&R, nu_, nu_);
+	for(ii=0; ii<nu_; ii++) R[ii*(nu_+1)] = 2.0;
+
+	double *q; d_zeros(&q, nx_, 1);
+	for(ii=0; ii<nx_; ii++) q[ii] = 0.1;
+
+	double *r; d_zeros(&r, nu_, 1);
+	for(ii=0; ii<nu_; ii++) r[ii] = 0.2;
+
+	struct blasfeo_dmat hsRSQrq[N+1];
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_allocate_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], &hsRSQrq[ii]);
+		blasfeo_dgese(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], 0.0, &hsRSQrq[ii], 0, 0);
+		blasfeo_pack_dmat(nu[ii], nu[ii], R, nu_, &hsRSQrq[ii], 0, 0);
+		blasfeo_pack_dmat(nx[ii], nx[ii], Q, nx_, &hsRSQrq[ii], nu[ii], nu[ii]);
+		blasfeo_pack_tran_dmat(nu[ii], 1, r, nu_, &hsRSQrq[ii], nu[ii]+nx[ii], 0);
+		blasfeo_pack_tran_dmat(nx[ii], 1, q, nx_, &hsRSQrq[ii], nu[ii]+nx[ii], nu[ii]);
+		}
+
+	// penalty of the soft constraints violation: [lower | upper]
+	struct blasfeo_dvec hsZ[N+1];
+	struct blasfeo_dvec hsz[N+1];
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_allocate_dvec(2*ns[ii], &hsZ[ii]);
+		blasfeo_dvecse(2*ns[ii], 1.0, &hsZ[ii], 0);
+		blasfeo_allocate_dvec(2*ns[ii], &hsz[ii]);
+		blasfeo_dvecse(2*ns[ii], 1.0, &hsz[ii], 0);
+		}
+
+/************************************************
+* box constraints
+************************************************/	
+
+	// d = [lb | ub], idxb = identity: inputs first, then states
+	int *hidxb[N+1];
+	struct blasfeo_dvec hsd[N+1]; // hard problem
+	struct blasfeo_dvec hsd_s[N+1]; // soft problem
+	struct blasfeo_dmat hsDCt[N+1]; // no general constraints
+	for(ii=0; ii<=N; ii++)
+		{
+		int_zeros(&hidxb[ii], nb[ii], 1);
+		for(jj=0; jj<nb[ii]; jj++)
+			hidxb[ii][jj] = jj;
+		blasfeo_allocate_dvec(2*nb[ii], &hsd[ii]);
+		blasfeo_dvecse(nu[ii], -0.5, &hsd[ii], 0); // umin
+		blasfeo_dvecse(nx[ii], -4.0, &hsd[ii], nu[ii]); // xmin
+		blasfeo_dvecse(nu[ii], 0.5, &hsd[ii], nb[ii]); // umax
+		blasfeo_dvecse(nx[ii], 4.0, &hsd[ii], nb[ii]+nu[ii]); // xmax
+		blasfeo_allocate_dvec(2*nb[ii], &hsd_s[ii]);
+		blasfeo_dvecse(nu[ii], -0.5, &hsd_s[ii], 0); // umin
+		blasfeo_dvecse(nx[ii], -0.5, &hsd_s[ii], nu[ii]); // soft xmin
+		blasfeo_dvecse(nu[ii], 0.5, &hsd_s[ii], nb[ii]); // umax
+		blasfeo_dvecse(nx[ii], 0.5, &hsd_s[ii], nb[ii]+nu[ii]); // soft xmax
+		blasfeo_allocate_dmat(nu[ii]+nx[ii], ng[ii], &hsDCt[ii]);
+		}
+
+/************************************************
+* solution vectors
+************************************************/	
+
+	struct blasfeo_dvec hsux_ipm[N+1];
+	struct blasfeo_dvec hspi_ipm[N+1];
+	struct blasfeo_dvec hslam_ipm[N+1];
+	struct blasfeo_dvec hst_ipm[N+1];
+	struct blasfeo_dvec hsux[N+1];
+	struct blasfeo_dvec hspi[N+1];
+	struct blasfeo_dvec hslam[N+1];
+	struct blasfeo_dvec hsv[N+1];
+	struct blasfeo_dvec hsw[N+1];
+	struct blasfeo_dvec hse[N+1];
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_allocate_dvec(nu[ii]+nx[ii], &hsux_ipm[ii]);
+		blasfeo_allocate_dvec(nx[ii], &hspi_ipm[ii]);
+		blasfeo_allocate_dvec(2*nb[ii]+2*ns[ii], &hslam_ipm[ii]);
+		blasfeo_allocate_dvec(2*nb[ii]+2*ns[ii], &hst_ipm[ii]);
+		blasfeo_allocate_dvec(nu[ii]+nx[ii], &hsux[ii]);
+		blasfeo_allocate_dvec(nx[ii], &hspi[ii]);
+		blasfeo_allocate_dvec(2*nb[ii], &hslam[ii]);
+		blasfeo_allocate_dvec(nb[ii], &hsv[ii]);
+		blasfeo_allocate_dvec(nb[ii], &hsw[ii]);
+		blasfeo_allocate_dvec(nu[ii]+nx[ii], &hse[ii]);
+		}
+
+	int kk, kk_ipm;
+	int hpmpc_exit;
+	double stat[5*k_max];
+	double err, err_max;
+
+	struct timeval tv0, tv1;
+
+/************************************************
+* hard problem: reference solution (IPM)
+************************************************/	
+
+	void *work_ipm;
+	v_zeros_align(&work_ipm, d_ip2_res_mpc_hard_work_space_size_bytes_libstr(N, nx, nu, nb, ng));
+
+	hpmpc_exit = d_ip2_res_mpc_hard_libstr(&kk_ipm, k_max_ipm, mu0, mu_tol, alpha_min, 0, stat, N, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsd, hsux_ipm, 1, hspi_ipm, hslam_ipm, hst_ipm, work_ipm);
+
+	printf("\nhard problem, IPM: exit flag %d, %d iterations\n", hpmpc_exit, kk_ipm);
+
+/************************************************
+* hard problem: ADMM
+************************************************/	
+
+	void *work_admm;
+	v_zeros_align(&work_admm, d_admm_mpc_soft_work_space_size_bytes_libstr(N, nx, nu, nbu, ns));
+
+	// ADMM from cold start, with factorization
+	hpmpc_exit = d_admm_mpc_hard_libstr(&kk, k_max, tol_p, tol_d, 0, 1, &rho, alpha, stat, N, nx, nu, nb, hidxb, hsBAbt, hsRSQrq, hsd, hsux, hsv, hsw, 1, hspi, hslam, work_admm);
+
+	err_max = 0.0;
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_daxpy(nu[ii]+nx[ii], -1.0, &hsux_ipm[ii], 0, &hsux[ii], 0, &hse[ii], 0);
+		blasfeo_dvecnrm_inf(nu[ii]+nx[ii], &hse[ii], 0, &err);
+		err_max = err>err_max ? err : err_max;
+		}
+
+	printf("\nhard problem, ADMM: exit flag %d, %d iterations, final rho = %e, max |ux_admm - ux_ipm| = %e\n", hpmpc_exit, kk, rho, err_max);
+
+#if PRINT
+	printf("\nux =\n\n");
+	for(ii=0; ii<=N; ii++)
+		blasfeo_print_tran_dvec(nu[ii]+nx[ii], &hsux[ii], 0);
+#endif
+
+	// warm start with the factorization of the previous call (the data is unchanged)
+	gettimeofday(&tv0, NULL); // start
+
+	for(rep=0; rep<nrep; rep++)
+		{
+
+		hpmpc_exit = d_admm_mpc_hard_libstr(&kk, k_max, tol_p, tol_d, 1, 0, &rho, alpha, stat, N, nx, nu, nb, hidxb, hsBAbt, hsRSQrq, hsd, hsux, hsv, hsw, 1, hspi, hslam, work_admm);
+
+		}
+
+	gettimeofday(&tv1, NULL); // stop
+
+	double time_admm = (tv1.tv_sec-tv0.tv_sec)/(nrep+0.0)+(tv1.tv_usec-tv0.tv_usec)/(nrep*1e6);
+
+	printf("\nhard problem, ADMM warm start without factorization: exit flag %d, %d iterations\n", hpmpc_exit, kk);
+
+	printf("\n Average solution time over %d runs: %5.2e seconds (ADMM, warm start)\n\n", nrep, time_admm);
+
+	v_free_align(work_ipm);
+
+/************************************************
+* soft problem: reference solution (IPM)
+************************************************/	
+
+	// the soft problem reuses idxb: inputs are the nbu hard constraints, states the ns soft ones
+	v_zeros_align(&work_ipm, d_ip2_res_mpc_soft_work_space_size_bytes_libstr(N, nx, nu, nbu, ng, ns));
+
+	hpmpc_exit = d_ip2_res_mpc_soft_libstr(&kk_ipm, k_max_ipm, mu0, mu_tol, alpha_min, 0, stat, N, nx, nu, nbu, hidxb, ng, ns, hsBAbt, hsRSQrq, hsZ, hsz, hsDCt, hsd_s, hsux_ipm, 1, hspi_ipm, hslam_ipm, hst_ipm, work_ipm);
+
+	printf("\nsoft problem, IPM: exit flag %d, %d iterations\n", hpmpc_exit, kk_ipm);
+
+/************************************************
+* soft problem: ADMM
+************************************************/	
+
+	rho = 1.0;
+
+	hpmpc_exit = d_admm_mpc_soft_libstr(&kk, k_max, tol_p, tol_d, 0, 1, &rho, alpha, stat, N, nx, nu, nbu, hidxb, ns, hsBAbt, hsRSQrq, hsZ, hsz, hsd_s, hsux, hsv, hsw, 1, hspi, hslam, work_admm);
+
+	err_max = 0.0;
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_daxpy(nu[ii]+nx[ii], -1.0, &hsux_ipm[ii], 0, &hsux[ii], 0, &hse[ii], 0);
+		blasfeo_dvecnrm_inf(nu[ii]+nx[ii], &hse[ii], 0, &err);
+		err_max = err>err_max ? err : err_max;
+		}
+
+	printf("\nsoft problem, ADMM: exit flag %d, %d iterations, final rho = %e, max |ux_admm - ux_ipm| = %e\n", hpmpc_exit, kk, rho, err_max);
+
+#if PRINT
+	printf("\nux =\n\n");
+	for(ii=0; ii<=N; ii++)
+		blasfeo_print_tran_dvec(nu[ii]+nx[ii], &hsux[ii], 0);
+#endif
+
+/************************************************
+* free memory
+************************************************/	
+
+	d_free(A);
+	d_free(B);
+	d_free_align(b);
+	d_free_align(x0);
+	d_free(Q);
+	d_free(R);
+	d_free(q);
+	d_free(r);
+
+	blasfeo_free_dmat(&sA);
+	blasfeo_free_dvec(&sx0);
+	blasfeo_free_dvec(&sb0);
+	for(ii=0; ii<N; ii++)
+		blasfeo_free_dmat(&hsBAbt[ii]);
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_free_dmat(&hsRSQrq[ii]);
+		blasfeo_free_dvec(&hsZ[ii]);
+		blasfeo_free_dvec(&hsz[ii]);
+		int_free(hidxb[ii]);
+		blasfeo_free_dvec(&hsd[ii]);
+		blasfeo_free_dvec(&hsd_s[ii]);
+		blasfeo_free_dmat(&hsDCt[ii]);
+		blasfeo_free_dvec(&hsux_ipm[ii]);
+		blasfeo_free_dvec(&hspi_ipm[ii]);
+		blasfeo_free_dvec(&hslam_ipm[ii]);
+		blasfeo_free_dvec(&hst_ipm[ii]);
+		blasfeo_free_dvec(&hsux[ii]);
+		blasfeo_free_dvec(&hspi[ii]);
+		blasfeo_free_dvec(&hslam[ii]);
+		blasfeo_free_dvec(&hsv[ii]);
+		blasfeo_free_dvec(&hsw[ii]);
+		blasfeo_free_dvec(&hse[ii]);
+		}
+	v_free_align(work_ipm);
+	v_free_align(work_admm);
+
+/************************************************
+* return
+************************************************/	
+
+	return 0;
+	}
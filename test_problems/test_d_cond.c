@@ -27,7 +27,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <sys/time.h>
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
+#if defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
 #include <xmmintrin.h> // needed to flush to zero sub-normals with _MM_SET_FLUSH_ZERO_MODE (_MM_FLUSH_ZERO_ON); in the main()
 #endif
 
@@ -142,6 +142,276 @@ void mass_spring_system(double Ts, int nx, int nu, int N, double *A, double *B,
 
 
 
+// max abs difference between two vectors
+static double max_diff_vec(int m, double *x, double *y)
+	{
+
+	int ii;
+	double tmp;
+	double diff = 0.0;
+
+	for(ii=0; ii<m; ii++)
+		{
+		tmp = fabs(x[ii] - y[ii]);
+		diff = tmp>diff ? tmp : diff;
+		}
+
+	return diff;
+
+	}
+
+
+
+// solve an OCP with boxes on inputs and positions and general constraints on every stage,
+// without condensing (N2 = N) and with partial condensing to N2 = 7 and 1 (full condensing),
+// and check that the condensed solutions match the uncondensed one; returns the number of failures
+static int test_cond_general_constraints(int N, int nx_, int nu_)
+	{
+
+	int ii, jj, ll;
+
+	int ng_ = 2;
+
+	// problem size
+	int nx[N+1];
+	int nu[N+1];
+	int nb[N+1];
+	int ng[N+1];
+	int *hidxb[N+1];
+	nx[0] = 0;
+	for(ii=1; ii<=N; ii++)
+		nx[ii] = nx_;
+	for(ii=0; ii<N; ii++)
+		nu[ii] = nu_;
+	nu[N] = 0;
+	for(ii=0; ii<=N; ii++)
+		{
+		nb[ii] = nu[ii] + nx[ii]/2;
+		ng[ii] = ng_;
+		int_zeros(&hidxb[ii], nb[ii], 1);
+		for(jj=0; jj<nb[ii]; jj++)
+			hidxb[ii][jj] = jj;
+		}
+
+	// dynamical system
+	double *A; d_zeros(&A, nx_, nx_);
+	double *B; d_zeros(&B, nx_, nu_);
+	double *b; d_zeros(&b, nx_, 1);
+	double *x0; d_zeros(&x0, nx_, 1);
+	mass_spring_system(0.5, nx_, nu_, N, A, B, b, x0);
+	for(jj=0; jj<nx_; jj++)
+		b[jj] = 0.1;
+
+	double *b0; d_zeros(&b0, nx_, 1);
+	for(ii=0; ii<nx_; ii++)
+		{
+		b0[ii] = b[ii];
+		for(jj=0; jj<nx_; jj++)
+			b0[ii] += A[ii+nx_*jj]*x0[jj];
+		}
+
+	// cost function
+	double *Q; d_zeros(&Q, nx_, nx_);
+	for(ii=0; ii<nx_; ii++) Q[ii*(nx_+1)] = 1.0;
+	double *S; d_zeros(&S, nu_, nx_);
+	double *R; d_zeros(&R, nu_, nu_);
+	for(ii=0; ii<nu_; ii++) R[ii*(nu_+1)] = 2.0;
+	double *q; d_zeros(&q, nx_, 1);
+	for(ii=0; ii<nx_; ii++) q[ii] = 0.1;
+	double *r; d_zeros(&r, nu_, 1);
+	for(ii=0; ii<nu_; ii++) r[ii] = 0.2;
+
+	// box constraints: inputs, then positions (the final stage has only the positions)
+	double *lb; d_zeros(&lb, nu_+nx_/2, 1);
+	double *ub; d_zeros(&ub, nu_+nx_/2, 1);
+	for(ii=0; ii<nu_; ii++)
+		{
+		lb[ii] = - 1.0;
+		ub[ii] = + 1.0;
+		}
+	for(; ii<nu_+nx_/2; ii++)
+		{
+		lb[ii] = - 2.2;
+		ub[ii] = + 2.2;
+		}
+
+	// general constraints: sum of the inputs plus first position, sum of the velocities
+	double *C; d_zeros(&C, ng_, nx_);
+	double *D; d_zeros(&D, ng_, nu_);
+	for(jj=0; jj<nu_; jj++)
+		D[0+ng_*jj] = 1.0;
+	C[0+ng_*0] = 1.0;
+	for(jj=nx_/2; jj<nx_; jj++)
+		C[1+ng_*jj] = 1.0;
+	double *lg; d_zeros(&lg, ng_, 1);
+	double *ug; d_zeros(&ug, ng_, 1);
+	lg[0] = - 0.4;
+	ug[0] = + 100.0;
+	lg[1] = - 1.5;
+	ug[1] = + 3.0;
+
+	double *hA[N];
+	double *hB[N];
+	double *hb[N];
+	double *hQ[N+1];
+	double *hS[N];
+	double *hR[N];
+	double *hq[N+1];
+	double *hr[N];
+	double *hlb[N+1];
+	double *hub[N+1];
+	double *hC[N+1];
+	double *hD[N];
+	double *hlg[N+1];
+	double *hug[N+1];
+	for(ii=0; ii<N; ii++)
+		{
+		hA[ii] = A;
+		hB[ii] = B;
+		hb[ii] = ii==0 ? b0 : b;
+		hS[ii] = S;
+		hR[ii] = R;
+		hr[ii] = r;
+		hD[ii] = D;
+		}
+	for(ii=0; ii<=N; ii++)
+		{
+		hQ[ii] = Q;
+		hq[ii] = q;
+		hlb[ii] = ii<N ? lb : lb+nu_;
+		hub[ii] = ii<N ? ub : ub+nu_;
+		hC[ii] = C;
+		hlg[ii] = lg;
+		hug[ii] = ug;
+		}
+
+	// solution, reference (uncondensed) and (partially) condensed
+	double *hx[2][N+1];
+	double *hu[2][N];
+	double *hpi[2][N];
+	double *hlam[2][N+1];
+	for(ll=0; ll<2; ll++)
+		{
+		for(ii=0; ii<N; ii++)
+			{
+			d_zeros(&hu[ll][ii], nu[ii], 1);
+			d_zeros(&hpi[ll][ii], nx[ii+1], 1);
+			}
+		for(ii=0; ii<=N; ii++)
+			{
+			d_zeros(&hx[ll][ii], nx[ii], 1);
+			d_zeros(&hlam[ll][ii], 2*nb[ii]+2*ng[ii], 1);
+			}
+		}
+
+	int kk = -1;
+	int k_max = 50;
+	double mu0 = 2.0;
+	double mu_tol = 1e-14;
+	double *stat; d_zeros(&stat, k_max, 5);
+	double inf_norm_res[5];
+	void *work;
+
+	// the IPMs stop at slightly different iterates close to mu_tol
+	int N2_v[3] = {N, 7, 1};
+	double tol_v[3] = {0.0, 1e-10, 1e-10};
+
+	int hpmpc_status, n_act, sol;
+	int n_fail = 0;
+	double diff, tmp;
+
+	printf("\ngeneral constraints and boxes on the states, N = %d\n", N);
+
+	for(ll=0; ll<3; ll++)
+		{
+
+		v_zeros_align(&work, hpmpc_d_ip_ocp_hard_tv_work_space_size_bytes(N, nx, nu, nb, hidxb, ng, N2_v[ll]));
+
+		sol = ll==0 ? 0 : 1;
+		hpmpc_status = fortran_order_d_ip_ocp_hard_tv(&kk, k_max, mu0, mu_tol, N, nx, nu, nb, hidxb, ng, N2_v[ll], 0, hA, hB, hb, hQ, hS, hR, hq, hr, hlb, hub, hC, hD, hlg, hug, hx[sol], hu[sol], hpi[sol], hlam[sol], inf_norm_res, work, stat);
+
+		v_free_align(work);
+
+		// active boxes on the states and general constraints, to make sure the test is not trivial
+		n_act = 0;
+		for(ii=0; ii<=N; ii++)
+			{
+			for(jj=nu[ii]; jj<nb[ii]; jj++)
+				if(hlam[sol][ii][jj]>1e-6 || hlam[sol][ii][nb[ii]+jj]>1e-6)
+					n_act++;
+			for(jj=0; jj<ng[ii]; jj++)
+				if(hlam[sol][ii][2*nb[ii]+jj]>1e-6 || hlam[sol][ii][2*nb[ii]+ng[ii]+jj]>1e-6)
+					n_act++;
+			}
+
+		diff = 0.0;
+		if(ll>0)
+			{
+			for(ii=0; ii<N; ii++)
+				{
+				tmp = max_diff_vec(nu[ii], hu[1][ii], hu[0][ii]);
+				diff = tmp>diff ? tmp : diff;
+				tmp = max_diff_vec(nx[ii+1], hpi[1][ii], hpi[0][ii]);
+				diff = tmp>diff ? tmp : diff;
+				}
+			for(ii=0; ii<=N; ii++)
+				{
+				tmp = max_diff_vec(nx[ii], hx[1][ii], hx[0][ii]);
+				diff = tmp>diff ? tmp : diff;
+				tmp = max_diff_vec(2*nb[ii]+2*ng[ii], hlam[1][ii], hlam[0][ii]);
+				diff = tmp>diff ? tmp : diff;
+				}
+			}
+
+		printf("N2 = %2d: status %d, %2d iterations, %3d active constraints, max |cond - full| = %e\n", N2_v[ll], hpmpc_status, kk, n_act, diff);
+
+		if(hpmpc_status!=0 || n_act==0 || diff>tol_v[ll])
+			n_fail++;
+
+		}
+
+	printf("\n");
+
+	// free memory
+	for(ll=0; ll<2; ll++)
+		{
+		for(ii=0; ii<N; ii++)
+			{
+			d_free(hu[ll][ii]);
+			d_free(hpi[ll][ii]);
+			}
+		for(ii=0; ii<=N; ii++)
+			{
+			d_free(hx[ll][ii]);
+			d_free(hlam[ll][ii]);
+			}
+		}
+	for(ii=0; ii<=N; ii++)
+		int_free(hidxb[ii]);
+	d_free(A);
+	d_free(B);
+	d_free(b);
+	d_free(x0);
+	d_free(b0);
+	d_free(Q);
+	d_free(S);
+	d_free(R);
+	d_free(q);
+	d_free(r);
+	d_free(lb);
+	d_free(ub);
+	d_free(C);
+	d_free(D);
+	d_free(lg);
+	d_free(ug);
+	d_free(stat);
+
+	return n_fail;
+
+	}
+
+
+
 int main()
 	{
 	
@@ -159,7 +429,7 @@ int main()
 	printf("\n");
 	printf("\n");
 	
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
+#if defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
 	_MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON); // flush to zero subnormals !!! works only with one thread !!!
 #endif
 
@@ -410,7 +680,7 @@ int main()
 
 #if MHE!=1
 	double *d0; d_zeros_align(&d0, 2*pnb_v[0], 1);
-	int *idxb0; i_zeros(&idxb0, nb_v[0], 1);
+	int *idxb0; int_zeros(&idxb0, nb_v[0], 1);
 	// inputs
 	for(ii=0; ii<nu_v[0]; ii++)
 		{
@@ -432,7 +702,7 @@ int main()
 	if(N>1)
 		{
 		d_zeros_align(&d1, 2*pnb_v[1], 1);
-		i_zeros(&idxb1, nb_v[1], 1);
+		int_zeros(&idxb1, nb_v[1], 1);
 		// inputs
 		for(ii=0; ii<nu_v[1]; ii++)
 			{
@@ -450,7 +720,7 @@ int main()
 		}
 
 	double *dN; d_zeros_align(&dN, 2*pnb_v[N], 1);
-	int *idxbN; i_zeros(&idxbN, nb_v[N], 1);
+	int *idxbN; int_zeros(&idxbN, nb_v[N], 1);
 	// no inputs
 	// states
 	for(ii=0 ; ii<nb_v[N]; ii++)
@@ -530,7 +800,7 @@ int main()
 
 	d_zeros_align(&pDCt2, pnz2, cnbg);
 	d_zeros_align(&d2, 2*pnbb+2*pnbg, 1);
-	i_zeros(&idxb2, nbb, 1);
+	int_zeros(&idxb2, nbb, 1);
 
 
 	d_zeros_align(&work0, pnxM*cnxM+pnz2*cnxM, 1);
@@ -657,28 +927,44 @@ int main()
 	for(ii=0; ii<N; ii++)
 		{
 		nu_tmp += nu_v[ii];
+#ifdef BLASFEO
 		d_print_pmat(nx_v[0]+1+nu_tmp, nx_v[ii+1], hpGamma[ii], cnx_v[ii+1]);
+#else
+		d_print_pmat(nx_v[0]+1+nu_tmp, nx_v[ii+1], bs, hpGamma[ii], cnx_v[ii+1]);
+#endif
 		}
 	
 	printf("\nBAbt2\n\n");
+#ifdef BLASFEO
 	d_print_pmat(nu2+nx_v[0]+1, nx_v[N], pBAbt2, cnx_v[N]);
+#else
+	d_print_pmat(nu2+nx_v[0]+1, nx_v[N], bs, pBAbt2, cnx_v[N]);
+#endif
 
 
 	d_cond_RSQrq(N, nx_v, nu_v, hpBAbt, hpRSQrq, hpGamma, work1, pRSQrq2);
 
 	printf("\nRSQrq2\n\n");
+#ifdef BLASFEO
 	d_print_pmat(nu2+nx_v[0]+1, nu2+nx_v[0], pRSQrq2, cnux2);
+#else
+	d_print_pmat(nu2+nx_v[0]+1, nu2+nx_v[0], bs, pRSQrq2, cnux2);
+#endif
 
 
-	d_cond_DCtd(N, nx_v, nu_v, nb_v, hidxb, hd, hpGamma, pDCt2, d2, idxb2);
+	d_cond_DCtd(N, nx_v, nu_v, nb_v, hidxb, ng_v, hpDCt, hd, hpGamma, work1, pDCt2, d2, idxb2);
 
 	printf("\nDCt2\n\n");
+#ifdef BLASFEO
 	d_print_pmat(nu2+nx_v[0], nbg, pDCt2, cnbg);
+#else
+	d_print_pmat(nu2+nx_v[0], nbg, bs, pDCt2, cnbg);
+#endif
 	d_print_mat(1, nbb, d2, 1);
 	d_print_mat(1, nbb, d2+pnbb, 1);
 	d_print_mat(1, nbg, d2+2*pnbb, 1);
 	d_print_mat(1, nbg, d2+2*pnbb+pnbg, 1);
-	i_print_mat(1, nbb, idxb2, 1);
+	int_print_mat(1, nbb, idxb2, 1);
 
 /************************************************
 * solve condensed system using Riccati / IPM
@@ -691,7 +977,7 @@ int main()
 	nx2_v[0] = nx_v[0];
 	nx2_v[1] = nx_v[N];
 
-	int nu2_v[N2];
+	int nu2_v[N2+1];
 	nu2_v[0] = nu2;
 	nu2_v[1] = 0; // XXX
 
@@ -849,6 +1135,8 @@ int main()
 	double *hpDCt3[N3+1];
 	double *hd3[N3+1];
 
+	d_part_cond_compute_problem_size(N, nx_v, nu_v, nb_v, hidxb, ng_v, N3, nx3_v, nu3_v, nb3_v, ng3_v);
+
 	void *memory_part_cond;
 	v_zeros_align(&memory_part_cond, d_part_cond_memory_space_size_bytes(N, nx_v, nu_v, nb_v, hidxb, ng_v, N3, nx3_v, nu3_v, nb3_v, ng3_v));
 
@@ -896,7 +1184,7 @@ int main()
 	
 //	printf("\nidxb3 = \n");
 //	for(ii=0; ii<=N3; ii++)
-//		i_print_mat(1, nb3_v[ii], hidxb3[ii], 1);
+//		int_print_mat(1, nb3_v[ii], hidxb3[ii], 1);
 	
 /************************************************
 * solve partially condensed system using IPM
@@ -1171,6 +1459,12 @@ int main()
 	printf("time ipm cond      (N = %3d) = %5.2e\n", 1, time_ipm_cond);
 	printf("time ipm part cond (N = %3d) = %5.2e\n\n", N3, time_ipm_part_cond);
 
+/************************************************
+* general constraints and boxes on the states: condensed vs uncondensed solution
+************************************************/	
+
+	int n_fail = test_cond_general_constraints(61, nx, nu);
+
 /************************************************
 * free memory
 ************************************************/	
@@ -1216,6 +1510,6 @@ int main()
 * return
 ************************************************/	
 
-	return 0;
+	return n_fail;
 
 	}
@@ -27,7 +27,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <sys/time.h>
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
+#if defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
 #include <xmmintrin.h> // needed to flush to zero sub-normals with _MM_SET_FLUSH_ZERO_MODE (_MM_FLUSH_ZERO_ON); in the main()
 #endif
 
@@ -163,7 +163,7 @@ int main()
 	printf("\n");
 	printf("\n");
 	
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
+#if defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
 	_MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON); // flush to zero subnormals !!! works only with one thread !!!
 #endif
 
@@ -705,6 +705,139 @@ int main()
 	for(jj=0; jj<kk; jj++)
 		printf("k = %d\tsigma = %f\talpha = %f\tmu = %f\t\tmu = %e\talpha = %f\tmu = %f\tmu = %e\n", jj, stat[5*jj], stat[5*jj+1], stat[5*jj+2], stat[5*jj+2], stat[5*jj+3], stat[5*jj+4], stat[5*jj+4]);
 	printf("\n");
+
+/************************************************
+* solve condensed system using dense IPM
+************************************************/	
+
+	int nv2 = nu2[0] + nx2[0];
+
+	int work_size_ipm_dense = d_ip2_res_dense_qp_work_space_size_bytes_libstr(nv2, nb2[0], ng2[0]);
+	void *work_ipm_dense;
+	v_zeros_align(&work_ipm_dense, work_size_ipm_dense);
+
+	struct blasfeo_dvec sv2;
+	blasfeo_allocate_dvec(nv2, &sv2);
+
+	printf("\nsolving... (condensed system, dense IPM)\n");
+
+	gettimeofday(&tv0, NULL); // stop
+
+	for(rep=0; rep<nrep; rep++)
+		{
+
+		d_cond_libstr(N, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsd, nx2, nu2, nb2, hidxb2, ng2, hsBAbt2, hsRSQrq2, hsDCt2, hsd2, memo_cond, work_cond, work_sizes_cond);
+
+		hpmpc_status = d_ip2_res_dense_qp_libstr(&kk, k_max, mu0, mu_tol, alpha_min, warm_start, stat, nv2, nb2[0], hidxb2[0], ng2[0], &hsRSQrq2[0], &hsDCt2[0], &hsd2[0], &sv2, &hslam2[0], &hst2[0], work_ipm_dense);
+
+		}
+
+	gettimeofday(&tv1, NULL); // stop
+
+	printf("\n... done\n");
+
+	float time_ipm_dense = (tv1.tv_sec-tv0.tv_sec)/(nrep+0.0)+(tv1.tv_usec-tv0.tv_usec)/(nrep*1e6);
+
+	printf("\nstatistics from last run\n\n");
+	for(jj=0; jj<kk; jj++)
+		printf("k = %d\tsigma = %f\talpha = %f\tmu = %f\t\tmu = %e\talpha = %f\tmu = %f\tmu = %e\n", jj, stat[5*jj], stat[5*jj+1], stat[5*jj+2], stat[5*jj+2], stat[5*jj+3], stat[5*jj+4], stat[5*jj+4]);
+	printf("\n");
+
+	// difference with the solution of the Riccati IPM on the condensed system
+	double nrm_dense;
+	blasfeo_daxpy(nv2, -1.0, &hsux2[0], 0, &sv2, 0, &sv2, 0);
+	blasfeo_dvecnrm_inf(nv2, &sv2, 0, &nrm_dense);
+	printf("\ninf norm of v_dense - v_ric = %e\n", nrm_dense);
+
+	blasfeo_free_dvec(&sv2);
+	v_free_align(work_ipm_dense);
+
+/************************************************
+* dense IPM, Schur complement on the constraints
+************************************************/	
+
+	// keep only the last half of the box constraints (the first stages, active in this problem), so that nb+ng<nv and the Schur complement is used
+	int nb3 = nb2[0]/2;
+	int ng3 = 0;
+	int *idxb3 = hidxb2[0] + nb2[0] - nb3;
+
+	struct blasfeo_dmat sDCt3;
+	blasfeo_allocate_dmat(nv2, ng3, &sDCt3);
+	struct blasfeo_dvec sd3;
+	blasfeo_allocate_dvec(2*nb3, &sd3);
+	blasfeo_dveccp(nb3, &hsd2[0], nb2[0]-nb3, &sd3, 0);
+	blasfeo_dveccp(nb3, &hsd2[0], nb2[0]+ng2[0]+nb2[0]-nb3, &sd3, nb3);
+	struct blasfeo_dvec sv3, slam3, st3;
+	blasfeo_allocate_dvec(nv2, &sv3);
+	blasfeo_allocate_dvec(2*nb3, &slam3);
+	blasfeo_allocate_dvec(2*nb3, &st3);
+
+	void *work_ipm_schur;
+	v_zeros_align(&work_ipm_schur, d_ip2_res_dense_qp_work_space_size_bytes_libstr(nv2, nb3, ng3));
+
+	printf("\nsolving... (condensed system, dense IPM, nb = %d, ng = %d, nv = %d)\n", nb3, ng3, nv2);
+
+	gettimeofday(&tv0, NULL); // stop
+
+	for(rep=0; rep<nrep; rep++)
+		{
+
+		hpmpc_status = d_ip2_res_dense_qp_libstr(&kk, k_max, mu0, mu_tol, alpha_min, warm_start, stat, nv2, nb3, idxb3, ng3, &hsRSQrq2[0], &sDCt3, &sd3, &sv3, &slam3, &st3, work_ipm_schur);
+
+		}
+
+	gettimeofday(&tv1, NULL); // stop
+
+	printf("\n... done\n");
+
+	float time_ipm_schur = (tv1.tv_sec-tv0.tv_sec)/(nrep+0.0)+(tv1.tv_usec-tv0.tv_usec)/(nrep*1e6);
+
+	printf("\nstatistics from last run\n\n");
+	for(jj=0; jj<kk; jj++)
+		printf("k = %d\tsigma = %f\talpha = %f\tmu = %f\t\tmu = %e\talpha = %f\tmu = %f\tmu = %e\n", jj, stat[5*jj], stat[5*jj+1], stat[5*jj+2], stat[5*jj+2], stat[5*jj+3], stat[5*jj+4], stat[5*jj+4]);
+	printf("\n");
+
+	// same QP with nv loose general constraints DCt=I, so that nb+ng>=nv and the normal equations are used
+	int ng4 = nv2;
+
+	struct blasfeo_dmat sDCt4;
+	blasfeo_allocate_dmat(nv2, ng4, &sDCt4);
+	blasfeo_dgese(nv2, ng4, 0.0, &sDCt4, 0, 0);
+	blasfeo_ddiare(nv2, 1.0, &sDCt4, 0, 0);
+	struct blasfeo_dvec sd4;
+	blasfeo_allocate_dvec(2*nb3+2*ng4, &sd4);
+	blasfeo_dveccp(nb3, &sd3, 0, &sd4, 0);
+	blasfeo_dvecse(ng4, -1e4, &sd4, nb3);
+	blasfeo_dveccp(nb3, &sd3, nb3, &sd4, nb3+ng4);
+	blasfeo_dvecse(ng4, 1e4, &sd4, nb3+ng4+nb3);
+	struct blasfeo_dvec sv4, slam4, st4;
+	blasfeo_allocate_dvec(nv2, &sv4);
+	blasfeo_allocate_dvec(2*nb3+2*ng4, &slam4);
+	blasfeo_allocate_dvec(2*nb3+2*ng4, &st4);
+
+	void *work_ipm_normal;
+	v_zeros_align(&work_ipm_normal, d_ip2_res_dense_qp_work_space_size_bytes_libstr(nv2, nb3, ng4));
+
+	hpmpc_status = d_ip2_res_dense_qp_libstr(&kk, k_max, mu0, mu_tol, alpha_min, warm_start, stat, nv2, nb3, idxb3, ng4, &hsRSQrq2[0], &sDCt4, &sd4, &sv4, &slam4, &st4, work_ipm_normal);
+
+	// difference between the Schur complement and the normal equations solutions
+	double nrm_schur;
+	blasfeo_daxpy(nv2, -1.0, &sv4, 0, &sv3, 0, &sv3, 0);
+	blasfeo_dvecnrm_inf(nv2, &sv3, 0, &nrm_schur);
+	printf("\ninf norm of v_schur - v_normal = %e\n", nrm_schur);
+
+	blasfeo_free_dmat(&sDCt3);
+	blasfeo_free_dvec(&sd3);
+	blasfeo_free_dvec(&sv3);
+	blasfeo_free_dvec(&slam3);
+	blasfeo_free_dvec(&st3);
+	v_free_align(work_ipm_schur);
+	blasfeo_free_dmat(&sDCt4);
+	blasfeo_free_dvec(&sd4);
+	blasfeo_free_dvec(&sv4);
+	blasfeo_free_dvec(&slam4);
+	blasfeo_free_dvec(&st4);
+	v_free_align(work_ipm_normal);
 	
 #if 0
 	printf("\nux2 =\n\n");
@@ -811,7 +944,9 @@ int main()
 ************************************************/	
 
 	printf("\ntime ipm full (in sec): %e", time_ipm_full);
-	printf("\ntime ipm cond (in sec): %e\n\n", time_ipm_cond);
+	printf("\ntime ipm cond (in sec): %e", time_ipm_cond);
+	printf("\ntime ipm dense (in sec): %e", time_ipm_dense);
+	printf("\ntime ipm dense schur (in sec): %e\n\n", time_ipm_schur);
 
 /************************************************
 * return
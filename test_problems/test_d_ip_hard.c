@@ -27,7 +27,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <sys/time.h>
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
+#if defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
 #include <xmmintrin.h> // needed to flush to zero sub-normals with _MM_SET_FLUSH_ZERO_MODE (_MM_FLUSH_ZERO_ON); in the main()
 #endif
 
@@ -154,7 +154,7 @@ int main()
 	printf("\n");
 	printf("\n");
 	
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
+#if defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
 	_MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON); // flush to zero subnormals !!! works only with one thread !!!
 #endif
 
@@ -1104,6 +1104,179 @@ exit(1);
 	printf(" Average solution time over %d runs: %5.2e seconds (resolve final kkt)\n", nrep, time_final);
 	printf("\n\n");
 
+/************************************************
+* batched solver: D_BATCH problems across the simd lanes
+************************************************/	
+
+	// the lanes differ in the initial state, and are compared with the low-level solver applied to each problem;
+	// at least one lane has to converge before the others, and then stay at its solution
+	const int vl = D_BATCH;
+	int ll, kk0;
+	int kk_batch[D_BATCH];
+	int kk_ref[D_BATCH];
+	int nz0, nx1;
+	double scal_x0;
+
+	double *bBAbt[N];
+	double *bRSQrq[N+1];
+	double *bd[N+1];
+	double *bux[N+1];
+	double *bpi[N];
+	double *blam[N+1];
+	double *bt[N+1];
+	double *stat_batch; d_zeros(&stat_batch, 5*k_max, vl);
+	double *work_batch; d_zeros_align(&work_batch, d_ip2_res_mpc_hard_batch_work_space_size_bytes(N, nx_v, nu_v, nb_v)/sizeof(double), 1);
+	double *x0_lane; d_zeros(&x0_lane, nx, 1);
+	double *b0_lane; d_zeros_align(&b0_lane, pnx, 1);
+	double *pBAbt0_lane; d_zeros_align(&pBAbt0_lane, pnz_v[0], cnx_v[1]);
+	double *BAbt; d_zeros(&BAbt, nu+nx+1, nx);
+	double *RSQrq; d_zeros(&RSQrq, nu+nx+1, nu+nx);
+	double *ux_ref[N+1];
+	double *pi_ref[N];
+
+	for(ii=0; ii<=N; ii++)
+		{
+		nz0 = nu_v[ii]+nx_v[ii];
+		nx1 = ii<N ? nx_v[ii+1] : 0;
+		d_zeros_align(&bRSQrq[ii], (nz0+1)*nz0*vl, 1);
+		d_zeros_align(&bd[ii], 2*nb_v[ii]*vl, 1);
+		d_zeros_align(&bux[ii], nz0*vl, 1);
+		d_zeros_align(&blam[ii], 2*nb_v[ii]*vl, 1);
+		d_zeros_align(&bt[ii], 2*nb_v[ii]*vl, 1);
+		d_zeros(&ux_ref[ii], nz0, vl);
+		if(ii<N)
+			{
+			d_zeros_align(&bBAbt[ii], (nz0+1)*nx1*vl, 1);
+			d_zeros_align(&bpi[ii], nx1*vl, 1);
+			d_zeros(&pi_ref[ii], nx1, vl);
+			}
+		}
+
+	for(ll=0; ll<vl; ll++)
+		{
+
+		// lane data: BAbt = [B'; A'; b'] and RSQrq = [R S; S' Q; r' q'], with x0 eliminated at the first stage
+		scal_x0 = 1.0 - ll/(vl-1.0);
+		for(jj=0; jj<nx; jj++)
+			x0_lane[jj] = scal_x0*x0[jj];
+		for(jj=0; jj<nx; jj++)
+			b0_lane[jj] = b[jj];
+		for(jj=0; jj<nx; jj++)
+			for(kk0=0; kk0<nx; kk0++)
+				b0_lane[jj] += A[jj+kk0*nx]*x0_lane[kk0];
+		for(ii=0; ii<=N; ii++)
+			{
+			nz0 = nu_v[ii]+nx_v[ii];
+			nx1 = ii<N ? nx_v[ii+1] : 0;
+			for(jj=0; jj<nx1; jj++)
+				{
+				for(kk0=0; kk0<nu_v[ii]; kk0++)
+					BAbt[kk0+jj*(nz0+1)] = B[jj+kk0*nx];
+				for(kk0=0; kk0<nx_v[ii]; kk0++)
+					BAbt[nu_v[ii]+kk0+jj*(nz0+1)] = A[jj+kk0*nx];
+				BAbt[nz0+jj*(nz0+1)] = ii==0 ? b0_lane[jj] : b[jj];
+				}
+			for(jj=0; jj<nz0; jj++)
+				for(kk0=0; kk0<=nz0; kk0++)
+					RSQrq[kk0+jj*(nz0+1)] = 0.0;
+			for(jj=0; jj<nu_v[ii]; jj++)
+				{
+				for(kk0=0; kk0<nu_v[ii]; kk0++)
+					RSQrq[kk0+jj*(nz0+1)] = R[kk0+jj*nu];
+				for(kk0=0; kk0<nx_v[ii]; kk0++)
+					RSQrq[nu_v[ii]+kk0+jj*(nz0+1)] = S[jj+kk0*nu];
+				RSQrq[nz0+jj*(nz0+1)] = r[jj];
+				}
+			for(jj=0; jj<nx_v[ii]; jj++)
+				{
+				for(kk0=0; kk0<nx_v[ii]; kk0++)
+					RSQrq[nu_v[ii]+kk0+(nu_v[ii]+jj)*(nz0+1)] = Q[kk0+jj*nx];
+				RSQrq[nz0+(nu_v[ii]+jj)*(nz0+1)] = q[jj];
+				}
+			if(ii<N)
+				d_cvt_mat2bmat(nz0+1, nx1, BAbt, nz0+1, ll, bBAbt[ii]);
+			d_cvt_mat2bmat(nz0+1, nz0, RSQrq, nz0+1, ll, bRSQrq[ii]);
+			d_cvt_vec2bvec(nb_v[ii], hlb[ii], ll, bd[ii]);
+			d_cvt_vec2bvec(nb_v[ii], hub[ii], ll, bd[ii]+nb_v[ii]*vl);
+			}
+
+		// reference: the low-level solver on the same problem
+		for(jj=0; jj<pnz_v[0]*cnx_v[1]; jj++)
+			pBAbt0_lane[jj] = pBAbt0[jj];
+		d_cvt_tran_mat2pmat(nx_v[1], 1, b0_lane, nx_v[1], nu_v[0]+nx_v[0], pBAbt0_lane+(nu_v[0]+nx_v[0])/bs*bs*cnx_v[1]+(nu_v[0]+nx_v[0])%bs, cnx_v[1]);
+		hpBAbt[0] = pBAbt0_lane;
+		hpmpc_status = d_ip2_res_mpc_hard_tv(&kk, k_max, mu0, mu_tol, alpha_min, 0, stat, N, nx_v, nu_v, nb_v, hidxb, ng_v, hpBAbt, hpRSQ, hpDCt, hd, hux, compute_mult, hpi, hlam, ht, work);
+		kk_ref[ll] = kk;
+		for(ii=0; ii<=N; ii++)
+			{
+			for(jj=0; jj<nu_v[ii]+nx_v[ii]; jj++)
+				ux_ref[ii][jj+ll*(nu_v[ii]+nx_v[ii])] = hux[ii][jj];
+			if(ii<N)
+				for(jj=0; jj<nx_v[ii+1]; jj++)
+					pi_ref[ii][jj+ll*nx_v[ii+1]] = hpi[ii][jj];
+			}
+
+		}
+	hpBAbt[0] = pBAbt0;
+
+	int batch_status = d_ip2_res_mpc_hard_batch(kk_batch, k_max, mu0, mu_tol, alpha_min, 0, stat_batch, N, nx_v, nu_v, nb_v, hidxb, bBAbt, bRSQrq, bd, bux, compute_mult, bpi, blam, bt, work_batch);
+
+	// iteration count and solution of each lane
+	double err_batch, err_max = 0.0;
+	int n_diff = 0;
+	int kk_max = 0;
+	int n_early = 0;
+	printf("\nbatched solver, %d lanes (exit status %d)\n\n", vl, batch_status);
+	for(ll=0; ll<vl; ll++)
+		{
+		err_batch = 0.0;
+		for(ii=0; ii<=N; ii++)
+			{
+			for(jj=0; jj<nu_v[ii]+nx_v[ii]; jj++)
+				err_batch = fmax(err_batch, fabs(bux[ii][jj*vl+ll]-ux_ref[ii][jj+ll*(nu_v[ii]+nx_v[ii])]));
+			if(ii<N)
+				for(jj=0; jj<nx_v[ii+1]; jj++)
+					err_batch = fmax(err_batch, fabs(bpi[ii][jj*vl+ll]-pi_ref[ii][jj+ll*nx_v[ii+1]]));
+			}
+		printf("lane %d: %d iterations (%d low-level), max |ux - ux_ref|, |pi - pi_ref| = %e\n", ll, kk_batch[ll], kk_ref[ll], err_batch);
+		err_max = fmax(err_max, err_batch);
+		if(kk_batch[ll]!=kk_ref[ll])
+			n_diff++;
+		kk_max = kk_batch[ll]>kk_max ? kk_batch[ll] : kk_max;
+		}
+	for(ll=0; ll<vl; ll++)
+		if(kk_batch[ll]<kk_max)
+			n_early++;
+	printf("\n%d lanes converged early\n\n", n_early);
+	if(err_max>1e-8 || n_diff>0 || n_early==0)
+		{
+		printf("\nbatched solver test failed\n\n");
+		return 1;
+		}
+
+	for(ii=0; ii<=N; ii++)
+		{
+		d_free_align(bRSQrq[ii]);
+		d_free_align(bd[ii]);
+		d_free_align(bux[ii]);
+		d_free_align(blam[ii]);
+		d_free_align(bt[ii]);
+		free(ux_ref[ii]);
+		if(ii<N)
+			{
+			d_free_align(bBAbt[ii]);
+			d_free_align(bpi[ii]);
+			free(pi_ref[ii]);
+			}
+		}
+	free(stat_batch);
+	d_free_align(work_batch);
+	free(x0_lane);
+	d_free_align(b0_lane);
+	d_free_align(pBAbt0_lane);
+	free(BAbt);
+	free(RSQrq);
+
 /************************************************
 * compute residuals
 ************************************************/	
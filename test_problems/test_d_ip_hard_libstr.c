@@ -27,7 +27,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <sys/time.h>
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
+#if defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
 #include <xmmintrin.h> // needed to flush to zero sub-normals with _MM_SET_FLUSH_ZERO_MODE (_MM_FLUSH_ZERO_ON); in the main()
 #endif
 
@@ -158,7 +158,7 @@ int main()
 	printf("\n");
 	printf("\n");
 	
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
+#if defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
 	_MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON); // flush to zero subnormals !!! works only with one thread !!!
 #endif
 
@@ -615,9 +615,11 @@ int main()
 	blasfeo_allocate_dvec(2*nb[N]+2*ng[N], &hslam[N]);
 	blasfeo_allocate_dvec(2*nb[N]+2*ng[N], &hst[N]);
 	
+	int work_size_no_alias, work_size;
+	d_ip2_res_mpc_hard_work_space_plan_libstr(N, nx, nu, nb, ng, &work_size_no_alias, &work_size);
 	void *work_memory;
-	v_zeros_align(&work_memory, d_ip2_res_mpc_hard_work_space_size_bytes_libstr(N, nx, nu, nb, ng));
-	printf("\nwork space size (in bytes): %d\n", d_ip2_res_mpc_hard_work_space_size_bytes_libstr(N, nx, nu, nb, ng));
+	v_zeros_align(&work_memory, work_size);
+	printf("\nwork space size (in bytes): %d (%d without aliasing)\n", work_size, work_size_no_alias);
 
 	// IP options
 	int kk = -1;
@@ -804,6 +806,174 @@ int main()
 
 	printf(" Average solution time over %d runs: %5.2e seconds (IPM resolve last kkt for new rhs)\n\n", nrep, time_ipm2);
 
+/************************************************
+* libstr ip2 solver - real-time mode with a time budget
+************************************************/	
+
+	// the deadline solver returns status 3 with the best iterate so far: the duality gap ranks the iterates
+	// until it reaches the threshold of iterative refinement, then the largest of gap and residuals does
+	double thr_iter_ref = 1e-5; // THR_ITER_REF in d_ip2_res_hard_libstr.c
+	double time_budget[2] = {1e-9, 0.5*time_ipm};
+	int kk_dl, kk_rep, kk_ref, kk_best, dl_exit;
+	double mu_dl[k_max+1];
+	double merit, merit_best, nrm, err_best, min_t_lam;
+
+	struct blasfeo_dvec hsux3[N+1];
+	struct blasfeo_dvec hspi3[N+1];
+	struct blasfeo_dvec hslam3[N+1];
+	struct blasfeo_dvec hst3[N+1];
+
+	blasfeo_allocate_dvec(nu[0]+nx[0], &hsux3[0]);
+	blasfeo_allocate_dvec(nx[1], &hspi3[1]);
+	blasfeo_allocate_dvec(2*nb[0]+2*ng[0], &hslam3[0]);
+	blasfeo_allocate_dvec(2*nb[0]+2*ng[0], &hst3[0]);
+	for(ii=1; ii<N; ii++)
+		{
+		blasfeo_allocate_dvec(nu[ii]+nx[ii], &hsux3[ii]);
+		blasfeo_allocate_dvec(nx[ii+1], &hspi3[ii+1]);
+		blasfeo_allocate_dvec(2*nb[ii]+2*ng[ii], &hslam3[ii]);
+		blasfeo_allocate_dvec(2*nb[ii]+2*ng[ii], &hst3[ii]);
+		}
+	blasfeo_allocate_dvec(nu[N]+nx[N], &hsux3[N]);
+	blasfeo_allocate_dvec(2*nb[N]+2*ng[N], &hslam3[N]);
+	blasfeo_allocate_dvec(2*nb[N]+2*ng[N], &hst3[N]);
+
+	for(rep=0; rep<2; rep++)
+		{
+
+		dl_exit = d_ip2_res_mpc_hard_deadline_libstr(&kk_dl, k_max, time_budget[rep], mu0, mu_tol, alpha_min, 0, stat, N, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsd, hsux2, 1, hspi2, hslam2, hst2, work_memory);
+
+		if(dl_exit!=3)
+			{
+			printf(" Time budget %5.2e seconds: exit flag %d after %d iterations, within the budget\n\n", time_budget[rep], dl_exit, kk_dl);
+			continue;
+			}
+
+		// the returned slacks and multipliers are strictly positive
+		min_t_lam = 1.0;
+		for(ii=0; ii<=N; ii++)
+			for(jj=0; jj<2*nb[ii]+2*ng[ii]; jj++)
+				{
+				min_t_lam = hst2[ii].pa[jj]<min_t_lam ? hst2[ii].pa[jj] : min_t_lam;
+				min_t_lam = hslam2[ii].pa[jj]<min_t_lam ? hslam2[ii].pa[jj] : min_t_lam;
+				}
+
+		// iterate where the duality gap reaches the threshold of iterative refinement: if more iterations follow,
+		// the ranking restarts from it with the residuals
+		kk_ref = kk_dl;
+		for(kk_rep=kk_dl; kk_rep>=1; kk_rep--)
+			if(stat[5*(kk_rep-1)+4]<=thr_iter_ref)
+				kk_ref = kk_rep;
+		for(kk_rep=1; kk_rep<=kk_dl; kk_rep++)
+			mu_dl[kk_rep] = stat[5*(kk_rep-1)+4];
+
+		// replay the iterations without budget, and rank them as the solver does
+		kk_best = 0;
+		merit_best = -1.0;
+		for(kk_rep=kk_ref<kk_dl ? kk_ref : 1; kk_rep<=kk_dl; kk_rep++)
+			{
+			merit = mu_dl[kk_rep];
+			if(kk_ref<kk_dl)
+				{
+				d_ip2_res_mpc_hard_libstr(&kk, kk_rep, mu0, mu_tol, alpha_min, 0, stat, N, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsd, hsux3, 1, hspi3, hslam3, hst3, work_memory);
+				d_res_res_mpc_hard_libstr(N, nx, nu, nb, hidxb, ng, hsBAbt, hsb, hsRSQrq, hsrq, hsux3, hsDCt, hsd, hspi3, hslam3, hst3, hsrrq, hsrb, hsrd, hsrm, &mu, work_res);
+				merit = mu;
+				for(ii=0; ii<=N; ii++)
+					{
+					blasfeo_dvecnrm_inf(nu[ii]+nx[ii], &hsrrq[ii], 0, &nrm);
+					merit = nrm>merit ? nrm : merit;
+					if(ii<N)
+						{
+						blasfeo_dvecnrm_inf(nx[ii+1], &hsrb[ii], 0, &nrm);
+						merit = nrm>merit ? nrm : merit;
+						}
+					blasfeo_dvecnrm_inf(2*nb[ii]+2*ng[ii], &hsrd[ii], 0, &nrm);
+					merit = nrm>merit ? nrm : merit;
+					}
+				}
+			if(merit_best<0.0 || merit<merit_best)
+				{
+				merit_best = merit;
+				kk_best = kk_rep;
+				}
+			}
+
+		// the returned iterate is the best ranked one
+		d_ip2_res_mpc_hard_libstr(&kk, kk_best, mu0, mu_tol, alpha_min, 0, stat, N, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsd, hsux3, 1, hspi3, hslam3, hst3, work_memory);
+		err_best = 0.0;
+		for(ii=0; ii<=N; ii++)
+			{
+			for(jj=0; jj<nu[ii]+nx[ii]; jj++)
+				err_best = fabs(hsux2[ii].pa[jj]-hsux3[ii].pa[jj])>err_best ? fabs(hsux2[ii].pa[jj]-hsux3[ii].pa[jj]) : err_best;
+			for(jj=0; jj<2*nb[ii]+2*ng[ii]; jj++)
+				{
+				err_best = fabs(hst2[ii].pa[jj]-hst3[ii].pa[jj])>err_best ? fabs(hst2[ii].pa[jj]-hst3[ii].pa[jj]) : err_best;
+				err_best = fabs(hslam2[ii].pa[jj]-hslam3[ii].pa[jj])>err_best ? fabs(hslam2[ii].pa[jj]-hslam3[ii].pa[jj]) : err_best;
+				}
+			}
+
+		printf(" Time budget %5.2e seconds: exit flag %d after %d iterations, min(t, lam) = %e, best iterate %d, max |x - x(best)| = %e\n\n", time_budget[rep], dl_exit, kk_dl, min_t_lam, kk_best, err_best);
+		if(min_t_lam<=0.0 || err_best!=0.0)
+			{
+			printf("\nreal-time mode test failed\n\n");
+			return 1;
+			}
+
+		}
+
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_free_dvec(&hsux3[ii]);
+		if(ii>0)
+			blasfeo_free_dvec(&hspi3[ii]);
+		blasfeo_free_dvec(&hslam3[ii]);
+		blasfeo_free_dvec(&hst3[ii]);
+		}
+
+/************************************************
+* libstr ip2 solver - closed loop with shifted warm start
+************************************************/	
+
+#if ! KEEP_X0
+	// the initial state of each cycle is the predicted state at stage 1 of the previous one;
+	// cold start (warm_start=0) vs shifted previous solution (warm_start=2)
+	int n_cycle = 8;
+	int kk_cycle[2] = {0, 0};
+	int cycle, warm;
+
+	struct blasfeo_dvec sx0_cl;
+	blasfeo_allocate_dvec(nx_, &sx0_cl);
+	struct blasfeo_dvec sb0_cl;
+	blasfeo_allocate_dvec(nx_, &sb0_cl);
+
+	for(warm=0; warm<2; warm++)
+		{
+		blasfeo_dveccp(nx_, &sx0, 0, &sx0_cl, 0);
+		for(cycle=0; cycle<n_cycle; cycle++)
+			{
+			// b0 = b + A*x0
+			blasfeo_pack_dvec(nx_, b, &sb0_cl, 0);
+			blasfeo_dgemv_n(nx_, nx_, 1.0, &sA, 0, 0, &sx0_cl, 0, 1.0, &sb0_cl, 0, &sb0_cl, 0);
+			blasfeo_drowin(nx[1], 1.0, &sb0_cl, 0, &hsBAbt[0], nu[0]+nx[0], 0);
+
+			hpmpc_exit = d_ip2_res_mpc_hard_libstr(&kk, k_max, mu0, mu_tol, alpha_min, warm==1 && cycle>0 ? 2 : 0, stat, N, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsd, hsux, 1, hspi, hslam, hst, work_memory);
+			kk_cycle[warm] += kk;
+
+			blasfeo_dveccp(nx_, &hsux[1], nu[1], &sx0_cl, 0);
+			if(warm==1)
+				d_shift_warm_start_mpc_hard_libstr(N, nx, nu, nb, ng, hsBAbt, hsux, hspi, hslam, hst, 1e-2);
+			}
+		}
+
+	// restore b0
+	blasfeo_drowin(nx[1], 1.0, &sb0, 0, &hsBAbt[0], nu[0]+nx[0], 0);
+
+	printf(" Closed loop over %d cycles: %d IPM iterations with cold start, %d with shifted warm start\n\n", n_cycle, kk_cycle[0], kk_cycle[1]);
+
+	blasfeo_free_dvec(&sx0_cl);
+	blasfeo_free_dvec(&sb0_cl);
+#endif
+
 
 /************************************************
 * high-level interface
@@ -1027,6 +1197,241 @@ int main()
 
 	printf(" Average solution time over %d runs: %5.2e seconds (IPM high kkt last rhs, N2 = %d)\n\n", nrep, time_ipm_high_kkt, N2);
 
+/************************************************
+* high-level interface, partial condensing horizon from the tuner
+************************************************/	
+
+	int N2_tune, N2_cache, N_sum;
+	int block_horizon[N];
+
+	// no stage to partition
+	N2_tune = hpmpc_d_ip_ocp_hard_tv_tune_N2(0, nx, nu, nb, hidxb, ng, 0, NULL);
+	printf("\ntuned N2 for N = 0: %d\n", N2_tune);
+
+	// cost model, then cached choice
+	N2_tune = hpmpc_d_ip_ocp_hard_tv_tune_N2(N, nx, nu, nb, hidxb, ng, 0, block_horizon);
+	N2_cache = hpmpc_d_ip_ocp_hard_tv_tune_N2(N, nx, nu, nb, hidxb, ng, 0, NULL);
+	N_sum = 0;
+	for(ii=0; ii<N2_tune; ii++)
+		N_sum += block_horizon[ii];
+	printf("\ntuned N2 = %d (model), %d (cached), block horizons summing to %d (N = %d)\n", N2_tune, N2_cache, N_sum, N);
+
+	// calibrated by timing the best candidates
+	N2_tune = hpmpc_d_ip_ocp_hard_tv_tune_N2(N, nx, nu, nb, hidxb, ng, 1, block_horizon);
+	N_sum = 0;
+	for(ii=0; ii<N2_tune; ii++)
+		N_sum += block_horizon[ii];
+	printf("\ntuned N2 = %d (calibrated), block horizons summing to %d (N = %d)\n", N2_tune, N_sum, N);
+
+	// solution with the tuned N2 against the one without condensing
+	double *hx_ref[N+1];
+	double *hu_ref[N];
+	void *work_tune;
+	v_zeros(&work_tune, hpmpc_d_ip_ocp_hard_tv_work_space_size_bytes(N, nx, nu, nb, hidxb, ng, N));
+
+	hpmpc_exit = fortran_order_d_ip_ocp_hard_tv(&kk, k_max, mu0, mu_tol, N, nx, nu, nb, hidxb, ng, N, 0, hA, hB, hb, hQ, hS, hR, hq, hr, hlb, hub, hC, hD, hlg, hug, hx, hu, hpi, hlam, inf_norm_res, work_tune, stat);
+	for(ii=0; ii<=N; ii++)
+		{
+		d_zeros(&hx_ref[ii], nx[ii], 1);
+		for(jj=0; jj<nx[ii]; jj++)
+			hx_ref[ii][jj] = hx[ii][jj];
+		if(ii<N)
+			{
+			d_zeros(&hu_ref[ii], nu[ii], 1);
+			for(jj=0; jj<nu[ii]; jj++)
+				hu_ref[ii][jj] = hu[ii][jj];
+			}
+		}
+	v_free(work_tune);
+
+	v_zeros(&work_tune, hpmpc_d_ip_ocp_hard_tv_work_space_size_bytes(N, nx, nu, nb, hidxb, ng, N2_tune));
+	hpmpc_exit = fortran_order_d_ip_ocp_hard_tv(&kk, k_max, mu0, mu_tol, N, nx, nu, nb, hidxb, ng, N2_tune, 0, hA, hB, hb, hQ, hS, hR, hq, hr, hlb, hub, hC, hD, hlg, hug, hx, hu, hpi, hlam, inf_norm_res, work_tune, stat);
+
+	double err_tune = 0.0;
+	for(ii=0; ii<=N; ii++)
+		{
+		for(jj=0; jj<nx[ii]; jj++)
+			err_tune = fabs(hx[ii][jj]-hx_ref[ii][jj])>err_tune ? fabs(hx[ii][jj]-hx_ref[ii][jj]) : err_tune;
+		if(ii<N)
+			for(jj=0; jj<nu[ii]; jj++)
+				err_tune = fabs(hu[ii][jj]-hu_ref[ii][jj])>err_tune ? fabs(hu[ii][jj]-hu_ref[ii][jj]) : err_tune;
+		}
+
+	printf("\ntuned N2 = %d: exit flag %d, %d iterations, max |ux(N2) - ux(N)| = %e\n\n", N2_tune, hpmpc_exit, kk, err_tune);
+
+	v_free(work_tune);
+	for(ii=0; ii<=N; ii++)
+		{
+		d_free(hx_ref[ii]);
+		if(ii<N)
+			d_free(hu_ref[ii]);
+		}
+
+/************************************************
+* high-level interface, batch of problems
+************************************************/	
+
+	// problems with different initial states, solved one by one and by the batch routine on several threads:
+	// the solutions and the iteration counts have to be bit-identical
+	int n_prob = 7;
+	int n_thread = 3;
+	int ll;
+
+	int N_batch[n_prob];
+	int N2_batch[n_prob];
+	int *nx_batch[n_prob];
+	int *nu_batch[n_prob];
+	int *nb_batch[n_prob];
+	int *ng_batch[n_prob];
+	int **hidxb_batch[n_prob];
+	double **hA_batch[n_prob];
+	double **hB_batch[n_prob];
+	double **hb_batch[n_prob];
+	double **hQ_batch[n_prob];
+	double **hS_batch[n_prob];
+	double **hR_batch[n_prob];
+	double **hq_batch[n_prob];
+	double **hr_batch[n_prob];
+	double **hlb_batch[n_prob];
+	double **hub_batch[n_prob];
+	double **hC_batch[n_prob];
+	double **hD_batch[n_prob];
+	double **hlg_batch[n_prob];
+	double **hug_batch[n_prob];
+	double **hx_batch[n_prob];
+	double **hu_batch[n_prob];
+	double **hpi_batch[n_prob];
+	double **hlam_batch[n_prob];
+	double *inf_norm_res_batch[n_prob];
+	double *stat_batch[n_prob];
+	int kk_batch[n_prob];
+	int status_batch[n_prob];
+	int kk_seq[n_prob];
+	int status_seq[n_prob];
+	double *hx_seq[n_prob][N+1];
+	double *hu_seq[n_prob][N];
+	double *hb_prob[n_prob][N];
+
+	for(ll=0; ll<n_prob; ll++)
+		{
+		N_batch[ll] = N;
+		N2_batch[ll] = N2;
+		nx_batch[ll] = nx;
+		nu_batch[ll] = nu;
+		nb_batch[ll] = nb;
+		ng_batch[ll] = ng;
+		hidxb_batch[ll] = hidxb;
+		hA_batch[ll] = hA;
+		hB_batch[ll] = hB;
+		hQ_batch[ll] = hQ;
+		hS_batch[ll] = hS;
+		hR_batch[ll] = hR;
+		hq_batch[ll] = hq;
+		hr_batch[ll] = hr;
+		hlb_batch[ll] = hlb;
+		hub_batch[ll] = hub;
+		hC_batch[ll] = hC;
+		hD_batch[ll] = hD;
+		hlg_batch[ll] = hlg;
+		hug_batch[ll] = hug;
+		// b0 = b + A*x0, with the initial state scaled
+		hb_batch[ll] = hb_prob[ll];
+		d_zeros(&hb_prob[ll][0], nx[1], 1);
+		for(jj=0; jj<nx[1]; jj++)
+			hb_prob[ll][0][jj] = b[jj] + (1.0-0.15*ll)*(b0[jj]-b[jj]);
+		for(ii=1; ii<N; ii++)
+			hb_prob[ll][ii] = hb[ii];
+		hx_batch[ll] = (double **) malloc((N+1)*sizeof(double *));
+		hu_batch[ll] = (double **) malloc(N*sizeof(double *));
+		hpi_batch[ll] = (double **) malloc(N*sizeof(double *));
+		hlam_batch[ll] = (double **) malloc((N+1)*sizeof(double *));
+		for(ii=0; ii<=N; ii++)
+			{
+			d_zeros(&hx_batch[ll][ii], nx[ii], 1);
+			d_zeros(&hx_seq[ll][ii], nx[ii], 1);
+			d_zeros(&hlam_batch[ll][ii], 2*nb[ii]+2*ng[ii], 1);
+			if(ii<N)
+				{
+				d_zeros(&hu_batch[ll][ii], nu[ii], 1);
+				d_zeros(&hu_seq[ll][ii], nu[ii], 1);
+				d_zeros(&hpi_batch[ll][ii], nx[ii+1], 1);
+				}
+			}
+		d_zeros(&inf_norm_res_batch[ll], 5, 1);
+		d_zeros(&stat_batch[ll], 5, k_max);
+		}
+
+	// one by one
+	for(ll=0; ll<n_prob; ll++)
+		{
+		status_seq[ll] = fortran_order_d_ip_ocp_hard_tv(&kk_seq[ll], k_max, mu0, mu_tol, N, nx, nu, nb, hidxb, ng, N2, 0, hA, hB, hb_batch[ll], hQ, hS, hR, hq, hr, hlb, hub, hC, hD, hlg, hug, hx_batch[ll], hu_batch[ll], hpi_batch[ll], hlam_batch[ll], inf_norm_res_batch[ll], work_ipm_high, stat_batch[ll]);
+		for(ii=0; ii<=N; ii++)
+			{
+			for(jj=0; jj<nx[ii]; jj++)
+				hx_seq[ll][ii][jj] = hx_batch[ll][ii][jj];
+			if(ii<N)
+				for(jj=0; jj<nu[ii]; jj++)
+					hu_seq[ll][ii][jj] = hu_batch[ll][ii][jj];
+			}
+		}
+
+	// batch
+	void *work_batch = malloc(hpmpc_d_ip_ocp_hard_tv_batch_work_space_size_bytes(n_thread, n_prob, N_batch, nx_batch, nu_batch, nb_batch, hidxb_batch, ng_batch, N2_batch));
+
+	int n_fail = fortran_order_d_ip_ocp_hard_tv_batch(n_thread, n_prob, kk_batch, k_max, mu0, mu_tol, N_batch, nx_batch, nu_batch, nb_batch, hidxb_batch, ng_batch, N2_batch, 0, hA_batch, hB_batch, hb_batch, hQ_batch, hS_batch, hR_batch, hq_batch, hr_batch, hlb_batch, hub_batch, hC_batch, hD_batch, hlg_batch, hug_batch, hx_batch, hu_batch, hpi_batch, hlam_batch, inf_norm_res_batch, work_batch, stat_batch, status_batch);
+
+	int n_diff = 0;
+	for(ll=0; ll<n_prob; ll++)
+		{
+		if(kk_batch[ll]!=kk_seq[ll] || status_batch[ll]!=status_seq[ll])
+			n_diff++;
+		for(ii=0; ii<=N; ii++)
+			{
+			for(jj=0; jj<nx[ii]; jj++)
+				if(hx_batch[ll][ii][jj]!=hx_seq[ll][ii][jj])
+					n_diff++;
+			if(ii<N)
+				for(jj=0; jj<nu[ii]; jj++)
+					if(hu_batch[ll][ii][jj]!=hu_seq[ll][ii][jj])
+						n_diff++;
+			}
+		}
+
+	printf("batch of %d problems on %d threads: %d not solved, %d entries different from the problems solved one by one\n\n", n_prob, n_thread, n_fail, n_diff);
+
+	// an empty batch does not touch its arguments
+	n_fail += fortran_order_d_ip_ocp_hard_tv_batch(n_thread, 0, NULL, k_max, mu0, mu_tol, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+
+	free(work_batch);
+	for(ll=0; ll<n_prob; ll++)
+		{
+		d_free(hb_prob[ll][0]);
+		for(ii=0; ii<=N; ii++)
+			{
+			d_free(hx_batch[ll][ii]);
+			d_free(hx_seq[ll][ii]);
+			d_free(hlam_batch[ll][ii]);
+			if(ii<N)
+				{
+				d_free(hu_batch[ll][ii]);
+				d_free(hu_seq[ll][ii]);
+				d_free(hpi_batch[ll][ii]);
+				}
+			}
+		free(hx_batch[ll]);
+		free(hu_batch[ll]);
+		free(hpi_batch[ll]);
+		free(hlam_batch[ll]);
+		d_free(inf_norm_res_batch[ll]);
+		d_free(stat_batch[ll]);
+		}
+
+	if(n_diff!=0 || n_fail!=0)
+		{
+		printf("\nbatch test failed\n\n");
+		return 1;
+		}
+
 /************************************************
 * free memory
 ************************************************/	
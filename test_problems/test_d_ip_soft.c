@@ -27,7 +27,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <sys/time.h>
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
+#if defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
 #include <xmmintrin.h> // needed to flush to zero sub-normals with _MM_SET_FLUSH_ZERO_MODE (_MM_FLUSH_ZERO_ON); in the main()
 #endif
 
@@ -43,6 +43,7 @@
 #include "../include/blas_d.h"
 #include "../include/lqcp_solvers.h"
 #include "../include/mpc_solvers.h"
+#include "../include/c_interface.h"
 #include "../problem_size.h"
 #include "../include/block_size.h"
 #include "tools.h"
@@ -153,7 +154,7 @@ int main()
 	printf("\n");
 	printf("\n");
 
-#if defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
+#if defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
 /*	printf("\nflush subnormals to zero\n");*/
 	_MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON); // flush to zero subnormals !!! works only with one thread !!!
 #endif
@@ -416,8 +417,103 @@ int main()
 	v_zeros(&work0, hpmpc_d_ip_ocp_soft_tv_work_space_size_bytes(N, nx, nu, nb, hidxb, ng, ns));
 	printf("\nhigh level interface work space size in bytes = %d\n", hpmpc_d_ip_ocp_soft_tv_work_space_size_bytes(N, nx, nu, nb, hidxb, ng, ns));
 
-//	TODO
-//	hpmpc_status = fortran_order_d_ip_ocp_soft_tv(&kk, k_max, mu0, mu_tol, N, nx, nu, nb, hidxb, ng, ns, warm_start, hA, hB, hb, hQ, hS, hR, hrq, hr, hZ, hz, hlb, hub, hC, hD, hlg, hug, hx, hu, hpi, hlam, inf_norm_res, work0, stat);
+#if defined(BLASFEO)
+	// hard box constraints on the inputs, then soft box constraints on the states
+	double *lb0; d_zeros(&lb0, nb[0]+ns[0], 1);
+	double *ub0; d_zeros(&ub0, nb[0]+ns[0], 1);
+	for(jj=0; jj<nb[0]; jj++)
+		{
+		lb0[jj] = u_min_hard;
+		ub0[jj] = u_max_hard;
+		}
+	double *lb1; d_zeros(&lb1, nb[1]+ns[1], 1);
+	double *ub1; d_zeros(&ub1, nb[1]+ns[1], 1);
+	for(jj=0; jj<nb[1]; jj++)
+		{
+		lb1[jj] = u_min_hard;
+		ub1[jj] = u_max_hard;
+		}
+	for(; jj<nb[1]+ns[1]; jj++)
+		{
+		lb1[jj] = x_min_soft;
+		ub1[jj] = x_max_soft;
+		}
+	double *lbN; d_zeros(&lbN, nb[N]+ns[N], 1);
+	double *ubN; d_zeros(&ubN, nb[N]+ns[N], 1);
+	for(jj=0; jj<nb[N]+ns[N]; jj++)
+		{
+		lbN[jj] = x_min_soft;
+		ubN[jj] = x_max_soft;
+		}
+
+	double *hZ1[N+1];
+	double *hz1[N+1];
+	double *hlb[N+1];
+	double *hub[N+1];
+	double *hC[N+1];
+	double *hD[N];
+	double *hlg[N+1];
+	double *hug[N+1];
+	double *hx[N+1];
+	double *hu[N];
+	double *hpi1[N];
+	double *hlam1[N+1];
+
+	// no general constraints
+	double *dummy; d_zeros(&dummy, 1, 1);
+
+	for(ii=0; ii<=N; ii++)
+		{
+		hZ1[ii] = Z;
+		hz1[ii] = z;
+		hlb[ii] = ii==0 ? lb0 : ii<N ? lb1 : lbN;
+		hub[ii] = ii==0 ? ub0 : ii<N ? ub1 : ubN;
+		hC[ii] = dummy;
+		hlg[ii] = dummy;
+		hug[ii] = dummy;
+		d_zeros(&hx[ii], nx[ii], 1);
+		d_zeros(&hlam1[ii], 2*nb[ii]+2*ng[ii]+4*ns[ii], 1);
+		if(ii<N)
+			{
+			hD[ii] = dummy;
+			d_zeros(&hu[ii], nu[ii], 1);
+			d_zeros(&hpi1[ii], nx[ii+1], 1);
+			}
+		}
+	hA[0] = A;
+	hS[0] = S;
+	hQ[0] = Q;
+	hq[0] = q;
+
+	hpmpc_status = fortran_order_d_ip_ocp_soft_tv(&kk, k_max, mu0, mu_tol, N, nx, nu, nb, hidxb, ng, ns, warm_start, hA, hB, hb, hQ, hS, hR, hq, hr, hZ1, hz1, hlb, hub, hC, hD, hlg, hug, hx, hu, hpi1, hlam1, inf_norm_res, work0, stat);
+
+	printf("\nhigh level interface: status = %d, %d iterations\n\nx =\n\n", hpmpc_status, kk);
+	for(ii=0; ii<=N; ii++)
+		d_print_mat(1, nx[ii], hx[ii], 1);
+	printf("\nu =\n\n");
+	for(ii=0; ii<N; ii++)
+		d_print_mat(1, nu[ii], hu[ii], 1);
+	printf("\ninfinity norm of residuals\n\n");
+	d_print_e_mat(1, 4, inf_norm_res, 1);
+
+	for(ii=0; ii<=N; ii++)
+		{
+		free(hx[ii]);
+		free(hlam1[ii]);
+		if(ii<N)
+			{
+			free(hu[ii]);
+			free(hpi1[ii]);
+			}
+		}
+	free(dummy);
+	free(lb0);
+	free(ub0);
+	free(lb1);
+	free(ub1);
+	free(lbN);
+	free(ubN);
+#endif
 
 /**************************************************************************************************
 *
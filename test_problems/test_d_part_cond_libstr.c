@@ -0,0 +1,879 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <sys/time.h>
+#if defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
+#include <xmmintrin.h> // needed to flush to zero sub-normals with _MM_SET_FLUSH_ZERO_MODE (_MM_FLUSH_ZERO_ON); in the main()
+#endif
+
+#ifdef BLASFEO
+#include <blasfeo_target.h>
+#include <blasfeo_common.h>
+#include <blasfeo_v_aux_ext_dep.h>
+#include <blasfeo_d_aux_ext_dep.h>
+#include <blasfeo_i_aux_ext_dep.h>
+#include <blasfeo_d_aux.h>
+#include <blasfeo_d_blas.h>
+#endif
+
+#include "../include/lqcp_solvers.h"
+#include "../include/mpc_solvers.h"
+#include "../include/c_interface.h"
+#include "tools.h"
+
+
+// printing
+#define PRINT 0
+
+/************************************************ 
+Mass-spring system: nx/2 masses connected each other with springs (in a row), and the first and the last one to walls. nu (<=nx) controls act on the first nu masses. The system is sampled with sampling time Ts. 
+************************************************/
+void mass_spring_system(double Ts, int nx, int nu, int N, double *A, double *B, double *b, double *x0)
+	{
+
+	int nx2 = nx*nx;
+
+	int info = 0;
+
+	int pp = nx/2; // number of masses
+	
+/************************************************
+* build the continuous time system 
+************************************************/
+	
+	double *T; d_zeros(&T, pp, pp);
+	int ii;
+	for(ii=0; ii<pp; ii++) T[ii*(pp+1)] = -2;
+	for(ii=0; ii<pp-1; ii++) T[ii*(pp+1)+1] = 1;
+	for(ii=1; ii<pp; ii++) T[ii*(pp+1)-1] = 1;
+
+	double *Z; d_zeros(&Z, pp, pp);
+	double *I; d_zeros(&I, pp, pp); for(ii=0; ii<pp; ii++) I[ii*(pp+1)]=1.0; // = eye(pp);
+	double *Ac; d_zeros(&Ac, nx, nx);
+	dmcopy(pp, pp, Z, pp, Ac, nx);
+	dmcopy(pp, pp, T, pp, Ac+pp, nx);
+	dmcopy(pp, pp, I, pp, Ac+pp*nx, nx);
+	dmcopy(pp, pp, Z, pp, Ac+pp*(nx+1), nx); 
+	free(T);
+	free(Z);
+	free(I);
+	
+	d_zeros(&I, nu, nu); for(ii=0; ii<nu; ii++) I[ii*(nu+1)]=1.0; //I = eye(nu);
+	double *Bc; d_zeros(&Bc, nx, nu);
+	dmcopy(nu, nu, I, nu, Bc+pp, nx);
+	free(I);
+	
+/************************************************
+* compute the discrete time system 
+************************************************/
+
+	double *bb; d_zeros(&bb, nx, 1);
+	dmcopy(nx, 1, bb, nx, b, nx);
+		
+	dmcopy(nx, nx, Ac, nx, A, nx);
+	dscal_3l(nx2, Ts, A);
+	expm(nx, A);
+	
+	d_zeros(&T, nx, nx);
+	d_zeros(&I, nx, nx); for(ii=0; ii<nx; ii++) I[ii*(nx+1)]=1.0; //I = eye(nx);
+	dmcopy(nx, nx, A, nx, T, nx);
+	daxpy_3l(nx2, -1.0, I, T);
+	dgemm_nn_3l(nx, nu, nx, T, nx, Bc, nx, B, nx);
+	free(T);
+	free(I);
+	
+	int *ipiv = (int *) malloc(nx*sizeof(int));
+	dgesv_3l(nx, nu, Ac, nx, ipiv, B, nx, &info);
+	free(ipiv);
+
+	free(Ac);
+	free(Bc);
+	free(bb);
+	
+			
+/************************************************
+* initial state 
+************************************************/
+	
+	if(nx==4)
+		{
+		x0[0] = 5;
+		x0[1] = 10;
+		x0[2] = 15;
+		x0[3] = 20;
+		}
+	else
+		{
+		int jj;
+		for(jj=0; jj<nx; jj++)
+			x0[jj] = 1;
+		}
+
+	}
+
+
+
+// max abs difference between two matrices
+static double max_diff_dmat(int m, int n, struct blasfeo_dmat *sA, struct blasfeo_dmat *sB)
+	{
+
+	int ii, jj;
+	double tmp;
+	double diff = 0.0;
+
+	for(jj=0; jj<n; jj++)
+		for(ii=0; ii<m; ii++)
+			{
+			tmp = fabs(blasfeo_dgeex1(sA, ii, jj) - blasfeo_dgeex1(sB, ii, jj));
+			diff = tmp>diff ? tmp : diff;
+			}
+
+	return diff;
+
+	}
+
+
+
+// max abs difference between two vectors
+static double max_diff_dvec(int m, struct blasfeo_dvec *sa, struct blasfeo_dvec *sb)
+	{
+
+	int ii;
+	double tmp;
+	double diff = 0.0;
+
+	for(ii=0; ii<m; ii++)
+		{
+		tmp = fabs(blasfeo_dvecex1(sa, ii) - blasfeo_dvecex1(sb, ii));
+		diff = tmp>diff ? tmp : diff;
+		}
+
+	return diff;
+
+	}
+
+
+
+// max abs difference between the partially condensed problems in (*1) and (*2)
+static double max_diff_part_cond(int N2, int *nx2, int *nu2, int *nb2, int **hidxb21, int **hidxb22, int *ng2, struct blasfeo_dmat *hsBAbt21, struct blasfeo_dmat *hsBAbt22, struct blasfeo_dvec *hsb21, struct blasfeo_dvec *hsb22, struct blasfeo_dmat *hsRSQrq21, struct blasfeo_dmat *hsRSQrq22, struct blasfeo_dvec *hsrq21, struct blasfeo_dvec *hsrq22, struct blasfeo_dmat *hsDCt21, struct blasfeo_dmat *hsDCt22, struct blasfeo_dvec *hsd21, struct blasfeo_dvec *hsd22)
+	{
+
+	int ii, jj;
+	double tmp;
+	double diff = 0.0;
+
+	for(ii=0; ii<N2; ii++)
+		{
+		for(jj=0; jj<nb2[ii]; jj++)
+			if(hidxb21[ii][jj]!=hidxb22[ii][jj])
+				diff = INFINITY; // different index of box constraints
+		tmp = max_diff_dmat(nu2[ii]+nx2[ii]+1, nx2[ii+1], &hsBAbt21[ii], &hsBAbt22[ii]);
+		diff = tmp>diff ? tmp : diff;
+		tmp = max_diff_dvec(nx2[ii+1], &hsb21[ii], &hsb22[ii]);
+		diff = tmp>diff ? tmp : diff;
+		tmp = max_diff_dmat(nu2[ii]+nx2[ii]+1, nu2[ii]+nx2[ii], &hsRSQrq21[ii], &hsRSQrq22[ii]);
+		diff = tmp>diff ? tmp : diff;
+		tmp = max_diff_dvec(nu2[ii]+nx2[ii], &hsrq21[ii], &hsrq22[ii]);
+		diff = tmp>diff ? tmp : diff;
+		tmp = max_diff_dmat(nu2[ii]+nx2[ii], ng2[ii], &hsDCt21[ii], &hsDCt22[ii]);
+		diff = tmp>diff ? tmp : diff;
+		tmp = max_diff_dvec(2*nb2[ii]+2*ng2[ii], &hsd21[ii], &hsd22[ii]);
+		diff = tmp>diff ? tmp : diff;
+		}
+
+	return diff;
+
+	}
+
+
+
+// max abs difference between two vectors
+static double max_diff_vec(int m, double *x, double *y)
+	{
+
+	int ii;
+	double tmp;
+	double diff = 0.0;
+
+	for(ii=0; ii<m; ii++)
+		{
+		tmp = fabs(x[ii] - y[ii]);
+		diff = tmp>diff ? tmp : diff;
+		}
+
+	return diff;
+
+	}
+
+
+
+// solve an OCP with boxes on inputs and positions and general constraints on every stage,
+// without condensing (N2 = N) and with partial condensing to N2 = 7 and 1 (full condensing),
+// and check that the condensed solutions match the uncondensed one; returns the number of failures
+static int test_cond_general_constraints(int N, int nx_, int nu_)
+	{
+
+	int ii, jj, ll;
+
+	int ng_ = 2;
+
+	// problem size
+	int nx[N+1];
+	int nu[N+1];
+	int nb[N+1];
+	int ng[N+1];
+	int *hidxb[N+1];
+	nx[0] = 0;
+	for(ii=1; ii<=N; ii++)
+		nx[ii] = nx_;
+	for(ii=0; ii<N; ii++)
+		nu[ii] = nu_;
+	nu[N] = 0;
+	for(ii=0; ii<=N; ii++)
+		{
+		nb[ii] = nu[ii] + nx[ii]/2;
+		ng[ii] = ng_;
+		int_zeros(&hidxb[ii], nb[ii], 1);
+		for(jj=0; jj<nb[ii]; jj++)
+			hidxb[ii][jj] = jj;
+		}
+
+	// dynamical system
+	double *A; d_zeros(&A, nx_, nx_);
+	double *B; d_zeros(&B, nx_, nu_);
+	double *b; d_zeros(&b, nx_, 1);
+	double *x0; d_zeros(&x0, nx_, 1);
+	mass_spring_system(0.5, nx_, nu_, N, A, B, b, x0);
+	for(jj=0; jj<nx_; jj++)
+		b[jj] = 0.1;
+
+	double *b0; d_zeros(&b0, nx_, 1);
+	for(ii=0; ii<nx_; ii++)
+		{
+		b0[ii] = b[ii];
+		for(jj=0; jj<nx_; jj++)
+			b0[ii] += A[ii+nx_*jj]*x0[jj];
+		}
+
+	// cost function
+	double *Q; d_zeros(&Q, nx_, nx_);
+	for(ii=0; ii<nx_; ii++) Q[ii*(nx_+1)] = 1.0;
+	double *S; d_zeros(&S, nu_, nx_);
+	double *R; d_zeros(&R, nu_, nu_);
+	for(ii=0; ii<nu_; ii++) R[ii*(nu_+1)] = 2.0;
+	double *q; d_zeros(&q, nx_, 1);
+	for(ii=0; ii<nx_; ii++) q[ii] = 0.1;
+	double *r; d_zeros(&r, nu_, 1);
+	for(ii=0; ii<nu_; ii++) r[ii] = 0.2;
+
+	// box constraints: inputs, then positions (the final stage has only the positions)
+	double *lb; d_zeros(&lb, nu_+nx_/2, 1);
+	double *ub; d_zeros(&ub, nu_+nx_/2, 1);
+	for(ii=0; ii<nu_; ii++)
+		{
+		lb[ii] = - 1.0;
+		ub[ii] = + 1.0;
+		}
+	for(; ii<nu_+nx_/2; ii++)
+		{
+		lb[ii] = - 2.2;
+		ub[ii] = + 2.2;
+		}
+
+	// general constraints: sum of the inputs plus first position, sum of the velocities
+	double *C; d_zeros(&C, ng_, nx_);
+	double *D; d_zeros(&D, ng_, nu_);
+	for(jj=0; jj<nu_; jj++)
+		D[0+ng_*jj] = 1.0;
+	C[0+ng_*0] = 1.0;
+	for(jj=nx_/2; jj<nx_; jj++)
+		C[1+ng_*jj] = 1.0;
+	double *lg; d_zeros(&lg, ng_, 1);
+	double *ug; d_zeros(&ug, ng_, 1);
+	lg[0] = - 0.4;
+	ug[0] = + 100.0;
+	lg[1] = - 1.5;
+	ug[1] = + 3.0;
+
+	double *hA[N];
+	double *hB[N];
+	double *hb[N];
+	double *hQ[N+1];
+	double *hS[N];
+	double *hR[N];
+	double *hq[N+1];
+	double *hr[N];
+	double *hlb[N+1];
+	double *hub[N+1];
+	double *hC[N+1];
+	double *hD[N];
+	double *hlg[N+1];
+	double *hug[N+1];
+	for(ii=0; ii<N; ii++)
+		{
+		hA[ii] = A;
+		hB[ii] = B;
+		hb[ii] = ii==0 ? b0 : b;
+		hS[ii] = S;
+		hR[ii] = R;
+		hr[ii] = r;
+		hD[ii] = D;
+		}
+	for(ii=0; ii<=N; ii++)
+		{
+		hQ[ii] = Q;
+		hq[ii] = q;
+		hlb[ii] = ii<N ? lb : lb+nu_;
+		hub[ii] = ii<N ? ub : ub+nu_;
+		hC[ii] = C;
+		hlg[ii] = lg;
+		hug[ii] = ug;
+		}
+
+	// solution, reference (uncondensed) and (partially) condensed
+	double *hx[2][N+1];
+	double *hu[2][N];
+	double *hpi[2][N];
+	double *hlam[2][N+1];
+	for(ll=0; ll<2; ll++)
+		{
+		for(ii=0; ii<N; ii++)
+			{
+			d_zeros(&hu[ll][ii], nu[ii], 1);
+			d_zeros(&hpi[ll][ii], nx[ii+1], 1);
+			}
+		for(ii=0; ii<=N; ii++)
+			{
+			d_zeros(&hx[ll][ii], nx[ii], 1);
+			d_zeros(&hlam[ll][ii], 2*nb[ii]+2*ng[ii], 1);
+			}
+		}
+
+	int kk = -1;
+	int k_max = 50;
+	double mu0 = 2.0;
+	double mu_tol = 1e-14;
+	double *stat; d_zeros(&stat, k_max, 5);
+	double inf_norm_res[5];
+	void *work;
+
+	// the IPMs stop at slightly different iterates close to mu_tol
+	int N2_v[3] = {N, 7, 1};
+	double tol_v[3] = {0.0, 1e-10, 1e-10};
+
+	int hpmpc_status, n_act, sol;
+	int n_fail = 0;
+	double diff, tmp;
+
+	printf("\ngeneral constraints and boxes on the states, N = %d\n", N);
+
+	for(ll=0; ll<3; ll++)
+		{
+
+		v_zeros_align(&work, hpmpc_d_ip_ocp_hard_tv_work_space_size_bytes(N, nx, nu, nb, hidxb, ng, N2_v[ll]));
+
+		sol = ll==0 ? 0 : 1;
+		hpmpc_status = fortran_order_d_ip_ocp_hard_tv(&kk, k_max, mu0, mu_tol, N, nx, nu, nb, hidxb, ng, N2_v[ll], 0, hA, hB, hb, hQ, hS, hR, hq, hr, hlb, hub, hC, hD, hlg, hug, hx[sol], hu[sol], hpi[sol], hlam[sol], inf_norm_res, work, stat);
+
+		v_free_align(work);
+
+		// active boxes on the states and general constraints, to make sure the test is not trivial
+		// (multipliers ordered as lb, lg, ub, ug)
+		n_act = 0;
+		for(ii=0; ii<=N; ii++)
+			{
+			for(jj=nu[ii]; jj<nb[ii]; jj++)
+				if(hlam[sol][ii][jj]>1e-6 || hlam[sol][ii][nb[ii]+ng[ii]+jj]>1e-6)
+					n_act++;
+			for(jj=0; jj<ng[ii]; jj++)
+				if(hlam[sol][ii][nb[ii]+jj]>1e-6 || hlam[sol][ii][2*nb[ii]+ng[ii]+jj]>1e-6)
+					n_act++;
+			}
+
+		diff = 0.0;
+		if(ll>0)
+			{
+			for(ii=0; ii<N; ii++)
+				{
+				tmp = max_diff_vec(nu[ii], hu[1][ii], hu[0][ii]);
+				diff = tmp>diff ? tmp : diff;
+				tmp = max_diff_vec(nx[ii+1], hpi[1][ii], hpi[0][ii]);
+				diff = tmp>diff ? tmp : diff;
+				}
+			for(ii=0; ii<=N; ii++)
+				{
+				tmp = max_diff_vec(nx[ii], hx[1][ii], hx[0][ii]);
+				diff = tmp>diff ? tmp : diff;
+				tmp = max_diff_vec(2*nb[ii]+2*ng[ii], hlam[1][ii], hlam[0][ii]);
+				diff = tmp>diff ? tmp : diff;
+				}
+			}
+
+		printf("N2 = %2d: status %d, %2d iterations, %3d active constraints, max |cond - full| = %e\n", N2_v[ll], hpmpc_status, kk, n_act, diff);
+
+		if(hpmpc_status!=0 || n_act==0 || diff>tol_v[ll])
+			n_fail++;
+
+		}
+
+	printf("\n");
+
+	// free memory
+	for(ll=0; ll<2; ll++)
+		{
+		for(ii=0; ii<N; ii++)
+			{
+			d_free(hu[ll][ii]);
+			d_free(hpi[ll][ii]);
+			}
+		for(ii=0; ii<=N; ii++)
+			{
+			d_free(hx[ll][ii]);
+			d_free(hlam[ll][ii]);
+			}
+		}
+	for(ii=0; ii<=N; ii++)
+		int_free(hidxb[ii]);
+	d_free(A);
+	d_free(B);
+	d_free(b);
+	d_free(x0);
+	d_free(b0);
+	d_free(Q);
+	d_free(S);
+	d_free(R);
+	d_free(q);
+	d_free(r);
+	d_free(lb);
+	d_free(ub);
+	d_free(C);
+	d_free(D);
+	d_free(lg);
+	d_free(ug);
+	d_free(stat);
+
+	return n_fail;
+
+	}
+
+
+
+int main()
+	{
+	
+	printf("\n");
+	printf("\n");
+	printf("\n");
+	printf(" HPMPC -- Library for High-Performance implementation of solvers for MPC.\n");
+	printf(" Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.\n");
+	printf("\n");
+	printf(" HPMPC is distributed in the hope that it will be useful,\n");
+	printf(" but WITHOUT ANY WARRANTY; without even the implied warranty of\n");
+	printf(" MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.\n");
+	printf(" See the GNU Lesser General Public License for more details.\n");
+	printf("\n");
+	printf("\n");
+	printf("\n");
+	
+#if defined(TARGET_X64_AVX512) || defined(TARGET_X64_AVX2) || defined(TARGET_X64_AVX) || defined(TARGET_X64_SSE3) || defined(TARGET_X86_ATOM) || defined(TARGET_AMD_SSE3)
+	_MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON); // flush to zero subnormals !!! works only with one thread !!!
+#endif
+
+	int ii, jj;
+	
+	int rep;
+
+	int nx_ = 8; // number of states (it has to be even for the mass-spring system test problem)
+	int nu_ = 3; // number of inputs (controllers) (it has to be at least 1 and at most nx/2 for the mass-spring system test problem)
+	int N  = 10; // horizon lenght
+	int N2 = 3; // horizon lenght of the partially condensed problem: blocks of 4, 3 and 3 stages
+
+	// number of calls to the condensing routines (for more accurate timings)
+	int nrep = 1000;
+
+	// stage-wise variant size
+	int nx[N+1];
+	nx[0] = 0;
+	for(ii=1; ii<=N; ii++)
+		nx[ii] = nx_;
+
+	int nu[N+1];
+	for(ii=0; ii<N; ii++)
+		nu[ii] = nu_;
+	nu[N] = 0;
+
+	int ng[N+1];
+	for(ii=0; ii<=N; ii++)
+		ng[ii] = 0;
+
+	// box constraints on inputs and states
+	int nb[N+1];
+	for(ii=0; ii<=N; ii++)
+		nb[ii] = nu[ii]+nx[ii];
+
+	printf(" Test problem: mass-spring system with %d masses and %d controls.\n", nx_/2, nu_);
+	printf("\n");
+	printf(" MPC problem size: %d states, %d inputs, %d horizon length, %d two-sided box constraints.\n", nx[1], nu[1], N, nb[1]);
+	printf("\n");
+	printf(" Partial condensing to horizon length %d.\n", N2);
+
+/************************************************
+* dynamical system
+************************************************/	
+
+	double *A; d_zeros(&A, nx_, nx_); // states update matrix
+
+	double *B; d_zeros(&B, nx_, nu_); // inputs matrix
+
+	double *b; d_zeros_align(&b, nx_, 1); // states offset
+	double *x0; d_zeros_align(&x0, nx_, 1); // initial state
+
+	double Ts = 0.5; // sampling time
+	mass_spring_system(Ts, nx_, nu_, N, A, B, b, x0);
+
+	for(jj=0; jj<nx_; jj++)
+		b[jj] = 0.1;
+
+	for(jj=0; jj<nx_; jj++)
+		x0[jj] = 0;
+	x0[0] = 2.5;
+	x0[1] = 2.5;
+
+	struct blasfeo_dmat sA;
+	blasfeo_allocate_dmat(nx_, nx_, &sA);
+	blasfeo_pack_dmat(nx_, nx_, A, nx_, &sA, 0, 0);
+
+	struct blasfeo_dvec sx0;
+	blasfeo_allocate_dvec(nx_, &sx0);
+	blasfeo_pack_dvec(nx_, x0, &sx0, 0);
+
+	// b0 = b + A*x0
+	struct blasfeo_dvec sb0;
+	blasfeo_allocate_dvec(nx_, &sb0);
+	blasfeo_pack_dvec(nx_, b, &sb0, 0);
+	blasfeo_dgemv_n(nx_, nx_, 1.0, &sA, 0, 0, &sx0, 0, 1.0, &sb0, 0, &sb0, 0);
+
+	struct blasfeo_dmat hsBAbt[N];
+	struct blasfeo_dvec hsb[N];
+	for(ii=0; ii<N; ii++)
+		{
+		blasfeo_allocate_dmat(nu[ii]+nx[ii]+1, nx[ii+1], &hsBAbt[ii]);
+		blasfeo_pack_tran_dmat(nx[ii+1], nu[ii], B, nx_, &hsBAbt[ii], 0, 0);
+		blasfeo_pack_tran_dmat(nx[ii+1], nx[ii], A, nx_, &hsBAbt[ii], nu[ii], 0);
+		if(ii==0)
+			blasfeo_drowin(nx[ii+1], 1.0, &sb0, 0, &hsBAbt[ii], nu[ii]+nx[ii], 0);
+		else
+			blasfeo_pack_tran_dmat(nx[ii+1], 1, b, nx_, &hsBAbt[ii], nu[ii]+nx[ii], 0);
+		blasfeo_allocate_dvec(nx[ii+1], &hsb[ii]);
+		blasfeo_drowex(nx[ii+1], 1.0, &hsBAbt[ii], nu[ii]+nx[ii], 0, &hsb[ii], 0);
+		}
+
+/************************************************
+* cost function
+************************************************/	
+	
+	double *Q; d_zeros(&Q, nx_, nx_);
+	for(ii=0; ii<nx_; ii++) Q[ii*(nx_+1)] = 1.0;
+
+	double *R; d_zeros(&R, nu_, nu_);
+	for(ii=0; ii<nu_; ii++) R[ii*(nu_+1)] = 2.0;
+
+	double *q; d_zeros(&q, nx_, 1);
+	for(ii=0; ii<nx_; ii++) q[ii] = 0.1;
+
+	double *r; d_zeros(&r, nu_, 1);
+	for(ii=0; ii<nu_; ii++) r[ii] = 0.2;
+
+	struct blasfeo_dmat hsRSQrq[N+1];
+	struct blasfeo_dvec hsrq[N+1];
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_allocate_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], &hsRSQrq[ii]);
+		blasfeo_dgese(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], 0.0, &hsRSQrq[ii], 0, 0);
+		blasfeo_pack_dmat(nu[ii], nu[ii], R, nu_, &hsRSQrq[ii], 0, 0);
+		blasfeo_pack_dmat(nx[ii], nx[ii], Q, nx_, &hsRSQrq[ii], nu[ii], nu[ii]);
+		blasfeo_pack_tran_dmat(nu[ii], 1, r, nu_, &hsRSQrq[ii], nu[ii]+nx[ii], 0);
+		blasfeo_pack_tran_dmat(nx[ii], 1, q, nx_, &hsRSQrq[ii], nu[ii]+nx[ii], nu[ii]);
+		blasfeo_allocate_dvec(nu[ii]+nx[ii], &hsrq[ii]);
+		blasfeo_drowex(nu[ii]+nx[ii], 1.0, &hsRSQrq[ii], nu[ii]+nx[ii], 0, &hsrq[ii], 0);
+		}
+
+/************************************************
+* box constraints
+************************************************/	
+
+	// d = [lb | ub], idxb = identity: inputs first, then states
+	int *hidxb[N+1];
+	struct blasfeo_dvec hsd[N+1];
+	struct blasfeo_dmat hsDCt[N+1]; // no general constraints
+	for(ii=0; ii<=N; ii++)
+		{
+		int_zeros(&hidxb[ii], nb[ii], 1);
+		for(jj=0; jj<nb[ii]; jj++)
+			hidxb[ii][jj] = jj;
+		blasfeo_allocate_dvec(2*nb[ii], &hsd[ii]);
+		blasfeo_dvecse(nu[ii], -0.5, &hsd[ii], 0); // umin
+		blasfeo_dvecse(nx[ii], -4.0, &hsd[ii], nu[ii]); // xmin
+		blasfeo_dvecse(nu[ii], 0.5, &hsd[ii], nb[ii]); // umax
+		blasfeo_dvecse(nx[ii], 4.0, &hsd[ii], nb[ii]+nu[ii]); // xmax
+		blasfeo_allocate_dmat(nu[ii]+nx[ii]+1, ng[ii], &hsDCt[ii]);
+		}
+
+/************************************************
+* partially condensed problem
+************************************************/	
+
+	int nx2[N2+1];
+	int nu2[N2+1];
+	int nb2[N2+1];
+	int ng2[N2+1];
+
+	d_part_cond_compute_problem_size_libstr(N, nx, nu, nb, hidxb, ng, N2, nx2, nu2, nb2, ng2);
+
+	// (*1): incremental update, (*2): reference, full partial condensing of the same data
+	int *hidxb21[N2+1];
+	int *hidxb22[N2+1];
+	struct blasfeo_dmat hsBAbt21[N2];
+	struct blasfeo_dmat hsBAbt22[N2];
+	struct blasfeo_dvec hsb21[N2];
+	struct blasfeo_dvec hsb22[N2];
+	struct blasfeo_dmat hsRSQrq21[N2+1];
+	struct blasfeo_dmat hsRSQrq22[N2+1];
+	struct blasfeo_dvec hsrq21[N2+1];
+	struct blasfeo_dvec hsrq22[N2+1];
+	struct blasfeo_dmat hsDCt21[N2+1];
+	struct blasfeo_dmat hsDCt22[N2+1];
+	struct blasfeo_dvec hsd21[N2+1];
+	struct blasfeo_dvec hsd22[N2+1];
+	for(ii=0; ii<=N2; ii++)
+		{
+		int_zeros(&hidxb21[ii], nb2[ii], 1);
+		int_zeros(&hidxb22[ii], nb2[ii], 1);
+		if(ii<N2)
+			{
+			blasfeo_allocate_dmat(nu2[ii]+nx2[ii]+1, nx2[ii+1], &hsBAbt21[ii]);
+			blasfeo_dgese(nu2[ii]+nx2[ii]+1, nx2[ii+1], 0.0, &hsBAbt21[ii], 0, 0);
+			blasfeo_allocate_dmat(nu2[ii]+nx2[ii]+1, nx2[ii+1], &hsBAbt22[ii]);
+			blasfeo_dgese(nu2[ii]+nx2[ii]+1, nx2[ii+1], 0.0, &hsBAbt22[ii], 0, 0);
+			blasfeo_allocate_dvec(nx2[ii+1], &hsb21[ii]);
+			blasfeo_allocate_dvec(nx2[ii+1], &hsb22[ii]);
+			}
+		blasfeo_allocate_dmat(nu2[ii]+nx2[ii]+1, nu2[ii]+nx2[ii], &hsRSQrq21[ii]);
+		blasfeo_dgese(nu2[ii]+nx2[ii]+1, nu2[ii]+nx2[ii], 0.0, &hsRSQrq21[ii], 0, 0);
+		blasfeo_allocate_dmat(nu2[ii]+nx2[ii]+1, nu2[ii]+nx2[ii], &hsRSQrq22[ii]);
+		blasfeo_dgese(nu2[ii]+nx2[ii]+1, nu2[ii]+nx2[ii], 0.0, &hsRSQrq22[ii], 0, 0);
+		blasfeo_allocate_dvec(nu2[ii]+nx2[ii], &hsrq21[ii]);
+		blasfeo_allocate_dvec(nu2[ii]+nx2[ii], &hsrq22[ii]);
+		blasfeo_allocate_dmat(nu2[ii]+nx2[ii]+1, ng2[ii], &hsDCt21[ii]);
+		blasfeo_dgese(nu2[ii]+nx2[ii]+1, ng2[ii], 0.0, &hsDCt21[ii], 0, 0);
+		blasfeo_allocate_dmat(nu2[ii]+nx2[ii]+1, ng2[ii], &hsDCt22[ii]);
+		blasfeo_dgese(nu2[ii]+nx2[ii]+1, ng2[ii], 0.0, &hsDCt22[ii], 0, 0);
+		blasfeo_allocate_dvec(2*nb2[ii]+2*ng2[ii], &hsd21[ii]);
+		blasfeo_allocate_dvec(2*nb2[ii]+2*ng2[ii], &hsd22[ii]);
+		}
+
+	int work_space_sizes[5];
+	void *work;
+	v_zeros_align(&work, d_part_cond_work_space_size_bytes_libstr(N, nx, nu, nb, hidxb, ng, N2, nx2, nu2, nb2, ng2, work_space_sizes));
+	void *memory1;
+	v_zeros_align(&memory1, d_part_cond_memory_space_size_bytes_libstr(N, nx, nu, nb, hidxb, ng, N2, nx2, nu2, nb2, ng2));
+	void *memory2;
+	v_zeros_align(&memory2, d_part_cond_memory_space_size_bytes_libstr(N, nx, nu, nb, hidxb, ng, N2, nx2, nu2, nb2, ng2));
+
+	int dirty[N];
+	double diff;
+
+	struct timeval tv0, tv1;
+
+/************************************************
+* initial condensing of (*1)
+************************************************/	
+
+	d_part_cond_libstr(N, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsd, N2, nx2, nu2, nb2, hidxb21, ng2, hsBAbt21, hsRSQrq21, hsDCt21, hsd21, memory1, work, work_space_sizes);
+
+/************************************************
+* update 1: stages 1 and 2 (inside the first block) and 5 (middle of the second block)
+************************************************/	
+
+	for(ii=0; ii<N; ii++)
+		dirty[ii] = 0;
+
+	// new dynamics at stage 1
+	blasfeo_dgein1(1.1*blasfeo_dgeex1(&hsBAbt[1], nu[1], 0), &hsBAbt[1], nu[1], 0);
+	blasfeo_dgein1(0.3, &hsBAbt[1], 0, 1);
+	dirty[1] = 1;
+	// new cost at stage 2
+	blasfeo_dgein1(3.0, &hsRSQrq[2], 0, 0);
+	blasfeo_dgein1(5.0, &hsRSQrq[2], nu[2]+1, nu[2]+1);
+	dirty[2] = 1;
+	// new dynamics and cost at stage 5
+	blasfeo_dgein1(0.9*blasfeo_dgeex1(&hsBAbt[5], nu[5]+2, 3), &hsBAbt[5], nu[5]+2, 3);
+	blasfeo_dgein1(2.0, &hsRSQrq[5], nu[5], nu[5]);
+	dirty[5] = 1;
+
+	d_part_cond_update_libstr(N, nx, nu, nb, hidxb, ng, dirty, hsBAbt, hsRSQrq, hsDCt, hsd, N2, nx2, nu2, nb2, hidxb21, ng2, hsBAbt21, hsRSQrq21, hsDCt21, hsd21, memory1, work, work_space_sizes);
+	d_part_cond_libstr(N, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsd, N2, nx2, nu2, nb2, hidxb22, ng2, hsBAbt22, hsRSQrq22, hsDCt22, hsd22, memory2, work, work_space_sizes);
+
+	// the vectors use the recursion matrices in memory
+	d_part_cond_rhs_libstr(N, nx, nu, nb, hidxb, ng, hsBAbt, hsb, hsRSQrq, hsrq, hsDCt, hsd, N2, nx2, nu2, nb2, hidxb21, ng2, hsBAbt21, hsb21, hsRSQrq21, hsrq21, hsDCt21, hsd21, memory1, work, work_space_sizes);
+	d_part_cond_rhs_libstr(N, nx, nu, nb, hidxb, ng, hsBAbt, hsb, hsRSQrq, hsrq, hsDCt, hsd, N2, nx2, nu2, nb2, hidxb22, ng2, hsBAbt22, hsb22, hsRSQrq22, hsrq22, hsDCt22, hsd22, memory2, work, work_space_sizes);
+
+	diff = max_diff_part_cond(N2, nx2, nu2, nb2, hidxb21, hidxb22, ng2, hsBAbt21, hsBAbt22, hsb21, hsb22, hsRSQrq21, hsRSQrq22, hsrq21, hsrq22, hsDCt21, hsDCt22, hsd21, hsd22);
+
+	printf("\nupdate of stages 1, 2, 5: max |update - full| = %e\n", diff);
+
+/************************************************
+* update 2: first and last stage of the third block
+************************************************/	
+
+	for(ii=0; ii<N; ii++)
+		dirty[ii] = 0;
+
+	// new dynamics at stage 7
+	blasfeo_dgein1(0.2, &hsBAbt[7], 1, 0);
+	dirty[7] = 1;
+	// new cost and bounds at stage 9
+	blasfeo_dgein1(4.0, &hsRSQrq[9], nu[9]+3, nu[9]+3);
+	blasfeo_dvecse(nx[9], -3.0, &hsd[9], nu[9]); // xmin
+	dirty[9] = 1;
+
+	d_part_cond_update_libstr(N, nx, nu, nb, hidxb, ng, dirty, hsBAbt, hsRSQrq, hsDCt, hsd, N2, nx2, nu2, nb2, hidxb21, ng2, hsBAbt21, hsRSQrq21, hsDCt21, hsd21, memory1, work, work_space_sizes);
+	d_part_cond_libstr(N, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsd, N2, nx2, nu2, nb2, hidxb22, ng2, hsBAbt22, hsRSQrq22, hsDCt22, hsd22, memory2, work, work_space_sizes);
+
+	d_part_cond_rhs_libstr(N, nx, nu, nb, hidxb, ng, hsBAbt, hsb, hsRSQrq, hsrq, hsDCt, hsd, N2, nx2, nu2, nb2, hidxb21, ng2, hsBAbt21, hsb21, hsRSQrq21, hsrq21, hsDCt21, hsd21, memory1, work, work_space_sizes);
+	d_part_cond_rhs_libstr(N, nx, nu, nb, hidxb, ng, hsBAbt, hsb, hsRSQrq, hsrq, hsDCt, hsd, N2, nx2, nu2, nb2, hidxb22, ng2, hsBAbt22, hsb22, hsRSQrq22, hsrq22, hsDCt22, hsd22, memory2, work, work_space_sizes);
+
+	diff = max_diff_part_cond(N2, nx2, nu2, nb2, hidxb21, hidxb22, ng2, hsBAbt21, hsBAbt22, hsb21, hsb22, hsRSQrq21, hsRSQrq22, hsrq21, hsrq22, hsDCt21, hsDCt22, hsd21, hsd22);
+
+	printf("\nupdate of stages 7, 9:    max |update - full| = %e\n", diff);
+
+#if PRINT
+	printf("\nRSQrq2 =\n\n");
+	for(ii=0; ii<N2; ii++)
+		blasfeo_print_dmat(nu2[ii]+nx2[ii]+1, nu2[ii]+nx2[ii], &hsRSQrq21[ii], 0, 0);
+#endif
+
+/************************************************
+* timing: full partial condensing vs update of a single stage
+************************************************/	
+
+	for(ii=0; ii<N; ii++)
+		dirty[ii] = 0;
+	dirty[5] = 1;
+
+	gettimeofday(&tv0, NULL); // start
+
+	for(rep=0; rep<nrep; rep++)
+		{
+		d_part_cond_libstr(N, nx, nu, nb, hidxb, ng, hsBAbt, hsRSQrq, hsDCt, hsd, N2, nx2, nu2, nb2, hidxb22, ng2, hsBAbt22, hsRSQrq22, hsDCt22, hsd22, memory2, work, work_space_sizes);
+		}
+
+	gettimeofday(&tv1, NULL); // stop
+
+	double time_full = (tv1.tv_sec-tv0.tv_sec)/(nrep+0.0)+(tv1.tv_usec-tv0.tv_usec)/(nrep*1e6);
+
+	gettimeofday(&tv0, NULL); // start
+
+	for(rep=0; rep<nrep; rep++)
+		{
+		d_part_cond_update_libstr(N, nx, nu, nb, hidxb, ng, dirty, hsBAbt, hsRSQrq, hsDCt, hsd, N2, nx2, nu2, nb2, hidxb21, ng2, hsBAbt21, hsRSQrq21, hsDCt21, hsd21, memory1, work, work_space_sizes);
+		}
+
+	gettimeofday(&tv1, NULL); // stop
+
+	double time_update = (tv1.tv_sec-tv0.tv_sec)/(nrep+0.0)+(tv1.tv_usec-tv0.tv_usec)/(nrep*1e6);
+
+	printf("\ntime full partial condensing = %e seconds\n", time_full);
+	printf("\ntime update of stage 5       = %e seconds\n", time_update);
+	printf("\n");
+
+/************************************************
+* general constraints and boxes on the states: condensed vs uncondensed solution
+************************************************/	
+
+	int n_fail = test_cond_general_constraints(61, nx_, nu_);
+
+/************************************************
+* free memory
+************************************************/	
+
+	d_free(A);
+	d_free(B);
+	d_free_align(b);
+	d_free_align(x0);
+	d_free(Q);
+	d_free(R);
+	d_free(q);
+	d_free(r);
+
+	blasfeo_free_dmat(&sA);
+	blasfeo_free_dvec(&sx0);
+	blasfeo_free_dvec(&sb0);
+	for(ii=0; ii<N; ii++)
+		{
+		blasfeo_free_dmat(&hsBAbt[ii]);
+		blasfeo_free_dvec(&hsb[ii]);
+		}
+	for(ii=0; ii<=N; ii++)
+		{
+		blasfeo_free_dmat(&hsRSQrq[ii]);
+		blasfeo_free_dvec(&hsrq[ii]);
+		int_free(hidxb[ii]);
+		blasfeo_free_dvec(&hsd[ii]);
+		blasfeo_free_dmat(&hsDCt[ii]);
+		}
+	for(ii=0; ii<=N2; ii++)
+		{
+		int_free(hidxb21[ii]);
+		int_free(hidxb22[ii]);
+		if(ii<N2)
+			{
+			blasfeo_free_dmat(&hsBAbt21[ii]);
+			blasfeo_free_dmat(&hsBAbt22[ii]);
+			blasfeo_free_dvec(&hsb21[ii]);
+			blasfeo_free_dvec(&hsb22[ii]);
+			}
+		blasfeo_free_dmat(&hsRSQrq21[ii]);
+		blasfeo_free_dmat(&hsRSQrq22[ii]);
+		blasfeo_free_dvec(&hsrq21[ii]);
+		blasfeo_free_dvec(&hsrq22[ii]);
+		blasfeo_free_dmat(&hsDCt21[ii]);
+		blasfeo_free_dmat(&hsDCt22[ii]);
+		blasfeo_free_dvec(&hsd21[ii]);
+		blasfeo_free_dvec(&hsd22[ii]);
+		}
+	v_free_align(work);
+	v_free_align(memory1);
+	v_free_align(memory2);
+
+/************************************************
+* return
+************************************************/	
+
+	return n_fail;
+	}
@@ -755,20 +755,24 @@ int main()
 	struct blasfeo_dmat hsmatdummy[Nn];
 	struct blasfeo_dvec hsvecdummy[Nn];
 
+	// work space
+	void *t_work_ric;
+	v_zeros_align(&t_work_ric, d_tree_back_ric_rec_work_space_size_bytes_libstr(Nn, tree, t_nx, t_nu, t_nb, t_ng));
+
 
 	// call riccati
 	gettimeofday(&tv1, NULL); // time
 
 	for(rep=0; rep<nrep; rep++)
 		{
-		d_tree_back_ric_rec_trf_libstr(Nn, tree, t_nx, t_nu, t_nb, t_hidxb, t_ng, t_hsBAbt, t_hsRSQrq, hsmatdummy, hsvecdummy, t_hsL, work_ric);
+		d_tree_back_ric_rec_trf_libstr(Nn, tree, t_nx, t_nu, t_nb, t_hidxb, t_ng, t_hsBAbt, t_hsRSQrq, hsmatdummy, hsvecdummy, t_hsL, t_work_ric);
 		}
 
 	gettimeofday(&tv2, NULL); // time
 
 	for(rep=0; rep<nrep; rep++)
 		{
-		d_tree_back_ric_rec_trs_libstr(Nn, tree, t_nx, t_nu, t_nb, t_hidxb, t_ng, t_hsBAbt, t_hsb, t_hsrq, hsmatdummy, hsvecdummy, t_hsux, 1, t_hspi, 1, t_hsPb, t_hsL, work_ric);
+		d_tree_back_ric_rec_trs_libstr(Nn, tree, t_nx, t_nu, t_nb, t_hidxb, t_ng, t_hsBAbt, t_hsb, t_hsrq, hsmatdummy, hsvecdummy, t_hsux, 1, t_hspi, 1, t_hsPb, t_hsL, t_work_ric);
 		}
 
 	gettimeofday(&tv3, NULL); // time
@@ -0,0 +1,208 @@
+/**************************************************************************************************
+*                                                                                                 *
+* This file is part of HPMPC.                                                                     *
+*                                                                                                 *
+* HPMPC -- Library for High-Performance implementation of solvers for MPC.                        *
+* Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.                *
+*                                                                                                 *
+* HPMPC is free software; you can redistribute it and/or                                          *
+* modify it under the terms of the GNU Lesser General Public                                      *
+* License as published by the Free Software Foundation; either                                    *
+* version 2.1 of the License, or (at your option) any later version.                              *
+*                                                                                                 *
+* HPMPC is distributed in the hope that it will be useful,                                        *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of                                  *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                                            *
+* See the GNU Lesser General Public License for more details.                                     *
+*                                                                                                 *
+* You should have received a copy of the GNU Lesser General Public                                *
+* License along with HPMPC; if not, write to the Free Software                                    *
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA                  *
+*                                                                                                 *
+* Author: Gianluca Frison, giaf (at) dtu.dk                                                       *
+*                                                                                                 *
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "../include/aux_d.h"
+#include "../include/blas_d.h"
+#include "../include/block_size.h"
+
+
+
+// max abs difference on the lower triangle (lower==1) or on the whole m x n matrix
+static double max_diff(int m, int n, int lower, double *A, double *B)
+	{
+
+	int ii, jj;
+	double tmp;
+	double diff = 0.0;
+
+	for(jj=0; jj<n; jj++)
+		for(ii=lower ? jj : 0; ii<m; ii++)
+			{
+			tmp = fabs(A[ii+m*jj] - B[ii+m*jj]);
+			diff = tmp>diff ? tmp : diff;
+			}
+
+	return diff;
+
+	}
+
+
+
+int main()
+	{
+
+	printf("\n");
+	printf("\n");
+	printf("\n");
+	printf(" HPMPC -- Library for High-Performance implementation of solvers for MPC.\n");
+	printf(" Copyright (C) 2014-2015 by Technical University of Denmark. All rights reserved.\n");
+	printf("\n");
+	printf(" HPMPC is distributed in the hope that it will be useful,\n");
+	printf(" but WITHOUT ANY WARRANTY; without even the implied warranty of\n");
+	printf(" MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.\n");
+	printf(" See the GNU Lesser General Public License for more details.\n");
+	printf("\n");
+	printf("\n");
+	printf("\n");
+
+	printf("Fused dtrmm + dsyrk + dpotrf of the Riccati recursion against the unfused sequence\n");
+	printf("dtrmm_nt_u_lib, row add and dsyrk_dpotrf_lib - double precision\n");
+	printf("\n");
+
+	const int bs = D_MR;
+	const int ncl = D_NCL;
+
+	// sizes around the 4-row panels
+	int nn[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 11, 12, 13, 15, 16, 17, 20, 23, 24, 25, 31, 32, 33};
+	int n_size = sizeof(nn)/sizeof(int);
+
+	// rows of W beyond the n columns of D: 1 is the gradient row of the Riccati recursion
+	int mm[] = {0, 1, 5};
+	int m_size = sizeof(mm)/sizeof(int);
+
+	int ii, jj, i_m, i_n, i_k, use_R;
+	int m, n, k, pm, pk, cn, ck;
+
+	double tol = 1e-10;
+	double diff;
+	double err_W = 0.0;
+	double err_D = 0.0;
+	int n_fail = 0;
+
+	for(i_m=0; i_m<m_size; i_m++)
+		for(i_n=0; i_n<n_size; i_n++)
+			for(i_k=0; i_k<n_size; i_k++)
+				for(use_R=0; use_R<2; use_R++)
+					{
+
+					n = nn[i_n];
+					m = n + mm[i_m];
+					k = nn[i_k];
+
+					pm = (m+bs-1)/bs*bs;
+					pk = (k+bs-1)/bs*bs;
+					cn = (n+ncl-1)/ncl*ncl;
+					ck = (k+ncl-1)/ncl*ncl;
+
+					double *A; d_zeros(&A, m, k);
+					double *B; d_zeros(&B, k, k);
+					double *C; d_zeros(&C, m, n);
+					double *W; d_zeros(&W, m, k);
+					double *W_ref; d_zeros(&W_ref, m, k);
+					double *D; d_zeros(&D, m, n);
+					double *D_ref; d_zeros(&D_ref, m, n);
+					double *inv_diag; d_zeros(&inv_diag, n, 1);
+					double *inv_diag_ref; d_zeros(&inv_diag_ref, n, 1);
+
+					double *pA; d_zeros_align(&pA, pm, ck);
+					double *pB; d_zeros_align(&pB, pk, ck);
+					double *pR; d_zeros_align(&pR, bs, ck);
+					double *pC; d_zeros_align(&pC, pm, cn);
+					double *pW; d_zeros_align(&pW, pm, ck);
+					double *pW_ref; d_zeros_align(&pW_ref, pm, ck);
+					double *pD; d_zeros_align(&pD, pm, cn);
+					double *pD_ref; d_zeros_align(&pD_ref, pm, cn);
+
+					for(ii=0; ii<m*k; ii++)
+						A[ii] = 0.1 * ((ii*7)%13 - 6) / 6.0;
+					// upper triangular B, with entries in the lower triangle that must not be referenced
+					for(jj=0; jj<k; jj++)
+						for(ii=0; ii<k; ii++)
+							B[ii+k*jj] = ii<=jj ? ((ii+3*jj)%5 - 2) / 4.0 + (ii==jj) : 1e3;
+					// symmetric positive definite C (strictly diagonally dominant)
+					for(jj=0; jj<n; jj++)
+						for(ii=0; ii<m; ii++)
+							C[ii+m*jj] = ii==jj ? m + k + 1.0 : ((ii+2*jj)%7 - 3) / 3.0;
+					for(jj=0; jj<k; jj++)
+						pR[jj*bs] = ((jj*3)%7 - 3) / 3.0;
+
+					d_cvt_mat2pmat(m, k, A, m, 0, pA, ck);
+					d_cvt_mat2pmat(k, k, B, k, 0, pB, ck);
+					d_cvt_mat2pmat(m, n, C, m, 0, pC, cn);
+
+					// unfused: W = A * B', last row of W += R, D = chol(C + W * W')
+					dtrmm_nt_u_lib(m, k, pA, ck, pB, ck, pW_ref, ck);
+					if(use_R)
+						for(jj=0; jj<k; jj++)
+							pW_ref[(m-1)/bs*bs*ck+(m-1)%bs+jj*bs] += pR[jj*bs];
+					dsyrk_dpotrf_lib(m, n, k, pW_ref, ck, pW_ref, ck, 1, pC, cn, pD_ref, cn, inv_diag_ref);
+
+					// fused
+					dtrmm_dsyrk_dpotrf_lib(m, n, k, pA, ck, pB, ck, use_R ? pR : NULL, pW, ck, pC, cn, pD, cn, inv_diag);
+
+					d_cvt_pmat2mat(m, k, 0, pW, ck, W, m);
+					d_cvt_pmat2mat(m, k, 0, pW_ref, ck, W_ref, m);
+					diff = max_diff(m, k, 0, W, W_ref);
+					err_W = diff>err_W ? diff : err_W;
+					if(diff>tol)
+						{
+						printf("W   m = %2d, n = %2d, k = %2d, R = %d: max |fused - unfused| = %e\n", m, n, k, use_R, diff);
+						n_fail++;
+						}
+
+					d_cvt_pmat2mat(m, n, 0, pD, cn, D, m);
+					d_cvt_pmat2mat(m, n, 0, pD_ref, cn, D_ref, m);
+					diff = max_diff(m, n, 1, D, D_ref);
+					if(max_diff(n, 1, 0, inv_diag, inv_diag_ref)>diff)
+						diff = max_diff(n, 1, 0, inv_diag, inv_diag_ref);
+					err_D = diff>err_D ? diff : err_D;
+					if(diff>tol)
+						{
+						printf("D   m = %2d, n = %2d, k = %2d, R = %d: max |fused - unfused| = %e\n", m, n, k, use_R, diff);
+						n_fail++;
+						}
+
+					d_free(A);
+					d_free(B);
+					d_free(C);
+					d_free(W);
+					d_free(W_ref);
+					d_free(D);
+					d_free(D_ref);
+					d_free(inv_diag);
+					d_free(inv_diag_ref);
+					d_free_align(pA);
+					d_free_align(pB);
+					d_free_align(pR);
+					d_free_align(pC);
+					d_free_align(pW);
+					d_free_align(pW_ref);
+					d_free_align(pD);
+					d_free_align(pD_ref);
+
+					}
+
+	printf("max |fused - unfused| over all sizes:\n");
+	printf("W      %e\n", err_W);
+	printf("D      %e\n", err_D);
+	printf("\n%d failures (tolerance %e)\n\n", n_fail, tol);
+
+	return n_fail;
+
+	}